@@ -67,6 +67,9 @@ function(cadet_choose_ad_lib TARGET)
 	elseif (ADLIB STREQUAL "sfad")
 		target_compile_definitions(${TARGET} PRIVATE -DACTIVE_SFAD)
 		target_include_directories(${TARGET} PRIVATE "${CMAKE_SOURCE_DIR}/include/ad")
+	elseif (ADLIB STREQUAL "sfad-arena")
+		target_compile_definitions(${TARGET} PRIVATE -DACTIVE_SFAD_ARENA)
+		target_include_directories(${TARGET} PRIVATE "${CMAKE_SOURCE_DIR}/include/ad")
 	elseif (ADLIB STREQUAL "setfad")
 		target_compile_definitions(${TARGET} PRIVATE -DACTIVE_SETFAD)
 		target_include_directories(${TARGET} PRIVATE "${CMAKE_SOURCE_DIR}/include/ad")
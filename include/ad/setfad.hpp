@@ -57,7 +57,7 @@ namespace sfad
 		{
 			setADValue(real_t(0));
 		}
-		FwdET(const real_t val) SFAD_NOEXCEPT_EXPR(noexcept(storage_t<real_t>()) : storage_t<real_t>(), _val(val)
+		FwdET(const real_t val) SFAD_NOEXCEPT_EXPR(noexcept(storage_t<real_t>())) : storage_t<real_t>(), _val(val)
 		{
 			setADValue(real_t(0));
 		}
@@ -66,11 +66,11 @@ namespace sfad
 			storage_t<real_t>::copyGradient(grad);
 		}
 		FwdET(const FwdET<real_t, storage_t>& cpy) SFAD_NOEXCEPT_EXPR(noexcept(storage_t<real_t>(cpy))) : storage_t<real_t>(cpy), _val(cpy._val) { }
-		FwdET(FwdET<real_t, storage_t>&& other) SFAD_NOEXCEPT_EXPR(noexcept(storage_t<real_t>(std::move(other))) : storage_t<real_t>(std::move(other)), _val(std::move(other._val)) { }
+		FwdET(FwdET<real_t, storage_t>&& other) SFAD_NOEXCEPT_EXPR(noexcept(storage_t<real_t>(std::move(other)))) : storage_t<real_t>(std::move(other)), _val(std::move(other._val)) { }
 
 		// Contains the one (and only) loop in expression template paradigm
 		template <typename A>
-		FwdET(const Expr<A, real_t>& other) SFAD_NOEXCEPT_EXPR(noexcept(storage_t<real_t>()) : storage_t<real_t>(), _val(other.value())
+		FwdET(const Expr<A, real_t>& other) SFAD_NOEXCEPT_EXPR(noexcept(storage_t<real_t>())) : storage_t<real_t>(), _val(other.value())
 		{
 			for (idx_t i = 0; i < detail::globalGradSize; ++i)
 				storage_t<real_t>::_grad[i] = other.gradient(i);
@@ -133,6 +133,10 @@ namespace sfad
 		inline real_t& operator[](const idx_t idx) { return storage_t<real_t>::_grad[idx]; }
 		inline const real_t operator[](const idx_t idx) const { return storage_t<real_t>::_grad[idx]; }
 
+		// Direct access to the contiguous gradient array for bulk extraction kernels
+		inline real_t* gradientVec() SFAD_NOEXCEPT { return storage_t<real_t>::_grad; }
+		inline real_t const* gradientVec() const SFAD_NOEXCEPT { return storage_t<real_t>::_grad; }
+
 		// Explicit cast operator to underlying scalar type
 		explicit operator real_t() const SFAD_NOEXCEPT { return _val; }
 		
@@ -495,6 +499,7 @@ namespace sfad
 		inline CLASSNAME<A, real_t> FUNCNAME(const Expr<A, real_t>& a) SFAD_NOEXCEPT { return CLASSNAME<A, real_t>(a.base()); }
 
 	SETFAD_UNARY_FUNC_ET_CLASS(Log, std::log(_cache), _a.value(), _a.gradient(idx) / _cache, log)
+	SETFAD_UNARY_FUNC_ET_CLASS(Log10, std::log10(_a.value()), std::log(real_t(10)) * _a.value(), _a.gradient(idx) / _cache, log10)
 	SETFAD_UNARY_FUNC_ET_CLASS(Square, detail::sqr(_cache), _a.value(), _a.gradient(idx) * real_t(2) * _cache, sqr)
 	SETFAD_UNARY_FUNC_ET_CLASS(Sqrt, _cache, std::sqrt(_a.value()), _a.gradient(idx) / (real_t(2) * _cache), sqrt)
 
@@ -547,7 +552,7 @@ namespace sfad
 	class Pow : public Expr<Pow<A,B,real_t>, real_t>
 	{
 	public:
-		Pow(const Expr<A, real_t>& a, const Expr<A, real_t>& b) SFAD_NOEXCEPT : _a(a.base()), _b(b.base()),
+		Pow(const Expr<A, real_t>& a, const Expr<B, real_t>& b) SFAD_NOEXCEPT : _a(a.base()), _b(b.base()),
 			_cacheA(_a.value()), _cacheB(_b.value()),
 			_cacheC(_cacheB * std::pow(_cacheA, _cacheB - real_t(1))), _cacheD(std::pow(_cacheA, _cacheB) * std::log(_cacheA))
 			{ }
@@ -611,6 +616,189 @@ namespace sfad
 	template <class A, typename real_t>
 	inline ScalarPow<A, real_t> pow(const real_t a, const Expr<A, real_t>& b) SFAD_NOEXCEPT { return ScalarPow<A, real_t>(a, b.base()); }
 
+
+	// Minimum and maximum select the gradient based on the cached difference of the values
+
+	template <class A, class B, typename real_t>
+	class Fmax : public Expr<Fmax<A,B,real_t>, real_t>
+	{
+	public:
+		Fmax(const Expr<A, real_t>& a, const Expr<B, real_t>& b) SFAD_NOEXCEPT : _a(a.base()), _b(b.base()), _diff(_a.value() - _b.value()) { }
+
+		inline const real_t value() const SFAD_NOEXCEPT { return (_diff > real_t(0)) ? _a.value() : _b.value(); }
+		inline const real_t gradient(std::size_t idx) const
+		{
+			if (_diff > real_t(0))
+				return _a.gradient(idx);
+			else if (_diff < real_t(0))
+				return _b.gradient(idx);
+			return std::max(_a.gradient(idx), _b.gradient(idx));
+		}
+
+	protected:
+		const A& _a;
+		const B& _b;
+		const real_t _diff;
+	};
+
+	template <class A, class B, typename real_t>
+	inline Fmax<A, B, real_t> fmax(const Expr<A, real_t>& a, const Expr<B, real_t>& b) SFAD_NOEXCEPT { return Fmax<A, B, real_t>(a.base(), b.base()); }
+
+
+	template <class A, typename real_t>
+	class FmaxScalar : public Expr<FmaxScalar<A,real_t>, real_t>
+	{
+	public:
+		FmaxScalar(const Expr<A, real_t>& a, const real_t b) SFAD_NOEXCEPT : _a(a.base()), _b(b), _diff(_a.value() - b) { }
+
+		inline const real_t value() const SFAD_NOEXCEPT { return (_diff > real_t(0)) ? _a.value() : _b; }
+		inline const real_t gradient(std::size_t idx) const
+		{
+			if (_diff > real_t(0))
+				return _a.gradient(idx);
+			else if (_diff < real_t(0))
+				return real_t(0);
+			return std::max(real_t(0), _a.gradient(idx));
+		}
+
+	protected:
+		const A& _a;
+		const real_t _b;
+		const real_t _diff;
+	};
+
+	template <class A, typename real_t>
+	inline FmaxScalar<A, real_t> fmax(const Expr<A, real_t>& a, const real_t b) SFAD_NOEXCEPT { return FmaxScalar<A, real_t>(a.base(), b); }
+
+	template <class A, typename real_t>
+	inline FmaxScalar<A, real_t> fmax(const real_t a, const Expr<A, real_t>& b) SFAD_NOEXCEPT { return FmaxScalar<A, real_t>(b.base(), a); }
+
+
+	template <class A, class B, typename real_t>
+	class Fmin : public Expr<Fmin<A,B,real_t>, real_t>
+	{
+	public:
+		Fmin(const Expr<A, real_t>& a, const Expr<B, real_t>& b) SFAD_NOEXCEPT : _a(a.base()), _b(b.base()), _diff(_a.value() - _b.value()) { }
+
+		inline const real_t value() const SFAD_NOEXCEPT { return (_diff < real_t(0)) ? _a.value() : _b.value(); }
+		inline const real_t gradient(std::size_t idx) const
+		{
+			if (_diff < real_t(0))
+				return _a.gradient(idx);
+			else if (_diff > real_t(0))
+				return _b.gradient(idx);
+			return std::min(_a.gradient(idx), _b.gradient(idx));
+		}
+
+	protected:
+		const A& _a;
+		const B& _b;
+		const real_t _diff;
+	};
+
+	template <class A, class B, typename real_t>
+	inline Fmin<A, B, real_t> fmin(const Expr<A, real_t>& a, const Expr<B, real_t>& b) SFAD_NOEXCEPT { return Fmin<A, B, real_t>(a.base(), b.base()); }
+
+
+	template <class A, typename real_t>
+	class FminScalar : public Expr<FminScalar<A,real_t>, real_t>
+	{
+	public:
+		FminScalar(const Expr<A, real_t>& a, const real_t b) SFAD_NOEXCEPT : _a(a.base()), _b(b), _diff(_a.value() - b) { }
+
+		inline const real_t value() const SFAD_NOEXCEPT { return (_diff < real_t(0)) ? _a.value() : _b; }
+		inline const real_t gradient(std::size_t idx) const
+		{
+			if (_diff < real_t(0))
+				return _a.gradient(idx);
+			else if (_diff > real_t(0))
+				return real_t(0);
+			return std::min(real_t(0), _a.gradient(idx));
+		}
+
+	protected:
+		const A& _a;
+		const real_t _b;
+		const real_t _diff;
+	};
+
+	template <class A, typename real_t>
+	inline FminScalar<A, real_t> fmin(const Expr<A, real_t>& a, const real_t b) SFAD_NOEXCEPT { return FminScalar<A, real_t>(a.base(), b); }
+
+	template <class A, typename real_t>
+	inline FminScalar<A, real_t> fmin(const real_t a, const Expr<A, real_t>& b) SFAD_NOEXCEPT { return FminScalar<A, real_t>(b.base(), a); }
+
+
+	// Branchless selection: the predicate is fixed at construction and applied uniformly to
+	// the value and all gradient slots, so evaluating the expression compiles to conditional
+	// moves instead of a data-dependent three-way branch per gradient slot. On ties, smax()
+	// and smin() return the first AD argument including its gradient, whereas fmax() and
+	// fmin() take the elementwise extremum of both gradients.
+
+	template <class A, class B, typename real_t>
+	class Sel : public Expr<Sel<A,B,real_t>, real_t>
+	{
+	public:
+		Sel(const bool cond, const Expr<A, real_t>& a, const Expr<B, real_t>& b) SFAD_NOEXCEPT : _cond(cond), _a(a.base()), _b(b.base()) { }
+
+		inline const real_t value() const SFAD_NOEXCEPT { return _cond ? _a.value() : _b.value(); }
+		inline const real_t gradient(std::size_t idx) const { return _cond ? _a.gradient(idx) : _b.gradient(idx); }
+
+	protected:
+		const bool _cond;
+		const A& _a;
+		const B& _b;
+	};
+
+	template <class A, class B, typename real_t>
+	inline Sel<A, B, real_t> sel(const bool cond, const Expr<A, real_t>& a, const Expr<B, real_t>& b) SFAD_NOEXCEPT { return Sel<A, B, real_t>(cond, a.base(), b.base()); }
+
+	template <class A, typename real_t>
+	class SelScalar : public Expr<SelScalar<A,real_t>, real_t>
+	{
+	public:
+		SelScalar(const bool cond, const Expr<A, real_t>& a, const real_t b) SFAD_NOEXCEPT : _cond(cond), _a(a.base()), _b(b) { }
+
+		inline const real_t value() const SFAD_NOEXCEPT { return _cond ? _a.value() : _b; }
+		inline const real_t gradient(std::size_t idx) const { return _cond ? _a.gradient(idx) : real_t(0); }
+
+	protected:
+		const bool _cond;
+		const A& _a;
+		const real_t _b;
+	};
+
+	template <class A, typename real_t>
+	inline SelScalar<A, real_t> sel(const bool cond, const Expr<A, real_t>& a, const real_t b) SFAD_NOEXCEPT { return SelScalar<A, real_t>(cond, a.base(), b); }
+
+	template <class A, typename real_t>
+	inline SelScalar<A, real_t> sel(const bool cond, const real_t a, const Expr<A, real_t>& b) SFAD_NOEXCEPT { return SelScalar<A, real_t>(!cond, b.base(), a); }
+
+	template <class A, class B, typename real_t>
+	inline Sel<A, B, real_t> smax(const Expr<A, real_t>& a, const Expr<B, real_t>& b) SFAD_NOEXCEPT { return Sel<A, B, real_t>(a.value() >= b.value(), a.base(), b.base()); }
+
+	template <class A, typename real_t>
+	inline SelScalar<A, real_t> smax(const Expr<A, real_t>& a, const real_t b) SFAD_NOEXCEPT { return SelScalar<A, real_t>(a.value() >= b, a.base(), b); }
+
+	template <class A, typename real_t>
+	inline SelScalar<A, real_t> smax(const real_t a, const Expr<A, real_t>& b) SFAD_NOEXCEPT { return SelScalar<A, real_t>(b.value() >= a, b.base(), a); }
+
+	template <class A, class B, typename real_t>
+	inline Sel<A, B, real_t> smin(const Expr<A, real_t>& a, const Expr<B, real_t>& b) SFAD_NOEXCEPT { return Sel<A, B, real_t>(a.value() <= b.value(), a.base(), b.base()); }
+
+	template <class A, typename real_t>
+	inline SelScalar<A, real_t> smin(const Expr<A, real_t>& a, const real_t b) SFAD_NOEXCEPT { return SelScalar<A, real_t>(a.value() <= b, a.base(), b); }
+
+	template <class A, typename real_t>
+	inline SelScalar<A, real_t> smin(const real_t a, const Expr<A, real_t>& b) SFAD_NOEXCEPT { return SelScalar<A, real_t>(b.value() <= a, b.base(), a); }
+
+	template <class A, class B, typename real_t> inline Fmax<A, B, real_t> max(const Expr<A, real_t>& a, const Expr<B, real_t>& b) SFAD_NOEXCEPT { return fmax(a, b); }
+	template <class A, typename real_t> inline FmaxScalar<A, real_t> max(const Expr<A, real_t>& a, const real_t b) SFAD_NOEXCEPT { return fmax(a, b); }
+	template <class A, typename real_t> inline FmaxScalar<A, real_t> max(const real_t a, const Expr<A, real_t>& b) SFAD_NOEXCEPT { return fmax(a, b); }
+	template <class A, class B, typename real_t> inline Fmin<A, B, real_t> min(const Expr<A, real_t>& a, const Expr<B, real_t>& b) SFAD_NOEXCEPT { return fmin(a, b); }
+	template <class A, typename real_t> inline FminScalar<A, real_t> min(const Expr<A, real_t>& a, const real_t b) SFAD_NOEXCEPT { return fmin(a, b); }
+	template <class A, typename real_t> inline FminScalar<A, real_t> min(const real_t a, const Expr<A, real_t>& b) SFAD_NOEXCEPT { return fmin(a, b); }
+
 	template <typename real_t, template <class T> class storage_t>
 	void swap(FwdET<real_t, storage_t>& x, FwdET<real_t, storage_t>& y) SFAD_NOEXCEPT
 	{
@@ -0,0 +1,520 @@
+// =============================================================================
+//  SFAD - Simple Forward Automatic Differentiation
+//
+//  Copyright © 2015-2017: Samuel Leweke¹
+//
+//    ¹ Forschungszentrum Juelich GmbH, IBG-1, Juelich, Germany.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#ifndef _SFAD_BATCH_HPP_
+#define _SFAD_BATCH_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+#include "sfad-common.hpp"
+
+namespace sfad
+{
+
+	namespace detail
+	{
+		// Tag type selecting the constructor that leaves the batch uninitialized
+		// (used for temporaries whose entries are overwritten entirely)
+		struct uninitializedBatchTag { };
+	}
+
+	/**
+	 * FwdBatch differentiates a batch of scalars (e.g., a strip of particle shells)
+	 * together and stores their gradients in direction-major order (structure of
+	 * arrays): the partial derivatives of all batch lanes with respect to one
+	 * direction are contiguous in memory. All operations apply elementwise per lane
+	 * and loop over the directions on the outside and the lanes on the inside, so
+	 * the compiler vectorizes across the lanes of the batch instead of across the
+	 * directions. This keeps the vector loops full when only few directions are
+	 * seeded (e.g., with compressed or colored seeding), where the per-scalar
+	 * gradient loops of Fwd become too short to vectorize profitably.
+	 *
+	 * Lanes are independent; there is no implicit broadcast between lanes except
+	 * for operations with a plain scalar, which apply the same scalar to all lanes.
+	 * Comparison operators are intentionally not provided since a batch has no
+	 * single truth value; value-dependent selections (fabs, fmax, fmin) branch per
+	 * lane instead. Batches are converted from and to arrays of ordinary AD
+	 * scalars via load() and store(), which transpose between the two layouts.
+	 */
+	template <typename real_t, std::size_t batch_size>
+	class FwdBatch
+	{
+	public:
+		typedef std::size_t idx_t;
+
+		static const idx_t lanes = batch_size;
+
+		FwdBatch() SFAD_NOEXCEPT
+		{
+			std::fill(_val, _val + batch_size, real_t(0));
+			setADValue(real_t(0));
+		}
+
+		explicit FwdBatch(const real_t val) SFAD_NOEXCEPT
+		{
+			std::fill(_val, _val + batch_size, val);
+			setADValue(real_t(0));
+		}
+
+		FwdBatch(const FwdBatch<real_t, batch_size>& cpy) SFAD_NOEXCEPT
+		{
+			std::copy(cpy._val, cpy._val + batch_size, _val);
+			copyGradient(cpy._grad);
+		}
+
+		FwdBatch<real_t, batch_size>& operator=(const FwdBatch<real_t, batch_size>& other) SFAD_NOEXCEPT
+		{
+			if (sfad_likely(this != &other))
+			{
+				std::copy(other._val, other._val + batch_size, _val);
+				copyGradient(other._grad);
+			}
+			return *this;
+		}
+
+		const idx_t gradientSize() const SFAD_NOEXCEPT { return detail::globalGradSize; }
+
+		// Per lane accessors
+
+		inline real_t getValue(const idx_t lane) const SFAD_NOEXCEPT { return _val[lane]; }
+		inline void setValue(const idx_t lane, const real_t v) SFAD_NOEXCEPT { _val[lane] = v; }
+
+		inline real_t getADValue(const idx_t dir, const idx_t lane) const SFAD_NOEXCEPT { return _grad[dir * batch_size + lane]; }
+		inline void setADValue(const idx_t dir, const idx_t lane, const real_t v) SFAD_NOEXCEPT { _grad[dir * batch_size + lane] = v; }
+
+		inline void setADValue(const real_t v) SFAD_NOEXCEPT
+		{
+			std::fill(_grad, _grad + detail::globalGradSize * batch_size, v);
+		}
+
+		// Direct access to the contiguous lane vector of one direction
+		inline real_t* gradientDir(const idx_t dir) SFAD_NOEXCEPT { return _grad + dir * batch_size; }
+		inline real_t const* gradientDir(const idx_t dir) const SFAD_NOEXCEPT { return _grad + dir * batch_size; }
+
+		// Layout conversion from and to arrays of ordinary AD scalars
+
+		/**
+		 * Gathers the values and gradients of @p src[0] to @p src[batch_size-1]
+		 * into the direction-major batch layout. The AD scalar type only has to
+		 * provide getValue() and getADValue(dir).
+		 */
+		template <typename ad_t>
+		inline void load(ad_t const* const src) SFAD_NOEXCEPT
+		{
+			for (idx_t l = 0; l < batch_size; ++l)
+				_val[l] = src[l].getValue();
+
+			for (idx_t i = 0; i < detail::globalGradSize; ++i)
+			{
+				real_t* const g = _grad + i * batch_size;
+				for (idx_t l = 0; l < batch_size; ++l)
+					g[l] = src[l].getADValue(i);
+			}
+		}
+
+		/**
+		 * Scatters the batch back to @p dst[0] to @p dst[batch_size-1]. The AD
+		 * scalar type only has to provide setValue() and setADValue(dir, v).
+		 */
+		template <typename ad_t>
+		inline void store(ad_t* const dst) const SFAD_NOEXCEPT
+		{
+			for (idx_t l = 0; l < batch_size; ++l)
+				dst[l].setValue(_val[l]);
+
+			for (idx_t i = 0; i < detail::globalGradSize; ++i)
+			{
+				real_t const* const g = _grad + i * batch_size;
+				for (idx_t l = 0; l < batch_size; ++l)
+					dst[l].setADValue(i, g[l]);
+			}
+		}
+
+		// Operators with non-temporary results
+
+		inline FwdBatch<real_t, batch_size>& operator=(const real_t v) SFAD_NOEXCEPT
+		{
+			std::fill(_val, _val + batch_size, v);
+			setADValue(real_t(0));
+			return *this;
+		}
+
+		inline FwdBatch<real_t, batch_size>& operator+=(const real_t v) SFAD_NOEXCEPT
+		{
+			for (idx_t l = 0; l < batch_size; ++l)
+				_val[l] += v;
+			return *this;
+		}
+
+		inline FwdBatch<real_t, batch_size>& operator+=(const FwdBatch<real_t, batch_size>& a) SFAD_NOEXCEPT
+		{
+			for (idx_t l = 0; l < batch_size; ++l)
+				_val[l] += a._val[l];
+			for (idx_t i = 0; i < detail::globalGradSize * batch_size; ++i)
+				_grad[i] += a._grad[i];
+			return *this;
+		}
+
+		inline FwdBatch<real_t, batch_size>& operator-=(const real_t v) SFAD_NOEXCEPT
+		{
+			for (idx_t l = 0; l < batch_size; ++l)
+				_val[l] -= v;
+			return *this;
+		}
+
+		inline FwdBatch<real_t, batch_size>& operator-=(const FwdBatch<real_t, batch_size>& a) SFAD_NOEXCEPT
+		{
+			for (idx_t l = 0; l < batch_size; ++l)
+				_val[l] -= a._val[l];
+			for (idx_t i = 0; i < detail::globalGradSize * batch_size; ++i)
+				_grad[i] -= a._grad[i];
+			return *this;
+		}
+
+		inline FwdBatch<real_t, batch_size>& operator*=(const real_t v) SFAD_NOEXCEPT
+		{
+			for (idx_t l = 0; l < batch_size; ++l)
+				_val[l] *= v;
+			for (idx_t i = 0; i < detail::globalGradSize * batch_size; ++i)
+				_grad[i] *= v;
+			return *this;
+		}
+
+		inline FwdBatch<real_t, batch_size>& operator*=(const FwdBatch<real_t, batch_size>& a) SFAD_NOEXCEPT
+		{
+			for (idx_t i = 0; i < detail::globalGradSize; ++i)
+			{
+				real_t* const g = _grad + i * batch_size;
+				real_t const* const ga = a._grad + i * batch_size;
+				for (idx_t l = 0; l < batch_size; ++l)
+					g[l] = a._val[l] * g[l] + _val[l] * ga[l];
+			}
+			for (idx_t l = 0; l < batch_size; ++l)
+				_val[l] *= a._val[l];
+			return *this;
+		}
+
+		inline FwdBatch<real_t, batch_size>& operator/=(const real_t v) SFAD_NOEXCEPT
+		{
+			for (idx_t l = 0; l < batch_size; ++l)
+				_val[l] /= v;
+			for (idx_t i = 0; i < detail::globalGradSize * batch_size; ++i)
+				_grad[i] /= v;
+			return *this;
+		}
+
+		inline FwdBatch<real_t, batch_size>& operator/=(const FwdBatch<real_t, batch_size>& a) SFAD_NOEXCEPT
+		{
+			for (idx_t i = 0; i < detail::globalGradSize; ++i)
+			{
+				real_t* const g = _grad + i * batch_size;
+				real_t const* const ga = a._grad + i * batch_size;
+				for (idx_t l = 0; l < batch_size; ++l)
+					g[l] = (g[l] * a._val[l] - _val[l] * ga[l]) / (a._val[l] * a._val[l]);
+			}
+			for (idx_t l = 0; l < batch_size; ++l)
+				_val[l] /= a._val[l];
+			return *this;
+		}
+
+		// Operators with temporary results
+
+		inline FwdBatch<real_t, batch_size> operator-() const SFAD_NOEXCEPT
+		{
+			FwdBatch<real_t, batch_size> res{detail::uninitializedBatchTag()};
+			for (idx_t l = 0; l < batch_size; ++l)
+				res._val[l] = -_val[l];
+			for (idx_t i = 0; i < detail::globalGradSize * batch_size; ++i)
+				res._grad[i] = -_grad[i];
+			return res;
+		}
+
+		inline FwdBatch<real_t, batch_size> operator+() const SFAD_NOEXCEPT { return *this; }
+
+		inline FwdBatch<real_t, batch_size> operator+(const real_t v) const SFAD_NOEXCEPT
+		{
+			FwdBatch<real_t, batch_size> res(*this);
+			res += v;
+			return res;
+		}
+
+		inline FwdBatch<real_t, batch_size> operator+(const FwdBatch<real_t, batch_size>& a) const SFAD_NOEXCEPT
+		{
+			FwdBatch<real_t, batch_size> res{detail::uninitializedBatchTag()};
+			for (idx_t l = 0; l < batch_size; ++l)
+				res._val[l] = _val[l] + a._val[l];
+			for (idx_t i = 0; i < detail::globalGradSize * batch_size; ++i)
+				res._grad[i] = _grad[i] + a._grad[i];
+			return res;
+		}
+
+		inline friend FwdBatch<real_t, batch_size> operator+(const real_t v, const FwdBatch<real_t, batch_size>& a) SFAD_NOEXCEPT
+		{
+			return a + v;
+		}
+
+		inline FwdBatch<real_t, batch_size> operator-(const real_t v) const SFAD_NOEXCEPT
+		{
+			FwdBatch<real_t, batch_size> res(*this);
+			res -= v;
+			return res;
+		}
+
+		inline FwdBatch<real_t, batch_size> operator-(const FwdBatch<real_t, batch_size>& a) const SFAD_NOEXCEPT
+		{
+			FwdBatch<real_t, batch_size> res{detail::uninitializedBatchTag()};
+			for (idx_t l = 0; l < batch_size; ++l)
+				res._val[l] = _val[l] - a._val[l];
+			for (idx_t i = 0; i < detail::globalGradSize * batch_size; ++i)
+				res._grad[i] = _grad[i] - a._grad[i];
+			return res;
+		}
+
+		inline friend FwdBatch<real_t, batch_size> operator-(const real_t v, const FwdBatch<real_t, batch_size>& a) SFAD_NOEXCEPT
+		{
+			FwdBatch<real_t, batch_size> res{detail::uninitializedBatchTag()};
+			for (idx_t l = 0; l < batch_size; ++l)
+				res._val[l] = v - a._val[l];
+			for (idx_t i = 0; i < detail::globalGradSize * batch_size; ++i)
+				res._grad[i] = -a._grad[i];
+			return res;
+		}
+
+		inline FwdBatch<real_t, batch_size> operator*(const real_t v) const SFAD_NOEXCEPT
+		{
+			FwdBatch<real_t, batch_size> res{detail::uninitializedBatchTag()};
+			for (idx_t l = 0; l < batch_size; ++l)
+				res._val[l] = _val[l] * v;
+			for (idx_t i = 0; i < detail::globalGradSize * batch_size; ++i)
+				res._grad[i] = _grad[i] * v;
+			return res;
+		}
+
+		inline FwdBatch<real_t, batch_size> operator*(const FwdBatch<real_t, batch_size>& a) const SFAD_NOEXCEPT
+		{
+			FwdBatch<real_t, batch_size> res{detail::uninitializedBatchTag()};
+			for (idx_t l = 0; l < batch_size; ++l)
+				res._val[l] = _val[l] * a._val[l];
+			for (idx_t i = 0; i < detail::globalGradSize; ++i)
+			{
+				real_t* const gr = res._grad + i * batch_size;
+				real_t const* const g = _grad + i * batch_size;
+				real_t const* const ga = a._grad + i * batch_size;
+				for (idx_t l = 0; l < batch_size; ++l)
+					gr[l] = a._val[l] * g[l] + _val[l] * ga[l];
+			}
+			return res;
+		}
+
+		inline friend FwdBatch<real_t, batch_size> operator*(const real_t v, const FwdBatch<real_t, batch_size>& a) SFAD_NOEXCEPT
+		{
+			return a * v;
+		}
+
+		inline FwdBatch<real_t, batch_size> operator/(const real_t v) const SFAD_NOEXCEPT
+		{
+			FwdBatch<real_t, batch_size> res{detail::uninitializedBatchTag()};
+			for (idx_t l = 0; l < batch_size; ++l)
+				res._val[l] = _val[l] / v;
+			for (idx_t i = 0; i < detail::globalGradSize * batch_size; ++i)
+				res._grad[i] = _grad[i] / v;
+			return res;
+		}
+
+		inline FwdBatch<real_t, batch_size> operator/(const FwdBatch<real_t, batch_size>& a) const SFAD_NOEXCEPT
+		{
+			FwdBatch<real_t, batch_size> res{detail::uninitializedBatchTag()};
+			for (idx_t l = 0; l < batch_size; ++l)
+				res._val[l] = _val[l] / a._val[l];
+			for (idx_t i = 0; i < detail::globalGradSize; ++i)
+			{
+				real_t* const gr = res._grad + i * batch_size;
+				real_t const* const g = _grad + i * batch_size;
+				real_t const* const ga = a._grad + i * batch_size;
+				for (idx_t l = 0; l < batch_size; ++l)
+					gr[l] = (g[l] * a._val[l] - _val[l] * ga[l]) / (a._val[l] * a._val[l]);
+			}
+			return res;
+		}
+
+		inline friend FwdBatch<real_t, batch_size> operator/(const real_t v, const FwdBatch<real_t, batch_size>& a) SFAD_NOEXCEPT
+		{
+			FwdBatch<real_t, batch_size> res{detail::uninitializedBatchTag()};
+			for (idx_t l = 0; l < batch_size; ++l)
+				res._val[l] = v / a._val[l];
+			for (idx_t i = 0; i < detail::globalGradSize; ++i)
+			{
+				real_t* const gr = res._grad + i * batch_size;
+				real_t const* const ga = a._grad + i * batch_size;
+				for (idx_t l = 0; l < batch_size; ++l)
+					gr[l] = -v * ga[l] / (a._val[l] * a._val[l]);
+			}
+			return res;
+		}
+
+		// Math functions
+		template <typename T, std::size_t N> inline friend FwdBatch<T, N> exp(const FwdBatch<T, N>& a);
+		template <typename T, std::size_t N> inline friend FwdBatch<T, N> log(const FwdBatch<T, N>& a);
+		template <typename T, std::size_t N> inline friend FwdBatch<T, N> sqrt(const FwdBatch<T, N>& a);
+		template <typename T, std::size_t N> inline friend FwdBatch<T, N> sqr(const FwdBatch<T, N>& a);
+		template <typename T, std::size_t N> inline friend FwdBatch<T, N> pow(const FwdBatch<T, N>& a, T v);
+		template <typename T, std::size_t N> inline friend FwdBatch<T, N> fabs(const FwdBatch<T, N>& a);
+		template <typename T, std::size_t N> inline friend FwdBatch<T, N> fmax(const FwdBatch<T, N>& a, const FwdBatch<T, N>& b);
+		template <typename T, std::size_t N> inline friend FwdBatch<T, N> fmin(const FwdBatch<T, N>& a, const FwdBatch<T, N>& b);
+
+	protected:
+		explicit FwdBatch(detail::uninitializedBatchTag) SFAD_NOEXCEPT { }
+
+		alignas(SFAD_ALIGNMENT) real_t _val[batch_size];
+		alignas(SFAD_ALIGNMENT) real_t _grad[SFAD_PADDED_DIR * batch_size];
+
+		void copyGradient(real_t const* const cpy) SFAD_NOEXCEPT
+		{
+			std::copy(cpy, cpy + detail::globalGradSize * batch_size, _grad);
+		}
+	};
+
+	template <typename real_t, std::size_t batch_size>
+	inline FwdBatch<real_t, batch_size> exp(const FwdBatch<real_t, batch_size>& a)
+	{
+		FwdBatch<real_t, batch_size> res(a);
+		for (std::size_t l = 0; l < batch_size; ++l)
+			res._val[l] = std::exp(a._val[l]);
+		for (std::size_t i = 0; i < detail::globalGradSize; ++i)
+		{
+			real_t* const g = res._grad + i * batch_size;
+			for (std::size_t l = 0; l < batch_size; ++l)
+				g[l] *= res._val[l];
+		}
+		return res;
+	}
+
+	template <typename real_t, std::size_t batch_size>
+	inline FwdBatch<real_t, batch_size> log(const FwdBatch<real_t, batch_size>& a)
+	{
+		FwdBatch<real_t, batch_size> res(a);
+		for (std::size_t l = 0; l < batch_size; ++l)
+			res._val[l] = std::log(a._val[l]);
+		for (std::size_t i = 0; i < detail::globalGradSize; ++i)
+		{
+			real_t* const g = res._grad + i * batch_size;
+			for (std::size_t l = 0; l < batch_size; ++l)
+				g[l] /= a._val[l];
+		}
+		return res;
+	}
+
+	template <typename real_t, std::size_t batch_size>
+	inline FwdBatch<real_t, batch_size> sqrt(const FwdBatch<real_t, batch_size>& a)
+	{
+		FwdBatch<real_t, batch_size> res(a);
+		for (std::size_t l = 0; l < batch_size; ++l)
+			res._val[l] = std::sqrt(a._val[l]);
+		for (std::size_t i = 0; i < detail::globalGradSize; ++i)
+		{
+			real_t* const g = res._grad + i * batch_size;
+			for (std::size_t l = 0; l < batch_size; ++l)
+				g[l] /= real_t(2) * res._val[l];
+		}
+		return res;
+	}
+
+	template <typename real_t, std::size_t batch_size>
+	inline FwdBatch<real_t, batch_size> sqr(const FwdBatch<real_t, batch_size>& a)
+	{
+		FwdBatch<real_t, batch_size> res(a);
+		for (std::size_t l = 0; l < batch_size; ++l)
+			res._val[l] = a._val[l] * a._val[l];
+		for (std::size_t i = 0; i < detail::globalGradSize; ++i)
+		{
+			real_t* const g = res._grad + i * batch_size;
+			for (std::size_t l = 0; l < batch_size; ++l)
+				g[l] *= real_t(2) * a._val[l];
+		}
+		return res;
+	}
+
+	template <typename real_t, std::size_t batch_size>
+	inline FwdBatch<real_t, batch_size> pow(const FwdBatch<real_t, batch_size>& a, real_t v)
+	{
+		FwdBatch<real_t, batch_size> res(a);
+		for (std::size_t l = 0; l < batch_size; ++l)
+			res._val[l] = std::pow(a._val[l], v);
+		for (std::size_t i = 0; i < detail::globalGradSize; ++i)
+		{
+			real_t* const g = res._grad + i * batch_size;
+			for (std::size_t l = 0; l < batch_size; ++l)
+				g[l] *= v * std::pow(a._val[l], v - real_t(1));
+		}
+		return res;
+	}
+
+	template <typename real_t, std::size_t batch_size>
+	inline FwdBatch<real_t, batch_size> fabs(const FwdBatch<real_t, batch_size>& a)
+	{
+		FwdBatch<real_t, batch_size> res(a);
+		for (std::size_t l = 0; l < batch_size; ++l)
+			res._val[l] = std::abs(a._val[l]);
+		for (std::size_t i = 0; i < detail::globalGradSize; ++i)
+		{
+			real_t* const g = res._grad + i * batch_size;
+			for (std::size_t l = 0; l < batch_size; ++l)
+			{
+				if (a._val[l] < real_t(0))
+					g[l] = -g[l];
+			}
+		}
+		return res;
+	}
+
+	template <typename real_t, std::size_t batch_size>
+	inline FwdBatch<real_t, batch_size> fmax(const FwdBatch<real_t, batch_size>& a, const FwdBatch<real_t, batch_size>& b)
+	{
+		FwdBatch<real_t, batch_size> res(a);
+		for (std::size_t l = 0; l < batch_size; ++l)
+		{
+			if (b._val[l] > a._val[l])
+			{
+				res._val[l] = b._val[l];
+				for (std::size_t i = 0; i < detail::globalGradSize; ++i)
+					res._grad[i * batch_size + l] = b._grad[i * batch_size + l];
+			}
+		}
+		return res;
+	}
+
+	template <typename real_t, std::size_t batch_size>
+	inline FwdBatch<real_t, batch_size> fmin(const FwdBatch<real_t, batch_size>& a, const FwdBatch<real_t, batch_size>& b)
+	{
+		FwdBatch<real_t, batch_size> res(a);
+		for (std::size_t l = 0; l < batch_size; ++l)
+		{
+			if (b._val[l] < a._val[l])
+			{
+				res._val[l] = b._val[l];
+				for (std::size_t i = 0; i < detail::globalGradSize; ++i)
+					res._grad[i * batch_size + l] = b._grad[i * batch_size + l];
+			}
+		}
+		return res;
+	}
+
+	template <typename real_t, std::size_t batch_size> inline FwdBatch<real_t, batch_size> max(const FwdBatch<real_t, batch_size>& a, const FwdBatch<real_t, batch_size>& b) { return fmax(a, b); }
+	template <typename real_t, std::size_t batch_size> inline FwdBatch<real_t, batch_size> min(const FwdBatch<real_t, batch_size>& a, const FwdBatch<real_t, batch_size>& b) { return fmin(a, b); }
+	template <typename real_t, std::size_t batch_size> inline FwdBatch<real_t, batch_size> abs(const FwdBatch<real_t, batch_size>& a) { return fabs(a); }
+
+}
+
+#endif
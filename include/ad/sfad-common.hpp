@@ -18,6 +18,23 @@
 	#define SFAD_DEFAULT_DIR 80
 #endif
 
+// Number of scalars per SIMD vector the gradient arrays are padded to.
+// Padding the storage to a full vector width allows the compiler to emit
+// vector loops without a scalar remainder.
+#ifndef SFAD_SIMD_WIDTH
+	#define SFAD_SIMD_WIDTH 4
+#endif
+
+// Alignment of the gradient arrays in bytes. Must not exceed the alignment
+// guaranteed by operator new (16 bytes on common 64 bit platforms), since
+// AD datatypes are also allocated on the heap.
+#ifndef SFAD_ALIGNMENT
+	#define SFAD_ALIGNMENT 16
+#endif
+
+// Gradient array length padded to the next multiple of the SIMD width
+#define SFAD_PADDED_DIR (((SFAD_DEFAULT_DIR + SFAD_SIMD_WIDTH - 1) / SFAD_SIMD_WIDTH) * SFAD_SIMD_WIDTH)
+
 #ifndef SFAD_GLOBAL_GRAD_SIZE
 	#define SFAD_GLOBAL_GRAD_SIZE std::size_t sfad::detail::globalGradSize = SFAD_DEFAULT_DIR;
 #endif
@@ -89,12 +106,20 @@
 
 
 #include <algorithm>
+#include <vector>
+#include <mutex>
 
 namespace sfad
 {
 	namespace detail
 	{
 		extern std::size_t globalGradSize;
+
+		// Rounds a gradient size up to the next multiple of the SIMD width
+		inline std::size_t paddedGradSize(const std::size_t n) SFAD_NOEXCEPT
+		{
+			return ((n + SFAD_SIMD_WIDTH - 1) / SFAD_SIMD_WIDTH) * SFAD_SIMD_WIDTH;
+		}
 	}
 
 	static void setGradientSize(const std::size_t n) SFAD_NOEXCEPT
@@ -112,12 +137,12 @@ namespace sfad
 	class HeapStorage
 	{
 	public:
-		HeapStorage() : _grad(new real_t[detail::globalGradSize]) { }
+		HeapStorage() : _grad(new real_t[detail::paddedGradSize(detail::globalGradSize)]) { }
 		HeapStorage(HeapStorage<real_t>&& other) SFAD_NOEXCEPT : _grad(other._grad)
 		{
 			other._grad = 0;
 		}
-		HeapStorage(const HeapStorage<real_t>& cpy) : _grad(new real_t[detail::globalGradSize])
+		HeapStorage(const HeapStorage<real_t>& cpy) : _grad(new real_t[detail::paddedGradSize(detail::globalGradSize)])
 		{
 			copyGradient(cpy._grad);
 		}
@@ -131,7 +156,7 @@ namespace sfad
 		{
 			delete[] _grad;
 
-			_grad = new real_t[detail::globalGradSize];
+			_grad = new real_t[detail::paddedGradSize(detail::globalGradSize)];
 			std::fill(_grad, _grad + detail::globalGradSize, real_t(0));
 		}
 
@@ -153,6 +178,148 @@ namespace sfad
 	};
 
 
+	namespace detail
+	{
+		// Arena handing out aligned, pooled gradient arrays of the current runtime size.
+		// Chunks are carved from large slabs and recycled through a free list, so the
+		// per-object cost is far below a heap allocation. When the gradient size changes
+		// via setGradientSize(), the free list is dropped and new chunks are carved;
+		// stale chunks remain in their slab until the arena is destroyed.
+		template <typename real_t>
+		class GradientArena
+		{
+		public:
+			static GradientArena& instance()
+			{
+				static GradientArena arena;
+				return arena;
+			}
+
+			real_t* allocate()
+			{
+				std::lock_guard<std::mutex> guard(_mutex);
+
+				const std::size_t elems = paddedGradSize(globalGradSize);
+				if (elems != _chunkElems)
+				{
+					// Gradient size changed: chunks of the old size cannot be reused
+					_freeList.clear();
+					_slabPos = 0;
+					_slabEnd = 0;
+					_chunkElems = elems;
+				}
+
+				if (!_freeList.empty())
+				{
+					real_t* const p = _freeList.back();
+					_freeList.pop_back();
+					return p;
+				}
+
+				if (!_slabPos || (_slabPos + chunkStride() > _slabEnd))
+					addSlab();
+
+				char* const raw = _slabPos;
+				_slabPos += chunkStride();
+
+				// Record the chunk size in the padding in front of the gradient array
+				*reinterpret_cast<std::size_t*>(raw) = _chunkElems;
+				return reinterpret_cast<real_t*>(raw + SFAD_ALIGNMENT);
+			}
+
+			void deallocate(real_t* const p) SFAD_NOEXCEPT
+			{
+				if (!p)
+					return;
+
+				std::lock_guard<std::mutex> guard(_mutex);
+
+				// Only chunks of the current size are recycled; stale ones stay in their slab
+				char* const raw = reinterpret_cast<char*>(p) - SFAD_ALIGNMENT;
+				if (*reinterpret_cast<std::size_t*>(raw) == _chunkElems)
+					_freeList.push_back(p);
+			}
+
+		private:
+			GradientArena() SFAD_NOEXCEPT : _chunkElems(0), _slabPos(0), _slabEnd(0) { }
+			~GradientArena() SFAD_NOEXCEPT
+			{
+				for (std::size_t i = 0; i < _slabs.size(); ++i)
+					delete[] _slabs[i];
+			}
+
+			GradientArena(const GradientArena&);
+			GradientArena& operator=(const GradientArena&);
+
+			// Distance between chunks; the leading SFAD_ALIGNMENT bytes hold the chunk size
+			// and keep the gradient array aligned since the padded payload is a multiple
+			// of the alignment as well
+			std::size_t chunkStride() const SFAD_NOEXCEPT { return SFAD_ALIGNMENT + _chunkElems * sizeof(real_t); }
+
+			void addSlab()
+			{
+				const std::size_t bytes = std::max<std::size_t>(std::size_t(65536), std::size_t(64) * chunkStride());
+				char* const slab = new char[bytes];
+				_slabs.push_back(slab);
+				_slabPos = slab;
+				_slabEnd = slab + bytes;
+			}
+
+			std::size_t _chunkElems;
+			char* _slabPos;
+			char* _slabEnd;
+			std::vector<char*> _slabs;
+			std::vector<real_t*> _freeList;
+			std::mutex _mutex;
+		};
+	}
+
+
+	template <typename real_t>
+	class ArenaStorage
+	{
+	public:
+		ArenaStorage() : _grad(detail::GradientArena<real_t>::instance().allocate()) { }
+		ArenaStorage(ArenaStorage<real_t>&& other) SFAD_NOEXCEPT : _grad(other._grad)
+		{
+			other._grad = 0;
+		}
+		ArenaStorage(const ArenaStorage<real_t>& cpy) : _grad(detail::GradientArena<real_t>::instance().allocate())
+		{
+			copyGradient(cpy._grad);
+		}
+
+		~ArenaStorage() SFAD_NOEXCEPT
+		{
+			detail::GradientArena<real_t>::instance().deallocate(_grad);
+		}
+
+		void resizeGradient()
+		{
+			detail::GradientArena<real_t>::instance().deallocate(_grad);
+
+			_grad = detail::GradientArena<real_t>::instance().allocate();
+			std::fill(_grad, _grad + detail::globalGradSize, real_t(0));
+		}
+
+	protected:
+		real_t* _grad;
+
+		void moveAssign(ArenaStorage&& other) SFAD_NOEXCEPT
+		{
+			detail::GradientArena<real_t>::instance().deallocate(_grad);
+
+			_grad = other._grad;
+			other._grad = 0;
+		}
+
+		void copyGradient(real_t const* const cpy)
+		{
+			std::copy(cpy, cpy + detail::globalGradSize, _grad);
+		}
+	};
+
+
 	template <typename real_t>
 	class StackStorage
 	{
@@ -167,7 +334,7 @@ namespace sfad
 		void resizeGradient() SFAD_NOEXCEPT { }
 
 	protected:
-		real_t _grad[SFAD_DEFAULT_DIR];
+		alignas(SFAD_ALIGNMENT) real_t _grad[SFAD_PADDED_DIR];
 
 		void moveAssign(StackStorage&& other) SFAD_NOEXCEPT
 		{
@@ -101,6 +101,10 @@ namespace sfad
 		inline real_t& operator[](const idx_t idx) { return storage_t<real_t>::_grad[idx]; }
 		inline const real_t operator[](const idx_t idx) const { return storage_t<real_t>::_grad[idx]; }
 
+		// Direct access to the contiguous gradient array for bulk extraction kernels
+		inline real_t* gradientVec() SFAD_NOEXCEPT { return storage_t<real_t>::_grad; }
+		inline real_t const* gradientVec() const SFAD_NOEXCEPT { return storage_t<real_t>::_grad; }
+
 		explicit operator real_t() const SFAD_NOEXCEPT { return _val; }
 
 		// Operators with non-temporary results
@@ -346,6 +350,10 @@ namespace sfad
 		template<typename T, template <class T2> class s_t> inline friend Fwd<T, s_t> fmin(T v, const Fwd<T, s_t> &a);
 		template<typename T, template <class T2> class s_t> inline friend Fwd<T, s_t> fmin(const Fwd<T, s_t> &a, T v);
 
+		template<typename T, template <class T2> class s_t> inline friend Fwd<T, s_t> sel(const bool cond, const Fwd<T, s_t> &a, const Fwd<T, s_t> &b);
+		template<typename T, template <class T2> class s_t> inline friend Fwd<T, s_t> sel(const bool cond, const Fwd<T, s_t> &a, T v);
+		template<typename T, template <class T2> class s_t> inline friend Fwd<T, s_t> sel(const bool cond, T v, const Fwd<T, s_t> &a);
+
 	protected:
 		Fwd(const real_t val, bool dummy) : storage_t<real_t>(), _val(val) { }
 
@@ -787,6 +795,57 @@ namespace sfad
 		return res;
 	}
 
+	// Branchless selection: the predicate is evaluated once and applied uniformly to the value
+	// and all gradient slots, so the loop over the gradient compiles to conditional moves or
+	// SIMD blends instead of a data-dependent three-way branch. On ties, smax() and smin()
+	// return the first AD argument including its gradient, whereas fmax() and fmin() take
+	// the elementwise extremum of both gradients.
+
+	template <typename real_t, template <class T> class storage_t>
+	inline Fwd<real_t, storage_t> sel(const bool cond, const Fwd<real_t, storage_t> &a, const Fwd<real_t, storage_t> &b)
+	{
+		Fwd<real_t, storage_t> res(cond ? a._val : b._val, false);
+		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
+			res._grad[i] = cond ? a._grad[i] : b._grad[i];
+		return res;
+	}
+
+	template <typename real_t, template <class T> class storage_t>
+	inline Fwd<real_t, storage_t> sel(const bool cond, const Fwd<real_t, storage_t> &a, real_t v)
+	{
+		Fwd<real_t, storage_t> res(cond ? a._val : v, false);
+		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
+			res._grad[i] = cond ? a._grad[i] : real_t(0);
+		return res;
+	}
+
+	template <typename real_t, template <class T> class storage_t>
+	inline Fwd<real_t, storage_t> sel(const bool cond, real_t v, const Fwd<real_t, storage_t> &a)
+	{
+		Fwd<real_t, storage_t> res(cond ? v : a._val, false);
+		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
+			res._grad[i] = cond ? real_t(0) : a._grad[i];
+		return res;
+	}
+
+	template <typename real_t, template <class T> class storage_t>
+	inline Fwd<real_t, storage_t> smax (const Fwd<real_t, storage_t> &a, const Fwd<real_t, storage_t> &b) { return sel(a >= b, a, b); }
+
+	template <typename real_t, template <class T> class storage_t>
+	inline Fwd<real_t, storage_t> smax (const Fwd<real_t, storage_t> &a, real_t v) { return sel(a >= v, a, v); }
+
+	template <typename real_t, template <class T> class storage_t>
+	inline Fwd<real_t, storage_t> smax (real_t v, const Fwd<real_t, storage_t> &a) { return sel(v > a, v, a); }
+
+	template <typename real_t, template <class T> class storage_t>
+	inline Fwd<real_t, storage_t> smin (const Fwd<real_t, storage_t> &a, const Fwd<real_t, storage_t> &b) { return sel(a <= b, a, b); }
+
+	template <typename real_t, template <class T> class storage_t>
+	inline Fwd<real_t, storage_t> smin (const Fwd<real_t, storage_t> &a, real_t v) { return sel(a <= v, a, v); }
+
+	template <typename real_t, template <class T> class storage_t>
+	inline Fwd<real_t, storage_t> smin (real_t v, const Fwd<real_t, storage_t> &a) { return sel(v < a, v, a); }
+
 	template <typename real_t, template <class T> class storage_t> inline Fwd<real_t, storage_t> max (const Fwd<real_t, storage_t> &a, const Fwd<real_t, storage_t> &b) { return fmax(a, b); }
 	template <typename real_t, template <class T> class storage_t> inline Fwd<real_t, storage_t> max (real_t v, const Fwd<real_t, storage_t> &a) { return fmax(v, a); }
 	template <typename real_t, template <class T> class storage_t> inline Fwd<real_t, storage_t> max (const Fwd<real_t, storage_t> &a, real_t v) { return fmax(a, v); }
@@ -71,6 +71,15 @@ public:
 	 */
 	virtual double timeDerivative(double t, double z, double r, unsigned int sec) = 0;
 
+	/**
+	 * @brief Returns whether the function value varies with the radial position in the bead
+	 * @details Profiles that are constant in the radial coordinate @p r allow callers to
+	 *          evaluate the profile once per column cell and time and reuse the value for
+	 *          all particle shells. The default is @c true, which disables such caching.
+	 * @return @c true if externalProfile() depends on @p r, otherwise @c false
+	 */
+	virtual bool dependsOnRadialPosition() const CADET_NOEXCEPT { return true; }
+
 	/**
 	 * @brief Sets the section time vector
 	 * @details The integration time is partitioned into sections. All parameters and
@@ -98,6 +98,48 @@ public:
 	 */
 	virtual void timeDerivative(double t, unsigned int sec, double* timeDerivative) = 0;
 
+	/**
+	 * @brief Returns the inlet concentration and its time derivative at a given time for all components
+	 * @details The default implementation calls inletConcentration() and timeDerivative() one after
+	 *          another. Implementations are encouraged to override this function if both quantities
+	 *          can be computed cheaper in a single pass (e.g., sharing a polynomial evaluation).
+	 *
+	 * @param [in]  t         Absolute simulation time
+	 * @param [in]  sec       Index of the current time section
+	 * @param [out] inletConc Pointer to first element of contiguous array receiving the inlet concentration of all components
+	 * @param [out] inletDeriv Pointer to first element of contiguous array receiving the time derivative of all components
+	 */
+	virtual void inletConcentrationAndDerivative(double t, unsigned int sec, double* inletConc, double* inletDeriv)
+	{
+		inletConcentration(t, sec, inletConc);
+		timeDerivative(t, sec, inletDeriv);
+	}
+
+	/**
+	 * @brief Returns the exact concentration jump at the transition into the given section
+	 * @details The jump is located exactly at the section boundary, that is, at the start time of
+	 *          section @p sec. Its magnitude is the difference between the value of section @p sec
+	 *          at its start time and the limit of section <tt>sec - 1</tt> at the same time point.
+	 *          A jump of @c 0.0 in all components indicates an exactly continuous transition.
+	 *
+	 *          Profiles that know their discontinuities in closed form (e.g., piecewise polynomials)
+	 *          should override this function. The time integrator uses the metadata to apply the
+	 *          jump as an exact state update followed by a lean reinitialization instead of
+	 *          resolving the discontinuity by collapsing step sizes or a full consistent
+	 *          initialization. The default implementation returns @c false, which means that the
+	 *          jump is unknown and the caller has to assume an arbitrary discontinuity.
+	 *
+	 * @param [in]  sec  Index of the section that is about to be entered (the transition occurs
+	 *              at the start time of this section); the first section (@c 0) has no transition
+	 * @param [out] jump Pointer to first element of contiguous array receiving the jump magnitude
+	 *              of all components (only valid if @c true is returned)
+	 * @return @c true if the jump at this transition is exactly known, otherwise @c false
+	 */
+	virtual bool sectionTransitionJump(unsigned int sec, double* jump)
+	{
+		return false;
+	}
+
 	/**
 	 * @brief Returns the second derivative of all components with respect to a given parameter and time
 	 * @details The given parameter @p id matches one of the availableParameters() (when unit operation id is ignored).
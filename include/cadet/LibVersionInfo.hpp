@@ -72,6 +72,12 @@ extern "C"
 	 * @return Git refspec
 	 */
 	CADET_API const char* cadetGetLibraryBuildHost();
+
+	/**
+	 * @brief Returns whether the library was built with deterministic (fixed-order) reductions
+	 * @return @c 1 if deterministic reductions are enabled, otherwise @c 0
+	 */
+	CADET_API int cadetGetLibraryDeterministicReductions();
 }
 
 namespace cadet
@@ -134,6 +140,16 @@ namespace cadet
 	 * @return Git refspec
 	 */
 	CADET_API const char* getLibraryBuildHost() CADET_NOEXCEPT;
+
+	/**
+	 * @brief Returns whether the library was built with deterministic (fixed-order) reductions
+	 * @details If enabled (CMake option DETERMINISTIC_REDUCTIONS), all reductions are
+	 *          guaranteed to accumulate in a fixed order regardless of the thread count,
+	 *          which makes results bitwise reproducible across machines.
+	 * @sa cadetGetLibraryDeterministicReductions()
+	 * @return @c true if deterministic reductions are enabled, otherwise @c false
+	 */
+	CADET_API bool getLibraryDeterministicReductions() CADET_NOEXCEPT;
 } // namespace cadet
 
 #endif  // LIBCADET_LIBVERSIONINFO_HPP_
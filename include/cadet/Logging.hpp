@@ -144,6 +144,9 @@ namespace cadet
 
 	/**
 	 * @brief Sets the log receiver replacing any previously set receiver
+	 * @details Thread-safe. The receiver is shared by all simulators in the process; messages
+	 *          from concurrent threads are delivered to it one at a time, so the receiver does
+	 *          not need to synchronize internally (see @ref threadsafety).
 	 * @param [in] recv Pointer to ILogReceiver implementation or @c nullptr
 	 * @sa cadetSetLogReceiver()
 	 */
@@ -163,6 +166,15 @@ namespace cadet
 	 */
 	CADET_API LogLevel getLogLevel();
 
+	/**
+	 * @brief Formats buffered log messages and forwards them to the registered ILogReceiver
+	 * @details If libcadet was built with deferred logging (@c CADET_DEFERRED_LOGGING), log
+	 *          messages are recorded in a binary ring buffer without formatting. This function
+	 *          drains the buffer, formats the most recent messages, and delivers them to the
+	 *          receiver. Does nothing if deferred logging is not enabled.
+	 */
+	CADET_API void drainLogs();
+
 } // namespace cadet
 
 extern "C"
@@ -186,6 +198,12 @@ extern "C"
 	 * @return Current log level
 	 */
 	CADET_API unsigned int cadetGetLogLevel();
+
+	/**
+	 * @brief Formats buffered log messages and forwards them to the registered ILogReceiver
+	 * @details Does nothing if deferred logging is not enabled.
+	 */
+	CADET_API void cadetDrainLogs();
 }
 
 #endif  // LIBCADET_LOGGING_HPP_
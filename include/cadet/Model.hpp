@@ -19,6 +19,7 @@
 #define LIBCADET_MODEL_HPP_
 
 #include <unordered_map>
+#include <cstddef>
 #ifdef CADET_BENCHMARK_MODE
 	#include <vector>
 #endif
@@ -30,6 +31,21 @@
 namespace cadet
 {
 
+/**
+ * @brief Estimated computational cost of one integrator time step
+ * @details Produced by a static cost model over the discretization sizes, stencil and
+ *          Jacobian bandwidths, and the number of AD directions. The estimates are order
+ *          of magnitude figures intended for placing jobs by their expected load (e.g.,
+ *          co-locating small simulations on a shared node and isolating large ones), not
+ *          for exact accounting.
+ */
+struct CostEstimate
+{
+	double flopsPerStep; //!< Estimated floating point operations per integrator step
+	double bytesPerStep; //!< Estimated bytes moved to and from memory per integrator step
+	std::size_t memory; //!< Predicted heap memory footprint in bytes (see IModel::memoryFootprint())
+};
+
 /**
  * @brief Interface common to all unit operation models
  * @details Users of the library are not supposed to implement this interface! The simulator provided
@@ -90,6 +106,30 @@ public:
 	 */
 	virtual void useAnalyticJacobian(const bool analyticJac) = 0;
 
+	/**
+	 * @brief Returns the amount of heap memory held by the unit operation in bytes
+	 * @details Covers the internal data structures of the unit operation (e.g., Jacobian
+	 *          matrices, workspaces) that are sized by the discretization. The value is
+	 *          available as soon as the model has been fully configured, that is, before
+	 *          the time integration is started, so that jobs can be placed by their
+	 *          predicted footprint. Thread local workspaces are counted once, they are
+	 *          replicated per thread in parallel builds. Memory owned by the simulator
+	 *          (state vectors, AD directions) and the solution recorders is not included.
+	 * @return Memory footprint in bytes
+	 */
+	virtual std::size_t memoryFootprint() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Estimates the computational cost of one integrator time step
+	 * @details Evaluates a static cost model over the discretization sizes, the stencil
+	 *          and Jacobian bandwidths, and the given number of AD directions. The
+	 *          estimate is available as soon as the model has been fully configured,
+	 *          that is, before the time integration is started.
+	 * @param [in] numSensParams Number of sensitive parameters the simulation will carry
+	 * @return Estimated cost of one integrator step
+	 */
+	virtual CostEstimate costEstimate(unsigned int numSensParams) const CADET_NOEXCEPT = 0;
+
 #ifdef CADET_BENCHMARK_MODE
 	/**
 	 * @brief Returns a vector with benchmark timings in seconds
@@ -103,6 +143,16 @@ public:
 	 * @return Descriptions of benchmark timings
 	 */
 	virtual char const* const* benchmarkDescriptions() const = 0;
+
+	/**
+	 * @brief Returns accumulated residual evaluation cost per discretization cell
+	 * @details The cost is measured in CPU cycles (or clock ticks on platforms without a
+	 *          cycle counter) and aggregated over all residual evaluations of the run. The
+	 *          layout of the vector is model specific (e.g., one entry per axial cell).
+	 *          Models that do not provide per-cell accounting return an empty vector.
+	 * @return Accumulated cost per cell, or an empty vector
+	 */
+	virtual std::vector<double> benchmarkCellTimings() const { return std::vector<double>(); }
 #endif
 };
 
@@ -141,6 +141,8 @@ public:
 
 	/**
 	 * @brief Registers an inlet profile type
+	 * @details May only be called during initialization of this builder, before models are
+	 *          created (see @ref threadsafety).
 	 * @param [in] name Name of the inlet profile type
 	 * @param [in] factory Factory function that creates the registered IInletProfile
 	 */
@@ -148,6 +150,8 @@ public:
 
 	/**
 	 * @brief Registers an external function type
+	 * @details May only be called during initialization of this builder, before models are
+	 *          created (see @ref threadsafety).
 	 * @param [in] name Name of the external function type
 	 * @param [in] factory Factory function that creates the registered IExternalFunction
 	 */
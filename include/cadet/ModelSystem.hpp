@@ -19,6 +19,7 @@
 #define LIBCADET_MODELSYSTEM_HPP_
 
 #include <unordered_map>
+#include <cstddef>
 #ifdef CADET_BENCHMARK_MODE
 	#include <vector>
 #endif
@@ -26,6 +27,7 @@
 #include "cadet/LibExportImport.hpp"
 #include "cadet/cadetCompilerInfo.hpp"
 #include "cadet/ParameterId.hpp"
+#include "cadet/Model.hpp"
 
 namespace cadet
 {
@@ -154,6 +156,25 @@ public:
 	 */
 	virtual void removeExternalFunction(IExternalFunction const* extFun) = 0;
 
+	/**
+	 * @brief Returns the amount of heap memory held by the model system in bytes
+	 * @details Sums the memory footprints of all unit operation models and adds the
+	 *          system level data structures (coupling Jacobian blocks, workspaces).
+	 *          See IModel::memoryFootprint() for details on what is counted.
+	 * @return Memory footprint in bytes
+	 */
+	virtual std::size_t memoryFootprint() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Estimates the computational cost of one integrator time step
+	 * @details Sums the cost estimates of all unit operation models and adds the system
+	 *          level coupling work. See IModel::costEstimate() for details and intended
+	 *          use of the figures.
+	 * @param [in] numSensParams Number of sensitive parameters the simulation will carry
+	 * @return Estimated cost of one integrator step
+	 */
+	virtual CostEstimate costEstimate(unsigned int numSensParams) const CADET_NOEXCEPT = 0;
+
 #ifdef CADET_BENCHMARK_MODE
 	/**
 	 * @brief Returns a vector with benchmark timings in seconds
@@ -22,6 +22,7 @@
 #include <vector>
 #include <unordered_map>
 #include <type_traits>
+#include <cstdint>
 
 #include "cadet/LibExportImport.hpp"
 #include "cadet/cadetCompilerInfo.hpp"
@@ -160,6 +161,92 @@ inline bool isValidConsistentInitialization(int ci) CADET_NOEXCEPT
 		&& (ci <= static_cast<typename std::underlying_type<ConsistentInitialization>::type>(ConsistentInitialization::Lean));
 }
 
+/**
+ * @brief Time integrator statistics of one integration slice
+ * @details Collects the counters of the time integrator and the linear solvers for one
+ *          continuously integrated time slice. A slice starts at the section given by
+ *          @c section and covers all following sections up to the next discontinuous
+ *          section transition (i.e., sections with a continuous transition share one
+ *          slice since the time integrator is not restarted there).
+ */
+struct SectionStatistics
+{
+	unsigned int section; //!< Index of the first section of the integration slice
+	unsigned int numSteps; //!< Number of (internal) time steps
+	unsigned int numResEvals; //!< Number of residual evaluations
+	unsigned int numErrTestFails; //!< Number of local error test failures
+	unsigned int numNonlinIters; //!< Number of Newton iterations of the nonlinear solver
+	unsigned int numNonlinConvFails; //!< Number of nonlinear solver convergence failures
+	unsigned int numLinSetups; //!< Number of linear solver setups (i.e., Jacobian updates and factorizations)
+	unsigned int numGmresIters; //!< Number of GMRES iterations spent in the linear solves of all unit operations
+};
+
+/**
+ * @brief One entry of the time integrator step event trace
+ * @details Step events are recorded in a ring buffer on each return of the time integrator
+ *          (see ISimulator::setStepTraceCapacity()). Consecutive events of a slice delimit
+ *          the individual steps; the timestamp is a raw tick count that is converted to
+ *          seconds via ISimulator::stepTraceTicksPerSecond(). A @c SliceStart event marks
+ *          the restart of the time integrator at a discontinuous section transition; its
+ *          counters are @c 0. The iteration and failure counters of a @c Step event cover
+ *          exactly the time span since the previous event, which allows to compute step
+ *          time distributions (e.g., p999 tail latencies) and to attribute pathological
+ *          steps to Newton or error test trouble.
+ */
+struct StepTraceEvent
+{
+	/**
+	 * @brief Type of the recorded event
+	 */
+	enum class Type : int
+	{
+		SliceStart = 0, //!< Time integrator (re-)start at the beginning of an integration slice
+		Step = 1, //!< Return of the time integrator after one or more steps
+	};
+
+	std::uint64_t timestamp; //!< Raw timestamp in ticks (convert via ISimulator::stepTraceTicksPerSecond())
+	double time; //!< Simulation time at the event
+	unsigned int section; //!< Index of the current time section
+	Type type; //!< Type of the event
+	int returnFlag; //!< Return flag of the time integrator (@c 0 on success, negative on failure)
+	unsigned int numSteps; //!< Number of internal steps since the previous event (@c 1 unless solutions are written at user times)
+	unsigned int numNewtonIters; //!< Number of Newton iterations since the previous event
+	unsigned int numLinIters; //!< Number of GMRES iterations since the previous event
+	unsigned int numErrTestFails; //!< Number of local error test failures since the previous event
+};
+
+/**
+ * @brief Receives progress notifications during time integration
+ * @details An implementation of this interface can be registered with ISimulator::setProgressMonitor()
+ *          and is then called from within ISimulator::integrate() after a configurable number of
+ *          successful time integrator steps. This allows host applications to display progress,
+ *          estimate completion, or implement adaptive timeouts for long running simulations.
+ *
+ *          The callback is invoked synchronously from the time integration loop and should
+ *          return quickly in order to not distort the integration time.
+ */
+class CADET_API IProgressMonitor
+{
+public:
+
+	virtual ~IProgressMonitor() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Called periodically during time integration
+	 * @details The estimated remaining wall clock time extrapolates the step density (time
+	 *          integrator steps per unit of process time) of the current integration slice
+	 *          over the remaining time span and converts it via the mean wall clock cost
+	 *          per step observed so far. The estimate is unavailable (@c -1.0) until the
+	 *          integrator has taken at least one step in the current slice.
+	 * @param [in] time Current process time of the time integrator
+	 * @param [in] section Index of the current time section
+	 * @param [in] numSteps Total number of time integrator steps taken so far in this run
+	 * @param [in] progress Completed fraction of the integration time span (in @f$ [0,1] @f$)
+	 * @param [in] secRemaining Estimated remaining wall clock time in seconds, @c -1.0 if no estimate is available
+	 */
+	virtual void progress(double time, unsigned int section, unsigned int numSteps, double progress, double secRemaining) = 0;
+};
+
 /**
  * @brief Provides functionality to simulate a model using a time integrator
  */
@@ -218,6 +305,20 @@ public:
 	//! \param  [in]    absTolS Absolute tolerance used in the sensitivity computation for this parameter (try 1.0e-5)
 	virtual void setSensitiveParameter(ParameterId const* ids, double const* diffFactors, unsigned int numParams, double absTolS) = 0;
 
+	//! \brief Restricts a parameter sensitivity to a subset of the time sections
+	//!
+	//! By default, a sensitivity is computed over the full simulation time. If a parameter
+	//! is known to not influence the solution during some sections (e.g., a gradient
+	//! parameter that only acts late in the process), those sections can be disabled here.
+	//! In a disabled section the corresponding sensitivity direction is skipped in the
+	//! residual evaluation and its state is frozen, which reduces the per-step cost.
+	//! Calling setSensitiveParameter() or clearSensParams() resets the activation pattern.
+	//!
+	//! \param  [in]    idx Index of the sensitive parameter
+	//! \param  [in]    activeSections Array of flags that enables (@c true) or disables (@c false) the sensitivity in each section
+	//! \param  [in]    numSections Number of elements in @p activeSections, has to match the number of time sections
+	virtual void setSensitiveParameterSections(unsigned int idx, bool const* activeSections, unsigned int numSections) = 0;
+
 	//! \brief Reset the simulator to compute no sensitivity at all
 	virtual void clearSensParams() = 0;
 
@@ -251,6 +352,20 @@ public:
 	//! \param  [in]    value Value of the parameter
 	virtual void setParameterValue(const ParameterId& id, double value) = 0;
 
+	//! \brief Applies a batch of parameter value updates without reconfiguring the model
+	//!
+	//! Updates the given parameters in place using the parameter registries of the models,
+	//! which is much cheaper than a full reconfigure when only a few values change between
+	//! runs (e.g., in estimation loops). Dependent state (such as the time transformation
+	//! when SECTION_TIMES is updated) is recomputed once after all updates have been applied.
+	//! Like setParameterValue(), this function does not respect fused parameters.
+	//!
+	//! \param  [in]    ids Parameter IDs of the parameters to be manipulated
+	//! \param  [in]    values New values of the parameters
+	//! \param  [in]    numParams Number of updated parameters
+	//! \return @c true if all parameters were found, otherwise @c false
+	virtual bool setParameterValues(ParameterId const* ids, double const* values, unsigned int numParams) = 0;
+
 	/**
 	 * @brief Checks whether a given parameter exists
 	 * @param [in] pId   pId   ParameterId that identifies the parameter uniquely
@@ -275,6 +390,17 @@ public:
 	//! \param  [in]    solutionTimes  A vector containing the timepoints at which a solution should be computed
 	virtual void setSolutionTimes(const std::vector<double>& solutionTimes) = 0;
 
+	//! \brief Enables or disables interpolated dense output at the solution times
+	//!
+	//! By default, the time integrator is forced to stop exactly at each timepoint set by
+	//! setSolutionTimes(), which can push the step size far below what the error test allows
+	//! if the output grid is fine. With dense output enabled, the integrator steps freely
+	//! and the solution at the requested timepoints is evaluated from its interpolating
+	//! polynomial, which does not perturb the step size control.
+	//!
+	//! \param  [in]    denseOutput  Determines whether interpolated dense output is used
+	virtual void setDenseOutput(bool denseOutput) = 0;
+
 	//! \brief Returns the time points at which a solution has been written
 	//!
 	//! \return Vector containing the timepoints at which a solution has been be computed
@@ -425,6 +551,19 @@ public:
 	 */
 	virtual void setSolutionRecorder(ISolutionRecorder* recorder) = 0;
 
+	/**
+	 * @brief Sets the progress monitor which is notified during integrate()
+	 * @details The monitor is invoked after every @p stride successful time integrator steps.
+	 *          Setting the monitor to @c NULL disables progress notifications. Without a
+	 *          monitor the integration loop is not affected at all; with a monitor set, the
+	 *          overhead is one counter query per integrator return plus the callback itself
+	 *          every @p stride steps.
+	 *
+	 * @param [in] monitor Implementation of the cadet::IProgressMonitor interface or @c NULL
+	 * @param [in] stride Number of successful time integrator steps between two callbacks (at least @c 1)
+	 */
+	virtual void setProgressMonitor(IProgressMonitor* monitor, unsigned int stride) CADET_NOEXCEPT = 0;
+
 	/**
 	 * @brief Starts the solution of the system specified for this simulator object
 	 * @details Checks all model parameters to lie inside their possible bounds and then runs the time integration
@@ -434,6 +573,60 @@ public:
 	 */
 	virtual void integrate() = 0;
 
+	/**
+	 * @brief Integrates repeated cycles until a cyclic steady state is reached
+	 * @details Treats the configured time sections as one full cycle of a repetitive
+	 *          process (e.g., SMB switching or flow-through polishing). After each
+	 *          integrate() the end-of-cycle state becomes the initial state of the
+	 *          next cycle, and the fixed point of this cycle map is accelerated by
+	 *          Anderson mixing, which typically converges in a handful of cycle
+	 *          evaluations instead of brute-force integrating dozens of cycles.
+	 *
+	 *          Solution recorders retain the trajectory of the last evaluated cycle.
+	 *          The simulator has to be set up as for a normal run before calling
+	 *          this function.
+	 * @param [in] maxCycles Maximum number of cycle evaluations
+	 * @param [in] tol Norm of the state change over one cycle, relative to the state norm, below which the process counts as cyclically steady
+	 * @return Number of evaluated cycles, or @c maxCycles + 1 if the tolerance was not reached
+	 */
+	virtual unsigned int integrateToCyclicSteadyState(unsigned int maxCycles, double tol) = 0;
+
+	/**
+	 * @brief Writes the current solver state to a binary checkpoint file
+	 * @details Serializes the state vector, its time derivative, all forward sensitivity
+	 *          vectors, the current integration time, and the last accepted step size.
+	 *          The file is written to a temporary name first and then renamed, so a crash
+	 *          during the write cannot corrupt an existing checkpoint.
+	 * @param [in] fileName Path of the checkpoint file
+	 * @return @c true if the checkpoint was written, otherwise @c false
+	 */
+	virtual bool saveCheckpoint(const char* fileName) const = 0;
+
+	/**
+	 * @brief Restores the solver state from a checkpoint file written by saveCheckpoint()
+	 * @details Loads the state vectors and schedules the next integrate() call to continue
+	 *          from the section boundary stored in the checkpoint instead of starting at
+	 *          the beginning of the first section. Since the time integrator is fully
+	 *          re-initialized from the state vector at every section boundary, a resumed
+	 *          run reproduces the remainder of an uninterrupted run exactly.
+	 *
+	 *          The simulator has to be set up as for a normal run (model initialized,
+	 *          section times set, sensitivities configured) before calling this function;
+	 *          it replaces the call to applyInitialCondition(). The checkpoint has to match
+	 *          the problem in the number of degrees of freedom and sensitivities.
+	 * @param [in] fileName Path of the checkpoint file
+	 * @return @c true if the state was restored, otherwise @c false
+	 */
+	virtual bool resumeFromCheckpoint(const char* fileName) = 0;
+
+	/**
+	 * @brief Enables periodic checkpointing during integrate()
+	 * @details A checkpoint is written at the beginning of every time section (where the
+	 *          state at the boundary fully determines the remainder of the run). Pass
+	 *          @c nullptr to disable periodic checkpointing.
+	 * @param [in] fileName Path of the checkpoint file or @c nullptr
+	 */
+	virtual void setCheckpointFile(const char* fileName) = 0;
 
 	/**
 	 * @brief Returns the bare state vector for the last timepoint
@@ -582,6 +775,39 @@ public:
 	 */
 	virtual void setAbsoluteErrorTolerance(const std::vector<double>& absTol) = 0;
 
+	/**
+	 * @brief Scales the absolute error tolerances of each state class by its own factor
+	 * @details The states of a model fall into classes with very different influence on the
+	 *          observable result: column liquid concentrations (including inlet and outlet
+	 *          DOFs), particle liquid concentrations, bound states, and film fluxes. The
+	 *          given factors multiply the absolute tolerance of every DOF of the respective
+	 *          class on top of the global or per-DOF tolerances. Loosening non-observable
+	 *          classes (factors greater than @c 1.0) lets the step size controller take
+	 *          larger steps while chromatogram accuracy remains governed by the column
+	 *          liquid tolerances; factors below @c 1.0 tighten a class. A factor of @c 1.0
+	 *          leaves a class unchanged, which is the default for all classes. Non-positive
+	 *          factors reset the respective class to @c 1.0.
+	 * @param [in] colLiquidFactor Factor for column liquid (bulk, inlet, and outlet) DOFs
+	 * @param [in] parLiquidFactor Factor for particle liquid phase DOFs
+	 * @param [in] boundFactor Factor for bound state DOFs
+	 * @param [in] fluxFactor Factor for film flux DOFs
+	 */
+	virtual void setStateClassErrorTolerances(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor) = 0;
+
+	/**
+	 * @brief Sets the tolerance relaxation applied right after a discontinuous section transition
+	 * @details When a section transition introduces a discontinuity (e.g., a step in the inlet
+	 *          profile), the disturbance is initially confined to a small part of the model
+	 *          (the cells next to the column inlet). Keeping the full error test active on the
+	 *          still unperturbed degrees of freedom forces the time integrator to very small
+	 *          steps without gaining accuracy. If a factor greater than @c 1.0 is set, the
+	 *          absolute tolerances of the unaffected degrees of freedom are multiplied by this
+	 *          factor when a discontinuous section begins and the nominal tolerances are
+	 *          restored after the first successful solver return in that section.
+	 * @param [in] relaxFactor Relaxation factor (at least @c 1.0), where @c 1.0 disables the feature
+	 */
+	virtual void setSectionTransitionErrorRelaxation(double relaxFactor) = 0;
+
 	/**
 	 * @brief Sets the error tolerance of the nonlinear algebraic equation solvers
 	 * @details This tolerance is used for consistent initialization of the nonlinear
@@ -604,6 +830,26 @@ public:
 	 */
 	virtual void setInitialStepSize(const std::vector<double>& stepSize) = 0;
 
+	/**
+	 * @brief Returns the size of the last accepted time step of the most recent integrate() run
+	 * @details The value is recorded at the end of integrate() and can be used to seed the
+	 *          initial step size of a subsequent run (see warmStartFromLastRun()).
+	 * @return Size of the last accepted time step, or @c 0.0 if no run has finished yet
+	 */
+	virtual double lastIntegrationStepSize() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Seeds the next integrate() run with the step size of the previous one
+	 * @details Continuation and parameter sweep studies integrate nearly identical problems
+	 *          back-to-back, but each run starts from the conservative defaults (tiny first
+	 *          step at BDF order @c 1). This function sets the initial step size of all
+	 *          sections to the last accepted step size of the previous run, which removes
+	 *          most of the startup transient. The BDF order history cannot be transferred
+	 *          through the time integrator's interface, so the order still ramps up, but it
+	 *          does so with realistic step sizes. Has no effect if no run has finished yet.
+	 */
+	virtual void warmStartFromLastRun() = 0;
+
 	/**
 	 * @brief Sets the maximum number of time steps in each section
 	 * @details If an integration process requires more than the specified number of time steps,
@@ -639,6 +885,44 @@ public:
 	 * @return Accumulated time of all calls of integrate() in seconds
 	 */
 	virtual double totalSimulationDuration() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns time integrator statistics of the most recent integrate() run
+	 * @details The statistics are recorded per continuously integrated time slice (i.e.,
+	 *          per restart of the time integrator, see SectionStatistics). They allow to
+	 *          pinpoint sections in which the time integrator struggles (many error test
+	 *          failures, Newton iterations, or GMRES iterations) without profiling.
+	 *          The vector is reset on each call to integrate(). If a run aborts with an
+	 *          exception, the statistics of the failed slice are the last entry.
+	 * @return Vector with one entry per integration slice of the last integrate() run
+	 */
+	virtual const std::vector<SectionStatistics>& integratorStatistics() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Enables or disables the step event trace and sets its capacity
+	 * @details If enabled, a StepTraceEvent is recorded in a ring buffer on each return of
+	 *          the time integrator. The buffer overwrites the oldest events when it is full,
+	 *          so the recording overhead is a few counter reads and one store per step and
+	 *          independent of the integration horizon. The trace is reset on each call to
+	 *          integrate(). Tracing is disabled by default.
+	 * @param [in] capacity Number of events the ring buffer holds (rounded up to a power of two; @c 0 disables tracing)
+	 */
+	virtual void setStepTraceCapacity(unsigned int capacity) = 0;
+
+	/**
+	 * @brief Returns the recorded step event trace in chronological order
+	 * @details If more events were recorded than the trace buffer holds, only the most
+	 *          recent ones are returned. Returns an empty vector if tracing is disabled.
+	 * @return Vector with the recorded step events, oldest first
+	 */
+	virtual std::vector<StepTraceEvent> stepTrace() const = 0;
+
+	/**
+	 * @brief Returns the number of step trace timestamp ticks per second
+	 * @details Use this factor to convert the raw timestamps of StepTraceEvent to seconds.
+	 * @return Timestamp ticks per second
+	 */
+	virtual double stepTraceTicksPerSecond() const = 0;
 };
 
 } // namespace cadet
@@ -37,6 +37,26 @@ enum class StateOrdering : uint8_t
 	Phase
 };
 
+/**
+ * @brief Contiguous strided view on exported solution data
+ * @details Describes a block of solution data by a base pointer, the number of logical
+ *          elements, and the distance between consecutive elements. A stride of @c 1
+ *          denotes contiguous data that can be bulk-copied or aliased directly.
+ *          The view is only valid as long as the exporter that produced it.
+ */
+struct SolutionSpan
+{
+	double const* data;       //!< Pointer to the first element (@c NULL if the data is not supported)
+	unsigned int numElements; //!< Number of logical elements in the view
+	unsigned int stride;      //!< Distance between two consecutive elements (in @c double elements)
+
+	/**
+	 * @brief Checks whether the elements are laid out contiguously in memory
+	 * @return @c true if the data can be copied or aliased as one block, otherwise @c false
+	 */
+	inline bool contiguous() const CADET_NOEXCEPT { return stride == 1; }
+};
+
 /**
  * @brief Interface providing functionality for exporting the solution to the user space
  */
@@ -222,6 +242,65 @@ public:
 	virtual double const* outlet(unsigned int& stride) const = 0;
 
 
+	/**
+	 * @brief Returns a span view on the main mobile phase state vector
+	 * @details The ordering of the data inside the span is provided by concentrationOrdering().
+	 *          The default implementation assembles the span from the classic accessors; exporters
+	 *          should override it if the span can be produced in a single call.
+	 * @return Span view on the main mobile phase data
+	 */
+	virtual SolutionSpan concentrationSpan() const
+	{
+		return SolutionSpan{ concentration(), numColumnDofs(), 1u };
+	}
+
+	/**
+	 * @brief Returns a span view on the flux state vector
+	 * @details The ordering of the data inside the span is provided by fluxOrdering().
+	 * @return Span view on the flux data (data pointer is @c NULL if fluxes are not supported)
+	 */
+	virtual SolutionSpan fluxSpan() const
+	{
+		return SolutionSpan{ flux(), numFluxDofs(), 1u };
+	}
+
+	/**
+	 * @brief Returns a span view on the particle mobile phase state vector
+	 * @details The span covers all particle DOFs, that is, the mobile phase together with the
+	 *          interleaved solid phase entries. The ordering of the data inside the span is
+	 *          provided by mobilePhaseOrdering().
+	 * @return Span view on the particle data (data pointer is @c NULL if particles are not supported)
+	 */
+	virtual SolutionSpan mobilePhaseSpan() const
+	{
+		return SolutionSpan{ mobilePhase(), numParticleDofs(), 1u };
+	}
+
+	/**
+	 * @brief Returns a span view on the inlet state vector
+	 * @details The span holds one element per main mobile phase component (see numComponents()).
+	 * @return Span view on the inlet data
+	 */
+	virtual SolutionSpan inletSpan() const
+	{
+		unsigned int stride = 0;
+		double const* const data = inlet(stride);
+		return SolutionSpan{ data, numComponents(), stride };
+	}
+
+	/**
+	 * @brief Returns a span view on the outlet state vector
+	 * @details The span holds one element per main mobile phase component (see numComponents()).
+	 * @return Span view on the outlet data
+	 */
+	virtual SolutionSpan outletSpan() const
+	{
+		unsigned int stride = 0;
+		double const* const data = outlet(stride);
+		return SolutionSpan{ data, numComponents(), stride };
+	}
+
+
 	/**
 	 * @brief Returns an array describing the ordering of the main mobile phase state vector
 	 * @details A pointer to the first element of the state vector ordering array is returned. The length
@@ -72,6 +72,18 @@ public:
 	 */
 	virtual void notifyIntegrationStart(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps) = 0;
 
+	/**
+	 * @brief Notifies the recorder of a changed number of anticipated timesteps
+	 * @details This function is called by ISimulator as soon as the number of output time points
+	 *          is known (i.e., when the solution time grid is set), which may happen before or
+	 *          after the recorder has been attached. Implementations can use the count to size
+	 *          their buffers exactly in advance of the time integration. The default
+	 *          implementation does nothing.
+	 *
+	 * @param [in] numTimesteps Number of anticipated timesteps, can be @c 0 if no estimate is available
+	 */
+	virtual void notifyTimePoints(unsigned int numTimesteps) { }
+
 	/**
 	 * @brief Provides the internal structure of a unit operation which can be used for memory allocation
 	 * @details After prepare() or notifyIntegrationStart() has been called, this function is called by each unit operation.
@@ -0,0 +1,125 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Defines a flat C API with stable ABI for embedding CADET in other processes.
+ */
+
+#ifndef LIBCADET_CADET_C_H_
+#define LIBCADET_CADET_C_H_
+
+#include <stddef.h>
+
+#include "cadet/LibExportImport.hpp"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Opaque handle of a driver that owns a simulator, a model, and the recorded solution
+ * @details A handle can be reused for multiple cdtConfigure() / cdtRun() cycles. Internal
+ *          allocations (models, simulator workspace, solution storage) are retained and
+ *          reused across calls whenever the problem structure permits.
+ */
+typedef struct cdtDriver cdtDriver;
+
+/**
+ * @brief Error codes returned by the C API functions
+ */
+typedef enum cdtResult
+{
+	cdtOK = 0, //!< Operation completed successfully
+	cdtErrorInvalidInputs = -1, //!< Invalid handle or argument passed to the function
+	cdtErrorConfiguration = -2, //!< Configuration of the simulation failed (see cdtGetLastError())
+	cdtErrorSimulation = -3, //!< Time integration failed (see cdtGetLastError())
+	cdtErrorNoResults = -4 //!< Requested results are not available (simulation not run or data not recorded)
+} cdtResult;
+
+/**
+ * @brief Creates a driver
+ * @return Handle to the driver, or @c NULL if allocation failed
+ */
+CADET_API cdtDriver* cdtCreateDriver(void);
+
+/**
+ * @brief Destroys a driver and releases all memory owned by it
+ * @details Pointers obtained from cdtGetSolutionTimes() and cdtGetSolutionOutlet() are
+ *          invalidated. Passing @c NULL is allowed and does nothing.
+ * @param [in] drv Handle of the driver to destroy
+ */
+CADET_API void cdtDestroyDriver(cdtDriver* drv);
+
+/**
+ * @brief Configures the driver from a JSON document held in a memory buffer
+ * @details The document mirrors the group / dataset layout of the file formats accepted
+ *          by the command line frontend: either the content of the "input" group or a
+ *          full document with a top level "input" group is accepted. The buffer is only
+ *          read during this call and can be released afterwards. Calling this again on
+ *          the same handle replaces the previous configuration while reusing internal
+ *          allocations where the problem structure allows.
+ * @param [in] drv Handle of the driver
+ * @param [in] config Pointer to the first character of the JSON document (need not be zero terminated)
+ * @param [in] length Number of characters in the buffer
+ * @return @c cdtOK on success, an error code otherwise
+ */
+CADET_API cdtResult cdtConfigure(cdtDriver* drv, char const* config, size_t length);
+
+/**
+ * @brief Runs the configured simulation
+ * @param [in] drv Handle of the driver
+ * @return @c cdtOK on success, an error code otherwise
+ */
+CADET_API cdtResult cdtRun(cdtDriver* drv);
+
+/**
+ * @brief Retrieves the time points of the recorded solution
+ * @details The returned pointer is owned by the driver and remains valid until the next
+ *          call to cdtConfigure(), cdtRun(), or cdtDestroyDriver() on this handle.
+ * @param [in] drv Handle of the driver
+ * @param [out] time Receives a pointer to the time points
+ * @param [out] numTime Receives the number of time points
+ * @return @c cdtOK on success, an error code otherwise
+ */
+CADET_API cdtResult cdtGetSolutionTimes(cdtDriver* drv, double const** time, unsigned int* numTime);
+
+/**
+ * @brief Retrieves the recorded outlet of a unit operation
+ * @details The data is stored time-major, that is, all components of the first time point
+ *          are followed by all components of the second time point. The returned pointer
+ *          is owned by the driver and remains valid until the next call to cdtConfigure(),
+ *          cdtRun(), or cdtDestroyDriver() on this handle.
+ * @param [in] drv Handle of the driver
+ * @param [in] unitOpId Id of the unit operation
+ * @param [out] data Receives a pointer to the outlet data
+ * @param [out] numTime Receives the number of recorded time points
+ * @param [out] numComp Receives the number of recorded components per time point
+ * @return @c cdtOK on success, an error code otherwise
+ */
+CADET_API cdtResult cdtGetSolutionOutlet(cdtDriver* drv, unsigned int unitOpId, double const** data, unsigned int* numTime, unsigned int* numComp);
+
+/**
+ * @brief Returns a message describing the last error that occurred on the given driver
+ * @details The returned pointer is owned by the driver and remains valid until the next
+ *          API call on this handle.
+ * @param [in] drv Handle of the driver
+ * @return Zero terminated error message, or an empty string if no error occurred
+ */
+CADET_API char const* cdtGetLastError(cdtDriver const* drv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBCADET_CADET_C_H_
@@ -26,6 +26,26 @@
  * @todo Check if all headers are included
  */
 
+/**
+ * @page threadsafety Thread safety
+ * Multiple ISimulator instances may run concurrently in one process under the following contract:
+ *
+ * - ISimulator, IModelBuilder, and the objects they create (IModelSystem, IModel) are confined
+ *   to one thread at a time. They do not synchronize internally. Use one simulator and one
+ *   model builder per thread and do not share model systems between builders on different threads.
+ * - The free factory functions (createSimulator(), createModelBuilder(), and their C API
+ *   counterparts) as well as destroySimulator() and destroyModelBuilder() are thread-safe.
+ * - Logging is process global and thread-safe: setLogReceiver(), setLogLevel(), getLogLevel(),
+ *   and drainLogs() may be called from any thread. Log messages from concurrent simulators are
+ *   delivered to the ILogReceiver one at a time, so the receiver itself does not need to be
+ *   thread-safe. It must not call back into libcadet, however.
+ * - Factory registration (IModelBuilder::registerInletType(), registerExternalFunctionType())
+ *   is an initialization time operation on the respective builder instance and must not race
+ *   with model creation on the same instance.
+ * - Process wide caches inside libcadet (e.g., shared discretization data) are internally
+ *   synchronized and require no action from the caller.
+ */
+
 #include "cadet/cadetCompilerInfo.hpp"
 #include "cadet/LibExportImport.hpp"
 #include "cadet/LibVersionInfo.hpp"
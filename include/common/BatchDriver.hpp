@@ -0,0 +1,208 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a driver that runs batches of CADET simulations concurrently
+ */
+
+#ifndef CADET_BATCHDRIVER_HPP_
+#define CADET_BATCHDRIVER_HPP_
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/Driver.hpp"
+
+
+namespace cadet
+{
+
+/**
+ * @brief Driver that runs many simulations of the same model structure concurrently
+ * @details Owns a fixed number of independently configured Driver instances (each with
+ *          its own simulator, model, and solution recorder) and integrates them on a
+ *          pool of worker threads. Configuration (discretization, Jacobian structure,
+ *          output recorders) is performed once per instance; subsequent runs only
+ *          change parameter values and initial conditions, which avoids paying the
+ *          full file parsing and configure() cost for every parameter set of a
+ *          fitting loop.
+ */
+class BatchDriver
+{
+public:
+	/**
+	 * @brief Creates a BatchDriver with the given number of simulator instances
+	 * @param [in] numInstances Number of simulator instances (i.e., maximum number of concurrent simulations)
+	 */
+	BatchDriver(unsigned int numInstances)
+	{
+		_drivers.reserve(numInstances);
+		for (unsigned int i = 0; i < numInstances; ++i)
+			_drivers.emplace_back(new Driver());
+	}
+
+	~BatchDriver() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Builds and configures all simulator instances from the same parameter provider
+	 * @details Each instance gets its own simulator, model, and solution recorder. The
+	 *          parameter provider is read once per instance, which happens only at setup
+	 *          and not per run.
+	 * @param [in] pp Implementation of cadet::IParameterProvider used as input
+	 * @tparam ParamProvider_t Type of the parameter provider
+	 */
+	template <typename ParamProvider_t>
+	void configure(ParamProvider_t& pp)
+	{
+		for (std::size_t i = 0; i < _drivers.size(); ++i)
+			_drivers[i]->configure(pp);
+	}
+
+	/**
+	 * @brief Sets the value of a parameter in every instance
+	 * @details This is the main entry point for parameter estimation: each instance is
+	 *          assigned one element of the given array and, thus, represents one
+	 *          parameter set of the batch.
+	 * @param [in] id Parameter id of the parameter to be set
+	 * @param [in] values Array with one parameter value per instance
+	 */
+	void setParameterValue(const ParameterId& id, double const* values)
+	{
+		for (std::size_t i = 0; i < _drivers.size(); ++i)
+			_drivers[i]->simulator()->setParameterValue(id, values[i]);
+	}
+
+	/**
+	 * @brief Sets the value of a parameter in a single instance
+	 * @param [in] idx Index of the instance
+	 * @param [in] id Parameter id of the parameter to be set
+	 * @param [in] value Value of the parameter
+	 */
+	void setParameterValue(unsigned int idx, const ParameterId& id, double value)
+	{
+		_drivers[idx]->simulator()->setParameterValue(id, value);
+	}
+
+	/**
+	 * @brief Performs time integration of all instances concurrently
+	 * @details Uses as many worker threads as the hardware supports concurrently.
+	 */
+	void run()
+	{
+		run(std::thread::hardware_concurrency());
+	}
+
+	/**
+	 * @brief Performs time integration of all instances concurrently
+	 * @details The instances are distributed over a pool of worker threads. Exceptions
+	 *          thrown by an instance (e.g., cadet::IntegrationException) are caught in
+	 *          the worker and the first one is rethrown after all threads have finished.
+	 * @param [in] numThreads Number of worker threads
+	 */
+	void run(unsigned int numThreads)
+	{
+		run(numThreads, numInstances());
+	}
+
+	/**
+	 * @brief Performs time integration of the first @p numActive instances concurrently
+	 * @details Integrates only a leading subset of the instances, which allows processing
+	 *          job counts that are not a multiple of the instance count in waves without
+	 *          wasting runs on instances that have not been assigned a parameter set.
+	 * @param [in] numThreads Number of worker threads
+	 * @param [in] numActive Number of instances to integrate (clamped to numInstances())
+	 */
+	void run(unsigned int numThreads, unsigned int numActive)
+	{
+		numActive = std::min(numActive, numInstances());
+		if (numActive == 0)
+			return;
+
+		numThreads = std::max(1u, std::min(numThreads, numActive));
+
+		// Restrict every simulator to a single thread; parallelism is provided by
+		// running the instances concurrently
+		for (std::size_t i = 0; i < numActive; ++i)
+			_drivers[i]->simulator()->setNumThreads(1);
+
+		std::atomic<std::size_t> nextJob(0);
+		std::vector<std::exception_ptr> errors(numActive);
+
+		const auto worker = [&]()
+		{
+			while (true)
+			{
+				const std::size_t idx = nextJob.fetch_add(1);
+				if (idx >= numActive)
+					return;
+
+				try
+				{
+					_drivers[idx]->run();
+				}
+				catch (...)
+				{
+					errors[idx] = std::current_exception();
+				}
+			}
+		};
+
+		std::vector<std::thread> pool;
+		pool.reserve(numThreads - 1);
+		for (unsigned int i = 0; i < numThreads - 1; ++i)
+			pool.emplace_back(worker);
+
+		// The calling thread participates in the work
+		worker();
+
+		for (std::size_t i = 0; i < pool.size(); ++i)
+			pool[i].join();
+
+		// Rethrow the first error, if any occurred
+		for (std::size_t i = 0; i < errors.size(); ++i)
+		{
+			if (errors[i])
+				std::rethrow_exception(errors[i]);
+		}
+	}
+
+	/**
+	 * @brief Removes all stored results of every instance
+	 */
+	void clearResults()
+	{
+		for (std::size_t i = 0; i < _drivers.size(); ++i)
+			_drivers[i]->clearResults();
+	}
+
+	inline unsigned int numInstances() const CADET_NOEXCEPT { return static_cast<unsigned int>(_drivers.size()); }
+
+	inline Driver& instance(unsigned int idx) { return *_drivers[idx]; }
+	inline const Driver& instance(unsigned int idx) const { return *_drivers[idx]; }
+
+	inline cadet::InternalStorageSystemRecorder* solution(unsigned int idx) CADET_NOEXCEPT { return _drivers[idx]->solution(); }
+	inline cadet::InternalStorageSystemRecorder const* solution(unsigned int idx) const CADET_NOEXCEPT { return _drivers[idx]->solution(); }
+
+protected:
+	std::vector<std::unique_ptr<Driver>> _drivers; //!< Driver instances owned by this batch driver
+
+private:
+	BatchDriver(const BatchDriver&) = delete;
+};
+
+} // namespace cadet
+
+#endif  // CADET_BATCHDRIVER_HPP_
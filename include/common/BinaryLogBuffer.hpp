@@ -0,0 +1,300 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Implementation of a binary ring buffer that stores log messages as raw argument
+ * values and defers formatting until the buffer is drained.
+ */
+
+#ifndef CADET_BINARYLOGBUFFER_HPP_
+#define CADET_BINARYLOGBUFFER_HPP_
+
+#include "common/CompilerSpecific.hpp"
+#include "cadet/cadetCompilerInfo.hpp"
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <mutex>
+#include <cstdint>
+#include <cstring>
+
+namespace cadet
+{
+
+enum class LogLevel : unsigned int;
+
+namespace log
+{
+
+	/**
+	 * @brief Type tags of the values recorded in a binary log message
+	 */
+	namespace logTag
+	{
+		const uint8_t int64 = 1; //!< Signed integer, stored as int64_t
+		const uint8_t uint64 = 2; //!< Unsigned integer, stored as uint64_t
+		const uint8_t float64 = 3; //!< Floating point number, stored as double
+		const uint8_t boolean = 4; //!< Boolean, stored as uint8_t
+		const uint8_t character = 5; //!< Single character
+		const uint8_t string = 6; //!< String, stored as uint32_t length followed by the characters
+	}
+
+	/**
+	 * @brief Appends raw bytes to a binary log record
+	 */
+	inline void logRecordAppend(std::vector<char>& rec, void const* data, std::size_t size)
+	{
+		char const* const p = static_cast<char const*>(data);
+		rec.insert(rec.end(), p, p + size);
+	}
+
+	/**
+	 * @brief Appends a value verbatim to a binary log record
+	 */
+	template <typename T>
+	inline void logRecordAppendValue(std::vector<char>& rec, const T& val)
+	{
+		logRecordAppend(rec, &val, sizeof(T));
+	}
+
+	/**
+	 * @brief Appends a type tag and a value to a binary log record
+	 */
+	template <typename T>
+	inline void logRecordAppendTagged(std::vector<char>& rec, uint8_t tag, const T& val)
+	{
+		rec.push_back(static_cast<char>(tag));
+		logRecordAppend(rec, &val, sizeof(T));
+	}
+
+	/**
+	 * @brief Appends a tagged string to a binary log record
+	 */
+	inline void logRecordAppendString(std::vector<char>& rec, char const* str, std::size_t len)
+	{
+		rec.push_back(static_cast<char>(logTag::string));
+		const uint32_t size = static_cast<uint32_t>(len);
+		logRecordAppend(rec, &size, sizeof(size));
+		logRecordAppend(rec, str, len);
+	}
+
+	/**
+	 * @brief Ring buffer that stores log messages in a binary format
+	 * @details Messages are committed as complete records consisting of positional information
+	 *          (pointers to the static file and function name strings, line number, log level)
+	 *          followed by type tagged raw argument values. No text formatting is performed on
+	 *          commit, which keeps the cost of high-frequency trace points low. When the buffer
+	 *          runs full, the oldest records are overwritten, so draining yields the most recent
+	 *          messages. Formatting happens in drain(), that is, off the hot path.
+	 *
+	 *          All operations are thread-safe. Records are assembled outside the buffer (e.g.,
+	 *          in thread local scratch space) and committed with a single short critical section.
+	 */
+	class BinaryLogBuffer
+	{
+	public:
+
+		/**
+		 * @brief Creates a BinaryLogBuffer with the given capacity
+		 * @param [in] capacity Size of the buffer in bytes
+		 */
+		BinaryLogBuffer(std::size_t capacity = 1048576) : _buffer(capacity), _read(0), _size(0), _overwritten(0) { }
+
+		/**
+		 * @brief Commits a fully assembled binary record to the buffer
+		 * @details If the buffer is full, the oldest records are discarded to make room.
+		 *          Records larger than the whole buffer are dropped.
+		 *
+		 * @param [in] data Pointer to the first byte of the record
+		 * @param [in] len Length of the record in bytes
+		 */
+		void commit(char const* data, std::size_t len)
+		{
+			const std::size_t required = sizeof(uint32_t) + len;
+			if (required > _buffer.size())
+				return;
+
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			// Evict oldest records until the new one fits
+			while (_buffer.size() - _size < required)
+			{
+				uint32_t oldLen = 0;
+				copyOut(&oldLen, _read, sizeof(oldLen));
+				_read = (_read + sizeof(oldLen) + oldLen) % _buffer.size();
+				_size -= sizeof(oldLen) + oldLen;
+				++_overwritten;
+			}
+
+			const uint32_t recLen = static_cast<uint32_t>(len);
+			std::size_t writePos = (_read + _size) % _buffer.size();
+			writePos = copyIn(writePos, &recLen, sizeof(recLen));
+			copyIn(writePos, data, len);
+			_size += required;
+		}
+
+		/**
+		 * @brief Drains the buffer, formatting each record and passing it to the given handler
+		 * @details The handler is called as
+		 *          <pre>handler(fileName, funcName, line, lvl, message)</pre>
+		 *          with the formatted message of each record in chronological order. The
+		 *          buffer is empty afterwards.
+		 *
+		 * @param [in] handler Callable receiving the formatted messages
+		 * @tparam Handler_t Type of the handler
+		 */
+		template <typename Handler_t>
+		void drain(Handler_t handler)
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+
+			while (_size > 0)
+			{
+				uint32_t recLen = 0;
+				copyOut(&recLen, _read, sizeof(recLen));
+
+				std::vector<char> rec(recLen);
+				copyOut(rec.data(), (_read + sizeof(recLen)) % _buffer.size(), recLen);
+
+				_read = (_read + sizeof(recLen) + recLen) % _buffer.size();
+				_size -= sizeof(recLen) + recLen;
+
+				// Format and deliver without holding the lock
+				lock.unlock();
+				formatRecord(rec, handler);
+				lock.lock();
+			}
+		}
+
+		/**
+		 * @brief Returns the number of records that have been overwritten since the last reset
+		 */
+		inline std::size_t numOverwritten() const CADET_NOEXCEPT { return _overwritten; }
+
+		/**
+		 * @brief Resets the counter of overwritten records
+		 */
+		inline void resetOverwritten() CADET_NOEXCEPT { _overwritten = 0; }
+
+	protected:
+
+		/**
+		 * @brief Copies bytes into the ring buffer handling wrap around
+		 * @return Position after the last written byte
+		 */
+		inline std::size_t copyIn(std::size_t pos, void const* data, std::size_t len)
+		{
+			char const* src = static_cast<char const*>(data);
+			const std::size_t tail = _buffer.size() - pos;
+			if (len <= tail)
+			{
+				std::memcpy(_buffer.data() + pos, src, len);
+				return (pos + len) % _buffer.size();
+			}
+
+			std::memcpy(_buffer.data() + pos, src, tail);
+			std::memcpy(_buffer.data(), src + tail, len - tail);
+			return len - tail;
+		}
+
+		/**
+		 * @brief Copies bytes out of the ring buffer handling wrap around
+		 */
+		inline void copyOut(void* dest, std::size_t pos, std::size_t len) const
+		{
+			char* dst = static_cast<char*>(dest);
+			const std::size_t tail = _buffer.size() - pos;
+			if (len <= tail)
+			{
+				std::memcpy(dst, _buffer.data() + pos, len);
+				return;
+			}
+
+			std::memcpy(dst, _buffer.data() + pos, tail);
+			std::memcpy(dst + tail, _buffer.data(), len - tail);
+		}
+
+		/**
+		 * @brief Reads a value verbatim from a decoded record
+		 */
+		template <typename T>
+		static inline T readValue(const std::vector<char>& rec, std::size_t& pos)
+		{
+			T val;
+			std::memcpy(&val, rec.data() + pos, sizeof(T));
+			pos += sizeof(T);
+			return val;
+		}
+
+		/**
+		 * @brief Decodes a record and hands the formatted message to the handler
+		 */
+		template <typename Handler_t>
+		static void formatRecord(const std::vector<char>& rec, Handler_t& handler)
+		{
+			std::size_t pos = 0;
+			char const* const fileName = readValue<char const*>(rec, pos);
+			char const* const funcName = readValue<char const*>(rec, pos);
+			const uint32_t line = readValue<uint32_t>(rec, pos);
+			const LogLevel lvl = static_cast<LogLevel>(readValue<uint8_t>(rec, pos));
+
+			std::ostringstream oss;
+			while (pos < rec.size())
+			{
+				const uint8_t tag = readValue<uint8_t>(rec, pos);
+				switch (tag)
+				{
+					case logTag::int64:
+						oss << readValue<int64_t>(rec, pos);
+						break;
+					case logTag::uint64:
+						oss << readValue<uint64_t>(rec, pos);
+						break;
+					case logTag::float64:
+						oss << readValue<double>(rec, pos);
+						break;
+					case logTag::boolean:
+						oss << static_cast<bool>(readValue<uint8_t>(rec, pos));
+						break;
+					case logTag::character:
+						oss << readValue<char>(rec, pos);
+						break;
+					case logTag::string:
+					{
+						const uint32_t len = readValue<uint32_t>(rec, pos);
+						oss.write(rec.data() + pos, len);
+						pos += len;
+						break;
+					}
+					default:
+						// Corrupted record, stop decoding
+						pos = rec.size();
+						break;
+				}
+			}
+
+			handler(fileName, funcName, line, lvl, oss.str());
+		}
+
+		std::vector<char> _buffer; //!< Ring buffer storage
+		std::size_t _read; //!< Position of the oldest record
+		std::size_t _size; //!< Number of occupied bytes
+		std::size_t _overwritten; //!< Number of records overwritten due to a full buffer
+		std::mutex _mutex; //!< Synchronizes commit and drain
+	};
+
+} // namespace log
+} // namespace cadet
+
+#endif  // CADET_BINARYLOGBUFFER_HPP_
@@ -81,3 +81,29 @@
 	#define cadet_likely(x) (x)
 	#define cadet_unlikely(x) (x)
 #endif
+
+// CADET_RESTRICT promises the compiler that a pointer is the only way the pointed-to
+// data is accessed inside the current scope, which enables vectorization and load / store
+// reordering in pointer-heavy kernels that the aliasing rules would otherwise forbid.
+// Use only where the promise actually holds (e.g., distinct input and output vectors).
+#if (defined __GNUC__) || (defined __clang__)
+	#define CADET_RESTRICT __restrict__
+#elif (defined _MSC_VER) || (defined __INTEL_COMPILER)
+	#define CADET_RESTRICT __restrict
+#else
+	#define CADET_RESTRICT
+#endif
+
+// Prefetch the cache line containing the given address for a later read. Used in kernels
+// with data dependent (gather) accesses that the hardware prefetcher cannot predict,
+// e.g., x[colIdx[i]] in sparse matrix-vector products. Expands to nothing if the
+// compiler offers no prefetch intrinsic; the address expression is still evaluated,
+// so it has to be valid (pointing one element past the end is not allowed).
+#ifdef __GNUC__
+	#define cadet_prefetch_read(x) __builtin_prefetch((x), 0, 2)
+#elif (defined _MSC_VER) && (defined _M_X64 || defined _M_IX86)
+	#include <xmmintrin.h>
+	#define cadet_prefetch_read(x) _mm_prefetch(reinterpret_cast<char const*>(x), _MM_HINT_T1)
+#else
+	#define cadet_prefetch_read(x) ((void)(x))
+#endif
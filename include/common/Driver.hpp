@@ -90,6 +90,16 @@ void configureSystemRecorder(cadet::InternalStorageSystemRecorder& recorder, Par
 
 #endif
 
+	// Optionally spill interior solution buffers to scratch files to bound recorder memory
+	std::string spillDir;
+	std::size_t spillBudget = 128 * 1024 * 1024;
+	if (pp.exists("SPILL_TO_DISK") && pp.getBool("SPILL_TO_DISK"))
+	{
+		spillDir = pp.exists("SPILL_DIRECTORY") ? pp.getString("SPILL_DIRECTORY") : std::string(".");
+		if (pp.exists("SPILL_RESIDENT_MEM"))
+			spillBudget = static_cast<std::size_t>(pp.getUint64("SPILL_RESIDENT_MEM"));
+	}
+
 	recorder.deleteRecorders();
 
 	cadet::InternalStorageUnitOpRecorder::StorageConfig cfg;
@@ -119,6 +129,10 @@ void configureSystemRecorder(cadet::InternalStorageSystemRecorder& recorder, Par
 		subRec->sensitivityDotConfig(cfg);
 
 		subRec->splitComponents(splitComponents);
+
+		if (!spillDir.empty())
+			subRec->spillToDisk(spillDir, spillBudget);
+
 		pp.popScope();
 
 		recorder.addRecorder(subRec);
@@ -152,7 +166,8 @@ void readSensitivityInitialState(ParamProvider_t& pp, const char* prefix, std::v
 class Driver
 {
 public:
-	Driver() : _sim(nullptr), _builder(nullptr), _storage(nullptr), _writeLastState(false), _writeLastStateSens(false)
+	Driver() : _sim(nullptr), _builder(nullptr), _storage(nullptr), _writeLastState(false), _writeLastStateSens(false), _compressionLevel(9),
+		_cssMaxCycles(0), _cssTolerance(1e-6)
 	{
 		_builder = cadetCreateModelBuilder();
 	}
@@ -213,7 +228,19 @@ public:
 		// Configure main solver parameters
 		pp.pushScope("solver");
 		_sim->configure(pp);
-		
+
+		// Cyclic steady state mode: treat the configured sections as one cycle of a
+		// repetitive process and iterate the end-of-cycle map until it is stationary
+		if (pp.exists("CSS_MAX_CYCLES"))
+			_cssMaxCycles = static_cast<unsigned int>(pp.getInt("CSS_MAX_CYCLES"));
+		else
+			_cssMaxCycles = 0;
+
+		if (pp.exists("CSS_TOLERANCE"))
+			_cssTolerance = pp.getDouble("CSS_TOLERANCE");
+		else
+			_cssTolerance = 1e-6;
+
 		// Configure section times
 		std::vector<double> secTimes;
 		std::vector<bool> secCont;
@@ -413,7 +440,12 @@ public:
 			_writeLastStateSens = pp.getBool("WRITE_SENS_LAST");
 		else
 			_writeLastStateSens = false;
-		
+
+		if (pp.exists("COMPRESSION_LEVEL"))
+			_compressionLevel = pp.getInt("COMPRESSION_LEVEL");
+		else
+			_compressionLevel = 9;
+
 		pp.popScope(); // scope return
 
 		if (applyInSimulator)
@@ -427,7 +459,14 @@ public:
 	void run()
 	{
 		// Run simulation
-		_sim->integrate();
+		if (_cssMaxCycles > 0)
+		{
+			const unsigned int cycles = _sim->integrateToCyclicSteadyState(_cssMaxCycles, _cssTolerance);
+			if (cycles > _cssMaxCycles)
+				LOG(Warning) << "Cyclic steady state not reached within " << _cssMaxCycles << " cycles";
+		}
+		else
+			_sim->integrate();
 	}
 
 	/**
@@ -447,6 +486,7 @@ public:
 		
 		writer.extendibleFields(false);
 		writer.compressFields(true);
+		writer.compressionLevel(_compressionLevel);
 
 		writer.pushGroup("output");
 		
@@ -544,6 +584,25 @@ public:
 	inline cadet::InternalStorageSystemRecorder* solution() CADET_NOEXCEPT { return _storage; }
 	inline cadet::InternalStorageSystemRecorder const* solution() const CADET_NOEXCEPT { return _storage; }
 
+	/**
+	 * @brief Replaces the internal solution recorder
+	 * @details Takes ownership of the given recorder and registers it in the simulator,
+	 *          if one exists. Call setReturnConfiguration() afterwards to configure the
+	 *          new recorder from a parameter provider. This allows swapping in, for
+	 *          instance, a cadet::StreamingStorageSystemRecorder that flushes time
+	 *          chunks to file during integration instead of accumulating the full
+	 *          solution in memory and writing it via write() after the run.
+	 * @param [in] rec Recorder that is henceforth owned by this driver
+	 */
+	inline void setSolutionRecorder(cadet::InternalStorageSystemRecorder* rec)
+	{
+		delete _storage;
+		_storage = rec;
+
+		if (_sim)
+			_sim->setSolutionRecorder(_storage);
+	}
+
 protected:
 	cadet::ISimulator* _sim; //!< Simulator owned by this driver
 	cadet::IModelBuilder* _builder; //!< Model builder owned by this driver
@@ -551,6 +610,9 @@ protected:
 
 	bool _writeLastState;
 	bool _writeLastStateSens;
+	int _compressionLevel; //!< Deflate level applied to compressed output fields
+	unsigned int _cssMaxCycles; //!< Maximum number of cycle evaluations in cyclic steady state mode, @c 0 runs a single plain integration
+	double _cssTolerance; //!< Relative cycle-to-cycle change below which cyclic steady state is reached
 
 	/**
 	 * @brief Sets section times and section continuity from the given parameter provider
@@ -0,0 +1,238 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides an accumulating hardware performance counter set for instrumenting hot code paths.
+ * On Linux, the counters are read via the perf_event interface of the kernel. On all other
+ * platforms (or if the kernel denies access to the counters, e.g., due to a restrictive
+ * perf_event_paranoid setting), a no-op stub is used that reports zero counts.
+ */
+
+#ifndef CADET_HARDWARECOUNTERS_HPP_
+#define CADET_HARDWARECOUNTERS_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#ifdef __linux__
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+	#include <cstring>
+#endif
+
+namespace cadet
+{
+
+#ifdef __linux__
+
+	/**
+	 * @brief Accumulating set of hardware performance counters measured via perf_event
+	 * @details Counts CPU cycles, retired instructions, last level cache references, and last
+	 *          level cache misses between all start() and stop() calls. The counters are opened
+	 *          as one perf_event group so that all four events are measured simultaneously and
+	 *          consistently.
+	 *
+	 *          Just like Timer, an instance is driven from a single thread and, in addition,
+	 *          only counts events of the calling thread. Work performed by other threads (e.g.,
+	 *          inside a parallel loop) is not attributed to the counters. Measurements are,
+	 *          thus, most meaningful in single threaded runs.
+	 */
+	class HardwareCounters
+	{
+	public:
+
+		enum : unsigned int
+		{
+			Cycles = 0,
+			Instructions = 1,
+			CacheReferences = 2,
+			CacheMisses = 3,
+			NumCounters = 4
+		};
+
+		HardwareCounters() : _valid(false)
+		{
+			for (unsigned int i = 0; i < NumCounters; ++i)
+				_fd[i] = -1;
+
+			const std::uint64_t configs[NumCounters] = {
+				PERF_COUNT_HW_CPU_CYCLES,
+				PERF_COUNT_HW_INSTRUCTIONS,
+				PERF_COUNT_HW_CACHE_REFERENCES,
+				PERF_COUNT_HW_CACHE_MISSES
+			};
+
+			perf_event_attr attr;
+			for (unsigned int i = 0; i < NumCounters; ++i)
+			{
+				std::memset(&attr, 0, sizeof(attr));
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.size = sizeof(attr);
+				attr.config = configs[i];
+				// The group leader starts disabled and controls all siblings
+				attr.disabled = (i == 0) ? 1 : 0;
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+				attr.read_format = PERF_FORMAT_GROUP;
+
+				const long fd = syscall(__NR_perf_event_open, &attr, 0, -1, (i == 0) ? -1 : _fd[0], 0);
+				if (fd < 0)
+				{
+					// Counter unavailable (missing permissions or unsupported hardware), degrade to no-op
+					closeCounters();
+					return;
+				}
+				_fd[i] = static_cast<int>(fd);
+			}
+			_valid = true;
+		}
+
+		~HardwareCounters()
+		{
+			closeCounters();
+		}
+
+		/**
+		 * @brief Starts counting hardware events
+		 */
+		inline void start()
+		{
+			if (_valid)
+				ioctl(_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		}
+
+		/**
+		 * @brief Stops counting hardware events
+		 * @details Accumulates the event counts over all start() and stop() calls.
+		 */
+		inline void stop()
+		{
+			if (_valid)
+				ioctl(_fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		}
+
+		/**
+		 * @brief Returns whether the hardware counters could be opened
+		 * @return @c true if real counts are reported, @c false if all counts are zero
+		 */
+		inline bool valid() const { return _valid; }
+
+		/**
+		 * @brief Returns the total count of the given event between all start() and stop() calls
+		 * @param [in] idx Index of the event (e.g., HardwareCounters::CacheMisses)
+		 * @return Total event count, or @c 0 if the counters could not be opened
+		 */
+		inline std::uint64_t totalCount(unsigned int idx) const
+		{
+			std::uint64_t counts[NumCounters];
+			readCounters(counts);
+			return counts[idx];
+		}
+
+		/**
+		 * @brief Appends the total counts of all events to the given vector
+		 * @details The counts are appended in the order of the event indices (cycles,
+		 *          instructions, cache references, cache misses).
+		 * @param [in,out] vec Vector the counts are appended to
+		 */
+		inline void appendCounts(std::vector<double>& vec) const
+		{
+			std::uint64_t counts[NumCounters];
+			readCounters(counts);
+			for (unsigned int i = 0; i < NumCounters; ++i)
+				vec.push_back(static_cast<double>(counts[i]));
+		}
+
+	private:
+
+		HardwareCounters(const HardwareCounters&) = delete;
+		HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+		inline void readCounters(std::uint64_t* counts) const
+		{
+			for (unsigned int i = 0; i < NumCounters; ++i)
+				counts[i] = 0;
+
+			if (!_valid)
+				return;
+
+			// Layout given by PERF_FORMAT_GROUP: number of events followed by one value per event
+			std::uint64_t buffer[1 + NumCounters];
+			if (read(_fd[0], buffer, sizeof(buffer)) == static_cast<ssize_t>(sizeof(buffer)))
+			{
+				for (unsigned int i = 0; i < NumCounters; ++i)
+					counts[i] = buffer[1 + i];
+			}
+		}
+
+		inline void closeCounters()
+		{
+			for (unsigned int i = 0; i < NumCounters; ++i)
+			{
+				if (_fd[i] >= 0)
+					close(_fd[i]);
+				_fd[i] = -1;
+			}
+			_valid = false;
+		}
+
+		int _fd[NumCounters];
+		bool _valid;
+	};
+
+#else
+
+	/**
+	 * @brief No-op stub of the hardware performance counter set for platforms without perf_event
+	 * @details Provides the same interface as the Linux implementation but always reports
+	 *          zero counts.
+	 */
+	class HardwareCounters
+	{
+	public:
+
+		enum : unsigned int
+		{
+			Cycles = 0,
+			Instructions = 1,
+			CacheReferences = 2,
+			CacheMisses = 3,
+			NumCounters = 4
+		};
+
+		HardwareCounters() { }
+
+		inline void start() { }
+		inline void stop() { }
+		inline bool valid() const { return false; }
+		inline std::uint64_t totalCount(unsigned int idx) const { return 0; }
+
+		inline void appendCounts(std::vector<double>& vec) const
+		{
+			for (unsigned int i = 0; i < NumCounters; ++i)
+				vec.push_back(0.0);
+		}
+
+	private:
+
+		HardwareCounters(const HardwareCounters&) = delete;
+		HardwareCounters& operator=(const HardwareCounters&) = delete;
+	};
+
+#endif  // __linux__
+
+} // namespace cadet
+
+#endif  // CADET_HARDWARECOUNTERS_HPP_
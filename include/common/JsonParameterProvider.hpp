@@ -0,0 +1,216 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides an IParameterProvider implementation backed by an in-memory JSON document.
+ */
+
+#ifndef CADET_JSONPARAMETERPROVIDER_HPP_
+#define CADET_JSONPARAMETERPROVIDER_HPP_
+
+#include <string>
+#include <vector>
+
+#include <json.hpp>
+
+#include "cadet/ParameterProvider.hpp"
+#include "cadet/Exceptions.hpp"
+
+namespace cadet
+{
+
+/**
+ * @brief Parameter provider backed by a JSON document held in memory
+ * @details Mirrors the group / dataset structure of the file based readers: JSON objects
+ *          act as groups, all other values as datasets. Scalars and one-element arrays
+ *          are interchangeable (reading a scalar as an array yields one element and vice
+ *          versa), matching the behavior of the HDF5 reader. The document is copied on
+ *          construction, so the source buffer can be released immediately.
+ */
+class JsonParameterProvider : public IParameterProvider
+{
+public:
+
+	/**
+	 * @brief Creates a parameter provider from a JSON document
+	 * @param [in] doc Parsed JSON document, copied into the provider
+	 */
+	JsonParameterProvider(const nlohmann::json& doc) : _root(doc)
+	{
+		_scopePath.push_back(&_root);
+	}
+
+	/**
+	 * @brief Creates a parameter provider by parsing a JSON text buffer
+	 * @param [in] data Pointer to the first character of the buffer
+	 * @param [in] length Number of characters in the buffer
+	 */
+	JsonParameterProvider(char const* data, std::size_t length) : _root(nlohmann::json::parse(data, data + length))
+	{
+		_scopePath.push_back(&_root);
+	}
+
+	virtual ~JsonParameterProvider() CADET_NOEXCEPT { }
+
+	virtual double getDouble(const std::string& paramName)
+	{
+		const nlohmann::json& p = item(paramName);
+		if (p.is_array())
+			return p.at(0).get<double>();
+		return p.get<double>();
+	}
+
+	virtual int getInt(const std::string& paramName)
+	{
+		const nlohmann::json& p = item(paramName);
+		if (p.is_array())
+			return scalarInt(p.at(0));
+		return scalarInt(p);
+	}
+
+	virtual uint64_t getUint64(const std::string& paramName)
+	{
+		const nlohmann::json& p = item(paramName);
+		if (p.is_array())
+			return p.at(0).get<uint64_t>();
+		return p.get<uint64_t>();
+	}
+
+	virtual bool getBool(const std::string& paramName)
+	{
+		const nlohmann::json& p = item(paramName);
+		if (p.is_array())
+			return scalarBool(p.at(0));
+		return scalarBool(p);
+	}
+
+	virtual std::string getString(const std::string& paramName)
+	{
+		const nlohmann::json& p = item(paramName);
+		if (p.is_array())
+			return p.at(0).get<std::string>();
+		return p.get<std::string>();
+	}
+
+	virtual std::vector<double> getDoubleArray(const std::string& paramName)
+	{
+		const nlohmann::json& p = item(paramName);
+		if (p.is_array())
+			return p.get<std::vector<double>>();
+		return std::vector<double>(1, p.get<double>());
+	}
+
+	virtual std::vector<int> getIntArray(const std::string& paramName)
+	{
+		const nlohmann::json& p = item(paramName);
+		if (!p.is_array())
+			return std::vector<int>(1, scalarInt(p));
+
+		std::vector<int> v;
+		v.reserve(p.size());
+		for (std::size_t i = 0; i < p.size(); ++i)
+			v.push_back(scalarInt(p.at(i)));
+		return v;
+	}
+
+	virtual std::vector<uint64_t> getUint64Array(const std::string& paramName)
+	{
+		const nlohmann::json& p = item(paramName);
+		if (p.is_array())
+			return p.get<std::vector<uint64_t>>();
+		return std::vector<uint64_t>(1, p.get<uint64_t>());
+	}
+
+	virtual std::vector<bool> getBoolArray(const std::string& paramName)
+	{
+		const nlohmann::json& p = item(paramName);
+		if (!p.is_array())
+			return std::vector<bool>(1, scalarBool(p));
+
+		std::vector<bool> v;
+		v.reserve(p.size());
+		for (std::size_t i = 0; i < p.size(); ++i)
+			v.push_back(scalarBool(p.at(i)));
+		return v;
+	}
+
+	virtual std::vector<std::string> getStringArray(const std::string& paramName)
+	{
+		const nlohmann::json& p = item(paramName);
+		if (p.is_array())
+			return p.get<std::vector<std::string>>();
+		return std::vector<std::string>(1, p.get<std::string>());
+	}
+
+	virtual bool exists(const std::string& paramName)
+	{
+		return _scopePath.back()->find(paramName) != _scopePath.back()->end();
+	}
+
+	virtual bool isArray(const std::string& paramName)
+	{
+		return item(paramName).is_array();
+	}
+
+	virtual void pushScope(const std::string& scope)
+	{
+		_scopePath.push_back(&item(scope));
+	}
+
+	virtual void popScope()
+	{
+		_scopePath.pop_back();
+	}
+
+protected:
+
+	/**
+	 * @brief Looks a dataset or group up in the current scope
+	 * @param [in] name Name of the dataset or group
+	 * @return Reference to the JSON value
+	 */
+	inline const nlohmann::json& item(const std::string& name) const
+	{
+		const nlohmann::json::const_iterator it = _scopePath.back()->find(name);
+		if (it == _scopePath.back()->end())
+			throw InvalidParameterException("Field " + name + " does not exist in JSON document");
+		return *it;
+	}
+
+	/**
+	 * @brief Converts a scalar JSON value to int, accepting booleans like the file readers
+	 */
+	static inline int scalarInt(const nlohmann::json& p)
+	{
+		if (p.is_boolean())
+			return p.get<bool>() ? 1 : 0;
+		return p.get<int>();
+	}
+
+	/**
+	 * @brief Converts a scalar JSON value to bool, accepting numbers like the file readers
+	 */
+	static inline bool scalarBool(const nlohmann::json& p)
+	{
+		if (p.is_boolean())
+			return p.get<bool>();
+		return p.get<int>() != 0;
+	}
+
+	nlohmann::json _root; //!< Owned copy of the JSON document
+	std::vector<nlohmann::json const*> _scopePath; //!< Stack of entered scopes, the root is always at the bottom
+};
+
+} // namespace cadet
+
+#endif  // CADET_JSONPARAMETERPROVIDER_HPP_
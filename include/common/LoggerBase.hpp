@@ -31,6 +31,7 @@
 #include <ostream>
 #include <utility>
 #include <type_traits>
+#include <atomic>
 
 namespace cadet
 {
@@ -468,15 +469,17 @@ namespace log
 		template <LogLevel lvl, class params_t>
 		static inline void forward(const char* fileName, const char* funcName, unsigned int line, const detail::LogMessage<lvl, true, params_t>& lm)
 		{
-			if (lvl <= _minLvl)
+			if (lvl <= _minLvl.load(std::memory_order_relaxed))
 				forward_logger_t::forward(fileName, funcName, line, lm);
 		}
 
-		static inline LogLevel level() CADET_NOEXCEPT { return _minLvl; }
-		static inline void level(LogLevel newLvl) CADET_NOEXCEPT { _minLvl = newLvl; }
+		static inline LogLevel level() CADET_NOEXCEPT { return _minLvl.load(std::memory_order_relaxed); }
+		static inline void level(LogLevel newLvl) CADET_NOEXCEPT { _minLvl.store(newLvl, std::memory_order_relaxed); }
 
 	private:
-		static LogLevel _minLvl;
+		// Atomic since the level is queried by every log statement and may be changed
+		// at any time from another thread (e.g., while several simulators are running)
+		static std::atomic<LogLevel> _minLvl;
 	};
 
 	template <class formattingPolicy_t, class writePolicy_t>
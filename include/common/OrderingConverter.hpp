@@ -19,6 +19,7 @@
 #define CADET_ORDERINGCONVERTER_HPP_
 
 #include <vector>
+#include <algorithm>
 
 #include "common/CompilerSpecific.hpp"
 
@@ -57,6 +58,7 @@ public:
 	{
 		prepareConversionToCol(dims.data(), dims.size());
 		prepareConversionToRow(dims.data(), dims.size());
+		copyDims(dims.data(), dims.size());
 	}
 
 	/**
@@ -71,6 +73,7 @@ public:
 		cadet_assert(size > 0);
 		prepareConversionToCol(dims, size);
 		prepareConversionToRow(dims, size);
+		copyDims(dims, size);
 	}
 
 	/**
@@ -235,11 +238,151 @@ public:
 	 */
 	inline const std::vector<index_t> subscriptIndex() const { return _subscript; }
 
+	/**
+	 * @brief Returns the total number of elements of the tensor
+	 * @return Number of tensor elements
+	 */
+	inline index_t numElements() const
+	{
+		index_t n = 1;
+		for (unsigned int i = 0; i < _dims.size(); ++i)
+			n *= _dims[i];
+		return n;
+	}
+
+	/**
+	 * @brief Checks whether row-major and column-major ordering coincide for this tensor
+	 * @details The two orderings produce the same linear layout if at most one dimension
+	 *          is non-trivial (i.e., greater than @c 1). In this case no reordering is
+	 *          required at all and the source array can be used as is (zero-copy).
+	 * @return @c true if both orderings result in the same linear layout, otherwise @c false
+	 */
+	inline bool trivialOrdering() const
+	{
+		unsigned int nonTrivial = 0;
+		for (unsigned int i = 0; i < _dims.size(); ++i)
+		{
+			if (_dims[i] > 1)
+				++nonTrivial;
+		}
+		return nonTrivial <= 1;
+	}
+
+	/**
+	 * @brief Converts a full tensor from row-major to column-major storage
+	 * @details The copy is blocked on the first and last dimension (the ones whose strides
+	 *          differ the most between the two orderings), so both source and destination
+	 *          are accessed in cache-sized tiles instead of long strided sweeps. If both
+	 *          orderings coincide (see trivialOrdering()), the data is copied straight through.
+	 * @param [in] src Pointer to tensor data in row-major storage
+	 * @param [out] dest Pointer to array of size numElements() receiving the column-major data
+	 */
+	inline void convertRowToCol(double const* const src, double* const dest) const
+	{
+		convertBlocked(src, dest, _prodToRow, _prodToCol);
+	}
+
+	/**
+	 * @brief Converts a full tensor from column-major to row-major storage
+	 * @details See convertRowToCol() for details on the blocked copy.
+	 * @param [in] src Pointer to tensor data in column-major storage
+	 * @param [out] dest Pointer to array of size numElements() receiving the row-major data
+	 */
+	inline void convertColToRow(double const* const src, double* const dest) const
+	{
+		convertBlocked(src, dest, _prodToCol, _prodToRow);
+	}
+
 protected:
 	std::vector<index_t> _prodToRow; //!< Helper vector for conversions from / to row-major
 	std::vector<index_t> _prodToCol; //!< Helper vector for conversions from / to column-major
+	std::vector<index_t> _dims; //!< Dimensions of the tensor
 	mutable std::vector<index_t> _subscript; //!< Cache for subscript index
 
+	template <typename T>
+	void copyDims(T const* dims, unsigned int size)
+	{
+		_dims.resize(size);
+		for (unsigned int i = 0; i < size; ++i)
+			_dims[i] = dims[i];
+	}
+
+	/**
+	 * @brief Copies a full tensor between the two storage orders using cache-sized tiles
+	 * @details The first and last dimension are the ones with contiguous access in one
+	 *          ordering and maximum stride in the other. Tiling these two dimensions
+	 *          keeps the working set of both source and destination in cache; all middle
+	 *          dimensions are traversed with incrementally updated offsets, which avoids
+	 *          the division and modulo operations of an element-wise index conversion.
+	 * @param [in] src Pointer to source tensor data
+	 * @param [out] dest Pointer to destination array of size numElements()
+	 * @param [in] srcProd Helper array of the source storage order
+	 * @param [in] destProd Helper array of the destination storage order
+	 */
+	void convertBlocked(double const* const src, double* const dest, const std::vector<index_t>& srcProd, const std::vector<index_t>& destProd) const
+	{
+		// Zero reordering required if both layouts coincide
+		if (trivialOrdering())
+		{
+			std::copy(src, src + numElements(), dest);
+			return;
+		}
+
+		const index_t tile = 32;
+		const unsigned int rank = _dims.size();
+		const index_t nFirst = _dims[0];
+		const index_t nLast = _dims[rank - 1];
+		const index_t srcFirst = srcProd[0];
+		const index_t srcLast = srcProd[rank - 1];
+		const index_t destFirst = destProd[0];
+		const index_t destLast = destProd[rank - 1];
+
+		// Odometer over the middle dimensions
+		std::vector<index_t>& mid = _subscript;
+		std::fill(mid.begin(), mid.end(), 0);
+
+		bool more = true;
+		while (more)
+		{
+			index_t srcMid = 0;
+			index_t destMid = 0;
+			for (unsigned int j = 1; j + 1 < rank; ++j)
+			{
+				srcMid += mid[j] * srcProd[j];
+				destMid += mid[j] * destProd[j];
+			}
+
+			for (index_t i0 = 0; i0 < nFirst; i0 += tile)
+			{
+				const index_t endI = std::min(nFirst, i0 + tile);
+				for (index_t j0 = 0; j0 < nLast; j0 += tile)
+				{
+					const index_t endJ = std::min(nLast, j0 + tile);
+					for (index_t i = i0; i < endI; ++i)
+					{
+						const index_t srcOff = srcMid + i * srcFirst;
+						const index_t destOff = destMid + i * destFirst;
+						for (index_t j = j0; j < endJ; ++j)
+							dest[destOff + j * destLast] = src[srcOff + j * srcLast];
+					}
+				}
+			}
+
+			// Advance the middle subscripts
+			more = false;
+			for (unsigned int j = 1; j + 1 < rank; ++j)
+			{
+				++mid[j];
+				if (mid[j] < _dims[j])
+				{
+					more = true;
+					break;
+				}
+				mid[j] = 0;
+			}
+		}
+	}
+
 	template <typename T>
 	void prepareConversionToCol(T const* dims, unsigned int size)
 	{
@@ -0,0 +1,398 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a copy-on-write overlay on top of another IParameterProvider.
+ */
+
+#ifndef CADET_OVERLAYPARAMETERPROVIDER_HPP_
+#define CADET_OVERLAYPARAMETERPROVIDER_HPP_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cadet/ParameterProvider.hpp"
+#include "cadet/Exceptions.hpp"
+#include "cadet/HashUtil.hpp"
+
+namespace cadet
+{
+
+/**
+ * @brief Copy-on-write overlay on top of another parameter provider
+ * @details Campaign sweeps differ from a base model in a handful of leaf values only.
+ *          Instead of parsing a full input per run, the base input is parsed (or memory
+ *          mapped) once and each run wraps it in an overlay that holds just the changed
+ *          leaves. Reads first consult the overlay and fall through to the base provider,
+ *          so the base is never modified and can back many overlays.
+ *
+ *          Overridden leaves are stored in a flat map keyed by a hash of their scope path
+ *          (chained with hash_combine() over the path segments), so lookup cost does not
+ *          grow with scope depth and the overlay does not mirror the group hierarchy of
+ *          the base. Consequently, an override can only live in a scope that exists in
+ *          the base provider: pushScope() is forwarded to the base, which rejects unknown
+ *          groups. New leaves in existing scopes are fine. A hash collision between two
+ *          distinct paths would silently alias them; with 64 bit hashes and the handful
+ *          of overrides of a sweep this is not a practical concern.
+ *
+ *          The overlay references the base provider and does not take ownership. Since
+ *          scope state lives in the base, a base provider instance can only serve one
+ *          overlay at a time; concurrent workers each wrap their own view of the base
+ *          (e.g., their own BinaryReader on a shared memory mapped snapshot).
+ */
+class OverlayParameterProvider : public IParameterProvider
+{
+public:
+
+	/**
+	 * @brief Creates an overlay with no overridden leaves on top of the given provider
+	 * @param [in] base Base provider the overlay reads through to, not owned
+	 */
+	OverlayParameterProvider(IParameterProvider& base) : _base(base), _scopeHash(1, 0)
+	{
+	}
+
+	virtual ~OverlayParameterProvider() CADET_NOEXCEPT { }
+
+	virtual double getDouble(const std::string& paramName)
+	{
+		DeltaValue const* const dv = findDelta(paramName);
+		if (!dv)
+			return _base.getDouble(paramName);
+		if (dv->type == DeltaType::Double)
+			return dv->valDouble;
+		if ((dv->type == DeltaType::DoubleArray) && (dv->arrDouble.size() == 1))
+			return dv->arrDouble[0];
+		throw InvalidParameterException("Overridden field " + paramName + " is not a double");
+	}
+
+	virtual int getInt(const std::string& paramName)
+	{
+		DeltaValue const* const dv = findDelta(paramName);
+		if (!dv)
+			return _base.getInt(paramName);
+		if (dv->type == DeltaType::Int)
+			return dv->valInt;
+		if ((dv->type == DeltaType::IntArray) && (dv->arrInt.size() == 1))
+			return dv->arrInt[0];
+		throw InvalidParameterException("Overridden field " + paramName + " is not an int");
+	}
+
+	virtual uint64_t getUint64(const std::string& paramName)
+	{
+		DeltaValue const* const dv = findDelta(paramName);
+		if (!dv)
+			return _base.getUint64(paramName);
+		if (dv->type == DeltaType::Uint64)
+			return dv->valUint64;
+		if ((dv->type == DeltaType::Uint64Array) && (dv->arrUint64.size() == 1))
+			return dv->arrUint64[0];
+		throw InvalidParameterException("Overridden field " + paramName + " is not a uint64");
+	}
+
+	virtual bool getBool(const std::string& paramName)
+	{
+		DeltaValue const* const dv = findDelta(paramName);
+		if (!dv)
+			return _base.getBool(paramName);
+		if (dv->type == DeltaType::Bool)
+			return dv->valBool;
+		if ((dv->type == DeltaType::BoolArray) && (dv->arrBool.size() == 1))
+			return dv->arrBool[0];
+		throw InvalidParameterException("Overridden field " + paramName + " is not a bool");
+	}
+
+	virtual std::string getString(const std::string& paramName)
+	{
+		DeltaValue const* const dv = findDelta(paramName);
+		if (!dv)
+			return _base.getString(paramName);
+		if (dv->type == DeltaType::String)
+			return dv->valString;
+		if ((dv->type == DeltaType::StringArray) && (dv->arrString.size() == 1))
+			return dv->arrString[0];
+		throw InvalidParameterException("Overridden field " + paramName + " is not a string");
+	}
+
+	virtual std::vector<double> getDoubleArray(const std::string& paramName)
+	{
+		DeltaValue const* const dv = findDelta(paramName);
+		if (!dv)
+			return _base.getDoubleArray(paramName);
+		if (dv->type == DeltaType::DoubleArray)
+			return dv->arrDouble;
+		if (dv->type == DeltaType::Double)
+			return std::vector<double>(1, dv->valDouble);
+		throw InvalidParameterException("Overridden field " + paramName + " is not a double array");
+	}
+
+	virtual std::vector<int> getIntArray(const std::string& paramName)
+	{
+		DeltaValue const* const dv = findDelta(paramName);
+		if (!dv)
+			return _base.getIntArray(paramName);
+		if (dv->type == DeltaType::IntArray)
+			return dv->arrInt;
+		if (dv->type == DeltaType::Int)
+			return std::vector<int>(1, dv->valInt);
+		throw InvalidParameterException("Overridden field " + paramName + " is not an int array");
+	}
+
+	virtual std::vector<uint64_t> getUint64Array(const std::string& paramName)
+	{
+		DeltaValue const* const dv = findDelta(paramName);
+		if (!dv)
+			return _base.getUint64Array(paramName);
+		if (dv->type == DeltaType::Uint64Array)
+			return dv->arrUint64;
+		if (dv->type == DeltaType::Uint64)
+			return std::vector<uint64_t>(1, dv->valUint64);
+		throw InvalidParameterException("Overridden field " + paramName + " is not a uint64 array");
+	}
+
+	virtual std::vector<bool> getBoolArray(const std::string& paramName)
+	{
+		DeltaValue const* const dv = findDelta(paramName);
+		if (!dv)
+			return _base.getBoolArray(paramName);
+		if (dv->type == DeltaType::BoolArray)
+			return dv->arrBool;
+		if (dv->type == DeltaType::Bool)
+			return std::vector<bool>(1, dv->valBool);
+		throw InvalidParameterException("Overridden field " + paramName + " is not a bool array");
+	}
+
+	virtual std::vector<std::string> getStringArray(const std::string& paramName)
+	{
+		DeltaValue const* const dv = findDelta(paramName);
+		if (!dv)
+			return _base.getStringArray(paramName);
+		if (dv->type == DeltaType::StringArray)
+			return dv->arrString;
+		if (dv->type == DeltaType::String)
+			return std::vector<std::string>(1, dv->valString);
+		throw InvalidParameterException("Overridden field " + paramName + " is not a string array");
+	}
+
+	virtual bool exists(const std::string& paramName)
+	{
+		if (findDelta(paramName))
+			return true;
+		return _base.exists(paramName);
+	}
+
+	virtual bool isArray(const std::string& paramName)
+	{
+		DeltaValue const* const dv = findDelta(paramName);
+		if (!dv)
+			return _base.isArray(paramName);
+		switch (dv->type)
+		{
+			case DeltaType::DoubleArray:
+			case DeltaType::IntArray:
+			case DeltaType::Uint64Array:
+			case DeltaType::BoolArray:
+			case DeltaType::StringArray:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	virtual void pushScope(const std::string& scope)
+	{
+		_base.pushScope(scope);
+		uint64_t h = _scopeHash.back();
+		hash_combine(h, scope);
+		_scopeHash.push_back(h);
+	}
+
+	virtual void popScope()
+	{
+		_base.popScope();
+		if (_scopeHash.size() > 1)
+			_scopeHash.pop_back();
+	}
+
+	/**
+	 * @brief Overrides a double leaf at the given path
+	 * @details The path is relative to the root of the base provider with scopes
+	 *          separated by @c / and the leaf name as last segment, e.g.,
+	 *          @c "model/unit_000/COL_DISPERSION". An existing override at the same
+	 *          path is replaced regardless of its type.
+	 * @param [in] path Slash separated path of the leaf
+	 * @param [in] val Value the leaf reads as through this overlay
+	 */
+	void setDouble(const std::string& path, double val)
+	{
+		DeltaValue& dv = insertDelta(path, DeltaType::Double);
+		dv.valDouble = val;
+	}
+
+	//! \brief Overrides an int leaf at the given path, see setDouble()
+	void setInt(const std::string& path, int val)
+	{
+		DeltaValue& dv = insertDelta(path, DeltaType::Int);
+		dv.valInt = val;
+	}
+
+	//! \brief Overrides a uint64 leaf at the given path, see setDouble()
+	void setUint64(const std::string& path, uint64_t val)
+	{
+		DeltaValue& dv = insertDelta(path, DeltaType::Uint64);
+		dv.valUint64 = val;
+	}
+
+	//! \brief Overrides a bool leaf at the given path, see setDouble()
+	void setBool(const std::string& path, bool val)
+	{
+		DeltaValue& dv = insertDelta(path, DeltaType::Bool);
+		dv.valBool = val;
+	}
+
+	//! \brief Overrides a string leaf at the given path, see setDouble()
+	void setString(const std::string& path, const std::string& val)
+	{
+		DeltaValue& dv = insertDelta(path, DeltaType::String);
+		dv.valString = val;
+	}
+
+	//! \brief Overrides a double array leaf at the given path, see setDouble()
+	void setDoubleArray(const std::string& path, const std::vector<double>& val)
+	{
+		DeltaValue& dv = insertDelta(path, DeltaType::DoubleArray);
+		dv.arrDouble = val;
+	}
+
+	//! \brief Overrides an int array leaf at the given path, see setDouble()
+	void setIntArray(const std::string& path, const std::vector<int>& val)
+	{
+		DeltaValue& dv = insertDelta(path, DeltaType::IntArray);
+		dv.arrInt = val;
+	}
+
+	//! \brief Overrides a uint64 array leaf at the given path, see setDouble()
+	void setUint64Array(const std::string& path, const std::vector<uint64_t>& val)
+	{
+		DeltaValue& dv = insertDelta(path, DeltaType::Uint64Array);
+		dv.arrUint64 = val;
+	}
+
+	//! \brief Overrides a bool array leaf at the given path, see setDouble()
+	void setBoolArray(const std::string& path, const std::vector<bool>& val)
+	{
+		DeltaValue& dv = insertDelta(path, DeltaType::BoolArray);
+		dv.arrBool = val;
+	}
+
+	//! \brief Overrides a string array leaf at the given path, see setDouble()
+	void setStringArray(const std::string& path, const std::vector<std::string>& val)
+	{
+		DeltaValue& dv = insertDelta(path, DeltaType::StringArray);
+		dv.arrString = val;
+	}
+
+	/**
+	 * @brief Returns the number of overridden leaves
+	 * @return Number of overridden leaves
+	 */
+	inline std::size_t numOverrides() const CADET_NOEXCEPT { return _deltas.size(); }
+
+	/**
+	 * @brief Removes all overridden leaves
+	 * @details Allows reusing the overlay (and its base provider) for the next run of
+	 *          a campaign without rebuilding either.
+	 */
+	inline void clearOverrides() { _deltas.clear(); }
+
+protected:
+
+	//! Type of an overridden leaf value
+	enum class DeltaType : int
+	{
+		Double, Int, Uint64, Bool, String,
+		DoubleArray, IntArray, Uint64Array, BoolArray, StringArray
+	};
+
+	/**
+	 * @brief Overridden leaf value
+	 * @details Only the member selected by type is meaningful. Overrides are few (the
+	 *          delta of a sweep run), so the unused members are not worth a union.
+	 */
+	struct DeltaValue
+	{
+		DeltaType type;
+		double valDouble;
+		int valInt;
+		uint64_t valUint64;
+		bool valBool;
+		std::string valString;
+		std::vector<double> arrDouble;
+		std::vector<int> arrInt;
+		std::vector<uint64_t> arrUint64;
+		std::vector<bool> arrBool;
+		std::vector<std::string> arrString;
+	};
+
+	/**
+	 * @brief Looks up an override of the given leaf in the current scope
+	 * @param [in] paramName Name of the leaf
+	 * @return Pointer to the override, or @c nullptr if the leaf is not overridden
+	 */
+	inline DeltaValue const* findDelta(const std::string& paramName) const
+	{
+		uint64_t key = _scopeHash.back();
+		hash_combine(key, paramName);
+		const std::unordered_map<uint64_t, DeltaValue>::const_iterator it = _deltas.find(key);
+		if (it == _deltas.end())
+			return nullptr;
+		return &it->second;
+	}
+
+	/**
+	 * @brief Creates (or replaces) the override at the given slash separated path
+	 * @details Hashes the path segments with the same chaining pushScope() uses, so
+	 *          reads in the corresponding scope find the override.
+	 * @param [in] path Slash separated path of the leaf relative to the provider root
+	 * @param [in] type Type of the new override
+	 * @return Reference to the override value to be filled by the caller
+	 */
+	DeltaValue& insertDelta(const std::string& path, DeltaType type)
+	{
+		uint64_t key = _scopeHash.front();
+		std::size_t segStart = 0;
+		while (segStart < path.size())
+		{
+			std::size_t segEnd = path.find('/', segStart);
+			if (segEnd == std::string::npos)
+				segEnd = path.size();
+			if (segEnd > segStart)
+				hash_combine(key, path.substr(segStart, segEnd - segStart));
+			segStart = segEnd + 1;
+		}
+
+		DeltaValue& dv = _deltas[key];
+		dv = DeltaValue();
+		dv.type = type;
+		return dv;
+	}
+
+	IParameterProvider& _base; //!< Base provider reads fall through to, not owned
+	std::vector<uint64_t> _scopeHash; //!< Chained hashes of the current scope path, front is the root
+	std::unordered_map<uint64_t, DeltaValue> _deltas; //!< Overridden leaves keyed by hashed scope path
+};
+
+} // namespace cadet
+
+#endif  // CADET_OVERLAYPARAMETERPROVIDER_HPP_
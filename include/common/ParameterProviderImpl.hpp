@@ -19,6 +19,8 @@
 #define CADET_PARAMPROVIDER_HPP_
 
 #include <string>
+#include <vector>
+#include <unordered_map>
 
 #include "cadet/ParameterProvider.hpp"
 
@@ -32,10 +34,13 @@ public:
 
 	ParameterProviderImpl(Reader_t& reader) : ParameterProviderImpl(reader, true) { }
 
-	ParameterProviderImpl(Reader_t& reader, bool inputPrefix) : _reader(reader)
+	ParameterProviderImpl(Reader_t& reader, bool inputPrefix) : _reader(reader), _scopePath()
 	{
 		if (inputPrefix)
+		{
 			_reader.setGroup("input");
+			_scopePath = "/input";
+		}
 	}
 
 	virtual ~ParameterProviderImpl() CADET_NOEXCEPT { }
@@ -116,14 +121,34 @@ public:
 
 	virtual bool exists(const std::string& paramName)
 	{
+		// Existence checks are repeated often during (re-)configuration, so cache
+		// them by their fully scoped path instead of walking the file hierarchy
+		const std::string key = _scopePath + "/" + paramName;
+		const typename std::unordered_map<std::string, bool>::const_iterator it = _existsCache.find(key);
+		if (it != _existsCache.end())
+		{
+			LOG(Debug) << "EXISTS " << paramName << " = " << (it->second ? "yes" : "no") << " (cached)";
+			return it->second;
+		}
+
 		const bool val = _reader.exists(paramName);
+		_existsCache[key] = val;
 		LOG(Debug) << "EXISTS " << paramName << " = " << (val ? "yes" : "no");
 		return val;
 	}
 
 	virtual bool isArray(const std::string& paramName)
 	{
+		const std::string key = _scopePath + "/" + paramName;
+		const typename std::unordered_map<std::string, bool>::const_iterator it = _isArrayCache.find(key);
+		if (it != _isArrayCache.end())
+		{
+			LOG(Debug) << "ISARRAY " << paramName << " = " << (it->second ? "yes" : "no") << " (cached)";
+			return it->second;
+		}
+
 		const bool val = _reader.isVector(paramName);
+		_isArrayCache[key] = val;
 		LOG(Debug) << "ISARRAY " << paramName << " = " << (val ? "yes" : "no");
 		return val;
 	}
@@ -132,15 +157,26 @@ public:
 	{
 		LOG(Debug) << "SCOPE " << scope;
 		_reader.pushGroup(scope);
+		_scopeLengths.push_back(_scopePath.size());
+		_scopePath += "/" + scope;
 	}
 
 	virtual void popScope()
 	{
 		LOG(Debug) << "SCOPE POP";
 		_reader.popGroup();
+		if (!_scopeLengths.empty())
+		{
+			_scopePath.resize(_scopeLengths.back());
+			_scopeLengths.pop_back();
+		}
 	}
 private:
 	Reader_t& _reader;
+	std::string _scopePath; //!< Path of the current scope used as prefix for cache keys
+	std::vector<std::size_t> _scopeLengths; //!< Lengths of _scopePath for the enclosing scopes
+	std::unordered_map<std::string, bool> _existsCache; //!< Caches exists() results by fully scoped path
+	std::unordered_map<std::string, bool> _isArrayCache; //!< Caches isArray() results by fully scoped path
 };
 
 } // namespace cadet
@@ -0,0 +1,360 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a driver that integrates long cyclic simulations parallel-in-time (Parareal)
+ */
+
+#ifndef CADET_PARAREALDRIVER_HPP_
+#define CADET_PARAREALDRIVER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "common/Driver.hpp"
+
+
+namespace cadet
+{
+
+/**
+ * @brief Driver that integrates a long time horizon parallel-in-time with the Parareal scheme
+ * @details The time horizon is split into slabs at user given boundaries (typically cycle
+ *          boundaries of a cyclic process, which have to coincide with section boundaries).
+ *          A cheap coarse propagator integrates the slabs sequentially to predict the state
+ *          at each slab boundary; an accurate fine propagator then integrates all slabs
+ *          concurrently from those predictions and the classic Parareal correction
+ *              @f[ U_{k+1}^{j+1} = G(U_k^{j+1}) + F(U_k^j) - G(U_k^j) @f]
+ *          is swept over the slab boundary states until they stop changing. The scheme
+ *          reproduces the sequential fine solution after at most as many iterations as
+ *          there are slabs and typically converges in far fewer for dissipative problems.
+ *
+ *          Each propagator is an independently configured Driver instance (own simulator,
+ *          model, and recorder), so the coarse propagator can be configured from a separate
+ *          parameter provider with a cheaper discretization (e.g., lower WENO order, fewer
+ *          cells) in addition to the loose error tolerance applied by this driver. The fine
+ *          trajectory recorders of the final sweep together cover the full output grid.
+ */
+class PararealDriver
+{
+public:
+	/**
+	 * @brief Creates a PararealDriver with the given number of time slabs
+	 * @param [in] numSlabs Number of time slabs (i.e., maximum number of concurrent fine integrations)
+	 */
+	PararealDriver(unsigned int numSlabs) : _coarse(new Driver()), _maxIterations(numSlabs), _tolerance(1e-8),
+		_coarseRelTol(1e-3), _lastIterations(0), _lastError(0.0)
+	{
+		_fine.reserve(numSlabs);
+		for (unsigned int i = 0; i < numSlabs; ++i)
+			_fine.emplace_back(new Driver());
+	}
+
+	~PararealDriver() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Builds and configures the fine and coarse propagators from separate parameter providers
+	 * @details Both providers have to describe the same process (same section times and unit
+	 *          operations); the coarse provider may use a cheaper spatial discretization.
+	 * @param [in] ppFine Parameter provider for the fine propagator instances
+	 * @param [in] ppCoarse Parameter provider for the coarse propagator
+	 * @tparam ParamProviderFine_t Type of the fine parameter provider
+	 * @tparam ParamProviderCoarse_t Type of the coarse parameter provider
+	 */
+	template <typename ParamProviderFine_t, typename ParamProviderCoarse_t>
+	void configure(ParamProviderFine_t& ppFine, ParamProviderCoarse_t& ppCoarse)
+	{
+		for (std::size_t i = 0; i < _fine.size(); ++i)
+			_fine[i]->configure(ppFine);
+
+		_coarse->configure(ppCoarse);
+		_coarse->simulator()->setRelativeErrorTolerance(_coarseRelTol);
+	}
+
+	/**
+	 * @brief Builds and configures both propagators from the same parameter provider
+	 * @details The coarse propagator uses the same discretization as the fine one and is
+	 *          only cheapened by the loose relative error tolerance (see coarseRelTol()).
+	 * @param [in] pp Implementation of cadet::IParameterProvider used as input
+	 * @tparam ParamProvider_t Type of the parameter provider
+	 */
+	template <typename ParamProvider_t>
+	void configure(ParamProvider_t& pp)
+	{
+		configure(pp, pp);
+	}
+
+	/**
+	 * @brief Performs the time-parallel integration
+	 * @details The slab boundaries have to be a subset of the section times (first and last
+	 *          slab boundary delimit the integrated horizon). Uses as many worker threads
+	 *          as there are slabs or the hardware supports, whichever is smaller.
+	 * @param [in] sectionTimes Section times of the full horizon as configured
+	 * @param [in] sectionContinuity Continuity of the section transitions (see ISimulator::setSectionTimes())
+	 * @param [in] slabTimes Slab boundaries, strictly increasing, numSlabs() + 1 entries
+	 */
+	void run(const std::vector<double>& sectionTimes, const std::vector<bool>& sectionContinuity, const std::vector<double>& slabTimes)
+	{
+		run(sectionTimes, sectionContinuity, slabTimes, std::thread::hardware_concurrency());
+	}
+
+	/**
+	 * @brief Performs the time-parallel integration
+	 * @param [in] sectionTimes Section times of the full horizon as configured
+	 * @param [in] sectionContinuity Continuity of the section transitions (see ISimulator::setSectionTimes())
+	 * @param [in] slabTimes Slab boundaries, strictly increasing, numSlabs() + 1 entries
+	 * @param [in] numThreads Number of worker threads for the fine sweeps
+	 */
+	void run(const std::vector<double>& sectionTimes, const std::vector<bool>& sectionContinuity, const std::vector<double>& slabTimes, unsigned int numThreads)
+	{
+		const std::size_t nSlabs = _fine.size();
+		if (slabTimes.size() != nSlabs + 1)
+			throw std::invalid_argument("Number of slab boundaries does not match number of slabs!");
+
+		// Restrict every fine simulator to a single thread; parallelism is provided by
+		// integrating the slabs concurrently
+		numThreads = std::max(1u, std::min(numThreads, static_cast<unsigned int>(nSlabs)));
+		for (std::size_t i = 0; i < nSlabs; ++i)
+			_fine[i]->simulator()->setNumThreads(1);
+
+		// Assign every propagator its slab of the horizon; each slab entry is a
+		// discontinuous section start, so consistent initialization is performed
+		// whenever a new boundary state is injected
+		const std::vector<double> solutionTimes = _fine[0]->simulator()->getSolutionTimes();
+		for (std::size_t k = 0; k < nSlabs; ++k)
+			applySlab(*_fine[k], sectionTimes, sectionContinuity, slabTimes, k, solutionTimes);
+
+		const unsigned int nDof = _fine[0]->simulator()->numDofs();
+
+		// Slab boundary states; U[0] is the initial condition applied at configuration
+		std::vector<std::vector<double>> bndState(nSlabs + 1, std::vector<double>(nDof, 0.0));
+		std::vector<std::vector<double>> coarseEnd(nSlabs, std::vector<double>(nDof, 0.0));
+		std::vector<std::vector<double>> fineEnd(nSlabs, std::vector<double>(nDof, 0.0));
+
+		unsigned int len = 0;
+		double const* const initY = _fine[0]->simulator()->getLastSolution(len);
+		std::copy(initY, initY + nDof, bndState[0].begin());
+
+		// Initial sequential coarse sweep predicts all slab boundary states
+		for (std::size_t k = 0; k < nSlabs; ++k)
+		{
+			propagateCoarse(sectionTimes, sectionContinuity, slabTimes, k, bndState[k].data(), coarseEnd[k]);
+			bndState[k + 1] = coarseEnd[k];
+		}
+
+		_lastIterations = 0;
+		_lastError = 0.0;
+		for (unsigned int iter = 0; iter < _maxIterations; ++iter)
+		{
+			// Parallel fine sweep from the current boundary states
+			fineSweep(bndState, fineEnd, numThreads);
+
+			// Sequential coarse correction sweep
+			double maxErr = 0.0;
+			std::vector<double> gNew(nDof, 0.0);
+			for (std::size_t k = 0; k < nSlabs; ++k)
+			{
+				propagateCoarse(sectionTimes, sectionContinuity, slabTimes, k, bndState[k].data(), gNew);
+
+				double err = 0.0;
+				std::vector<double>& u = bndState[k + 1];
+				for (unsigned int i = 0; i < nDof; ++i)
+				{
+					const double corrected = gNew[i] + fineEnd[k][i] - coarseEnd[k][i];
+					err = std::max(err, std::abs(corrected - u[i]) / (1.0 + std::abs(u[i])));
+					u[i] = corrected;
+				}
+				maxErr = std::max(maxErr, err);
+
+				coarseEnd[k] = gNew;
+			}
+
+			_lastIterations = iter + 1;
+			_lastError = maxErr;
+			if (maxErr <= _tolerance)
+				break;
+		}
+
+		// Final fine sweep from the converged boundary states such that the recorded
+		// trajectories of all slabs belong to one consistent solution
+		fineSweep(bndState, fineEnd, numThreads);
+	}
+
+	/**
+	 * @brief Removes all stored results of every fine propagator
+	 */
+	void clearResults()
+	{
+		for (std::size_t i = 0; i < _fine.size(); ++i)
+			_fine[i]->clearResults();
+	}
+
+	//! Convergence tolerance on the maximum relative change of the slab boundary states
+	inline void tolerance(double tol) CADET_NOEXCEPT { _tolerance = tol; }
+	inline double tolerance() const CADET_NOEXCEPT { return _tolerance; }
+
+	//! Maximum number of Parareal iterations (defaults to the number of slabs, which guarantees the fine solution)
+	inline void maxIterations(unsigned int maxIter) CADET_NOEXCEPT { _maxIterations = maxIter; }
+	inline unsigned int maxIterations() const CADET_NOEXCEPT { return _maxIterations; }
+
+	//! Relative error tolerance of the coarse propagator, applied at configuration
+	inline void coarseRelTol(double relTol) CADET_NOEXCEPT { _coarseRelTol = relTol; }
+	inline double coarseRelTol() const CADET_NOEXCEPT { return _coarseRelTol; }
+
+	//! Number of iterations and boundary state error of the last run
+	inline unsigned int lastIterations() const CADET_NOEXCEPT { return _lastIterations; }
+	inline double lastError() const CADET_NOEXCEPT { return _lastError; }
+
+	inline unsigned int numSlabs() const CADET_NOEXCEPT { return static_cast<unsigned int>(_fine.size()); }
+
+	inline Driver& fineInstance(unsigned int idx) { return *_fine[idx]; }
+	inline Driver& coarseInstance() { return *_coarse; }
+
+	inline cadet::InternalStorageSystemRecorder* solution(unsigned int idx) CADET_NOEXCEPT { return _fine[idx]->solution(); }
+	inline cadet::InternalStorageSystemRecorder const* solution(unsigned int idx) const CADET_NOEXCEPT { return _fine[idx]->solution(); }
+
+protected:
+
+	/**
+	 * @brief Restricts a driver to the given slab of the time horizon
+	 * @details Clips section times, continuity flags, and the output grid to the slab. The
+	 *          slab boundaries have to coincide with section times.
+	 */
+	void applySlab(Driver& drv, const std::vector<double>& sectionTimes, const std::vector<bool>& sectionContinuity,
+		const std::vector<double>& slabTimes, std::size_t slab, const std::vector<double>& solutionTimes)
+	{
+		const double tBegin = slabTimes[slab];
+		const double tEnd = slabTimes[slab + 1];
+
+		std::vector<double> secTimes;
+		std::vector<bool> secCont;
+		for (std::size_t i = 0; i < sectionTimes.size(); ++i)
+		{
+			if ((sectionTimes[i] < tBegin) || (sectionTimes[i] > tEnd))
+				continue;
+
+			secTimes.push_back(sectionTimes[i]);
+			if ((sectionTimes[i] > tBegin) && (sectionTimes[i] < tEnd) && (i < sectionContinuity.size() + 1) && (i >= 1))
+				secCont.push_back(sectionContinuity[i - 1]);
+		}
+
+		if ((secTimes.size() < 2) || (secTimes.front() != tBegin) || (secTimes.back() != tEnd))
+			throw std::invalid_argument("Slab boundaries have to coincide with section times!");
+
+		drv.simulator()->setSectionTimes(secTimes, secCont);
+
+		// Clip the output grid to the slab; the slab end is always included such that
+		// the integration runs to it exactly and getLastSolution() returns the state there
+		std::vector<double> solTimes;
+		for (std::size_t i = 0; i < solutionTimes.size(); ++i)
+		{
+			if ((solutionTimes[i] >= tBegin) && (solutionTimes[i] < tEnd))
+				solTimes.push_back(solutionTimes[i]);
+		}
+		solTimes.push_back(tEnd);
+		drv.simulator()->setSolutionTimes(solTimes);
+	}
+
+	/**
+	 * @brief Integrates one slab with the coarse propagator from the given state
+	 */
+	void propagateCoarse(const std::vector<double>& sectionTimes, const std::vector<bool>& sectionContinuity,
+		const std::vector<double>& slabTimes, std::size_t slab, double const* y0, std::vector<double>& yEnd)
+	{
+		// The coarse propagator only needs the state at the slab end
+		applySlab(*_coarse, sectionTimes, sectionContinuity, slabTimes, slab, std::vector<double>());
+
+		_coarse->simulator()->setInitialCondition(y0);
+		_coarse->run();
+
+		unsigned int len = 0;
+		double const* const y = _coarse->simulator()->getLastSolution(len);
+		std::copy(y, y + len, yEnd.begin());
+	}
+
+	/**
+	 * @brief Integrates all slabs with the fine propagators concurrently
+	 * @details Exceptions thrown by a slab are caught in the worker and the first one is
+	 *          rethrown after all threads have finished.
+	 */
+	void fineSweep(const std::vector<std::vector<double>>& bndState, std::vector<std::vector<double>>& fineEnd, unsigned int numThreads)
+	{
+		std::atomic<std::size_t> nextJob(0);
+		std::vector<std::exception_ptr> errors(_fine.size());
+
+		const auto worker = [&]()
+		{
+			while (true)
+			{
+				const std::size_t k = nextJob.fetch_add(1);
+				if (k >= _fine.size())
+					return;
+
+				try
+				{
+					_fine[k]->simulator()->setInitialCondition(bndState[k].data());
+					_fine[k]->run();
+
+					unsigned int len = 0;
+					double const* const y = _fine[k]->simulator()->getLastSolution(len);
+					std::copy(y, y + len, fineEnd[k].begin());
+				}
+				catch (...)
+				{
+					errors[k] = std::current_exception();
+				}
+			}
+		};
+
+		std::vector<std::thread> pool;
+		pool.reserve(numThreads - 1);
+		for (unsigned int i = 0; i < numThreads - 1; ++i)
+			pool.emplace_back(worker);
+
+		// The calling thread participates in the work
+		worker();
+
+		for (std::size_t i = 0; i < pool.size(); ++i)
+			pool[i].join();
+
+		// Rethrow the first error, if any occurred
+		for (std::size_t i = 0; i < errors.size(); ++i)
+		{
+			if (errors[i])
+				std::rethrow_exception(errors[i]);
+		}
+	}
+
+	std::vector<std::unique_ptr<Driver>> _fine; //!< Fine propagator instances, one per slab
+	std::unique_ptr<Driver> _coarse; //!< Coarse propagator instance
+
+	unsigned int _maxIterations; //!< Maximum number of Parareal iterations
+	double _tolerance; //!< Convergence tolerance on the slab boundary states
+	double _coarseRelTol; //!< Relative error tolerance of the coarse propagator
+
+	unsigned int _lastIterations; //!< Number of iterations of the last run
+	double _lastError; //!< Maximum relative boundary state change of the last iteration
+
+private:
+	PararealDriver(const PararealDriver&) = delete;
+};
+
+} // namespace cadet
+
+#endif  // CADET_PARAREALDRIVER_HPP_
@@ -20,16 +20,74 @@
 
 #include <vector>
 #include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "cadet/SolutionRecorder.hpp"
+#include "cadet/SolutionExporter.hpp"
+
+#include "common/SpillBuffer.hpp"
 
 namespace cadet
 {
 
+/**
+ * @brief Non-owning view on a contiguous array of doubles
+ * @details Carries the element count alongside the data pointer so that consumers
+ *          can map recorded solution buffers without copying them.
+ */
+struct ConstSolutionView
+{
+	double const* data; //!< Pointer to the first element
+	unsigned int size; //!< Number of elements
+
+	inline double const* begin() const CADET_NOEXCEPT { return data; }
+	inline double const* end() const CADET_NOEXCEPT { return data + size; }
+	inline double operator[](unsigned int idx) const { return data[idx]; }
+};
+
+/**
+ * @brief Layout of a recorded interior buffer negotiated with the model
+ * @details The recorder adopts the native state ordering the model's ISolutionExporter
+ *          advertises and records interior data (bulk, particle, flux) as raw block
+ *          copies of the exported pointers. This struct retains the adopted layout of
+ *          one time step so that any reordering can be deferred to the final write
+ *          stage or to read time: @c ordering lists the dimensions from outermost to
+ *          innermost (i.e., row-major with the last entry contiguous) and @c dims
+ *          holds the matching extents. Ordering entries without their own extent
+ *          (such as StateOrdering::Phase, whose states are folded into the component
+ *          dimension) are omitted from both vectors. Time is not included; recorded
+ *          time steps are simply concatenated.
+ */
+struct RecordedDataLayout
+{
+	std::vector<StateOrdering> ordering; //!< Dimensions of one time step, outermost first
+	std::vector<std::size_t> dims; //!< Extent of each dimension in @c ordering
+
+	/**
+	 * @brief Returns the number of elements of one recorded time step
+	 * @return Number of elements per time step
+	 */
+	inline std::size_t elementsPerTimestep() const CADET_NOEXCEPT
+	{
+		std::size_t n = 1;
+		for (std::size_t i = 0; i < dims.size(); ++i)
+			n *= dims[i];
+		return n;
+	}
+};
+
 /**
  * @brief Stores pieces of the solution of one single unit operation in internal buffers
- * @details The pieces of stored solutions are selectable at runtime.
- * @todo Use better storage than std::vector (control growth, maybe chunked storage -> needs chunked writes)
+ * @details The pieces of stored solutions are selectable at runtime. The large interior
+ *          buffers (bulk, particle, and flux, including time derivatives and sensitivities)
+ *          can spill to memory-mapped scratch files via spillToDisk(), which bounds the
+ *          resident memory of the recorder on long, finely resolved runs.
+ * @todo Use better storage than std::vector for inlet / outlet (control growth, maybe chunked storage -> needs chunked writes)
  */
 class InternalStorageUnitOpRecorder : public ISolutionRecorder
 {
@@ -49,7 +107,9 @@ public:
 	InternalStorageUnitOpRecorder(UnitOpIdx idx) : _cfgSolution({false, false, false, true, false}),
 		_cfgSolutionDot({false, false, false, false, false}), _cfgSensitivity({false, false, false, true, false}),
 		_cfgSensitivityDot({false, false, false, true, false}), _storeTime(false), _splitComponents(true), _curCfg(nullptr),
-		_nComp(0), _numTimesteps(0), _numSens(0), _unitOp(idx), _needsReAlloc(false)
+		_spillResidentBytes(0), _nComp(0), _numTimesteps(0), _numSens(0), _unitOp(idx), _needsReAlloc(false),
+		_decimStride(1), _stepIdx(0), _skipStep(false), _trackMax(false), _accumMoments(false), _curTime(0.0),
+		_redPrevTime(0.0), _redHavePrev(false)
 	{
 	}
 
@@ -126,15 +186,15 @@ public:
 		{
 			_sensOutlet[i] = new std::vector<double>();
 			_sensInlet[i] = new std::vector<double>();
-			_sensColumn[i] = new std::vector<double>();
-			_sensParticle[i] = new std::vector<double>();
-			_sensFlux[i] = new std::vector<double>();
+			_sensColumn[i] = createSensInteriorBuffer();
+			_sensParticle[i] = createSensInteriorBuffer();
+			_sensFlux[i] = createSensInteriorBuffer();
 
 			_sensOutletDot[i] = new std::vector<double>();
 			_sensInletDot[i] = new std::vector<double>();
-			_sensColumnDot[i] = new std::vector<double>();
-			_sensParticleDot[i] = new std::vector<double>();
-			_sensFluxDot[i] = new std::vector<double>();
+			_sensColumnDot[i] = createSensInteriorBuffer();
+			_sensParticleDot[i] = createSensInteriorBuffer();
+			_sensFluxDot[i] = createSensInteriorBuffer();
 		}
 
 		_needsReAlloc = false;
@@ -195,19 +255,30 @@ public:
 			{
 				_sensOutlet[i] = new std::vector<double>();
 				_sensInlet[i] = new std::vector<double>();
-				_sensColumn[i] = new std::vector<double>();
-				_sensParticle[i] = new std::vector<double>();
-				_sensFlux[i] = new std::vector<double>();
+				_sensColumn[i] = createSensInteriorBuffer();
+				_sensParticle[i] = createSensInteriorBuffer();
+				_sensFlux[i] = createSensInteriorBuffer();
 
 				_sensOutletDot[i] = new std::vector<double>();
 				_sensInletDot[i] = new std::vector<double>();
-				_sensColumnDot[i] = new std::vector<double>();
-				_sensParticleDot[i] = new std::vector<double>();
-				_sensFluxDot[i] = new std::vector<double>();
+				_sensColumnDot[i] = createSensInteriorBuffer();
+				_sensParticleDot[i] = createSensInteriorBuffer();
+				_sensFluxDot[i] = createSensInteriorBuffer();
 			}
 
 			_numSens = numSens;
 		}
+
+		if (_storeTime && (_numTimesteps > 0))
+			_time.reserve(expectedTimesteps());
+	}
+
+	virtual void notifyTimePoints(unsigned int numTimesteps)
+	{
+		// The updated count takes effect when the buffers are (re-)allocated in
+		// unitOperationStructure() at the start of the next time integration
+		_needsReAlloc = _needsReAlloc || (numTimesteps > _numTimesteps);
+		_numTimesteps = numTimesteps;
 	}
 
 	virtual void unitOperationStructure(UnitOpIdx idx, const IModel& model, const ISolutionExporter& exporter)
@@ -218,69 +289,90 @@ public:
 
 		_nComp = exporter.numComponents();
 
-		// Query structure
+		// Reset decimation and reduction state for the upcoming run
+		_stepIdx = 0;
+		_skipStep = false;
+		resetReductions();
+
+		// Query structure and adopt the native layout the exporter advertises; interior
+		// recording is a raw block copy of the exported pointers, so the retained layout
+		// metadata is what gives the recorded bytes their meaning (see dataLayout())
 		unsigned int len = 0;
 		StateOrdering const* order = exporter.concentrationOrdering(len);
 		_columnLayout.clear();
 		_columnLayout.reserve(len + 1); // First slot is time
 		_columnLayout.push_back(0);
+		_columnDataLayout.ordering.clear();
 		for (unsigned int i = 0; i < len; ++i)
 		{
 			switch (order[i])
 			{
 				case StateOrdering::Component:
 					_columnLayout.push_back(exporter.numComponents());
+					_columnDataLayout.ordering.push_back(order[i]);
 					break;
 				case StateOrdering::AxialCell:
 					_columnLayout.push_back(exporter.numAxialCells());
+					_columnDataLayout.ordering.push_back(order[i]);
 					break;
 				case StateOrdering::RadialCell:
 				case StateOrdering::Phase:
 					break;
 			}
 		}
+		_columnDataLayout.dims.assign(_columnLayout.begin() + 1, _columnLayout.end());
 
 		order = exporter.mobilePhaseOrdering(len);
 		_particleLayout.clear();
 		_particleLayout.reserve(len + 1); // First slot is time
 		_particleLayout.push_back(0);
+		_particleDataLayout.ordering.clear();
 		for (unsigned int i = 0; i < len; ++i)
 		{
 			switch (order[i])
 			{
 				case StateOrdering::Component:
 					_particleLayout.push_back(exporter.numComponents() + exporter.numBoundStates());
+					_particleDataLayout.ordering.push_back(order[i]);
 					break;
 				case StateOrdering::AxialCell:
 					_particleLayout.push_back(exporter.numAxialCells());
+					_particleDataLayout.ordering.push_back(order[i]);
 					break;
 				case StateOrdering::RadialCell:
 					_particleLayout.push_back(exporter.numRadialCells());
+					_particleDataLayout.ordering.push_back(order[i]);
 					 break;
 				case StateOrdering::Phase:
+					// The phases are folded into the component dimension
 					break;
 			}
 		}
+		_particleDataLayout.dims.assign(_particleLayout.begin() + 1, _particleLayout.end());
 
 		order = exporter.fluxOrdering(len);
 		_fluxLayout.clear();
 		_fluxLayout.reserve(len + 1); // First slot is time
 		_fluxLayout.push_back(0);
+		_fluxDataLayout.ordering.clear();
 		for (unsigned int i = 0; i < len; ++i)
 		{
 			switch (order[i])
 			{
 				case StateOrdering::Component:
 					_fluxLayout.push_back(exporter.numComponents());
+					_fluxDataLayout.ordering.push_back(order[i]);
 					break;
 				case StateOrdering::AxialCell:
 					_fluxLayout.push_back(exporter.numAxialCells());
+					_fluxDataLayout.ordering.push_back(order[i]);
 					break;
 				case StateOrdering::RadialCell:
 				case StateOrdering::Phase:
 					break;
 			}
 		}
+		_fluxDataLayout.dims.assign(_fluxLayout.begin() + 1, _fluxLayout.end());
 		
 		// Everything is ok, we have nothing to do
 		if (!_needsReAlloc)
@@ -317,6 +409,12 @@ public:
 
 	virtual void beginTimestep(double t)
 	{
+		_curTime = t;
+		_skipStep = (_decimStride > 1) && (_stepIdx % _decimStride != 0);
+		++_stepIdx;
+		if (_skipStep)
+			return;
+
 		++_numTimesteps;
 		if (_storeTime)
 			_time.push_back(t);
@@ -328,38 +426,76 @@ public:
 		if ((idx != _unitOp) || !_curCfg)
 			return;
 
-		unsigned int stride = 0;
+		// On-the-fly reductions consume the outlet of every time step of the main
+		// solution pass, even those the decimation drops from the trajectory buffers
+		if ((_trackMax || _accumMoments) && (_curCfg == &_cfgSolution))
+			updateReductions(exporter);
+
+		// Decimation drops this time step from all trajectory buffers
+		if (_skipStep)
+			return;
 
 		if (_curCfg->storeOutlet)
 		{
-			double const* outlet = exporter.outlet(stride);
-			for (unsigned int i = 0; i < _nComp; ++i)
-				_curOutlet->push_back(outlet[i * stride]);
+			const SolutionSpan outlet = exporter.outletSpan();
+			if (!_recComponents.empty())
+			{
+				// Reduced output, gather only the selected components
+				for (unsigned int i = 0; i < _recComponents.size(); ++i)
+					_curOutlet->push_back(outlet.data[_recComponents[i] * outlet.stride]);
+			}
+			else if (outlet.contiguous())
+			{
+				// Components are contiguous, no strided gather required
+				_curOutlet->insert(_curOutlet->end(), outlet.data, outlet.data + _nComp);
+			}
+			else
+			{
+				for (unsigned int i = 0; i < _nComp; ++i)
+					_curOutlet->push_back(outlet.data[i * outlet.stride]);
+			}
 		}
 
 		if (_curCfg->storeInlet)
 		{
-			double const* inlet = exporter.inlet(stride);
-			for (unsigned int i = 0; i < _nComp; ++i)
-				_curInlet->push_back(inlet[i * stride]);
+			const SolutionSpan inlet = exporter.inletSpan();
+			if (!_recComponents.empty())
+			{
+				// Reduced output, gather only the selected components
+				for (unsigned int i = 0; i < _recComponents.size(); ++i)
+					_curInlet->push_back(inlet.data[_recComponents[i] * inlet.stride]);
+			}
+			else if (inlet.contiguous())
+			{
+				// Components are contiguous, no strided gather required
+				_curInlet->insert(_curInlet->end(), inlet.data, inlet.data + _nComp);
+			}
+			else
+			{
+				for (unsigned int i = 0; i < _nComp; ++i)
+					_curInlet->push_back(inlet.data[i * inlet.stride]);
+			}
 		}
 
+		// The interior buffers are recorded as raw block copies in the layout negotiated
+		// in unitOperationStructure(); reordering is deferred to the write stage or to
+		// read time (see columnDataLayout() and friends)
 		if (_curCfg->storeColumn)
 		{
-			double const* const data = exporter.concentration();
-			_curBulk->insert(_curBulk->end(), data, data + exporter.numColumnDofs());
+			const SolutionSpan data = exporter.concentrationSpan();
+			_curBulk->append(data.data, data.data + data.numElements);
 		}
 
 		if (_curCfg->storeParticle)
 		{
-			double const* const data = exporter.mobilePhase();
-			_curParticle->insert(_curParticle->end(), data, data + exporter.numParticleDofs());
+			const SolutionSpan data = exporter.mobilePhaseSpan();
+			_curParticle->append(data.data, data.data + data.numElements);
 		}
 
 		if (_curCfg->storeFlux)
 		{
-			double const* const data = exporter.flux();
-			_curFlux->insert(_curFlux->end(), data, data + exporter.numFluxDofs());
+			const SolutionSpan data = exporter.fluxSpan();
+			_curFlux->append(data.data, data.data + data.numElements);
 		}
 	}
 
@@ -473,6 +609,49 @@ public:
 		endSolution();
 	}
 
+	/**
+	 * @brief Appends all buffered time steps of the solution to extendible datasets and clears the buffers
+	 * @details Used for streaming chunked writes during time integration. The writer has to
+	 *          support appending along the leading (time) dimension (see cadet::io::HDF5Writer::append()).
+	 * @param [in] writer Writer to append to
+	 * @param [in] numSteps Number of buffered time steps
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void flushSolution(Writer_t& writer, unsigned int numSteps)
+	{
+		std::ostringstream oss;
+
+		beginSolution();
+		appendData(writer, "SOLUTION", oss, numSteps);
+		endSolution();
+
+		beginSolutionDerivative();
+		appendData(writer, "SOLDOT", oss, numSteps);
+		endSolution();
+	}
+
+	/**
+	 * @brief Appends all buffered time steps of a sensitivity to extendible datasets and clears the buffers
+	 * @param [in] writer Writer to append to
+	 * @param [in] param Index of the sensitive parameter
+	 * @param [in] numSteps Number of buffered time steps
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void flushSensitivity(Writer_t& writer, unsigned int param, unsigned int numSteps)
+	{
+		std::ostringstream oss;
+
+		beginSensitivity(param);
+		appendData(writer, "SENS", oss, numSteps);
+		endSolution();
+
+		beginSensitivityDot(param);
+		appendData(writer, "SENSDOT", oss, numSteps);
+		endSolution();
+	}
+
 	inline StorageConfig& solutionConfig() CADET_NOEXCEPT { return _cfgSolution; }
 	inline const StorageConfig& solutionConfig() const CADET_NOEXCEPT { return _cfgSolution; }
 	inline void solutionConfig(const StorageConfig& cfg) CADET_NOEXCEPT { _cfgSolution = cfg; }
@@ -495,12 +674,131 @@ public:
 	inline bool splitComponents() const CADET_NOEXCEPT { return _splitComponents; }
 	inline void splitComponents(bool st) CADET_NOEXCEPT { _splitComponents = st; }
 
+	/**
+	 * @brief Spills the interior solution buffers to memory-mapped scratch files
+	 * @details Affects the bulk, particle, and flux buffers including time derivatives
+	 *          and sensitivities; the small inlet / outlet buffers stay on the heap.
+	 *          Completed time chunks are written back asynchronously by the operating
+	 *          system and dropped from the resident set, bounding the memory consumed
+	 *          by each buffer to roughly the given budget. The final output file is
+	 *          assembled from the scratch files at write time as usual. Does nothing
+	 *          on platforms without POSIX memory mapping.
+	 * @param [in] scratchDir Directory the scratch files are created in
+	 * @param [in] residentBytes Approximate resident set budget per buffer in bytes
+	 */
+	inline void spillToDisk(const std::string& scratchDir, std::size_t residentBytes)
+	{
+		_spillDir = scratchDir;
+		_spillResidentBytes = residentBytes;
+
+		_column.spillToFile(scratchDir, residentBytes);
+		_particle.spillToFile(scratchDir, residentBytes);
+		_flux.spillToFile(scratchDir, residentBytes);
+		_columnDot.spillToFile(scratchDir, residentBytes);
+		_particleDot.spillToFile(scratchDir, residentBytes);
+		_fluxDot.spillToFile(scratchDir, residentBytes);
+
+		for (unsigned int i = 0; i < _sensColumn.size(); ++i)
+		{
+			_sensColumn[i]->spillToFile(scratchDir, residentBytes);
+			_sensParticle[i]->spillToFile(scratchDir, residentBytes);
+			_sensFlux[i]->spillToFile(scratchDir, residentBytes);
+			_sensColumnDot[i]->spillToFile(scratchDir, residentBytes);
+			_sensParticleDot[i]->spillToFile(scratchDir, residentBytes);
+			_sensFluxDot[i]->spillToFile(scratchDir, residentBytes);
+		}
+	}
+
+	/**
+	 * @brief Restricts inlet and outlet recording to the given components
+	 * @details An empty selection (the default) records all components. Bulk, particle,
+	 *          and flux data always comprise all components regardless of the selection.
+	 * @param [in] comps Indices of the recorded components in ascending order
+	 */
+	inline void recordedComponents(const std::vector<unsigned int>& comps) { _recComponents = comps; }
+	inline const std::vector<unsigned int>& recordedComponents() const CADET_NOEXCEPT { return _recComponents; }
+	inline unsigned int numRecordedComponents() const CADET_NOEXCEPT { return _recComponents.empty() ? _nComp : static_cast<unsigned int>(_recComponents.size()); }
+
+	/**
+	 * @brief Sets the stride of the time step decimation
+	 * @details Only every @p stride-th received time step is stored in the trajectory
+	 *          buffers (and later written to file); the reductions below still consume
+	 *          every time step. The default stride @c 1 stores everything.
+	 * @param [in] stride Number of received time steps per stored time step
+	 */
+	inline void decimationStride(unsigned int stride) CADET_NOEXCEPT { _decimStride = std::max(1u, stride); }
+	inline unsigned int decimationStride() const CADET_NOEXCEPT { return _decimStride; }
+
+	/**
+	 * @name On-the-fly outlet reductions
+	 * @details When enabled, the running maximum of each outlet component (peak height
+	 *          and retention time) and the first three temporal moments
+	 *          @f$ \int t^k c(t) \,\mathrm{d}t @f$, @f$ k = 0, 1, 2 @f$, (trapezoidal rule
+	 *          over the received time steps) are accumulated during recording. Runs that
+	 *          only feed objective functions can thus disable all trajectory storage
+	 *          (including the outlet) and read the metrics directly from the recorder.
+	 *          The reductions always cover all components regardless of the restriction
+	 *          set via recordedComponents().
+	 */
+	//@{
+	inline void trackMaximum(bool tm) CADET_NOEXCEPT { _trackMax = tm; }
+	inline bool trackMaximum() const CADET_NOEXCEPT { return _trackMax; }
+
+	inline void accumulateMoments(bool am) CADET_NOEXCEPT { _accumMoments = am; }
+	inline bool accumulateMoments() const CADET_NOEXCEPT { return _accumMoments; }
+
+	//! \brief Returns the maximum outlet concentration of the given component
+	inline double maxOutlet(unsigned int comp) const { return _redMaxValue[comp]; }
+	//! \brief Returns the time at which the outlet concentration of the given component attains its maximum
+	inline double timeOfMaxOutlet(unsigned int comp) const { return _redMaxTime[comp]; }
+	//! \brief Returns the accumulated outlet moment @f$ \int t^k c(t) \,\mathrm{d}t @f$ of the given order @f$ k \leq 2 @f$ and component
+	inline double outletMoment(unsigned int order, unsigned int comp) const { return _redMoments[order * _nComp + comp]; }
+	//@}
+
 	inline UnitOpIdx unitOperation() const CADET_NOEXCEPT { return _unitOp; }
 	inline void unitOperation(UnitOpIdx idx) CADET_NOEXCEPT { _unitOp = idx; }
 
 	inline unsigned int numDataPoints() const CADET_NOEXCEPT { return _numTimesteps; }
 	inline unsigned int numComponents() const CADET_NOEXCEPT { return _nComp; }
 
+	/**
+	 * @name Layouts of the recorded interior buffers
+	 * @details The layouts are negotiated with the model in unitOperationStructure():
+	 *          the recorder adopts the native ordering the exporter advertises and
+	 *          records the interior buffers as raw block copies, so consumers of the
+	 *          views above interpret (or reorder) the data using this metadata at
+	 *          read time. The same metadata drives the tensor dimensions of the
+	 *          final file output. Valid after unitOperationStructure() has been called.
+	 */
+	//@{
+	inline const RecordedDataLayout& columnDataLayout() const CADET_NOEXCEPT { return _columnDataLayout; }
+	inline const RecordedDataLayout& particleDataLayout() const CADET_NOEXCEPT { return _particleDataLayout; }
+	inline const RecordedDataLayout& fluxDataLayout() const CADET_NOEXCEPT { return _fluxDataLayout; }
+	//@}
+
+	/**
+	 * @brief Returns the amount of heap memory held by the recording buffers in bytes
+	 * @details The capacities of all solution and sensitivity buffers are counted, that is,
+	 *          the value reflects the allocated memory rather than the used memory.
+	 * @return Memory footprint in bytes
+	 */
+	inline std::size_t memoryFootprint() const CADET_NOEXCEPT
+	{
+		std::size_t mem = (_time.capacity() + _outlet.capacity() + _inlet.capacity() + _outletDot.capacity() + _inletDot.capacity()) * sizeof(double);
+		mem += _column.memoryFootprint() + _particle.memoryFootprint() + _flux.memoryFootprint()
+			+ _columnDot.memoryFootprint() + _particleDot.memoryFootprint() + _fluxDot.memoryFootprint();
+
+		for (std::size_t i = 0; i < _sensOutlet.size(); ++i)
+		{
+			mem += (_sensOutlet[i]->capacity() + _sensInlet[i]->capacity()) * sizeof(double);
+			mem += _sensColumn[i]->memoryFootprint() + _sensParticle[i]->memoryFootprint() + _sensFlux[i]->memoryFootprint();
+			mem += (_sensOutletDot[i]->capacity() + _sensInletDot[i]->capacity()) * sizeof(double);
+			mem += _sensColumnDot[i]->memoryFootprint() + _sensParticleDot[i]->memoryFootprint() + _sensFluxDot[i]->memoryFootprint();
+		}
+
+		return mem;
+	}
+
 	inline double const* time() const CADET_NOEXCEPT { return _time.data(); }
 	inline double const* inlet() const CADET_NOEXCEPT { return _inlet.data(); }
 	inline double const* outlet() const CADET_NOEXCEPT { return _outlet.data(); }
@@ -522,6 +820,72 @@ public:
 	inline double const* sensColumnDot(unsigned int idx) const CADET_NOEXCEPT { return _sensColumnDot[idx]->data(); }
 	inline double const* sensParticleDot(unsigned int idx) const CADET_NOEXCEPT { return _sensParticleDot[idx]->data(); }
 	inline double const* sensFluxDot(unsigned int idx) const CADET_NOEXCEPT { return _sensFluxDot[idx]->data(); }
+
+	/**
+	 * @name Sized views on the recorded time-major buffers
+	 * @details The views point directly into the internal storage, no data is copied.
+	 *          A view stays valid until the storage is reallocated, which only happens
+	 *          in notifyIntegrationStart() or unitOperationStructure() when the number
+	 *          of time steps or sensitivities grows, or on destruction. clear() resets
+	 *          the contents but does not release the memory, so pointers obtained
+	 *          before clear() keep pointing at the same (now overwritten) storage.
+	 *          Use the extract functions below to take ownership of a buffer that has
+	 *          to outlive the next run.
+	 */
+	//@{
+	inline ConstSolutionView timeView() const CADET_NOEXCEPT { return ConstSolutionView{_time.data(), static_cast<unsigned int>(_time.size())}; }
+	inline ConstSolutionView inletView() const CADET_NOEXCEPT { return ConstSolutionView{_inlet.data(), static_cast<unsigned int>(_inlet.size())}; }
+	inline ConstSolutionView outletView() const CADET_NOEXCEPT { return ConstSolutionView{_outlet.data(), static_cast<unsigned int>(_outlet.size())}; }
+	inline ConstSolutionView columnView() const CADET_NOEXCEPT { return ConstSolutionView{_column.data(), static_cast<unsigned int>(_column.size())}; }
+	inline ConstSolutionView particleView() const CADET_NOEXCEPT { return ConstSolutionView{_particle.data(), static_cast<unsigned int>(_particle.size())}; }
+	inline ConstSolutionView fluxView() const CADET_NOEXCEPT { return ConstSolutionView{_flux.data(), static_cast<unsigned int>(_flux.size())}; }
+	inline ConstSolutionView inletDotView() const CADET_NOEXCEPT { return ConstSolutionView{_inletDot.data(), static_cast<unsigned int>(_inletDot.size())}; }
+	inline ConstSolutionView outletDotView() const CADET_NOEXCEPT { return ConstSolutionView{_outletDot.data(), static_cast<unsigned int>(_outletDot.size())}; }
+	inline ConstSolutionView columnDotView() const CADET_NOEXCEPT { return ConstSolutionView{_columnDot.data(), static_cast<unsigned int>(_columnDot.size())}; }
+	inline ConstSolutionView particleDotView() const CADET_NOEXCEPT { return ConstSolutionView{_particleDot.data(), static_cast<unsigned int>(_particleDot.size())}; }
+	inline ConstSolutionView fluxDotView() const CADET_NOEXCEPT { return ConstSolutionView{_fluxDot.data(), static_cast<unsigned int>(_fluxDot.size())}; }
+	inline ConstSolutionView sensInletView(unsigned int idx) const CADET_NOEXCEPT { return ConstSolutionView{_sensInlet[idx]->data(), static_cast<unsigned int>(_sensInlet[idx]->size())}; }
+	inline ConstSolutionView sensOutletView(unsigned int idx) const CADET_NOEXCEPT { return ConstSolutionView{_sensOutlet[idx]->data(), static_cast<unsigned int>(_sensOutlet[idx]->size())}; }
+	inline ConstSolutionView sensColumnView(unsigned int idx) const CADET_NOEXCEPT { return ConstSolutionView{_sensColumn[idx]->data(), static_cast<unsigned int>(_sensColumn[idx]->size())}; }
+	inline ConstSolutionView sensParticleView(unsigned int idx) const CADET_NOEXCEPT { return ConstSolutionView{_sensParticle[idx]->data(), static_cast<unsigned int>(_sensParticle[idx]->size())}; }
+	inline ConstSolutionView sensFluxView(unsigned int idx) const CADET_NOEXCEPT { return ConstSolutionView{_sensFlux[idx]->data(), static_cast<unsigned int>(_sensFlux[idx]->size())}; }
+	inline ConstSolutionView sensInletDotView(unsigned int idx) const CADET_NOEXCEPT { return ConstSolutionView{_sensInletDot[idx]->data(), static_cast<unsigned int>(_sensInletDot[idx]->size())}; }
+	inline ConstSolutionView sensOutletDotView(unsigned int idx) const CADET_NOEXCEPT { return ConstSolutionView{_sensOutletDot[idx]->data(), static_cast<unsigned int>(_sensOutletDot[idx]->size())}; }
+	inline ConstSolutionView sensColumnDotView(unsigned int idx) const CADET_NOEXCEPT { return ConstSolutionView{_sensColumnDot[idx]->data(), static_cast<unsigned int>(_sensColumnDot[idx]->size())}; }
+	inline ConstSolutionView sensParticleDotView(unsigned int idx) const CADET_NOEXCEPT { return ConstSolutionView{_sensParticleDot[idx]->data(), static_cast<unsigned int>(_sensParticleDot[idx]->size())}; }
+	inline ConstSolutionView sensFluxDotView(unsigned int idx) const CADET_NOEXCEPT { return ConstSolutionView{_sensFluxDot[idx]->data(), static_cast<unsigned int>(_sensFluxDot[idx]->size())}; }
+	//@}
+
+	/**
+	 * @name Ownership transfer of recorded buffers
+	 * @details Moves a recorded buffer out of the recorder without copying the data
+	 *          (interior buffers spilled to disk are copied back from the scratch file).
+	 *          The returned vector is unaffected by subsequent clear() or new runs,
+	 *          the recorder continues with an empty buffer that grows on demand.
+	 */
+	//@{
+	inline std::vector<double> extractTime() { std::vector<double> v; v.swap(_time); return v; }
+	inline std::vector<double> extractInlet() { std::vector<double> v; v.swap(_inlet); return v; }
+	inline std::vector<double> extractOutlet() { std::vector<double> v; v.swap(_outlet); return v; }
+	inline std::vector<double> extractColumn() { return _column.extract(); }
+	inline std::vector<double> extractParticle() { return _particle.extract(); }
+	inline std::vector<double> extractFlux() { return _flux.extract(); }
+	inline std::vector<double> extractInletDot() { std::vector<double> v; v.swap(_inletDot); return v; }
+	inline std::vector<double> extractOutletDot() { std::vector<double> v; v.swap(_outletDot); return v; }
+	inline std::vector<double> extractColumnDot() { return _columnDot.extract(); }
+	inline std::vector<double> extractParticleDot() { return _particleDot.extract(); }
+	inline std::vector<double> extractFluxDot() { return _fluxDot.extract(); }
+	inline std::vector<double> extractSensInlet(unsigned int idx) { std::vector<double> v; v.swap(*_sensInlet[idx]); return v; }
+	inline std::vector<double> extractSensOutlet(unsigned int idx) { std::vector<double> v; v.swap(*_sensOutlet[idx]); return v; }
+	inline std::vector<double> extractSensColumn(unsigned int idx) { return _sensColumn[idx]->extract(); }
+	inline std::vector<double> extractSensParticle(unsigned int idx) { return _sensParticle[idx]->extract(); }
+	inline std::vector<double> extractSensFlux(unsigned int idx) { return _sensFlux[idx]->extract(); }
+	inline std::vector<double> extractSensInletDot(unsigned int idx) { std::vector<double> v; v.swap(*_sensInletDot[idx]); return v; }
+	inline std::vector<double> extractSensOutletDot(unsigned int idx) { std::vector<double> v; v.swap(*_sensOutletDot[idx]); return v; }
+	inline std::vector<double> extractSensColumnDot(unsigned int idx) { return _sensColumnDot[idx]->extract(); }
+	inline std::vector<double> extractSensParticleDot(unsigned int idx) { return _sensParticleDot[idx]->extract(); }
+	inline std::vector<double> extractSensFluxDot(unsigned int idx) { return _sensFluxDot[idx]->extract(); }
+	//@}
 protected:
 
 	inline void beginSensitivity(unsigned int sensIdx)
@@ -534,6 +898,75 @@ protected:
 		_curFlux = _sensFlux[sensIdx];
 	}
 
+	/**
+	 * @brief Maps a position in the recorded inlet / outlet data to the component it belongs to
+	 */
+	inline unsigned int componentIndex(unsigned int item) const CADET_NOEXCEPT { return _recComponents.empty() ? item : _recComponents[item]; }
+
+	/**
+	 * @brief Resets the maximum tracking and moment accumulation for a new run
+	 */
+	inline void resetReductions()
+	{
+		_redMaxValue.assign(_nComp, -std::numeric_limits<double>::infinity());
+		_redMaxTime.assign(_nComp, 0.0);
+		_redMoments.assign(3 * _nComp, 0.0);
+		_redPrevOutlet.assign(_nComp, 0.0);
+		_redPrevTime = 0.0;
+		_redHavePrev = false;
+	}
+
+	/**
+	 * @brief Folds the outlet of the current time step into the enabled reductions
+	 * @param [in] exporter Exporter of the unit operation
+	 */
+	inline void updateReductions(const ISolutionExporter& exporter)
+	{
+		const SolutionSpan outlet = exporter.outletSpan();
+
+		for (unsigned int comp = 0; comp < _nComp; ++comp)
+		{
+			const double c = outlet.data[comp * outlet.stride];
+
+			if (_trackMax && (c > _redMaxValue[comp]))
+			{
+				_redMaxValue[comp] = c;
+				_redMaxTime[comp] = _curTime;
+			}
+
+			if (_accumMoments && _redHavePrev)
+			{
+				// Trapezoidal rule for \int t^k c(t) dt on the current step
+				const double dt = _curTime - _redPrevTime;
+				const double cPrev = _redPrevOutlet[comp];
+				_redMoments[comp] += 0.5 * dt * (c + cPrev);
+				_redMoments[_nComp + comp] += 0.5 * dt * (_curTime * c + _redPrevTime * cPrev);
+				_redMoments[2 * _nComp + comp] += 0.5 * dt * (_curTime * _curTime * c + _redPrevTime * _redPrevTime * cPrev);
+			}
+
+			if (_accumMoments)
+				_redPrevOutlet[comp] = c;
+		}
+
+		if (_accumMoments)
+		{
+			_redPrevTime = _curTime;
+			_redHavePrev = true;
+		}
+	}
+
+	/**
+	 * @brief Allocates an interior sensitivity buffer honoring the spill settings
+	 * @return Newly allocated buffer
+	 */
+	inline SpillBuffer* createSensInteriorBuffer()
+	{
+		SpillBuffer* const buf = new SpillBuffer();
+		if (!_spillDir.empty())
+			buf->spillToFile(_spillDir, _spillResidentBytes);
+		return buf;
+	}
+
 	inline void beginSensitivityDot(unsigned int sensIdx)
 	{
 		_curCfg = &_cfgSensitivityDot;
@@ -544,43 +977,60 @@ protected:
 		_curFlux = _sensFluxDot[sensIdx];
 	}
 
+	/**
+	 * @brief Returns the number of time steps that will actually be stored
+	 * @details Takes the decimation stride into account such that the buffers are
+	 *          sized exactly. Without a time step hint from the simulator a default
+	 *          capacity is returned and the vectors grow on demand.
+	 */
+	inline unsigned int expectedTimesteps() const CADET_NOEXCEPT
+	{
+		if (_numTimesteps == 0)
+			return 100u;
+		return (_numTimesteps + _decimStride - 1) / _decimStride;
+	}
+
 	inline void allocateMemory(const ISolutionExporter& exporter)
 	{
+		const unsigned int expectedSteps = expectedTimesteps();
+
 		if (_curCfg->storeOutlet)
-			_curOutlet->reserve(std::max(_numTimesteps, 100u) * _nComp);
+			_curOutlet->reserve(expectedSteps * numRecordedComponents());
 
 		if (_curCfg->storeInlet)
-			_curInlet->reserve(std::max(_numTimesteps, 100u) * _nComp);
-		
+			_curInlet->reserve(expectedSteps * numRecordedComponents());
+
 		if (_curCfg->storeColumn)
-			_curBulk->reserve(std::max(_numTimesteps, 100u) * exporter.numColumnDofs());
-		
+			_curBulk->reserve(expectedSteps * exporter.numColumnDofs());
+
 		if (exporter.hasParticleMobilePhase() && _curCfg->storeParticle)
-			_curParticle->reserve(std::max(_numTimesteps, 100u) * exporter.numParticleDofs());
-		
+			_curParticle->reserve(expectedSteps * exporter.numParticleDofs());
+
 		if (exporter.hasParticleFlux() && _curCfg->storeFlux)
-			_curFlux->reserve(std::max(_numTimesteps, 100u) * exporter.numFluxDofs());
+			_curFlux->reserve(expectedSteps * exporter.numFluxDofs());
 	}
 
 	template <typename Writer_t>
 	void writeData(Writer_t& writer, const char* prefix, std::ostringstream& oss)
 	{
+		const unsigned int nRec = numRecordedComponents();
+
 		if (_curCfg->storeOutlet)
 		{
 			if (_splitComponents)
 			{
-				for (unsigned int comp = 0; comp < _nComp; ++comp)
+				for (unsigned int comp = 0; comp < nRec; ++comp)
 				{
 					oss.str("");
-					oss << prefix << "_COLUMN_OUTLET_COMP_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << comp;
-					writer.template vector<double>(oss.str(), _numTimesteps, _curOutlet->data() + comp, _nComp);
+					oss << prefix << "_COLUMN_OUTLET_COMP_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << componentIndex(comp);
+					writer.template vector<double>(oss.str(), _numTimesteps, _curOutlet->data() + comp, nRec);
 				}
 			}
 			else
 			{
 				oss.str("");
 				oss << prefix << "_COLUMN_OUTLET";
-				writer.template matrix<double>(oss.str(), _numTimesteps, _nComp, _curOutlet->data(), 1);
+				writer.template matrix<double>(oss.str(), _numTimesteps, nRec, _curOutlet->data(), 1);
 			}
 		}
 
@@ -588,18 +1038,18 @@ protected:
 		{
 			if (_splitComponents)
 			{
-				for (unsigned int comp = 0; comp < _nComp; ++comp)
+				for (unsigned int comp = 0; comp < nRec; ++comp)
 				{
 					oss.str("");
-					oss << prefix << "_COLUMN_INLET_COMP_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << comp;
-					writer.template vector<double>(oss.str(), _numTimesteps, _curInlet->data() + comp, _nComp);
+					oss << prefix << "_COLUMN_INLET_COMP_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << componentIndex(comp);
+					writer.template vector<double>(oss.str(), _numTimesteps, _curInlet->data() + comp, nRec);
 				}
 			}
 			else
 			{
 				oss.str("");
 				oss << prefix << "_COLUMN_INLET";
-				writer.template matrix<double>(oss.str(), _numTimesteps, _nComp, _curInlet->data(), 1);
+				writer.template matrix<double>(oss.str(), _numTimesteps, nRec, _curInlet->data(), 1);
 			}
 		}
 
@@ -628,55 +1078,149 @@ protected:
 		}
 	}
 
+	template <typename Writer_t>
+	void appendData(Writer_t& writer, const char* prefix, std::ostringstream& oss, unsigned int numSteps)
+	{
+		const unsigned int nRec = numRecordedComponents();
+
+		if (_curCfg->storeOutlet)
+		{
+			if (_splitComponents)
+			{
+				for (unsigned int comp = 0; comp < nRec; ++comp)
+				{
+					oss.str("");
+					oss << prefix << "_COLUMN_OUTLET_COMP_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << componentIndex(comp);
+					writer.template appendVector<double>(oss.str(), numSteps, _curOutlet->data() + comp, nRec);
+				}
+			}
+			else
+			{
+				oss.str("");
+				oss << prefix << "_COLUMN_OUTLET";
+				writer.template appendMatrix<double>(oss.str(), numSteps, nRec, _curOutlet->data(), 1);
+			}
+			_curOutlet->clear();
+		}
+
+		if (_curCfg->storeInlet)
+		{
+			if (_splitComponents)
+			{
+				for (unsigned int comp = 0; comp < nRec; ++comp)
+				{
+					oss.str("");
+					oss << prefix << "_COLUMN_INLET_COMP_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << componentIndex(comp);
+					writer.template appendVector<double>(oss.str(), numSteps, _curInlet->data() + comp, nRec);
+				}
+			}
+			else
+			{
+				oss.str("");
+				oss << prefix << "_COLUMN_INLET";
+				writer.template appendMatrix<double>(oss.str(), numSteps, nRec, _curInlet->data(), 1);
+			}
+			_curInlet->clear();
+		}
+
+		if (_curCfg->storeColumn)
+		{
+			oss.str("");
+			oss << prefix << "_COLUMN";
+			_columnLayout[0] = numSteps;
+			writer.template appendTensor<double>(oss.str(), _columnLayout.size(), _columnLayout.data(), _curBulk->data());
+			_curBulk->clear();
+		}
+
+		if (_curCfg->storeParticle)
+		{
+			oss.str("");
+			oss << prefix << "_PARTICLE";
+			_particleLayout[0] = numSteps;
+			writer.template appendTensor<double>(oss.str(), _particleLayout.size(), _particleLayout.data(), _curParticle->data());
+			_curParticle->clear();
+		}
+
+		if (_curCfg->storeFlux)
+		{
+			oss.str("");
+			oss << prefix << "_FLUX";
+			_fluxLayout[0] = numSteps;
+			writer.template appendTensor<double>(oss.str(), _fluxLayout.size(), _fluxLayout.data(), _curFlux->data());
+			_curFlux->clear();
+		}
+	}
+
 	StorageConfig _cfgSolution;
 	StorageConfig _cfgSolutionDot;
 	StorageConfig _cfgSensitivity;
 	StorageConfig _cfgSensitivityDot;
 	bool _storeTime;
 	bool _splitComponents;
+	std::vector<unsigned int> _recComponents;
 
 	StorageConfig const* _curCfg;
 	std::vector<double>* _curOutlet;
 	std::vector<double>* _curInlet;
-	std::vector<double>* _curBulk;
-	std::vector<double>* _curParticle;
-	std::vector<double>* _curFlux;
+	SpillBuffer* _curBulk;
+	SpillBuffer* _curParticle;
+	SpillBuffer* _curFlux;
 
 	std::vector<double> _time;
 	std::vector<double> _outlet;
 	std::vector<double> _inlet;
-	std::vector<double> _column;
-	std::vector<double> _particle;
-	std::vector<double> _flux;
+	SpillBuffer _column;
+	SpillBuffer _particle;
+	SpillBuffer _flux;
 
 	std::vector<double> _outletDot;
 	std::vector<double> _inletDot;
-	std::vector<double> _columnDot;
-	std::vector<double> _particleDot;
-	std::vector<double> _fluxDot;
+	SpillBuffer _columnDot;
+	SpillBuffer _particleDot;
+	SpillBuffer _fluxDot;
 
 	std::vector<std::vector<double>*> _sensOutlet;
 	std::vector<std::vector<double>*> _sensInlet;
-	std::vector<std::vector<double>*> _sensColumn;
-	std::vector<std::vector<double>*> _sensParticle;
-	std::vector<std::vector<double>*> _sensFlux;
+	std::vector<SpillBuffer*> _sensColumn;
+	std::vector<SpillBuffer*> _sensParticle;
+	std::vector<SpillBuffer*> _sensFlux;
 
 	std::vector<std::vector<double>*> _sensOutletDot;
 	std::vector<std::vector<double>*> _sensInletDot;
-	std::vector<std::vector<double>*> _sensColumnDot;
-	std::vector<std::vector<double>*> _sensParticleDot;
-	std::vector<std::vector<double>*> _sensFluxDot;
+	std::vector<SpillBuffer*> _sensColumnDot;
+	std::vector<SpillBuffer*> _sensParticleDot;
+	std::vector<SpillBuffer*> _sensFluxDot;
+
+	std::string _spillDir; //!< Scratch directory for spilled interior buffers, empty if spilling is disabled
+	std::size_t _spillResidentBytes; //!< Resident set budget per spilled buffer in bytes
 	
 	std::vector<std::size_t> _columnLayout;
 	std::vector<std::size_t> _particleLayout;
 	std::vector<std::size_t> _fluxLayout;
 
+	RecordedDataLayout _columnDataLayout; //!< Layout of one recorded bulk time step
+	RecordedDataLayout _particleDataLayout; //!< Layout of one recorded particle time step
+	RecordedDataLayout _fluxDataLayout; //!< Layout of one recorded flux time step
+
 	unsigned int _nComp;
 	unsigned int _numTimesteps;
 	unsigned int _numSens;
 	UnitOpIdx _unitOp;
 
 	bool _needsReAlloc;
+
+	unsigned int _decimStride; //!< Number of received time steps per stored time step (@c 1 stores everything)
+	unsigned int _stepIdx; //!< Number of time steps received since the last call to unitOperationStructure()
+	bool _skipStep; //!< Determines whether the current time step is dropped by the decimation
+	bool _trackMax; //!< Determines whether outlet maxima are tracked
+	bool _accumMoments; //!< Determines whether outlet moments are accumulated
+	double _curTime; //!< Time of the current time step
+	double _redPrevTime; //!< Time of the previous step in the moment accumulation
+	bool _redHavePrev; //!< Determines whether the moment accumulation has seen a previous step
+	std::vector<double> _redMaxValue; //!< Running maximum of the outlet per component
+	std::vector<double> _redMaxTime; //!< Time of the running maximum of the outlet per component
+	std::vector<double> _redMoments; //!< Accumulated outlet moments, order-major with _nComp entries per order
+	std::vector<double> _redPrevOutlet; //!< Outlet of the previous step for the trapezoidal rule
 };
 
 
@@ -726,6 +1270,14 @@ public:
 			rec->notifyIntegrationStart(numDofs, numSens, numTimesteps);
 	}
 
+	virtual void notifyTimePoints(unsigned int numTimesteps)
+	{
+		_time.reserve(numTimesteps);
+
+		for (InternalStorageUnitOpRecorder* rec : _recorders)
+			rec->notifyTimePoints(numTimesteps);
+	}
+
 	virtual void unitOperationStructure(UnitOpIdx idx, const IModel& model, const ISolutionExporter& exporter)
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
@@ -860,12 +1412,28 @@ public:
 
 	inline unsigned int numDataPoints() const CADET_NOEXCEPT { return _numTimesteps; }
 
+	inline double const* time() const CADET_NOEXCEPT { return _time.data(); }
+	inline ConstSolutionView timeView() const CADET_NOEXCEPT { return ConstSolutionView{_time.data(), static_cast<unsigned int>(_time.size())}; }
+
 	inline void addRecorder(InternalStorageUnitOpRecorder* rec)
 	{
 		_recorders.push_back(rec);
 	}
 
 	inline unsigned int numRecorders() const CADET_NOEXCEPT { return _recorders.size(); }
+
+	/**
+	 * @brief Returns the amount of heap memory held by all recording buffers in bytes
+	 * @return Memory footprint in bytes
+	 */
+	inline std::size_t memoryFootprint() const CADET_NOEXCEPT
+	{
+		std::size_t mem = _time.capacity() * sizeof(double);
+		for (InternalStorageUnitOpRecorder const* rec : _recorders)
+			mem += rec->memoryFootprint();
+		return mem;
+	}
+
 	inline InternalStorageUnitOpRecorder* recorder(unsigned int idx) CADET_NOEXCEPT { return _recorders[idx]; }
 	inline InternalStorageUnitOpRecorder* const recorder(unsigned int idx) const CADET_NOEXCEPT { return _recorders[idx]; }
 
@@ -905,6 +1473,687 @@ protected:
 };
 
 
+/**
+ * @brief Streams the solution to a writer in fixed-size time chunks during time integration
+ * @details Extends InternalStorageSystemRecorder by flushing all buffered time steps to
+ *          extendible datasets whenever a given number of time steps has accumulated.
+ *          This bounds the memory consumption of long simulations with fine time
+ *          resolution and avoids the bulk write at the end of the run. The last
+ *          (partial) chunk has to be flushed by calling flush() after time integration.
+ *          The file layout matches the one produced by cadet::Driver::write().
+ * @tparam Writer_t Type of the writer (e.g., cadet::io::HDF5Writer), which has to support
+ *         appending along the leading (time) dimension
+ */
+template <typename Writer_t>
+class StreamingStorageSystemRecorder : public InternalStorageSystemRecorder
+{
+public:
+
+	/**
+	 * @brief Creates a StreamingStorageSystemRecorder
+	 * @param [in] writer Writer the time chunks are flushed to (file or group has to stay open during integration)
+	 * @param [in] chunkSize Number of time steps that are buffered before a flush
+	 */
+	StreamingStorageSystemRecorder(Writer_t& writer, unsigned int chunkSize) : _writer(writer), _chunkSize(chunkSize), _bufferedSteps(0)
+	{
+	}
+
+	virtual void notifyIntegrationStart(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
+	{
+		InternalStorageSystemRecorder::notifyIntegrationStart(numDofs, numSens, numTimesteps);
+		_bufferedSteps = 0;
+	}
+
+	virtual void endTimestep()
+	{
+		InternalStorageSystemRecorder::endTimestep();
+
+		++_bufferedSteps;
+		if (_bufferedSteps >= _chunkSize)
+			flush();
+	}
+
+	/**
+	 * @brief Appends all buffered time steps to the file and clears the buffers
+	 * @details Called automatically whenever a full chunk has accumulated. Has to be
+	 *          called once after time integration to flush the last (partial) chunk.
+	 */
+	void flush()
+	{
+		if (_bufferedSteps == 0)
+			return;
+
+		std::ostringstream oss;
+
+		_writer.pushGroup("output");
+		_writer.pushGroup("solution");
+
+		if (_storeTime)
+		{
+			_writer.template appendVector<double>("SOLUTION_TIMES", _time.size(), _time.data());
+			_time.clear();
+		}
+
+		for (InternalStorageUnitOpRecorder* rec : _recorders)
+		{
+			oss.str("");
+			oss << "unit_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << static_cast<int>(rec->unitOperation());
+
+			_writer.pushGroup(oss.str());
+			rec->flushSolution(_writer, _bufferedSteps);
+			_writer.popGroup();
+		}
+
+		_writer.popGroup(); // solution
+
+		if (_numSens > 0)
+		{
+			_writer.pushGroup("sensitivity");
+
+			for (unsigned int param = 0; param < _numSens; ++param)
+			{
+				oss.str("");
+				oss << "param_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << param;
+				_writer.pushGroup(oss.str());
+
+				for (InternalStorageUnitOpRecorder* rec : _recorders)
+				{
+					oss.str("");
+					oss << "unit_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << static_cast<int>(rec->unitOperation());
+
+					_writer.pushGroup(oss.str());
+					rec->flushSensitivity(_writer, param, _bufferedSteps);
+					_writer.popGroup();
+				}
+
+				_writer.popGroup();
+			}
+
+			_writer.popGroup(); // sensitivity
+		}
+
+		_writer.popGroup(); // output
+
+		_bufferedSteps = 0;
+	}
+
+	inline unsigned int chunkSize() const CADET_NOEXCEPT { return _chunkSize; }
+	inline void chunkSize(unsigned int cs) CADET_NOEXCEPT { _chunkSize = cs; }
+
+protected:
+
+	Writer_t& _writer;
+	unsigned int _chunkSize;
+	unsigned int _bufferedSteps;
+};
+
+
+
+
+/**
+ * @brief Decouples solution recording from the time integration thread
+ * @details Wraps another ISolutionRecorder and forwards all recorded data to it on a
+ *          dedicated consumer thread. The integration thread only gathers the raw
+ *          solution slices into a ring of buffers (which are preallocated after the
+ *          first few time steps since the slots are reused), while the consumer thread
+ *          replays the buffered time steps on the wrapped recorder, which performs the
+ *          actual copying and reordering. The buffered data is served to the wrapped
+ *          recorder through an exporter that mimics the original one.
+ *          
+ *          The order of the time steps is preserved. If the ring is full, the
+ *          integration thread blocks until the consumer has caught up. Structural
+ *          callbacks (clear(), prepare(), notifyIntegrationStart(), and
+ *          unitOperationStructure()) drain the ring and are forwarded synchronously.
+ *          Call wait() after time integration (or rely on the destructor) before
+ *          reading results from the wrapped recorder.
+ *          
+ *          The replaying exporter assumes the interleaved particle shell layout of the
+ *          models in this library (mobile phase components first, then bound states)
+ *          when serving single element queries.
+ */
+class AsyncSystemRecorder : public ISolutionRecorder
+{
+public:
+
+	/**
+	 * @brief Creates an AsyncSystemRecorder
+	 * @param [in] target Recorder that receives the buffered data on the consumer thread
+	 * @param [in] queueDepth Number of time steps that can be buffered before the integration thread blocks
+	 */
+	AsyncSystemRecorder(ISolutionRecorder& target, unsigned int queueDepth = 8) : _target(target), _ring(std::max(queueDepth, 2u)),
+		_head(0), _count(0), _shutdown(false), _curBuf(nullptr)
+	{
+		_consumer = std::thread(&AsyncSystemRecorder::consumeLoop, this);
+	}
+
+	virtual ~AsyncSystemRecorder() CADET_NOEXCEPT
+	{
+		wait();
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_shutdown = true;
+		}
+		_notEmpty.notify_all();
+		_consumer.join();
+	}
+
+	/**
+	 * @brief Blocks until all buffered time steps have been replayed on the wrapped recorder
+	 */
+	void wait()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (_count > 0)
+			_notFull.wait(lock);
+	}
+
+	/**
+	 * @brief Returns the wrapped recorder
+	 * @details Call wait() before reading results during or after time integration.
+	 */
+	inline ISolutionRecorder& target() CADET_NOEXCEPT { return _target; }
+
+	virtual void clear()
+	{
+		wait();
+		_target.clear();
+	}
+
+	virtual void prepare(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
+	{
+		wait();
+		_target.prepare(numDofs, numSens, numTimesteps);
+	}
+
+	virtual void notifyIntegrationStart(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
+	{
+		wait();
+		_target.notifyIntegrationStart(numDofs, numSens, numTimesteps);
+	}
+
+	virtual void notifyTimePoints(unsigned int numTimesteps)
+	{
+		wait();
+		_target.notifyTimePoints(numTimesteps);
+	}
+
+	virtual void unitOperationStructure(UnitOpIdx idx, const IModel& model, const ISolutionExporter& exporter)
+	{
+		wait();
+
+		// Capture the (time invariant) structure of the unit operation for replay
+		UnitStructure* su = nullptr;
+		for (UnitStructure& u : _units)
+		{
+			if (u.idx == idx)
+			{
+				su = &u;
+				break;
+			}
+		}
+		if (!su)
+		{
+			_units.push_back(UnitStructure());
+			su = &_units.back();
+		}
+
+		su->idx = idx;
+		su->model = &model;
+		su->multiBound = exporter.hasMultipleBoundStates();
+		su->nonBinding = exporter.hasNonBindingComponents();
+		su->parFlux = exporter.hasParticleFlux();
+		su->parMobile = exporter.hasParticleMobilePhase();
+		su->nComp = exporter.numComponents();
+		su->nAxial = exporter.numAxialCells();
+		su->nRadial = exporter.numRadialCells();
+		su->nBound = exporter.numBoundStates();
+		su->nColDofs = exporter.numColumnDofs();
+		su->nParDofs = exporter.numParticleDofs();
+		su->nFluxDofs = exporter.numFluxDofs();
+
+		su->boundPerComp.assign(exporter.numBoundStatesPerComponent(), exporter.numBoundStatesPerComponent() + su->nComp);
+		su->boundOffset.resize(su->nComp);
+		unsigned int offset = 0;
+		for (unsigned int i = 0; i < su->nComp; ++i)
+		{
+			su->boundOffset[i] = offset;
+			offset += su->boundPerComp[i];
+		}
+
+		unsigned int len = 0;
+		StateOrdering const* order = exporter.concentrationOrdering(len);
+		su->concOrdering.assign(order, order + len);
+		order = exporter.fluxOrdering(len);
+		su->fluxOrdering.assign(order, order + len);
+		order = exporter.mobilePhaseOrdering(len);
+		su->parOrdering.assign(order, order + len);
+		order = exporter.solidPhaseOrdering(len);
+		su->solidOrdering.assign(order, order + len);
+
+		// Offset of the solid phase inside the particle slice (interleaved layout)
+		su->solidOffset = 0;
+		if (su->parMobile && (su->nParDofs > 0))
+			su->solidOffset = static_cast<unsigned int>(exporter.solidPhase() - exporter.mobilePhase());
+
+		_target.unitOperationStructure(idx, model, exporter);
+	}
+
+	virtual void beginTimestep(double t)
+	{
+		_curBuf = acquireSlot();
+		_curBuf->time = t;
+		_curBuf->data.clear();
+		_curBuf->events.clear();
+	}
+
+	virtual void beginUnitOperation(UnitOpIdx idx, const IModel& model, const ISolutionExporter& exporter)
+	{
+		if (!_curBuf)
+		{
+			_target.beginUnitOperation(idx, model, exporter);
+			return;
+		}
+
+		unsigned int unitIdx = 0;
+		for (; unitIdx < _units.size(); ++unitIdx)
+		{
+			if (_units[unitIdx].idx == idx)
+				break;
+		}
+
+		const UnitStructure& su = _units[unitIdx];
+		std::vector<double>& data = _curBuf->data;
+		const std::size_t offset = data.size();
+
+		// Gather inlet and outlet contiguously, copy the remaining slices verbatim
+		const SolutionSpan inlet = exporter.inletSpan();
+		for (unsigned int i = 0; i < su.nComp; ++i)
+			data.push_back(inlet.data[i * inlet.stride]);
+
+		const SolutionSpan outlet = exporter.outletSpan();
+		for (unsigned int i = 0; i < su.nComp; ++i)
+			data.push_back(outlet.data[i * outlet.stride]);
+
+		const SolutionSpan conc = exporter.concentrationSpan();
+		data.insert(data.end(), conc.data, conc.data + su.nColDofs);
+
+		const SolutionSpan parts = exporter.mobilePhaseSpan();
+		data.insert(data.end(), parts.data, parts.data + su.nParDofs);
+
+		const SolutionSpan flux = exporter.fluxSpan();
+		data.insert(data.end(), flux.data, flux.data + su.nFluxDofs);
+
+		pushEvent(Event::UnitOperation, unitIdx, offset);
+	}
+
+	virtual void endUnitOperation()
+	{
+		if (!_curBuf)
+		{
+			_target.endUnitOperation();
+			return;
+		}
+		pushEvent(Event::EndUnitOperation, 0, 0);
+	}
+
+	virtual void endTimestep()
+	{
+		if (!_curBuf)
+		{
+			_target.endTimestep();
+			return;
+		}
+
+		// Publish the buffer to the consumer thread
+		_curBuf = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			++_count;
+		}
+		_notEmpty.notify_all();
+	}
+
+	virtual void beginSolution() { forwardOrPush(Event::BeginSolution, &ISolutionRecorder::beginSolution); }
+	virtual void endSolution() { forwardOrPush(Event::EndSolution, &ISolutionRecorder::endSolution); }
+	virtual void beginSolutionDerivative() { forwardOrPush(Event::BeginSolutionDot, &ISolutionRecorder::beginSolutionDerivative); }
+	virtual void endSolutionDerivative() { forwardOrPush(Event::EndSolutionDot, &ISolutionRecorder::endSolutionDerivative); }
+
+	virtual void beginSensitivity(const ParameterId& pId, unsigned int sensIdx) { forwardOrPush(Event::BeginSensitivity, &ISolutionRecorder::beginSensitivity, pId, sensIdx); }
+	virtual void endSensitivity(const ParameterId& pId, unsigned int sensIdx) { forwardOrPush(Event::EndSensitivity, &ISolutionRecorder::endSensitivity, pId, sensIdx); }
+	virtual void beginSensitivityDerivative(const ParameterId& pId, unsigned int sensIdx) { forwardOrPush(Event::BeginSensitivityDot, &ISolutionRecorder::beginSensitivityDerivative, pId, sensIdx); }
+	virtual void endSensitivityDerivative(const ParameterId& pId, unsigned int sensIdx) { forwardOrPush(Event::EndSensitivityDot, &ISolutionRecorder::endSensitivityDerivative, pId, sensIdx); }
+
+protected:
+
+	struct UnitStructure
+	{
+		UnitOpIdx idx;
+		IModel const* model;
+		bool multiBound;
+		bool nonBinding;
+		bool parFlux;
+		bool parMobile;
+		unsigned int nComp;
+		unsigned int nAxial;
+		unsigned int nRadial;
+		unsigned int nBound;
+		unsigned int nColDofs;
+		unsigned int nParDofs;
+		unsigned int nFluxDofs;
+		unsigned int solidOffset;
+		std::vector<unsigned int> boundPerComp;
+		std::vector<unsigned int> boundOffset;
+		std::vector<StateOrdering> concOrdering;
+		std::vector<StateOrdering> fluxOrdering;
+		std::vector<StateOrdering> parOrdering;
+		std::vector<StateOrdering> solidOrdering;
+	};
+
+	struct Event
+	{
+		enum Type
+		{
+			BeginSolution,
+			EndSolution,
+			BeginSolutionDot,
+			EndSolutionDot,
+			BeginSensitivity,
+			EndSensitivity,
+			BeginSensitivityDot,
+			EndSensitivityDot,
+			UnitOperation,
+			EndUnitOperation,
+		};
+
+		Type type;
+		unsigned int idx; //!< Index into the unit structure table or sensitivity index
+		std::size_t dataOffset; //!< Offset of the unit operation data inside the buffer
+		ParameterId pId; //!< Parameter ID for sensitivity events
+	};
+
+	struct TimestepBuffer
+	{
+		double time;
+		std::vector<double> data;
+		std::vector<Event> events;
+	};
+
+	/**
+	 * @brief Serves buffered solution slices through the ISolutionExporter interface
+	 */
+	class BufferedExporter : public ISolutionExporter
+	{
+	public:
+		BufferedExporter(const UnitStructure& su, double const* data) : _su(su), _inlet(data), _outlet(data + su.nComp),
+			_column(_outlet + su.nComp), _particle(_column + su.nColDofs), _flux(_particle + su.nParDofs) { }
+
+		virtual bool hasMultipleBoundStates() const CADET_NOEXCEPT { return _su.multiBound; }
+		virtual bool hasNonBindingComponents() const CADET_NOEXCEPT { return _su.nonBinding; }
+		virtual bool hasParticleFlux() const CADET_NOEXCEPT { return _su.parFlux; }
+		virtual bool hasParticleMobilePhase() const CADET_NOEXCEPT { return _su.parMobile; }
+
+		virtual unsigned int numComponents() const CADET_NOEXCEPT { return _su.nComp; }
+		virtual unsigned int numAxialCells() const CADET_NOEXCEPT { return _su.nAxial; }
+		virtual unsigned int numRadialCells() const CADET_NOEXCEPT { return _su.nRadial; }
+		virtual unsigned int numBoundStates() const CADET_NOEXCEPT { return _su.nBound; }
+		virtual unsigned int const* numBoundStatesPerComponent() const CADET_NOEXCEPT { return _su.boundPerComp.data(); }
+		virtual unsigned int numBoundStates(unsigned int comp) const CADET_NOEXCEPT { return _su.boundPerComp[comp]; }
+		virtual unsigned int numColumnDofs() const CADET_NOEXCEPT { return _su.nColDofs; }
+		virtual unsigned int numParticleDofs() const CADET_NOEXCEPT { return _su.nParDofs; }
+		virtual unsigned int numFluxDofs() const CADET_NOEXCEPT { return _su.nFluxDofs; }
+
+		virtual double concentration(unsigned int component, unsigned int axialCell) const { return _column[planarIndex(_su.concOrdering, component, axialCell)]; }
+		virtual double flux(unsigned int component, unsigned int axialCell) const { return _flux[planarIndex(_su.fluxOrdering, component, axialCell)]; }
+		virtual double mobilePhase(unsigned int component, unsigned int axialCell, unsigned int radialCell) const
+		{
+			return _particle[shellIndex(axialCell, radialCell) + component];
+		}
+		virtual double solidPhase(unsigned int component, unsigned int axialCell, unsigned int radialCell, unsigned int boundState) const
+		{
+			return _particle[shellIndex(axialCell, radialCell) + _su.nComp + _su.boundOffset[component] + boundState];
+		}
+
+		virtual double const* concentration() const { return _column; }
+		virtual double const* flux() const { return _flux; }
+		virtual double const* mobilePhase() const { return _particle; }
+		virtual double const* solidPhase() const { return _particle + _su.solidOffset; }
+		virtual double const* inlet(unsigned int& stride) const
+		{
+			stride = 1;
+			return _inlet;
+		}
+		virtual double const* outlet(unsigned int& stride) const
+		{
+			stride = 1;
+			return _outlet;
+		}
+
+		virtual StateOrdering const* concentrationOrdering(unsigned int& len) const
+		{
+			len = _su.concOrdering.size();
+			return _su.concOrdering.data();
+		}
+		virtual StateOrdering const* fluxOrdering(unsigned int& len) const
+		{
+			len = _su.fluxOrdering.size();
+			return _su.fluxOrdering.data();
+		}
+		virtual StateOrdering const* mobilePhaseOrdering(unsigned int& len) const
+		{
+			len = _su.parOrdering.size();
+			return _su.parOrdering.data();
+		}
+		virtual StateOrdering const* solidPhaseOrdering(unsigned int& len) const
+		{
+			len = _su.solidOrdering.size();
+			return _su.solidOrdering.data();
+		}
+
+	protected:
+
+		/**
+		 * @brief Computes the index of a planar (component x axial cell) entry from its state ordering
+		 */
+		inline unsigned int planarIndex(const std::vector<StateOrdering>& ordering, unsigned int comp, unsigned int cell) const
+		{
+			unsigned int idx = 0;
+			for (StateOrdering o : ordering)
+			{
+				switch (o)
+				{
+					case StateOrdering::Component:
+						idx = idx * _su.nComp + comp;
+						break;
+					case StateOrdering::AxialCell:
+						idx = idx * _su.nAxial + cell;
+						break;
+					default:
+						break;
+				}
+			}
+			return idx;
+		}
+
+		/**
+		 * @brief Computes the index of the first entry of a particle shell
+		 * @details Assumes the interleaved shell layout (all components and bound states of
+		 *          a shell are contiguous) used by the models in this library.
+		 */
+		inline unsigned int shellIndex(unsigned int axialCell, unsigned int radialCell) const
+		{
+			unsigned int idx = 0;
+			for (StateOrdering o : _su.parOrdering)
+			{
+				switch (o)
+				{
+					case StateOrdering::AxialCell:
+						idx = idx * _su.nAxial + axialCell;
+						break;
+					case StateOrdering::RadialCell:
+						idx = idx * _su.nRadial + radialCell;
+						break;
+					default:
+						break;
+				}
+			}
+			return idx * (_su.nComp + _su.nBound);
+		}
+
+		const UnitStructure& _su;
+		double const* const _inlet;
+		double const* const _outlet;
+		double const* const _column;
+		double const* const _particle;
+		double const* const _flux;
+	};
+
+	/**
+	 * @brief Appends an event to the current buffer
+	 */
+	inline void pushEvent(Event::Type type, unsigned int idx, std::size_t dataOffset)
+	{
+		Event ev;
+		ev.type = type;
+		ev.idx = idx;
+		ev.dataOffset = dataOffset;
+		_curBuf->events.push_back(ev);
+	}
+
+	/**
+	 * @brief Forwards a parameterless section callback directly or records it for replay
+	 */
+	inline void forwardOrPush(Event::Type type, void (ISolutionRecorder::*fwd)())
+	{
+		if (!_curBuf)
+		{
+			(_target.*fwd)();
+			return;
+		}
+		pushEvent(type, 0, 0);
+	}
+
+	/**
+	 * @brief Forwards a sensitivity section callback directly or records it for replay
+	 */
+	inline void forwardOrPush(Event::Type type, void (ISolutionRecorder::*fwd)(const ParameterId&, unsigned int), const ParameterId& pId, unsigned int sensIdx)
+	{
+		if (!_curBuf)
+		{
+			(_target.*fwd)(pId, sensIdx);
+			return;
+		}
+		Event ev;
+		ev.type = type;
+		ev.idx = sensIdx;
+		ev.dataOffset = 0;
+		ev.pId = pId;
+		_curBuf->events.push_back(ev);
+	}
+
+	/**
+	 * @brief Blocks until a ring slot is available and returns it
+	 */
+	TimestepBuffer* acquireSlot()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (_count >= _ring.size())
+			_notFull.wait(lock);
+
+		// The consumer advances _head and decrements _count together, so this
+		// index is stable even after the lock is released
+		return &_ring[(_head + _count) % _ring.size()];
+	}
+
+	/**
+	 * @brief Consumer thread main loop replaying buffered time steps on the wrapped recorder
+	 */
+	void consumeLoop()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		for (;;)
+		{
+			while ((_count == 0) && !_shutdown)
+				_notEmpty.wait(lock);
+
+			if (_count == 0)
+				return;
+
+			TimestepBuffer& buf = _ring[_head];
+			lock.unlock();
+			replay(buf);
+			lock.lock();
+
+			_head = (_head + 1) % _ring.size();
+			--_count;
+			_notFull.notify_all();
+		}
+	}
+
+	/**
+	 * @brief Replays one buffered time step on the wrapped recorder
+	 */
+	void replay(const TimestepBuffer& buf)
+	{
+		_target.beginTimestep(buf.time);
+		for (const Event& ev : buf.events)
+		{
+			switch (ev.type)
+			{
+				case Event::BeginSolution:
+					_target.beginSolution();
+					break;
+				case Event::EndSolution:
+					_target.endSolution();
+					break;
+				case Event::BeginSolutionDot:
+					_target.beginSolutionDerivative();
+					break;
+				case Event::EndSolutionDot:
+					_target.endSolutionDerivative();
+					break;
+				case Event::BeginSensitivity:
+					_target.beginSensitivity(ev.pId, ev.idx);
+					break;
+				case Event::EndSensitivity:
+					_target.endSensitivity(ev.pId, ev.idx);
+					break;
+				case Event::BeginSensitivityDot:
+					_target.beginSensitivityDerivative(ev.pId, ev.idx);
+					break;
+				case Event::EndSensitivityDot:
+					_target.endSensitivityDerivative(ev.pId, ev.idx);
+					break;
+				case Event::UnitOperation:
+				{
+					const UnitStructure& su = _units[ev.idx];
+					const BufferedExporter exporter(su, buf.data.data() + ev.dataOffset);
+					_target.beginUnitOperation(su.idx, *su.model, exporter);
+					break;
+				}
+				case Event::EndUnitOperation:
+					_target.endUnitOperation();
+					break;
+			}
+		}
+		_target.endTimestep();
+	}
+
+	ISolutionRecorder& _target;
+	std::vector<UnitStructure> _units;
+
+	std::vector<TimestepBuffer> _ring;
+	unsigned int _head; //!< Index of the oldest pending buffer
+	unsigned int _count; //!< Number of pending buffers
+	bool _shutdown; //!< Signals the consumer thread to terminate once the ring is empty
+	TimestepBuffer* _curBuf; //!< Buffer of the time step currently being recorded (only touched by the producer)
+
+	std::mutex _mutex;
+	std::condition_variable _notEmpty;
+	std::condition_variable _notFull;
+	std::thread _consumer;
+};
+
+
 } // namespace cadet
 
 #endif  // LIBCADET_SOLUTIONRECORDER_IMPL_HPP_
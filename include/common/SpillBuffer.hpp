@@ -0,0 +1,346 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides an append-only double buffer that can spill to a memory-mapped scratch file.
+ */
+
+#ifndef CADET_SPILLBUFFER_HPP_
+#define CADET_SPILLBUFFER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "cadet/cadetCompilerInfo.hpp"
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	#define CADET_SPILLBUFFER_MMAP
+	#include <sys/mman.h>
+	#include <sys/types.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace cadet
+{
+
+/**
+ * @brief Append-only buffer of doubles that can spill completed data to a scratch file
+ * @details By default the buffer behaves like a plain std::vector<double>. After a call
+ *          to spillToFile(), the contents live in an unlinked memory-mapped scratch file
+ *          instead of the heap: appends go to the mapped tail, and whenever the resident
+ *          window exceeds the configured budget, the completed head of the buffer is
+ *          scheduled for asynchronous writeback (msync with @c MS_ASYNC) and dropped from
+ *          the process (madvise with @c MADV_DONTNEED). This bounds the RSS contribution
+ *          of the buffer to roughly the budget regardless of how much data is recorded.
+ *
+ *          Since the mapping is shared and file-backed, spilled data is not lost: reading
+ *          through data() transparently pages it back in from the file. The scratch file
+ *          is unlinked immediately after creation, so crashed or killed runs never leak
+ *          scratch files; the operating system reclaims the space when the process exits.
+ *
+ *          On platforms without POSIX memory mapping, spillToFile() fails and the buffer
+ *          simply remains on the heap. All operations invalidate pointers previously
+ *          obtained from data().
+ */
+class SpillBuffer
+{
+public:
+
+	SpillBuffer() CADET_NOEXCEPT : _size(0)
+#ifdef CADET_SPILLBUFFER_MMAP
+		, _fd(-1), _mapped(nullptr), _mappedBytes(0), _capacity(0), _retiredBytes(0), _residentBytes(0), _pageSize(0)
+#endif
+	{ }
+
+	~SpillBuffer() CADET_NOEXCEPT
+	{
+#ifdef CADET_SPILLBUFFER_MMAP
+		if (_mapped)
+			munmap(_mapped, _mappedBytes);
+		if (_fd >= 0)
+			close(_fd);
+#endif
+	}
+
+	// Buffers own either heap memory or a file mapping and are not copyable
+	SpillBuffer(const SpillBuffer&) = delete;
+	SpillBuffer& operator=(const SpillBuffer&) = delete;
+
+	/**
+	 * @brief Moves the buffer to a memory-mapped scratch file
+	 * @details Creates an unlinked scratch file in the given directory and migrates any
+	 *          contents already recorded. On failure (or on platforms without POSIX
+	 *          memory mapping) the buffer keeps its heap storage and remains fully
+	 *          functional. Calling this on an already spilling buffer only updates the
+	 *          resident budget.
+	 * @param [in] scratchDir Directory the scratch file is created in
+	 * @param [in] residentBytes Approximate upper bound on the resident set contribution of this buffer
+	 * @return @c true if the buffer is backed by a scratch file, otherwise @c false
+	 */
+	bool spillToFile(const std::string& scratchDir, std::size_t residentBytes)
+	{
+#ifdef CADET_SPILLBUFFER_MMAP
+		_residentBytes = std::max(residentBytes, static_cast<std::size_t>(sysconf(_SC_PAGESIZE)));
+		if (_fd >= 0)
+			return true;
+
+		_pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+		// mkstemp() requires a mutable template string
+		std::vector<char> fileName(scratchDir.begin(), scratchDir.end());
+		const char tpl[] = "/cadet_spill_XXXXXX";
+		fileName.insert(fileName.end(), tpl, tpl + sizeof(tpl));
+
+		_fd = mkstemp(fileName.data());
+		if (_fd < 0)
+			return false;
+
+		// Unlink immediately so that crashed runs never leak scratch files
+		unlink(fileName.data());
+
+		// Migrate contents recorded before spilling was enabled
+		if (!ensureCapacity(std::max(_size, _pageSize / sizeof(double))))
+		{
+			close(_fd);
+			_fd = -1;
+			return false;
+		}
+
+		if (_size > 0)
+			std::memcpy(_mapped, _mem.data(), _size * sizeof(double));
+
+		std::vector<double>().swap(_mem);
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * @brief Removes all elements
+	 * @details Neither heap capacity nor scratch file size are given back.
+	 */
+	inline void clear() CADET_NOEXCEPT
+	{
+		_mem.clear();
+		_size = 0;
+#ifdef CADET_SPILLBUFFER_MMAP
+		_retiredBytes = 0;
+#endif
+	}
+
+	/**
+	 * @brief Reserves storage for the given number of elements
+	 * @param [in] numElements Number of elements to reserve storage for
+	 */
+	inline void reserve(std::size_t numElements)
+	{
+#ifdef CADET_SPILLBUFFER_MMAP
+		if (_fd >= 0)
+		{
+			ensureCapacity(numElements);
+			return;
+		}
+#endif
+		_mem.reserve(numElements);
+	}
+
+	/**
+	 * @brief Appends the given range at the end of the buffer
+	 * @details When spilling, completed data beyond the resident budget is scheduled
+	 *          for writeback and dropped from the resident set.
+	 * @param [in] first Pointer to the first element to append
+	 * @param [in] last Pointer one past the last element to append
+	 */
+	void append(double const* first, double const* last)
+	{
+#ifdef CADET_SPILLBUFFER_MMAP
+		if (_fd >= 0)
+		{
+			const std::size_t n = static_cast<std::size_t>(last - first);
+			if (!ensureCapacity(_size + n))
+			{
+				// Growing the scratch file failed (e.g., disk full); fall back to the heap
+				abandonFile();
+				_mem.insert(_mem.end(), first, last);
+				_size = _mem.size();
+				return;
+			}
+
+			std::memcpy(_mapped + _size, first, n * sizeof(double));
+			_size += n;
+			retireCompletedPages();
+			return;
+		}
+#endif
+		_mem.insert(_mem.end(), first, last);
+		_size = _mem.size();
+	}
+
+	/**
+	 * @brief Returns a pointer to the contiguous buffer contents
+	 * @details When spilling, reads through this pointer transparently page spilled
+	 *          data back in from the scratch file.
+	 * @return Pointer to the first element, only valid until the next non-const operation
+	 */
+	inline double const* data() const CADET_NOEXCEPT
+	{
+#ifdef CADET_SPILLBUFFER_MMAP
+		if (_fd >= 0)
+			return _mapped;
+#endif
+		return _mem.data();
+	}
+
+	/**
+	 * @brief Returns the number of elements in the buffer
+	 * @return Number of elements
+	 */
+	inline std::size_t size() const CADET_NOEXCEPT { return _size; }
+
+	/**
+	 * @brief Returns an estimate of the resident memory consumed by the buffer
+	 * @details When spilling, only the resident window counts; data retired to the
+	 *          scratch file does not occupy process memory.
+	 * @return Resident memory in bytes
+	 */
+	inline std::size_t memoryFootprint() const CADET_NOEXCEPT
+	{
+#ifdef CADET_SPILLBUFFER_MMAP
+		if (_fd >= 0)
+			return _size * sizeof(double) - _retiredBytes;
+#endif
+		return _mem.capacity() * sizeof(double);
+	}
+
+	/**
+	 * @brief Removes the contents from the buffer and returns them
+	 * @details In heap mode the storage is moved out without copying; when spilling,
+	 *          the contents are copied back from the scratch file.
+	 * @return Vector with the former buffer contents
+	 */
+	std::vector<double> extract()
+	{
+		std::vector<double> v;
+#ifdef CADET_SPILLBUFFER_MMAP
+		if (_fd >= 0)
+		{
+			v.assign(_mapped, _mapped + _size);
+			clear();
+			return v;
+		}
+#endif
+		v.swap(_mem);
+		_size = 0;
+		return v;
+	}
+
+protected:
+
+#ifdef CADET_SPILLBUFFER_MMAP
+
+	/**
+	 * @brief Grows scratch file and mapping to hold at least the given number of elements
+	 * @details The new mapping is established before the old one is released, so the
+	 *          contents remain intact if growing fails.
+	 * @param [in] numElements Required capacity in elements
+	 * @return @c true if the capacity is available, otherwise @c false
+	 */
+	bool ensureCapacity(std::size_t numElements)
+	{
+		if (numElements <= _capacity)
+			return true;
+
+		std::size_t newBytes = std::max(2 * _mappedBytes, numElements * sizeof(double));
+		newBytes = ((newBytes + _pageSize - 1) / _pageSize) * _pageSize;
+
+		if (ftruncate(_fd, static_cast<off_t>(newBytes)) != 0)
+			return false;
+
+		void* const p = mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+		if (p == MAP_FAILED)
+			return false;
+
+		if (_mapped)
+			munmap(_mapped, _mappedBytes);
+
+		_mapped = static_cast<double*>(p);
+		_mappedBytes = newBytes;
+		_capacity = newBytes / sizeof(double);
+		return true;
+	}
+
+	/**
+	 * @brief Schedules completed pages beyond the resident budget for writeback and drops them
+	 * @details Dirty pages of a shared file mapping are preserved by the kernel, so
+	 *          dropping them after scheduling asynchronous writeback loses no data.
+	 */
+	void retireCompletedPages()
+	{
+		const std::size_t usedBytes = _size * sizeof(double);
+		if (usedBytes - _retiredBytes <= _residentBytes)
+			return;
+
+		// Retire whole pages up to the start of the resident tail window
+		const std::size_t retireEnd = ((usedBytes - _residentBytes) / _pageSize) * _pageSize;
+		if (retireEnd <= _retiredBytes)
+			return;
+
+		char* const base = reinterpret_cast<char*>(_mapped) + _retiredBytes;
+		const std::size_t len = retireEnd - _retiredBytes;
+		msync(base, len, MS_ASYNC);
+#ifdef MADV_DONTNEED
+		madvise(base, len, MADV_DONTNEED);
+#endif
+		_retiredBytes = retireEnd;
+	}
+
+	/**
+	 * @brief Copies the contents back to the heap and releases the scratch file
+	 * @details Used as fallback when the scratch file cannot grow any further.
+	 */
+	void abandonFile()
+	{
+		_mem.assign(_mapped, _mapped + _size);
+		munmap(_mapped, _mappedBytes);
+		close(_fd);
+		_fd = -1;
+		_mapped = nullptr;
+		_mappedBytes = 0;
+		_capacity = 0;
+		_retiredBytes = 0;
+	}
+
+#endif  // CADET_SPILLBUFFER_MMAP
+
+	std::vector<double> _mem; //!< Heap storage used until the buffer spills
+	std::size_t _size; //!< Number of recorded elements
+
+#ifdef CADET_SPILLBUFFER_MMAP
+	int _fd; //!< File descriptor of the scratch file, @c -1 while on the heap
+	double* _mapped; //!< Base address of the file mapping
+	std::size_t _mappedBytes; //!< Size of the file mapping in bytes
+	std::size_t _capacity; //!< Capacity of the file mapping in elements
+	std::size_t _retiredBytes; //!< Bytes at the head of the buffer already retired to the file
+	std::size_t _residentBytes; //!< Approximate resident set budget in bytes
+	std::size_t _pageSize; //!< System page size in bytes
+#endif
+};
+
+} // namespace cadet
+
+#endif  // CADET_SPILLBUFFER_HPP_
@@ -53,6 +53,16 @@ namespace cadet
 			return elapsed;
 		}
 
+		/**
+		 * @brief Returns the time elapsed since the last call to start() without stopping the timer
+		 * @details Does not modify the accumulated total elapsed time.
+		 * @return Elapsed time since the last call to start() in seconds
+		 */
+		inline double peek() const
+		{
+			return timer_t::stopCore();
+		}
+
 		/**
 		 * @brief Returns the total elapsed time between all start() and stop() calls in seconds
 		 * @return Total elapsed time in seconds
@@ -0,0 +1,72 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Defines constants of the flat binary snapshot format shared by BinaryReader and BinaryWriter.
+ *
+ * The format stores a parameter tree (groups containing datasets or other groups) in a single
+ * flat file that can be memory mapped and navigated in place without parsing:
+ *
+ *     Header (32 bytes): char magic[8], uint64 version, uint64 rootOffset, uint64 fileSize
+ *
+ * All offsets are absolute file offsets and all records are 8 byte aligned. A node record
+ * begins with a uint64 type tag. Group nodes continue with the number of children followed
+ * by (nameOffset, nodeOffset) pairs. Dataset nodes continue with a flags field (bit 0 marks
+ * a vector as opposed to a scalar), the number of elements, and the payload. Numeric payloads
+ * are stored as 8 byte elements (double, int64, uint64); string payloads and names are stored
+ * as a uint64 length followed by the characters, padded to 8 bytes.
+ *
+ * The data is stored in native byte order since snapshots are machine-local caches and not
+ * an exchange format.
+ */
+
+#ifndef LIBCADET_BINARYFORMAT_HPP_
+#define LIBCADET_BINARYFORMAT_HPP_
+
+#include <cstdint>
+
+namespace cadet
+{
+
+namespace io
+{
+
+namespace bin
+{
+
+	const char fileMagic[8] = { 'C', 'A', 'D', 'E', 'T', 'B', 'I', 'N' };
+	const uint64_t fileVersion = 1;
+	const uint64_t headerSize = 32;
+
+	const uint64_t nodeTypeGroup = 0;
+	const uint64_t nodeTypeDouble = 1;
+	const uint64_t nodeTypeInt = 2;
+	const uint64_t nodeTypeUint64 = 3;
+	const uint64_t nodeTypeString = 4;
+
+	const uint64_t flagVector = 1;
+
+	/**
+	 * @brief Rounds the given size up to the next multiple of 8 bytes
+	 * @param [in] n Size in bytes
+	 * @return Smallest multiple of 8 that is at least @p n
+	 */
+	inline uint64_t alignTo8(uint64_t n) { return (n + 7) & ~static_cast<uint64_t>(7); }
+
+}  // namespace bin
+
+}  // namespace io
+
+}  // namespace cadet
+
+#endif  // LIBCADET_BINARYFORMAT_HPP_
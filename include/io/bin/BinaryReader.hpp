@@ -0,0 +1,370 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a memory-mapped reader for the flat binary snapshot format (see BinaryFormat.hpp).
+ */
+
+#ifndef LIBCADET_BINARYREADER_HPP_
+#define LIBCADET_BINARYREADER_HPP_
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+#include "cadet/cadetCompilerInfo.hpp"
+#include "io/IOException.hpp"
+#include "io/bin/BinaryFormat.hpp"
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace cadet
+{
+
+namespace io
+{
+
+/**
+ * @brief Reads a parameter tree from a memory-mapped flat binary snapshot file
+ * @details The file is mapped into memory and navigated in place; no parsing or copying
+ *          happens on open. This makes repeated runs over the same input (e.g., parameter
+ *          sweeps with many worker processes) start much faster than opening the full
+ *          featured file formats every time. Snapshots are created by BinaryWriter.
+ */
+class BinaryReader
+{
+public:
+	/// \brief Constructor
+	BinaryReader() : _data(nullptr), _size(0), _root(0), _groupStack()
+	{
+#ifdef _WIN32
+		_file = INVALID_HANDLE_VALUE;
+		_mapping = NULL;
+#else
+		_fd = -1;
+#endif
+	}
+
+	/// \brief Destructor
+	~BinaryReader() CADET_NOEXCEPT { closeFile(); }
+
+	/// \brief Memory maps a snapshot file and validates its header
+	inline void openFile(const std::string& fileName, const std::string& mode = "r")
+	{
+		if ((mode != "r") && (mode != "rw"))
+			throw IOException("Binary snapshot files can only be opened for reading");
+
+		closeFile();
+
+#ifdef _WIN32
+		_file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (_file == INVALID_HANDLE_VALUE)
+			throw IOException("Failed to open binary snapshot file '" + fileName + "'");
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(_file, &fileSize))
+		{
+			closeFile();
+			throw IOException("Failed to determine size of binary snapshot file '" + fileName + "'");
+		}
+		_size = static_cast<uint64_t>(fileSize.QuadPart);
+
+		_mapping = CreateFileMappingA(_file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (!_mapping)
+		{
+			closeFile();
+			throw IOException("Failed to memory map binary snapshot file '" + fileName + "'");
+		}
+
+		_data = static_cast<char const*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+		if (!_data)
+		{
+			closeFile();
+			throw IOException("Failed to memory map binary snapshot file '" + fileName + "'");
+		}
+#else
+		_fd = ::open(fileName.c_str(), O_RDONLY);
+		if (_fd < 0)
+			throw IOException("Failed to open binary snapshot file '" + fileName + "'");
+
+		struct stat fileInfo;
+		if (::fstat(_fd, &fileInfo) < 0)
+		{
+			closeFile();
+			throw IOException("Failed to determine size of binary snapshot file '" + fileName + "'");
+		}
+		_size = static_cast<uint64_t>(fileInfo.st_size);
+
+		void* const mapped = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+		if (mapped == MAP_FAILED)
+		{
+			closeFile();
+			throw IOException("Failed to memory map binary snapshot file '" + fileName + "'");
+		}
+		_data = static_cast<char const*>(mapped);
+#endif
+
+		// Validate header
+		if ((_size < bin::headerSize) || (std::memcmp(_data, bin::fileMagic, sizeof(bin::fileMagic)) != 0))
+		{
+			closeFile();
+			throw IOException("File '" + fileName + "' is not a binary snapshot file");
+		}
+		if (u64(8) != bin::fileVersion)
+		{
+			closeFile();
+			throw IOException("Binary snapshot file '" + fileName + "' has unsupported version");
+		}
+		if (u64(24) != _size)
+		{
+			closeFile();
+			throw IOException("Binary snapshot file '" + fileName + "' is truncated");
+		}
+
+		_root = u64(16);
+		_groupStack.assign(1, _root);
+	}
+	inline void openFile(const char* fileName, const std::string& mode = "r") { openFile(std::string(fileName), mode); }
+
+	/// \brief Unmaps and closes the snapshot file
+	inline void closeFile() CADET_NOEXCEPT
+	{
+#ifdef _WIN32
+		if (_data)
+			UnmapViewOfFile(_data);
+		if (_mapping)
+			CloseHandle(_mapping);
+		if (_file != INVALID_HANDLE_VALUE)
+			CloseHandle(_file);
+		_mapping = NULL;
+		_file = INVALID_HANDLE_VALUE;
+#else
+		if (_data)
+			::munmap(const_cast<char*>(_data), _size);
+		if (_fd >= 0)
+			::close(_fd);
+		_fd = -1;
+#endif
+		_data = nullptr;
+		_size = 0;
+		_root = 0;
+		_groupStack.clear();
+	}
+
+	/// \brief Convenience wrapper for reading vectors
+	template <typename T>
+	std::vector<T> vector(const std::string& dataSetName);
+
+	/// \brief Convenience wrapper for reading scalars
+	template <typename T>
+	T scalar(const std::string& dataSetName, std::size_t position = 0);
+
+	/// \brief Checks if the given dataset or group exists in the current group
+	inline bool exists(const std::string& elementName) { return findChild(_groupStack.back(), elementName) != 0; }
+	inline bool exists(const char* elementName) { return exists(std::string(elementName)); }
+
+	/// \brief Checks if the given dataset is a vector
+	inline bool isVector(const std::string& elementName)
+	{
+		const uint64_t node = findChild(_groupStack.back(), elementName);
+		if ((node == 0) || (u64(node) == bin::nodeTypeGroup))
+			return false;
+		return (u64(node + 8) & bin::flagVector) != 0;
+	}
+	inline bool isVector(const char* elementName) { return isVector(std::string(elementName)); }
+
+	/// \brief Selects a group from the root of the tree
+	inline void setGroup(const std::string& groupName)
+	{
+		_groupStack.assign(1, _root);
+
+		std::size_t start = 0;
+		while (start < groupName.size())
+		{
+			const std::size_t end = groupName.find_first_of('/', start);
+			if (end != start)
+				pushGroup(groupName.substr(start, (end == std::string::npos) ? std::string::npos : end - start));
+
+			if (end == std::string::npos)
+				break;
+			start = end + 1;
+		}
+	}
+
+	/// \brief Descends into a subgroup of the current group
+	inline void pushGroup(const std::string& groupName)
+	{
+		const uint64_t node = findChild(_groupStack.back(), groupName);
+		if ((node == 0) || (u64(node) != bin::nodeTypeGroup))
+			throw IOException("Group '" + groupName + "' doesn't exist in file");
+		_groupStack.push_back(node);
+	}
+
+	/// \brief Returns to the parent group
+	inline void popGroup()
+	{
+		if (_groupStack.size() > 1)
+			_groupStack.pop_back();
+	}
+
+private:
+
+	char const* _data; //!< Pointer to the memory-mapped file content
+	uint64_t _size; //!< Size of the mapping in bytes
+	uint64_t _root; //!< Offset of the root group node
+	std::vector<uint64_t> _groupStack; //!< Stack of group node offsets leading to the current group
+
+#ifdef _WIN32
+	HANDLE _file; //!< Handle of the opened file
+	HANDLE _mapping; //!< Handle of the file mapping
+#else
+	int _fd; //!< File descriptor of the opened file
+#endif
+
+	/// \brief Reads an unaligned uint64 at the given absolute file offset
+	inline uint64_t u64(uint64_t offset) const
+	{
+		uint64_t value;
+		std::memcpy(&value, _data + offset, sizeof(uint64_t));
+		return value;
+	}
+
+	/// \brief Reads a length-prefixed string record at the given absolute file offset
+	inline std::string stringAt(uint64_t offset) const
+	{
+		const uint64_t len = u64(offset);
+		return std::string(_data + offset + 8, len);
+	}
+
+	/// \brief Compares a length-prefixed string record with the given name
+	inline bool stringEquals(uint64_t offset, const std::string& name) const
+	{
+		const uint64_t len = u64(offset);
+		return (len == name.size()) && (std::memcmp(_data + offset + 8, name.data(), len) == 0);
+	}
+
+	/**
+	 * @brief Looks up a child of a group node by name
+	 * @return Absolute offset of the child node or @c 0 if it does not exist
+	 */
+	inline uint64_t findChild(uint64_t groupNode, const std::string& name) const
+	{
+		if (!_data || (u64(groupNode) != bin::nodeTypeGroup))
+			return 0;
+
+		const uint64_t numChildren = u64(groupNode + 8);
+		for (uint64_t i = 0; i < numChildren; ++i)
+		{
+			const uint64_t entry = groupNode + 16 + 16 * i;
+			if (stringEquals(u64(entry), name))
+				return u64(entry + 8);
+		}
+		return 0;
+	}
+
+	/**
+	 * @brief Locates a dataset in the current group and checks its type
+	 * @return Absolute offset of the dataset node
+	 */
+	inline uint64_t dataSet(const std::string& name, uint64_t expectedType) const
+	{
+		const uint64_t node = findChild(_groupStack.back(), name);
+		if (node == 0)
+			throw IOException("Field '" + name + "' doesn't exist in group");
+		if (u64(node) == bin::nodeTypeGroup)
+			throw IOException("Field '" + name + "' is a group, not a dataset");
+		if (u64(node) != expectedType)
+			throw IOException("Field '" + name + "' has the wrong datatype");
+		return node;
+	}
+};
+
+
+// ============================================================================================================
+//   Template specializations of member functions for different data types
+// ============================================================================================================
+
+template <>
+inline std::vector<double> BinaryReader::vector<double>(const std::string& dataSetName)
+{
+	const uint64_t node = dataSet(dataSetName, bin::nodeTypeDouble);
+	const uint64_t n = u64(node + 16);
+	std::vector<double> values(n);
+	std::memcpy(values.data(), _data + node + 24, n * sizeof(double));
+	return values;
+}
+
+template <>
+inline std::vector<int> BinaryReader::vector<int>(const std::string& dataSetName)
+{
+	const uint64_t node = dataSet(dataSetName, bin::nodeTypeInt);
+	const uint64_t n = u64(node + 16);
+	std::vector<int> values(n);
+	for (uint64_t i = 0; i < n; ++i)
+	{
+		int64_t raw;
+		std::memcpy(&raw, _data + node + 24 + 8 * i, sizeof(int64_t));
+		values[i] = static_cast<int>(raw);
+	}
+	return values;
+}
+
+template <>
+inline std::vector<uint64_t> BinaryReader::vector<uint64_t>(const std::string& dataSetName)
+{
+	const uint64_t node = dataSet(dataSetName, bin::nodeTypeUint64);
+	const uint64_t n = u64(node + 16);
+	std::vector<uint64_t> values(n);
+	std::memcpy(values.data(), _data + node + 24, n * sizeof(uint64_t));
+	return values;
+}
+
+template <>
+inline std::vector<std::string> BinaryReader::vector<std::string>(const std::string& dataSetName)
+{
+	const uint64_t node = dataSet(dataSetName, bin::nodeTypeString);
+	const uint64_t n = u64(node + 16);
+	std::vector<std::string> values;
+	values.reserve(n);
+
+	uint64_t offset = node + 24;
+	for (uint64_t i = 0; i < n; ++i)
+	{
+		values.push_back(stringAt(offset));
+		offset += 8 + bin::alignTo8(u64(offset));
+	}
+	return values;
+}
+
+template <typename T>
+T BinaryReader::scalar(const std::string& dataSetName, std::size_t position)
+{
+	return vector<T>(dataSetName).at(position);
+}
+
+}  // namespace io
+
+}  // namespace cadet
+
+#endif  // LIBCADET_BINARYREADER_HPP_
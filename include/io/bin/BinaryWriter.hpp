@@ -0,0 +1,362 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a writer for the flat binary snapshot format (see BinaryFormat.hpp).
+ */
+
+#ifndef LIBCADET_BINARYWRITER_HPP_
+#define LIBCADET_BINARYWRITER_HPP_
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+
+#include "cadet/cadetCompilerInfo.hpp"
+#include "io/IOException.hpp"
+#include "io/bin/BinaryFormat.hpp"
+
+namespace cadet
+{
+
+namespace io
+{
+
+/**
+ * @brief Writes a parameter tree to a flat binary snapshot file
+ * @details The tree is collected in memory by scalar(), vector(), and the group functions
+ *          and serialized to disk when the file is closed. The resulting snapshot can be
+ *          memory mapped and navigated in place by BinaryReader, which avoids the parsing
+ *          and library overhead of the full featured file formats on repeated runs.
+ */
+class BinaryWriter
+{
+public:
+	/// \brief Constructor
+	BinaryWriter() : _root(bin::nodeTypeGroup), _groupStack(1, &_root), _fileName(), _opened(false) { }
+
+	/// \brief Destructor
+	~BinaryWriter() CADET_NOEXCEPT
+	{
+		// Do not write unfinished snapshots on destruction; closeFile() has to be called explicitly
+	}
+
+	/// \brief Opens a snapshot file for writing, the content is written on closeFile()
+	inline void openFile(const std::string& fileName, const std::string& mode = "c")
+	{
+		if (mode == "r")
+			throw IOException("Binary snapshot files cannot be opened for writing in read-only mode");
+
+		_fileName = fileName;
+		_opened = true;
+	}
+	inline void openFile(const char* fileName, const std::string& mode = "c") { openFile(std::string(fileName), mode); }
+
+	/// \brief Serializes the collected tree and closes the file
+	inline void closeFile()
+	{
+		if (!_opened)
+			return;
+
+		std::vector<char> buffer;
+		const uint64_t rootOffset = serializeNode(_root, buffer);
+
+		std::ofstream file(_fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file)
+			throw IOException("Failed to open binary snapshot file '" + _fileName + "' for writing");
+
+		// Write header followed by all node records
+		const uint64_t fileSize = bin::headerSize + buffer.size();
+		file.write(bin::fileMagic, sizeof(bin::fileMagic));
+		writeU64(file, bin::fileVersion);
+		writeU64(file, rootOffset);
+		writeU64(file, fileSize);
+		file.write(buffer.data(), buffer.size());
+
+		if (!file)
+			throw IOException("Failed to write binary snapshot file '" + _fileName + "'");
+
+		_opened = false;
+	}
+
+	/// \brief Writes a scalar dataset in the current group
+	template <typename T>
+	void scalar(const std::string& dataSetName, const T& value);
+
+	/// \brief Writes a vector dataset in the current group
+	template <typename T>
+	void vector(const std::string& dataSetName, const std::vector<T>& values);
+
+	/// \brief Selects a group from the root of the tree, creating it if necessary
+	inline void setGroup(const std::string& groupName)
+	{
+		_groupStack.resize(1);
+
+		std::size_t start = 0;
+		while (start < groupName.size())
+		{
+			const std::size_t end = groupName.find_first_of('/', start);
+			if (end != start)
+				pushGroup(groupName.substr(start, (end == std::string::npos) ? std::string::npos : end - start));
+
+			if (end == std::string::npos)
+				break;
+			start = end + 1;
+		}
+	}
+
+	/// \brief Descends into a subgroup of the current group, creating it if necessary
+	inline void pushGroup(const std::string& groupName)
+	{
+		Element* child = _groupStack.back()->findChild(groupName);
+		if (!child)
+		{
+			child = new Element(bin::nodeTypeGroup);
+			_groupStack.back()->children.push_back(std::make_pair(groupName, child));
+		}
+		else if (child->type != bin::nodeTypeGroup)
+			throw IOException("Dataset '" + groupName + "' cannot be opened as group");
+
+		_groupStack.push_back(child);
+	}
+
+	/// \brief Returns to the parent group
+	inline void popGroup()
+	{
+		if (_groupStack.size() > 1)
+			_groupStack.pop_back();
+	}
+
+private:
+
+	/**
+	 * @brief Node of the in-memory tree collected before serialization
+	 */
+	struct Element
+	{
+		uint64_t type;
+		uint64_t flags;
+
+		std::vector<double> floatData;
+		std::vector<int64_t> intData;
+		std::vector<uint64_t> uintData;
+		std::vector<std::string> stringData;
+
+		std::vector<std::pair<std::string, Element*>> children;
+
+		Element(uint64_t t) : type(t), flags(0) { }
+		~Element() CADET_NOEXCEPT
+		{
+			for (std::size_t i = 0; i < children.size(); ++i)
+				delete children[i].second;
+		}
+
+		Element* findChild(const std::string& name)
+		{
+			for (std::size_t i = 0; i < children.size(); ++i)
+			{
+				if (children[i].first == name)
+					return children[i].second;
+			}
+			return nullptr;
+		}
+
+	private:
+		Element(const Element&);
+		Element& operator=(const Element&);
+	};
+
+	Element _root; //!< Root group of the tree
+	std::vector<Element*> _groupStack; //!< Stack of groups leading to the currently selected group
+	std::string _fileName; //!< Name of the snapshot file written on closeFile()
+	bool _opened; //!< Determines whether a file name has been set and the tree is pending serialization
+
+	/**
+	 * @brief Creates (or resets) a dataset in the current group
+	 */
+	inline Element& dataSet(const std::string& name, uint64_t type, bool isVector)
+	{
+		Element* child = _groupStack.back()->findChild(name);
+		if (!child)
+		{
+			child = new Element(type);
+			_groupStack.back()->children.push_back(std::make_pair(name, child));
+		}
+		else if (child->type == bin::nodeTypeGroup)
+			throw IOException("Group '" + name + "' cannot be overwritten by a dataset");
+
+		child->type = type;
+		child->flags = isVector ? bin::flagVector : 0;
+		child->floatData.clear();
+		child->intData.clear();
+		child->uintData.clear();
+		child->stringData.clear();
+		return *child;
+	}
+
+	static inline void writeU64(std::ofstream& file, uint64_t value)
+	{
+		file.write(reinterpret_cast<char const*>(&value), sizeof(uint64_t));
+	}
+
+	static inline uint64_t position(const std::vector<char>& buffer)
+	{
+		return bin::headerSize + buffer.size();
+	}
+
+	static inline void appendU64(std::vector<char>& buffer, uint64_t value)
+	{
+		char const* const raw = reinterpret_cast<char const*>(&value);
+		buffer.insert(buffer.end(), raw, raw + sizeof(uint64_t));
+	}
+
+	static inline void appendBytes(std::vector<char>& buffer, void const* data, std::size_t size)
+	{
+		char const* const raw = reinterpret_cast<char const*>(data);
+		buffer.insert(buffer.end(), raw, raw + size);
+		// Pad to 8 byte alignment
+		buffer.resize(buffer.size() + (bin::alignTo8(size) - size), 0);
+	}
+
+	static inline uint64_t appendString(std::vector<char>& buffer, const std::string& str)
+	{
+		const uint64_t off = position(buffer);
+		appendU64(buffer, str.size());
+		appendBytes(buffer, str.data(), str.size());
+		return off;
+	}
+
+	/**
+	 * @brief Serializes a node (and, for groups, its subtree) into the buffer
+	 * @return Absolute file offset of the node record
+	 */
+	static uint64_t serializeNode(const Element& elem, std::vector<char>& buffer)
+	{
+		if (elem.type == bin::nodeTypeGroup)
+		{
+			// Children are emitted before the group record so that all offsets are known
+			std::vector<std::pair<uint64_t, uint64_t>> refs;
+			refs.reserve(elem.children.size());
+			for (std::size_t i = 0; i < elem.children.size(); ++i)
+			{
+				const uint64_t nodeOff = serializeNode(*elem.children[i].second, buffer);
+				const uint64_t nameOff = appendString(buffer, elem.children[i].first);
+				refs.push_back(std::make_pair(nameOff, nodeOff));
+			}
+
+			const uint64_t off = position(buffer);
+			appendU64(buffer, bin::nodeTypeGroup);
+			appendU64(buffer, refs.size());
+			for (std::size_t i = 0; i < refs.size(); ++i)
+			{
+				appendU64(buffer, refs[i].first);
+				appendU64(buffer, refs[i].second);
+			}
+			return off;
+		}
+
+		const uint64_t off = position(buffer);
+		appendU64(buffer, elem.type);
+		appendU64(buffer, elem.flags);
+		switch (elem.type)
+		{
+			case bin::nodeTypeDouble:
+				appendU64(buffer, elem.floatData.size());
+				appendBytes(buffer, elem.floatData.data(), elem.floatData.size() * sizeof(double));
+				break;
+			case bin::nodeTypeInt:
+				appendU64(buffer, elem.intData.size());
+				appendBytes(buffer, elem.intData.data(), elem.intData.size() * sizeof(int64_t));
+				break;
+			case bin::nodeTypeUint64:
+				appendU64(buffer, elem.uintData.size());
+				appendBytes(buffer, elem.uintData.data(), elem.uintData.size() * sizeof(uint64_t));
+				break;
+			case bin::nodeTypeString:
+				appendU64(buffer, elem.stringData.size());
+				for (std::size_t i = 0; i < elem.stringData.size(); ++i)
+					appendString(buffer, elem.stringData[i]);
+				break;
+		}
+		return off;
+	}
+};
+
+
+// ============================================================================================================
+//   Template specializations of member functions for different data types
+// ============================================================================================================
+
+template <>
+inline void BinaryWriter::scalar<double>(const std::string& dataSetName, const double& value)
+{
+	dataSet(dataSetName, bin::nodeTypeDouble, false).floatData.assign(1, value);
+}
+
+template <>
+inline void BinaryWriter::scalar<int>(const std::string& dataSetName, const int& value)
+{
+	dataSet(dataSetName, bin::nodeTypeInt, false).intData.assign(1, value);
+}
+
+template <>
+inline void BinaryWriter::scalar<uint64_t>(const std::string& dataSetName, const uint64_t& value)
+{
+	dataSet(dataSetName, bin::nodeTypeUint64, false).uintData.assign(1, value);
+}
+
+template <>
+inline void BinaryWriter::scalar<bool>(const std::string& dataSetName, const bool& value)
+{
+	dataSet(dataSetName, bin::nodeTypeInt, false).intData.assign(1, value ? 1 : 0);
+}
+
+template <>
+inline void BinaryWriter::scalar<std::string>(const std::string& dataSetName, const std::string& value)
+{
+	dataSet(dataSetName, bin::nodeTypeString, false).stringData.assign(1, value);
+}
+
+template <>
+inline void BinaryWriter::vector<double>(const std::string& dataSetName, const std::vector<double>& values)
+{
+	dataSet(dataSetName, bin::nodeTypeDouble, true).floatData = values;
+}
+
+template <>
+inline void BinaryWriter::vector<int>(const std::string& dataSetName, const std::vector<int>& values)
+{
+	Element& elem = dataSet(dataSetName, bin::nodeTypeInt, true);
+	elem.intData.assign(values.begin(), values.end());
+}
+
+template <>
+inline void BinaryWriter::vector<uint64_t>(const std::string& dataSetName, const std::vector<uint64_t>& values)
+{
+	dataSet(dataSetName, bin::nodeTypeUint64, true).uintData = values;
+}
+
+template <>
+inline void BinaryWriter::vector<std::string>(const std::string& dataSetName, const std::vector<std::string>& values)
+{
+	dataSet(dataSetName, bin::nodeTypeString, true).stringData = values;
+}
+
+}  // namespace io
+
+}  // namespace cadet
+
+#endif  // LIBCADET_BINARYWRITER_HPP_
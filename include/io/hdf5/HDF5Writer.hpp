@@ -16,6 +16,7 @@
 #include <vector>
 #include <string>
 #include <cstring>
+#include <algorithm>
 
 #include "cadet/cadetCompilerInfo.hpp"
 #include "common/CompilerSpecific.hpp"
@@ -72,6 +73,23 @@ public:
 	template <typename T>
 	void scalar(const std::string& dataSetName, const T buffer);
 
+	/// \brief Appends data along the leading dimension of an extendible dataset,
+	///        creating the dataset (maxsize = unlimited, chunked layout) on the first call
+	template <typename T>
+	void append(const std::string& dataSetName, const size_t rank, const size_t* dims, const T* buffer, const size_t stride = 1);
+
+	/// \brief Convenience wrapper for appending tensor chunks from C-array
+	template <typename T>
+	void appendTensor(const std::string& dataSetName, const size_t rank, const size_t* dims, const T* buffer, const size_t stride = 1);
+
+	/// \brief Convenience wrapper for appending matrix rows from C-array
+	template <typename T>
+	void appendMatrix(const std::string& dataSetName, const size_t rows, const size_t cols, const T* buffer, const size_t stride = 1);
+
+	/// \brief Convenience wrapper for appending vector elements from C-array
+	template <typename T>
+	void appendVector(const std::string& dataSetName, const size_t length, const T* buffer, const size_t stride = 1);
+
 	/// \brief Removes an existing group from the file
 	inline void unlinkGroup(const std::string& groupName);
 
@@ -81,6 +99,9 @@ public:
 	/// \brief Enable/disable compression for tensors of 2nd order and above
 	inline void compressFields(bool setCompression) {_writeCompressed = setCompression;}
 
+	/// \brief Sets the deflate level (0-9) applied to compressed fields, where 0 disables compression
+	inline void compressionLevel(int level) {_compressionLevel = std::max(0, std::min(9, level));}
+
 	/// \brief Tensors of 2nd order (matrices) and above are written as extendible fields
 	///        (maxsize = unlimited, chunked layout), when set to true.
 	inline void extendibleFields(bool setExtendible) {_writeExtendible = setExtendible;}
@@ -89,12 +110,16 @@ private:
 
 	void writeWork(const std::string& dataSetName, hid_t memType, hid_t fileType, const size_t rank, const size_t* dims, const void* buffer, const size_t stride);
 
+	void appendWork(const std::string& dataSetName, hid_t memType, hid_t fileType, const size_t rank, const size_t* dims, const void* buffer, const size_t stride);
+
 	bool                    _writeScalar;
 	bool                    _writeExtendible;
 	bool                    _writeCompressed;
+	int                     _compressionLevel;
 	hsize_t*                _maxDims;
 	hsize_t*                _chunks;
 	double                  _chunkFactor;
+	hsize_t                 _maxChunkElems;
 };
 
 
@@ -102,9 +127,11 @@ HDF5Writer::HDF5Writer() :
 		_writeScalar(false),
 		_writeExtendible(true),
 		_writeCompressed(false),
+		_compressionLevel(9),
 		_maxDims(NULL),
 		_chunks(NULL),
-		_chunkFactor(1.5)
+		_chunkFactor(1.5),
+		_maxChunkElems(128 * 1024)
 {}
 
 HDF5Writer::~HDF5Writer() CADET_NOEXCEPT { }
@@ -176,6 +203,30 @@ void HDF5Writer::write(const std::string& dataSetName, const size_t rank, const
 // ============================================================================================================
 
 
+// ============================================================================================================
+//   Template specializations of member function append() for different data types
+// ============================================================================================================
+template <>
+void HDF5Writer::append<double>(const std::string& dataSetName, const size_t rank, const size_t* dims, const double* buffer, const size_t stride)
+{
+	appendWork(dataSetName, H5T_NATIVE_DOUBLE, H5T_IEEE_F64LE, rank, dims, buffer, stride);
+}
+
+template <>
+void HDF5Writer::append<int>(const std::string& dataSetName, const size_t rank, const size_t* dims, const int* buffer, const size_t stride)
+{
+	appendWork(dataSetName, H5T_NATIVE_INT, H5T_STD_I32LE, rank, dims, buffer, stride);
+}
+
+// Template that matches on every unsupported type and throws an exception
+template <typename T>
+void HDF5Writer::append(const std::string& dataSetName, const size_t rank, const size_t* dims, const T* buffer, const size_t stride)
+{
+	throw IOException("You may not try to append an unsupported type");
+}
+// ============================================================================================================
+
+
 // ============================================================================================================
 //   Convenience wrappers
 // ============================================================================================================
@@ -231,6 +282,25 @@ void HDF5Writer::scalar(const std::string& dataSetName, const T buffer)
 	_writeScalar = true;
 	vector<T>(dataSetName, 1, &buffer);
 }
+
+template <typename T>
+void HDF5Writer::appendTensor(const std::string& dataSetName, const size_t rank, const size_t* dims, const T* buffer, const size_t stride)
+{
+	append<T>(dataSetName, rank, dims, buffer, stride);
+}
+
+template <typename T>
+void HDF5Writer::appendMatrix(const std::string& dataSetName, const size_t rows, const size_t cols, const T* buffer, const size_t stride)
+{
+	size_t dims[2] = {rows, cols};
+	append<T>(dataSetName, 2, dims, buffer, stride);
+}
+
+template <typename T>
+void HDF5Writer::appendVector(const std::string& dataSetName, const size_t length, const T* buffer, const size_t stride)
+{
+	append<T>(dataSetName, 1, &length, buffer, stride);
+}
 // ============================================================================================================
 
 
@@ -266,6 +336,15 @@ void HDF5Writer::writeWork(const std::string& dataSetName, hid_t memType, hid_t
 			for (size_t i = 0; i < rank; ++i)
 				_chunks[i] = (_writeExtendible) ? static_cast<hsize_t>(dims[i] * _chunkFactor) : dims[i]; // leave some space in all dims, if extendible
 
+			// Split large datasets along the leading dimension so that the filter
+			// pipeline and partial I/O operate on reasonably sized chunks instead
+			// of one monolithic chunk spanning the whole dataset
+			hsize_t rowElems = 1;
+			for (size_t i = 1; i < rank; ++i)
+				rowElems *= _chunks[i];
+			if ((rowElems > 0) && (_chunks[0] * rowElems > _maxChunkElems))
+				_chunks[0] = std::max<hsize_t>(1, _maxChunkElems / rowElems);
+
 			H5Pset_chunk(propList, rank, _chunks);
 			delete[] _chunks;
 		}
@@ -292,8 +371,13 @@ void HDF5Writer::writeWork(const std::string& dataSetName, hid_t memType, hid_t
 		delete[] convDims;
 		delete[] _maxDims;
 
-		if (_writeCompressed) // enable compression
-			H5Pset_deflate(propList, 9);
+		if (_writeCompressed && (_compressionLevel > 0)) // enable compression
+		{
+			// Byte-shuffling regroups the bytes of the floating point values and considerably
+			// improves the deflate ratio on solution data at negligible runtime cost
+			H5Pset_shuffle(propList);
+			H5Pset_deflate(propList, _compressionLevel);
+		}
 	}
 	else // reset _writeScalar
 	{
@@ -332,6 +416,84 @@ void HDF5Writer::writeWork(const std::string& dataSetName, hid_t memType, hid_t
 	H5Pclose(propList);
 }
 
+
+void HDF5Writer::appendWork(const std::string& dataSetName, hid_t memType, hid_t fileType, const size_t rank, const size_t* dims, const void* buffer, const size_t stride)
+{
+	openGroup(true);
+	const htri_t dsExists = H5Lexists(_groupsOpened.top(), dataSetName.c_str(), H5P_DEFAULT);
+	if (dsExists <= 0)
+	{
+		closeGroup();
+
+		// First chunk: create the dataset as extendible field (maxsize = unlimited, chunked layout)
+		const bool wasExtendible = _writeExtendible;
+		_writeExtendible = true;
+		writeWork(dataSetName, memType, fileType, rank, dims, buffer, stride);
+		_writeExtendible = wasExtendible;
+		return;
+	}
+
+	const hid_t dataSet = H5Dopen2(_groupsOpened.top(), dataSetName.c_str(), H5P_DEFAULT);
+	closeGroup();
+
+	// Grow the dataset along its leading dimension
+	hid_t fileSpace = H5Dget_space(dataSet);
+	const int fileRank = H5Sget_simple_extent_ndims(fileSpace);
+	hsize_t* const curDims = new hsize_t[fileRank];
+	H5Sget_simple_extent_dims(fileSpace, curDims, NULL);
+	H5Sclose(fileSpace);
+
+	hsize_t* const newDims = new hsize_t[fileRank];
+	for (int i = 0; i < fileRank; ++i)
+		newDims[i] = curDims[i];
+	newDims[0] += dims[0];
+	H5Dset_extent(dataSet, newDims);
+
+	// Select the appended hyperslab of the grown dataset
+	fileSpace = H5Dget_space(dataSet);
+	hsize_t* const start = new hsize_t[fileRank];
+	hsize_t* const count = new hsize_t[fileRank];
+	start[0] = curDims[0];
+	count[0] = dims[0];
+	for (int i = 1; i < fileRank; ++i)
+	{
+		start[i] = 0;
+		count[i] = dims[i];
+	}
+	H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, NULL, count, NULL);
+
+	delete[] count;
+	delete[] start;
+	delete[] newDims;
+	delete[] curDims;
+
+	hsize_t numElem = 1;
+	for (size_t i = 0; i < rank; ++i)
+		numElem *= dims[i];
+
+	// Create (strided) memory data space for the buffered chunk
+	hid_t memSpace;
+	if (stride <= 1)
+		memSpace = H5Screate_simple(1, &numElem, NULL);
+	else
+	{
+		const hsize_t clampedStride = stride;
+
+		// We need the actual array size (not just the number of elements to be written)
+		const hsize_t spaceExtent = numElem * clampedStride;
+		memSpace = H5Screate_simple(1, &spaceExtent, NULL);
+
+		const hsize_t memStart = 0;
+		H5Sselect_hyperslab(memSpace, H5S_SELECT_SET, &memStart, &clampedStride, &numElem, NULL);
+	}
+
+	H5Dwrite(dataSet, memType, memSpace, fileSpace, H5P_DEFAULT, buffer);
+
+	H5Sclose(memSpace);
+	H5Sclose(fileSpace);
+	H5Dclose(dataSet);
+}
+
 }  // namespace io
 }  // namespace cadet
 
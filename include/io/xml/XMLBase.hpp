@@ -92,6 +92,7 @@ protected:
 	xpath_node               _groupOpened;      //!< Holds the group that is currently opened
 	std::stack<std::string>  _groupExists;      //!< Stack holding the last successfully opened group
 	std::vector<std::string> _groupNames;       //!< Vector of group names for the currently selected group
+	bool                     _groupDirty;       //!< Determines whether _groupOpened has to be resolved again
 
 	void openGroup(bool forceCreation = false);
 	void closeGroup();
@@ -126,7 +127,8 @@ const std::string XMLBase::_typeBool   = "bool";
 
 
 XMLBase::XMLBase() :
-	_enable_write(false)
+	_enable_write(false),
+	_groupDirty(true)
 {}
 
 XMLBase::~XMLBase() CADET_NOEXCEPT
@@ -165,6 +167,7 @@ void XMLBase::openFile(const std::string& fileName, const std::string& mode)
 
 	findOrCreateRootNode();
 	_fileName = fileName;
+	_groupDirty = true;
 }
 
 
@@ -220,6 +223,7 @@ bool XMLBase::isVector(const char* elementName)
 void XMLBase::setGroup(const std::string& groupName)
 {
 	_groupNames.clear();
+	_groupDirty = true;
 
 	size_t start   = 0;
 	size_t end     = 0;
@@ -248,17 +252,24 @@ void XMLBase::setGroup(const std::string& groupName)
 void XMLBase::pushGroup(const std::string& groupName)
 {
 	_groupNames.push_back(groupName);
+	_groupDirty = true;
 }
 
 
 void XMLBase::popGroup()
 {
 	_groupNames.pop_back();
+	_groupDirty = true;
 }
 
 
 void XMLBase::openGroup(bool forceCreation)
 {
+	// Reuse the previously resolved group node if the selection has not changed
+	// since group lookups run a full XPath query over the document
+	if (!_groupDirty && _groupOpened)
+		return;
+
 	// Clear existent group cache
 	while (_groupExists.size() > 0)  _groupExists.pop();
 
@@ -275,6 +286,7 @@ void XMLBase::openGroup(bool forceCreation)
 	{
 		// Select root node
 		_groupOpened = _root.select_single_node(("/" + _nodeRoot).c_str());
+		_groupDirty = false;
 		return;
 	}
 
@@ -315,6 +327,8 @@ void XMLBase::openGroup(bool forceCreation)
 		else
 			throw IOException("Group was not opened/created! Either not existent, creation not forced or file not opened in write mode");
 	}
+
+	_groupDirty = false;
 }
 
 
@@ -133,20 +133,26 @@ std::vector<T> XMLReader::read(const std::string& dataSetName)
 	}
 	delete [] dims;
 
-	// Split data and convert to right type
-	std::vector<std::string> data_vec = split(data_str, _textSeparator.c_str());
-	if (bufSize != data_vec.size())
+	// Tokenize and convert the text in a single pass, reusing one conversion stream
+	// instead of splitting the whole text into a separate string per element first
+	std::vector<T> data(bufSize);
+	std::istringstream tokens(data_str);
+	std::istringstream conv;
+	std::string item;
+	size_t numRead = 0;
+	while ((numRead < bufSize) && std::getline(tokens, item, _textSeparator[0]))
 	{
-		std::ostringstream oss;
-		oss << "XML file is inconsistent: Possibly wrong no. of entrys in dataset '" << dataset.attribute(_attrName.c_str()).value() << "'";
-		throw IOException(oss.str());
+		conv.clear();
+		conv.str(item);
+		conv >> data[numRead];
+		++numRead;
 	}
 
-	std::vector<T> data(bufSize);
-	for (size_t i = 0; i < bufSize; ++i)
+	if ((numRead != bufSize) || std::getline(tokens, item, _textSeparator[0]))
 	{
-		std::stringstream ss(data_vec[i]);
-		ss >> data[i];
+		std::ostringstream oss;
+		oss << "XML file is inconsistent: Possibly wrong no. of entrys in dataset '" << dataset.attribute(_attrName.c_str()).value() << "'";
+		throw IOException(oss.str());
 	}
 
 	closeGroup();
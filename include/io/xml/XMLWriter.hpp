@@ -85,6 +85,10 @@ public:
 	///        Set the level of compression used for tensors of 2nd order and above
 	inline void compressFields(bool setCompression) {}
 
+	/// \brief This functionality is not supported by XML - this is a stub.
+	///        Sets the compression level applied to compressed fields
+	inline void compressionLevel(int level) {}
+
 	/// \brief This functionality is not supported by XML - this is a stub.
 	///        Tensors of 2nd order (vectors) and above are written as extendible fields
 	///        (maxsize = unlimited, chunked layout), when set to true.
@@ -15,6 +15,10 @@
 #include "io/hdf5/HDF5Writer.hpp"
 #include "io/xml/XMLReader.hpp"
 #include "io/xml/XMLWriter.hpp"
+#include "io/bin/BinaryReader.hpp"
+#include "io/bin/BinaryWriter.hpp"
+
+#include <json.hpp>
 
 #include <tclap/CmdLine.h>
 #include "common/TclapUtils.hpp"
@@ -24,19 +28,36 @@
 #include "common/CompilerSpecific.hpp"
 #include "common/ParameterProviderImpl.hpp"
 #include "common/Driver.hpp"
-
-#ifdef CADET_BENCHMARK_MODE
-	#include "common/Timer.hpp"
-#endif
+#include "common/Timer.hpp"
 
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <string>
+#include <vector>
 #include <cctype>
+#include <unordered_map>
+#include <thread>
+#include <future>
+#include <system_error>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	#define CADET_CLI_SHM
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
 
 #ifndef CADET_LOGGING_DISABLE
 	template <>
-	cadet::LogLevel cadet::log::RuntimeFilteringLogger<cadet::log::GlobalLogger>::_minLvl = cadet::LogLevel::Trace;
+	std::atomic<cadet::LogLevel> cadet::log::RuntimeFilteringLogger<cadet::log::GlobalLogger>::_minLvl(cadet::LogLevel::Trace);
 #endif
 
 namespace
@@ -109,6 +130,633 @@ namespace TCLAP
 	}
 }
 
+namespace
+{
+	/**
+	 * @brief State of the recursive HDF5 to binary snapshot conversion
+	 */
+	struct SnapshotConversionContext
+	{
+		cadet::io::HDF5Reader& reader;
+		cadet::io::BinaryWriter& writer;
+		std::string path;
+		std::string error;
+	};
+
+	herr_t convertSnapshotNode(hid_t loc, const char* name, const H5L_info_t* info, void* opData);
+
+	inline herr_t convertSnapshotChildren(hid_t grp, SnapshotConversionContext& ctx)
+	{
+		return H5Literate(grp, H5_INDEX_NAME, H5_ITER_INC, NULL, &convertSnapshotNode, &ctx);
+	}
+
+	/**
+	 * @brief Copies a single HDF5 node (group or dataset) into the snapshot being written
+	 * @details Groups are entered recursively, datasets are read via HDF5Reader and handed
+	 *          to the BinaryWriter. Exceptions are captured in the context since this is
+	 *          called from the HDF5 C library.
+	 */
+	herr_t convertSnapshotNode(hid_t loc, const char* name, const H5L_info_t*, void* opData)
+	{
+		SnapshotConversionContext& ctx = *static_cast<SnapshotConversionContext*>(opData);
+
+		H5O_info_t objInfo;
+		if (H5Oget_info_by_name(loc, name, &objInfo, H5P_DEFAULT) < 0)
+			return -1;
+
+		if (objInfo.type == H5O_TYPE_GROUP)
+		{
+			const std::string parentPath = ctx.path;
+			ctx.path = parentPath + "/" + name;
+			ctx.writer.pushGroup(name);
+
+			const hid_t grp = H5Gopen2(loc, name, H5P_DEFAULT);
+			if (grp < 0)
+				return -1;
+			const herr_t status = convertSnapshotChildren(grp, ctx);
+			H5Gclose(grp);
+
+			ctx.writer.popGroup();
+			ctx.path = parentPath;
+			return status;
+		}
+
+		if (objInfo.type != H5O_TYPE_DATASET)
+			return 0;
+
+		// Classify the element type of the dataset
+		const hid_t dset = H5Dopen2(loc, name, H5P_DEFAULT);
+		if (dset < 0)
+			return -1;
+		const hid_t dtype = H5Dget_type(dset);
+		const H5T_class_t typeClass = H5Tget_class(dtype);
+		const bool isUnsigned64 = (typeClass == H5T_INTEGER) && (H5Tget_sign(dtype) == H5T_SGN_NONE) && (H5Tget_size(dtype) == 8);
+		H5Tclose(dtype);
+		H5Dclose(dset);
+
+		try
+		{
+			ctx.reader.setGroup(ctx.path);
+			const bool isVec = ctx.reader.isVector(name);
+
+			switch (typeClass)
+			{
+				case H5T_FLOAT:
+					if (isVec)
+						ctx.writer.vector<double>(name, ctx.reader.vector<double>(name));
+					else
+						ctx.writer.scalar<double>(name, ctx.reader.scalar<double>(name));
+					break;
+				case H5T_INTEGER:
+					if (isUnsigned64)
+					{
+						if (isVec)
+							ctx.writer.vector<uint64_t>(name, ctx.reader.vector<uint64_t>(name));
+						else
+							ctx.writer.scalar<uint64_t>(name, ctx.reader.scalar<uint64_t>(name));
+					}
+					else
+					{
+						if (isVec)
+							ctx.writer.vector<int>(name, ctx.reader.vector<int>(name));
+						else
+							ctx.writer.scalar<int>(name, ctx.reader.scalar<int>(name));
+					}
+					break;
+				case H5T_STRING:
+					if (isVec)
+						ctx.writer.vector<std::string>(name, ctx.reader.vector<std::string>(name));
+					else
+						ctx.writer.scalar<std::string>(name, ctx.reader.scalar<std::string>(name));
+					break;
+				default:
+					ctx.error = "Dataset '" + ctx.path + "/" + name + "' has a datatype that is not supported by the binary snapshot format";
+					return -1;
+			}
+		}
+		catch (const std::exception& e)
+		{
+			ctx.error = e.what();
+			return -1;
+		}
+		return 0;
+	}
+}
+
+/**
+ * @brief Converts an HDF5 input file into a memory mappable binary snapshot
+ * @details The full parameter tree of the HDF5 file is copied into the flat binary
+ *          snapshot format. Later runs can memory map the snapshot via BinaryReader
+ *          instead of paying the HDF5 parsing overhead again, which speeds up farms
+ *          of batch workers operating on the same input.
+ */
+void convertToSnapshot(const std::string& inFileName, const std::string& outFileName)
+{
+	cadet::io::HDF5Reader rd;
+	rd.openFile(inFileName, "r");
+
+	cadet::io::BinaryWriter writer;
+	writer.openFile(outFileName, "co");
+
+	SnapshotConversionContext ctx = { rd, writer, std::string(), std::string() };
+
+	// Walk the file structure with the HDF5 C API since HDF5Reader cannot enumerate groups
+	const hid_t file = H5Fopen(inFileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+	if (file < 0)
+	{
+		rd.closeFile();
+		throw cadet::io::IOException("Failed to open HDF5 file '" + inFileName + "'");
+	}
+
+	const hid_t rootGrp = H5Gopen2(file, "/", H5P_DEFAULT);
+	const herr_t status = (rootGrp < 0) ? -1 : convertSnapshotChildren(rootGrp, ctx);
+	if (rootGrp >= 0)
+		H5Gclose(rootGrp);
+	H5Fclose(file);
+	rd.closeFile();
+
+	if (status < 0)
+		throw cadet::io::IOException(ctx.error.empty() ? ("Failed to convert HDF5 file '" + inFileName + "' to a binary snapshot") : ctx.error);
+
+	writer.closeFile();
+}
+
+/**
+ * @brief Appends the outlet trajectories of a finished run to a consolidated campaign file
+ * @details Sweep campaigns producing one output file per run are slow to open en masse in
+ *          post-processing. This collects the outlet trajectories of all runs in a single
+ *          file using extendible datasets:
+ *
+ *              /campaign/SOLUTION_TIMES           Time points of all runs, concatenated
+ *              /campaign/unit_XXX/SOLUTION_OUTLET Outlet of unit operation XXX, rows concatenated
+ *              /campaign/index/RUN_ID             Id of each run
+ *              /campaign/index/OFFSET             First row of each run in the trajectories
+ *              /campaign/index/NUM_STEPS          Number of rows of each run
+ */
+void appendToCampaign(cadet::Driver& drv, const std::string& fileName, int runId)
+{
+	cadet::InternalStorageSystemRecorder const* const storage = drv.solution();
+	if (!storage || (storage->numDataPoints() == 0))
+		throw cadet::io::IOException("No recorded solution available for campaign output");
+
+	const unsigned int numSteps = storage->numDataPoints();
+
+	// Derive row offset and run count from the index of an existing campaign file
+	int offset = 0;
+	int numRuns = 0;
+	try
+	{
+		cadet::io::HDF5Reader rd;
+		rd.openFile(fileName, "r");
+		rd.setGroup("campaign/index");
+		const std::vector<int> steps = rd.vector<int>("NUM_STEPS");
+		numRuns = static_cast<int>(steps.size());
+		for (std::size_t i = 0; i < steps.size(); ++i)
+			offset += steps[i];
+		rd.closeFile();
+	}
+	catch (const cadet::io::IOException&)
+	{
+		// File or index does not exist yet, a new campaign is started
+	}
+
+	cadet::io::HDF5Writer writer;
+	try
+	{
+		writer.openFile(fileName, "rw");
+	}
+	catch (const cadet::io::IOException&)
+	{
+		writer.openFile(fileName, "co");
+	}
+
+	writer.setGroup("campaign");
+	writer.appendVector<double>("SOLUTION_TIMES", numSteps, storage->time());
+
+	std::ostringstream oss;
+	for (unsigned int i = 0; i < storage->numRecorders(); ++i)
+	{
+		cadet::InternalStorageUnitOpRecorder const* const rec = storage->recorder(i);
+		if (!rec->solutionConfig().storeOutlet)
+			continue;
+
+		oss.str("");
+		oss << "unit_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << static_cast<int>(rec->unitOperation());
+
+		writer.pushGroup(oss.str());
+		writer.appendMatrix<double>("SOLUTION_OUTLET", numSteps, rec->numRecordedComponents(), rec->outlet());
+		writer.popGroup();
+	}
+
+	writer.pushGroup("index");
+	const int storedRunId = (runId >= 0) ? runId : numRuns;
+	const int numStepsInt = static_cast<int>(numSteps);
+	writer.appendVector<int>("RUN_ID", 1, &storedRunId);
+	writer.appendVector<int>("OFFSET", 1, &offset);
+	writer.appendVector<int>("NUM_STEPS", 1, &numStepsInt);
+	writer.popGroup();
+
+	writer.closeFile();
+}
+
+#ifdef CADET_CLI_SHM
+
+/**
+ * @brief Header of a published shared memory solution segment
+ * @details The orchestrating process polls @c ready, which is @c 0 while the segment
+ *          is being (re)written and set to @c 1 once all data below is complete.
+ *          All offsets are in bytes from the beginning of the segment.
+ */
+struct ShmSolutionHeader
+{
+	std::uint64_t magic; //!< Identifies the layout, always "CADETSHM"
+	std::uint32_t version; //!< Layout version
+	std::uint32_t ready; //!< 0 while writing, 1 when the segment is complete
+	std::uint32_t numSteps; //!< Number of recorded time steps
+	std::uint32_t numUnits; //!< Number of published unit operations
+	std::uint64_t timeOffset; //!< Offset of the time point array (numSteps doubles)
+};
+
+/**
+ * @brief Entry of the unit operation table following the header
+ */
+struct ShmUnitEntry
+{
+	std::uint32_t unitOp; //!< Unit operation id
+	std::uint32_t nComp; //!< Number of recorded outlet components
+	std::uint64_t offset; //!< Offset of the outlet matrix (numSteps x nComp doubles, time-major as in the recorder)
+};
+
+#endif
+
+/**
+ * @brief Publishes the outlet trajectories of a finished run into a named shared memory segment
+ * @details Mirrors the contiguous recorder buffers so that an orchestrating process can map
+ *          the segment and read the results without any filesystem round-trip:
+ *
+ *              ShmSolutionHeader
+ *              ShmUnitEntry[numUnits]
+ *              SOLUTION_TIMES           (numSteps doubles)
+ *              per unit: SOLUTION_OUTLET (numSteps x nComp doubles, time-major)
+ *
+ *          The segment is created (or resized) on every run and stays alive after the
+ *          process exits; removing it is left to the orchestrator (shm_unlink()).
+ * @param [in] drv Driver holding the recorded solution
+ * @param [in] shmName Name of the shared memory segment (a leading '/' is added if missing)
+ */
+void publishToShm(cadet::Driver& drv, const std::string& shmName)
+{
+#ifdef CADET_CLI_SHM
+	cadet::InternalStorageSystemRecorder const* const storage = drv.solution();
+	if (!storage || (storage->numDataPoints() == 0))
+		throw cadet::io::IOException("No recorded solution available for shared memory output");
+
+	const unsigned int numSteps = storage->numDataPoints();
+
+	// Collect the published unit operations
+	std::vector<cadet::InternalStorageUnitOpRecorder const*> recs;
+	for (unsigned int i = 0; i < storage->numRecorders(); ++i)
+	{
+		cadet::InternalStorageUnitOpRecorder const* const rec = storage->recorder(i);
+		if (rec->solutionConfig().storeOutlet)
+			recs.push_back(rec);
+	}
+
+	// Compute the layout; the data area is 8 byte aligned
+	const std::size_t tableBytes = sizeof(ShmSolutionHeader) + recs.size() * sizeof(ShmUnitEntry);
+	const std::size_t timeOffset = (tableBytes + 7) & ~static_cast<std::size_t>(7);
+	std::size_t totalBytes = timeOffset + numSteps * sizeof(double);
+
+	std::vector<std::size_t> unitOffsets(recs.size());
+	for (std::size_t i = 0; i < recs.size(); ++i)
+	{
+		unitOffsets[i] = totalBytes;
+		totalBytes += static_cast<std::size_t>(numSteps) * recs[i]->numRecordedComponents() * sizeof(double);
+	}
+
+	// POSIX requires the name to start with a slash
+	const std::string name = (shmName[0] == '/') ? shmName : ('/' + shmName);
+
+	const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+	if (fd < 0)
+		throw cadet::io::IOException("Failed to create shared memory segment '" + name + "'");
+
+	if (ftruncate(fd, static_cast<off_t>(totalBytes)) != 0)
+	{
+		close(fd);
+		throw cadet::io::IOException("Failed to resize shared memory segment '" + name + "'");
+	}
+
+	void* const mem = mmap(nullptr, totalBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mem == MAP_FAILED)
+		throw cadet::io::IOException("Failed to map shared memory segment '" + name + "'");
+
+	char* const base = static_cast<char*>(mem);
+	ShmSolutionHeader* const header = reinterpret_cast<ShmSolutionHeader*>(base);
+
+	// Mark the segment as busy before touching any data so that a polling
+	// orchestrator never observes a half-written result
+	header->ready = 0;
+	std::atomic_thread_fence(std::memory_order_release);
+
+	std::memcpy(&header->magic, "CADETSHM", 8);
+	header->version = 1;
+	header->numSteps = numSteps;
+	header->numUnits = static_cast<std::uint32_t>(recs.size());
+	header->timeOffset = timeOffset;
+
+	ShmUnitEntry* const table = reinterpret_cast<ShmUnitEntry*>(base + sizeof(ShmSolutionHeader));
+	for (std::size_t i = 0; i < recs.size(); ++i)
+	{
+		table[i].unitOp = static_cast<std::uint32_t>(recs[i]->unitOperation());
+		table[i].nComp = recs[i]->numRecordedComponents();
+		table[i].offset = unitOffsets[i];
+	}
+
+	std::memcpy(base + timeOffset, storage->time(), numSteps * sizeof(double));
+	for (std::size_t i = 0; i < recs.size(); ++i)
+		std::memcpy(base + unitOffsets[i], recs[i]->outlet(), static_cast<std::size_t>(numSteps) * recs[i]->numRecordedComponents() * sizeof(double));
+
+	// Publish: all data is in place, flip the flag the orchestrator polls
+	std::atomic_thread_fence(std::memory_order_release);
+	header->ready = 1;
+
+	munmap(mem, totalBytes);
+#else
+	throw cadet::io::IOException("Shared memory output is not supported on this platform");
+#endif
+}
+
+/**
+ * @brief Simulates a run and publishes its outlet trajectories into a shared memory segment
+ */
+template <class Reader_t>
+void runShm(const std::string& inFileName, const std::string& shmName)
+{
+	cadet::Driver drv;
+
+	{
+		Reader_t rd;
+		rd.openFile(inFileName, "r");
+
+		cadet::ParameterProviderImpl<Reader_t> pp(rd);
+		drv.configure(pp);
+
+		rd.closeFile();
+	}
+
+	drv.run();
+
+	// Flush deferred log messages, if any
+	cadet::drainLogs();
+
+	publishToShm(drv, shmName);
+}
+
+/**
+ * @brief Parameter provider that overlays per-run sweep values over a base provider
+ * @details Wraps another IParameterProvider and serves selected double valued datasets,
+ *          addressed by their absolute path (e.g., @c /input/model/unit_001/COL_DISPERSION),
+ *          from an override table instead of the underlying file. All other requests are
+ *          forwarded unchanged. This allows many sweep runs to share one loaded input file,
+ *          with only the deltas of each run kept in memory.
+ */
+class SweepOverlayProvider : public cadet::IParameterProvider
+{
+public:
+	SweepOverlayProvider(cadet::IParameterProvider& base, const std::unordered_map<std::string, std::vector<double>>& overrides)
+		: _base(base), _overrides(overrides), _path() { }
+
+	virtual ~SweepOverlayProvider() CADET_NOEXCEPT { }
+
+	virtual double getDouble(const std::string& paramName)
+	{
+		const auto it = _overrides.find(_path + "/" + paramName);
+		if (it != _overrides.end())
+			return it->second[0];
+		return _base.getDouble(paramName);
+	}
+
+	virtual std::vector<double> getDoubleArray(const std::string& paramName)
+	{
+		const auto it = _overrides.find(_path + "/" + paramName);
+		if (it != _overrides.end())
+			return it->second;
+		return _base.getDoubleArray(paramName);
+	}
+
+	virtual int getInt(const std::string& paramName) { return _base.getInt(paramName); }
+	virtual uint64_t getUint64(const std::string& paramName) { return _base.getUint64(paramName); }
+	virtual bool getBool(const std::string& paramName) { return _base.getBool(paramName); }
+	virtual std::string getString(const std::string& paramName) { return _base.getString(paramName); }
+	virtual std::vector<int> getIntArray(const std::string& paramName) { return _base.getIntArray(paramName); }
+	virtual std::vector<uint64_t> getUint64Array(const std::string& paramName) { return _base.getUint64Array(paramName); }
+	virtual std::vector<bool> getBoolArray(const std::string& paramName) { return _base.getBoolArray(paramName); }
+	virtual std::vector<std::string> getStringArray(const std::string& paramName) { return _base.getStringArray(paramName); }
+
+	virtual bool exists(const std::string& paramName)
+	{
+		if (_overrides.find(_path + "/" + paramName) != _overrides.end())
+			return true;
+		return _base.exists(paramName);
+	}
+
+	virtual bool isArray(const std::string& paramName)
+	{
+		// Overrides only change values of existing datasets, so the shape decision of the
+		// base file stands unless the dataset is introduced by the override itself
+		const auto it = _overrides.find(_path + "/" + paramName);
+		if ((it != _overrides.end()) && !_base.exists(paramName))
+			return it->second.size() > 1;
+		return _base.isArray(paramName);
+	}
+
+	virtual void pushScope(const std::string& scope)
+	{
+		_base.pushScope(scope);
+		_path += "/" + scope;
+	}
+
+	virtual void popScope()
+	{
+		_base.popScope();
+		_path.erase(_path.find_last_of('/'));
+	}
+
+protected:
+	cadet::IParameterProvider& _base;
+	const std::unordered_map<std::string, std::vector<double>>& _overrides; //!< Absolute dataset path -> replacement values
+	std::string _path; //!< Current scope path
+};
+
+/**
+ * @brief Executes a parameter sweep with an in-process worker pool
+ * @details The sweep specification is a JSON file containing the parameter deltas of every
+ *          run relative to the base input file:
+ *
+ *              {
+ *                  "NTHREADS": 4,
+ *                  "RUNS": [
+ *                      { "/input/model/unit_001/COL_DISPERSION": 5.75e-8 },
+ *                      { "/input/model/unit_001/COL_DISPERSION": [1.0e-7] }
+ *                  ]
+ *              }
+ *
+ *          Keys are absolute dataset paths, values are doubles or arrays of doubles that
+ *          replace the dataset of the base file for that run. Worker threads pull run
+ *          indices from a shared counter (idle workers immediately take over remaining
+ *          runs), each thread keeps its own reader and Driver for its whole lifetime so
+ *          repeated runs reuse the pooled model instances of the builder cache, and the
+ *          outlet trajectories of all runs are consolidated into a single campaign file
+ *          (see appendToCampaign()). File I/O of configuration and output is serialized
+ *          behind a mutex since the readers and writers are not thread safe; only the time
+ *          integration itself runs concurrently.
+ * @param [in] inFileName Name of the base input file
+ * @param [in] sweepFileName Name of the JSON sweep specification
+ * @param [in] campaignFileName Name of the consolidated campaign output file
+ * @param [in] requestedThreads Number of worker threads (@c 0 selects NTHREADS from the
+ *             specification, or the hardware concurrency if that is absent)
+ * @return @c 0 if all runs succeeded, otherwise @c 3
+ */
+template <class Reader_t>
+int runSweep(const std::string& inFileName, const std::string& sweepFileName, const std::string& campaignFileName, unsigned int requestedThreads)
+{
+	// Parse the sweep specification
+	std::ifstream ifs(sweepFileName);
+	if (!ifs)
+		throw cadet::io::IOException("Failed to open sweep file '" + sweepFileName + "'");
+
+	nlohmann::json spec;
+	ifs >> spec;
+
+	if (spec.find("RUNS") == spec.end())
+		throw cadet::io::IOException("Sweep file '" + sweepFileName + "' does not contain a RUNS array");
+
+	std::vector<std::unordered_map<std::string, std::vector<double>>> runs;
+	for (const auto& runSpec : spec["RUNS"])
+	{
+		std::unordered_map<std::string, std::vector<double>> overrides;
+		for (auto it = runSpec.begin(); it != runSpec.end(); ++it)
+		{
+			if (it.value().is_array())
+				overrides[it.key()] = it.value().get<std::vector<double>>();
+			else
+				overrides[it.key()] = std::vector<double>(1, it.value().get<double>());
+		}
+		runs.push_back(std::move(overrides));
+	}
+
+	if (runs.empty())
+		return 0;
+
+	unsigned int numThreads = requestedThreads;
+	if ((numThreads == 0) && (spec.find("NTHREADS") != spec.end()))
+		numThreads = spec["NTHREADS"].get<unsigned int>();
+	if (numThreads == 0)
+		numThreads = std::max(1u, std::thread::hardware_concurrency());
+	numThreads = std::min(numThreads, static_cast<unsigned int>(runs.size()));
+
+	std::atomic<unsigned int> nextRun(0);
+	std::mutex ioMutex;
+	std::vector<std::string> errors(runs.size());
+
+	const auto worker = [&]()
+	{
+		// Reader, parameter provider, and driver live for all runs of this worker: the
+		// input file is parsed once, and the builder cache of the driver hands the pooled
+		// model instances of the previous run to the next configure()
+		Reader_t rd;
+		cadet::Driver drv;
+
+		{
+			std::lock_guard<std::mutex> guard(ioMutex);
+			rd.openFile(inFileName, "r");
+		}
+		cadet::ParameterProviderImpl<Reader_t> pp(rd);
+
+		while (true)
+		{
+			const unsigned int idx = nextRun++;
+			if (idx >= runs.size())
+				break;
+
+			try
+			{
+				SweepOverlayProvider overlay(pp, runs[idx]);
+
+				{
+					// Configuration reads from the shared input file
+					std::lock_guard<std::mutex> guard(ioMutex);
+					drv.configure(overlay);
+				}
+
+				drv.run();
+
+				{
+					std::lock_guard<std::mutex> guard(ioMutex);
+
+					// Flush deferred log messages, if any
+					cadet::drainLogs();
+
+					appendToCampaign(drv, campaignFileName, idx);
+				}
+			}
+			catch (const std::exception& e)
+			{
+				errors[idx] = e.what();
+			}
+		}
+
+		std::lock_guard<std::mutex> guard(ioMutex);
+		rd.closeFile();
+	};
+
+	std::vector<std::thread> pool;
+	pool.reserve(numThreads);
+	for (unsigned int i = 0; i < numThreads; ++i)
+		pool.emplace_back(worker);
+	for (std::thread& t : pool)
+		t.join();
+
+	int retCode = 0;
+	for (std::size_t i = 0; i < errors.size(); ++i)
+	{
+		if (!errors[i].empty())
+		{
+			std::cerr << "ERROR in sweep run " << i << ": " << errors[i] << std::endl;
+			retCode = 3;
+		}
+	}
+	return retCode;
+}
+
+/**
+ * @brief Simulates a run and appends its outlet trajectories to a consolidated campaign file
+ */
+template <class Reader_t>
+void runCampaign(const std::string& inFileName, const std::string& campaignFileName, int runId)
+{
+	cadet::Driver drv;
+
+	{
+		Reader_t rd;
+		rd.openFile(inFileName, "r");
+
+		cadet::ParameterProviderImpl<Reader_t> pp(rd);
+		drv.configure(pp);
+
+		rd.closeFile();
+	}
+
+	drv.run();
+
+	// Flush deferred log messages, if any
+	cadet::drainLogs();
+
+	appendToCampaign(drv, campaignFileName, runId);
+}
+
 template <class Reader_t, class Writer_t>
 void run(const std::string& inFileName, const std::string& outFileName)
 {
@@ -124,13 +772,42 @@ void run(const std::string& inFileName, const std::string& outFileName)
 		rd.closeFile();
 	}
 
+	// Create (or open) the output file on a background thread while time integration
+	// runs. The integrator does not touch the HDF5 library, so the file creation cost
+	// (noticeable on network file systems) overlaps with the start of the computation.
+	// The input file has already been closed at this point, so opening the same file
+	// for output is safe as well.
+	Writer_t writer;
+	std::future<void> outFileTask;
+	try
+	{
+		outFileTask = std::async(std::launch::async, [&writer, &inFileName, &outFileName]()
+		{
+			if (inFileName == outFileName)
+				writer.openFile(outFileName, "rw");
+			else
+				writer.openFile(outFileName, "co");
+		});
+	}
+	catch (const std::system_error&)
+	{
+		// No thread available, the file is opened synchronously below
+	}
+
 	drv.run();
 
-	Writer_t writer;
-	if (inFileName == outFileName)
-		writer.openFile(outFileName, "rw");
+	// Flush deferred log messages, if any
+	cadet::drainLogs();
+
+	if (outFileTask.valid())
+		outFileTask.get();
 	else
-		writer.openFile(outFileName, "co");
+	{
+		if (inFileName == outFileName)
+			writer.openFile(outFileName, "rw");
+		else
+			writer.openFile(outFileName, "co");
+	}
 
 	drv.write(writer);
 	writer.closeFile();
@@ -163,12 +840,206 @@ void run(const std::string& inFileName, const std::string& outFileName)
 		for (unsigned int i = 0; i < grmTiming.size()-1; ++i)
 			std::cout << "\t\t\"" << grmDesc[i] << "\": " << grmTiming[i] << ",\n";
 
-		std::cout << "\t\t\"" << grmDesc[grmTiming.size()-1] << "\": " << grmTiming[grmTiming.size()-1] << "\n\t}";
+		std::cout << "\t\t\"" << grmDesc[grmTiming.size()-1] << "\": " << grmTiming[grmTiming.size()-1];
+
+		// Per-cell cost attribution, if the unit operation provides it
+		const std::vector<double> cellTiming = m->benchmarkCellTimings();
+		if (!cellTiming.empty())
+		{
+			std::cout << ",\n\t\t\"CellResidualCycles\": [";
+			for (unsigned int i = 0; i < cellTiming.size(); ++i)
+			{
+				if (i > 0)
+					std::cout << ", ";
+				std::cout << cellTiming[i];
+			}
+			std::cout << "]";
+		}
+		std::cout << "\n\t}";
 	}
 	std::cout << "\n}" << std::endl;
 #endif
 }
 
+using json = nlohmann::json;
+
+namespace
+{
+	/**
+	 * @brief Returns an interpolated quantile of a sorted sample
+	 * @param [in] sorted Sample sorted in ascending order, must not be empty
+	 * @param [in] q Quantile in [0,1]
+	 */
+	inline double sortedQuantile(const std::vector<double>& sorted, double q)
+	{
+		const double pos = q * (sorted.size() - 1);
+		const std::size_t idx = static_cast<std::size_t>(pos);
+		if (idx + 1 >= sorted.size())
+			return sorted.back();
+
+		const double frac = pos - static_cast<double>(idx);
+		return sorted[idx] * (1.0 - frac) + sorted[idx + 1] * frac;
+	}
+}
+
+/**
+ * @brief Runs the input repeatedly and gates the phase timings against a stored baseline
+ * @details The simulation is repeated @p reps times, each time with a freshly configured
+ *          driver so that every repetition starts from a cold state. For every timing phase
+ *          the median and the interquartile range over all repetitions are reported. In
+ *          benchmark builds (CADET_BENCHMARK_MODE) the phases are the counters of
+ *          Benchmark.hpp, broken down by ModelSystem and unit operation; in ordinary builds
+ *          only the total wall time of the time integration is available.
+ *
+ *          If a baseline file is given, the measured medians are compared phase by phase
+ *          against the medians stored in the baseline. A phase that is slower than its
+ *          baseline by more than @p threshold percent counts as a regression. Phases whose
+ *          baseline is below 1 ms are dominated by timer noise and are not gated.
+ * @param [in] inFileName Name of the input file
+ * @param [in] reps Number of repetitions
+ * @param [in] baselineFileName Name of the baseline file to compare against (may be empty)
+ * @param [in] storeFileName Name of the file the measured medians are written to (may be empty)
+ * @param [in] threshold Relative slowdown in percent that counts as a regression
+ * @return @c 0 if no regression was detected, otherwise @c 4
+ */
+template <class Reader_t>
+int runBenchmark(const std::string& inFileName, unsigned int reps, const std::string& baselineFileName, const std::string& storeFileName, double threshold)
+{
+	std::vector<std::string> names;
+	std::vector<std::vector<double>> samples;
+
+	for (unsigned int r = 0; r < reps; ++r)
+	{
+		cadet::Driver drv;
+
+		{
+			Reader_t rd;
+			rd.openFile(inFileName, "r");
+
+			cadet::ParameterProviderImpl<Reader_t> pp(rd);
+			drv.configure(pp);
+
+			rd.closeFile();
+		}
+
+		cadet::Timer timer;
+		timer.start();
+		drv.run();
+		const double wallTime = timer.stop();
+
+		// Flush deferred log messages, if any
+		cadet::drainLogs();
+
+		std::vector<std::string> curNames;
+		std::vector<double> curVals;
+
+		curNames.push_back("TotalTime");
+		curVals.push_back(wallTime);
+
+#ifdef CADET_BENCHMARK_MODE
+		// Phase breakdown of the ModelSystem and all unit operations that provide timings
+		{
+			const std::vector<double> sysTiming = drv.model()->benchmarkTimings();
+			char const* const* const sysDesc = drv.model()->benchmarkDescriptions();
+			for (std::size_t i = 0; i < sysTiming.size(); ++i)
+			{
+				curNames.push_back(std::string("ModelSystem/") + sysDesc[i]);
+				curVals.push_back(sysTiming[i]);
+			}
+		}
+
+		for (unsigned int j = 0; j < drv.model()->numModels(); ++j)
+		{
+			cadet::IModel const* const m = drv.model()->getModel(j);
+			if (!m->benchmarkDescriptions())
+				continue;
+
+			std::ostringstream prefix;
+			prefix << m->unitOperationName() << static_cast<int>(m->unitOperationId()) << "/";
+
+			const std::vector<double> unitTiming = m->benchmarkTimings();
+			char const* const* const unitDesc = m->benchmarkDescriptions();
+			for (std::size_t i = 0; i < unitTiming.size(); ++i)
+			{
+				curNames.push_back(prefix.str() + unitDesc[i]);
+				curVals.push_back(unitTiming[i]);
+			}
+		}
+#endif
+
+		if (r == 0)
+		{
+			names = curNames;
+			samples.resize(names.size());
+		}
+
+		for (std::size_t i = 0; i < curVals.size(); ++i)
+			samples[i].push_back(curVals[i]);
+	}
+
+	// Median and interquartile range of every phase
+	std::vector<double> medians(names.size());
+	std::cout << "Phase timings over " << reps << " repetitions:\n";
+	for (std::size_t i = 0; i < names.size(); ++i)
+	{
+		std::sort(samples[i].begin(), samples[i].end());
+		medians[i] = sortedQuantile(samples[i], 0.5);
+		const double iqr = sortedQuantile(samples[i], 0.75) - sortedQuantile(samples[i], 0.25);
+		std::cout << "  " << names[i] << ": median " << medians[i] << " sec, IQR " << iqr << " sec\n";
+	}
+	std::cout << std::flush;
+
+	int retCode = 0;
+	if (!baselineFileName.empty())
+	{
+		std::ifstream ifs(baselineFileName);
+		if (!ifs)
+			throw cadet::io::IOException("Failed to open baseline file '" + baselineFileName + "'");
+
+		json baseline;
+		ifs >> baseline;
+		const json basePhases = (baseline.find("PHASES") != baseline.end()) ? baseline["PHASES"] : baseline;
+
+		for (std::size_t i = 0; i < names.size(); ++i)
+		{
+			if (basePhases.find(names[i]) == basePhases.end())
+				continue;
+
+			const double base = basePhases[names[i]].get<double>();
+			if (base < 1e-3)
+				continue;
+
+			const double relChange = (medians[i] - base) / base * 100.0;
+			if (relChange > threshold)
+			{
+				std::cout << "REGRESSION in " << names[i] << ": " << base << " sec -> " << medians[i] << " sec (" << relChange << " %)" << std::endl;
+				retCode = 4;
+			}
+			else
+				std::cout << "OK " << names[i] << ": " << base << " sec -> " << medians[i] << " sec (" << relChange << " %)" << std::endl;
+		}
+	}
+
+	if (!storeFileName.empty())
+	{
+		json result;
+		result["INPUT"] = inFileName;
+		result["REPETITIONS"] = reps;
+
+		json phases = json::object();
+		for (std::size_t i = 0; i < names.size(); ++i)
+			phases[names[i]] = medians[i];
+		result["PHASES"] = phases;
+
+		std::ofstream ofs(storeFileName, std::ios_base::out | std::ios_base::trunc);
+		if (!ofs)
+			throw cadet::io::IOException("Failed to open baseline file '" + storeFileName + "' for writing");
+		ofs << result.dump(4) << std::endl;
+	}
+
+	return retCode;
+}
+
 
 int main(int argc, char** argv)
 {	
@@ -180,6 +1051,15 @@ int main(int argc, char** argv)
 	// Program options
 	std::string inFileName = "";
 	std::string outFileName = "";
+	std::string campaignFileName = "";
+	std::string shmName = "";
+	std::string sweepFileName = "";
+	unsigned int sweepThreads = 0;
+	int runId = -1;
+	unsigned int benchReps = 0;
+	std::string baselineFileName = "";
+	std::string storeBaselineFileName = "";
+	double benchThreshold = 5.0;
 	cadet::LogLevel logLevel = cadet::LogLevel::Trace;
 
 	try
@@ -189,6 +1069,15 @@ int main(int argc, char** argv)
 		cmd.setOutput(&customOut);
 
 		cmd >> (new TCLAP::ValueArg<cadet::LogLevel>("L", "loglevel", "Set the log level", false, cadet::LogLevel::Trace, "LogLevel"))->storeIn(&logLevel);
+		cmd >> (new TCLAP::ValueArg<std::string>("a", "append", "Append outlet trajectories to the given consolidated campaign file instead of writing an output file", false, "", "File"))->storeIn(&campaignFileName);
+		cmd >> (new TCLAP::ValueArg<std::string>("m", "shm", "Publish the outlet trajectories into the given named shared memory segment instead of writing an output file", false, "", "Name"))->storeIn(&shmName);
+		cmd >> (new TCLAP::ValueArg<int>("r", "runid", "Run id stored in the campaign index (defaults to the number of runs already in the file)", false, -1, "Id"))->storeIn(&runId);
+		cmd >> (new TCLAP::ValueArg<std::string>("s", "sweep", "Execute the parameter sweep given in the JSON specification on an in-process worker pool (requires --append)", false, "", "File"))->storeIn(&sweepFileName);
+		cmd >> (new TCLAP::ValueArg<unsigned int>("t", "threads", "Number of sweep worker threads (defaults to NTHREADS from the specification or the hardware concurrency)", false, 0, "Num"))->storeIn(&sweepThreads);
+		cmd >> (new TCLAP::ValueArg<unsigned int>("b", "benchmark", "Run the input the given number of times and report median phase timings instead of writing an output file", false, 0, "Reps"))->storeIn(&benchReps);
+		cmd >> (new TCLAP::ValueArg<std::string>("", "baseline", "Compare the median phase timings against the given baseline file and exit with code 4 on regression (requires --benchmark)", false, "", "File"))->storeIn(&baselineFileName);
+		cmd >> (new TCLAP::ValueArg<std::string>("", "storebaseline", "Write the measured median phase timings to the given baseline file (requires --benchmark)", false, "", "File"))->storeIn(&storeBaselineFileName);
+		cmd >> (new TCLAP::ValueArg<double>("", "threshold", "Relative slowdown in percent that counts as a regression (default: 5)", false, 5.0, "Percent"))->storeIn(&benchThreshold);
 		cmd >> (new TCLAP::UnlabeledValueArg<std::string>("input", "Input file", true, "", "File"))->storeIn(&inFileName);
 		cmd >> (new TCLAP::UnlabeledValueArg<std::string>("output", "Output file (defaults to input file)", false, "", "File"))->storeIn(&outFileName);
 
@@ -232,6 +1121,74 @@ int main(int argc, char** argv)
 
 	try
 	{
+		// Benchmark mode: repeat the simulation and gate phase timings, no output file is written
+		if (benchReps > 0)
+		{
+			if (cadet::util::caseInsensitiveEquals(fileExtIn, "h5"))
+				return runBenchmark<cadet::io::HDF5Reader>(inFileName, benchReps, baselineFileName, storeBaselineFileName, benchThreshold);
+			else if (cadet::util::caseInsensitiveEquals(fileExtIn, "xml"))
+				return runBenchmark<cadet::io::XMLReader>(inFileName, benchReps, baselineFileName, storeBaselineFileName, benchThreshold);
+			else if (cadet::util::caseInsensitiveEquals(fileExtIn, "bin"))
+				return runBenchmark<cadet::io::BinaryReader>(inFileName, benchReps, baselineFileName, storeBaselineFileName, benchThreshold);
+
+			std::cerr << "Input file format ('." << fileExtIn << "') not supported" << std::endl;
+			return 2;
+		}
+
+		// Sweep mode: execute all runs of the specification in-process and consolidate the output
+		if (!sweepFileName.empty())
+		{
+			if (campaignFileName.empty())
+			{
+				std::cerr << "Sweep mode requires a consolidated campaign file (--append)" << std::endl;
+				return 2;
+			}
+
+			if (cadet::util::caseInsensitiveEquals(fileExtIn, "h5"))
+				return runSweep<cadet::io::HDF5Reader>(inFileName, sweepFileName, campaignFileName, sweepThreads);
+			else if (cadet::util::caseInsensitiveEquals(fileExtIn, "xml"))
+				return runSweep<cadet::io::XMLReader>(inFileName, sweepFileName, campaignFileName, sweepThreads);
+			else if (cadet::util::caseInsensitiveEquals(fileExtIn, "bin"))
+				return runSweep<cadet::io::BinaryReader>(inFileName, sweepFileName, campaignFileName, sweepThreads);
+
+			std::cerr << "Input file format ('." << fileExtIn << "') not supported" << std::endl;
+			return 2;
+		}
+
+		// Shared memory mode: simulate and publish to the segment, no output file is written
+		if (!shmName.empty())
+		{
+			if (cadet::util::caseInsensitiveEquals(fileExtIn, "h5"))
+				runShm<cadet::io::HDF5Reader>(inFileName, shmName);
+			else if (cadet::util::caseInsensitiveEquals(fileExtIn, "xml"))
+				runShm<cadet::io::XMLReader>(inFileName, shmName);
+			else if (cadet::util::caseInsensitiveEquals(fileExtIn, "bin"))
+				runShm<cadet::io::BinaryReader>(inFileName, shmName);
+			else
+			{
+				std::cerr << "Input file format ('." << fileExtIn << "') not supported" << std::endl;
+				return 2;
+			}
+			return 0;
+		}
+
+		// Campaign mode: simulate and append to the consolidated file, no output file is written
+		if (!campaignFileName.empty())
+		{
+			if (cadet::util::caseInsensitiveEquals(fileExtIn, "h5"))
+				runCampaign<cadet::io::HDF5Reader>(inFileName, campaignFileName, runId);
+			else if (cadet::util::caseInsensitiveEquals(fileExtIn, "xml"))
+				runCampaign<cadet::io::XMLReader>(inFileName, campaignFileName, runId);
+			else if (cadet::util::caseInsensitiveEquals(fileExtIn, "bin"))
+				runCampaign<cadet::io::BinaryReader>(inFileName, campaignFileName, runId);
+			else
+			{
+				std::cerr << "Input file format ('." << fileExtIn << "') not supported" << std::endl;
+				return 2;
+			}
+			return 0;
+		}
+
 		if (cadet::util::caseInsensitiveEquals(fileExtIn, "h5"))
 		{
 			if (cadet::util::caseInsensitiveEquals(fileExtOut, "h5"))
@@ -242,12 +1199,33 @@ int main(int argc, char** argv)
 			{
 				run<cadet::io::HDF5Reader, cadet::io::XMLWriter>(inFileName, outFileName);
 			}
+			else if (cadet::util::caseInsensitiveEquals(fileExtOut, "bin"))
+			{
+				// Only convert the input to a binary snapshot, do not simulate
+				convertToSnapshot(inFileName, outFileName);
+			}
 			else
 			{
 				std::cerr << "Output file format ('." << fileExtOut << "') not supported" << std::endl;
 				return 2;
 			}
 		}
+		else if (cadet::util::caseInsensitiveEquals(fileExtIn, "bin"))
+		{
+			if (cadet::util::caseInsensitiveEquals(fileExtOut, "h5"))
+			{
+				run<cadet::io::BinaryReader, cadet::io::HDF5Writer>(inFileName, outFileName);
+			}
+			else if (cadet::util::caseInsensitiveEquals(fileExtOut, "xml"))
+			{
+				run<cadet::io::BinaryReader, cadet::io::XMLWriter>(inFileName, outFileName);
+			}
+			else
+			{
+				std::cerr << "Binary snapshot inputs require an '.h5' or '.xml' output file" << std::endl;
+				return 2;
+			}
+		}
 		else if (cadet::util::caseInsensitiveEquals(fileExtIn, "xml"))
 		{
 			if (cadet::util::caseInsensitiveEquals(fileExtOut, "xml"))
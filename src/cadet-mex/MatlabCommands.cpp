@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <memory>
 #include <unordered_map>
 #include <sstream>
 #include <string>
@@ -26,6 +27,7 @@
 #include "Logging.hpp"
 #include "MatlabIO.hpp"
 #include "MatlabReaderWriter.hpp"
+#include "MatlabSolutionRecorder.hpp"
 #include "MatlabCommands.hpp"
 
 // Take care of namespace pollution / macros
@@ -41,6 +43,9 @@
 #include "common/CompilerSpecific.hpp"
 #include "common/ParameterProviderImpl.hpp"
 #include "common/Driver.hpp"
+#include "common/BatchDriver.hpp"
+
+#include <thread>
 
 namespace std
 {
@@ -162,6 +167,36 @@ namespace
 		mxSetFieldByNumber(structArray, idx, 5, cadet::mex::io::scalar<cadet::SectionIdx, int32_t>(pId.section, cadet::SectionIndep));
 	}
 
+	/**
+	 * @brief Holds the persistent in-place solution recorder of each Driver object
+	 * @details The recorders own persistent mxArrays that are reused across mexFunction()
+	 *          calls and are released when the corresponding Driver is destroyed.
+	 */
+	std::unordered_map<cadet::Driver*, std::unique_ptr<cadet::mex::MatlabSolutionRecorder>> inPlaceRecorders;
+
+	inline cadet::mex::MatlabSolutionRecorder* inPlaceRecorder(cadet::Driver* drv)
+	{
+		std::unique_ptr<cadet::mex::MatlabSolutionRecorder>& rec = inPlaceRecorders[drv];
+		if (!rec)
+			rec.reset(new cadet::mex::MatlabSolutionRecorder());
+		return rec.get();
+	}
+
+	/**
+	 * @brief Warm simulator pool for batched residual evaluations of a Driver handle
+	 * @details Owns a BatchDriver whose instances stay configured across mexFunction()
+	 *          calls, together with a snapshot of the configured initial state that every
+	 *          job is reset to. The pool is released when the Driver is destroyed.
+	 */
+	struct BatchEvaluationServer
+	{
+		std::unique_ptr<cadet::BatchDriver> batch; //!< Pool of independently configured driver instances
+		std::vector<double> initState; //!< Initial state vector the instances are reset to before every job
+		std::vector<double> initStateDot; //!< Initial time derivative state the instances are reset to before every job
+	};
+
+	std::unordered_map<cadet::Driver*, BatchEvaluationServer> batchServers;
+
 }
 
 namespace cadet
@@ -709,9 +744,236 @@ void reRun(cadet::Driver& drv, int nlhs, mxArray** plhs, int nrhs, const mxArray
 	drv.write(writer);
 }
 
+/**
+ * @brief Runs an already configured CADET simulation again, recording directly into persistent Matlab arrays
+ * @details Requires an already configured model and solution times set in advance. Instead of
+ *          buffering the solution internally and copying it into fresh Matlab arrays, the
+ *          solution times and unit operation outlets are written in place into persistent
+ *          mxArrays during recording. The arrays are reused by subsequent calls if the
+ *          dimensions have not changed, which removes allocation and copy overhead from
+ *          estimation loops that run the same model many times.
+ * @param [in] drv Driver
+ * @param [in] nlhs Number of left hand side (output) arguments
+ * @param [out] plhs List with output arguments
+ * @param [in] nrhs Number of right hand side (input) arguments
+ * @param [in] prhs List with input arguments
+ */
+void reRunInPlace(cadet::Driver& drv, int nlhs, mxArray** plhs, int nrhs, const mxArray** prhs)
+{
+	if (nrhs > 3)
+		mexWarnMsgIdAndTxt("CADET:mexWarn", "CadetMex: Command 'reruninplace' ignores all additional arguments (requires only 2, uses at most 3).\n");
+	if (nlhs != 1)
+		mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'reruninplace' requires exactly one output.\n");
+
+	requireConfiguredSimulatorAndModel(drv.simulator(), "reruninplace");
+
+	cadet::mex::MatlabSolutionRecorder* const rec = inPlaceRecorder(&drv);
+	rec->clear();
+	drv.simulator()->setSolutionRecorder(rec);
+
+	if (nrhs == 3)
+	{
+		// Set initial conditions
+		cadet::mex::MatlabReaderWriter reader(const_cast<mxArray**>(&prhs[2]));
+		cadet::ParameterProviderImpl<cadet::mex::MatlabReaderWriter> pp(reader, false);
+		drv.setInitialCondition(pp);
+	}
+	else
+	{
+		// Resume simulation from last state
+		drv.simulator()->skipConsistentInitialization();
+	}
+
+	try
+	{
+		drv.run();
+	}
+	catch (...)
+	{
+		// Reattach the internal storage so that regular commands keep working
+		drv.simulator()->setSolutionRecorder(drv.solution());
+		throw;
+	}
+
+	drv.simulator()->setSolutionRecorder(drv.solution());
+
+	if (!rec->hasRecordedSolution())
+		mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'reruninplace' requires solution times to be set in advance (use 'setsoltimes').\n");
+
+	plhs[0] = rec->createOutputStruct();
+}
+
+/**
+ * @brief Creates and configures a pool of warm simulator instances for batched evaluations
+ * @details Builds the given number of independently configured simulator instances from the
+ *          task struct and keeps them alive across mexFunction() calls. The configured
+ *          initial state is snapshotted so that every job submitted via 'batchrun' starts
+ *          from it. Configuration is paid once here instead of once per evaluation.
+ * @param [in] drv Driver
+ * @param [in] nlhs Number of left hand side (output) arguments
+ * @param [out] plhs List with output arguments
+ * @param [in] nrhs Number of right hand side (input) arguments
+ * @param [in] prhs List with input arguments
+ */
+void configureBatch(cadet::Driver& drv, int nlhs, mxArray** plhs, int nrhs, const mxArray** prhs)
+{
+	checkInputArgs(nrhs, 4, "batchconf");
+	checkOutputArgs(nlhs, 0, "batchconf");
+
+	const unsigned int numInstances = cadet::mex::io::scalar<int32_t>(prhs[3]);
+	if (numInstances == 0)
+		mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'batchconf' requires at least one simulator instance.\n");
+
+	BatchEvaluationServer& srv = batchServers[&drv];
+	srv.batch.reset(new cadet::BatchDriver(numInstances));
+
+	cadet::mex::MatlabReaderWriter reader(const_cast<mxArray**>(&prhs[2]));
+	cadet::ParameterProviderImpl<cadet::mex::MatlabReaderWriter> pp(reader);
+	srv.batch->configure(pp);
+
+	// Snapshot the configured initial state; all instances are identical at this point
+	unsigned int len = 0;
+	cadet::ISimulator* const sim = srv.batch->instance(0).simulator();
+	double const* const initY = sim->getLastSolution(len);
+	srv.initState.assign(initY, initY + len);
+	double const* const initYdot = sim->getLastSolutionDerivative(len);
+	srv.initStateDot.assign(initYdot, initYdot + len);
+}
+
+/**
+ * @brief Evaluates a batch of parameter vectors on the warm simulator pool
+ * @details Takes the same parameter addressing as 'setparval' but with a matrix of values
+ *          (one row per parameter, one column per job) and returns a cell array with one
+ *          output struct per job. The jobs are processed in waves of the pool size: each
+ *          wave resets the instances to the snapshotted initial state, assigns one
+ *          parameter column per instance, and integrates all instances concurrently
+ *          inside this single MEX call. Matlab arrays are only touched on the calling
+ *          thread; the workers run pure C++ simulators. This amortizes the Matlab
+ *          boundary crossing over the whole batch, e.g., for finite-difference Jacobians
+ *          of optimizer loops.
+ * @param [in] drv Driver
+ * @param [in] nlhs Number of left hand side (output) arguments
+ * @param [out] plhs List with output arguments
+ * @param [in] nrhs Number of right hand side (input) arguments
+ * @param [in] prhs List with input arguments
+ */
+void runBatch(cadet::Driver& drv, int nlhs, mxArray** plhs, int nrhs, const mxArray** prhs)
+{
+	checkInputArgs(nrhs, 9, "batchrun");
+	checkOutputArgs(nlhs, 1, "batchrun");
+
+	const auto it = batchServers.find(&drv);
+	if ((it == batchServers.end()) || !it->second.batch)
+		mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'batchrun' requires a configured batch server (use 'batchconf').\n");
+
+	BatchEvaluationServer& srv = it->second;
+	cadet::BatchDriver& batch = *srv.batch;
+
+	// Check lengths of vectors and cell arrays
+	const unsigned int nPar = io::numElements(prhs[2]);
+	for (unsigned int i = 3; i < 8; ++i)
+	{
+		if (io::numElements(prhs[i]) != nPar)
+			mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'batchrun' requires all addressing arguments to be of the same size (failed for argument %d).\n", i + 1);
+	}
+
+	const mxArray* const mNames = prhs[2];
+	const MatlabAutoConverter<UnitOpIdx, int32_t> unitOps(prhs[3], "CadetMex: Command 'batchrun' requires unit operation ids of type 'int32'.\n");
+	const MatlabAutoConverter<ComponentIdx, int32_t> comps(prhs[4], "CadetMex: Command 'batchrun' requires component ids of type 'int32'.\n");
+	const MatlabAutoConverter<BoundPhaseIdx, int32_t> boundPhases(prhs[5], "CadetMex: Command 'batchrun' requires bound phase ids of type 'int32'.\n");
+	const MatlabAutoConverter<ReactionIdx, int32_t> reactIdx(prhs[6], "CadetMex: Command 'batchrun' requires reaction ids of type 'int32'.\n");
+	const MatlabAutoConverter<SectionIdx, int32_t> secIdx(prhs[7], "CadetMex: Command 'batchrun' requires section ids of type 'int32'.\n");
+
+	if (!cadet::mex::io::isType<double>(prhs[8]))
+		mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'batchrun' requires parameter values of type 'double'.\n");
+
+	if (!cadet::mex::io::isCell(mNames) && !cadet::mex::io::isType<uint64_t>(mNames))
+		mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'batchrun' requires parameter names as cell array of strings or hashes (uint64).\n");
+
+	if (mxGetM(prhs[8]) != nPar)
+		mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'batchrun' requires one row of values per parameter.\n");
+
+	uint64_t const* nameHash = nullptr;
+	if (cadet::mex::io::isType<uint64_t>(mNames))
+		nameHash = cadet::mex::io::data<uint64_t>(mNames);
+
+	// Construct all parameter IDs up front; they are shared by all jobs
+	std::vector<ParameterId> pIds;
+	pIds.reserve(nPar);
+	for (unsigned int i = 0; i < nPar; ++i)
+	{
+		cadet::StringHash paramName;
+
+		if (!nameHash)
+		{
+			mxArray* const curCellStr = mxGetCell(mNames, i);
+			if (!mxIsChar(curCellStr))
+				mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'batchrun' requires all parameter name cells to contain strings (failed for element %d).\n", i + 1);
+
+			const char* const strName = mxArrayToString(curCellStr);
+			paramName = cadet::hashStringRuntime(strName);
+			mxFree(const_cast<char*>(strName));
+		}
+		else
+			paramName = nameHash[i];
+
+		pIds.push_back(makeParamId(paramName, unitOps[i], comps[i], boundPhases[i], reactIdx[i], secIdx[i]));
+	}
+
+	const unsigned int numJobs = mxGetN(prhs[8]);
+	double const* const parVals = cadet::mex::io::data<double>(prhs[8]);
+
+	plhs[0] = mxCreateCellMatrix(1, numJobs);
+
+	// Process the jobs in waves of the pool size
+	const unsigned int poolSize = batch.numInstances();
+	for (unsigned int offset = 0; offset < numJobs; offset += poolSize)
+	{
+		const unsigned int active = std::min(poolSize, numJobs - offset);
+
+		for (unsigned int i = 0; i < active; ++i)
+		{
+			cadet::Driver& inst = batch.instance(i);
+			inst.clearResults();
+			inst.simulator()->setInitialCondition(srv.initState.data(), srv.initStateDot.data());
+
+			double const* const jobVals = parVals + static_cast<std::size_t>(offset + i) * nPar;
+			for (unsigned int j = 0; j < nPar; ++j)
+				inst.simulator()->setParameterValue(pIds[j], jobVals[j]);
+		}
+
+		batch.run(std::thread::hardware_concurrency(), active);
+
+		// Convert the finished wave back to Matlab on the calling thread
+		for (unsigned int i = 0; i < active; ++i)
+		{
+			mxArray* out = nullptr;
+			cadet::mex::MatlabReaderWriter writer(&out);
+			batch.instance(i).write(writer);
+			mxSetCell(plhs[0], offset + i, out);
+		}
+	}
+}
+
+/**
+ * @brief Releases the warm simulator pool of the batch evaluation server
+ * @param [in] drv Driver
+ * @param [in] nlhs Number of left hand side (output) arguments
+ * @param [out] plhs List with output arguments
+ * @param [in] nrhs Number of right hand side (input) arguments
+ * @param [in] prhs List with input arguments
+ */
+void clearBatch(cadet::Driver& drv, int nlhs, mxArray** plhs, int nrhs, const mxArray** prhs)
+{
+	if (nlhs != 0)
+		mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'clearbatch' does not return anything.\n");
+
+	batchServers.erase(&drv);
+}
+
 /**
  * @brief Reconfigures a given unit operation model, the model system itself, or the time integrator
- * @details Requires an already configured model. The entity that is configured depends on the 
+ * @details Requires an already configured model. The entity that is configured depends on the
  *          number of input arguments.
  * @param [in] drv Driver
  * @param [in] nlhs Number of left hand side (output) arguments
@@ -1021,6 +1283,16 @@ void getSimulationTime(cadet::Driver& drv, int nlhs, mxArray** plhs, int nrhs, c
 
 } // namespace command
 
+void releaseInPlaceRecorder(cadet::Driver* drv)
+{
+	inPlaceRecorders.erase(drv);
+}
+
+void releaseBatchDriver(cadet::Driver* drv)
+{
+	batchServers.erase(drv);
+}
+
 CommandMap registeredCommands()
 {
 	CommandMap map;
@@ -1036,6 +1308,10 @@ CommandMap registeredCommands()
 	map["setsensparfactor"] = &command::setSensitiveParameterFactors;
 	map["setconsinitmode"] = &command::setConsistentInitializationMode;
 	map["rerun"] = &command::reRun;
+	map["reruninplace"] = &command::reRunInPlace;
+	map["batchconf"] = &command::configureBatch;
+	map["batchrun"] = &command::runBatch;
+	map["clearbatch"] = &command::clearBatch;
 	map["reconf"] = &command::reconfigureModelOrSimulator;
 	map["setreturnconf"] = &command::setReturnConfiguration;
 	map["settimeintopts"] = &command::setTimeIntegratorOptions;
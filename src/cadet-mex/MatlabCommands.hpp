@@ -40,6 +40,20 @@ class MatlabReaderWriter;
  */
 void runFullSimulation(cadet::Driver& drv, mxArray const*& input, mxArray*& output);
 
+/**
+ * @brief Releases the persistent in-place solution recorder of the given Driver, if any
+ * @details Has to be called before a Driver object is destroyed.
+ * @param [in] drv Driver whose recorder is released
+ */
+void releaseInPlaceRecorder(cadet::Driver* drv);
+
+/**
+ * @brief Releases the persistent batch evaluation server of the given Driver, if any
+ * @details Has to be called before a Driver object is destroyed.
+ * @param [in] drv Driver whose batch server is released
+ */
+void releaseBatchDriver(cadet::Driver* drv);
+
 /**
  * @brief Command map type
  */
@@ -128,6 +128,9 @@ public:
 	/// \brief Enable/disable compression for tensors of 2nd order and above
 	inline void compressFields(bool setCompression) { }
 
+	/// \brief Sets the compression level applied to compressed fields, ignored by Matlab
+	inline void compressionLevel(int level) { }
+
 	/// \brief Tensors of 2nd order (vectors) and above are written as extendible fields
 	///        (maxsize = unlimited, chunked layout), when set to true.
 	inline void extendibleFields(bool setExtendible) { }
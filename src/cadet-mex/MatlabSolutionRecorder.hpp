@@ -0,0 +1,246 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a solution recorder that writes directly into persistent Matlab arrays.
+ */
+
+#ifndef CADET_MEX_MATLABSOLUTIONRECORDER_HPP_
+#define CADET_MEX_MATLABSOLUTIONRECORDER_HPP_
+
+#include <mex.h>
+
+#include <vector>
+#include <cstdio>
+
+#include "MatlabUndocumentedSupport.hpp"
+
+#include "cadet/SolutionRecorder.hpp"
+#include "cadet/SolutionExporter.hpp"
+
+namespace cadet
+{
+
+namespace mex
+{
+
+/**
+ * @brief Records solution times and unit operation outlets directly into persistent mxArrays
+ * @details Instead of buffering the solution in internal storage and copying it into freshly
+ *          allocated Matlab arrays after the time integration, this recorder writes each
+ *          time step in place into pre-created persistent mxArrays as it is reported by the
+ *          simulator. The arrays survive across mexFunction() calls and are reused by
+ *          subsequent runs if the dimensions (number of time steps and components) have not
+ *          changed, which avoids both the copy and the allocation in Matlab estimation loops.
+ *
+ *          Only the solution of the original system is recorded (time points and outlets of
+ *          all unit operations). Time derivatives and parameter sensitivities are ignored.
+ *
+ *          Note that preallocation requires the number of time steps to be known in advance,
+ *          that is, solution times have to be set in the simulator.
+ */
+class MatlabSolutionRecorder : public cadet::ISolutionRecorder
+{
+public:
+
+	MatlabSolutionRecorder() : _time(nullptr), _units(), _numTimesteps(0), _curStep(0), _inSolution(false) { }
+
+	virtual ~MatlabSolutionRecorder() CADET_NOEXCEPT
+	{
+		if (_time)
+			mxDestroyArray(_time);
+
+		for (UnitStorage& u : _units)
+		{
+			if (u.outlet)
+				mxDestroyArray(u.outlet);
+		}
+	}
+
+	virtual void clear()
+	{
+		// Keep the persistent arrays, subsequent runs overwrite their contents
+		_curStep = 0;
+	}
+
+	virtual void prepare(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
+	{
+		_numTimesteps = numTimesteps;
+		_curStep = 0;
+		prepareTimeArray();
+	}
+
+	virtual void notifyIntegrationStart(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
+	{
+		_numTimesteps = numTimesteps;
+		_curStep = 0;
+		prepareTimeArray();
+	}
+
+	virtual void unitOperationStructure(UnitOpIdx idx, const IModel& model, const ISolutionExporter& exporter)
+	{
+		const unsigned int nComp = exporter.numComponents();
+
+		UnitStorage* unit = unitStorage(idx);
+		if (!unit)
+		{
+			_units.push_back(UnitStorage{idx, nComp, nullptr});
+			unit = &_units.back();
+		}
+
+		// Reuse the existing array if the dimensions still match
+		if (unit->outlet && ((unit->nComp != nComp) || (mxGetM(unit->outlet) != _numTimesteps)))
+		{
+			mxDestroyArray(unit->outlet);
+			unit->outlet = nullptr;
+		}
+
+		unit->nComp = nComp;
+		if (!unit->outlet && (_numTimesteps > 0))
+		{
+			unit->outlet = mxCreateUninitNumericMatrix(_numTimesteps, nComp, mxDOUBLE_CLASS, mxREAL);
+			mexMakeArrayPersistent(unit->outlet);
+		}
+	}
+
+	virtual void beginTimestep(double t)
+	{
+		if (_time && (_curStep < _numTimesteps))
+			mxGetPr(_time)[_curStep] = t;
+	}
+
+	virtual void beginUnitOperation(cadet::UnitOpIdx idx, const cadet::IModel& model, const cadet::ISolutionExporter& exporter)
+	{
+		if (!_inSolution || (_curStep >= _numTimesteps))
+			return;
+
+		UnitStorage* const unit = unitStorage(idx);
+		if (!unit || !unit->outlet)
+			return;
+
+		// Matlab arrays are column-major, so each component occupies one column
+		const SolutionSpan outlet = exporter.outletSpan();
+		double* const dest = mxGetPr(unit->outlet);
+		for (unsigned int i = 0; i < unit->nComp; ++i)
+			dest[i * _numTimesteps + _curStep] = outlet.data[i * outlet.stride];
+	}
+
+	virtual void endUnitOperation() { }
+
+	virtual void endTimestep()
+	{
+		++_curStep;
+	}
+
+	virtual void beginSolution() { _inSolution = true; }
+	virtual void endSolution() { _inSolution = false; }
+
+	virtual void beginSolutionDerivative() { }
+	virtual void endSolutionDerivative() { }
+
+	virtual void beginSensitivity(const cadet::ParameterId& pId, unsigned int sensIdx) { }
+	virtual void endSensitivity(const cadet::ParameterId& pId, unsigned int sensIdx) { }
+
+	virtual void beginSensitivityDerivative(const cadet::ParameterId& pId, unsigned int sensIdx) { }
+	virtual void endSensitivityDerivative(const cadet::ParameterId& pId, unsigned int sensIdx) { }
+
+	/**
+	 * @brief Returns whether persistent arrays have been allocated and completely filled
+	 * @return @c true if a full solution has been recorded, otherwise @c false
+	 */
+	inline bool hasRecordedSolution() const CADET_NOEXCEPT { return _time && (_numTimesteps > 0) && (_curStep >= _numTimesteps); }
+
+	/**
+	 * @brief Creates a Matlab struct referencing the recorded solution without copying it
+	 * @details The returned struct contains the field @c SOLUTION_TIMES and one field
+	 *          @c unit_XXX per recorded unit operation holding its @c SOLUTION_OUTLET
+	 *          matrix (time steps x components). The data buffers are shared with the
+	 *          persistent arrays of this recorder via copy-on-write, so no data is copied
+	 *          as long as Matlab does not modify the returned arrays.
+	 * @return Matlab struct with the recorded solution
+	 */
+	inline mxArray* createOutputStruct() const
+	{
+		mxArray* const out = mxCreateStructMatrix(1, 1, 0, nullptr);
+
+		const int fieldTime = mxAddField(out, "SOLUTION_TIMES");
+		mxSetFieldByNumber(out, 0, fieldTime, mxCreateSharedDataCopy(_time));
+
+		char unitName[10];
+		for (const UnitStorage& u : _units)
+		{
+			std::snprintf(unitName, sizeof(unitName), "unit_%03d", static_cast<int>(u.idx));
+
+			mxArray* const unitStruct = mxCreateStructMatrix(1, 1, 0, nullptr);
+			const int fieldOutlet = mxAddField(unitStruct, "SOLUTION_OUTLET");
+			mxSetFieldByNumber(unitStruct, 0, fieldOutlet, mxCreateSharedDataCopy(u.outlet));
+
+			const int fieldUnit = mxAddField(out, unitName);
+			mxSetFieldByNumber(out, 0, fieldUnit, unitStruct);
+		}
+
+		return out;
+	}
+
+protected:
+
+	struct UnitStorage
+	{
+		UnitOpIdx idx; //!< Unit operation id
+		unsigned int nComp; //!< Number of recorded components
+		mxArray* outlet; //!< Persistent array with outlet data (time steps x components)
+	};
+
+	/**
+	 * @brief Allocates or reuses the persistent array holding the solution times
+	 */
+	inline void prepareTimeArray()
+	{
+		if (_time && (mxGetM(_time) != _numTimesteps))
+		{
+			mxDestroyArray(_time);
+			_time = nullptr;
+		}
+
+		if (!_time && (_numTimesteps > 0))
+		{
+			_time = mxCreateUninitNumericMatrix(_numTimesteps, 1, mxDOUBLE_CLASS, mxREAL);
+			mexMakeArrayPersistent(_time);
+		}
+	}
+
+	/**
+	 * @brief Returns the storage of the given unit operation or @c nullptr if it is unknown
+	 */
+	inline UnitStorage* unitStorage(UnitOpIdx idx)
+	{
+		for (UnitStorage& u : _units)
+		{
+			if (u.idx == idx)
+				return &u;
+		}
+		return nullptr;
+	}
+
+	mxArray* _time; //!< Persistent array with solution times
+	std::vector<UnitStorage> _units; //!< Outlet storage of all unit operations
+	unsigned int _numTimesteps; //!< Number of anticipated time steps
+	unsigned int _curStep; //!< Index of the current time step
+	bool _inSolution; //!< Determines whether the solution of the original system is currently exported
+};
+
+} // namespace mex
+
+} // namespace cadet
+
+#endif  // CADET_MEX_MATLABSOLUTIONRECORDER_HPP_
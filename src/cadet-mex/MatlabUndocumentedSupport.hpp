@@ -28,4 +28,8 @@
 	extern "C" mxArray* mxCreateUninitNumericArray(size_t ndim, size_t *dims, mxClassID classid, mxComplexity ComplexFlag);
 #endif
 
+#ifndef MATLAB_HAVE_CREATESHAREDDATACOPY
+	extern "C" mxArray* mxCreateSharedDataCopy(mxArray const* pr);
+#endif
+
 #endif  // CADET_MEX_MATLAB_UNDOCUMENTED_SUPPORT_HPP_
@@ -54,7 +54,7 @@
 
 #ifndef CADET_LOGGING_DISABLE
 	template <>
-	cadet::LogLevel cadet::log::RuntimeFilteringLogger<cadet::log::GlobalLogger>::_minLvl = cadet::LogLevel::Trace;
+	std::atomic<cadet::LogLevel> cadet::log::RuntimeFilteringLogger<cadet::log::GlobalLogger>::_minLvl(cadet::LogLevel::Trace);
 #endif
 
 namespace
@@ -195,6 +195,8 @@ extern "C" DLL_EXPORT_SYM void mexFunction(int nlhs, mxArray *plhs[], int nrhs,
 		{
 			if (nrhs != 2)
 				mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'destroy' requires a handle to operate on.\n");
+			cadet::mex::releaseInPlaceRecorder(cadet::mex::convertMat2Ptr<cadet::Driver>(prhs[1]));
+			cadet::mex::releaseBatchDriver(cadet::mex::convertMat2Ptr<cadet::Driver>(prhs[1]));
 			cadet::mex::destroyObject<cadet::Driver>(prhs[1]);
 		}
 		else if (command == "loglevel")
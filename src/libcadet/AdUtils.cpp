@@ -51,22 +51,16 @@ void extractBandedJacobianFromAd(active const* const adVec, unsigned int adDirOf
 	const unsigned int stride = lowerBandwidth + 1 + upperBandwidth;
 	for (unsigned int eq = 0; eq < mat.rows(); ++eq)
 	{
-		// Start with lowest subdiagonal and stay in the range of the columns:
-		// diagDir might be too big for the matrix and, hence, dir ranges between
-		// diagDir - lowerBandwidth <= dir <= diagDir + upperBandwidth
-		unsigned int dir = diagDir - lowerBandwidth + eq % stride;
-
-		// Loop over diagonals
-		for (unsigned int diag = 0; diag < stride; ++diag)
-		{
-			mat.native(eq, diag) = adVec[eq].getADValue(adDirOffset + dir);
-
-			// Wrap around at end of row and jump to lowest subdiagonal
-			if (dir == diagDir + upperBandwidth)
-				dir = diagDir - lowerBandwidth;
-			else
-				++dir;
-		}
+		// The relevant directions diagDir - lowerBandwidth <= dir <= diagDir + upperBandwidth
+		// form one contiguous window in the gradient array of this residual entry. The banded
+		// storage of the row holds exactly this window rotated left by eq % stride (the seed
+		// pattern of prepareAdVectorSeedsForBandMatrix()), so the row is filled by two
+		// contiguous copies instead of an element-wise loop with wrap-around arithmetic
+		double const* const window = adVec[eq].gradientVec() + adDirOffset + diagDir - lowerBandwidth;
+		double* const dest = &mat.native(eq, 0);
+		const unsigned int rot = eq % stride;
+		std::copy(window + rot, window + stride, dest);
+		std::copy(window, window + rot, dest + stride - rot);
 	}
 }
 
@@ -98,6 +92,107 @@ void extractDenseJacobianFromBandedAd(active const* const adVec, unsigned int ro
 	}
 }
 
+unsigned int colorJacobianPattern(const linalg::CompressedSparseMatrix& pattern, unsigned int cols, std::vector<unsigned int>& colors)
+{
+	const std::vector<unsigned int>& rowStart = pattern.rowStart();
+	const std::vector<unsigned int>& colIdx = pattern.cols();
+	const unsigned int nnz = pattern.numNonZero();
+
+	// Build the column -> rows adjacency by a counting sort over the column indices
+	std::vector<unsigned int> colStart(cols + 1, 0);
+	for (unsigned int i = 0; i < nnz; ++i)
+		++colStart[colIdx[i] + 1];
+	for (unsigned int c = 1; c <= cols; ++c)
+		colStart[c] += colStart[c - 1];
+
+	std::vector<unsigned int> colRows(nnz);
+	std::vector<unsigned int> pos(colStart.begin(), colStart.end() - (cols > 0 ? 1 : 0));
+	for (unsigned int r = 0; r < pattern.rows(); ++r)
+	{
+		for (unsigned int i = rowStart[r]; i < rowStart[r + 1]; ++i)
+			colRows[pos[colIdx[i]]++] = r;
+	}
+
+	// Greedy sequential coloring: each column in turn receives the smallest color that is
+	// not taken by any previously colored column it shares a structural non-zero row with.
+	// The array forbidden[] is indexed by color and stamped with the current column index,
+	// which avoids clearing it between columns.
+	colors.assign(cols, 0);
+	std::vector<unsigned int> forbidden(cols, cols);
+	unsigned int numColors = 0;
+	for (unsigned int c = 0; c < cols; ++c)
+	{
+		// Mark the colors of all conflicting columns as forbidden
+		for (unsigned int i = colStart[c]; i < colStart[c + 1]; ++i)
+		{
+			const unsigned int r = colRows[i];
+			for (unsigned int j = rowStart[r]; j < rowStart[r + 1]; ++j)
+			{
+				const unsigned int c2 = colIdx[j];
+				if (c2 < c)
+					forbidden[colors[c2]] = c;
+			}
+		}
+
+		// Pick the smallest admissible color
+		unsigned int color = 0;
+		while (forbidden[color] == c)
+			++color;
+
+		colors[c] = color;
+		numColors = std::max(numColors, color + 1);
+	}
+
+	return numColors;
+}
+
+void prepareAdVectorSeedsForColoredPattern(active* const adVec, unsigned int adDirOffset, const std::vector<unsigned int>& colors)
+{
+	for (unsigned int col = 0; col < colors.size(); ++col)
+	{
+		// Clear previously set directions
+		adVec[col].fillADValue(adDirOffset, 0.0);
+		// Set direction to the color of the column
+		adVec[col].setADValue(adDirOffset + colors[col], 1.0);
+	}
+}
+
+void extractSparseJacobianFromAd(active const* const adVec, unsigned int adDirOffset, const std::vector<unsigned int>& colors, linalg::CompressedSparseMatrix& mat)
+{
+	const std::vector<unsigned int>& rowStart = mat.rowStart();
+	const std::vector<unsigned int>& colIdx = mat.cols();
+	std::vector<double>& values = mat.values();
+
+	// Each element (r, c) was computed in the AD direction assigned to its column
+	for (unsigned int r = 0; r < mat.rows(); ++r)
+	{
+		for (unsigned int i = rowStart[r]; i < rowStart[r + 1]; ++i)
+			values[i] = adVec[r].getADValue(adDirOffset + colors[colIdx[i]]);
+	}
+}
+
+void extractBandedJacobianFromColoredAd(active const* const adVec, unsigned int adDirOffset, const std::vector<unsigned int>& colors,
+	const linalg::CompressedSparseMatrix& pattern, linalg::BandMatrix& mat)
+{
+	const std::vector<unsigned int>& rowStart = pattern.rowStart();
+	const std::vector<unsigned int>& colIdx = pattern.cols();
+	const int lowerBandwidth = static_cast<int>(mat.lowerBandwidth());
+
+	// In-band entries that are not part of the pattern are structural zeros, but the band
+	// storage (and its factorization) does not know that, so they are cleared explicitly
+	mat.setAll(0.0);
+
+	// Each element (r, c) was computed in the AD direction assigned to its column
+	for (unsigned int r = 0; r < pattern.rows(); ++r)
+	{
+		for (unsigned int i = rowStart[r]; i < rowStart[r + 1]; ++i)
+		{
+			const unsigned int c = colIdx[i];
+			mat.native(r, static_cast<unsigned int>(static_cast<int>(c) - static_cast<int>(r) + lowerBandwidth)) = adVec[r].getADValue(adDirOffset + colors[c]);
+		}
+	}
+}
+
 double compareBandedJacobianWithAd(active const* const adVec, unsigned int adDirOffset, unsigned int diagDir, const linalg::BandMatrix& mat)
 {
 	const unsigned int lowerBandwidth = mat.lowerBandwidth();
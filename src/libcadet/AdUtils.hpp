@@ -20,12 +20,15 @@
 
 #include "AutoDiff.hpp"
 
+#include <vector>
+
 namespace cadet
 {
 
 namespace linalg
 {
 	class BandMatrix;
+	class CompressedSparseMatrix;
 
 	namespace detail
 	{
@@ -78,9 +81,63 @@ void extractBandedJacobianFromAd(active const* const adVec, unsigned int adDirOf
  * @param [in] upperBandwidth Upper bandwidth (number of upper superdiagonals) of the banded Jacobian
  * @param [out] mat Dense matrix to be populated with the Jacobian submatrix
  */
-void extractDenseJacobianFromBandedAd(active const* const adVec, unsigned int row, unsigned int adDirOffset, unsigned int diagDir, 
+void extractDenseJacobianFromBandedAd(active const* const adVec, unsigned int row, unsigned int adDirOffset, unsigned int diagDir,
 	unsigned int lowerBandwidth, unsigned int upperBandwidth, linalg::detail::DenseMatrixBase& mat);
 
+/**
+ * @brief Computes a coloring of the Jacobian columns for compressed AD seeding
+ * @details Two columns of the Jacobian can share an AD direction if and only if they do not
+ *          both have a structural non-zero in the same row. This function assigns each column
+ *          a color (i.e., an AD direction index) honoring this rule via a greedy sequential
+ *          coloring in the spirit of Curtis, Powell, and Reid. On a banded pattern without
+ *          structural zeros inside the band it reproduces the band compression used by
+ *          prepareAdVectorSeedsForBandMatrix(), but it requires fewer directions whenever the
+ *          true coupling is sparser than the enclosing band.
+ * @param [in] pattern Sparsity pattern of the Jacobian given as CSR matrix (element values are ignored)
+ * @param [in] cols Number of columns of the Jacobian
+ * @param [out] colors Color of each column, used as AD direction relative to the direction offset
+ * @return Number of colors, which is the number of AD directions required
+ */
+unsigned int colorJacobianPattern(const linalg::CompressedSparseMatrix& pattern, unsigned int cols, std::vector<unsigned int>& colors);
+
+/**
+ * @brief Sets seed vectors on an AD vector according to a column coloring
+ * @details All columns of the same color share one AD direction, which is valid for colorings
+ *          computed by colorJacobianPattern().
+ * @param [in,out] adVec Vector of AD datatypes whose seed vectors are to be set
+ * @param [in] adDirOffset Offset in the AD directions (can be used to move past parameter sensitivity directions)
+ * @param [in] colors Color of each column as computed by colorJacobianPattern()
+ */
+void prepareAdVectorSeedsForColoredPattern(active* const adVec, unsigned int adDirOffset, const std::vector<unsigned int>& colors);
+
+/**
+ * @brief Extracts a sparse Jacobian from color compressed AD seed vectors
+ * @details Uses the results of an AD computation with seed vectors set by
+			prepareAdVectorSeedsForColoredPattern() to assemble the Jacobian into the given
+			CSR matrix, which also serves as the sparsity pattern of the extraction.
+ * @param [in] adVec Vector of AD datatypes with color compressed seed vectors
+ * @param [in] adDirOffset Offset in the AD directions (can be used to move past parameter sensitivity directions)
+ * @param [in] colors Color of each column as computed by colorJacobianPattern()
+ * @param [in,out] mat CSR matrix whose element values are populated with the Jacobian
+ */
+void extractSparseJacobianFromAd(active const* const adVec, unsigned int adDirOffset, const std::vector<unsigned int>& colors, linalg::CompressedSparseMatrix& mat);
+
+/**
+ * @brief Extracts a band matrix from color compressed AD seed vectors
+ * @details Uses the results of an AD computation with seed vectors set by
+			prepareAdVectorSeedsForColoredPattern() to assemble the Jacobian into the given
+			band matrix. Only the elements of the given sparsity pattern are extracted;
+			all other entries inside the band are structural zeros and are cleared, since
+			the band storage does not distinguish them from true matrix elements.
+ * @param [in] adVec Vector of AD datatypes with color compressed seed vectors
+ * @param [in] adDirOffset Offset in the AD directions (can be used to move past parameter sensitivity directions)
+ * @param [in] colors Color of each column as computed by colorJacobianPattern()
+ * @param [in] pattern Sparsity pattern the coloring was computed for (element values are ignored)
+ * @param [out] mat BandMatrix to be populated with the Jacobian
+ */
+void extractBandedJacobianFromColoredAd(active const* const adVec, unsigned int adDirOffset, const std::vector<unsigned int>& colors,
+	const linalg::CompressedSparseMatrix& pattern, linalg::BandMatrix& mat);
+
 /**
  * @brief Compares a banded Jacobian with an AD version derived by band compressed AD seed vectors
  * @details Uses the results of an AD computation with seed vectors set by prepareAdVectorSeedsForBandMatrix() to
@@ -160,6 +217,22 @@ inline void copyToAd(double const* const src, active* const adVec, unsigned int
 		adVec[i].setValue(src[i]);
 }
 
+/**
+ * @brief Copies AD seed directions from one AD vector to another one
+ * @details Copies the full AD datatypes including their derivatives. This is used to share
+ *          prepared seed vectors between structurally identical unit operations. The values
+ *          are overwritten by copyToAd() before each evaluation anyway, so copying them along
+ *          with the seeds is harmless.
+ * @param [in] src Source vector of AD datatypes with prepared seeds
+ * @param [out] dest Destination vector of AD datatypes
+ * @param [in] size Size of the vectors
+ */
+inline void copyAdSeeds(active const* const src, active* const dest, unsigned int size)
+{
+	for (unsigned int i = 0; i < size; ++i)
+		dest[i] = src[i];
+}
+
 /**
  * @brief Resets a vector of AD datatypes erasing both its value and its derivatives
  * @param [in,out] adVec Vector of AD datatypes to be reset
@@ -0,0 +1,103 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides cache line aligned allocation of double arrays.
+ */
+
+#ifndef LIBCADET_ALIGNEDMEMORY_HPP_
+#define LIBCADET_ALIGNEDMEMORY_HPP_
+
+#include "cadet/cadetCompilerInfo.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(CADET_HUGE_PAGES) && defined(__linux__)
+	#include <sys/mman.h>
+#endif
+
+namespace cadet
+{
+
+	//! Alignment of numeric array storage in bytes (cache line, also suffices for AVX-512 loads)
+	const std::size_t cacheLineAlignment = 64;
+
+	//! Minimum allocation size in bytes for which transparent huge pages are advised (one huge page)
+	const std::size_t hugePageThreshold = 2 * 1024 * 1024;
+
+	/**
+	 * @brief Advises the kernel to back the given memory range with transparent huge pages
+	 * @details Huge pages reduce TLB misses when multi-GB arrays (e.g., the particle block
+	 *          Jacobians of large discretizations) are streamed in factorization sweeps.
+	 *          The advised range is shrunk inward to page boundaries. This is a hint only:
+	 *          if huge pages are unavailable or the build or platform does not support
+	 *          the madvise call, the memory simply stays on regular pages. Only active if
+	 *          the code is compiled with CADET_HUGE_PAGES on Linux.
+	 * @param [in] ptr Pointer to the beginning of the memory range (may be @c nullptr)
+	 * @param [in] bytes Size of the memory range in bytes
+	 */
+	inline void adviseHugePages(void* ptr, std::size_t bytes)
+	{
+#if defined(CADET_HUGE_PAGES) && defined(__linux__)
+		if (!ptr || (bytes < hugePageThreshold))
+			return;
+
+		const std::size_t pageSize = 4096;
+		const std::uintptr_t begin = (reinterpret_cast<std::uintptr_t>(ptr) + pageSize - 1) / pageSize * pageSize;
+		const std::uintptr_t end = (reinterpret_cast<std::uintptr_t>(ptr) + bytes) / pageSize * pageSize;
+
+		// Failure is acceptable (e.g., THP disabled system-wide); the allocation still works
+		if (end > begin)
+			madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+#else
+		(void)ptr;
+		(void)bytes;
+#endif
+	}
+
+	/**
+	 * @brief Allocates an array of doubles aligned to cacheLineAlignment
+	 * @details The memory has to be released with alignedDoubleFree(). Aligned storage
+	 *          allows vectorized kernels to use aligned loads and avoids cache line
+	 *          splits at the beginning of the array.
+	 * @param [in] n Number of elements
+	 * @return Pointer to the aligned array
+	 */
+	inline double* alignedDoubleAlloc(std::size_t n)
+	{
+		// Leave room for the alignment shift and for storing the pointer to the raw block
+		char* const raw = new char[n * sizeof(double) + cacheLineAlignment + sizeof(void*)];
+		char* aligned = raw + sizeof(void*);
+		aligned += cacheLineAlignment - reinterpret_cast<std::uintptr_t>(aligned) % cacheLineAlignment;
+
+		// Store the pointer to the raw block just in front of the aligned area
+		*(reinterpret_cast<char**>(aligned) - 1) = raw;
+
+		adviseHugePages(aligned, n * sizeof(double));
+		return reinterpret_cast<double*>(aligned);
+	}
+
+	/**
+	 * @brief Releases an array allocated by alignedDoubleAlloc()
+	 * @param [in] ptr Pointer to the aligned array (may be @c nullptr)
+	 */
+	inline void alignedDoubleFree(double* ptr) CADET_NOEXCEPT
+	{
+		if (ptr)
+			delete[] *(reinterpret_cast<char**>(ptr) - 1);
+	}
+
+} // namespace cadet
+
+#endif  // LIBCADET_ALIGNEDMEMORY_HPP_
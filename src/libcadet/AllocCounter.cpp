@@ -0,0 +1,69 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "AllocCounter.hpp"
+
+#ifdef CADET_DEBUG_COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<std::size_t> allocCounter(0);
+}
+
+namespace cadet
+{
+
+namespace util
+{
+
+	std::size_t heapAllocationCount()
+	{
+		return allocCounter.load(std::memory_order_relaxed);
+	}
+
+} // namespace util
+
+} // namespace cadet
+
+// Count every allocation made through the global operator new and, thus, by all
+// standard containers. Deallocations do not have to be tracked for counting, but
+// operator delete is overridden as well to keep new and delete paired on malloc().
+
+void* operator new(std::size_t size)
+{
+	allocCounter.fetch_add(1, std::memory_order_relaxed);
+	void* const ptr = std::malloc(size);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+#endif  // CADET_DEBUG_COUNT_ALLOCATIONS
@@ -0,0 +1,46 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Debug counter for heap allocations.
+ */
+
+#ifndef LIBCADET_ALLOCCOUNTER_HPP_
+#define LIBCADET_ALLOCCOUNTER_HPP_
+
+#ifdef CADET_DEBUG_COUNT_ALLOCATIONS
+
+#include <cstddef>
+
+namespace cadet
+{
+
+namespace util
+{
+
+	/**
+	 * @brief Returns the number of heap allocations performed since process start
+	 * @details The counter is maintained by a global operator new override (see AllocCounter.cpp)
+	 *          and can be sampled before and after a code section (e.g., a time step) in order
+	 *          to verify that the section does not allocate.
+	 * @return Number of heap allocations since process start
+	 */
+	std::size_t heapAllocationCount();
+
+} // namespace util
+
+} // namespace cadet
+
+#endif  // CADET_DEBUG_COUNT_ALLOCATIONS
+
+#endif  // LIBCADET_ALLOCCOUNTER_HPP_
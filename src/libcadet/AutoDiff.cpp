@@ -16,7 +16,7 @@
 #include "AutoDiff.hpp"
 
 
-#if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
+#if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SFAD_ARENA) || defined(ACTIVE_SETFAD)
 	ACTIVE_INIT
 #endif
 
@@ -27,7 +27,7 @@ namespace cadet
 
 #if defined(ACTIVE_ADOLC)
 
-#elif defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
+#elif defined(ACTIVE_SFAD) || defined(ACTIVE_SFAD_ARENA) || defined(ACTIVE_SETFAD)
 
 #endif
 
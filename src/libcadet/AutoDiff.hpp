@@ -123,27 +123,40 @@
 		}
 	}
 
-#elif defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
+#elif defined(ACTIVE_SFAD) || defined(ACTIVE_SFAD_ARENA) || defined(ACTIVE_SETFAD)
 
 	#define SFAD_DEFAULT_DIR 80
 
-	#if defined(ACTIVE_SFAD)
-		#include "sfad.hpp"
-	#else
+	#if defined(ACTIVE_SETFAD)
 		#include "setfad.hpp"
+	#else
+		#include "sfad.hpp"
 	#endif
+	#include "sfad-batch.hpp"
 
 	#define ACTIVE_INIT SFAD_GLOBAL_GRAD_SIZE
 
 	namespace cadet
 	{
-		
+
 		#if defined(ACTIVE_SFAD)
 			typedef sfad::Fwd<double, sfad::StackStorage> active;
+		#elif defined(ACTIVE_SFAD_ARENA)
+			typedef sfad::Fwd<double, sfad::ArenaStorage> active;
 		#else
 			typedef sfad::FwdET<double, sfad::StackStorage> active;
 		#endif
 
+		/**
+		 * @brief Batch AD type that differentiates @p batch_size scalars together
+		 * @details Gradients are stored direction-major (structure of arrays), so the
+		 *          operations vectorize across the lanes of the batch instead of across
+		 *          the AD directions. Batches are converted from and to strips of
+		 *          @c active scalars via load() and store().
+		 */
+		template <std::size_t batch_size>
+		using activeBatch = sfad::FwdBatch<double, batch_size>;
+
 		namespace ad
 		{
 			/**
@@ -161,12 +174,17 @@
 			/**
 			 * @brief Sets the current number of AD directions (seed vectors)
 			 * @details The number of AD directions must not exceed the value returned by getMaxDirections().
-			 * 
+			 *          With arena-allocated gradient storage (ACTIVE_SFAD_ARENA), the direction count
+			 *          is a pure runtime quantity and may exceed getMaxDirections(); the arena sizes
+			 *          all subsequently created AD datatypes accordingly.
+			 *
 			 * @param [in] numDir Number of required AD directions
 			 */
 			inline void setDirections(size_t n)
 			{
-				cadet_assert(n <= SFAD_DEFAULT_DIR);
+				#if !defined(ACTIVE_SFAD_ARENA)
+					cadet_assert(n <= SFAD_DEFAULT_DIR);
+				#endif
 				sfad::setGradientSize(n);
 			}
 		}
@@ -22,9 +22,98 @@
 
 	#include "common/Timer.hpp"
 
+	#include <cstdint>
+	#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		#include <intrin.h>
+	#elif defined(__x86_64__) || defined(__i386__)
+		#include <x86intrin.h>
+	#else
+		#include <chrono>
+	#endif
+
+namespace cadet
+{
+
+	/**
+	 * @brief Reads a fast monotonic cycle counter for fine-grained cost attribution
+	 * @details Uses the time stamp counter on x86 and falls back to the steady clock tick
+	 *          count on other platforms. The counter is not serializing and only meant for
+	 *          accumulating relative costs of code blocks, not for precise one-shot timings.
+	 * @return Current cycle (or clock tick) count
+	 */
+	inline std::uint64_t benchCycleCount()
+	{
+	#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+	#else
+		return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+	#endif
+	}
+
+} // namespace cadet
+
+#ifdef CADET_SELF_PROFILER
+
+	#include "SelfProfiler.hpp"
+
+	// Feed the phase stack of the sampling self-profiler with the stringified timer names
+	#define BENCH_PROF_PUSH(name) ::cadet::profiler::pushPhase(#name)
+	#define BENCH_PROF_POP() ::cadet::profiler::popPhase()
+	#define BENCH_PROF_SCOPE(name) ::cadet::profiler::ScopedPhase profScope##name(#name);
+
+#else
+
+	#define BENCH_PROF_PUSH(name) ((void)0)
+	#define BENCH_PROF_POP() ((void)0)
+	#define BENCH_PROF_SCOPE(name)
+
+#endif
+
+#ifdef CADET_HARDWARE_COUNTERS
+
+	#include "common/HardwareCounters.hpp"
+
+	#define BENCH_TIMER(name) mutable ::cadet::Timer name; mutable ::cadet::HardwareCounters name##Hwc;
+	#define BENCH_START(name) (BENCH_PROF_PUSH(name), name.start(), name##Hwc.start())
+	#define BENCH_STOP(name) (name##Hwc.stop(), name.stop(), BENCH_PROF_POP())
+
+	/**
+	 * @brief Starts and stops a given timer and its hardware counters on construction and desctruction, respectively
+	 */
+	class BenchmarkScope
+	{
+	public:
+
+		BenchmarkScope(::cadet::Timer& timer, ::cadet::HardwareCounters& hwc) : _timer(timer), _hwc(hwc)
+		{
+			_timer.start();
+			_hwc.start();
+		}
+
+		~BenchmarkScope()
+		{
+			_hwc.stop();
+			_timer.stop();
+		}
+
+	private:
+		::cadet::Timer& _timer;
+		::cadet::HardwareCounters& _hwc;
+	};
+
+	#define BENCH_SCOPE(name) BENCH_PROF_SCOPE(name) BenchmarkScope scope##name(name, name##Hwc)
+
+	/**
+	 * @brief Expands to the descriptions of the hardware counters of a timer declared via BENCH_TIMER()
+	 * @details The prefix has to be a string literal and should match the description of the timer.
+	 */
+	#define BENCH_HWC_DESC(prefix) prefix "Cycles", prefix "Instructions", prefix "CacheRefs", prefix "CacheMisses"
+
+#else
+
 	#define BENCH_TIMER(name) mutable ::cadet::Timer name;
-	#define BENCH_START(name) name.start()
-	#define BENCH_STOP(name) name.stop()
+	#define BENCH_START(name) (BENCH_PROF_PUSH(name), name.start())
+	#define BENCH_STOP(name) (name.stop(), BENCH_PROF_POP())
 
 	/**
 	 * @brief Starts and stops a given timer on construction and desctruction, respectively
@@ -40,7 +129,9 @@
 		::cadet::Timer& _timer;
 	};
 
-	#define BENCH_SCOPE(name) BenchmarkScope scope##name(name)
+	#define BENCH_SCOPE(name) BENCH_PROF_SCOPE(name) BenchmarkScope scope##name(name)
+
+#endif
 
 #else
 
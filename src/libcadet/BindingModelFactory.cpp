@@ -21,19 +21,19 @@ namespace cadet
 	{
 		namespace binding
 		{
-			void registerLinearModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-			void registerLangmuirModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-			void registerAntiLangmuirModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-			void registerBiLangmuirModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-			void registerKumarLangmuirModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-			void registerMobilePhaseModulatorLangmuirModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-			void registerStericMassActionModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-			void registerBiStericMassActionModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-			void registerMultiStateStericMassActionModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-//			void registerSimplifiedMultiStateStericMassActionModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-			void registerSelfAssociationModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-			void registerSaskaModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
-			void registerMultiComponentSpreadingModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings);
+			void registerLinearModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+			void registerLangmuirModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+			void registerAntiLangmuirModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+			void registerBiLangmuirModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+			void registerKumarLangmuirModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+			void registerMobilePhaseModulatorLangmuirModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+			void registerStericMassActionModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+			void registerBiStericMassActionModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+			void registerMultiStateStericMassActionModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+//			void registerSimplifiedMultiStateStericMassActionModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+			void registerSelfAssociationModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+			void registerSaskaModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
+			void registerMultiComponentSpreadingModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings);
 		}
 	}
 
@@ -61,7 +61,7 @@ namespace cadet
 	template <class BindingModel_t>
 	void BindingModelFactory::registerModel(const std::string& name)
 	{
-		_bindingModels[name] = []() { return new BindingModel_t(); };
+		_bindingModels[hashStringRuntime(name)] = []() { return new BindingModel_t(); };
 	}
 
 	template <class BindingModel_t>
@@ -72,7 +72,9 @@ namespace cadet
 
 	model::IBindingModel* BindingModelFactory::create(const std::string& name) const
 	{
-		const auto it = _bindingModels.find(name);
+		// Models are looked up by the hash of their name, which avoids string
+		// allocations and comparisons in the registry
+		const auto it = _bindingModels.find(hashStringRuntime(name));
 		if (it == _bindingModels.end())
 		{
 			// BindingModel was not found
@@ -86,8 +88,9 @@ namespace cadet
 
 	void BindingModelFactory::registerModel(const std::string& name, std::function<model::IBindingModel*()> factory)
 	{
-		if (_bindingModels.find(name) == _bindingModels.end())
-			_bindingModels[name] = factory;
+		const StringHash hashedName = hashStringRuntime(name);
+		if (_bindingModels.find(hashedName) == _bindingModels.end())
+			_bindingModels[hashedName] = factory;
 		else
 			throw InvalidParameterException("IBindingModel implementation with the name " + name + " is already registered and cannot be overwritten");
 	}
@@ -22,6 +22,8 @@
 #include <unordered_map>
 #include <functional>
 
+#include "cadet/ParameterId.hpp"
+
 namespace cadet
 {
 
@@ -32,6 +34,11 @@ namespace cadet
 
 	/**
 	 * @brief Creates binding models
+	 * @details The factory is immutable after initialization: all internal binding models are
+	 *          registered in the constructor and create() only reads the registration map.
+	 *          Additional models may be registered via registerModel(), but only before the
+	 *          factory is used concurrently. Once registration has finished, create() can be
+	 *          called from multiple threads without synchronization.
 	 */
 	class BindingModelFactory
 	{
@@ -53,6 +60,8 @@ namespace cadet
 
 		/**
 		 * @brief Registers the given binding model implementation
+		 * @details May only be called during initialization, that is, before the factory is
+		 *          used from multiple threads. Registration is not synchronized with create().
 		 * @param [in] name Name of the IBindingModel implementation
 		 * @param [in] factory Function that creates an object of the IBindingModel class
 		 */
@@ -75,7 +84,7 @@ namespace cadet
 		template <class BindingModel_t>
 		void registerModel();
 
-		std::unordered_map<std::string, std::function<model::IBindingModel*()>> _bindingModels; //!< Map with factory functions
+		std::unordered_map<StringHash, std::function<model::IBindingModel*()>> _bindingModels; //!< Map with factory functions, keyed by hashed model name
 	};
 
 } // namespace cadet
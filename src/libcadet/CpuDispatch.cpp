@@ -0,0 +1,188 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "CpuDispatch.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <mutex>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define CADET_CPUDISPATCH_MSVC_X86
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define CADET_CPUDISPATCH_GNUC_X86
+#endif
+
+namespace
+{
+
+	/**
+	 * @brief Detects the highest instruction set level the running CPU and OS support
+	 */
+	cadet::dispatch::CpuLevel detectLevel() CADET_NOEXCEPT
+	{
+		using cadet::dispatch::CpuLevel;
+
+#if defined(CADET_CPUDISPATCH_GNUC_X86)
+		// The builtin covers both the CPUID feature flags and the operating system's
+		// vector state support (XGETBV), which is required for AVX and above
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f"))
+			return CpuLevel::Avx512;
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+			return CpuLevel::Avx2;
+		if (__builtin_cpu_supports("sse2"))
+			return CpuLevel::Sse2;
+		return CpuLevel::Scalar;
+#elif defined(CADET_CPUDISPATCH_MSVC_X86)
+		int regs[4] = {0, 0, 0, 0};
+
+		__cpuid(regs, 0);
+		const int maxLeaf = regs[0];
+
+		__cpuid(regs, 1);
+		const bool sse2 = (regs[3] & (1 << 26)) != 0;
+		const bool osxsave = (regs[2] & (1 << 27)) != 0;
+		const bool fma = (regs[2] & (1 << 12)) != 0;
+
+		if (!sse2)
+			return CpuLevel::Scalar;
+
+		// AVX and above additionally require the operating system to save the extended
+		// vector state (XCR0: XMM and YMM for AVX2, plus opmask and ZMM for AVX-512)
+		if (!osxsave || (maxLeaf < 7))
+			return CpuLevel::Sse2;
+
+		const unsigned long long xcr0 = _xgetbv(0);
+		const bool ymmState = (xcr0 & 0x6) == 0x6;
+		const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+
+		__cpuidex(regs, 7, 0);
+		const bool avx2 = (regs[1] & (1 << 5)) != 0;
+		const bool avx512f = (regs[1] & (1 << 16)) != 0;
+
+		if (avx512f && zmmState)
+			return CpuLevel::Avx512;
+		if (avx2 && fma && ymmState)
+			return CpuLevel::Avx2;
+		return CpuLevel::Sse2;
+#else
+		return CpuLevel::Scalar;
+#endif
+	}
+
+	/**
+	 * @brief Parses an instruction set level from the environment variable format
+	 * @details Accepts the level names (case insensitive) as well as their numeric values.
+	 * @return Parsed level, or the given fallback if the string is not recognized
+	 */
+	cadet::dispatch::CpuLevel parseLevel(char const* const str, cadet::dispatch::CpuLevel fallback) CADET_NOEXCEPT
+	{
+		using cadet::dispatch::CpuLevel;
+
+		const CpuLevel levels[] = {CpuLevel::Scalar, CpuLevel::Sse2, CpuLevel::Avx2, CpuLevel::Avx512};
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			char const* const name = cadet::dispatch::toString(levels[i]);
+			bool match = true;
+			unsigned int j = 0;
+			for (; name[j] && str[j]; ++j)
+			{
+				if (std::toupper(str[j]) != name[j])
+				{
+					match = false;
+					break;
+				}
+			}
+			if (match && !name[j] && !str[j])
+				return levels[i];
+		}
+
+		if ((str[0] >= '0') && (str[0] <= '3') && !str[1])
+			return static_cast<CpuLevel>(str[0] - '0');
+
+		return fallback;
+	}
+
+	/**
+	 * @brief Registry of kernel families and their resolved variants
+	 * @details Meyers singleton so that registration from namespace scope objects in
+	 *          other translation units does not depend on static initialization order.
+	 */
+	struct KernelRegistry
+	{
+		std::mutex mutex;
+		std::vector<cadet::dispatch::KernelFamilyInfo> entries;
+	};
+
+	KernelRegistry& registry()
+	{
+		static KernelRegistry reg;
+		return reg;
+	}
+
+} // namespace
+
+namespace cadet
+{
+
+namespace dispatch
+{
+
+	CpuLevel detectedCpuLevel() CADET_NOEXCEPT
+	{
+		static const CpuLevel level = detectLevel();
+		return level;
+	}
+
+	CpuLevel activeCpuLevel() CADET_NOEXCEPT
+	{
+		static const CpuLevel level = [] {
+			const CpuLevel detected = detectedCpuLevel();
+			if (char const* const env = std::getenv("CADET_CPU_LEVEL"))
+				return std::min(detected, parseLevel(env, detected));
+			return detected;
+		}();
+		return level;
+	}
+
+	const char* toString(CpuLevel level) CADET_NOEXCEPT
+	{
+		switch (level)
+		{
+			case CpuLevel::Scalar: return "SCALAR";
+			case CpuLevel::Sse2: return "SSE2";
+			case CpuLevel::Avx2: return "AVX2";
+			case CpuLevel::Avx512: return "AVX512";
+		}
+		return "UNKNOWN";
+	}
+
+	void registerKernelFamily(const char* name, CpuLevel level)
+	{
+		KernelRegistry& reg = registry();
+		std::lock_guard<std::mutex> lock(reg.mutex);
+		reg.entries.push_back(KernelFamilyInfo{name, level});
+	}
+
+	std::vector<KernelFamilyInfo> registeredKernelFamilies()
+	{
+		KernelRegistry& reg = registry();
+		std::lock_guard<std::mutex> lock(reg.mutex);
+		return reg.entries;
+	}
+
+} // namespace dispatch
+
+} // namespace cadet
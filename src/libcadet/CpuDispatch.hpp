@@ -0,0 +1,197 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Runtime CPU feature dispatch for kernel variants.
+ * One libcadet binary is deployed across machine generations with very different vector
+ * units, and building for the lowest common denominator leaves the wider units unused.
+ * Kernel families (e.g., WENO reconstruction, band matrix products, binding batches)
+ * ship several compiled variants of the same function and register them in a
+ * VariantTable; a namespace scope DispatchedKernel object resolves the best variant the
+ * running CPU supports once at library load, so call sites pay a single function pointer
+ * indirection and no per-call feature test. The detected level can be capped via the
+ * environment variable @c CADET_CPU_LEVEL (values @c SCALAR, @c SSE2, @c AVX2,
+ * @c AVX512), e.g., for debugging a variant or for reproducing results across fleets.
+ */
+
+#ifndef LIBCADET_CPUDISPATCH_HPP_
+#define LIBCADET_CPUDISPATCH_HPP_
+
+#include <vector>
+
+#include "cadet/cadetCompilerInfo.hpp"
+
+namespace cadet
+{
+
+namespace dispatch
+{
+
+	/**
+	 * @brief Instruction set levels a kernel variant can target
+	 * @details The levels are cumulative: a CPU reporting a level supports all lower
+	 *          levels as well. Scalar is the portable fallback every family provides.
+	 */
+	enum class CpuLevel : int
+	{
+		Scalar = 0, //!< Portable C++, no vector instructions assumed
+		Sse2 = 1, //!< 128 bit vectors (baseline on all x86-64 CPUs)
+		Avx2 = 2, //!< 256 bit vectors with FMA
+		Avx512 = 3 //!< 512 bit vectors (AVX-512F)
+	};
+
+	/**
+	 * @brief Returns the highest instruction set level the running CPU supports
+	 * @details Detected once via CPUID (including the operating system's vector state
+	 *          support) and cached. On non-x86 platforms CpuLevel::Scalar is returned.
+	 * @return Highest supported instruction set level
+	 */
+	CpuLevel detectedCpuLevel() CADET_NOEXCEPT;
+
+	/**
+	 * @brief Returns the instruction set level kernel dispatch actually uses
+	 * @details The detected level capped by the environment variable @c CADET_CPU_LEVEL
+	 *          if it is set. Evaluated once and cached, so the environment variable has
+	 *          to be set before the library is loaded.
+	 * @return Instruction set level used for resolving kernel variants
+	 */
+	CpuLevel activeCpuLevel() CADET_NOEXCEPT;
+
+	/**
+	 * @brief Returns a human readable name of the given instruction set level
+	 * @param [in] level Instruction set level
+	 * @return Name of the level (e.g., @c "AVX2")
+	 */
+	const char* toString(CpuLevel level) CADET_NOEXCEPT;
+
+	/**
+	 * @brief Name and resolved level of a registered kernel family
+	 */
+	struct KernelFamilyInfo
+	{
+		const char* name; //!< Name of the kernel family (string literal)
+		CpuLevel level; //!< Instruction set level of the resolved variant
+	};
+
+	/**
+	 * @brief Records a kernel family and the variant it resolved to in the central registry
+	 * @details Called by DispatchedKernel on construction; diagnostics (e.g., log output
+	 *          or support dumps) read the registry via registeredKernelFamilies().
+	 * @param [in] name Name of the kernel family, has to be a string literal
+	 * @param [in] level Instruction set level of the resolved variant
+	 */
+	void registerKernelFamily(const char* name, CpuLevel level);
+
+	/**
+	 * @brief Returns all registered kernel families with their resolved levels
+	 * @return Copy of the registry contents
+	 */
+	std::vector<KernelFamilyInfo> registeredKernelFamilies();
+
+	/**
+	 * @brief Table with one function pointer per instruction set level
+	 * @details Variants that do not exist (yet) for a family are set to @c nullptr;
+	 *          resolution falls through to the next lower level. The scalar variant
+	 *          is mandatory.
+	 * @tparam Fn_t Function pointer type shared by all variants of the family
+	 */
+	template <typename Fn_t>
+	struct VariantTable
+	{
+		Fn_t scalar; //!< Portable fallback, must not be @c nullptr
+		Fn_t sse2; //!< SSE2 variant or @c nullptr
+		Fn_t avx2; //!< AVX2 variant or @c nullptr
+		Fn_t avx512; //!< AVX-512 variant or @c nullptr
+	};
+
+	/**
+	 * @brief Resolves the best variant of a table for the given instruction set level
+	 * @details Picks the highest non-null variant that does not exceed @p level and
+	 *          falls back to the scalar variant otherwise.
+	 * @param [in] table Variant table of the kernel family
+	 * @param [in] level Instruction set level to resolve for
+	 * @param [out] chosen Level of the returned variant
+	 * @return Function pointer of the resolved variant
+	 * @tparam Fn_t Function pointer type shared by all variants of the family
+	 */
+	template <typename Fn_t>
+	inline Fn_t resolveVariant(const VariantTable<Fn_t>& table, CpuLevel level, CpuLevel& chosen)
+	{
+		Fn_t fn = table.scalar;
+		chosen = CpuLevel::Scalar;
+
+		if ((level >= CpuLevel::Sse2) && table.sse2)
+		{
+			fn = table.sse2;
+			chosen = CpuLevel::Sse2;
+		}
+		if ((level >= CpuLevel::Avx2) && table.avx2)
+		{
+			fn = table.avx2;
+			chosen = CpuLevel::Avx2;
+		}
+		if ((level >= CpuLevel::Avx512) && table.avx512)
+		{
+			fn = table.avx512;
+			chosen = CpuLevel::Avx512;
+		}
+
+		return fn;
+	}
+
+	/**
+	 * @brief Kernel family with variants resolved once against the running CPU
+	 * @details Intended to live at namespace scope in the translation unit of the kernel
+	 *          family, so resolution and registration happen at library load:
+	 *          @code
+	 *          namespace
+	 *          {
+	 *              const dispatch::DispatchedKernel<wenoKernel_t> wenoReconstruct("weno-reconstruct",
+	 *                  { &wenoReconstructScalar, nullptr, &wenoReconstructAvx2, &wenoReconstructAvx512 });
+	 *          }
+	 *          @endcode
+	 *          Call sites invoke the resolved variant via get() and pay only the usual
+	 *          indirect call, no per-call feature tests.
+	 * @tparam Fn_t Function pointer type shared by all variants of the family
+	 */
+	template <typename Fn_t>
+	class DispatchedKernel
+	{
+	public:
+
+		/**
+		 * @brief Resolves the given variant table and registers the family
+		 * @param [in] name Name of the kernel family, has to be a string literal
+		 * @param [in] table Variant table, the scalar entry must not be @c nullptr
+		 */
+		DispatchedKernel(const char* name, const VariantTable<Fn_t>& table) : _fn(resolveVariant(table, activeCpuLevel(), _level))
+		{
+			registerKernelFamily(name, _level);
+		}
+
+		//! \brief Returns the resolved variant
+		inline Fn_t get() const CADET_NOEXCEPT { return _fn; }
+
+		//! \brief Returns the instruction set level of the resolved variant
+		inline CpuLevel level() const CADET_NOEXCEPT { return _level; }
+
+	private:
+		CpuLevel _level; //!< Level of the resolved variant, initialized by resolveVariant()
+		Fn_t _fn; //!< Resolved variant
+	};
+
+} // namespace dispatch
+
+} // namespace cadet
+
+#endif  // LIBCADET_CPUDISPATCH_HPP_
@@ -0,0 +1,134 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "cadet/cadet-c.h"
+
+#include "Logging.hpp"
+
+#include "common/Driver.hpp"
+#include "common/JsonParameterProvider.hpp"
+
+#include <cstring>
+#include <exception>
+#include <new>
+#include <string>
+
+/**
+ * @brief Driver handle exposed through the C API
+ * @details Wraps the C++ driver and keeps the message of the last error so that it can
+ *          be queried after a failed call. The driver (and with it the model builder,
+ *          the simulator, and the solution storage) lives as long as the handle, which
+ *          lets repeated configure / run cycles reuse internal allocations.
+ */
+struct cdtDriver
+{
+	cadet::Driver driver;
+	std::string lastError;
+};
+
+extern "C"
+{
+
+	cdtDriver* cdtCreateDriver(void)
+	{
+		return new (std::nothrow) cdtDriver();
+	}
+
+	void cdtDestroyDriver(cdtDriver* drv)
+	{
+		delete drv;
+	}
+
+	cdtResult cdtConfigure(cdtDriver* drv, char const* config, size_t length)
+	{
+		if (!drv || !config || (length == 0))
+			return cdtErrorInvalidInputs;
+
+		drv->lastError.clear();
+		try
+		{
+			cadet::JsonParameterProvider pp(config, length);
+
+			// Accept both the content of the "input" group and a full document
+			// containing it, matching the layout of the file based frontends
+			if (pp.exists("input"))
+				pp.pushScope("input");
+
+			drv->driver.configure(pp);
+		}
+		catch (const std::exception& e)
+		{
+			drv->lastError = e.what();
+			return cdtErrorConfiguration;
+		}
+		return cdtOK;
+	}
+
+	cdtResult cdtRun(cdtDriver* drv)
+	{
+		if (!drv)
+			return cdtErrorInvalidInputs;
+
+		drv->lastError.clear();
+		try
+		{
+			drv->driver.run();
+		}
+		catch (const std::exception& e)
+		{
+			drv->lastError = e.what();
+			return cdtErrorSimulation;
+		}
+		return cdtOK;
+	}
+
+	cdtResult cdtGetSolutionTimes(cdtDriver* drv, double const** time, unsigned int* numTime)
+	{
+		if (!drv || !time || !numTime)
+			return cdtErrorInvalidInputs;
+
+		cadet::InternalStorageSystemRecorder* const rec = drv->driver.solution();
+		if (!rec || (rec->numDataPoints() == 0))
+			return cdtErrorNoResults;
+
+		*time = rec->time();
+		*numTime = rec->numDataPoints();
+		return cdtOK;
+	}
+
+	cdtResult cdtGetSolutionOutlet(cdtDriver* drv, unsigned int unitOpId, double const** data, unsigned int* numTime, unsigned int* numComp)
+	{
+		if (!drv || !data || !numTime || !numComp)
+			return cdtErrorInvalidInputs;
+
+		cadet::InternalStorageSystemRecorder* const sysRec = drv->driver.solution();
+		if (!sysRec || (sysRec->numDataPoints() == 0))
+			return cdtErrorNoResults;
+
+		cadet::InternalStorageUnitOpRecorder* const rec = sysRec->unitOperation(static_cast<cadet::UnitOpIdx>(unitOpId));
+		if (!rec || !rec->solutionConfig().storeOutlet)
+			return cdtErrorNoResults;
+
+		*data = rec->outlet();
+		*numTime = rec->numDataPoints();
+		*numComp = rec->numRecordedComponents();
+		return cdtOK;
+	}
+
+	char const* cdtGetLastError(cdtDriver const* drv)
+	{
+		if (!drv)
+			return "Invalid driver handle";
+		return drv->lastError.c_str();
+	}
+
+}
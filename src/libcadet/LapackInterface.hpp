@@ -58,6 +58,12 @@ namespace cadet
 	extern "C" void LAPACK_FUNC(dgbtrs,DGBTRS) (char* trans, lapackInt_t* n, lapackInt_t* kl, lapackInt_t*  ku, lapackInt_t* nrhs,
 			double* ab, lapackInt_t* ldab, lapackInt_t* ipiv, double* b, lapackInt_t* ldb, lapackInt_t* info);
 
+	extern "C" void LAPACK_FUNC(sgbtrf,SGBTRF) (lapackInt_t* m, lapackInt_t* n, lapackInt_t* kl, lapackInt_t* ku, float* ab,
+			lapackInt_t* ldab, lapackInt_t* ipiv, lapackInt_t* info);
+
+	extern "C" void LAPACK_FUNC(sgbtrs,SGBTRS) (char* trans, lapackInt_t* n, lapackInt_t* kl, lapackInt_t*  ku, lapackInt_t* nrhs,
+			float* ab, lapackInt_t* ldab, lapackInt_t* ipiv, float* b, lapackInt_t* ldb, lapackInt_t* info);
+
 	extern "C" void LAPACK_FUNC(dgbmv,DGBMV) (char* trans, lapackInt_t* m, lapackInt_t* n, lapackInt_t* kl, lapackInt_t* ku,
 			double* alpha, double* a, lapackInt_t* lda, double* x, lapackInt_t* incx, double* beta,
 			double* y, lapackInt_t* incy);
@@ -81,12 +87,17 @@ namespace cadet
 			lapackInt_t* LDA, double* TAU, double* C, lapackInt_t* LDC, double* WORK, lapackInt_t* LWORK, lapackInt_t* INFO);
 
 	extern "C" void LAPACK_FUNC(dtrtrs,DTRTRS) (char* UPLO, char* TRANS, char* DIAG, lapackInt_t* N, lapackInt_t* NRHS, double* A, lapackInt_t* LDA,
-			double* B, lapackInt_t* LDB, lapackInt_t* INFO);			
+			double* B, lapackInt_t* LDB, lapackInt_t* INFO);
+
+	extern "C" void LAPACK_FUNC(dsyev,DSYEV) (char* JOBZ, char* UPLO, lapackInt_t* N, double* A, lapackInt_t* LDA, double* W,
+			double* WORK, lapackInt_t* LWORK, lapackInt_t* INFO);
 
 	#ifdef CADET_LAPACK_TRAILING_UNDERSCORE
 		#ifdef CADET_LAPACK_UPPERCASE
 			#define LapackFactorDenseBanded DGBTRF_
 			#define LapackSolveDenseBanded DGBTRS_
+			#define LapackFactorSingleBanded SGBTRF_
+			#define LapackSolveSingleBanded SGBTRS_
 			#define LapackMultiplyDenseBanded DGBMV_
 			#define LapackFactorDense DGETRF_
 			#define LapackSolveDense DGETRS_
@@ -95,9 +106,12 @@ namespace cadet
 			#define LapackFactorLQDense DGELQF_
 			#define LapackMultiplyFactorizedQ DORMLQ_
 			#define LapackSolveTriangular DTRTRS_
+			#define LapackEigSymmetric DSYEV_
 		#else
 			#define LapackFactorDenseBanded dgbtrf_
 			#define LapackSolveDenseBanded dgbtrs_
+			#define LapackFactorSingleBanded sgbtrf_
+			#define LapackSolveSingleBanded sgbtrs_
 			#define LapackMultiplyDenseBanded dgbmv_
 			#define LapackFactorDense dgetrf_
 			#define LapackSolveDense dgetrs_
@@ -106,12 +120,15 @@ namespace cadet
 			#define LapackFactorLQDense dgelqf_
 			#define LapackMultiplyFactorizedQ dormlq_
 			#define LapackSolveTriangular dtrtrs_
+			#define LapackEigSymmetric dsyev_
 		#endif
 	#else
 		#ifdef CADET_LAPACK_PRECEDING_UNDERSCORE
 			#ifdef CADET_LAPACK_UPPERCASE
 				#define LapackFactorDenseBanded _DGBTRF
 				#define LapackSolveDenseBanded _DGBTRS
+				#define LapackFactorSingleBanded _SGBTRF
+				#define LapackSolveSingleBanded _SGBTRS
 				#define LapackMultiplyDenseBanded _DGBMV
 				#define LapackFactorDense _DGETRF
 				#define LapackSolveDense _DGETRS
@@ -120,9 +137,12 @@ namespace cadet
 				#define LapackFactorLQDense _DGELQF
 				#define LapackMultiplyFactorizedQ _DORMLQ
 				#define LapackSolveTriangular _DTRTRS
+				#define LapackEigSymmetric _DSYEV
 			#else
 				#define LapackFactorDenseBanded _dgbtrf
 				#define LapackSolveDenseBanded _dgbtrs
+				#define LapackFactorSingleBanded _sgbtrf
+				#define LapackSolveSingleBanded _sgbtrs
 				#define LapackMultiplyDenseBanded _dgbmv
 				#define LapackFactorDense _dgetrf
 				#define LapackSolveDense _dgetrs
@@ -131,11 +151,14 @@ namespace cadet
 				#define LapackFactorLQDense _dgelqf
 				#define LapackMultiplyFactorizedQ _dormlq
 				#define LapackSolveTriangular _dtrtrs
+				#define LapackEigSymmetric _dsyev
 			#endif
 		#else
 			#ifdef CADET_LAPACK_UPPERCASE
 				#define LapackFactorDenseBanded DGBTRF
 				#define LapackSolveDenseBanded DGBTRS
+				#define LapackFactorSingleBanded SGBTRF
+				#define LapackSolveSingleBanded SGBTRS
 				#define LapackMultiplyDenseBanded DGBMV
 				#define LapackFactorDense DGETRF
 				#define LapackSolveDense DGETRS
@@ -144,9 +167,12 @@ namespace cadet
 				#define LapackFactorLQDense DGELQF
 				#define LapackMultiplyFactorizedQ DORMLQ
 				#define LapackSolveTriangular DTRTRS
+				#define LapackEigSymmetric DSYEV
 			#else
 				#define LapackFactorDenseBanded dgbtrf
 				#define LapackSolveDenseBanded dgbtrs
+				#define LapackFactorSingleBanded sgbtrf
+				#define LapackSolveSingleBanded sgbtrs
 				#define LapackMultiplyDenseBanded dgbmv
 				#define LapackFactorDense dgetrf
 				#define LapackSolveDense dgetrs
@@ -155,6 +181,7 @@ namespace cadet
 				#define LapackFactorLQDense dgelqf
 				#define LapackMultiplyFactorizedQ dormlq
 				#define LapackSolveTriangular dtrtrs
+				#define LapackEigSymmetric dsyev
 			#endif
 		#endif
 	#endif
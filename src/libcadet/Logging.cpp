@@ -13,16 +13,31 @@
 #include "Logging.hpp"
 
 #ifndef CADET_LOGGING_DISABLE
+
+	#include <atomic>
+	#include <mutex>
+
 	namespace
 	{
 		/**
 		 * @brief Receiver of all log messages created in the libcadet library
+		 * @details The receiver is shared by all ISimulator instances in the process. It is
+		 *          read atomically so that installing or removing a receiver from one thread
+		 *          while other threads emit log messages is well defined.
+		 */
+		std::atomic<cadet::ILogReceiver*> logReceiver(nullptr);
+
+		/**
+		 * @brief Serializes calls into the log receiver
+		 * @details Receivers are not required to be thread-safe. When multiple ISimulator
+		 *          instances run concurrently, this mutex guarantees that the receiver sees
+		 *          one complete message at a time.
 		 */
-		cadet::ILogReceiver* logReceiver = nullptr;
+		std::mutex logReceiverMutex;
 	}
 
 	template <>
-	cadet::LogLevel cadet::log::RuntimeFilteringLogger<cadet::log::GlobalLogger>::_minLvl = cadet::LogLevel::Trace;
+	std::atomic<cadet::LogLevel> cadet::log::RuntimeFilteringLogger<cadet::log::GlobalLogger>::_minLvl(cadet::LogLevel::Trace);
 #endif
 
 namespace cadet
@@ -40,14 +55,34 @@ namespace cadet
 	{
 		void emitLog(const char* file, const char* func, const unsigned int line, LogLevel lvl, const char* message)
 		{
-			if (logReceiver)
-				logReceiver->message(file, func, line, lvl, to_string(lvl), message);
+			// Fast path without lock if no receiver is installed
+			if (!logReceiver.load(std::memory_order_relaxed))
+				return;
+
+			std::lock_guard<std::mutex> lock(logReceiverMutex);
+
+			// Re-read under the lock so that a receiver removed by setLogReceiver()
+			// in the meantime is not called anymore
+			cadet::ILogReceiver* const recv = logReceiver.load(std::memory_order_acquire);
+			if (recv)
+				recv->message(file, func, line, lvl, to_string(lvl), message);
+		}
+
+#ifdef CADET_DEFERRED_LOGGING
+		BinaryLogBuffer& logBuffer()
+		{
+			static BinaryLogBuffer buffer;
+			return buffer;
 		}
+#endif
 	}
 
 	void setLogReceiver(ILogReceiver* const recv)
 	{
-		logReceiver = recv;
+		// Take the fan-out lock so that a receiver is never swapped out while a
+		// message is being delivered to it
+		std::lock_guard<std::mutex> lock(logReceiverMutex);
+		logReceiver.store(recv, std::memory_order_release);
 	}
 
 	void setLogLevel(LogLevel lvl)
@@ -62,6 +97,22 @@ namespace cadet
 
 #endif
 
+#if defined(CADET_LOGGING_DISABLE) || !defined(CADET_DEFERRED_LOGGING)
+
+	void drainLogs() { }
+
+#else
+
+	void drainLogs()
+	{
+		cadet::log::logBuffer().drain([](const char* file, const char* func, unsigned int line, LogLevel lvl, const std::string& msg)
+			{
+				cadet::log::emitLog(file, func, line, lvl, msg.c_str());
+			});
+	}
+
+#endif
+
 } // namespace cadet
 
 extern "C"
@@ -80,4 +131,9 @@ extern "C"
 	{
 		return static_cast<typename std::underlying_type<cadet::LogLevel>::type>(cadet::getLogLevel());
 	}
+
+	void cadetDrainLogs()
+	{
+		cadet::drainLogs();
+	}
 }
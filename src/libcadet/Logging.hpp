@@ -21,6 +21,13 @@
 #include "cadet/Logging.hpp"
 #include "common/LoggerBase.hpp"
 
+#ifdef CADET_DEFERRED_LOGGING
+	#include "common/BinaryLogBuffer.hpp"
+
+	#include <cstring>
+	#include <type_traits>
+#endif
+
 namespace cadet
 {
 namespace log
@@ -61,8 +68,130 @@ namespace log
 		}
 	};
 
+#ifdef CADET_DEFERRED_LOGGING
+
+	/**
+	 * @brief Returns the global binary log buffer
+	 */
+	BinaryLogBuffer& logBuffer();
+
+	/**
+	 * @brief Records raw argument values in the global binary log buffer
+	 * @details Instead of formatting via ostream insertion at the call site, arithmetic
+	 *          values, characters, and strings are copied verbatim into a thread local
+	 *          scratch record that is committed to the BinaryLogBuffer. Formatting is
+	 *          deferred until the buffer is drained (see drainLogs()), which takes the
+	 *          conversion cost off the hot path of high-frequency trace points. Types
+	 *          without a binary representation (e.g., vectors) are still formatted
+	 *          immediately and recorded as strings.
+	 */
+	class RingBufferWritePolicy : public BufferedWritePolicyBase<RingBufferWritePolicy>
+	{
+	public:
+		static inline void begin(const char* fileName, const char* funcName, unsigned int line, LogLevel lvl)
+		{
+			std::vector<char>& rec = scratch();
+			rec.clear();
+			logRecordAppendValue(rec, fileName);
+			logRecordAppendValue(rec, funcName);
+			logRecordAppendValue(rec, static_cast<uint32_t>(line));
+			logRecordAppendValue(rec, static_cast<uint8_t>(lvl));
+		}
+
+		static inline void end(LogLevel lvl)
+		{
+			const std::vector<char>& rec = scratch();
+			logBuffer().commit(rec.data(), rec.size());
+		}
+
+		template <class T>
+		static inline void writeObj(LogLevel lvl, const T& obj)
+		{
+			writeDispatch(obj, typename std::is_arithmetic<T>::type());
+		}
+
+		static inline void writeObj(LogLevel lvl, const bool& obj)
+		{
+			logRecordAppendTagged(scratch(), logTag::boolean, static_cast<uint8_t>(obj));
+		}
+
+		static inline void writeObj(LogLevel lvl, const char& obj)
+		{
+			logRecordAppendTagged(scratch(), logTag::character, obj);
+		}
+
+		template <std::size_t N>
+		static inline void writeObj(LogLevel lvl, const char (&obj)[N])
+		{
+			logRecordAppendString(scratch(), obj, std::strlen(obj));
+		}
+
+		static inline void writeObj(LogLevel lvl, char const* const& obj)
+		{
+			logRecordAppendString(scratch(), obj, std::strlen(obj));
+		}
+
+		static inline void writeObj(LogLevel lvl, const std::string& obj)
+		{
+			logRecordAppendString(scratch(), obj.data(), obj.size());
+		}
+
+	private:
+
+		/**
+		 * @brief Returns the thread local scratch space used to assemble a record
+		 */
+		static inline std::vector<char>& scratch()
+		{
+			static thread_local std::vector<char> rec;
+			return rec;
+		}
+
+		/**
+		 * @brief Records an arithmetic value verbatim
+		 */
+		template <class T>
+		static inline void writeDispatch(const T& obj, std::true_type)
+		{
+			writeNumber(obj, typename std::is_integral<T>::type());
+		}
+
+		/**
+		 * @brief Formats a non-arithmetic value immediately and records it as string
+		 */
+		template <class T>
+		static inline void writeDispatch(const T& obj, std::false_type)
+		{
+			std::ostringstream oss;
+			oss << obj;
+			const std::string str = oss.str();
+			logRecordAppendString(scratch(), str.data(), str.size());
+		}
+
+		template <class T>
+		static inline void writeNumber(const T& obj, std::true_type)
+		{
+			if (std::is_signed<T>::value)
+				logRecordAppendTagged(scratch(), logTag::int64, static_cast<int64_t>(obj));
+			else
+				logRecordAppendTagged(scratch(), logTag::uint64, static_cast<uint64_t>(obj));
+		}
+
+		template <class T>
+		static inline void writeNumber(const T& obj, std::false_type)
+		{
+			logRecordAppendTagged(scratch(), logTag::float64, static_cast<double>(obj));
+		}
+	};
+
+	typedef NonFilteringLogger<LibCadetFormattingPolicy, RingBufferWritePolicy> GlobalLogger;
+
+#else
+
 	typedef NonFilteringLogger<LibCadetFormattingPolicy, EmitterWritePolicy> GlobalLogger;
 
+#endif  // CADET_DEFERRED_LOGGING
+
 #ifndef CADET_LOGGING_DISABLE
 	typedef Logger<RuntimeFilteringLogger<GlobalLogger>, LogLevel::CADET_LOGLEVEL_MIN> DoubleFilterLogger;
 #else
@@ -38,6 +38,48 @@ namespace cadet
 	inline double sqr(const double x) CADET_NOEXCEPT { return x * x; }
 #endif
 
+	/**
+	 * @brief Selects one of two values depending on a predicate
+	 * @details Counterpart of the branchless AD selection sel() for plain @c double so that
+	 *          templated kernels can use the same code for both instantiations.
+	 * @param [in] cond Predicate
+	 * @param [in] a Value returned if @p cond is @c true
+	 * @param [in] b Value returned if @p cond is @c false
+	 * @return @p a if @p cond is @c true, otherwise @p b
+	 */
+	inline double sel(const bool cond, const double a, const double b) CADET_NOEXCEPT { return cond ? a : b; }
+
+	/**
+	 * @brief Returns the maximum of two values (@c double counterpart of the AD smax())
+	 */
+	inline double smax(const double a, const double b) CADET_NOEXCEPT { return (a >= b) ? a : b; }
+
+	/**
+	 * @brief Returns the minimum of two values (@c double counterpart of the AD smin())
+	 */
+	inline double smin(const double a, const double b) CADET_NOEXCEPT { return (a <= b) ? a : b; }
+
+	/**
+	 * @brief Computes @f$ b^e @f$ from the precomputed natural logarithm of a positive base @f$ b @f$
+	 * @details pow() internally evaluates a logarithm followed by an exponential. When many
+	 *          exponents share the same positive base (e.g., the characteristic charges of the
+	 *          components in SMA-type isotherms), the logarithm can be hoisted out of the loop
+	 *          and each power reduces to a single exponential. The remaining exp() calls are
+	 *          independent across loop iterations, so a compiler with a vector math library
+	 *          (SVML, SLEEF, libmvec) can batch them.
+	 * @param [in] logBase Natural logarithm of the (positive) base
+	 * @param [in] e Exponent
+	 * @tparam BaseType Type of the base, such as @c active or @c double
+	 * @tparam ExpType Type of the exponent, not wider than @p BaseType
+	 * @return Base raised to the power @p e
+	 */
+	template <typename BaseType, typename ExpType>
+	inline BaseType powFromLog(const BaseType& logBase, const ExpType& e)
+	{
+		using std::exp;
+		return exp(e * logBase);
+	}
+
 } // namespace cadet
 
 #endif  // LIBCADET_MATHUTIL_HPP_
@@ -19,7 +19,10 @@
 #define LIBCADET_MEMORYPOOL_HPP_
 
 #include "common/CompilerSpecific.hpp"
+#include "AlignedMemory.hpp"
 #include <type_traits>
+#include <cstddef>
+#include <vector>
 
 namespace cadet
 {
@@ -38,12 +41,7 @@ namespace cadet
 		/**
 		 * @brief Creates an empty ArrayPool
 		 */
-		ArrayPool() : _mem(nullptr), _numElements(0)
-		{
-#ifdef DEBUG
-			_capacity = 0;
-#endif
-		}
+		ArrayPool() : _mem(nullptr), _numElements(0), _capacity(0) { }
 
 		/**
 		 * @brief Creates an ArrayPool with the given size in bytes
@@ -51,12 +49,7 @@ namespace cadet
 		 * 
 		 * @param [in] maxBytes Size of the pool in bytes
 		 */
-		ArrayPool(unsigned int maxBytes) : _mem(new char[maxBytes]), _numElements(0)
-		{
-#ifdef DEBUG
-			_capacity = maxBytes;
-#endif
-		}
+		ArrayPool(unsigned int maxBytes) : _mem(new char[maxBytes]), _numElements(0), _capacity(maxBytes) { }
 
 		~ArrayPool() CADET_NOEXCEPT { delete[] _mem; }
 
@@ -72,10 +65,7 @@ namespace cadet
 			delete[] _mem;
 			_mem = new char[maxBytes];
 			_numElements = 0;
-
-#ifdef DEBUG
 			_capacity = maxBytes;
-#endif
 		}
 
 		/**
@@ -163,12 +153,369 @@ namespace cadet
 
 		inline const unsigned int numElements() const { return _numElements; }
 
+		/**
+		 * @brief Returns the size of the underlying memory block in bytes
+		 * @return Capacity of the pool in bytes
+		 */
+		inline unsigned int capacityBytes() const CADET_NOEXCEPT { return _capacity; }
+
 	protected:
 		char* _mem; //<! Memory block
 		unsigned int _numElements; //<! Current number of created elements
-#ifdef DEBUG
-		unsigned int _capacity; //<! Capacity of the pool, only available in debug builds
-#endif
+		unsigned int _capacity; //<! Capacity of the pool in bytes
+	};
+
+
+	/**
+	 * @brief Fixed-capacity variant of ArrayPool that lives on the stack
+	 * @details Provides the create() / destroy() interface of ArrayPool on top of an embedded
+	 *          buffer whose capacity is fixed at compile time. Since the buffer is part of the
+	 *          object, a StackArrayPool declared as a local variable hands out stack memory:
+	 *          there is no heap allocation, no pointer indirection, and the workspace is hot in
+	 *          cache and private to the executing thread. Intended for small per-item solves in
+	 *          tight (possibly parallel) loops (e.g., the per-shell nonlinear consistency solves
+	 *          of the binding models); callers have to check capacityBytes() against the
+	 *          required size and fall back to a heap-backed workspace for oversized problems.
+	 * @tparam maxBytes Capacity of the embedded buffer in bytes
+	 */
+	template <unsigned int maxBytes>
+	class StackArrayPool
+	{
+	public:
+
+		/**
+		 * @brief Creates an empty StackArrayPool
+		 */
+		StackArrayPool() CADET_NOEXCEPT : _numElements(0) { }
+
+		/**
+		 * @brief Creates an array in the pool
+		 * @details Since the array is always created in the same memory, previous arrays will be overwritten.
+		 *          Array elements are default constructed.
+		 *
+		 * @param [in] n Number of elements
+		 * @tparam T Type of elements
+		 * @return Pointer to array of the requested size and type
+		 */
+		template <typename T>
+		inline typename std::enable_if<!std::is_arithmetic<T>::value, T* const>::type create(unsigned int n)
+		{
+			cadet_assert(sizeof(T) * n <= maxBytes);
+
+			// Call constructor on every element
+			T* _cur = reinterpret_cast<T*>(_mem);
+			for (unsigned int i = 0; i < n; ++i)
+			{
+				// Default constructor
+				new(_cur) T;
+				++_cur;
+			}
+
+			_numElements = n;
+			return reinterpret_cast<T*>(_mem);
+		}
+
+		/**
+		 * @brief Destroys a currently active array
+		 * @details The destructor of the array elements is called
+		 *
+		 * @tparam T Type of elements
+		 */
+		template <typename T>
+		inline typename std::enable_if<!std::is_arithmetic<T>::value, void>::type destroy()
+		{
+			// Call destructor on every element
+			T* _cur = reinterpret_cast<T*>(_mem);
+			for (unsigned int i = 0; i < _numElements; ++i)
+			{
+				_cur->~T();
+				++_cur;
+			}
+			_numElements = 0;
+		}
+
+		/**
+		 * @brief Creates an array of integral / arithmetic types (e.g., double, int) in the pool
+		 * @details Since the array is always created in the same memory, previous arrays will be overwritten.
+		 *          Array elements are initialized to zero.
+		 *
+		 * @param [in] n Number of elements
+		 * @tparam T Type of elements
+		 * @return Pointer to array of the requested size and type
+		 */
+		template <typename T>
+		inline typename std::enable_if<std::is_arithmetic<T>::value, T* const>::type create(unsigned int n)
+		{
+			cadet_assert(sizeof(T) * n <= maxBytes);
+
+			// Arithmetic types do not need constructor, but initialization to zero
+			T* _cur = reinterpret_cast<T*>(_mem);
+			for (unsigned int i = 0; i < n; ++i)
+			{
+				*_cur = T(0);
+				++_cur;
+			}
+
+			_numElements = n;
+			return reinterpret_cast<T*>(_mem);
+		}
+
+		/**
+		 * @brief Destroys a currently active array
+		 * @tparam T Type of elements
+		 */
+		template <typename T>
+		inline typename std::enable_if<std::is_arithmetic<T>::value, void>::type destroy()
+		{
+			// Call to destructor is not required
+			_numElements = 0;
+		}
+
+		inline const unsigned int numElements() const { return _numElements; }
+
+		/**
+		 * @brief Returns the size of the embedded buffer in bytes
+		 * @return Capacity of the pool in bytes
+		 */
+		CADET_CONSTEXPR static inline unsigned int capacityBytes() CADET_NOEXCEPT { return maxBytes; }
+
+	protected:
+		alignas(double) char _mem[maxBytes]; //<! Embedded buffer
+		unsigned int _numElements; //<! Current number of created elements
+	};
+
+
+	/**
+	 * @brief Bump allocator for short-lived data that is reclaimed wholesale
+	 * @details A ScratchArena hands out memory from a list of blocks by advancing an offset.
+	 *          Individual allocations are never freed; instead, reset() rewinds the arena to
+	 *          its beginning while keeping the blocks, such that subsequent allocations reuse
+	 *          the already acquired memory. After the first pass through a code section that
+	 *          is scoped by reset() calls (e.g., a configure() run), the arena does not touch
+	 *          the heap anymore. This avoids fragmenting the heap of long-lived processes
+	 *          with many small transient allocations.
+	 *
+	 *          Use ScratchAllocator to back standard containers with an arena.
+	 */
+	class ScratchArena
+	{
+	public:
+
+		/**
+		 * @brief Creates a ScratchArena with the default block size
+		 */
+		ScratchArena() : _blockSize(4096), _curBlock(0), _offset(0) { }
+
+		/**
+		 * @brief Creates a ScratchArena with the given block size
+		 * @param [in] blockSize Size of one memory block in bytes
+		 */
+		explicit ScratchArena(std::size_t blockSize) : _blockSize(blockSize), _curBlock(0), _offset(0) { }
+
+		~ScratchArena() CADET_NOEXCEPT
+		{
+			for (Block& b : _blocks)
+				delete[] b.mem;
+		}
+
+		ScratchArena(const ScratchArena&) = delete;
+		ScratchArena& operator=(const ScratchArena&) = delete;
+
+		/**
+		 * @brief Allocates memory from the arena
+		 * @details Advances the offset in the current block or acquires a new block from the
+		 *          heap if no block with sufficient remaining space is available. Requests
+		 *          bigger than the block size get a dedicated block of their own.
+		 * @param [in] bytes Number of bytes to allocate
+		 * @param [in] alignment Required alignment of the returned pointer in bytes
+		 * @return Pointer to uninitialized memory of the requested size
+		 */
+		void* allocate(std::size_t bytes, std::size_t alignment)
+		{
+			while (_curBlock < _blocks.size())
+			{
+				const std::size_t aligned = alignUp(_offset, alignment);
+				if (aligned + bytes <= _blocks[_curBlock].size)
+				{
+					_offset = aligned + bytes;
+					return _blocks[_curBlock].mem + aligned;
+				}
+
+				// Current block exhausted, move on to the next one
+				++_curBlock;
+				_offset = 0;
+			}
+
+			// No block with sufficient space left, acquire a new one
+			const std::size_t size = (bytes > _blockSize) ? bytes : _blockSize;
+			_blocks.push_back(Block{new char[size], size});
+			_curBlock = _blocks.size() - 1;
+			_offset = bytes;
+			return _blocks[_curBlock].mem;
+		}
+
+		/**
+		 * @brief Rewinds the arena to its beginning without releasing memory
+		 * @details All pointers previously obtained from the arena are invalidated. The
+		 *          acquired blocks are kept and reused by subsequent allocations.
+		 */
+		inline void reset() CADET_NOEXCEPT
+		{
+			_curBlock = 0;
+			_offset = 0;
+		}
+
+		/**
+		 * @brief Returns the total size of all acquired memory blocks in bytes
+		 * @return Capacity of the arena in bytes
+		 */
+		inline std::size_t capacityBytes() const CADET_NOEXCEPT
+		{
+			std::size_t sum = 0;
+			for (const Block& b : _blocks)
+				sum += b.size;
+			return sum;
+		}
+
+	protected:
+
+		struct Block
+		{
+			char* mem; //<! Memory block
+			std::size_t size; //<! Size of the block in bytes
+		};
+
+		static inline std::size_t alignUp(std::size_t offset, std::size_t alignment) CADET_NOEXCEPT
+		{
+			return (offset + alignment - 1) / alignment * alignment;
+		}
+
+		std::size_t _blockSize; //<! Minimum size of newly acquired blocks in bytes
+		std::vector<Block> _blocks; //<! Acquired memory blocks
+		std::size_t _curBlock; //<! Index of the block allocations are currently served from
+		std::size_t _offset; //<! Offset of the next allocation in the current block
+	};
+
+
+	/**
+	 * @brief Standard conforming allocator backed by a ScratchArena
+	 * @details Allows standard containers (e.g., @c std::vector) to draw their memory from a
+	 *          ScratchArena. Deallocation is a no-op since arena memory is reclaimed wholesale
+	 *          by ScratchArena::reset(). Containers using this allocator must not outlive a
+	 *          reset() of the arena.
+	 * @tparam T Type of the allocated elements
+	 */
+	template <typename T>
+	class ScratchAllocator
+	{
+	public:
+		typedef T value_type;
+
+		template <typename U>
+		struct rebind { typedef ScratchAllocator<U> other; };
+
+		explicit ScratchAllocator(ScratchArena& arena) CADET_NOEXCEPT : _arena(&arena) { }
+
+		template <typename U>
+		ScratchAllocator(const ScratchAllocator<U>& other) CADET_NOEXCEPT : _arena(other.arena()) { }
+
+		inline T* allocate(std::size_t n)
+		{
+			return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		inline void deallocate(T*, std::size_t) CADET_NOEXCEPT { }
+
+		inline ScratchArena* arena() const CADET_NOEXCEPT { return _arena; }
+
+	protected:
+		ScratchArena* _arena; //<! Arena serving the allocations, not owned by the allocator
+	};
+
+	template <typename T, typename U>
+	inline bool operator==(const ScratchAllocator<T>& a, const ScratchAllocator<U>& b) CADET_NOEXCEPT { return a.arena() == b.arena(); }
+
+	template <typename T, typename U>
+	inline bool operator!=(const ScratchAllocator<T>& a, const ScratchAllocator<U>& b) CADET_NOEXCEPT { return a.arena() != b.arena(); }
+
+	/**
+	 * @brief Vector drawing its memory from a ScratchArena
+	 * @tparam T Type of the elements
+	 */
+	template <typename T>
+	using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+
+	/**
+	 * @brief Pooled workspace array that grows lazily and can be released between uses
+	 * @details Holds a single array of elements that is only (re)allocated when a request
+	 *          exceeds the current capacity. Repeated require() calls with the same or a
+	 *          smaller size reuse the existing memory, e.g., across reinitializations of a
+	 *          simulator. release() returns the memory to the heap, which keeps the resident
+	 *          set of processes running many simulators in turns small; the next require()
+	 *          transparently reacquires the workspace. Elements are default constructed on
+	 *          allocation and growing discards the previous contents.
+	 * @tparam T Type of the elements
+	 */
+	template <typename T>
+	class LazyWorkspace
+	{
+	public:
+
+		LazyWorkspace() CADET_NOEXCEPT : _mem(nullptr), _capacity(0) { }
+		~LazyWorkspace() CADET_NOEXCEPT { delete[] _mem; }
+
+		LazyWorkspace(const LazyWorkspace&) = delete;
+		LazyWorkspace& operator=(const LazyWorkspace&) = delete;
+
+		/**
+		 * @brief Acquires a workspace of at least @p n elements
+		 * @details Reuses the current array if it is big enough, otherwise replaces it by a
+		 *          bigger one. Growing discards the previous contents.
+		 * @param [in] n Number of elements
+		 * @return Pointer to the workspace array
+		 */
+		inline T* require(std::size_t n)
+		{
+			if (n > _capacity)
+			{
+				delete[] _mem;
+				_mem = nullptr;
+				_capacity = 0;
+
+				_mem = new T[n];
+				_capacity = n;
+				adviseHugePages(_mem, n * sizeof(T));
+			}
+			return _mem;
+		}
+
+		/**
+		 * @brief Returns the current workspace array
+		 * @return Pointer to the workspace array, or @c nullptr if none has been acquired
+		 */
+		inline T* get() const CADET_NOEXCEPT { return _mem; }
+
+		/**
+		 * @brief Releases the workspace memory
+		 * @details All pointers previously obtained from the workspace are invalidated.
+		 */
+		inline void release() CADET_NOEXCEPT
+		{
+			delete[] _mem;
+			_mem = nullptr;
+			_capacity = 0;
+		}
+
+		/**
+		 * @brief Returns the size of the currently held array in bytes
+		 * @return Capacity of the workspace in bytes
+		 */
+		inline std::size_t capacityBytes() const CADET_NOEXCEPT { return _capacity * sizeof(T); }
+
+	protected:
+		T* _mem; //<! Workspace array
+		std::size_t _capacity; //<! Number of elements the array holds
 	};
 
 } // namespace cadet
@@ -17,12 +17,21 @@
 #include "cadet/InletProfile.hpp"
 #include "cadet/ExternalFunction.hpp"
 
+#include "cadet/HashUtil.hpp"
+
 #include "model/ModelSystemImpl.hpp"
 
 #include "model/GeneralRateModel.hpp"
+#include "model/GeneralRateModel2D.hpp"
+#include "model/CstrModel.hpp"
 #include "model/InletModel.hpp"
 #include "model/OutletModel.hpp"
 
+#include "AllocCounter.hpp"
+
+#include "LoggingUtils.hpp"
+#include "Logging.hpp"
+
 #include <sstream>
 #include <iomanip>
 
@@ -42,10 +51,15 @@ namespace cadet
 		} // namespace extfun
 	} // namespace model
 
-	ModelBuilder::ModelBuilder()
+	ModelBuilder::ModelBuilder() : _cacheCapacity(8)
 	{
+#ifdef CADET_DEBUG_COUNT_ALLOCATIONS
+		_lastBuildAllocCount = 0;
+#endif
 		// Register all available models
 		registerModel<model::GeneralRateModel>();
+		registerModel<model::GeneralRateModel2D>();
+		registerModel<model::CstrModel>();
 		registerModel<model::InletModel>();
 		registerModel<model::OutletModel>();
 
@@ -61,12 +75,16 @@ namespace cadet
 	{
 		for (IModelSystem* model : _models)
 			delete model;
+
+		for (auto& entry : _modelCache)
+			delete entry.second;
 	}
 
 	template <class UnitOpModel_t>
 	void ModelBuilder::registerModel(const std::string& name)
 	{
 		_modelCreators[name] = [](UnitOpIdx uoId) { return new UnitOpModel_t(uoId); };
+		_modelStructureHashes[name] = [](IParameterProvider& paramProvider) { return UnitOpModel_t::structureHash(paramProvider); };
 	}
 
 	template <class UnitOpModel_t>
@@ -77,6 +95,9 @@ namespace cadet
 
 	IModelSystem* ModelBuilder::createSystem(IParameterProvider& paramProvider)
 	{
+#ifdef CADET_DEBUG_COUNT_ALLOCATIONS
+		const std::size_t allocsBeforeBuild = util::heapAllocationCount();
+#endif
 		model::ModelSystem* sys = new model::ModelSystem();
 		
 		// Create and configure all unit operations
@@ -116,11 +137,16 @@ namespace cadet
 		if (success)
 		{
 			_models.push_back(sys);
+#ifdef CADET_DEBUG_COUNT_ALLOCATIONS
+			_lastBuildAllocCount = util::heapAllocationCount() - allocsBeforeBuild;
+			LOG(Debug) << "Model system build performed " << _lastBuildAllocCount << " heap allocations";
+#endif
 			return sys;
 		}
 		else
 		{
-			delete sys;
+			// Salvage pooled unit operations before deleting the system
+			destroySystem(sys);
 			return nullptr;
 		}
 	}
@@ -146,6 +172,17 @@ namespace cadet
 
 	void ModelBuilder::destroySystem(IModelSystem* sys)
 	{
+		if (sys)
+		{
+			// Salvage unit operations for the model structure cache before
+			// the system deletes them in its destructor
+			while (sys->numModels() > 0)
+			{
+				IModel* const unitOp = sys->getModel(sys->numModels() - 1);
+				sys->removeModel(unitOp);
+				destroyUnitOperation(unitOp);
+			}
+		}
 		delete sys;
 	}
 
@@ -159,6 +196,38 @@ namespace cadet
 			return nullptr;
 		}
 
+		// Try to reuse a pooled instance with identical structure whose parameters
+		// are then just overwritten by reconfigure(), skipping all allocations
+		uint64_t structHash = 0;
+		bool hasHash = false;
+		const auto itHash = _modelStructureHashes.find(uoType);
+		if ((_cacheCapacity > 0) && (itHash != _modelStructureHashes.end()))
+		{
+			hash_combine(structHash, uoType);
+			hash_combine(structHash, static_cast<uint64_t>(uoId));
+			hash_combine(structHash, itHash->second(paramProvider));
+			hasHash = true;
+
+			for (auto itCache = _modelCache.begin(); itCache != _modelCache.end(); ++itCache)
+			{
+				if (itCache->first != structHash)
+					continue;
+
+				IUnitOperation* const cached = itCache->second;
+				_modelCache.erase(itCache);
+
+				if (cached->reconfigure(paramProvider))
+				{
+					_leasedModels[cached] = structHash;
+					return cached;
+				}
+
+				// Reconfiguration failed, fall back to building the model from scratch
+				delete cached;
+				break;
+			}
+		}
+
 		// Call factory function (thanks to type erasure of std::function we can store 
 		// all factory functions in one container)
 		IUnitOperation* const model = it->second(uoId);
@@ -169,6 +238,9 @@ namespace cadet
 			return nullptr;
 		}
 
+		if (hasHash)
+			_leasedModels[model] = structHash;
+
 		return model;
 	}
 
@@ -187,13 +259,49 @@ namespace cadet
 
 	void ModelBuilder::destroyUnitOperation(IModel* unitOp)
 	{
+		if (!unitOp)
+			return;
+
+		// Recycle instances with known structure hash into the cache instead of deleting them
+		const auto it = _leasedModels.find(unitOp);
+		if (it != _leasedModels.end())
+		{
+			_modelCache.emplace_front(it->second, static_cast<IUnitOperation*>(unitOp));
+			_leasedModels.erase(it);
+
+			// Evict least recently used entries
+			while (_modelCache.size() > _cacheCapacity)
+			{
+				delete _modelCache.back().second;
+				_modelCache.pop_back();
+			}
+			return;
+		}
+
 		delete unitOp;
 	}
 
+	void ModelBuilder::modelCacheCapacity(unsigned int cap)
+	{
+		_cacheCapacity = cap;
+		while (_modelCache.size() > _cacheCapacity)
+		{
+			delete _modelCache.back().second;
+			_modelCache.pop_back();
+		}
+	}
+
+	void ModelBuilder::clearModelCache()
+	{
+		for (auto& entry : _modelCache)
+			delete entry.second;
+		_modelCache.clear();
+	}
+
 	void ModelBuilder::registerInletType(const std::string& name, std::function<IInletProfile*(void)> factory)
 	{
 		if (_inletCreators.find(name) == _inletCreators.end())
-			_inletCreators[name] = factory;
+			_inletCreators[name] = std::move(factory);
 		else
 			throw std::invalid_argument("INLET_TYPE " + name + " is already registered and cannot be overwritten");
 	}
@@ -201,7 +309,7 @@ namespace cadet
 	void ModelBuilder::registerExternalFunctionType(const std::string& name, std::function<IExternalFunction*(void)> factory)
 	{
 		if (_extFunCreators.find(name) == _extFunCreators.end())
-			_extFunCreators[name] = factory;
+			_extFunCreators[name] = std::move(factory);
 		else
 			throw std::invalid_argument("EXTFUN_TYPE " + name + " is already registered and cannot be overwritten");
 	}
@@ -24,6 +24,9 @@
 
 #include <vector>
 #include <string>
+#include <list>
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
 #include <functional>
 
@@ -35,6 +38,15 @@ class IInletProfile;
 
 /**
  * @brief Provides functionality to build a model
+ * @details The factory maps (_modelCreators, _inletCreators, _extFunCreators, and the
+ *          BindingModelFactory) are filled in the constructor and are immutable afterwards,
+ *          except for registerInletType() and registerExternalFunctionType() which may only
+ *          be called during initialization. The create*() functions then only read the maps.
+ *
+ *          A ModelBuilder instance is confined to one thread at a time: createSystem(),
+ *          createUnitOperation(), and the model cache mutate per-instance state without
+ *          synchronization. For concurrent simulations, use one ModelBuilder per thread
+ *          (see the thread safety notes in cadet.hpp).
  */
 class ModelBuilder : public IModelBuilder, public IConfigHelper
 {
@@ -60,6 +72,35 @@ public:
 	virtual model::IBindingModel* createBindingModel(const std::string& name) const;
 	virtual IExternalFunction* createExternalFunction(const std::string& type) const;
 
+	/**
+	 * @brief Returns the maximum number of pooled model instances
+	 * @return Capacity of the model structure cache
+	 */
+	inline unsigned int modelCacheCapacity() const CADET_NOEXCEPT { return _cacheCapacity; }
+
+	/**
+	 * @brief Sets the maximum number of pooled model instances
+	 * @details Destroyed unit operations whose structure hash is known are pooled instead of
+	 *          deleted and handed back by createUnitOperation() if the requested discretization
+	 *          matches, skipping all memory allocations of configure(). A capacity of @c 0
+	 *          disables the cache. Excess entries are evicted in least recently used order.
+	 * @param [in] cap Maximum number of pooled model instances
+	 */
+	void modelCacheCapacity(unsigned int cap);
+
+	/**
+	 * @brief Removes and deletes all pooled model instances
+	 */
+	void clearModelCache();
+
+#ifdef CADET_DEBUG_COUNT_ALLOCATIONS
+	/**
+	 * @brief Returns the number of heap allocations of the last successful createSystem() call
+	 * @return Number of heap allocations performed while building the last model system
+	 */
+	inline std::size_t lastBuildAllocationCount() const CADET_NOEXCEPT { return _lastBuildAllocCount; }
+#endif
+
 protected:
 
 	/**
@@ -81,14 +122,24 @@ protected:
 	BindingModelFactory _bindingModels; //!< Factory for IBindingModel implementations
 
 	typedef std::unordered_map<std::string, std::function<IUnitOperation*(UnitOpIdx)>> ModelFactoryContainer_t;
+	typedef std::unordered_map<std::string, std::function<uint64_t(IParameterProvider&)>> ModelHashContainer_t;
 	typedef std::unordered_map<std::string, std::function<IInletProfile*(void)>> InletFactoryContainer_t;
 	typedef std::unordered_map<std::string, std::function<IExternalFunction*(void)>> ExternalFunctionFactoryContainer_t;
 
 	ModelFactoryContainer_t _modelCreators; //!< Map with factory functions for models
+	ModelHashContainer_t _modelStructureHashes; //!< Map with structure hash functions for models
 	InletFactoryContainer_t _inletCreators; //!< Map with factory functions for inlet profiles
 	ExternalFunctionFactoryContainer_t _extFunCreators; //!< Map with factory functions for external functions
 
 	std::vector<IModelSystem*> _models; //!< Models
+
+	std::list<std::pair<uint64_t, IUnitOperation*>> _modelCache; //!< Pooled model instances keyed by structure hash, most recently used in front
+	std::unordered_map<IModel const*, uint64_t> _leasedModels; //!< Structure hashes of pooled instances currently handed out
+	unsigned int _cacheCapacity; //!< Maximum number of pooled model instances
+
+#ifdef CADET_DEBUG_COUNT_ALLOCATIONS
+	std::size_t _lastBuildAllocCount; //!< Heap allocations of the last successful createSystem() call
+#endif
 };
 
 } // namespace cadet
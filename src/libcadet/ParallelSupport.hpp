@@ -1,9 +1,9 @@
 // =============================================================================
 //  CADET - The Chromatography Analysis and Design Toolkit
-//  
+//
 //  Copyright © 2008-2017: The CADET Authors
 //            Please see the AUTHORS and CONTRIBUTORS file.
-//  
+//
 //  All rights reserved. This program and the accompanying materials
 //  are made available under the terms of the GNU Public License v3.0 (or, at
 //  your option, any later version) which accompanies this distribution, and
@@ -11,19 +11,370 @@
 // =============================================================================
 
 /**
- * @file 
+ * @file
  * Helper functions and macros for parallelization.
  */
 
 #ifndef LIBCADET_PARALLEL_SUPPORT_HPP_
 #define LIBCADET_PARALLEL_SUPPORT_HPP_
 
+#include <cstddef>
+
 #ifdef CADET_PARALLELIZE
+
+	#include <tbb/tbb.h>
+
+	#define TBB_PREVIEW_GLOBAL_CONTROL 1
+	#include <tbb/global_control.h>
+
+	#include <atomic>
+	#include <cstdlib>
+	#include <memory>
+	#include <thread>
+
+	#if defined(__linux__)
+		#include <sched.h>
+	#endif
+
 	#define CADET_PARFOR_END )
 	#define CADET_PARNODE_END })
+
 #else
+
 	#define CADET_PARFOR_END
 	#define CADET_PARNODE_END
+
+#endif
+
+namespace cadet
+{
+
+namespace util
+{
+
+#ifdef CADET_PARALLELIZE
+
+	/**
+	 * @brief Manages the process-wide worker thread pool
+	 * @details All parallel regions in libcadet (system-level loops over unit operations in
+	 *          ModelSystem as well as unit-level loops over, e.g., particle blocks in the
+	 *          general rate model) are executed by a single TBB work-stealing pool. Nested
+	 *          regions compose in this pool without spawning additional threads, which rules
+	 *          out the oversubscription known from naively nested parallel runtimes. Hence,
+	 *          no arbitration between the nesting levels is required beyond sharing the pool.
+	 *
+	 *          This class owns the process-wide concurrency limit and keeps it alive between
+	 *          time integration runs such that the pool is not torn down and recreated on
+	 *          every call to ISimulator::integrate(). It is initialized once per process on
+	 *          first use and can optionally pin worker threads round-robin to processor cores
+	 *          (on Linux), which stabilizes the mapping of work to cores and, together with
+	 *          affinity-guided partitioning (see AffinityPartitioner), keeps repeatedly
+	 *          processed data in the cache and memory domain that first touched it.
+	 */
+	class ThreadPool
+	{
+	public:
+
+		/**
+		 * @brief Returns the process-wide thread pool
+		 * @return Singleton ThreadPool object
+		 */
+		static inline ThreadPool& instance()
+		{
+			static ThreadPool tp;
+			return tp;
+		}
+
+		/**
+		 * @brief Applies the given concurrency limit to the process-wide pool
+		 * @details The limit persists until it is changed by another call to this function.
+		 *          Calling it again with the same value is a no-op, in particular, the pool
+		 *          is not recreated between time integration runs.
+		 *
+		 *          On the first call, worker pinning is enabled if the environment variable
+		 *          @c CADET_PARALLEL_PIN is set.
+		 * @param [in] maxThreads Maximum number of threads to use, @c 0 uses the TBB default
+		 */
+		inline void ensureInitialized(unsigned int maxThreads)
+		{
+			if (!_configured)
+			{
+				_configured = true;
+				if (std::getenv("CADET_PARALLEL_PIN"))
+					pinWorkersToCores(true);
+			}
+
+			if (maxThreads == _maxThreads)
+				return;
+
+			_maxThreads = maxThreads;
+			if (maxThreads > 0)
+				_limit.reset(new tbb::global_control(tbb::global_control::max_allowed_parallelism, maxThreads));
+			else
+				_limit.reset();
+		}
+
+		/**
+		 * @brief Returns the configured concurrency limit
+		 * @return Maximum number of threads, @c 0 if the TBB default is used
+		 */
+		inline unsigned int maxThreads() const { return _maxThreads; }
+
+		/**
+		 * @brief Enables or disables pinning of worker threads to processor cores
+		 * @details Worker threads entering the pool are pinned round-robin to the available
+		 *          cores. Only supported on Linux, a no-op on other platforms.
+		 * @param [in] enable Determines whether pinning is enabled or disabled
+		 */
+		inline void pinWorkersToCores(bool enable)
+		{
+			_pinner.observe(enable);
+		}
+
+	private:
+
+		/**
+		 * @brief Pins threads entering the scheduler round-robin to processor cores
+		 */
+		class PinningObserver : public tbb::task_scheduler_observer
+		{
+		public:
+			PinningObserver() : _nextCore(0) { }
+
+			virtual void on_scheduler_entry(bool isWorker)
+			{
+#if defined(__linux__)
+				const unsigned int numCores = std::thread::hardware_concurrency();
+				if (numCores == 0)
+					return;
+
+				const unsigned int core = _nextCore++ % numCores;
+				cpu_set_t cpuSet;
+				CPU_ZERO(&cpuSet);
+				CPU_SET(core, &cpuSet);
+				sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+#endif
+			}
+
+		private:
+			std::atomic<unsigned int> _nextCore; //!< Next core a thread is pinned to
+		};
+
+		ThreadPool() : _limit(), _pinner(), _maxThreads(0), _configured(false) { }
+
+		std::unique_ptr<tbb::global_control> _limit; //!< Process-wide concurrency limit, @c nullptr if the TBB default is used
+		PinningObserver _pinner; //!< Pins worker threads to cores when enabled
+		unsigned int _maxThreads; //!< Configured concurrency limit, @c 0 if the TBB default is used
+		bool _configured; //!< Determines whether one-time configuration has run
+	};
+
+	/**
+	 * @brief Remembers which worker executed which part of a loop and replays this mapping
+	 * @details Passed to parallelBatchedFor() to bias the scheduler towards executing the
+	 *          same iteration range on the same worker in repeated runs of the loop. With
+	 *          pinned workers (see ThreadPool::pinWorkersToCores()), this keeps each batch
+	 *          of, e.g., particle blocks on the core (and thus cache and memory domain)
+	 *          that processed it before. One object must not be shared between loops that
+	 *          run concurrently.
+	 */
+	typedef tbb::affinity_partitioner AffinityPartitioner;
+
+	/**
+	 * @brief Runs a loop of many small independent iterations in parallel batches
+	 * @details Adjacent iterations are grouped into batches of (at least) @p batchSize
+	 *          elements that are executed by one task. For loops over many identical
+	 *          small systems (e.g., the per-cell particle blocks of the GRM), this
+	 *          amortizes the scheduling overhead of a task over a whole batch and keeps
+	 *          adjacent blocks, which are contiguous in memory, on the same core. The
+	 *          batch boundary is also the natural staging granularity if a batch is ever
+	 *          dispatched to an accelerator instead of a worker thread. In serial builds,
+	 *          this function degrades to a plain loop.
+	 * @param [in] first Index of the first iteration
+	 * @param [in] last Index past the last iteration
+	 * @param [in] batchSize Minimum number of iterations per task
+	 * @param [in] f Loop body, invoked as @c f(i) for each index
+	 * @tparam Func_t Type of the loop body functor
+	 */
+	template <typename Func_t>
+	inline void parallelBatchedFor(std::size_t first, std::size_t last, std::size_t batchSize, Func_t f)
+	{
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(first, last, batchSize), [&](const tbb::blocked_range<std::size_t>& r)
+		{
+			for (std::size_t i = r.begin(); i < r.end(); ++i)
+				f(i);
+		});
+	}
+
+	/**
+	 * @brief Runs a loop of many small independent iterations in parallel batches with affinity replay
+	 * @details Same as parallelBatchedFor() but additionally records in @p ap which worker
+	 *          executed which batch and replays this mapping in subsequent runs of the loop.
+	 *          The partitioner has to outlive the loop (e.g., as a class member) to be of
+	 *          any use. In serial builds, this function degrades to a plain loop.
+	 * @param [in] first Index of the first iteration
+	 * @param [in] last Index past the last iteration
+	 * @param [in] batchSize Minimum number of iterations per task
+	 * @param [in,out] ap Partitioner that persists the iteration-to-worker mapping
+	 * @param [in] f Loop body, invoked as @c f(i) for each index
+	 * @tparam Func_t Type of the loop body functor
+	 */
+	template <typename Func_t>
+	inline void parallelBatchedFor(std::size_t first, std::size_t last, std::size_t batchSize, AffinityPartitioner& ap, Func_t f)
+	{
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(first, last, batchSize), [&](const tbb::blocked_range<std::size_t>& r)
+		{
+			for (std::size_t i = r.begin(); i < r.end(); ++i)
+				f(i);
+		}, ap);
+	}
+
+#else
+
+	/**
+	 * @brief Manages the process-wide worker thread pool
+	 * @details Serial fallback in which all operations are no-ops. See the parallel
+	 *          variant for details.
+	 */
+	class ThreadPool
+	{
+	public:
+
+		static inline ThreadPool& instance()
+		{
+			static ThreadPool tp;
+			return tp;
+		}
+
+		inline void ensureInitialized(unsigned int maxThreads) { }
+		inline unsigned int maxThreads() const { return 1; }
+		inline void pinWorkersToCores(bool enable) { }
+
+	private:
+		ThreadPool() { }
+	};
+
+	/**
+	 * @brief Remembers which worker executed which part of a loop and replays this mapping
+	 * @details Serial fallback without any state. See the parallel variant for details.
+	 */
+	struct AffinityPartitioner { };
+
+	/**
+	 * @brief Runs a loop of many small independent iterations in parallel batches
+	 * @details Serial fallback that executes a plain loop. See the parallel variant
+	 *          for details.
+	 * @param [in] first Index of the first iteration
+	 * @param [in] last Index past the last iteration
+	 * @param [in] batchSize Minimum number of iterations per task (ignored)
+	 * @param [in] f Loop body, invoked as @c f(i) for each index
+	 * @tparam Func_t Type of the loop body functor
+	 */
+	template <typename Func_t>
+	inline void parallelBatchedFor(std::size_t first, std::size_t last, std::size_t batchSize, Func_t f)
+	{
+		for (std::size_t i = first; i < last; ++i)
+			f(i);
+	}
+
+	/**
+	 * @brief Runs a loop of many small independent iterations in parallel batches with affinity replay
+	 * @details Serial fallback that executes a plain loop. See the parallel variant
+	 *          for details.
+	 * @param [in] first Index of the first iteration
+	 * @param [in] last Index past the last iteration
+	 * @param [in] batchSize Minimum number of iterations per task (ignored)
+	 * @param [in,out] ap Partitioner (ignored)
+	 * @param [in] f Loop body, invoked as @c f(i) for each index
+	 * @tparam Func_t Type of the loop body functor
+	 */
+	template <typename Func_t>
+	inline void parallelBatchedFor(std::size_t first, std::size_t last, std::size_t batchSize, AffinityPartitioner& ap, Func_t f)
+	{
+		for (std::size_t i = first; i < last; ++i)
+			f(i);
+	}
+
+#endif
+
+#ifdef CADET_PARALLELIZE
+
+	/**
+	 * @brief Provides each thread with its own copy of a workspace object
+	 * @details Wraps tbb::enumerable_thread_specific such that workspace objects
+	 *          (e.g., ArrayPool) are not shared between threads of a parallel
+	 *          region. Thread local copies are created lazily on first access
+	 *          using the constructor arguments passed to ThreadLocalStorage or
+	 *          reset(). In serial builds, this class degrades to a single object.
+	 * @tparam T Type of the workspace object
+	 */
+	template <typename T>
+	class ThreadLocalStorage
+	{
+	public:
+		ThreadLocalStorage() : _storage() { }
+
+		/**
+		 * @brief Creates a ThreadLocalStorage whose thread local copies are constructed with the given arguments
+		 * @param [in] args Arguments passed to the constructor of each thread local copy
+		 */
+		template <typename... Args>
+		ThreadLocalStorage(Args... args) : _storage(args...) { }
+
+		/**
+		 * @brief Returns the calling thread's local copy, creating it if necessary
+		 * @return Reference to the thread local object
+		 */
+		inline T& local() { return _storage.local(); }
+
+		/**
+		 * @brief Discards all thread local copies and changes the construction arguments
+		 * @details Must not be called while a parallel region is using the storage.
+		 * @param [in] args Arguments passed to the constructor of each thread local copy
+		 */
+		template <typename... Args>
+		void reset(Args... args)
+		{
+			_storage = tbb::enumerable_thread_specific<T>(args...);
+		}
+
+	private:
+		tbb::enumerable_thread_specific<T> _storage;
+	};
+
+#else
+
+	/**
+	 * @brief Provides each thread with its own copy of a workspace object
+	 * @details Serial fallback that holds a single object. See the parallel
+	 *          variant for details.
+	 * @tparam T Type of the workspace object
+	 */
+	template <typename T>
+	class ThreadLocalStorage
+	{
+	public:
+		ThreadLocalStorage() : _storage() { }
+
+		template <typename... Args>
+		ThreadLocalStorage(Args... args) : _storage(args...) { }
+
+		inline T& local() { return _storage; }
+
+		template <typename... Args>
+		void reset(Args... args)
+		{
+			_storage.~T();
+			new (&_storage) T(args...);
+		}
+
+	private:
+		T _storage;
+	};
+
 #endif
 
+} // namespace util
+
+} // namespace cadet
+
 #endif  // LIBCADET_PARALLEL_SUPPORT_HPP_
@@ -0,0 +1,196 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a collision-free hash table for ParameterId lookups on hot paths.
+ */
+
+#ifndef LIBCADET_PARAMHASHTABLE_HPP_
+#define LIBCADET_PARAMHASHTABLE_HPP_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "cadet/ParameterId.hpp"
+#include "ParamIdUtil.hpp"
+
+namespace cadet
+{
+
+	/**
+	 * @brief Collision-free dispatch table for ParameterId lookups
+	 * @details Parameter updates during estimation perform many lookups against a fixed key
+	 *          set, which std::unordered_map serves with bucket traversal and key comparisons.
+	 *          This table is compiled once from the registered parameters at configure time:
+	 *          rebuild() searches a multiplicative hash seed under which all keys map to
+	 *          distinct slots of a power-of-two table, so find() is a single multiply-shift,
+	 *          one indexed load, and one key comparison without any probing loop.
+	 *
+	 *          The key set is fixed between rebuilds; lookups of unknown keys are valid and
+	 *          return the empty value. The mapped type has to be pointer-like: value-copyable
+	 *          and convertible to @c bool with the default constructed value being empty.
+	 * @tparam ValueType Pointer-like mapped type (e.g., @c active*)
+	 */
+	template <typename ValueType>
+	class ParameterHashTable
+	{
+	public:
+
+		ParameterHashTable() CADET_NOEXCEPT : _seed(0), _shift(64), _numEntries(0) { }
+
+		/**
+		 * @brief Removes all entries from the table
+		 */
+		inline void clear() CADET_NOEXCEPT
+		{
+			_slots.clear();
+			_shift = 64;
+			_numEntries = 0;
+		}
+
+		/**
+		 * @brief Compiles the dispatch table from the given parameter map
+		 * @details Deterministically searches seeds (and, if necessary, bigger tables) until
+		 *          every key occupies its own slot. For the parameter counts of a flowsheet
+		 *          (tens to a few hundred keys at twofold over-allocation) only a few attempts
+		 *          are needed.
+		 * @param [in] params Registered parameters; the table keeps copies of keys and values
+		 */
+		void rebuild(const std::unordered_map<ParameterId, ValueType>& params)
+		{
+			clear();
+			if (params.empty())
+				return;
+
+			// Smallest power of two with at most 50% load
+			std::size_t numSlots = 16;
+			while (numSlots < 2 * params.size())
+				numSlots *= 2;
+
+			std::uint64_t seedState = 0;
+			for (int attempt = 0; true; ++attempt)
+			{
+				// Grow the table if no collision-free seed turns up quickly
+				if (attempt == 32)
+				{
+					numSlots *= 2;
+					attempt = 0;
+				}
+
+				const std::uint64_t seed = nextSeed(seedState);
+				unsigned int shift = 64;
+				for (std::size_t m = 1; m < numSlots; m *= 2)
+					--shift;
+
+				std::vector<Slot> slots(numSlots);
+				bool collisionFree = true;
+				for (typename std::unordered_map<ParameterId, ValueType>::const_iterator it = params.begin(); it != params.end(); ++it)
+				{
+					Slot& s = slots[(hashParameter(it->first) * seed) >> shift];
+					if (s.value)
+					{
+						collisionFree = false;
+						break;
+					}
+					s.id = it->first;
+					s.value = it->second;
+				}
+
+				if (collisionFree)
+				{
+					_slots = std::move(slots);
+					_seed = seed;
+					_shift = shift;
+					_numEntries = params.size();
+					return;
+				}
+			}
+		}
+
+		/**
+		 * @brief Checks whether the table is an exact snapshot of the given parameter map
+		 * @details Compares the keys and their mapped values. This can be used to decide
+		 *          whether a rebuild() is necessary after the registered parameters have
+		 *          been refreshed in place; each check is a single find() per key.
+		 * @param [in] params Registered parameters
+		 * @return @c true if the table maps exactly the keys of @p params to the same values
+		 */
+		bool matches(const std::unordered_map<ParameterId, ValueType>& params) const CADET_NOEXCEPT
+		{
+			if (params.size() != _numEntries)
+				return false;
+
+			for (typename std::unordered_map<ParameterId, ValueType>::const_iterator it = params.begin(); it != params.end(); ++it)
+			{
+				if (find(it->first) != it->second)
+					return false;
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Looks up a parameter
+		 * @param [in] pId Id of the parameter
+		 * @return Mapped value, or the empty value if the parameter is not in the table
+		 */
+		inline ValueType find(const ParameterId& pId) const CADET_NOEXCEPT
+		{
+			if (_slots.empty())
+				return ValueType();
+
+			const Slot& s = _slots[(hashParameter(pId) * _seed) >> _shift];
+			if (s.value && (s.id == pId))
+				return s.value;
+			return ValueType();
+		}
+
+		/**
+		 * @brief Returns the size of the slot array in bytes
+		 * @return Capacity of the table in bytes
+		 */
+		inline std::size_t capacityBytes() const CADET_NOEXCEPT { return _slots.capacity() * sizeof(Slot); }
+
+	protected:
+
+		struct Slot
+		{
+			Slot() : id(), value() { }
+
+			ParameterId id; //<! Key occupying this slot
+			ValueType value; //<! Mapped value; empty marks a free slot
+		};
+
+		/**
+		 * @brief Advances the deterministic seed sequence (splitmix64 step)
+		 * @param [in,out] state Sequence state
+		 * @return Next (odd) multiplicative hash seed
+		 */
+		static inline std::uint64_t nextSeed(std::uint64_t& state) CADET_NOEXCEPT
+		{
+			state += UINT64_C(0x9E3779B97F4A7C15);
+			std::uint64_t z = state;
+			z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+			z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+			return (z ^ (z >> 31)) | 1;
+		}
+
+		std::vector<Slot> _slots; //<! Slot array (power-of-two size)
+		std::uint64_t _seed; //<! Multiplicative hash seed that is collision-free for the key set
+		unsigned int _shift; //<! Right shift mapping the multiplied hash to a slot index
+		std::size_t _numEntries; //<! Number of occupied slots
+	};
+
+} // namespace cadet
+
+#endif  // LIBCADET_PARAMHASHTABLE_HPP_
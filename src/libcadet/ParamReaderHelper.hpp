@@ -26,6 +26,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace cadet
@@ -41,26 +42,47 @@ namespace cadet
 	 * @param [in] dataSet Name of the dataset
 	 * @param [in] nExpand How often a single scalar parameter is replicated (@c 1 if scalars should remain scalar)
 	 * @tparam ValType Type of the parameter, such as @c active or @c double
+	 * @tparam Alloc_t Allocator of the destination vector (e.g., the default allocator or a cadet::ScratchAllocator)
 	 */
-	template <typename ValType>
-	inline void readScalarParameterOrArray(std::vector<ValType>& dest, IParameterProvider& paramProvider, const std::string& dataSet, unsigned int nExpand)
+	template <typename ValType, typename Alloc_t>
+	inline void readScalarParameterOrArray(std::vector<ValType, Alloc_t>& dest, IParameterProvider& paramProvider, const std::string& dataSet, unsigned int nExpand)
 	{
 		dest.clear();
 		if (paramProvider.isArray(dataSet))
 		{
-			// Copy all values from provider to destination
+			// Convert all values from provider to destination in a single pass
 			const std::vector<double> vals = paramProvider.getDoubleArray(dataSet);
-			dest.resize(vals.size());
-			for (unsigned int i = 0; i < vals.size(); ++i)
-				dest[i] = vals[i];
+			dest.assign(vals.begin(), vals.end());
 		}
 		else
 		{
 			// Only scalar value in provider, expand to given size
-			const double val = paramProvider.getDouble(dataSet);
-			dest.resize(nExpand);
-			for (unsigned int i = 0; i < nExpand; ++i)
-				dest[i] = val;
+			dest.assign(nExpand, ValType(paramProvider.getDouble(dataSet)));
+		}
+	}
+
+	/**
+	 * @brief Reads a scalar, possibly vectorial, parameter into a vector of doubles
+	 * @details Specialization of readScalarParameterOrArray() for @c double destinations.
+	 *          Since no type conversion is required, the buffer returned by the parameter
+	 *          provider is moved into the destination instead of copied element by element.
+	 *
+	 * @param [in] dest Destination vector in which the data is saved
+	 * @param [in] paramProvider Parameter provider from which is read
+	 * @param [in] dataSet Name of the dataset
+	 * @param [in] nExpand How often a single scalar parameter is replicated (@c 1 if scalars should remain scalar)
+	 */
+	inline void readScalarParameterOrArray(std::vector<double>& dest, IParameterProvider& paramProvider, const std::string& dataSet, unsigned int nExpand)
+	{
+		if (paramProvider.isArray(dataSet))
+		{
+			// Take ownership of the buffer returned by the provider without copying
+			dest = paramProvider.getDoubleArray(dataSet);
+		}
+		else
+		{
+			// Only scalar value in provider, expand to given size
+			dest.assign(nExpand, paramProvider.getDouble(dataSet));
 		}
 	}
 
@@ -78,19 +100,51 @@ namespace cadet
 	 * @param [in] nExpect Expected number of elements in the vectorial parameter
 	 * @param [in] nExpand How often the vectorial parameter is replicated (@c 1 if vectorials should remain vectorial)
 	 * @tparam ValType Type of the parameter, such as @c active or @c double
+	 * @tparam Alloc_t Allocator of the destination vector (e.g., the default allocator or a cadet::ScratchAllocator)
 	 */
-	template <typename ValType>
-	inline void readParameterMatrix(std::vector<ValType>& dest, IParameterProvider& paramProvider, const std::string& dataSet, unsigned int nExpect, unsigned int nExpand)
+	template <typename ValType, typename Alloc_t>
+	inline void readParameterMatrix(std::vector<ValType, Alloc_t>& dest, IParameterProvider& paramProvider, const std::string& dataSet, unsigned int nExpect, unsigned int nExpand)
 	{
 		dest.clear();
-		const std::vector<double> vals = paramProvider.getDoubleArray(dataSet);
+		std::vector<double> vals = paramProvider.getDoubleArray(dataSet);
 
 		if (vals.size() == nExpect)
 		{
-			// Read expected number of values, so copy them
-			dest.resize(nExpect);
-			for (unsigned int i = 0; i < nExpect; ++i)
-				dest[i] = vals[i];
+			// Read expected number of values, so convert them in a single pass
+			dest.assign(vals.begin(), vals.end());
+		}
+		else
+		{
+			// We copy the read values nExpand times
+			dest.resize(vals.size() * nExpand);
+			for (unsigned int j = 0; j < nExpand; ++j)
+			{
+				for (unsigned int i = 0; i < vals.size(); ++i)
+					dest[i + j * nExpand] = vals[i];
+			}
+		}
+	}
+
+	/**
+	 * @brief Reads a vector valued parameter, that may also be a matrix, into a vector of doubles
+	 * @details Specialization of readParameterMatrix() for @c double destinations. If the
+	 *          parameter does not have to be replicated, the buffer returned by the parameter
+	 *          provider is moved into the destination instead of copied element by element.
+	 *
+	 * @param [in] dest Destination vector in which the data is saved
+	 * @param [in] paramProvider Parameter provider from which is read
+	 * @param [in] dataSet Name of the dataset
+	 * @param [in] nExpect Expected number of elements in the vectorial parameter
+	 * @param [in] nExpand How often the vectorial parameter is replicated (@c 1 if vectorials should remain vectorial)
+	 */
+	inline void readParameterMatrix(std::vector<double>& dest, IParameterProvider& paramProvider, const std::string& dataSet, unsigned int nExpect, unsigned int nExpand)
+	{
+		std::vector<double> vals = paramProvider.getDoubleArray(dataSet);
+
+		if (vals.size() == nExpect)
+		{
+			// Take ownership of the buffer returned by the provider without copying
+			dest = std::move(vals);
 		}
 		else
 		{
@@ -275,9 +329,59 @@ namespace cadet
 	}
 
 
+	/**
+	 * @brief Extracts the plain values of an active parameter slice into a packed double array
+	 * @details Parameter tables are stored as @c active so that individual entries can carry
+	 *          AD seeds when they are selected as sensitivity targets. Residual evaluations
+	 *          with @c double typed parameters only read the plain values, however, and
+	 *          striding over the gradient slots of the active storage wastes cache bandwidth.
+	 *          This function packs the plain values into a dense double array (e.g., once per
+	 *          time section) so that those reads become unit stride.
+	 *
+	 * @param [in] data Pointer to the first element of the active parameter slice
+	 * @param [in] nElements Number of elements in the slice
+	 * @param [out] dest Destination vector which is resized to @p nElements
+	 */
+	inline void extractDenseSlice(active const* const data, unsigned int nElements, std::vector<double>& dest)
+	{
+		dest.resize(nElements);
+		for (unsigned int i = 0; i < nElements; ++i)
+			dest[i] = static_cast<double>(data[i]);
+	}
+
+
+	/**
+	 * @brief Selects the parameter slice matching the given parameter type
+	 * @details Residual functions are instantiated with @c double parameters for plain
+	 *          evaluations and with @c active parameters when AD seeds have to be propagated
+	 *          (e.g., parameter sensitivities). Only the latter require the full active
+	 *          storage; the former can read a packed double mirror created by
+	 *          extractDenseSlice(), which is much smaller and unit stride.
+	 *
+	 * @param [in] adData Pointer to the active parameter slice
+	 * @param [in] denseData Pointer to the packed double mirror of the same slice
+	 * @return The slice matching @c ParamType
+	 * @tparam ParamType Type of the parameter, either @c active or @c double
+	 */
+	template <typename ParamType>
+	inline ParamType const* selectParamSlice(active const* const adData, double const* const denseData) CADET_NOEXCEPT;
+
+	template <>
+	inline active const* selectParamSlice<active>(active const* const adData, double const* const denseData) CADET_NOEXCEPT
+	{
+		return adData;
+	}
+
+	template <>
+	inline double const* selectParamSlice<double>(active const* const adData, double const* const denseData) CADET_NOEXCEPT
+	{
+		return denseData;
+	}
+
+
 	/**
 	 * @brief Registers scalar parameters that may be section dependent
-	 * 
+	 *
 	 * @param [in] nameHash Hashed name of the parameter
 	 * @param [in,out] map Map to which the parameters are added
 	 * @param [in] params Vector with parameters to be registered (only 1 if not section dependent)
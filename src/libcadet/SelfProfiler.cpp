@@ -0,0 +1,249 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#ifdef CADET_SELF_PROFILER
+
+#include "SelfProfiler.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef __linux__
+	#include <csignal>
+	#include <sys/time.h>
+#endif
+
+namespace
+{
+	/**
+	 * @brief Maximum supported nesting depth of phases, deeper frames are dropped
+	 */
+	const int maxDepth = 16;
+
+	/**
+	 * @brief Number of slots in the aggregation table, has to be a power of two
+	 */
+	const unsigned int tableSize = 4096;
+
+	/**
+	 * @brief Per-thread stack of phase labels
+	 * @details The labels are string literals, so pointer identity is sufficient for
+	 *          comparing and hashing stacks.
+	 */
+	struct PhaseStack
+	{
+		char const* frames[maxDepth];
+		int depth;
+	};
+
+	thread_local PhaseStack tlStack = { { nullptr }, 0 };
+
+	/**
+	 * @brief One aggregated stack in the sample table
+	 * @details @c depth doubles as the slot state: 0 means empty, -1 means a thread is
+	 *          currently claiming the slot, and a positive value means the slot holds a
+	 *          valid stack of that depth. All fields are only written while the slot is
+	 *          claimed, so the signal handler never observes a partially filled slot.
+	 */
+	struct Slot
+	{
+		std::atomic<int> depth;
+		char const* frames[maxDepth];
+		std::atomic<unsigned long> count;
+	};
+
+	Slot sampleTable[tableSize];
+
+	std::atomic<unsigned long> totalSamples(0);
+	std::atomic<unsigned long> droppedSamples(0);
+
+	char const* const idleFrame = "Idle";
+
+	/**
+	 * @brief Records the given stack in the aggregation table
+	 * @details Lock-free and async-signal-safe: only pointer comparisons and lock-free
+	 *          atomics are used. Samples that do not fit into the table are counted as
+	 *          dropped instead of blocking.
+	 */
+	inline void recordSample(char const* const* frames, int depth)
+	{
+		// FNV-1a over the frame pointers
+		std::size_t h = 14695981039346656037ull;
+		for (int i = 0; i < depth; ++i)
+			h = (h ^ reinterpret_cast<std::size_t>(frames[i])) * 1099511628211ull;
+
+		for (unsigned int probe = 0; probe < 64; ++probe)
+		{
+			Slot& slot = sampleTable[(h + probe) & (tableSize - 1)];
+			const int slotDepth = slot.depth.load(std::memory_order_acquire);
+
+			if (slotDepth == depth)
+			{
+				bool match = true;
+				for (int i = 0; i < depth; ++i)
+				{
+					if (slot.frames[i] != frames[i])
+					{
+						match = false;
+						break;
+					}
+				}
+				if (match)
+				{
+					slot.count.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+			}
+			else if (slotDepth == 0)
+			{
+				int expected = 0;
+				if (slot.depth.compare_exchange_strong(expected, -1, std::memory_order_acq_rel))
+				{
+					for (int i = 0; i < depth; ++i)
+						slot.frames[i] = frames[i];
+					slot.count.store(1, std::memory_order_relaxed);
+					slot.depth.store(depth, std::memory_order_release);
+					return;
+				}
+			}
+			// Slot holds a different stack or is being claimed, probe the next one
+		}
+
+		droppedSamples.fetch_add(1, std::memory_order_relaxed);
+	}
+
+#ifdef __linux__
+
+	void sampleHandler(int)
+	{
+		totalSamples.fetch_add(1, std::memory_order_relaxed);
+
+		const PhaseStack& st = tlStack;
+		int depth = st.depth;
+		if (depth > maxDepth)
+			depth = maxDepth;
+
+		if (depth <= 0)
+			recordSample(&idleFrame, 1);
+		else
+			recordSample(st.frames, depth);
+	}
+
+	/**
+	 * @brief Installs the interval timer on construction and writes the profile on destruction
+	 */
+	class SamplerLifetime
+	{
+	public:
+		SamplerLifetime()
+		{
+			struct sigaction sa;
+			sa.sa_handler = &sampleHandler;
+			sa.sa_flags = SA_RESTART;
+			sigemptyset(&sa.sa_mask);
+			if (sigaction(SIGPROF, &sa, nullptr) != 0)
+				return;
+
+			long intervalUsec = 1000;
+			if (char const* const env = std::getenv("CADET_PROFILE_INTERVAL"))
+			{
+				const long val = std::atol(env);
+				if (val > 0)
+					intervalUsec = val;
+			}
+
+			struct itimerval timer;
+			timer.it_interval.tv_sec = intervalUsec / 1000000;
+			timer.it_interval.tv_usec = intervalUsec % 1000000;
+			timer.it_value = timer.it_interval;
+			setitimer(ITIMER_PROF, &timer, nullptr);
+		}
+
+		~SamplerLifetime()
+		{
+			struct itimerval timer = { { 0, 0 }, { 0, 0 } };
+			setitimer(ITIMER_PROF, &timer, nullptr);
+			cadet::profiler::writeProfile();
+		}
+	};
+
+	SamplerLifetime sampler;
+
+#endif  // __linux__
+}
+
+namespace cadet
+{
+
+namespace profiler
+{
+
+	void pushPhase(char const* name) CADET_NOEXCEPT
+	{
+		PhaseStack& st = tlStack;
+		if (st.depth < maxDepth)
+			st.frames[st.depth] = name;
+
+		// Make sure the signal handler never sees the new depth before the frame
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+		++st.depth;
+	}
+
+	void popPhase() CADET_NOEXCEPT
+	{
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+		--tlStack.depth;
+	}
+
+	void writeProfile()
+	{
+		char const* fileName = "cadet_profile.folded";
+		if (char const* const env = std::getenv("CADET_PROFILE_FILE"))
+			fileName = env;
+
+		std::FILE* const f = std::fopen(fileName, "w");
+		if (!f)
+			return;
+
+		unsigned long written = 0;
+		for (unsigned int i = 0; i < tableSize; ++i)
+		{
+			const Slot& slot = sampleTable[i];
+			const int depth = slot.depth.load(std::memory_order_acquire);
+			if (depth <= 0)
+				continue;
+
+			const unsigned long count = slot.count.load(std::memory_order_relaxed);
+			if (count == 0)
+				continue;
+
+			std::fputs("cadet", f);
+			for (int j = 0; j < depth; ++j)
+			{
+				std::fputc(';', f);
+				std::fputs(slot.frames[j], f);
+			}
+			std::fprintf(f, " %lu\n", count);
+			written += count;
+		}
+		std::fclose(f);
+
+		std::fprintf(stderr, "Self-profiler: wrote %lu of %lu samples (%lu dropped) to %s\n",
+			written, totalSamples.load(std::memory_order_relaxed), droppedSamples.load(std::memory_order_relaxed), fileName);
+	}
+
+} // namespace profiler
+
+} // namespace cadet
+
+#endif  // CADET_SELF_PROFILER
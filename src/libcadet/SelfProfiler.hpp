@@ -0,0 +1,80 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Built-in sampling self-profiler.
+ * The profiler maintains a per-thread stack of phase labels (fed by the BENCH_START() /
+ * BENCH_STOP() / BENCH_SCOPE() macros of Benchmark.hpp and by explicit ScopedPhase objects)
+ * and periodically samples it from a CPU time based interval timer (SIGPROF on Linux).
+ * At process exit the aggregated samples are written as a collapsed stack file (one line
+ * per distinct stack, "cadet;phase1;phase2 count") that flame graph tools consume directly.
+ * This allows diagnosing live slowdowns on machines where external profilers cannot be
+ * attached. The output file defaults to @c cadet_profile.folded and can be changed via the
+ * environment variable @c CADET_PROFILE_FILE; the sampling interval defaults to 1000 us and
+ * can be changed via @c CADET_PROFILE_INTERVAL (in us).
+ */
+
+#ifndef LIBCADET_SELFPROFILER_HPP_
+#define LIBCADET_SELFPROFILER_HPP_
+
+#ifdef CADET_SELF_PROFILER
+
+#include "cadet/cadetCompilerInfo.hpp"
+
+namespace cadet
+{
+
+namespace profiler
+{
+
+	/**
+	 * @brief Pushes a phase label onto the calling thread's phase stack
+	 * @details The label has to remain valid until the profile is written, that is, it
+	 *          has to be a string literal or live at least as long as the process.
+	 *          Must be balanced by a later popPhase() on the same thread.
+	 * @param [in] name Phase label
+	 */
+	void pushPhase(char const* name) CADET_NOEXCEPT;
+
+	/**
+	 * @brief Pops the topmost phase label from the calling thread's phase stack
+	 */
+	void popPhase() CADET_NOEXCEPT;
+
+	/**
+	 * @brief Writes the aggregated samples collected so far as a collapsed stack file
+	 * @details Called automatically at process exit, but can also be invoked manually to
+	 *          obtain an intermediate profile of a long running simulation.
+	 */
+	void writeProfile();
+
+	/**
+	 * @brief Scope class that pushes a phase label on construction and pops it on destruction
+	 */
+	class ScopedPhase
+	{
+	public:
+		ScopedPhase(char const* name) CADET_NOEXCEPT { pushPhase(name); }
+		~ScopedPhase() CADET_NOEXCEPT { popPhase(); }
+
+		ScopedPhase(const ScopedPhase&) = delete;
+		ScopedPhase& operator=(const ScopedPhase&) = delete;
+	};
+
+} // namespace profiler
+
+} // namespace cadet
+
+#endif  // CADET_SELF_PROFILER
+
+#endif  // LIBCADET_SELFPROFILER_HPP_
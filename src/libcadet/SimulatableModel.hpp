@@ -157,6 +157,24 @@ public:
 	 */
 	virtual void notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset) = 0;
 
+	/**
+	 * @brief Checks whether the transition into the given section is an exactly known state jump
+	 * @details A transition is exact if every discontinuity introduced at the section boundary
+	 *          is known in closed form (e.g., an inlet profile reporting its jump magnitudes)
+	 *          and is applied exactly during consistent initialization. In this case the time
+	 *          integrator can downgrade a full consistent initialization to a lean one: the
+	 *          differential states are continuous across the boundary and the remaining
+	 *          algebraic variables are restored by the lean initialization.
+	 *
+	 *          This function has to be called after notifyDiscontinuousSectionTransition() as
+	 *          the answer may depend on the updated valve switch state.
+	 *
+	 * @param [in] t Time point of the section transition
+	 * @param [in] secIdx Index of the new section that is about to be integrated
+	 * @return @c true if the transition is an exactly known state jump, otherwise @c false
+	 */
+	virtual bool exactSectionTransition(double t, unsigned int secIdx) = 0;
+
 	/**
 	 * @brief Applies initial conditions to the state vector and its time derivative
 	 * @details The initial conditions do not need to be consistent at this point. On a (discontinuous)
@@ -331,6 +349,9 @@ public:
 	 * @param [in] ySdot Pointers to global sensitivity time derivative state vectors
 	 * @param [out] resS Pointers to global sensitivity residuals
 	 * @param [in,out] adRes Pointer to global residual vector of AD datatypes for computing the sensitivity derivatives
+	 * @param [in] sensMask Array of flags that enables (@c 1) or disables (@c 0) each sensitivity direction, or @c nullptr
+	 *             if all directions are active. Disabled directions are not propagated; their residual is set to
+	 *             @f$ \dot{s} @f$ such that the time integrator freezes the corresponding sensitivity vector.
 	 * @param [in] tmp1 Temporary storage in the size of global state vector @p y
 	 * @param [in] tmp2 Temporary storage in the size of global state vector of @p y
 	 * @param [in] tmp3 Temporary storage in the size of global state vector of @p y
@@ -339,7 +360,7 @@ public:
 	virtual int residualSensFwd(unsigned int nSens, const active& t, unsigned int secIdx, const active& timeFactor,
 		double const* const y, double const* const yDot, double const* const res,
 		const std::vector<const double*>& yS, const std::vector<const double*>& ySdot, const std::vector<double*>& resS,
-		active* const adRes, double* const tmp1, double* const tmp2, double* const tmp3) = 0;
+		active* const adRes, unsigned char const* sensMask, double* const tmp1, double* const tmp2, double* const tmp3) = 0;
 
 	/**
 	 * @brief Computes the residual of the forward sensitivity systems and evaluates the Jacobian
@@ -411,6 +432,13 @@ public:
 	virtual int linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
 		double const* const y, double const* const yDot, double const* const res) = 0;
 
+	/**
+	 * @brief Returns the accumulated number of GMRES iterations spent in linearSolve()
+	 * @details Counts all iterations of all unit operations since creation of the model.
+	 * @return Total number of GMRES iterations
+	 */
+	virtual unsigned int numGmresIterations() const CADET_NOEXCEPT = 0;
+
 	/**
 	 * @brief Prepares the AD system vectors by constructing seed vectors
 	 * @details Sets the seed vectors used in AD. Since the AD vector is fully managed by the model,
@@ -466,6 +494,53 @@ public:
 	 */
 	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut) = 0;
 
+	/**
+	 * @brief Computes relaxed error tolerances for use right after a discontinuous section transition
+	 * @details When a section transition introduces a discontinuity (e.g., a step in the inlet
+	 *          profile), the disturbance is initially confined to a small part of the spatial
+	 *          domain. Applying the full error test to the still unperturbed DOFs forces the
+	 *          time integrator to take tiny steps without gaining accuracy. This function keeps
+	 *          the base tolerances for the DOFs near the point where the disturbance enters the
+	 *          model and multiplies the tolerances of all remaining DOFs by @p relaxFactor.
+	 * 
+	 * @param [in] baseTol Pointer to array with base absolute error tolerances for each DOF
+	 * @param [in] relaxFactor Factor (at least @c 1.0) the tolerances of unaffected DOFs are multiplied with
+	 * @param [out] relaxedTol Pointer to array receiving the relaxed error tolerances for each DOF
+	 */
+	virtual void relaxTransitionErrorTol(double const* baseTol, double relaxFactor, double* relaxedTol) = 0;
+
+	/**
+	 * @brief Determines whether any part of the model decouples fast local dynamics from the error test
+	 * @return @c true if applyMultirateErrorTol() modifies the tolerances, otherwise @c false
+	 */
+	virtual bool hasMultirateErrorTol() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Scales the error tolerances of DOFs governed by fast local dynamics
+	 * @details Multiplies the absolute tolerances of DOFs with fast local dynamics (e.g.,
+	 *          particle shells and film fluxes of units configured for multirate stepping)
+	 *          by a configured factor so that the global step size controller follows the
+	 *          bulk transport time scale. See IUnitOperation::applyMultirateErrorTol().
+	 *
+	 * @param [in,out] absTol Pointer to array with absolute error tolerances for each DOF
+	 */
+	virtual void applyMultirateErrorTol(double* absTol) = 0;
+
+	/**
+	 * @brief Scales the error tolerances of the DOFs of each state class by its own factor
+	 * @details Multiplies the absolute tolerance of every DOF by the factor of its state
+	 *          class (column liquid, particle liquid, bound states, film fluxes), so
+	 *          non-observable states can run with a looser local error test than the
+	 *          outlet concentrations. See IUnitOperation::applyStateClassErrorTol().
+	 *
+	 * @param [in] colLiquidFactor Factor for column liquid (bulk, inlet, and outlet) DOFs
+	 * @param [in] parLiquidFactor Factor for particle liquid phase DOFs
+	 * @param [in] boundFactor Factor for bound state DOFs
+	 * @param [in] fluxFactor Factor for film flux DOFs
+	 * @param [in,out] absTol Pointer to array with absolute error tolerances for each DOF
+	 */
+	virtual void applyStateClassErrorTol(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor, double* absTol) = 0;
+
 	/**
 	 * @brief Calculates error tolerances for additional coupling DOFs
 	 * @details ModelSystem uses additional DOFs to decouple a system of unit operations for parallelization.
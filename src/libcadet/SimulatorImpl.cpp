@@ -24,8 +24,15 @@
 
 #include <vector>
 #include <sstream>
+#include <algorithm>
+#include <fstream>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 
 #include "AutoDiff.hpp"
+#include "AllocCounter.hpp"
 #include "LoggingUtils.hpp"
 #include "Logging.hpp"
 
@@ -36,6 +43,8 @@
 	#include <tbb/global_control.h>
 #endif
 
+#include "ParallelSupport.hpp"
+
 namespace
 {
 	template <class T>
@@ -192,13 +201,31 @@ namespace cadet
 	/**
 	* @brief IDAS wrapper function to call the model's residual() method
 	*/
-	int residualDaeWrapper(double t, N_Vector y, N_Vector yDot, N_Vector res, void* userData)
+	int residualDaeWrapper(double t, N_Vector y, N_Vector yDot, N_Vector res, void* userData) CADET_NOEXCEPT
 	{
 		cadet::Simulator* const sim = static_cast<cadet::Simulator*>(userData);
 		const unsigned int secIdx = sim->getCurrentSection(t);
 		const active timeFactor = sim->timeFactor();
-		return sim->_model->residualWithJacobian(sim->toRealTime(t), secIdx, timeFactor, NVEC_DATA(y), NVEC_DATA(yDot), NVEC_DATA(res), 
-			sim->_vecADres, sim->_vecADy, sim->numSensitivityAdDirections());
+
+		// Exceptions must not unwind through the C call frames of IDAS. The hot path
+		// signals errors by return code; a stray exception (e.g., a failed allocation)
+		// is converted to a positive (recoverable) code, which makes IDAS retry the
+		// step with a reduced step size and eventually give up with IDA_REP_RES_ERR.
+		try
+		{
+			return sim->_model->residualWithJacobian(sim->toRealTime(t), secIdx, timeFactor, NVEC_DATA(y), NVEC_DATA(yDot), NVEC_DATA(res), 
+				sim->_adRes.get(), sim->_adY.get(), sim->numSensitivityAdDirections());
+		}
+		catch (const std::exception& e)
+		{
+			LOG(Error) << "Residual evaluation failed: " << e.what();
+			return 1;
+		}
+		catch (...)
+		{
+			LOG(Error) << "Residual evaluation failed with unknown error";
+			return 1;
+		}
 	}
 
 	/**
@@ -284,7 +311,7 @@ namespace cadet
 	/**
 	* @brief IDAS wrapper function to call the model's linearSolve() method
 	*/
-	int linearSolveWrapper(IDAMem IDA_mem, N_Vector rhs, N_Vector weight, N_Vector y, N_Vector yDot, N_Vector res)
+	int linearSolveWrapper(IDAMem IDA_mem, N_Vector rhs, N_Vector weight, N_Vector y, N_Vector yDot, N_Vector res) CADET_NOEXCEPT
 	{
 		cadet::Simulator* const sim = static_cast<cadet::Simulator*>(IDA_mem->ida_lmem);
 		const double t = static_cast<double>(sim->toRealTime(IDA_mem->ida_tn));
@@ -292,7 +319,21 @@ namespace cadet
 		const double tol = IDA_mem->ida_epsNewt;
 		const active timeFactor = sim->timeFactor();
 
-		return sim->_model->linearSolve(t, static_cast<double>(timeFactor), alpha, tol, NVEC_DATA(rhs), NVEC_DATA(weight), NVEC_DATA(y), NVEC_DATA(yDot), NVEC_DATA(res));
+		// See residualDaeWrapper() for the exception barrier rationale
+		try
+		{
+			return sim->_model->linearSolve(t, static_cast<double>(timeFactor), alpha, tol, NVEC_DATA(rhs), NVEC_DATA(weight), NVEC_DATA(y), NVEC_DATA(yDot), NVEC_DATA(res));
+		}
+		catch (const std::exception& e)
+		{
+			LOG(Error) << "Linear solve failed: " << e.what();
+			return 1;
+		}
+		catch (...)
+		{
+			LOG(Error) << "Linear solve failed with unknown error";
+			return 1;
+		}
 	}
 
 	/**
@@ -300,29 +341,67 @@ namespace cadet
 	*/
 	int residualSensWrapper(int ns, double t, N_Vector y, N_Vector yDot, N_Vector res, 
 			N_Vector* yS, N_Vector* ySDot, N_Vector* resS,
-			void *userData, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+			void *userData, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3) CADET_NOEXCEPT
 	{
 		cadet::Simulator* const sim = static_cast<cadet::Simulator*>(userData);
-		const std::vector<const double*> sensY = convertNVectorToStdVectorPtrs<const double*>(yS, ns);
-		const std::vector<const double*> sensYdot = convertNVectorToStdVectorPtrs<const double*>(ySDot, ns);
-		std::vector<double*> sensRes = convertNVectorToStdVectorPtrs<double*>(resS, ns);
+
+		// Refill the preallocated pointer tables in place; this wrapper is called
+		// in every time step and must not allocate (see preFwdSensInit())
+		std::vector<const double*>& sensY = sim->_sensYPtr;
+		std::vector<const double*>& sensYdot = sim->_sensYdotPtr;
+		std::vector<double*>& sensRes = sim->_sensResPtr;
+		for (int i = 0; i < ns; ++i)
+		{
+			sensY[i] = NVEC_DATA(yS[i]);
+			sensYdot[i] = NVEC_DATA(ySDot[i]);
+			sensRes[i] = NVEC_DATA(resS[i]);
+		}
+
 		const unsigned int secIdx = sim->getCurrentSection(t);
 		const active timeFactor = sim->timeFactor();
+
+		// Build the mask of active sensitivity directions for the current section,
+		// if the user has restricted some sensitivities to a subset of the sections
+		unsigned char const* sensMask = nullptr;
+		if (!sim->_sensActiveSections.empty())
+		{
+			std::vector<unsigned char>& mask = sim->_sensMaskBuf;
+			for (int i = 0; i < ns; ++i)
+			{
+				const std::vector<char>& pattern = sim->_sensActiveSections[i];
+				mask[i] = (pattern.empty() || (secIdx >= pattern.size())) ? 1 : static_cast<unsigned char>(pattern[secIdx]);
+			}
+			sensMask = mask.data();
+		}
 		
 		//sim->_model->genJacobian(ns, sim->toRealTime(t), secIdx, timeFactor, NVEC_DATA(y), NVEC_DATA(yDot), NVEC_DATA(res),
-		//	sensY, sensYdot, sensRes, sim->_vecADres, NVEC_DATA(tmp1), NVEC_DATA(tmp2), NVEC_DATA(tmp3));
+		//	sensY, sensYdot, sensRes, sim->_adRes.get(), NVEC_DATA(tmp1), NVEC_DATA(tmp2), NVEC_DATA(tmp3));
 
-		return sim->_model->residualSensFwd(ns, sim->toRealTime(t), secIdx, timeFactor, NVEC_DATA(y), NVEC_DATA(yDot), NVEC_DATA(res), 
-			sensY, sensYdot, sensRes, sim->_vecADres, NVEC_DATA(tmp1), NVEC_DATA(tmp2), NVEC_DATA(tmp3));
+		// See residualDaeWrapper() for the exception barrier rationale
+		try
+		{
+			return sim->_model->residualSensFwd(ns, sim->toRealTime(t), secIdx, timeFactor, NVEC_DATA(y), NVEC_DATA(yDot), NVEC_DATA(res), 
+				sensY, sensYdot, sensRes, sim->_adRes.get(), sensMask, NVEC_DATA(tmp1), NVEC_DATA(tmp2), NVEC_DATA(tmp3));
+		}
+		catch (const std::exception& e)
+		{
+			LOG(Error) << "Sensitivity residual evaluation failed: " << e.what();
+			return 1;
+		}
+		catch (...)
+		{
+			LOG(Error) << "Sensitivity residual evaluation failed with unknown error";
+			return 1;
+		}
 	}
 
-	Simulator::Simulator() : _model(nullptr), _solRecorder(nullptr), _idaMemBlock(nullptr), _vecStateY(nullptr), 
+	Simulator::Simulator() : _model(nullptr), _solRecorder(nullptr), _progressMonitor(nullptr), _progressStride(1), _idaMemBlock(nullptr), _denseOutput(false), _vecStateY(nullptr),
 		_vecStateYdot(nullptr), _vecFwdYs(nullptr), _vecFwdYsDot(nullptr),
-		_relTolS(1.0e-9), _absTol(1, 1.0e-12), _relTol(1.0e-9), _initStepSize(1, 1.0e-6), _maxSteps(10000), _curSec(0),
+		_relTolS(1.0e-9), _absTol(1, 1.0e-12), _relTol(1.0e-9), _transitionRelaxFactor(1.0), _classTolColLiquid(1.0), _classTolParLiquid(1.0), _classTolBound(1.0), _classTolFlux(1.0), _initStepSize(1, 1.0e-6), _lastIntStepSize(0.0), _curTransformedTime(0.0), _hasResumeState(false), _maxSteps(10000), _curSec(0),
 		_skipConsistencyStateY(false), _skipConsistencySensitivity(false), _consistentInitMode(ConsistentInitialization::Full), 
-		_consistentInitModeSens(ConsistentInitialization::Full), _vecADres(nullptr), _vecADy(nullptr), _lastIntTime(0.0)
+		_consistentInitModeSens(ConsistentInitialization::Full), _lastIntTime(0.0)
 	{
-#if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
+#if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SFAD_ARENA) || defined(ACTIVE_SETFAD)
 		LOG(Debug) << "Resetting AD directions from " << ad::getDirections() << " to default " << ad::getMaxDirections();
 		ad::setDirections(ad::getMaxDirections());
 #endif
@@ -335,8 +414,8 @@ namespace cadet
 
 	void Simulator::clearModel() CADET_NOEXCEPT
 	{
-		delete[] _vecADy;
-		delete[] _vecADres;
+		_adY.release();
+		_adRes.release();
 
 		if ((_sensitiveParams.slices() > 0) && _vecFwdYs)
 		{
@@ -346,9 +425,9 @@ namespace cadet
 		_sensitiveParams.clear();
 		
 		if (_vecStateYdot)
-			NVec_Destroy(_vecStateYdot);
+			NVec_DestroyAligned(_vecStateYdot);
 		if (_vecStateY)
-			NVec_Destroy(_vecStateY);
+			NVec_DestroyAligned(_vecStateY);
 
 		if (_idaMemBlock)
 			IDAFree(&_idaMemBlock);		
@@ -362,10 +441,15 @@ namespace cadet
 		// Require ISimulatableModel descendant
 		_model = reinterpret_cast<ISimulatableModel*>(&model);
 
-		// Allocate and initialize state vectors
+		// Allocate and initialize state vectors on aligned, parallel first-touched storage
 		const unsigned int nDOFs = _model->numDofs();
-		_vecStateY = NVec_New(nDOFs);
-		_vecStateYdot = NVec_New(nDOFs);
+		_vecStateY = NVec_NewAligned(nDOFs);
+		_vecStateYdot = NVec_NewAligned(nDOFs);
+
+		// Run the WRMS norm of the IDAS error test on the worker threads; all vectors
+		// that IDAS clones from these templates inherit the patched kernels
+		installParallelNorms(_vecStateY);
+		installParallelNorms(_vecStateYdot);
 
 		// Propagate section times if available
 		if (_sectionTimes.size() > 0)
@@ -432,11 +516,11 @@ namespace cadet
 
 		IDASetUserData(IDA_mem, this);
 
-		// Allocate memory for AD if required
+		// Acquire AD workspace if required
 		if (_model->usesAD())
 		{
-			_vecADres = new active[nDOFs];
-			_vecADy = new active[nDOFs];
+			_adRes.require(nDOFs);
+			_adY.require(nDOFs);
 		}
 	}
 
@@ -445,35 +529,53 @@ namespace cadet
 		if (!_idaMemBlock)
 			return;
 
-		if (_absTol.size() > 1)
+		// Multirate stepping and state class factors require per-DOF tolerances even for a scalar specification
+		if ((_absTol.size() > 1) || hasStateClassErrorTol() || (_model && _model->hasMultirateErrorTol()))
 		{
 			if (!_model)
 				return;
 
 			N_Vector absTolTemp = NVec_New(_model->numDofs());
+			assembleAbsTolVector(NVEC_DATA(absTolTemp));
+
+			IDASVtolerances(_idaMemBlock, _relTol, absTolTemp);
+			NVec_Destroy(absTolTemp);
+		}
+		else
+			IDASStolerances(_idaMemBlock, _relTol, _absTol[0]);
+	}
+
+	void Simulator::assembleAbsTolVector(double* absTolOut) const
+	{
+		if (_absTol.size() > 1)
+		{
 			const unsigned int pureDofs = _model->numPureDofs();
 
 			// Check whether user has given us full absolute error for all (pure) DOFs
 			if (_absTol.size() >= pureDofs)
 			{
-				// Copy error tolerances for pure data
-				std::copy(_absTol.data(), _absTol.data() + pureDofs, NVEC_DATA(absTolTemp));
+				std::copy(_absTol.data(), _absTol.data() + pureDofs, absTolOut);
 
-				// Calculate error tolerances for coupling DOFs and append them
 				const std::vector<double> addAbsErrTol = _model->calculateErrorTolsForAdditionalDofs(_absTol.data(), _absTol.size());
-				std::copy(addAbsErrTol.data(), addAbsErrTol.data() + addAbsErrTol.size(), NVEC_DATA(absTolTemp) + pureDofs);
+				std::copy(addAbsErrTol.data(), addAbsErrTol.data() + addAbsErrTol.size(), absTolOut + pureDofs);
 			}
 			else
 			{
 				// We've received an expandable error specification
-				_model->expandErrorTol(_absTol.data(), _absTol.size(), NVEC_DATA(absTolTemp));
+				_model->expandErrorTol(_absTol.data(), _absTol.size(), absTolOut);
 			}
-
-			IDASVtolerances(_idaMemBlock, _relTol, absTolTemp);
-			NVec_Destroy(absTolTemp);
 		}
 		else
-			IDASStolerances(_idaMemBlock, _relTol, _absTol[0]);		
+			std::fill_n(absTolOut, _model->numDofs(), _absTol[0]);
+
+		// Relax the error test on fast local DOFs of units configured for multirate stepping
+		if (_model->hasMultirateErrorTol())
+			_model->applyMultirateErrorTol(absTolOut);
+
+		// Scale the tolerances of each state class (column liquid, particle liquid,
+		// bound, flux) by its configured factor
+		if (hasStateClassErrorTol())
+			_model->applyStateClassErrorTol(_classTolColLiquid, _classTolParLiquid, _classTolBound, _classTolFlux, absTolOut);
 	}
 
 	void Simulator::preFwdSensInit(unsigned int nSens)
@@ -498,10 +600,25 @@ namespace cadet
 			_vecFwdYs     = NVec_CloneArray(nSens, _vecStateY);
 			_vecFwdYsDot  = NVec_CloneArray(nSens, _vecStateYdot);
 
-			// Allocate memory for AD if not already done
-			if (!_vecADres)
-				_vecADres = new active[_model->numDofs()];
+			// Acquire AD workspace if not already done
+			_adRes.require(_model->numDofs());
 		}
+
+		// Preallocate the pointer tables used in residualSensWrapper() so that
+		// no heap allocation is required per time step
+		_sensYPtr.resize(nSens);
+		_sensYdotPtr.resize(nSens);
+		_sensResPtr.resize(nSens);
+		_sensMaskBuf.resize(nSens);
+
+		// Drop mask patterns if all restrictions have been lifted
+		bool anyPattern = false;
+		for (std::size_t i = 0; i < _sensActiveSections.size(); ++i)
+			anyPattern = anyPattern || !_sensActiveSections[i].empty();
+		if (!anyPattern)
+			_sensActiveSections.clear();
+		else
+			_sensActiveSections.resize(nSens);
 	}
 
 	void Simulator::postFwdSensInit(unsigned int nSens)
@@ -715,6 +832,9 @@ namespace cadet
 
 		_sensitiveParams.pushBackSlice(ids, numParams);
 		_absTolS.push_back(absTolS);
+
+		// By default the new sensitivity is active in all sections
+		_sensActiveSections.push_back(std::vector<char>());
 		
 		if (diffFactors)
 			_sensitiveParamsFactor.insert(_sensitiveParamsFactor.end(), diffFactors, diffFactors + numParams);
@@ -727,6 +847,20 @@ namespace cadet
 		setSensitiveParameter(ids, nullptr, numParams, absTolS);
 	}
 
+	void Simulator::setSensitiveParameterSections(unsigned int idx, bool const* activeSections, unsigned int numSections)
+	{
+		if (idx >= _sensActiveSections.size())
+			throw InvalidParameterException("Sensitive parameter index " + std::to_string(idx) + " out of bounds (" + std::to_string(_sensActiveSections.size()) + " sensitivities)");
+
+		std::vector<char>& pattern = _sensActiveSections[idx];
+		pattern.assign(activeSections, activeSections + numSections);
+
+		// An all-active pattern is equivalent to no restriction at all; drop it so that
+		// residualSensWrapper() can skip the mask construction entirely
+		if (std::find(pattern.begin(), pattern.end(), char(0)) == pattern.end())
+			pattern.clear();
+	}
+
 	void Simulator::resetSensParams()
 	{
 		using std::to_string;
@@ -766,6 +900,7 @@ namespace cadet
 		_sensitiveParams.clear();
 		_sensitiveParamsFactor.clear();
 		_absTolS.clear();
+		_sensActiveSections.clear();
 
 		_model->clearSensParams();
 		for (unsigned int i = 0; i < _sectionTimes.size(); ++i)
@@ -879,6 +1014,38 @@ namespace cadet
 			_model->setParameter(id, value);
 	}
 
+	bool Simulator::setParameterValues(ParameterId const* ids, double const* values, unsigned int numParams)
+	{
+		bool allFound = true;
+		bool sectionTimesChanged = false;
+
+		for (unsigned int i = 0; i < numParams; ++i)
+		{
+			const ParameterId& id = ids[i];
+			bool found = false;
+
+			if (isSectionTimeParameter(id, _sectionTimes.size()))
+			{
+				_sectionTimes[id.section].setValue(values[i]);
+				sectionTimesChanged = true;
+				found = true;
+
+				// Do not continue here, since model can also contain instances of SECTION_TIMES
+			}
+
+			if (_model)
+				found = _model->setParameter(id, values[i]) || found;
+
+			allFound = allFound && found;
+		}
+
+		// Update the time transformation only once after all updates have been applied
+		if (sectionTimesChanged)
+			calculateTimeTransformation(false);
+
+		return allFound;
+	}
+
 	void Simulator::setSolutionTimes(const std::vector<double>& solutionTimes)
 	{
 		_solutionTimes = solutionTimes;
@@ -886,6 +1053,11 @@ namespace cadet
 
 		// Transform user solution times
 		transformSolutionTimes();
+
+		// Pass the now known output count on to an already attached recorder such
+		// that all trajectory buffers can be preallocated exactly
+		if (_solRecorder)
+			_solRecorder->notifyTimePoints(_solutionTimes.size());
 	}
 
 	const std::vector<double>& Simulator::getSolutionTimes() const
@@ -926,6 +1098,14 @@ namespace cadet
 
 		_sectionContinuity = sectionContinuity;
 
+		// The step size history of a previous run only carries over to section indices
+		// of an unchanged layout (e.g., the next cycle of a cyclic process)
+		if (_sectionStepHistory.size() != sectionTimes.size() - 1)
+			_sectionStepHistory.assign(sectionTimes.size() - 1, 0.0);
+
+		// Precompute the transition plan for the new continuity pattern
+		computeSectionTransitionPlan();
+
 		// Calculate the transformed section times
 		calculateTimeTransformation(true);
 
@@ -942,6 +1122,22 @@ namespace cadet
 		}
 	}
 
+	void Simulator::computeSectionTransitionPlan()
+	{
+		const unsigned int nSec = _sectionTimes.size() - 1;
+		_sectionSliceLength.resize(nSec);
+		_sectionEntryDiscontinuous.resize(nSec);
+
+		// Walk the transitions backwards such that each slice length is the run of
+		// continuous transitions starting at the section plus the section itself
+		_sectionSliceLength[nSec - 1] = 1;
+		for (int i = static_cast<int>(nSec) - 2; i >= 0; --i)
+			_sectionSliceLength[i] = _sectionContinuity[i] ? _sectionSliceLength[i + 1] + 1 : 1;
+
+		for (unsigned int i = 0; i < nSec; ++i)
+			_sectionEntryDiscontinuous[i] = ((i == 0) || !_sectionContinuity[i - 1]) ? 1 : 0;
+	}
+
 	void Simulator::transformSolutionTimes()
 	{
 		for (unsigned int i = 0; i < _solutionTimes.size(); ++i)
@@ -978,7 +1174,13 @@ namespace cadet
 		}
 	}
 
-	const active Simulator::timeFactor(unsigned int curSec) const
+	void Simulator::setProgressMonitor(IProgressMonitor* monitor, unsigned int stride) CADET_NOEXCEPT
+	{
+		_progressMonitor = monitor;
+		_progressStride = std::max(stride, 1u);
+	}
+
+	const active Simulator::timeFactor(unsigned int curSec) const CADET_NOEXCEPT
 	{
 //		return (_transformedTimes[curSec + 1] - _transformedTimes[curSec]) / static_cast<double>(_sectionTimes[curSec + 1] - _sectionTimes[curSec]);
 		return (_transformedTimes[curSec + 1] - _transformedTimes[curSec]) / (_sectionTimes[curSec + 1] - _sectionTimes[curSec]);
@@ -999,7 +1201,7 @@ namespace cadet
 		return -1.0;
 	}
 
-	active Simulator::toRealTime(double t, unsigned int curSec) const
+	active Simulator::toRealTime(double t, unsigned int curSec) const CADET_NOEXCEPT
 	{
 		for (unsigned int i = curSec; i < _transformedTimes.size()-1; ++i)
 		{
@@ -1011,6 +1213,34 @@ namespace cadet
 		return active(-1.0);
 	}
 
+	void Simulator::recordSectionStatistics(unsigned int firstSec, unsigned int gmresIterBefore)
+	{
+		long int nSteps = 0;
+		long int nResEvals = 0;
+		long int nErrTestFails = 0;
+		long int nNonlinIters = 0;
+		long int nNonlinConvFails = 0;
+		long int nLinSetups = 0;
+
+		IDAGetNumSteps(_idaMemBlock, &nSteps);
+		IDAGetNumResEvals(_idaMemBlock, &nResEvals);
+		IDAGetNumErrTestFails(_idaMemBlock, &nErrTestFails);
+		IDAGetNumNonlinSolvIters(_idaMemBlock, &nNonlinIters);
+		IDAGetNumNonlinSolvConvFails(_idaMemBlock, &nNonlinConvFails);
+		IDAGetNumLinSolvSetups(_idaMemBlock, &nLinSetups);
+
+		SectionStatistics stats;
+		stats.section = firstSec;
+		stats.numSteps = static_cast<unsigned int>(nSteps);
+		stats.numResEvals = static_cast<unsigned int>(nResEvals);
+		stats.numErrTestFails = static_cast<unsigned int>(nErrTestFails);
+		stats.numNonlinIters = static_cast<unsigned int>(nNonlinIters);
+		stats.numNonlinConvFails = static_cast<unsigned int>(nNonlinConvFails);
+		stats.numLinSetups = static_cast<unsigned int>(nLinSetups);
+		stats.numGmresIters = _model->numGmresIterations() - gmresIterBefore;
+		_sectionStats.push_back(stats);
+	}
+
 	void Simulator::integrate()
 	{
 		// In this function the model is integrated by IDAS from the SUNDIALS package.
@@ -1020,15 +1250,10 @@ namespace cadet
 		// discontinuitites and the solver is restarted accordingly. This also requires
 		// the computation of consistent initial values for each restart.
 
-		// This sets up the tbb thread limiter
-		// TBB can use up to _nThreads but it may use fewer
-#ifdef CADET_PARALLELIZE
-		tbb::task_scheduler_init init(tbb::task_scheduler_init::deferred);
-		if (_nThreads > 0)
-			init.initialize(_nThreads);
-		else
-			init.initialize(tbb::task_scheduler_init::default_num_threads());
-#endif
+		// This applies the thread limit to the persistent process-wide pool
+		// TBB can use up to _nThreads but it may use fewer; the pool survives
+		// this call such that repeated integrations do not recreate the threads
+		util::ThreadPool::instance().ensureInitialized(_nThreads);
 
 		// Set number of threads in SUNDIALS OpenMP-enabled implementation
 		#ifdef CADET_SUNDIALS_OPENMP
@@ -1048,12 +1273,22 @@ namespace cadet
 
 		// Set number of AD directions
 		// @todo This is problematic if multiple Simulators are run concurrently!
-#if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
+#if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SFAD_ARENA) || defined(ACTIVE_SETFAD)
 		LOG(Debug) << "Setting AD directions from " << ad::getDirections() << " to " << numSensitivityAdDirections() + _model->requiredADdirs();
 		ad::setDirections(numSensitivityAdDirections() + _model->requiredADdirs());
 #endif
+		// Reacquire the AD workspace in case it has been released at the end of a
+		// previous integrate() call; the pool reuses or lazily grows its memory
+		if (_model->usesAD())
+		{
+			_adRes.require(_model->numDofs());
+			_adY.require(_model->numDofs());
+		}
+		if (_sensitiveParams.slices() > 0)
+			_adRes.require(_model->numDofs());
+
 		// Setup AD vectors by model
-		_model->prepareADvectors(_vecADres, _vecADy, numSensitivityAdDirections());
+		_model->prepareADvectors(_adRes.get(), _adY.get(), numSensitivityAdDirections());
 
 		std::vector<double>::const_iterator it;
 		double tOut = 0.0;
@@ -1068,13 +1303,32 @@ namespace cadet
 		}
 
 		// Decide whether to use user specified solution output times (IDA_NORMAL)
-		// or internal integrator steps (IDA_ONE_STEP)
+		// or internal integrator steps (IDA_ONE_STEP). In dense-output mode the
+		// integrator also steps freely and the solution at the user specified times
+		// is evaluated from its interpolating polynomial.
+		const bool denseOutput = writeAtUserTimes && _denseOutput;
 		int idaTask = IDA_ONE_STEP;
-		if (writeAtUserTimes)
+		if (writeAtUserTimes && !denseOutput)
 		{
 			idaTask = IDA_NORMAL;
 		}
 
+		// Temporary vectors receiving the interpolated solution in dense-output mode
+		N_Vector yInterp = nullptr;
+		N_Vector yDotInterp = nullptr;
+		N_Vector* ysInterp = nullptr;
+		N_Vector* ysDotInterp = nullptr;
+		if (denseOutput)
+		{
+			yInterp = NVec_New(_model->numDofs());
+			yDotInterp = NVec_New(_model->numDofs());
+			if (wantSensitivities)
+			{
+				ysInterp = NVec_CloneArray(_sensitiveParams.slices(), _vecStateY);
+				ysDotInterp = NVec_CloneArray(_sensitiveParams.slices(), _vecStateYdot);
+			}
+		}
+
 		LOG(Debug) << "Integration span: [" << _transformedTimes[0] << ", " << _transformedTimes.back() 
 			<< "] transformed, [" << static_cast<double>(_sectionTimes[0]) << ", " << static_cast<double>(_sectionTimes.back()) << "] sections";
 		
@@ -1085,7 +1339,27 @@ namespace cadet
 
 		double transformedT = _transformedTimes[0];
 		_curSec = 0;
+		_sectionStats.clear();
+		_stepTrace.clear();
+
+		// Continue from the section boundary stored in a restored checkpoint
+		if (_hasResumeState)
+		{
+			transformedT = _curTransformedTime;
+			_hasResumeState = false;
+		}
 		const double tEnd = writeAtUserTimes ? _solutionTimes.back() : _transformedTimes.back();
+
+		// Progress reporting state: overall time span, wall clock, steps of completed
+		// integration slices, and the step count at the last notification
+		const double progBegin = transformedT;
+		const double progSpan = _transformedTimes.back() - progBegin;
+		unsigned long progStepsDoneSlices = 0;
+		unsigned long progLastNotified = 0;
+		Timer progTimer;
+		if (_progressMonitor)
+			progTimer.start();
+
 		while (transformedT < tEnd)
 		{
 			// Get smallest index with t_i >= transformedT (t_i being a _transformedTimes element)
@@ -1094,25 +1368,35 @@ namespace cadet
 			_curSec = getNextSection(transformedT, _curSec);
 			const double startTime = _transformedTimes[_curSec];
 
-			// Determine continuous time slice
-			unsigned int skip = 1; // Always finish the current section
-			for (size_t i = _curSec; i < _transformedTimes.size() - 2; ++i)
-			{
-				if (!_sectionContinuity[i])
-					break;
+			// Determine continuous time slice from the precomputed transition plan:
+			// continuous transitions do not restart the integrator, we just integrate
+			// for a longer time
+			const unsigned int skip = (_curSec < _sectionSliceLength.size()) ? _sectionSliceLength[_curSec] : 1;
 
-				// This is a continuous section transition, so we don't need to
-				// restart the integrator and just integrate for a longer time
-				++skip;
-			}
+			// A slice can only begin at a continuous transition when resuming from a
+			// checkpoint; in that case state, time derivatives, and Jacobians carry over
+			// unchanged and the conservative reinitialization work is skipped entirely
+			const bool discontinuousEntry = (_curSec >= _sectionEntryDiscontinuous.size()) || (_sectionEntryDiscontinuous[_curSec] != 0);
 
 			const double endTime = writeAtUserTimes ? std::min(_transformedTimes[_curSec + skip], tEnd) : _transformedTimes[_curSec + skip];
 			transformedT = startTime;
+			_curTransformedTime = transformedT;
+
+			// Periodic checkpointing: the state at a section boundary fully determines the
+			// remainder of the run, since the time integrator is re-initialized here anyway
+			if (!_checkpointFile.empty() && (_curSec > 0))
+				saveCheckpoint(_checkpointFile.c_str());
 
 			LOG(Debug) << " ###### SECTION " << _curSec << " from " << startTime << " to " << endTime;
 
 			// IDAS Step 7.3: Set the initial step size
-			const double stepSize = _initStepSize.size() > 1 ? _initStepSize[_curSec] : _initStepSize[0];
+			// A converged step size recorded for this section on its previous visit (the
+			// same section of the previous cycle or integration run) takes precedence over
+			// the configured guess, so the controller does not relearn the step profile
+			// of recurring dynamics after every restart
+			double stepSize = _initStepSize.size() > 1 ? _initStepSize[_curSec] : _initStepSize[0];
+			if ((_curSec < _sectionStepHistory.size()) && (_sectionStepHistory[_curSec] > 0.0))
+				stepSize = std::min(_sectionStepHistory[_curSec], endTime - startTime);
 			IDASetInitStep(_idaMemBlock, stepSize);
 
 			// IDAS Step 7.4: Set the stop time
@@ -1120,23 +1404,37 @@ namespace cadet
 
 			// Update Jacobian
 			active realT = toRealTime(transformedT, _curSec);
-			_model->notifyDiscontinuousSectionTransition(static_cast<double>(realT), _curSec, _vecADres, _vecADy, numSensitivityAdDirections());
+			if (discontinuousEntry)
+				_model->notifyDiscontinuousSectionTransition(static_cast<double>(realT), _curSec, _adRes.get(), _adY.get(), numSensitivityAdDirections());
 
 			// Get time factor
 			const active curTimeFactor = timeFactor(_curSec);
 
 			// Compute consistent initial values
-			LOG(Debug) << "---====--- CONSISTENCY ---====--- ";
-			const double consPrev = _model->residualNorm(static_cast<double>(realT), _curSec, static_cast<double>(curTimeFactor), NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot));
-			LOG(Debug) << " ==========> Consistency error prev: " << consPrev;
+			if (discontinuousEntry)
+			{
+				LOG(Debug) << "---====--- CONSISTENCY ---====--- ";
+				const double consPrev = _model->residualNorm(static_cast<double>(realT), _curSec, static_cast<double>(curTimeFactor), NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot));
+				LOG(Debug) << " ==========> Consistency error prev: " << consPrev;
+			}
 
-			if (!_skipConsistencyStateY && (_consistentInitMode != ConsistentInitialization::None))
+			if (discontinuousEntry && !_skipConsistencyStateY && (_consistentInitMode != ConsistentInitialization::None))
 			{
-				const ConsistentInitialization mode = currentConsistentInitMode(_consistentInitMode, _curSec);
+				ConsistentInitialization mode = currentConsistentInitMode(_consistentInitMode, _curSec);
+
+				// If all discontinuities at this boundary are exactly known state jumps (e.g.,
+				// rectangular pulses of a piecewise polynomial inlet profile), the jumps are
+				// applied exactly during initialization and a lean reinitialization suffices
+				if ((mode == ConsistentInitialization::Full) && _model->exactSectionTransition(static_cast<double>(realT), _curSec))
+				{
+					LOG(Debug) << " ==========> Exact section transition detected, downgrading Full to Lean consistent initialization";
+					mode = ConsistentInitialization::Lean;
+				}
+
 				if (mode == ConsistentInitialization::Full)
 				{
 					_model->consistentInitialConditions(static_cast<double>(realT), _curSec, static_cast<double>(curTimeFactor), NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), 
-						_vecADres, _vecADy, numSensitivityAdDirections(), _algTol);
+						_adRes.get(), _adY.get(), numSensitivityAdDirections(), _algTol);
 
 					const double consPost = _model->residualNorm(static_cast<double>(realT), _curSec, static_cast<double>(curTimeFactor), NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot));
 					LOG(Debug) << " ==========> Consistency error post Full: " << consPost;
@@ -1144,7 +1442,7 @@ namespace cadet
 				else if (mode == ConsistentInitialization::Lean)
 				{
 					_model->leanConsistentInitialConditions(static_cast<double>(realT), _curSec, static_cast<double>(curTimeFactor), NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), 
-						_vecADres, _vecADy, numSensitivityAdDirections(), _algTol);
+						_adRes.get(), _adY.get(), numSensitivityAdDirections(), _algTol);
 
 					const double consPost = _model->residualNorm(static_cast<double>(realT), _curSec, static_cast<double>(curTimeFactor), NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot));
 					LOG(Debug) << " ==========> Consistency error post Lean: " << consPost;
@@ -1160,7 +1458,7 @@ namespace cadet
 			}
 			_skipConsistencyStateY = false;
 
-			if ((_sensitiveParams.slices() > 0) && !_skipConsistencySensitivity && (_consistentInitModeSens != ConsistentInitialization::None))
+			if (discontinuousEntry && (_sensitiveParams.slices() > 0) && !_skipConsistencySensitivity && (_consistentInitModeSens != ConsistentInitialization::None))
 			{
 #ifdef CADET_DEBUG
 				const std::vector<const double*> sensYdbg = convertNVectorToStdVectorPtrs<const double*>(_vecFwdYs, _sensitiveParams.slices());
@@ -1169,7 +1467,7 @@ namespace cadet
 				std::vector<double> norms(_sensitiveParams.slices(), 0.0);
 				std::vector<double> temp(_model->numDofs(), 0.0);
 				_model->residualSensFwdNorm(_sensitiveParams.slices(), realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot),
-					sensYdbg, sensYdotDbg, norms.data(), _vecADres, temp.data());
+					sensYdbg, sensYdotDbg, norms.data(), _adRes.get(), temp.data());
 
 				LOG(Debug) << " ==========> Sens consistency error prev: " << norms;
 #endif
@@ -1180,11 +1478,11 @@ namespace cadet
 					// Compute consistent initial conditions for sensitivity subsystems
 					std::vector<double*> sensY = convertNVectorToStdVectorPtrs<double*>(_vecFwdYs, _sensitiveParams.slices());
 					std::vector<double*> sensYdot = convertNVectorToStdVectorPtrs<double*>(_vecFwdYsDot, _sensitiveParams.slices());
-					_model->consistentInitialSensitivity(realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), sensY, sensYdot, _vecADres, _vecADy);
+					_model->consistentInitialSensitivity(realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), sensY, sensYdot, _adRes.get(), _adY.get());
 
 #ifdef CADET_DEBUG
 					_model->residualSensFwdNorm(_sensitiveParams.slices(), realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot),
-						sensYdbg, sensYdotDbg, norms.data(), _vecADres, temp.data());
+						sensYdbg, sensYdotDbg, norms.data(), _adRes.get(), temp.data());
 
 					LOG(Debug) << " ==========> Sens consistency error post Full: " << norms;
 #endif
@@ -1194,11 +1492,11 @@ namespace cadet
 					// Compute consistent initial conditions for sensitivity subsystems
 					std::vector<double*> sensY = convertNVectorToStdVectorPtrs<double*>(_vecFwdYs, _sensitiveParams.slices());
 					std::vector<double*> sensYdot = convertNVectorToStdVectorPtrs<double*>(_vecFwdYsDot, _sensitiveParams.slices());
-					_model->leanConsistentInitialSensitivity(realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), sensY, sensYdot, _vecADres, _vecADy);
+					_model->leanConsistentInitialSensitivity(realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), sensY, sensYdot, _adRes.get(), _adY.get());
 
 #ifdef CADET_DEBUG
 					_model->residualSensFwdNorm(_sensitiveParams.slices(), realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot),
-						sensYdbg, sensYdotDbg, norms.data(), _vecADres, temp.data());
+						sensYdbg, sensYdotDbg, norms.data(), _adRes.get(), temp.data());
 
 					LOG(Debug) << " ==========> Sens consistency error post Lean: " << norms;
 #endif
@@ -1220,10 +1518,43 @@ namespace cadet
 			_skipConsistencySensitivity = false;
 
 			// IDAS Step 5.2: Re-initialization of the solver
+			// Note that this also resets the statistics counters of IDAS, which are read
+			// at the end of this slice (see recordSectionStatistics())
 			IDAReInit(_idaMemBlock, startTime, _vecStateY, _vecStateYdot);
 			if (numSensParams() > 0)
 				IDASensReInit(_idaMemBlock, IDA_STAGGERED, _vecFwdYs, _vecFwdYsDot);
 
+			const unsigned int gmresIterBefore = _model->numGmresIterations();
+
+			// Counter snapshots of the previous step trace event; the IDAS counters have
+			// just been reset by IDAReInit() above
+			long int tracePrevSteps = 0;
+			long int tracePrevNonlinIters = 0;
+			long int tracePrevErrTestFails = 0;
+			unsigned int tracePrevGmresIters = gmresIterBefore;
+			if (cadet_unlikely(_stepTrace.enabled()))
+			{
+				const StepTraceEvent ev{StepEventTrace::now(), static_cast<double>(realT), _curSec, StepTraceEvent::Type::SliceStart, 0, 0u, 0u, 0u, 0u};
+				_stepTrace.record(ev);
+			}
+
+			// Temporarily relax the error test away from the disturbance front if this
+			// section starts with a discontinuity
+			bool tolRelaxed = false;
+			if ((_transitionRelaxFactor > 1.0) && (_curSec > 0) && discontinuousEntry)
+			{
+				N_Vector baseTol = NVec_New(_model->numDofs());
+				N_Vector relaxedTol = NVec_New(_model->numDofs());
+
+				assembleAbsTolVector(NVEC_DATA(baseTol));
+				_model->relaxTransitionErrorTol(NVEC_DATA(baseTol), _transitionRelaxFactor, NVEC_DATA(relaxedTol));
+				IDASVtolerances(_idaMemBlock, _relTol, relaxedTol);
+
+				NVec_Destroy(baseTol);
+				NVec_Destroy(relaxedTol);
+				tolRelaxed = true;
+			}
+
 			// Inititalize the IDA solver flag
 			int solverFlag = IDA_SUCCESS;
 
@@ -1236,6 +1567,11 @@ namespace cadet
 				// Initialize iterator and forward it to the first solution time that lies inside the current section
 				it = _solutionTimes.begin();
 				while ((*it) <= startTime) ++it;
+
+				// In dense-output mode tOut - only during the first call to IDASolve - specifies
+				// the direction and rough scale of the independent variable, see IDAS Guide p.33
+				if (denseOutput)
+					tOut = endTime;
 			}
 			else
 			{
@@ -1258,20 +1594,95 @@ namespace cadet
 					// otherwise integrate till IDA_TSTOP_RETURN
 					if (it == _solutionTimes.end())
 						break;
-					else
+					else if (!denseOutput)
 						tOut = *it;
 				}
 
 				// IDA Step 11: Advance solution in time
+#ifdef CADET_DEBUG_COUNT_ALLOCATIONS
+				const std::size_t allocsBeforeStep = util::heapAllocationCount();
+#endif
 				solverFlag = IDASolve(_idaMemBlock, tOut, &transformedT, _vecStateY, _vecStateYdot, idaTask);
-				LOG(Debug) << "Solve from " << transformedT << " to " << tOut << " => " 
+#ifdef CADET_DEBUG_COUNT_ALLOCATIONS
+				const std::size_t allocsInStep = util::heapAllocationCount() - allocsBeforeStep;
+				if (allocsInStep > 0)
+				{
+					LOG(Warning) << "Time step towards t = " << tOut << " performed " << allocsInStep << " heap allocations";
+				}
+#endif
+				LOG(Debug) << "Solve from " << transformedT << " to " << tOut << " => "
 					<< (solverFlag == IDA_SUCCESS ? "IDA_SUCCESS" : "") << (solverFlag == IDA_TSTOP_RETURN ? "IDA_TSTOP_RETURN" : "");
 				realT = toRealTime(transformedT, _curSec);
 
+				// Record a step trace event carrying the counter increments since the
+				// previous event; only raw counter reads and one store on the hot path
+				if (cadet_unlikely(_stepTrace.enabled()))
+				{
+					long int nSteps = 0;
+					long int nNonlinIters = 0;
+					long int nErrTestFails = 0;
+					IDAGetNumSteps(_idaMemBlock, &nSteps);
+					IDAGetNumNonlinSolvIters(_idaMemBlock, &nNonlinIters);
+					IDAGetNumErrTestFails(_idaMemBlock, &nErrTestFails);
+					const unsigned int nGmresIters = _model->numGmresIterations();
+
+					const StepTraceEvent ev{StepEventTrace::now(), static_cast<double>(realT), _curSec, StepTraceEvent::Type::Step, solverFlag,
+						static_cast<unsigned int>(nSteps - tracePrevSteps), static_cast<unsigned int>(nNonlinIters - tracePrevNonlinIters),
+						nGmresIters - tracePrevGmresIters, static_cast<unsigned int>(nErrTestFails - tracePrevErrTestFails)};
+					_stepTrace.record(ev);
+
+					tracePrevSteps = nSteps;
+					tracePrevNonlinIters = nNonlinIters;
+					tracePrevErrTestFails = nErrTestFails;
+					tracePrevGmresIters = nGmresIters;
+				}
+
+				// Restore the nominal error tolerances once the integrator has advanced
+				// into the new section
+				if (tolRelaxed)
+				{
+					updateMainErrorTolerances();
+					tolRelaxed = false;
+				}
+
+				// Notify the progress monitor after every _progressStride successful steps
+				if (_progressMonitor && (solverFlag >= 0))
+				{
+					long int stepsInSlice = 0;
+					IDAGetNumSteps(_idaMemBlock, &stepsInSlice);
+					const unsigned long totalSteps = progStepsDoneSlices + static_cast<unsigned long>(stepsInSlice);
+
+					if (totalSteps - progLastNotified >= _progressStride)
+					{
+						progLastNotified = totalSteps;
+
+						const double elapsed = progTimer.peek();
+						const double frac = (progSpan > 0.0) ? std::min((transformedT - progBegin) / progSpan, 1.0) : 1.0;
+
+						// Extrapolate the step density of the current slice over the remaining
+						// time span and convert via the mean wall clock cost per step so far
+						double eta = -1.0;
+						if ((stepsInSlice > 0) && (transformedT > startTime) && (totalSteps > 0))
+						{
+							const double stepDensity = static_cast<double>(stepsInSlice) / (transformedT - startTime);
+							eta = stepDensity * (_transformedTimes.back() - transformedT) * (elapsed / static_cast<double>(totalSteps));
+						}
+
+						_progressMonitor->progress(static_cast<double>(realT), _curSec, static_cast<unsigned int>(totalSteps), frac, eta);
+					}
+				}
+
 				switch (solverFlag)
 				{
 				case IDA_SUCCESS:
-					// tOut was reached
+					// tOut was reached or an internal step has completed (dense output)
+
+					if (denseOutput)
+					{
+						// Evaluate the solution at all user specified times covered by the step
+						writeDenseOutput(it, transformedT, yInterp, yDotInterp, ysInterp, ysDotInterp);
+						break;
+					}
 
 					// Extract sensitivity information from IDA (required for consistent initialization
 					// and output of sensitivities)
@@ -1297,7 +1708,12 @@ namespace cadet
 					}
 
 					// Section end time was reached (in previous step)
-					if (!writeAtUserTimes && (endTime == _transformedTimes.back()))
+					if (denseOutput)
+					{
+						// Evaluate the solution at the remaining user specified times of this section
+						writeDenseOutput(it, transformedT, yInterp, yDotInterp, ysInterp, ysDotInterp);
+					}
+					else if (!writeAtUserTimes && (endTime == _transformedTimes.back()))
 					{
 						// Write a solution for the ultimate endTime in the last section,
 						// when we write at integration times.
@@ -1305,8 +1721,24 @@ namespace cadet
 					}
 					break;
 				default:
+					recordSectionStatistics(_curSec, gmresIterBefore);
 					_lastIntTime = _timerIntegration.stop();
 
+					if (denseOutput)
+					{
+						NVec_Destroy(yInterp);
+						NVec_Destroy(yDotInterp);
+						if (wantSensitivities)
+						{
+							NVec_DestroyArray(ysInterp, _sensitiveParams.slices());
+							NVec_DestroyArray(ysDotInterp, _sensitiveParams.slices());
+						}
+					}
+
+					// Release the AD workspace like in the success path below
+					_adRes.release();
+					_adY.release();
+
 					// An error occured
 					LOG(Error) << "IDASolve returned " << IDAGetReturnFlagName(solverFlag) << " at t = " << static_cast<double>(realT);
 					throw IntegrationException("Error in IDASolve!"); //todo might not be necessary
@@ -1315,11 +1747,256 @@ namespace cadet
 
 			} // while
 
+			recordSectionStatistics(_curSec, gmresIterBefore);
+
+			// Remember the step size the controller settled on in this slice; the next
+			// visit of the same section starts from it instead of relearning. The current
+			// (i.e., next attempted) step is used since the last accepted step may have
+			// been truncated to hit the stop time exactly.
+			if (_curSec < _sectionStepHistory.size())
+			{
+				double curStep = 0.0;
+				IDAGetCurrentStep(_idaMemBlock, &curStep);
+				if (curStep > 0.0)
+					_sectionStepHistory[_curSec] = curStep;
+			}
+
+			// The step counters of IDAS are reset on reinitialization at the next
+			// discontinuous section transition, so carry the slice total over
+			progStepsDoneSlices += _sectionStats.back().numSteps;
+
 		} // for (_sec ...)
 
+		if (denseOutput)
+		{
+			NVec_Destroy(yInterp);
+			NVec_Destroy(yDotInterp);
+			if (wantSensitivities)
+			{
+				NVec_DestroyArray(ysInterp, _sensitiveParams.slices());
+				NVec_DestroyArray(ysDotInterp, _sensitiveParams.slices());
+			}
+		}
+
+		// Remember the last accepted step size for warm starting subsequent runs
+		IDAGetLastStep(_idaMemBlock, &_lastIntStepSize);
+		_curTransformedTime = transformedT;
+
+		// Release the AD workspace until the next run; this cuts resident memory
+		// when many simulators take turns in one process
+		_adRes.release();
+		_adY.release();
+
 		_lastIntTime = _timerIntegration.stop();
 	}
 
+	unsigned int Simulator::integrateToCyclicSteadyState(unsigned int maxCycles, double tol)
+	{
+		const unsigned int nDofs = numDofs();
+
+		// Iterate the end-of-cycle map G(y): state at cycle start -> state at cycle end,
+		// accelerated by Anderson mixing of depth 1. Compared to plain repeated cycling
+		// (Picard iteration), the mixing extrapolates along the difference of the last
+		// two cycle residuals, which contracts the slowly decaying modes of the cycle
+		// map and typically reaches cyclic steady state in a handful of cycles.
+		std::vector<double> yCur(NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateY) + nDofs);
+		std::vector<double> gCur(nDofs, 0.0);
+		std::vector<double> gPrev(nDofs, 0.0);
+		std::vector<double> fCur(nDofs, 0.0);
+		std::vector<double> fPrev(nDofs, 0.0);
+
+		for (unsigned int cycle = 1; cycle <= maxCycles; ++cycle)
+		{
+			integrate();
+
+			unsigned int len = 0;
+			double const* const yEnd = getLastSolution(len);
+			std::copy(yEnd, yEnd + nDofs, gCur.begin());
+
+			// Cycle residual f_k = G(y_k) - y_k and its norm relative to the iterate
+			double normF = 0.0;
+			double normY = 0.0;
+			for (unsigned int i = 0; i < nDofs; ++i)
+			{
+				fCur[i] = gCur[i] - yCur[i];
+				normF += fCur[i] * fCur[i];
+				normY += yCur[i] * yCur[i];
+			}
+			normF = std::sqrt(normF);
+			normY = std::sqrt(normY);
+
+			LOG(Debug) << "Cyclic steady state cycle " << cycle << " residual " << normF << " (state norm " << normY << ")";
+
+			if (normF <= tol * std::max(normY, 1.0))
+				return cycle;
+
+			if (cycle == 1)
+			{
+				// No residual history yet, take the plain Picard step
+				std::copy(gCur.begin(), gCur.end(), yCur.begin());
+			}
+			else
+			{
+				// Anderson mixing: minimize || f_k + gamma (f_k - f_{k-1}) || over gamma
+				double num = 0.0;
+				double den = 0.0;
+				for (unsigned int i = 0; i < nDofs; ++i)
+				{
+					const double df = fCur[i] - fPrev[i];
+					num += fCur[i] * df;
+					den += df * df;
+				}
+
+				// Fall back to Picard on (nearly) linearly dependent residuals and keep
+				// the extrapolation bounded to avoid overshooting into unphysical states
+				double gamma = (den > 0.0) ? (num / den) : 0.0;
+				gamma = std::max(-2.0, std::min(2.0, gamma));
+
+				for (unsigned int i = 0; i < nDofs; ++i)
+					yCur[i] = gCur[i] - gamma * (gCur[i] - gPrev[i]);
+			}
+
+			fPrev.swap(fCur);
+			gPrev.swap(gCur);
+
+			// Matching yDot is recovered by consistent initialization at cycle start
+			setInitialCondition(yCur.data());
+		}
+
+		return maxCycles + 1;
+	}
+
+	namespace
+	{
+		//! Magic bytes identifying a checkpoint file
+		const char checkpointMagic[8] = {'C', 'A', 'D', 'E', 'T', 'C', 'K', 'P'};
+		//! Version of the checkpoint file format
+		const std::uint32_t checkpointVersion = 1;
+	}
+
+	bool Simulator::saveCheckpoint(const char* fileName) const
+	{
+		if (!_vecStateY || !fileName)
+			return false;
+
+		// Write to a temporary file first and rename afterwards such that a crash
+		// during the write cannot corrupt an existing checkpoint
+		const std::string tempName = std::string(fileName) + ".tmp";
+		{
+			std::ofstream file(tempName.c_str(), std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				LOG(Error) << "Failed to open checkpoint file " << tempName << " for writing";
+				return false;
+			}
+
+			const std::uint64_t nDofs = NVEC_LENGTH(_vecStateY);
+			const std::uint32_t nSens = _sensitiveParams.slices();
+
+			file.write(checkpointMagic, sizeof(checkpointMagic));
+			file.write(reinterpret_cast<const char*>(&checkpointVersion), sizeof(checkpointVersion));
+			file.write(reinterpret_cast<const char*>(&nDofs), sizeof(nDofs));
+			file.write(reinterpret_cast<const char*>(&nSens), sizeof(nSens));
+			file.write(reinterpret_cast<const char*>(&_curTransformedTime), sizeof(double));
+			file.write(reinterpret_cast<const char*>(&_lastIntStepSize), sizeof(double));
+
+			file.write(reinterpret_cast<const char*>(NVEC_DATA(_vecStateY)), nDofs * sizeof(double));
+			file.write(reinterpret_cast<const char*>(NVEC_DATA(_vecStateYdot)), nDofs * sizeof(double));
+			for (std::uint32_t i = 0; i < nSens; ++i)
+			{
+				file.write(reinterpret_cast<const char*>(NVEC_DATA(_vecFwdYs[i])), nDofs * sizeof(double));
+				file.write(reinterpret_cast<const char*>(NVEC_DATA(_vecFwdYsDot[i])), nDofs * sizeof(double));
+			}
+
+			if (!file)
+			{
+				LOG(Error) << "Failed to write checkpoint file " << tempName;
+				return false;
+			}
+		}
+
+		if (std::rename(tempName.c_str(), fileName) != 0)
+		{
+			LOG(Error) << "Failed to move checkpoint file " << tempName << " to " << fileName;
+			return false;
+		}
+		return true;
+	}
+
+	bool Simulator::resumeFromCheckpoint(const char* fileName)
+	{
+		if (!_vecStateY)
+		{
+			LOG(Error) << "Cannot resume from checkpoint before the model has been initialized";
+			return false;
+		}
+
+		std::ifstream file(fileName, std::ios::binary);
+		if (!file)
+		{
+			LOG(Error) << "Failed to open checkpoint file " << fileName;
+			return false;
+		}
+
+		char magic[sizeof(checkpointMagic)];
+		std::uint32_t version = 0;
+		std::uint64_t nDofs = 0;
+		std::uint32_t nSens = 0;
+		double time = 0.0;
+		double lastStepSize = 0.0;
+
+		file.read(magic, sizeof(magic));
+		file.read(reinterpret_cast<char*>(&version), sizeof(version));
+		file.read(reinterpret_cast<char*>(&nDofs), sizeof(nDofs));
+		file.read(reinterpret_cast<char*>(&nSens), sizeof(nSens));
+		file.read(reinterpret_cast<char*>(&time), sizeof(time));
+		file.read(reinterpret_cast<char*>(&lastStepSize), sizeof(lastStepSize));
+
+		if (!file || (std::memcmp(magic, checkpointMagic, sizeof(magic)) != 0) || (version != checkpointVersion))
+		{
+			LOG(Error) << "Checkpoint file " << fileName << " is not a valid checkpoint";
+			return false;
+		}
+		if ((nDofs != static_cast<std::uint64_t>(NVEC_LENGTH(_vecStateY))) || (nSens != _sensitiveParams.slices()))
+		{
+			LOG(Error) << "Checkpoint file " << fileName << " does not match the problem ("
+				<< nDofs << " DOFs and " << nSens << " sensitivities vs. " << NVEC_LENGTH(_vecStateY)
+				<< " DOFs and " << _sensitiveParams.slices() << " sensitivities)";
+			return false;
+		}
+
+		file.read(reinterpret_cast<char*>(NVEC_DATA(_vecStateY)), nDofs * sizeof(double));
+		file.read(reinterpret_cast<char*>(NVEC_DATA(_vecStateYdot)), nDofs * sizeof(double));
+		for (std::uint32_t i = 0; i < nSens; ++i)
+		{
+			file.read(reinterpret_cast<char*>(NVEC_DATA(_vecFwdYs[i])), nDofs * sizeof(double));
+			file.read(reinterpret_cast<char*>(NVEC_DATA(_vecFwdYsDot[i])), nDofs * sizeof(double));
+		}
+
+		if (!file)
+		{
+			LOG(Error) << "Checkpoint file " << fileName << " is truncated";
+			return false;
+		}
+
+		_curTransformedTime = time;
+		_hasResumeState = true;
+
+		// Seed the step size of the first section like warmStartFromLastRun()
+		if (lastStepSize > 0.0)
+			setInitialStepSize(lastStepSize);
+
+		return true;
+	}
+
+	void Simulator::setCheckpointFile(const char* fileName)
+	{
+		if (fileName)
+			_checkpointFile = fileName;
+		else
+			_checkpointFile.clear();
+	}
+
 	double const* Simulator::getLastSolution(unsigned int& len) const
 	{
 		len = NVEC_LENGTH(_vecStateY);
@@ -1395,6 +2072,36 @@ namespace cadet
 		else
 			_relTolS = _relTol;
 
+		// Optional per-state-class scaling of the absolute tolerances, see
+		// setStateClassErrorTolerances()
+		_classTolColLiquid = 1.0;
+		_classTolParLiquid = 1.0;
+		_classTolBound = 1.0;
+		_classTolFlux = 1.0;
+		if (paramProvider.exists("ABSTOL_FACTOR_COL_LIQUID"))
+		{
+			const double v = paramProvider.getDouble("ABSTOL_FACTOR_COL_LIQUID");
+			_classTolColLiquid = (v > 0.0) ? v : 1.0;
+		}
+		if (paramProvider.exists("ABSTOL_FACTOR_PAR_LIQUID"))
+		{
+			const double v = paramProvider.getDouble("ABSTOL_FACTOR_PAR_LIQUID");
+			_classTolParLiquid = (v > 0.0) ? v : 1.0;
+		}
+		if (paramProvider.exists("ABSTOL_FACTOR_BOUND"))
+		{
+			const double v = paramProvider.getDouble("ABSTOL_FACTOR_BOUND");
+			_classTolBound = (v > 0.0) ? v : 1.0;
+		}
+		if (paramProvider.exists("ABSTOL_FACTOR_FLUX"))
+		{
+			const double v = paramProvider.getDouble("ABSTOL_FACTOR_FLUX");
+			_classTolFlux = (v > 0.0) ? v : 1.0;
+		}
+
+		if (paramProvider.exists("STEP_TRACE_CAPACITY"))
+			_stepTrace.setCapacity(paramProvider.getInt("STEP_TRACE_CAPACITY"));
+
 		paramProvider.popScope();
 
 		if (paramProvider.exists("NTHREADS"))
@@ -1468,6 +2175,20 @@ namespace cadet
 		updateMainErrorTolerances();
 	}
 
+	void Simulator::setStateClassErrorTolerances(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor)
+	{
+		_classTolColLiquid = (colLiquidFactor > 0.0) ? colLiquidFactor : 1.0;
+		_classTolParLiquid = (parLiquidFactor > 0.0) ? parLiquidFactor : 1.0;
+		_classTolBound = (boundFactor > 0.0) ? boundFactor : 1.0;
+		_classTolFlux = (fluxFactor > 0.0) ? fluxFactor : 1.0;
+		updateMainErrorTolerances();
+	}
+
+	void Simulator::setSectionTransitionErrorRelaxation(double relaxFactor)
+	{
+		_transitionRelaxFactor = std::max(relaxFactor, 1.0);
+	}
+
 	void Simulator::setInitialStepSize(double stepSize)
 	{
 		_initStepSize.clear();
@@ -1479,6 +2200,15 @@ namespace cadet
 		_initStepSize = stepSize;
 	}
 
+	void Simulator::warmStartFromLastRun()
+	{
+		// Nothing to seed from if no run has finished yet
+		if (_lastIntStepSize <= 0.0)
+			return;
+
+		setInitialStepSize(_lastIntStepSize);
+	}
+
 	void Simulator::setMaximumSteps(unsigned int maxSteps)
 	{
 		_maxSteps = maxSteps;
@@ -1523,6 +2253,11 @@ namespace cadet
 	}
 
 	void Simulator::writeSolution(double t)
+	{
+		writeSolution(t, _vecStateY, _vecStateYdot, _vecFwdYs, _vecFwdYsDot);
+	}
+
+	void Simulator::writeSolution(double t, N_Vector y, N_Vector yDot, N_Vector const* yS, N_Vector const* ySdot)
 	{
 		if (!_solRecorder)
 			return;
@@ -1530,27 +2265,48 @@ namespace cadet
 		_solRecorder->beginTimestep(t);
 		
 		_solRecorder->beginSolution();
-		_model->reportSolution(*_solRecorder, NVEC_DATA(_vecStateY));
+		_model->reportSolution(*_solRecorder, NVEC_DATA(y));
 		_solRecorder->endSolution();
 
 		_solRecorder->beginSolutionDerivative();
-		_model->reportSolution(*_solRecorder, NVEC_DATA(_vecStateYdot));
+		_model->reportSolution(*_solRecorder, NVEC_DATA(yDot));
 		_solRecorder->endSolutionDerivative();
 
 		for (unsigned int i = 0; i < _sensitiveParams.slices(); ++i)
 		{
 			_solRecorder->beginSensitivity(*_sensitiveParams[i], i);
-			_model->reportSolution(*_solRecorder, NVEC_DATA(_vecFwdYs[i]));
+			_model->reportSolution(*_solRecorder, NVEC_DATA(yS[i]));
 			_solRecorder->endSensitivity(*_sensitiveParams[i], i);
 
 			_solRecorder->beginSensitivityDerivative(*_sensitiveParams[i], i);
-			_model->reportSolution(*_solRecorder, NVEC_DATA(_vecFwdYsDot[i]));
+			_model->reportSolution(*_solRecorder, NVEC_DATA(ySdot[i]));
 			_solRecorder->endSensitivityDerivative(*_sensitiveParams[i], i);
 		}
 
 		_solRecorder->endTimestep();
 	}
 
+	void Simulator::writeDenseOutput(std::vector<double>::const_iterator& it, double tMax, N_Vector yTemp, N_Vector yDotTemp, N_Vector* ySTemp, N_Vector* ySdotTemp)
+	{
+		const bool wantSensitivities = _sensitiveParams.slices() > 0;
+		while ((it != _solutionTimes.end()) && (*it <= tMax))
+		{
+			const double t = *it;
+
+			// Evaluate the interpolating polynomial of the integrator at the requested time
+			IDAGetDky(_idaMemBlock, t, 0, yTemp);
+			IDAGetDky(_idaMemBlock, t, 1, yDotTemp);
+			if (wantSensitivities)
+			{
+				IDAGetSensDky(_idaMemBlock, t, 0, ySTemp);
+				IDAGetSensDky(_idaMemBlock, t, 1, ySdotTemp);
+			}
+
+			writeSolution(static_cast<double>(toRealTime(t, _curSec)), yTemp, yDotTemp, ySTemp, ySdotTemp);
+			++it;
+		}
+	}
+
 	unsigned int Simulator::getNextSection(double t, unsigned int startIdx) const
 	{
 		if (t < _transformedTimes[startIdx])
@@ -1565,7 +2321,7 @@ namespace cadet
 		return -1;
 	}
 
-	unsigned int Simulator::getCurrentSection(double t) const
+	unsigned int Simulator::getCurrentSection(double t) const CADET_NOEXCEPT
 	{
 		//TODO: Use binary search
 		
@@ -19,6 +19,7 @@
 #define LIBCADET_SIMULATOR_IMPL_HPP_
 
 #include <vector>
+#include <string>
 #include <unordered_map>
 
 #include "SundialsVector.hpp"
@@ -27,18 +28,20 @@
 #include "cadet/Simulator.hpp"
 #include "AutoDiff.hpp"
 #include "SlicedVector.hpp"
+#include "MemoryPool.hpp"
+#include "StepEventTrace.hpp"
 #include "common/Timer.hpp"
 
 namespace cadet
 {
 
-int residualDaeWrapper(double t, N_Vector y, N_Vector yDot, N_Vector res, void* userData);
+int residualDaeWrapper(double t, N_Vector y, N_Vector yDot, N_Vector res, void* userData) CADET_NOEXCEPT;
 
-int linearSolveWrapper(IDAMem IDA_mem, N_Vector rhs, N_Vector weight, N_Vector yCur, N_Vector yDotCur, N_Vector resCur);
+int linearSolveWrapper(IDAMem IDA_mem, N_Vector rhs, N_Vector weight, N_Vector yCur, N_Vector yDotCur, N_Vector resCur) CADET_NOEXCEPT;
 
 int residualSensWrapper(int ns, double t, N_Vector y, N_Vector yDot, N_Vector res, 
 		N_Vector* yS, N_Vector* ySDot, N_Vector* resS,
-		void *userData, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+		void *userData, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3) CADET_NOEXCEPT;
 
 //int weightWrapper(N_Vector y, N_Vector ewt, void *user_data);
 
@@ -68,9 +71,12 @@ public:
 	virtual void setSensitiveParameterFactors(unsigned int idx, double const* factors);
 	virtual void setSensitiveParameter(ParameterId const* ids, double const* diffFactors, unsigned int numParams, double absTolS);
 	virtual void setSensitiveParameter(ParameterId const* ids, unsigned int numParams, double absTolS);
+	virtual void setSensitiveParameterSections(unsigned int idx, bool const* activeSections, unsigned int numSections);
 	virtual void setParameterValue(const ParameterId& id, double value);
+	virtual bool setParameterValues(ParameterId const* ids, double const* values, unsigned int numParams);
 
 	virtual void setSolutionTimes(const std::vector<double>& solutionTimes);
+	virtual void setDenseOutput(bool denseOutput) CADET_NOEXCEPT { _denseOutput = denseOutput; }
 	virtual const std::vector<double>& getSolutionTimes() const;
 	virtual void setSectionTimes(const std::vector<double>& sectionTimes);
 	virtual void setSectionTimes(const std::vector<double>& sectionTimes, const std::vector<bool>& sectionContinuity);
@@ -90,7 +96,14 @@ public:
 
 	virtual void setSolutionRecorder(ISolutionRecorder* recorder);
 
+	virtual void setProgressMonitor(IProgressMonitor* monitor, unsigned int stride) CADET_NOEXCEPT;
+
 	virtual void integrate();
+	virtual unsigned int integrateToCyclicSteadyState(unsigned int maxCycles, double tol);
+
+	virtual bool saveCheckpoint(const char* fileName) const;
+	virtual bool resumeFromCheckpoint(const char* fileName);
+	virtual void setCheckpointFile(const char* fileName);
 
 	virtual double const* getLastSolution(unsigned int& len) const;
 	virtual double const* getLastSolutionDerivative(unsigned int& len) const;
@@ -107,9 +120,13 @@ public:
 	virtual void setRelativeErrorTolerance(double relTol);
 	virtual void setAbsoluteErrorTolerance(double absTol);
 	virtual void setAbsoluteErrorTolerance(const std::vector<double>& absTol);
+	virtual void setStateClassErrorTolerances(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor);
+	virtual void setSectionTransitionErrorRelaxation(double relaxFactor);
 	virtual void setAlgebraicErrorTolerance(double algTol) CADET_NOEXCEPT { _algTol = algTol; }
 	virtual void setInitialStepSize(double stepSize);
 	virtual void setInitialStepSize(const std::vector<double>& stepSize);
+	virtual double lastIntegrationStepSize() const CADET_NOEXCEPT { return _lastIntStepSize; }
+	virtual void warmStartFromLastRun();
 	virtual void setMaximumSteps(unsigned int maxSteps);
 	virtual void setMaximumStepSize(double maxStepSize);
 	virtual void setRelativeErrorToleranceSens(double relTol);
@@ -125,6 +142,12 @@ public:
 
 	virtual double lastSimulationDuration() const CADET_NOEXCEPT { return _lastIntTime; }
 	virtual double totalSimulationDuration() const CADET_NOEXCEPT { return _timerIntegration.totalElapsedTime(); }
+
+	virtual const std::vector<SectionStatistics>& integratorStatistics() const CADET_NOEXCEPT { return _sectionStats; }
+
+	virtual void setStepTraceCapacity(unsigned int capacity) { _stepTrace.setCapacity(capacity); }
+	virtual std::vector<StepTraceEvent> stepTrace() const { return _stepTrace.linearize(); }
+	virtual double stepTraceTicksPerSecond() const { return _stepTrace.ticksPerSecond(); }
 protected:
 
 	/**
@@ -138,6 +161,30 @@ protected:
 	 */
 	void writeSolution(double t);
 
+	/**
+	 * @brief Reports the given solution and sensitivity vectors at time @p t
+	 * @param [in] t Current time point
+	 * @param [in] y State vector to be reported
+	 * @param [in] yDot Time derivative state vector to be reported
+	 * @param [in] yS Array with sensitivity state vectors (may be @c nullptr if there are no sensitivities)
+	 * @param [in] ySdot Array with sensitivity time derivative vectors (may be @c nullptr if there are no sensitivities)
+	 */
+	void writeSolution(double t, N_Vector y, N_Vector yDot, N_Vector const* yS, N_Vector const* ySdot);
+
+	/**
+	 * @brief Writes interpolated solutions for all pending solution times up to @p tMax
+	 * @details Evaluates the interpolating polynomial of IDAS via IDAGetDky() at each
+	 *          solution time in the interval covered by the last accepted step and reports
+	 *          the result. The iterator is advanced past all consumed solution times.
+	 * @param [in,out] it Iterator pointing to the next pending solution time
+	 * @param [in] tMax Largest (transformed) time that can be interpolated (i.e., the current integrator time)
+	 * @param [in] yTemp Temporary vector receiving interpolated states
+	 * @param [in] yDotTemp Temporary vector receiving interpolated time derivatives
+	 * @param [in] ySTemp Array of temporary vectors for interpolated sensitivities (may be @c nullptr if there are no sensitivities)
+	 * @param [in] ySdotTemp Array of temporary vectors for interpolated sensitivity derivatives (may be @c nullptr if there are no sensitivities)
+	 */
+	void writeDenseOutput(std::vector<double>::const_iterator& it, double tMax, N_Vector yTemp, N_Vector yDotTemp, N_Vector* ySTemp, N_Vector* ySdotTemp);
+
 	/**
 	 * @brief Computes the index of the next section from the given time @p t
 	 * @details Returns the lowest index @c i with @f$ t_i \geq t @f$, where 
@@ -158,7 +205,7 @@ protected:
 	 * @param [in] t Current time
 	 * @return Index of the current section corresponding to time @p t
 	 */
-	unsigned int getCurrentSection(double t) const;
+	unsigned int getCurrentSection(double t) const CADET_NOEXCEPT;
 
 	/**
 	 * @brief Enables or disables sensitivities in IDAS and allocates space for sensitivity state vectors
@@ -196,10 +243,28 @@ protected:
 	void resetSensParams();
 
 	/**
-	 * @brief Transforms the user solution times according to the (transformed) section times 
+	 * @brief Precomputes the section transition plan from the continuity flags
+	 * @details For every section, the length of the continuous integration slice starting
+	 *          there and the action required on entering it (continuous continuation vs.
+	 *          full reinitialization) are determined once, turning the per-boundary
+	 *          decisions in integrate() into table lookups.
+	 */
+	void computeSectionTransitionPlan();
+
+	/**
+	 * @brief Transforms the user solution times according to the (transformed) section times
 	 */
 	void transformSolutionTimes();
 
+	/**
+	 * @brief Records the time integrator statistics of the current integration slice
+	 * @details Reads the counters of IDAS, which are reset on each IDAReInit() and, thus,
+	 *          cover exactly the current slice, and appends them to _sectionStats.
+	 * @param [in] firstSec Index of the first section of the slice
+	 * @param [in] gmresIterBefore Accumulated GMRES iterations of the model before the slice was integrated
+	 */
+	void recordSectionStatistics(unsigned int firstSec, unsigned int gmresIterBefore);
+
 	/**
 	 * @brief Calculates _transformedTimes from _sectionTimes via time transformation
 	 * @details Since the _sectionTimes are reset, it may be necessary to reset their AD directions.
@@ -218,15 +283,32 @@ protected:
 	 */
 	void updateMainErrorTolerances();
 
-	const active timeFactor(unsigned int curSec) const;
-	inline const active timeFactor() const { return timeFactor(_curSec); }
+	/**
+	 * @brief Assembles the full vector of nominal absolute error tolerances
+	 * @details Mirrors updateMainErrorTolerances() but writes the tolerances to an array
+	 *          instead of passing them to IDAS. Scalar tolerances are replicated for all DOFs.
+	 * @param [out] absTolOut Pointer to array of size numDofs() receiving the tolerances
+	 */
+	void assembleAbsTolVector(double* absTolOut) const;
+
+	/**
+	 * @brief Determines whether any state class tolerance factor differs from @c 1.0
+	 * @return @c true if applyStateClassErrorTol() modifies the tolerances, otherwise @c false
+	 */
+	inline bool hasStateClassErrorTol() const CADET_NOEXCEPT
+	{
+		return (_classTolColLiquid != 1.0) || (_classTolParLiquid != 1.0) || (_classTolBound != 1.0) || (_classTolFlux != 1.0);
+	}
+
+	const active timeFactor(unsigned int curSec) const CADET_NOEXCEPT;
+	inline const active timeFactor() const CADET_NOEXCEPT { return timeFactor(_curSec); }
 
 	template <typename time_t>
 	double toTransformedTime(double t, const std::vector<time_t>& oldTimes, const std::vector<double>& newTimes) const;
 
 	inline double toTransformedTime(double t) const { return toTransformedTime(t, _sectionTimes, _transformedTimes); }
-	inline active toRealTime(double t) const { return toRealTime(t, _curSec); }
-	active toRealTime(double t, unsigned int curSec) const;
+	inline active toRealTime(double t) const CADET_NOEXCEPT { return toRealTime(t, _curSec); }
+	active toRealTime(double t, unsigned int curSec) const CADET_NOEXCEPT;
 
 	friend int ::cadet::residualDaeWrapper(double t, N_Vector y, N_Vector yDot, N_Vector res, void* userData);
 
@@ -242,6 +324,9 @@ protected:
 
 	ISolutionRecorder* _solRecorder;
 
+	IProgressMonitor* _progressMonitor; //!< Progress monitor notified during integrate(), not owned by the Simulator
+	unsigned int _progressStride; //!< Number of successful time integrator steps between two progress callbacks
+
 	void* _idaMemBlock; //!< IDAS internal memory
 
 	std::vector<double> _transformedTimes; //!< Stores the section time points (start, end)
@@ -254,15 +339,24 @@ protected:
 	 */
 	std::vector<bool> _sectionContinuity;
 
+	std::vector<unsigned int> _sectionSliceLength; //!< Precomputed number of contiguous sections an integration slice starting at each section covers (see computeSectionTransitionPlan())
+	std::vector<unsigned char> _sectionEntryDiscontinuous; //!< Precomputed flag for each section indicating a discontinuous transition into it
+
 	std::vector<double> _solutionTimes; //!< Contains the time transformed user specified times for writing solutions to the output
 	std::vector<double> _solutionTimesOriginal; //!< Contains the original user specified times for writing solutions to the output
+	bool _denseOutput; //!< Determines whether solutions at user specified times are interpolated instead of forcing integrator stops
 
 	N_Vector _vecStateY; //!< IDAS state vector	
 	N_Vector _vecStateYdot; //!< IDAS state vector time derivative
-	N_Vector* _vecFwdYs; //!< IDAS sensitivities vector	
+	N_Vector* _vecFwdYs; //!< IDAS sensitivities vector
 	N_Vector* _vecFwdYsDot; //!< IDAS sensitivities vector time derivative
+	std::vector<const double*> _sensYPtr; //!< Preallocated pointer table into the sensitivity state vectors for residualSensWrapper()
+	std::vector<const double*> _sensYdotPtr; //!< Preallocated pointer table into the sensitivity time derivative vectors for residualSensWrapper()
+	std::vector<double*> _sensResPtr; //!< Preallocated pointer table into the sensitivity residual vectors for residualSensWrapper()
 	util::SlicedVector<ParameterId> _sensitiveParams; //!< Stores (fused) sensitive parameters
 	std::vector<double> _sensitiveParamsFactor; //!< Stores the factors of the linear sensitive parameter combinations
+	std::vector<std::vector<char>> _sensActiveSections; //!< Per-section activation pattern of each sensitive parameter, empty if the parameter is active everywhere
+	std::vector<unsigned char> _sensMaskBuf; //!< Preallocated mask of active sensitivity directions in the current section for residualSensWrapper()
 	std::vector<active> _sectionTimes; //!< Stores the AD variables used for SECTION_TIMES parameter derivatives
 	
 	double _relTolS; //!< Relative tolerance for forward sensitivity systems in the time integration
@@ -270,8 +364,18 @@ protected:
 
 	std::vector<double> _absTol; //!< Absolute tolerance for the original system in the time integration
 	double _relTol; //!< Relative tolerance for the original system in the time integration
+	double _transitionRelaxFactor; //!< Tolerance relaxation factor applied right after discontinuous section transitions (@c 1.0 disables the feature)
+	double _classTolColLiquid; //!< Absolute tolerance factor of column liquid (bulk, inlet, and outlet) DOFs (@c 1.0 leaves them unchanged)
+	double _classTolParLiquid; //!< Absolute tolerance factor of particle liquid phase DOFs (@c 1.0 leaves them unchanged)
+	double _classTolBound; //!< Absolute tolerance factor of bound state DOFs (@c 1.0 leaves them unchanged)
+	double _classTolFlux; //!< Absolute tolerance factor of film flux DOFs (@c 1.0 leaves them unchanged)
 	double _algTol; //!< Tolerance for the solution of algebraic equations in the consistent initialization
 	std::vector<double> _initStepSize; //!< Initial step size for the time integrator
+	double _lastIntStepSize; //!< Last accepted step size of the most recent time integration run
+	std::vector<double> _sectionStepHistory; //!< Converged step size of each section slice from its previous visit (@c 0.0 marks no history)
+	std::string _checkpointFile; //!< Path of the periodic checkpoint file (empty if periodic checkpointing is disabled)
+	double _curTransformedTime; //!< Current position of the time integration in transformed time
+	bool _hasResumeState; //!< Determines whether the next integrate() call continues from a restored checkpoint
 	unsigned int _maxSteps; //!< Maximum number of time integration steps
 	double _maxStepSize; //!< Maximum time step size
 	unsigned int _nThreads; //!< Maximum number of threads CADET is allowed to use 0, disables maximum setting
@@ -284,11 +388,13 @@ protected:
 	ConsistentInitialization _consistentInitMode; //!< Mode that determines consistent initialization behavior
 	ConsistentInitialization _consistentInitModeSens; //!< Mode that determines consistent initialization behavior of the sensitivity systems
 
-	active* _vecADres; //!< Vector of AD datatypes for holding the residual
-	active* _vecADy; //!< Vector of AD datatypes for holding the state vector
+	LazyWorkspace<active> _adRes; //!< Pooled AD vector for holding the residual, acquired on demand and released after integrate()
+	LazyWorkspace<active> _adY; //!< Pooled AD vector for holding the state vector, acquired on demand and released after integrate()
 
 	Timer _timerIntegration; //!< Timer measuring the duration of the call to integrate()
 	double _lastIntTime; //!< Last simulation duration
+	std::vector<SectionStatistics> _sectionStats; //!< Per-slice time integrator statistics of the most recent integrate() run
+	StepEventTrace _stepTrace; //!< Ring buffer recording per-step events of the time integrator (disabled by default)
 };
 
 } // namespace cadet
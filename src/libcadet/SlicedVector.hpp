@@ -21,6 +21,8 @@
 #include "common/CompilerSpecific.hpp"
 #include <vector>
 #include <algorithm>
+#include <iterator>
+#include <utility>
 
 namespace cadet
 {
@@ -107,7 +109,7 @@ public:
 	}
 
 	/**
-	 * @brief Appends a given slice 
+	 * @brief Appends a given slice
 	 * @param [in] data Pointer to the first element of the slice
 	 * @param [in] size Size of the slice
 	 */
@@ -117,6 +119,36 @@ public:
 		_values.insert(_values.end(), data, data + size);
 	}
 
+	/**
+	 * @brief Appends a given slice by moving its elements
+	 * @details The elements are moved out of @p slice instead of copied.
+	 * @param [in] slice Slice to append
+	 */
+	inline void pushBackSlice(std::vector<T>&& slice)
+	{
+		_index.push_back(_index.back() + slice.size());
+		_values.insert(_values.end(), std::make_move_iterator(slice.begin()), std::make_move_iterator(slice.end()));
+	}
+
+	/**
+	 * @brief Replaces the content by adopting a linear buffer partitioned into uniform slices
+	 * @details The buffer is moved into the SlicedVector instead of appending its elements
+	 *          one by one. The number of elements in @p values has to be a multiple of
+	 *          @p sliceSize.
+	 * @param [in] values Linearized values of all slices
+	 * @param [in] sliceSize Number of elements in each slice
+	 */
+	inline void assign(std::vector<T>&& values, size_type sliceSize)
+	{
+		cadet_assert(sliceSize > 0);
+		cadet_assert(values.size() % sliceSize == 0);
+
+		_values = std::move(values);
+		_index.clear();
+		for (size_type i = 0; i <= _values.size(); i += sliceSize)
+			_index.push_back(i);
+	}
+
 	/**
 	 * @brief Append an element to the last slice
 	 * @param [in] value Element to append
@@ -369,6 +401,39 @@ public:
 	 */
 	inline size_type sliceOffset(size_type idx) const { return _index[idx]; }
 
+	/**
+	 * @brief Returns a pointer to the linearized storage
+	 * @return Pointer to the first element of the linearized storage
+	 */
+	inline T const* data() const CADET_NOEXCEPT { return _values.data(); }
+
+	/**
+	 * @brief Returns a pointer to the linearized storage
+	 * @return Pointer to the first element of the linearized storage
+	 */
+	inline T* data() CADET_NOEXCEPT { return _values.data(); }
+
+	/**
+	 * @brief Returns the common slice size if all slices have the same size
+	 * @details Allows inner loops to hoist the slice-offset indirection of operator[]
+	 *          by iterating the linearized storage returned by data() with a constant
+	 *          stride (i.e., the slice with index @c i starts at <tt>data() + i * stride</tt>).
+	 * @return Common size of all slices, or @c 0 if the slices differ in size or no slice exists
+	 */
+	inline size_type uniformSliceSize() const CADET_NOEXCEPT
+	{
+		if (empty())
+			return 0;
+
+		const size_type stride = _index[1];
+		for (size_type i = 1; i < slices(); ++i)
+		{
+			if (_index[i + 1] - _index[i] != stride)
+				return 0;
+		}
+		return stride;
+	}
+
 	/**
 	 * @brief Reserves memory without initializing it
 	 * @details Corresponds to std::vector<T>::reserve().
@@ -405,6 +470,179 @@ protected:
 	std::vector<size_type> _index; //!< Holds starting indices of slices
 };
 
+
+/**
+ * @brief A dynamically growing vector of slices with compile-time fixed slice size
+ * @details Variant of SlicedVector for the common case that all slices have the same,
+ *          statically known size. No slice index array is required since the offset of
+ *          a slice is a compile-time multiple of its index, which removes the
+ *          slice-offset indirection of SlicedVector::operator[] from inner loops.
+ * @tparam T Type of the saved data
+ * @tparam fixedSliceSize Number of elements in each slice
+ */
+template <typename T, unsigned int fixedSliceSize>
+class FixedSlicedVector
+{
+public:
+	typedef typename std::vector<T>::size_type size_type;
+
+	/**
+	 * @brief Creates an empty FixedSlicedVector
+	 */
+	FixedSlicedVector() { }
+	~FixedSlicedVector() CADET_NOEXCEPT { }
+
+	// Default copy and move mechanisms
+	FixedSlicedVector(const FixedSlicedVector<T, fixedSliceSize>& cpy) = default;
+	FixedSlicedVector(FixedSlicedVector<T, fixedSliceSize>&& cpy) CADET_NOEXCEPT = default;
+
+	inline FixedSlicedVector<T, fixedSliceSize>& operator=(const FixedSlicedVector<T, fixedSliceSize>& cpy) = default;
+
+#ifdef COMPILER_SUPPORT_NOEXCEPT_DEFAULTED_MOVE
+	inline FixedSlicedVector<T, fixedSliceSize>& operator=(FixedSlicedVector<T, fixedSliceSize>&& cpy) CADET_NOEXCEPT = default;
+#else
+	inline FixedSlicedVector<T, fixedSliceSize>& operator=(FixedSlicedVector<T, fixedSliceSize>&& cpy) = default;
+#endif
+
+	/**
+	 * @brief Returns the compile-time size of every slice
+	 * @return Number of elements in each slice
+	 */
+	CADET_CONSTEXPR static inline size_type sliceSize() CADET_NOEXCEPT { return fixedSliceSize; }
+
+	/**
+	 * @brief Checks whether this FixedSlicedVector is empty
+	 * @return @c true if it is empty, otherwise @c false
+	 */
+	inline bool empty() const { return _values.empty(); }
+
+	/**
+	 * @brief Clears the FixedSlicedVector and deletes all stored items
+	 */
+	inline void clear() { _values.clear(); }
+
+	/**
+	 * @brief Appends a slice
+	 * @details The new elements are default constructed.
+	 */
+	inline void pushBackSlice()
+	{
+		_values.resize(_values.size() + fixedSliceSize);
+	}
+
+	/**
+	 * @brief Appends a given slice
+	 * @param [in] data Pointer to the first element of the slice
+	 */
+	inline void pushBackSlice(T const* data)
+	{
+		_values.insert(_values.end(), data, data + fixedSliceSize);
+	}
+
+	/**
+	 * @brief Replaces the content by adopting a linear buffer
+	 * @details The buffer is moved into the FixedSlicedVector. The number of elements
+	 *          in @p values has to be a multiple of the slice size.
+	 * @param [in] values Linearized values of all slices
+	 */
+	inline void assign(std::vector<T>&& values)
+	{
+		cadet_assert(values.size() % fixedSliceSize == 0);
+		_values = std::move(values);
+	}
+
+	/**
+	 * @brief Returns the number of slices
+	 * @return Number of slices
+	 */
+	inline size_type slices() const CADET_NOEXCEPT { return _values.size() / fixedSliceSize; }
+
+	/**
+	 * @brief Returns a pointer to the first element of a given slice
+	 * @param [in] idxSlice Index of the slice
+	 * @return Pointer to the first element of the given slice
+	 */
+	inline T const* operator[](size_type idxSlice) const { return &_values[idxSlice * fixedSliceSize]; }
+
+	/**
+	 * @brief Returns a pointer to the first element of a given slice
+	 * @param [in] idxSlice Index of the slice
+	 * @return Pointer to the first element of the given slice
+	 */
+	inline T* operator[](size_type idxSlice) { return &_values[idxSlice * fixedSliceSize]; }
+
+	/**
+	 * @brief Returns the element at the given position in the given slice
+	 * @param [in] idxSlice Index of the slice
+	 * @param [in] idxElem Index of the element within the slice
+	 * @return Element at the given index of the given slice
+	 */
+	inline const T& operator()(size_type idxSlice, size_type idxElem) const { return _values[idxSlice * fixedSliceSize + idxElem]; }
+
+	/**
+	 * @brief Returns the element at the given position in the given slice
+	 * @param [in] idxSlice Index of the slice
+	 * @param [in] idxElem Index of the element within the slice
+	 * @return Element at the given index of the given slice
+	 */
+	inline T& operator()(size_type idxSlice, size_type idxElem) { return _values[idxSlice * fixedSliceSize + idxElem]; }
+
+	/**
+	 * @brief Returns the element at the given linear index
+	 * @param [in] idx Linear index of the requested element
+	 * @return Element at the given linear index
+	 */
+	inline T& native(size_type idx) { return _values[idx]; }
+
+	/**
+	 * @brief Returns the element at the given linear index
+	 * @param [in] idx Linear index of the requested element
+	 * @return Element at the given linear index
+	 */
+	inline const T& native(size_type idx) const { return _values[idx]; }
+
+	/**
+	 * @brief Returns a pointer to the linearized storage
+	 * @return Pointer to the first element of the linearized storage
+	 */
+	inline T const* data() const CADET_NOEXCEPT { return _values.data(); }
+
+	/**
+	 * @brief Returns a pointer to the linearized storage
+	 * @return Pointer to the first element of the linearized storage
+	 */
+	inline T* data() CADET_NOEXCEPT { return _values.data(); }
+
+	/**
+	 * @brief Returns the total number of stored items
+	 * @details All items in every slice are counted.
+	 * @return Total number of stored items
+	 */
+	inline size_type size() const CADET_NOEXCEPT { return _values.size(); }
+
+	/**
+	 * @brief Reserves memory without initializing it
+	 * @details Corresponds to std::vector<T>::reserve().
+	 * @param [in] numSlices Number of slices to reserve space for
+	 */
+	inline void reserve(size_type numSlices)
+	{
+		_values.reserve(numSlices * fixedSliceSize);
+	}
+
+	/**
+	 * @brief Fills all slices with the same value
+	 * @param [in] val Value that is copied to all elements of all slices
+	 */
+	inline void fill(const T& val = T())
+	{
+		std::fill(_values.begin(), _values.end(), val);
+	}
+
+protected:
+	std::vector<T> _values; //!< Holds all values in a linearized fashion
+};
+
 } // namespace util
 } // namespace cadet
 
@@ -204,6 +204,93 @@ namespace cadet
 		MemoryPoolType& _memPool;
 	};
 
+
+	/**
+	 * @brief A stencil for @c double data that keeps its window in a small stack array
+	 * @details The cache of a CachingStencil lives in a memory pool, so every advance() shifts
+	 *          the window through heap memory that the compiler has to assume aliased with the
+	 *          state and residual vectors. The resulting store-load chain defeats store-to-load
+	 *          forwarding in the bulk convection loops, which shift the stencil once per cell.
+	 *          This variant stores the window in a member array of compile-time size instead:
+	 *          after inlining, the array is provably local, the rotation in advance() is fully
+	 *          unrolled, and the compiler can promote the window to registers across consecutive
+	 *          cells. The stencil size has to be odd and at most @p maxSize.
+	 * @tparam maxSize Compile-time capacity of the stencil window
+	 */
+	template <unsigned int maxSize>
+	class RegisterStencil
+	{
+	public:
+
+		/**
+		 * @brief Creates a RegisterStencil with given size
+		 * @details The @p size has to be odd and at most @p maxSize.
+		 * @param [in] size Size of the stencil
+		 * @param [in] offset Offset of the pointer in the stencil
+		 */
+		RegisterStencil(const unsigned int size, const unsigned int offset) : _size(size), _offset(offset)
+		{
+			cadet_assert(size <= maxSize);
+		}
+
+		/**
+		 * @brief Creates a RegisterStencil with given size
+		 * @details The memory pool overload matches the CachingStencil constructors so that both
+		 *          stencil types can be created from generic code; the pool itself is not used.
+		 */
+		template <class MemoryPoolType>
+		RegisterStencil(const unsigned int size, MemoryPoolType& memPool, const unsigned int offset) : RegisterStencil(size, offset) { }
+
+		inline double operator[](const int idx) const
+		{
+			cadet_assert(idx >= -static_cast<int>(_offset));
+			cadet_assert(idx < static_cast<int>(_size - _offset));
+			return _cache[static_cast<int>(_offset) + idx];
+		}
+		inline double& operator[](const int idx)
+		{
+			cadet_assert(idx >= -static_cast<int>(_offset));
+			cadet_assert(idx < static_cast<int>(_size - _offset));
+			return _cache[static_cast<int>(_offset) + idx];
+		}
+
+		inline double native(const unsigned int i) const
+		{
+			cadet_assert(i < _size);
+			return _cache[i];
+		}
+
+		inline void initialize(const std::initializer_list<double> vals)
+		{
+			cadet_assert(vals.size() <= _size);
+
+			double const* ptr = vals.begin();
+
+			for (unsigned int i = 0; i < vals.size(); ++i, ++ptr)
+				_cache[i] = *ptr;
+		}
+
+		/**
+		 * @brief Advances the stencil to the next cell
+		 * @details The rotation runs over the full compile-time capacity so that the loop has a
+		 *          constant trip count and is fully unrolled; slots beyond the runtime size hold
+		 *          unused values and shifting them is harmless.
+		 * @param val New volume average added to the stencil
+		 */
+		inline void advance(const double val) CADET_NOEXCEPT
+		{
+			for (unsigned int i = 0; i < maxSize - 1; ++i)
+				_cache[i] = _cache[i+1];
+
+			_cache[_size - 1] = val;
+		}
+
+	protected:
+		double _cache[maxSize]; //!< Stencil window in native (leftmost first) order
+		const unsigned int _size; //!< Size of the stencil
+		const unsigned int _offset; //!< Offset of the pointer in the stencil
+	};
+
 } // namespace cadet
 
 #endif  // LIBCADET_STENCIL_HPP_
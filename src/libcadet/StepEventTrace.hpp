@@ -0,0 +1,181 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a low-overhead ring buffer for time integrator step events.
+ * Events carry raw timestamps (time stamp counter on x86, otherwise nanoseconds
+ * of the monotonic clock) and are not formatted or converted on the hot path.
+ */
+
+#ifndef LIBCADET_STEPEVENTTRACE_HPP_
+#define LIBCADET_STEPEVENTTRACE_HPP_
+
+#include "cadet/Simulator.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+	#include <x86intrin.h>
+	#define CADET_STEPTRACE_TSC
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define CADET_STEPTRACE_TSC
+#endif
+
+namespace cadet
+{
+
+/**
+ * @brief Ring buffer that records time integrator step events
+ * @details The buffer has a fixed capacity (rounded up to a power of two) and overwrites
+ *          the oldest events when it is full, so the overhead per event is a counter read
+ *          and a store regardless of how long the integration runs. Timestamps are taken
+ *          from the time stamp counter where available; ticksPerSecond() calibrates them
+ *          against the monotonic clock for post-run conversion. Recording is not thread
+ *          safe, which suffices since only the time integration loop records events.
+ */
+class StepEventTrace
+{
+public:
+
+	StepEventTrace() CADET_NOEXCEPT : _mask(0), _head(0), _anchorTimestamp(0) { }
+
+	/**
+	 * @brief Sets the capacity of the ring buffer
+	 * @details Rounds the capacity up to the next power of two and discards all recorded
+	 *          events. A capacity of @c 0 disables tracing entirely.
+	 * @param [in] capacity Requested number of events the buffer holds (@c 0 disables tracing)
+	 */
+	void setCapacity(unsigned int capacity)
+	{
+		std::size_t cap = 1;
+		while (cap < capacity)
+			cap *= 2;
+
+		if (capacity == 0)
+			_events.clear();
+		else
+			_events.resize(cap);
+
+		_events.shrink_to_fit();
+		_mask = _events.empty() ? 0 : (_events.size() - 1);
+		clear();
+	}
+
+	/**
+	 * @brief Returns whether tracing is enabled
+	 * @return @c true if a capacity has been set, otherwise @c false
+	 */
+	inline bool enabled() const CADET_NOEXCEPT { return !_events.empty(); }
+
+	/**
+	 * @brief Discards all recorded events and re-anchors the timestamp calibration
+	 */
+	void clear()
+	{
+		_head = 0;
+		_anchorTimestamp = now();
+		_anchorTime = std::chrono::steady_clock::now();
+	}
+
+	/**
+	 * @brief Records an event
+	 * @details Overwrites the oldest event if the buffer is full. Must not be called
+	 *          if tracing is disabled (see enabled()).
+	 * @param [in] ev Event to be recorded
+	 */
+	inline void record(const StepTraceEvent& ev)
+	{
+		_events[_head & _mask] = ev;
+		++_head;
+	}
+
+	/**
+	 * @brief Returns the current raw timestamp
+	 * @return Time stamp counter reading on x86, otherwise nanoseconds of the monotonic clock
+	 */
+	static inline std::uint64_t now() CADET_NOEXCEPT
+	{
+#ifdef CADET_STEPTRACE_TSC
+		return __rdtsc();
+#else
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+
+	/**
+	 * @brief Returns the number of raw timestamp ticks per second
+	 * @details Calibrated against the monotonic clock since the last call to clear(), so
+	 *          the accuracy improves with the time passed since then.
+	 * @return Timestamp ticks per second
+	 */
+	double ticksPerSecond() const
+	{
+#ifdef CADET_STEPTRACE_TSC
+		const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - _anchorTime).count();
+		if (elapsed <= 0.0)
+			return 0.0;
+
+		return static_cast<double>(now() - _anchorTimestamp) / elapsed;
+#else
+		return 1e9;
+#endif
+	}
+
+	/**
+	 * @brief Returns the recorded events in chronological order
+	 * @details Linearizes the ring buffer; if more events were recorded than the buffer
+	 *          holds, only the most recent ones are returned.
+	 * @return Vector with the recorded events, oldest first
+	 */
+	std::vector<StepTraceEvent> linearize() const
+	{
+		std::vector<StepTraceEvent> out;
+		if (_events.empty())
+			return out;
+
+		const std::size_t num = (_head < _events.size()) ? _head : _events.size();
+		const std::size_t first = _head - num;
+
+		out.reserve(num);
+		for (std::size_t i = 0; i < num; ++i)
+			out.push_back(_events[(first + i) & _mask]);
+
+		return out;
+	}
+
+	/**
+	 * @brief Returns the total number of recorded events including overwritten ones
+	 * @return Number of record() calls since the last call to clear()
+	 */
+	inline std::size_t totalRecorded() const CADET_NOEXCEPT { return _head; }
+
+	/**
+	 * @brief Returns the number of bytes of memory owned by the trace buffer
+	 * @return Memory footprint in bytes
+	 */
+	inline std::size_t memoryFootprint() const CADET_NOEXCEPT { return _events.capacity() * sizeof(StepTraceEvent); }
+
+protected:
+	std::vector<StepTraceEvent> _events; //!< Ring buffer storage (power of two size)
+	std::size_t _mask; //!< Index mask, i.e., buffer size minus 1
+	std::size_t _head; //!< Total number of recorded events; next slot is _head & _mask
+	std::uint64_t _anchorTimestamp; //!< Raw timestamp taken at the last clear() for calibration
+	std::chrono::steady_clock::time_point _anchorTime; //!< Monotonic clock reading taken at the last clear()
+};
+
+} // namespace cadet
+
+#endif  // LIBCADET_STEPEVENTTRACE_HPP_
@@ -20,6 +20,10 @@
 #ifndef LIBCADET_SUNDIALSVECTOR_HPP_
 #define LIBCADET_SUNDIALSVECTOR_HPP_
 
+#if defined(CADET_SUNDIALS_OPENMP) && defined(CADET_DETERMINISTIC_REDUCTIONS)
+	#error The OpenMP NVector implementation reduces dot products and norms in a thread-count dependent order and, thus, cannot be combined with CADET_DETERMINISTIC_REDUCTIONS
+#endif
+
 #ifdef CADET_SUNDIALS_OPENMP
 	#include <nvector/nvector_openmp.h>
 	#include <omp.h>
@@ -33,9 +37,37 @@
 	#define NVec_CloneArray N_VCloneVectorArray_OpenMP
  	#define NVec_NewEmpty(x) N_VNewEmpty_OpenMP(x, omp_get_max_threads())
 	#define NVec_SetThreads(x, nThreads) NV_NUM_THREADS_OMP(x) = nThreads
+
+	// The OpenMP implementation owns its storage and touches it from its own threads
+	#define NVec_NewAligned(x) NVec_New(x)
+	#define NVec_DestroyAligned NVec_Destroy
+
+namespace cadet
+{
+	/**
+	 * @brief Redirects the norm kernels of an NVector to parallel counterparts
+	 * @details The OpenMP NVector implementation already reduces its norms in parallel,
+	 *          so there is nothing to patch here.
+	 * @param [in] v NVector whose ops table would be patched
+	 */
+	inline void installParallelNorms(N_Vector v) { }
+} // namespace cadet
 #else
 	#include <nvector/nvector_serial.h>
 
+	#include "AlignedMemory.hpp"
+
+	#ifdef CADET_PARALLELIZE
+		#include <tbb/parallel_for.h>
+		#include <tbb/parallel_reduce.h>
+		#include <tbb/blocked_range.h>
+		#include <tbb/partitioner.h>
+	#endif
+
+	#include <algorithm>
+	#include <functional>
+	#include <cmath>
+
 	#define NVEC_DATA(x) NV_DATA_S(x)
 	#define NVEC_LENGTH(x) NV_LENGTH_S(x)
 
@@ -44,7 +76,118 @@
 	#define NVec_DestroyArray N_VDestroyVectorArray_Serial
 	#define NVec_CloneArray N_VCloneVectorArray_Serial
 	#define NVec_NewEmpty N_VNewEmpty_Serial
-	#define NVec_SetThreads(x, nThreads) 
+	#define NVec_SetThreads(x, nThreads)
+
+namespace cadet
+{
+	/**
+	 * @brief Creates a serial NVector on cache line aligned, parallel first-touched storage
+	 * @details The storage is allocated via alignedDoubleAlloc() and zeroed in page sized
+	 *          chunks from the TBB worker threads. Under the usual first-touch page
+	 *          placement policy this spreads the pages of the state vector over the NUMA
+	 *          domains of the threads that later stream it in the parallel residual and
+	 *          particle loops, instead of placing the whole vector on the domain of the
+	 *          allocating thread. The vector has to be released with NVec_DestroyAligned
+	 *          since the NVector does not own the buffer.
+	 * @param [in] len Number of elements
+	 * @return NVector wrapping the aligned storage
+	 */
+	inline N_Vector createAlignedNVector(long len)
+	{
+		double* const data = alignedDoubleAlloc(len);
+
+#ifdef CADET_PARALLELIZE
+		// One chunk per memory page (4096 bytes); the simple partitioner prevents
+		// chunk merging and thus spreads the pages over the worker threads
+		tbb::parallel_for(tbb::blocked_range<long>(0, len, 4096 / sizeof(double)), [=](const tbb::blocked_range<long>& r)
+		{
+			std::fill(data + r.begin(), data + r.end(), 0.0);
+		}, tbb::simple_partitioner());
+#else
+		std::fill(data, data + len, 0.0);
+#endif
+
+		return N_VMake_Serial(len, data);
+	}
+
+	/**
+	 * @brief Destroys an NVector created by createAlignedNVector()
+	 * @param [in] v NVector to destroy (may be @c nullptr)
+	 */
+	inline void destroyAlignedNVector(N_Vector v)
+	{
+		if (!v)
+			return;
+
+		alignedDoubleFree(NV_DATA_S(v));
+		N_VDestroy_Serial(v);
+	}
+
+#ifdef CADET_PARALLELIZE
+	/**
+	 * @brief Computes the WRMS norm of a serial NVector on the TBB worker threads
+	 * @details Drop-in replacement for the serial N_VWrmsNorm() kernel. The local error test
+	 *          of IDAS evaluates this norm over the full state vector in every step, which is
+	 *          a plain memory sweep limited by the bandwidth of a single core. The reduction
+	 *          is split into fixed page sized blocks whose partial results combine in a fixed
+	 *          tree, so the result does not depend on the number of threads (see the reduction
+	 *          order invariant in linalg/Norms.hpp). Small vectors are reduced serially since
+	 *          the threading overhead would dominate.
+	 * @param [in] x Vector whose norm is to be evaluated
+	 * @param [in] w Vector with error weights
+	 * @return WRMS norm of @p x weighted by @p w
+	 */
+	inline realtype parallelWrmsNorm(N_Vector x, N_Vector w)
+	{
+		const long len = NV_LENGTH_S(x);
+		double const* const xd = NV_DATA_S(x);
+		double const* const wd = NV_DATA_S(w);
+
+		// One block per memory page (4096 bytes), matching createAlignedNVector()
+		const long blockSize = 4096 / sizeof(double);
+
+		if (len < 64 * blockSize)
+		{
+			double sumSq = 0.0;
+			for (long i = 0; i < len; ++i)
+				sumSq += (xd[i] * wd[i]) * (xd[i] * wd[i]);
+			return std::sqrt(sumSq / static_cast<double>(len));
+		}
+
+		// The simple partitioner splits the range into the same blocks regardless of the
+		// thread count, which keeps the combination order of the partial sums fixed
+		const double sumSq = tbb::parallel_deterministic_reduce(tbb::blocked_range<long>(0, len, blockSize), 0.0,
+			[=](const tbb::blocked_range<long>& r, double acc) -> double
+			{
+				for (long i = r.begin(); i < r.end(); ++i)
+					acc += (xd[i] * wd[i]) * (xd[i] * wd[i]);
+				return acc;
+			},
+			std::plus<double>(), tbb::simple_partitioner());
+
+		return std::sqrt(sumSq / static_cast<double>(len));
+	}
+#endif
+
+	/**
+	 * @brief Redirects the norm kernels of a serial NVector to their parallel counterparts
+	 * @details Patches the ops table of @p v so that N_VWrmsNorm() runs on the worker threads.
+	 *          Vectors cloned from @p v inherit the patched ops table, hence installing the
+	 *          kernels on the state vector templates passed to IDAInit() covers all internal
+	 *          temporaries of IDAS, in particular the ones consumed by the local error test.
+	 *          No-op in serial builds.
+	 * @param [in] v NVector whose ops table is to be patched
+	 */
+	inline void installParallelNorms(N_Vector v)
+	{
+#ifdef CADET_PARALLELIZE
+		v->ops->nvwrmsnorm = &parallelWrmsNorm;
+#endif
+	}
+} // namespace cadet
+
+	#define NVec_NewAligned(x) ::cadet::createAlignedNVector(x)
+	#define NVec_DestroyAligned(x) ::cadet::destroyAlignedNVector(x)
 #endif
 
 #define NVec_Const N_VConst
@@ -22,6 +22,7 @@
 #include "AutoDiff.hpp"
 
 #include <vector>
+#include <cstdint>
 
 namespace cadet
 {
@@ -153,6 +154,36 @@ public:
 	 */
 	virtual void notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset) = 0;
 
+	/**
+	 * @brief Checks whether the outlet of this unit operation jumps on entry into the given section
+	 * @details Used by the discontinuity propagation analysis of consistent initialization to
+	 *          determine which units are actually perturbed by a section transition. Units whose
+	 *          outlet is a dynamic state variable cannot jump at a section boundary and return
+	 *          @c false. System sources (e.g., inlets) compare their profile on both sides of
+	 *          the boundary.
+	 *
+	 * @param [in] t Time point of the section transition
+	 * @param [in] secIdx Index of the new section that is about to be integrated
+	 * @return @c true if the outlet changes discontinuously at the transition, otherwise @c false
+	 */
+	virtual bool discontinuousOutputTransition(double t, unsigned int secIdx) = 0;
+
+	/**
+	 * @brief Checks whether the outlet jump on entry into the given section is exactly known
+	 * @details A unit operation whose outlet jump at the section boundary is known in closed form
+	 *          (including the case of no jump at all) applies it exactly during (lean) consistent
+	 *          initialization. If all units of a system report an exact transition, the time
+	 *          integrator can replace the full consistent initialization by an exact state jump
+	 *          plus a lean reinitialization. Units whose outlet is a dynamic state variable do
+	 *          not jump and trivially return @c true; system sources (e.g., inlets) query their
+	 *          profile for discontinuity metadata.
+	 *
+	 * @param [in] t Time point of the section transition
+	 * @param [in] secIdx Index of the new section that is about to be integrated
+	 * @return @c true if the outlet jump at the transition is exactly known, otherwise @c false
+	 */
+	virtual bool exactDiscontinuousOutputTransition(double t, unsigned int secIdx) = 0;
+
 	/**
 	 * @brief Applies initial conditions to the state vector and its time derivative
 	 * @details The initial conditions do not need to be consistent at this point. On a (discontinuous)
@@ -236,6 +267,14 @@ public:
 	virtual int linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
 		double const* const y, double const* const yDot, double const* const res) = 0;
 
+	/**
+	 * @brief Returns the accumulated number of GMRES iterations spent in linearSolve()
+	 * @details Counts all iterations since creation of the unit operation. Models that do
+	 *          not use an iterative linear solver return @c 0.
+	 * @return Total number of GMRES iterations
+	 */
+	virtual unsigned int numGmresIterations() const CADET_NOEXCEPT = 0;
+
 	/**
 	 * @brief Prepares the AD system vectors by constructing seed vectors
 	 * @details Sets the seed vectors used in AD. Since the AD vector slice is fully managed by the model,
@@ -253,6 +292,20 @@ public:
 	 */
 	virtual void prepareADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const = 0;
 
+	/**
+	 * @brief Returns a hash of the AD seed structure of this unit operation
+	 * @details Two unit operations with the same non-zero hash are guaranteed to set up identical
+	 *          seed vectors in prepareADvectors(). This allows the caller to prepare the seeds of
+	 *          one representative unit and copy them to all other units of the same structure
+	 *          instead of repeating the seed bookkeeping for every unit.
+	 *
+	 *          The hash has to cover everything that influences the seeding (e.g., discretization,
+	 *          number of components, Jacobian bandwidths). Models that do not support seed sharing
+	 *          (e.g., because they do not use AD) return @c 0, which opts out of sharing.
+	 * @return Hash of the AD seed structure or @c 0 if seed sharing is not supported
+	 */
+	virtual uint64_t adSeedStructureHash() const CADET_NOEXCEPT = 0;
+
 	/**
 	 * @brief Sets the section time vector
 	 * @details The integration time is partitioned into sections. All parameters and
@@ -291,6 +344,61 @@ public:
 	 */
 	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut) = 0;
 
+	/**
+	 * @brief Computes relaxed error tolerances for use right after a discontinuous section transition
+	 * @details When a section transition introduces a discontinuity (e.g., a step in the inlet
+	 *          profile), the disturbance is initially confined to a small part of the spatial
+	 *          domain. Applying the full error test to the still unperturbed DOFs forces the
+	 *          time integrator to take tiny steps without gaining accuracy. This function keeps
+	 *          the base tolerances for the DOFs near the point where the disturbance enters the
+	 *          model and multiplies the tolerances of all remaining DOFs by @p relaxFactor.
+	 * 
+	 * @param [in] baseTol Pointer to array with base absolute error tolerances for each DOF
+	 * @param [in] relaxFactor Factor (at least @c 1.0) the tolerances of unaffected DOFs are multiplied with
+	 * @param [out] relaxedTol Pointer to array receiving the relaxed error tolerances for each DOF
+	 */
+	virtual void relaxTransitionErrorTol(double const* baseTol, double relaxFactor, double* relaxedTol) = 0;
+
+	/**
+	 * @brief Determines whether the unit operation decouples fast local dynamics from the error test
+	 * @return @c true if applyMultirateErrorTol() modifies the tolerances, otherwise @c false
+	 */
+	virtual bool hasMultirateErrorTol() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Scales the error tolerances of DOFs governed by fast local dynamics
+	 * @details In a monolithic DAE the global step size follows the stiffest dynamics in the
+	 *          system, which for mild-transport problems are the particle and film flux DOFs
+	 *          rather than the bulk transport of interest. This function multiplies the
+	 *          absolute tolerances of such fast local DOFs by a configured factor so that
+	 *          the step size controller effectively follows the bulk time scale, emulating
+	 *          the step size behavior of a multirate scheme while keeping the monolithic
+	 *          solve. The local dynamics are still integrated implicitly and stably, only
+	 *          their weight in the error test is reduced.
+	 *
+	 * @param [in,out] absTol Pointer to array with absolute error tolerances for each DOF of this unit operation
+	 */
+	virtual void applyMultirateErrorTol(double* absTol) = 0;
+
+	/**
+	 * @brief Scales the error tolerances of the DOFs of each state class by its own factor
+	 * @details The DOFs of a unit operation fall into classes with very different influence
+	 *          on the observable result: column liquid concentrations (including inlet and
+	 *          outlet DOFs), particle liquid concentrations, bound states, and film fluxes.
+	 *          Non-observable classes tolerate a looser local error test than the outlet
+	 *          concentrations, which lets the step size controller take larger steps. This
+	 *          function multiplies the absolute tolerance of every DOF by the factor of its
+	 *          class; a factor of @c 1.0 leaves a class unchanged. Classes the unit does not
+	 *          have are ignored.
+	 *
+	 * @param [in] colLiquidFactor Factor for column liquid (bulk, inlet, and outlet) DOFs
+	 * @param [in] parLiquidFactor Factor for particle liquid phase DOFs
+	 * @param [in] boundFactor Factor for bound state DOFs
+	 * @param [in] fluxFactor Factor for film flux DOFs
+	 * @param [in,out] absTol Pointer to array with absolute error tolerances for each DOF of this unit operation
+	 */
+	virtual void applyStateClassErrorTol(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor, double* absTol) = 0;
+
 	/**
 	 * @brief Returns the number of components
 	 * @details It is assumed that the number of components is also the number of inputs
@@ -311,6 +419,16 @@ public:
 	 */
 	virtual bool hasOutlet() const CADET_NOEXCEPT = 0;
 
+	/**
+	 * @brief Returns whether this unit operation is a pure boundary unit
+	 * @details A pure boundary unit only realizes a boundary condition of the network (e.g.,
+	 *          an inlet profile evaluation or an outlet copy) and carries no spatial DOFs.
+	 *          Its residual is so cheap that the model system evaluates it on the calling
+	 *          thread instead of dispatching it to the parallel per-unit loop.
+	 * @return @c true if the unit operation is a pure boundary unit, otherwise @c false
+	 */
+	virtual bool isPureBoundaryUnit() const CADET_NOEXCEPT = 0;
+
 	/**
 	 * @brief Returns the local index of the first outlet component in the managed state vector slice
 	 * @details As each unit operation manages a slice of the global state vector on its own, the
@@ -369,13 +487,15 @@ public:
 	 * @param [in] ySdot Pointers to global sensitivity time derivative state vectors
 	 * @param [out] resS Pointers to global sensitivity residuals
 	 * @param [in] adRes Pointer to global residual vector of AD datatypes with the sensitivity derivatives from residualSensFwdAdOnly()
+	 * @param [in] dirMap Maps an index into @p yS to its AD direction in @p adRes, or @c nullptr if the mapping is the identity.
+	 *             Used when the caller has removed inactive directions from the vectors (see ModelSystem::residualSensFwd()).
 	 * @param [in] tmp1 Temporary storage in the size of global state vector @p y
 	 * @param [in] tmp2 Temporary storage in the size of global state vector of @p y
 	 * @param [in] tmp3 Temporary storage in the size of global state vector of @p y
 	 * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
 	 */
 	virtual int residualSensFwdCombine(const active& timeFactor, const std::vector<const double*>& yS, const std::vector<const double*>& ySdot,
-		const std::vector<double*>& resS, active const* adRes, double* const tmp1, double* const tmp2, double* const tmp3) = 0;
+		const std::vector<double*>& resS, active const* adRes, unsigned int const* dirMap, double* const tmp1, double* const tmp2, double* const tmp3) = 0;
 
 	/**
 	 * @brief Evaluates the residuals with AD to compute the parameter sensitivities and at the same time updates the Jacobian
@@ -549,6 +669,19 @@ public:
 	 */
 	virtual void multiplyWithJacobian(double const* yS, double alpha, double beta, double* ret) = 0;
 
+	/**
+	 * @brief Multiplies the given vector with the transposed system Jacobian (i.e., @f$ \frac{\partial F}{\partial y}^T @f$)
+	 * @details Actually, the operation @f$ z = \alpha \frac{\partial F}{\partial y}^T x + \beta z @f$ is performed.
+	 *          This is the adjoint counterpart of multiplyWithJacobian() and is required for reverse
+	 *          (adjoint) sensitivity propagation, which pulls the gradient of a scalar functional
+	 *          backwards through the model equations.
+	 * @param [in] yS Vector @f$ x @f$ that is transformed by the transposed Jacobian @f$ \frac{\partial F}{\partial y}^T @f$
+	 * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ \frac{\partial F}{\partial y}^T @f$
+	 * @param [in] beta Factor @f$ \beta @f$ in front of @f$ z @f$
+	 * @param [in,out] ret Vector @f$ z @f$ which stores the result of the operation
+	 */
+	virtual void multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret) = 0;
+
 	/**
 	 * @brief Multiplies the time derivative Jacobian @f$ \frac{\partial F}{\partial \dot{y}} @f$ with a given vector
 	 * @details The operation @f$ z = \frac{\partial F}{\partial \dot{y}} x @f$ is performed.
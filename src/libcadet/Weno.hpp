@@ -24,9 +24,50 @@
 #include "common/CompilerSpecific.hpp"
 #include "cadet/Exceptions.hpp"
 
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace cadet
 {
 
+/**
+ * @brief Coefficient tables of the WENO method of a given order
+ * @details Holds the optimal weights @f$ d @f$, the reconstruction coefficients @f$ c @f$,
+ *          and the Jacobian tensor of the smoothness indicators (used to generate Jbv via
+ *          vec(Jbv) = A*v) as @c constexpr data. Fixed-order kernels index the tables with
+ *          compile-time constants, so the compiler folds the entries directly into the
+ *          unrolled multiply-add chains instead of loading them through a runtime pointer.
+ * @tparam order Order of the WENO method
+ */
+template <int order> struct WenoCoefficients;
+
+template <> struct WenoCoefficients<2>
+{
+	static constexpr double d[2] = { 2.0/3.0, 1.0/3.0 };
+	static constexpr double c[2*2] = { 0.5, -0.5,
+	                                   0.5,  1.5 };
+	static constexpr double Jbvv[2*3*3] =
+		{0, 2,   0,-2,   0, 0,
+		 0,-2,   2, 2,  -2, 0,
+		 0, 0,  -2, 0,   2, 0};
+};
+
+template <> struct WenoCoefficients<3>
+{
+	static constexpr double d[3] = { 0.3, 0.6, 0.1 };
+	static constexpr double c[3*3] = { 1.0/3.0, -1.0/6.0,  1.0/3.0,
+	                                   5.0/6.0,  5.0/6.0, -7.0/6.0,
+	                                  -1.0/6.0,  1.0/3.0, 11.0/6.0  };
+	static constexpr double Jbvv[3*5*5] =
+		{0,0,8.0/3,   0,0,-19.0/3,        0,0,11.0/3,            0,0,0,             0,0,0,
+		 0,0,-19.0/3, 0,8.0/3,50.0/3,     0,-13.0/3,-31.0/3,     0,5.0/3,0,         0,0,0,
+		 0,0,11.0/3,  0,-13.0/3,-31.0/3,  20.0/3,26.0/3,20.0/3, -31.0/3,-13.0/3,0,  11.0/3,0,0,
+		 0,0,0,       0,5.0/3,0,         -31.0/3,-13.0/3,0,      50.0/3,8.0/3,0,   -19.0/3,0,0,
+		 0,0,0,       0,0,0,              11.0/3,0,0,           -19.0/3,0,0,         8.0/3,0,0};
+};
+
 /**
  * @brief Implements the WENO scheme for convection
  * @details This scheme is based on upwind stencils and provides WENO methods 1-1, 2-3, and 3-5.
@@ -55,7 +96,8 @@ public:
 	/**
 	 * @brief Creates the WENO scheme
 	 */
-	Weno() : _order(maxOrder()), _boundaryTreatment(BoundaryTreatment::ReduceOrder), _intermediateValues(3 * maxOrder() * sizeof(active)) { }
+	Weno() : _order(maxOrder()), _boundaryTreatment(BoundaryTreatment::ReduceOrder), _intermediateValues(3 * maxOrder() * sizeof(active)),
+		_memoTol(0.0), _memoCells(0), _memoSlot(0), _memoTime(std::numeric_limits<double>::quiet_NaN()) { }
 
 	/**
 	 * @brief Returns the maximum order \f$ r \f$ of the implemented schemes
@@ -106,6 +148,130 @@ public:
 		return reconstruct<StateType, StencilType, false>(epsilon, cellIdx, numCells, w, result, nullptr);
 	}
 
+	/**
+	 * @brief Reconstructs the right cell face values of a contiguous strip of cells in one sweep
+	 * @details Batched version of reconstruct() for plain @c double data. All cells that cannot
+	 *          be affected by the boundary treatment are processed by a fixed-order kernel whose
+	 *          loop bounds are known at compile time. The kernel operates on contiguous memory
+	 *          without temporary allocations and consists of branch-free multiply-add chains,
+	 *          which allows the compiler to apply SIMD vectorization over the strip. Cells close
+	 *          to the column ends are delegated to the scalar reconstruct() kernel, which
+	 *          implements the boundary treatment.
+	 *
+	 * @param [in] epsilon \f$ \varepsilon \f$ of the WENO method (prevents division by zero in the weights)
+	 * @param [in] nCells Number of cells in the strip
+	 * @param [in] w Pointer to the @p nCells contiguous cell averages
+	 * @param [out] vm Array of size @p nCells receiving the reconstructed cell face values
+	 * @param [out] Dvm Array of size <tt>nCells * maxStencilSize()</tt> receiving the gradients of the
+	 *                  face values (one row per cell); only accessed if @p wantJac is @c true
+	 * @param [out] usedOrder Array of size @p nCells receiving the WENO order used in each cell
+	 * @tparam wantJac Determines if the gradients are computed (@c true) or not (@c false)
+	 */
+	template <bool wantJac>
+	void reconstructStrip(double epsilon, unsigned int nCells, double const* w, double* vm, double* Dvm, int* usedOrder)
+	{
+		reconstructStripRange<wantJac>(epsilon, nCells, 0, static_cast<int>(nCells) - 1, w, vm, Dvm, usedOrder);
+	}
+
+	/**
+	 * @brief Reconstructs the right cell face values of a subrange of a strip of cells
+	 * @details Like reconstructStrip(), but only processes the cells @p firstCell to
+	 *          @p lastCell (inclusive) of a strip with @p nCells cells. The stencils still
+	 *          read from the full strip @p w and the boundary treatment is applied with
+	 *          respect to the full strip, so processing a strip block by block yields
+	 *          exactly the same face values as one full sweep. This allows callers to tile
+	 *          the reconstruction with the downstream flux evaluation for cache locality.
+	 *
+	 * @param [in] epsilon \f$ \varepsilon \f$ of the WENO method (prevents division by zero in the weights)
+	 * @param [in] nCells Number of cells in the strip
+	 * @param [in] firstCell Index of the first cell to reconstruct
+	 * @param [in] lastCell Index of the last cell to reconstruct (inclusive)
+	 * @param [in] w Pointer to the @p nCells contiguous cell averages
+	 * @param [out] vm Array of size @p nCells receiving the reconstructed cell face values
+	 * @param [out] Dvm Array of size <tt>nCells * maxStencilSize()</tt> receiving the gradients of the
+	 *                  face values (one row per cell); only accessed if @p wantJac is @c true
+	 * @param [out] usedOrder Array of size @p nCells receiving the WENO order used in each cell
+	 * @tparam wantJac Determines if the gradients are computed (@c true) or not (@c false)
+	 */
+	template <bool wantJac>
+	void reconstructStripRange(double epsilon, unsigned int nCells, int firstCell, int lastCell, double const* w, double* vm, double* Dvm, int* usedOrder)
+	{
+		// Interior cells [order - 1, nCells - order] use the full order and are independent
+		// of the boundary treatment in all modes; clamp to the requested range
+		const int intStart = std::max(_order - 1, firstCell);
+		const int intEnd = std::min(static_cast<int>(nCells) - _order, lastCell);
+
+		// Boundary cells are delegated to the scalar kernel; ghost cells are zero
+		double buf[2 * 3 - 1]; // maxOrder() many ghost-padded stencil entries on each side
+		for (int cell = firstCell; cell <= lastCell; ++cell)
+		{
+			if (cadet_likely((cell >= intStart) && (cell <= intEnd)))
+				continue;
+
+			for (int i = -(_order - 1); i <= _order - 1; ++i)
+			{
+				const int idx = cell + i;
+				buf[_order - 1 + i] = ((idx >= 0) && (idx < static_cast<int>(nCells))) ? w[idx] : 0.0;
+			}
+
+			double const* const stencil = buf + _order - 1;
+			if (wantJac)
+				usedOrder[cell] = reconstruct<double, double const*>(epsilon, cell, nCells, stencil, vm[cell], Dvm + cell * maxStencilSize());
+			else
+				usedOrder[cell] = reconstruct<double, double const*>(epsilon, cell, nCells, stencil, vm[cell]);
+		}
+
+		if (intEnd < intStart)
+			return;
+
+		// Locate the memo slot if memoization is enabled and sized for this discretization
+		double* memoBeta = nullptr;
+		double* memoCenter = nullptr;
+		char* memoValid = nullptr;
+		if (!_memoValid.empty() && (nCells == _memoCells))
+		{
+			memoBeta = _memoBeta.data() + _memoSlot * _memoCells * maxOrder();
+			memoCenter = _memoCenter.data() + _memoSlot * _memoCells;
+			memoValid = _memoValid.data() + _memoSlot * _memoCells;
+		}
+
+		switch (_order)
+		{
+			case 1:
+				for (int cell = intStart; cell <= intEnd; ++cell)
+				{
+					vm[cell] = w[cell];
+					if (wantJac)
+						Dvm[cell * maxStencilSize()] = 1.0;
+					usedOrder[cell] = 1;
+				}
+				break;
+			case 2:
+				reconstructStripInterior<2, wantJac>(epsilon, intStart, intEnd, w, vm, Dvm, usedOrder, memoBeta, memoCenter, memoValid);
+				break;
+			case 3:
+				reconstructStripInterior<3, wantJac>(epsilon, intStart, intEnd, w, vm, Dvm, usedOrder, memoBeta, memoCenter, memoValid);
+				break;
+		}
+	}
+
+	/**
+	 * @brief Precomputes the boundary treatment for every cell of a discretization
+	 * @details Builds per-cell tables with the locally used WENO order and the boundary
+	 *          weight cutoff such that reconstruct() replaces the boundary treatment
+	 *          branches by a table lookup. The tables are rebuilt automatically when the
+	 *          order or the boundary treatment method changes. Calling init() is optional;
+	 *          without it, reconstruct() evaluates the boundary treatment on every call.
+	 * @param [in] numCells Number of cells of the discretization
+	 */
+	inline void init(unsigned int numCells)
+	{
+		_cellOrder.resize(numCells);
+		_cellBnd.resize(numCells);
+		for (unsigned int cell = 0; cell < numCells; ++cell)
+			applyBoundaryTreatment(cell, numCells, _cellOrder[cell], _cellBnd[cell]);
+	}
+
 	/**
 	 * @brief Sets the WENO order
 	 * @param [in] order Order of the WENO method
@@ -115,6 +281,13 @@ public:
 		cadet_assert(order <= static_cast<int>(maxOrder()));
 		cadet_assert(order > 0);
 		_order = order;
+
+		// Rebuild the per-cell boundary treatment tables for the new order
+		if (!_cellOrder.empty())
+			init(_cellOrder.size());
+
+		// Stored smoothness indicators belong to the old order
+		invalidateSmoothnessMemo();
 	}
 	
 	/**
@@ -127,7 +300,14 @@ public:
 	 * @brief Sets the boundary treatment method
 	 * @param [in] bndTreatment Boundary treatment method
 	 */
-	inline void boundaryTreatment(BoundaryTreatment bndTreatment) { _boundaryTreatment = bndTreatment; }
+	inline void boundaryTreatment(BoundaryTreatment bndTreatment)
+	{
+		_boundaryTreatment = bndTreatment;
+
+		// Rebuild the per-cell boundary treatment tables for the new method
+		if (!_cellOrder.empty())
+			init(_cellOrder.size());
+	}
 
 	/**
 	 * @brief Returns the boundary treatment method
@@ -144,16 +324,16 @@ public:
 		switch(bndTreatment)
 		{
 			case static_cast<typename std::underlying_type<BoundaryTreatment>::type>(BoundaryTreatment::ReduceOrder):
-				_boundaryTreatment = BoundaryTreatment::ReduceOrder;
+				boundaryTreatment(BoundaryTreatment::ReduceOrder);
 				return;
 			case static_cast<typename std::underlying_type<BoundaryTreatment>::type>(BoundaryTreatment::ZeroWeights):
-				_boundaryTreatment = BoundaryTreatment::ZeroWeights;
+				boundaryTreatment(BoundaryTreatment::ZeroWeights);
 				return;
 			case static_cast<typename std::underlying_type<BoundaryTreatment>::type>(BoundaryTreatment::ZeroWeightsForPnotZero):
-				_boundaryTreatment = BoundaryTreatment::ZeroWeightsForPnotZero;
+				boundaryTreatment(BoundaryTreatment::ZeroWeightsForPnotZero);
 				return;
 			case static_cast<typename std::underlying_type<BoundaryTreatment>::type>(BoundaryTreatment::LargeGhostNodes):
-				_boundaryTreatment = BoundaryTreatment::LargeGhostNodes;
+				boundaryTreatment(BoundaryTreatment::LargeGhostNodes);
 				return;
 		}
 		throw InvalidParameterException("Unknown boundary treatment type");
@@ -177,37 +357,105 @@ public:
 	 */
 	inline unsigned int stencilSize() const CADET_NOEXCEPT { return 2 * _order - 1; }
 
-private:
+	/**
+	 * @brief Enables memoization of the smoothness indicators across residual evaluations of a time step
+	 * @details Within one time step of the DAE integrator, the Newton iteration evaluates the
+	 *          residual several times at nearby states and recomputes smoothness indicators
+	 *          that barely change. With memoization enabled, the strip kernels store the raw
+	 *          indicators of every cell on the first evaluation of a step and reuse them in
+	 *          subsequent evaluations as long as the cell average has moved by less than
+	 *          @p threshold (relative); cells that moved further are recomputed and the stored
+	 *          values refreshed. Since the memoized indicators only steer the convex blending
+	 *          of the candidate stencils, reusing them keeps the reconstruction consistent
+	 *          (the same indicators enter the residual and its Jacobian).
+	 *
+	 *          The memo is organized in @p numSlots independent slots (one per component, see
+	 *          smoothnessMemoSlot()) and applies to the fixed-order interior kernels of
+	 *          reconstructStrip() only; boundary cells and AD evaluations always recompute.
+	 * @param [in] numSlots Number of independent memo slots (e.g., number of components)
+	 * @param [in] numCells Number of cells of the discretization
+	 * @param [in] threshold Maximum relative change of a cell average up to which the stored indicators are reused
+	 */
+	inline void enableSmoothnessMemo(unsigned int numSlots, unsigned int numCells, double threshold)
+	{
+		_memoBeta.assign(numSlots * numCells * maxOrder(), 0.0);
+		_memoCenter.assign(numSlots * numCells, 0.0);
+		_memoValid.assign(numSlots * numCells, 0);
+		_memoTol = threshold;
+		_memoCells = numCells;
+		_memoSlot = 0;
+		_memoTime = std::numeric_limits<double>::quiet_NaN();
+	}
 
 	/**
-	 * @brief Reconstructs a cell face value from volume averages
-	 * @param [in] epsilon \f$ \varepsilon \f$ of the WENO emthod (prevents division by zero in the weights) 
-	 * @param [in] cellIdx Index of the current cell
-	 * @param [in] numCells Number of cells
-	 * @param [in] w Stencil that contains the \f$ 2r-1 \f$ volume averages from which the cell face values are reconstructed centered at the 
-	 *               current cell (i.e., index 0 is the current cell, -2 the next to previous cell, 2 the next but one cell)
-	 * @param [out] result Reconstructed cell face value
-	 * @param [out] Dvm Gradient of the reconstructed cell face value (array has to be of size \f$ 2r-1\f$ where \f$ r \f$ is the WENO order)
-	 * @tparam StateType Type of the state variables
-	 * @tparam StencilType Type of the stencil (can be a dedicated class with overloaded operator[] or a simple pointer)
-	 * @tparam wantJac Determines if the gradient is computed (@c true) or not (@c false)
-	 * @return Order of the WENO scheme that was used in the computation
+	 * @brief Disables memoization of the smoothness indicators and releases the memo storage
 	 */
-	template <typename StateType, typename StencilType, bool wantJac>
-	int reconstruct(double epsilon, unsigned int cellIdx, unsigned int numCells, const StencilType& w, StateType& result, double* const Dvm)
+	inline void disableSmoothnessMemo()
 	{
-#if defined(ACTIVE_SETFAD) || defined(ACTIVE_SFAD)
-		using cadet::sqr;
-		using sfad::sqr;
-#elif defined(ACTIVE_ADOLC)
-		using cadet::sqr;
-#endif
+		_memoBeta.clear();
+		_memoCenter.clear();
+		_memoValid.clear();
+		_memoCells = 0;
+	}
 
-		// Local order of the scheme that is actually used (may be changed by treatment of boundaries)
-		int order = _order;
+	/**
+	 * @brief Returns whether memoization of the smoothness indicators is enabled
+	 * @return @c true if memoization is enabled, otherwise @c false
+	 */
+	inline bool smoothnessMemoEnabled() const CADET_NOEXCEPT { return !_memoValid.empty(); }
 
-		// Boundaries
-		int bnd = 0;
+	/**
+	 * @brief Notifies the memo of the time point of the current residual evaluation
+	 * @details The DAE integrator evaluates all Newton iterations of one step attempt at the
+	 *          same time point, so the time stamp handed down from the integrator's residual
+	 *          wrapper identifies the step: a changed time point marks the first evaluation
+	 *          of a new step (or of a retried attempt) and invalidates all stored indicators.
+	 *          Does nothing if memoization is disabled.
+	 * @param [in] t Time point of the current residual evaluation
+	 */
+	inline void beginTimeStep(double t)
+	{
+		if (_memoValid.empty())
+			return;
+		if (t != _memoTime)
+		{
+			_memoTime = t;
+			std::fill(_memoValid.begin(), _memoValid.end(), char(0));
+		}
+	}
+
+	/**
+	 * @brief Selects the memo slot used by the following reconstructStrip() calls
+	 * @param [in] slot Index of the memo slot (e.g., index of the component being swept)
+	 */
+	inline void smoothnessMemoSlot(unsigned int slot) CADET_NOEXCEPT { _memoSlot = slot; }
+
+	/**
+	 * @brief Invalidates all memoized smoothness indicators
+	 */
+	inline void invalidateSmoothnessMemo()
+	{
+		std::fill(_memoValid.begin(), _memoValid.end(), char(0));
+		_memoTime = std::numeric_limits<double>::quiet_NaN();
+	}
+
+private:
+
+	/**
+	 * @brief Evaluates the boundary treatment for a single cell
+	 * @details Determines the locally used WENO order and the boundary weight cutoff
+	 *          according to the configured boundary treatment method. Used to build the
+	 *          per-cell tables in init() and as fallback in reconstruct() when the tables
+	 *          do not match the discretization.
+	 * @param [in] cellIdx Index of the cell
+	 * @param [in] numCells Number of cells
+	 * @param [out] order Locally used WENO order
+	 * @param [out] bnd Boundary weight cutoff (@c 0 in the interior)
+	 */
+	inline void applyBoundaryTreatment(unsigned int cellIdx, unsigned int numCells, int& order, int& bnd) const
+	{
+		order = _order;
+		bnd = 0;
 		switch (_boundaryTreatment)
 		{
 		default:
@@ -238,21 +486,46 @@ private:
 					bnd = numCells - cellIdx;
 			}
 			break;
-/*
-		case BoundaryTreatment::LargeGhostNodes:
-			// Large ghost points
-			if (cellIdx == 0)
-			{
-				w[-1] = 1e20;
-				w[-2] = 1e50;
-			}
-			else if (cellIdx == numCells - 2)
-				w[2] = 1e20;
-			else if (cellIdx == numCells - 1)
-				w[2] = 1e50;
-			break;
-*/
-		}		
+		}
+	}
+
+	/**
+	 * @brief Reconstructs a cell face value from volume averages
+	 * @param [in] epsilon \f$ \varepsilon \f$ of the WENO emthod (prevents division by zero in the weights) 
+	 * @param [in] cellIdx Index of the current cell
+	 * @param [in] numCells Number of cells
+	 * @param [in] w Stencil that contains the \f$ 2r-1 \f$ volume averages from which the cell face values are reconstructed centered at the 
+	 *               current cell (i.e., index 0 is the current cell, -2 the next to previous cell, 2 the next but one cell)
+	 * @param [out] result Reconstructed cell face value
+	 * @param [out] Dvm Gradient of the reconstructed cell face value (array has to be of size \f$ 2r-1\f$ where \f$ r \f$ is the WENO order)
+	 * @tparam StateType Type of the state variables
+	 * @tparam StencilType Type of the stencil (can be a dedicated class with overloaded operator[] or a simple pointer)
+	 * @tparam wantJac Determines if the gradient is computed (@c true) or not (@c false)
+	 * @return Order of the WENO scheme that was used in the computation
+	 */
+	template <typename StateType, typename StencilType, bool wantJac>
+	int reconstruct(double epsilon, unsigned int cellIdx, unsigned int numCells, const StencilType& w, StateType& result, double* const Dvm)
+	{
+#if defined(ACTIVE_SETFAD) || defined(ACTIVE_SFAD) || defined(ACTIVE_SFAD_ARENA)
+		using cadet::sqr;
+		using sfad::sqr;
+#elif defined(ACTIVE_ADOLC)
+		using cadet::sqr;
+#endif
+
+		// Local order of the scheme that is actually used (may be changed by treatment of boundaries)
+		int order = _order;
+		int bnd = 0;
+
+		// Look up the boundary treatment in the tables built by init(); only fall back to
+		// evaluating it here if the tables do not match the discretization
+		if (cadet_likely(numCells == _cellOrder.size()))
+		{
+			order = _cellOrder[cellIdx];
+			bnd = _cellBnd[cellIdx];
+		}
+		else
+			applyBoundaryTreatment(cellIdx, numCells, order, bnd);
 
 		// Total stencil size
 		const int sl = 2 * order - 1;
@@ -283,17 +556,17 @@ private:
 			case 2:
 				beta[0] = sqr(w[1] - w[0]);
 				beta[1] = sqr(w[0] - w[-1]);
-				d = _wenoD2;
-				c = _wenoC2;
-				Jbvv = _wenoJbvv2;
+				d = WenoCoefficients<2>::d;
+				c = WenoCoefficients<2>::c;
+				Jbvv = WenoCoefficients<2>::Jbvv;
 				break;
 			case 3:
 				beta[0] = 13.0/12.0 * sqr(w[ 0] - 2.0 * w[ 1] + w[2]) + 0.25 * sqr(3.0 * w[ 0] - 4.0 * w[ 1] +       w[2]);
 				beta[1] = 13.0/12.0 * sqr(w[-1] - 2.0 * w[ 0] + w[1]) + 0.25 * sqr(      w[-1] -       w[ 1]             );
 				beta[2] = 13.0/12.0 * sqr(w[-2] - 2.0 * w[-1] + w[0]) + 0.25 * sqr(      w[-2] - 4.0 * w[-1] + 3.0 * w[0]);
-				d = _wenoD3;
-				c = _wenoC3;
-				Jbvv = _wenoJbvv3;
+				d = WenoCoefficients<3>::d;
+				c = WenoCoefficients<3>::c;
+				Jbvv = WenoCoefficients<3>::Jbvv;
 				break;
 		}
 
@@ -380,18 +653,149 @@ private:
 		return order;
 	}
 
-	int _order; //!< Selected WENO order
-	BoundaryTreatment _boundaryTreatment; //!< Controls how to treat boundary cells
-	ArrayPool _intermediateValues; //!< Buffer for intermediate and temporary values
+	/**
+	 * @brief Reconstructs the right cell face values of all interior cells of a strip
+	 * @details Fixed-order kernel used by reconstructStrip() for cells that are not affected
+	 *          by the boundary treatment. All loop bounds and coefficient table indices are
+	 *          compile-time constants (the tables come from WenoCoefficients) and the
+	 *          temporaries live on the stack, so the multiply-add chains unroll and vectorize.
+	 *          The order of floating point operations matches the scalar reconstruct() kernel.
+	 *
+	 * @param [in] epsilon \f$ \varepsilon \f$ of the WENO method
+	 * @param [in] startCell Index of the first interior cell
+	 * @param [in] endCell Index of the last interior cell (inclusive)
+	 * @param [in] w Pointer to the contiguous cell averages of the strip
+	 * @param [out] vm Array receiving the reconstructed cell face values
+	 * @param [out] Dvm Array receiving the gradients (one row of maxStencilSize() entries per cell)
+	 * @param [out] usedOrder Array receiving the WENO order used in each cell
+	 * @param [in,out] memoBeta Memoized raw smoothness indicators of the active slot (one row of
+	 *                          maxOrder() entries per cell), or @c nullptr if memoization is disabled
+	 * @param [in,out] memoCenter Cell averages the memoized indicators were computed from, or @c nullptr
+	 * @param [in,out] memoValid Per-cell validity flags of the memo, or @c nullptr
+	 * @tparam order Order of the WENO method
+	 * @tparam wantJac Determines if the gradients are computed (@c true) or not (@c false)
+	 */
+	template <int order, bool wantJac>
+	void reconstructStripInterior(double epsilon, int startCell, int endCell, double const* w, double* vm, double* Dvm, int* usedOrder,
+		double* memoBeta, double* memoCenter, char* memoValid)
+	{
+		typedef WenoCoefficients<order> Coeffs;
+		const int sl = 2 * order - 1;
+		for (int col = startCell; col <= endCell; ++col)
+		{
+			double const* const ww = w + col;
+
+			double beta[order];
+			double omega[order];
+			double vr[order];
+
+			// Reuse the memoized smoothness measures if the cell average has barely moved
+			// since they were stored (first residual evaluation of the current time step)
+			if (memoValid && memoValid[col]
+				&& (std::abs(ww[0] - memoCenter[col]) <= _memoTol * std::max(std::abs(memoCenter[col]), 1.0)))
+			{
+				for (int r = 0; r < order; ++r)
+					beta[r] = memoBeta[col * static_cast<int>(maxOrder()) + r];
+			}
+			else
+			{
+				// Calculate smoothness measures
+				if (order == 2)
+				{
+					beta[0] = sqr(ww[1] - ww[0]);
+					beta[1] = sqr(ww[0] - ww[-1]);
+				}
+				else
+				{
+					beta[0] = 13.0/12.0 * sqr(ww[ 0] - 2.0 * ww[ 1] + ww[2]) + 0.25 * sqr(3.0 * ww[ 0] - 4.0 * ww[ 1] +       ww[2]);
+					beta[1] = 13.0/12.0 * sqr(ww[-1] - 2.0 * ww[ 0] + ww[1]) + 0.25 * sqr(      ww[-1] -       ww[ 1]             );
+					beta[2] = 13.0/12.0 * sqr(ww[-2] - 2.0 * ww[-1] + ww[0]) + 0.25 * sqr(      ww[-2] - 4.0 * ww[-1] + 3.0 * ww[0]);
+				}
+
+				if (memoValid)
+				{
+					for (int r = 0; r < order; ++r)
+						memoBeta[col * static_cast<int>(maxOrder()) + r] = beta[r];
+					memoCenter[col] = ww[0];
+					memoValid[col] = 1;
+				}
+			}
+
+			// Add eps to avoid divide-by-zeros and calculate weights
+			for (int r = 0; r < order; ++r)
+			{
+				beta[r] += epsilon;
+				omega[r] = Coeffs::d[r] / sqr(beta[r]);
+			}
+
+			// Normalize weights
+			double alpha_sum = omega[0];
+			for (int r = 1; r < order; ++r)
+				alpha_sum += omega[r];
+			for (int r = 0; r < order; ++r)
+				omega[r] /= alpha_sum;
 
-	static const double _wenoD2[2];
-	static const double _wenoC2[2*2];
-	static const double _wenoJbvv2[2*3*3];
+			// Calculate reconstructed values
+			for (int r = 0; r < order; ++r)
+			{
+				vr[r] = 0.0;
+				for (int j = 0; j < order; ++j)
+					vr[r] += Coeffs::c[r + order * j] * ww[-r+j];
+			}
+
+			// Weighted sum
+			double result = 0.0;
+			for (int r = 0; r < order; ++r)
+				result += vr[r] * omega[r];
+			vm[col] = result;
+			usedOrder[col] = order;
+
+			// Jacobian (same dependency chain as the scalar kernel)
+			if (wantJac)
+			{
+				double* const DvmRow = Dvm + col * maxStencilSize();
+
+				double dot = 0.0;
+				for (int r = 0; r < order; ++r)
+					dot += vr[r] * omega[r];
+				for (int r = 0; r < order; ++r)
+					vr[r] = (vr[r] - dot) / alpha_sum;
 
-	static const double _wenoD3[3];
-	static const double _wenoC3[3*3];
-	static const double _wenoJbvv3[3*5*5];
+				for (int r = 0; r < order; ++r)
+					vr[r] *= -2.0 * Coeffs::d[r] / pow(beta[r], 3.0);
+
+				for (int j = 0; j < sl; ++j)
+				{
+					DvmRow[j] = 0.0;
+					for (int r = 0; r < order; ++r)
+					{
+						dot = 0.0;
+						for (int i = 0; i < sl; ++i)
+							dot += Coeffs::Jbvv[r + order * j + order * sl * i] * ww[i - order + 1];
+						DvmRow[j] += vr[r] * dot;
+					}
+				}
+
+				for (int r = 0; r < order; ++r)
+					for (int j = 0; j < order; ++j)
+						DvmRow[order - 1 + j - r] += omega[r] * Coeffs::c[r + order * j];
+			}
+		}
+	}
 
+	int _order; //!< Selected WENO order
+	BoundaryTreatment _boundaryTreatment; //!< Controls how to treat boundary cells
+	ArrayPool _intermediateValues; //!< Buffer for intermediate and temporary values
+	std::vector<int> _cellOrder; //!< Locally used WENO order for each cell (precomputed by init(), empty if init() has not been called)
+	std::vector<int> _cellBnd; //!< Boundary weight cutoff for each cell (precomputed by init(), empty if init() has not been called)
+
+	std::vector<double> _memoBeta; //!< Memoized raw smoothness indicators (maxOrder() entries per cell and slot, empty if memoization is disabled)
+	std::vector<double> _memoCenter; //!< Cell averages the memoized indicators were computed from
+	std::vector<char> _memoValid; //!< Per-cell and slot validity flags of the memo
+	double _memoTol; //!< Maximum relative change of a cell average up to which memoized indicators are reused
+	unsigned int _memoCells; //!< Number of cells the memo is sized for
+	unsigned int _memoSlot; //!< Currently selected memo slot
+	double _memoTime; //!< Time point the memo was last invalidated at (identifies the time step)
 };
 
 } // namespace cadet
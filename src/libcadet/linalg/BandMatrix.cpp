@@ -12,9 +12,16 @@
 
 #include "linalg/BandMatrix.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
 #include <ostream>
 
+#ifdef CADET_PARALLELIZE
+	#include <tbb/tbb.h>
+#endif
+
 namespace cadet
 {
 
@@ -46,6 +53,374 @@ void bandMatrixVectorMultiplication(unsigned int rows, unsigned int upperBand, u
 	LapackMultiplyDenseBanded(trans, &n, &n, &kl, &ku, &alpha, const_cast<double*>(data), &ldab, const_cast<double*>(x), &inc, &beta, const_cast<double*>(y), &inc);
 }
 
+//! Number of rows processed per block in the blocked matrix-vector kernel; the
+//! corresponding slices of x, y, and the accumulator fit into L1 cache together
+const unsigned int blockedMultRows = 128;
+
+/**
+ * @brief Cache-blocked banded matrix-vector multiplication @f$ y = \alpha Ax + \beta y @f$
+ * @details Processes the matrix in blocks of rows. Each block is traversed diagonal by
+ *          diagonal, so the innermost loop runs over consecutive rows and accesses
+ *          @f$ x @f$ and the (aligned) accumulator with unit stride, which allows the
+ *          compiler to vectorize it. The band storage of a block stays in cache while
+ *          all of its diagonals are applied.
+ */
+void bandMatrixVectorMultiplicationBlocked(unsigned int rows, unsigned int lowerBand, unsigned int upperBand, unsigned int stride,
+	double const* CADET_RESTRICT const data, double alpha, double beta, double const* CADET_RESTRICT const x, double* CADET_RESTRICT const y)
+{
+	const int lb = static_cast<int>(lowerBand);
+	const int ub = static_cast<int>(upperBand);
+	const int n = static_cast<int>(rows);
+
+	alignas(detail::matrixDataAlignment) double acc[blockedMultRows];
+
+	for (int rowStart = 0; rowStart < n; rowStart += blockedMultRows)
+	{
+		const int rowEnd = std::min(n, rowStart + static_cast<int>(blockedMultRows));
+		std::fill(acc, acc + (rowEnd - rowStart), 0.0);
+
+		// Diagonal-major traversal of the block
+		for (int d = -lb; d <= ub; ++d)
+		{
+			// Clip rows for which the diagonal leaves the matrix
+			const int rBegin = std::max(rowStart, -d);
+			const int rFinal = std::min(rowEnd, n - d);
+
+			// Element (r, d) of the band is located at diag[r * stride]
+			double const* const diag = data + lb + d;
+			for (int r = rBegin; r < rFinal; ++r)
+				acc[r - rowStart] += diag[r * static_cast<int>(stride)] * x[r + d];
+		}
+
+		for (int r = rowStart; r < rowEnd; ++r)
+			y[r] = alpha * acc[r - rowStart] + beta * y[r];
+	}
+}
+
+//! Minimum total bandwidth for which the native blocked LU outperforms LAPACK's serial dgbtrf
+const unsigned int nativeLuMinBandwidth = 48;
+
+//! Number of pivot columns factorized per panel in the native blocked LU
+const unsigned int nativeLuPanelSize = 16;
+
+//! Maximum number of iterative refinement steps of the mixed precision solver
+const unsigned int maxRefinementIter = 10;
+
+/**
+ * @brief Blocked banded LU factorization with partial pivoting
+ * @details Computes the same factorization as LAPACK's dgbtrf on the band storage of
+ *          FactorizableBandMatrix (in which the matrix appears transposed, i.e., lower
+ *          and upper bandwidth interchange and a column of the factorized matrix is
+ *          contiguous in memory). Multipliers, fill-in, and the 1-based pivot indices
+ *          are stored exactly like dgbtrf stores them, so the factorization can be
+ *          passed to dgbtrs for solving.
+ *
+ *          Pivot columns are processed in panels. Row interchanges and rank-1 updates
+ *          are applied immediately inside the panel, but deferred for the trailing
+ *          columns and replayed there column by column. Since a deferred column only
+ *          reads the finished panel and writes to itself, the trailing update is
+ *          embarrassingly parallel over the affected columns and is threaded for
+ *          sufficiently wide bands.
+ *
+ * @param [in] rows Number of rows
+ * @param [in] lowerBand Number of lower diagonals (excluding the main diagonal)
+ * @param [in] upperBand Number of upper diagonals (excluding the main diagonal)
+ * @param [in] stride Stride of the band storage including the fill-in area
+ * @param [in,out] data Pointer to band storage, on exit the LU factorization
+ * @param [out] pivot Array of 1-based pivot indices (at least @p rows elements)
+ * @return @c true if the factorization was successful, @c false if the matrix is singular
+ */
+bool bandedLuFactorizeBlocked(unsigned int rows, unsigned int lowerBand, unsigned int upperBand, unsigned int stride,
+	double* CADET_RESTRICT const data, lapackInt_t* CADET_RESTRICT const pivot)
+{
+	const int n = static_cast<int>(rows);
+
+	// In the transposed view LAPACK has of our storage, lower and upper bandwidth interchange
+	const int kl = static_cast<int>(upperBand);
+	const int ku = static_cast<int>(lowerBand);
+	const int center = kl + ku;
+	const int ldm = static_cast<int>(stride);
+	const int nb = static_cast<int>(nativeLuPanelSize);
+
+	// Clear the fill-in area populated by the row interchanges
+	for (int j = 0; j < n; ++j)
+		std::fill(data + j * ldm, data + j * ldm + kl, 0.0);
+
+	bool singular = false;
+
+	for (int p0 = 0; p0 < n; p0 += nb)
+	{
+		const int p1 = std::min(n, p0 + nb);
+
+		// Factorize the panel; interchanges and updates of panel columns are applied immediately
+		for (int j = p0; j < p1; ++j)
+		{
+			double* const cj = data + j * ldm + center;
+			const int km = std::min(kl, n - 1 - j);
+
+			// Partial pivoting; the subdiagonal part of the pivot column is contiguous
+			int jp = 0;
+			for (int d = 1; d <= km; ++d)
+			{
+				if (std::abs(cj[d]) > std::abs(cj[jp]))
+					jp = d;
+			}
+			pivot[j] = j + jp + 1; // LAPACK uses 1-based pivot indices
+
+			if (cj[jp] != 0.0)
+			{
+				const int jw = std::min(p1 - 1, j + ku + kl);
+
+				// Apply the row interchange to the panel columns
+				if (jp != 0)
+				{
+					for (int k = j; k <= jw; ++k)
+					{
+						double* const ck = data + k * ldm + center;
+						std::swap(ck[j - k], ck[j + jp - k]);
+					}
+				}
+
+				// Compute the multipliers
+				const double invPivot = 1.0 / cj[0];
+				for (int d = 1; d <= km; ++d)
+					cj[d] *= invPivot;
+
+				// Rank-1 update of the remaining panel columns
+				for (int k = j + 1; k <= jw; ++k)
+				{
+					double* const ck = data + k * ldm + center;
+					const double mjk = ck[j - k];
+					if (mjk != 0.0)
+					{
+						for (int d = 1; d <= km; ++d)
+							ck[j + d - k] -= mjk * cj[d];
+					}
+				}
+			}
+			else
+				singular = true;
+		}
+
+		// Replay the deferred interchanges and updates of the whole panel on each trailing column
+		const int trailEnd = std::min(n, p1 + ku + kl);
+		const auto updateTrailingColumn = [&](int k)
+		{
+			double* const ck = data + k * ldm + center;
+			for (int j = std::max(p0, k - ku - kl); j < p1; ++j)
+			{
+				const int jp = static_cast<int>(pivot[j]) - 1 - j;
+				if (jp != 0)
+					std::swap(ck[j - k], ck[j + jp - k]);
+
+				const double mjk = ck[j - k];
+				if (mjk != 0.0)
+				{
+					double const* const cj = data + j * ldm + center;
+					const int km = std::min(kl, n - 1 - j);
+					for (int d = 1; d <= km; ++d)
+						ck[j + d - k] -= mjk * cj[d];
+				}
+			}
+		};
+
+#ifdef CADET_PARALLELIZE
+		tbb::parallel_for(p1, trailEnd, 1, updateTrailingColumn);
+#else
+		for (int k = p1; k < trailEnd; ++k)
+			updateTrailingColumn(k);
+#endif
+	}
+
+	return !singular;
+}
+
+//! Maximum lower / upper bandwidth handled by the compile-time specialized small-band LU
+const unsigned int smallLuMaxBandwidth = 3;
+
+/**
+ * @brief Banded LU factorization with partial pivoting for compile-time small bandwidths
+ * @details Same storage contract as bandedLuFactorizeBlocked() (and thus dgbtrf): lower
+ *          and upper bandwidth refer to the transposed view LAPACK has of our storage.
+ *          With the bandwidths fixed at compile time, all inner loops have constant trip
+ *          counts of at most @c KL resp. @c KL + KU and are fully unrolled, which removes
+ *          the generic-band overhead that dominates for tri- and pentadiagonal blocks
+ *          (e.g., the column blocks of low WENO orders).
+ *
+ * @param [in] n Number of rows
+ * @param [in] ldm Stride of the band storage including the fill-in area
+ * @param [in,out] data Pointer to band storage, on exit the LU factorization
+ * @param [out] pivot Array of 1-based pivot indices (at least @p n elements)
+ * @tparam KL Number of lower diagonals in the transposed view (= upper bandwidth of the matrix)
+ * @tparam KU Number of upper diagonals in the transposed view (= lower bandwidth of the matrix)
+ * @return @c true if the factorization was successful, @c false if the matrix is singular
+ */
+template <int KL, int KU>
+bool bandedLuFactorizeSmall(int n, int ldm, double* CADET_RESTRICT const data, lapackInt_t* CADET_RESTRICT const pivot)
+{
+	const int center = KL + KU;
+	bool singular = false;
+
+	// Clear the fill-in area populated by the row interchanges
+	for (int j = 0; j < n; ++j)
+		std::fill(data + j * ldm, data + j * ldm + KL, 0.0);
+
+	for (int j = 0; j < n; ++j)
+	{
+		double* const cj = data + j * ldm + center;
+		const int km = std::min(KL, n - 1 - j);
+
+		// Partial pivoting; the subdiagonal part of the pivot column is contiguous
+		int jp = 0;
+		for (int d = 1; d <= km; ++d)
+		{
+			if (std::abs(cj[d]) > std::abs(cj[jp]))
+				jp = d;
+		}
+		pivot[j] = j + jp + 1; // LAPACK uses 1-based pivot indices
+
+		if (cadet_likely(cj[jp] != 0.0))
+		{
+			const int jw = std::min(n - 1, j + KU + KL);
+
+			// Apply the row interchange
+			if (jp != 0)
+			{
+				for (int k = j; k <= jw; ++k)
+				{
+					double* const ck = data + k * ldm + center;
+					std::swap(ck[j - k], ck[j + jp - k]);
+				}
+			}
+
+			// Compute the multipliers
+			const double invPivot = 1.0 / cj[0];
+			for (int d = 1; d <= km; ++d)
+				cj[d] *= invPivot;
+
+			// Rank-1 update of the trailing columns
+			for (int k = j + 1; k <= jw; ++k)
+			{
+				double* const ck = data + k * ldm + center;
+				const double mjk = ck[j - k];
+				if (mjk != 0.0)
+				{
+					for (int d = 1; d <= km; ++d)
+						ck[j + d - k] -= mjk * cj[d];
+				}
+			}
+		}
+		else
+			singular = true;
+	}
+
+	return !singular;
+}
+
+/**
+ * @brief Banded backward / forward substitution for compile-time small bandwidths
+ * @details Performs the same solve as dgbtrs with @c trans @c = @c 'T' on the factorization
+ *          produced by bandedLuFactorizeSmall() (or dgbtrf), i.e., it solves the original
+ *          (untransposed) equation @f$ Ax = b @f$. Inner loops have constant trip counts.
+ *
+ * @param [in] n Number of rows
+ * @param [in] ldm Stride of the band storage including the fill-in area
+ * @param [in] data Pointer to the factorized band storage
+ * @param [in] pivot Array of 1-based pivot indices from the factorization
+ * @param [in,out] rhs On entry the right hand side @f$ b @f$, on exit the solution @f$ x @f$
+ * @tparam KL Number of lower diagonals in the transposed view (= upper bandwidth of the matrix)
+ * @tparam KU Number of upper diagonals in the transposed view (= lower bandwidth of the matrix)
+ */
+template <int KL, int KU>
+void bandedLuSolveSmall(int n, int ldm, double const* CADET_RESTRICT const data, lapackInt_t const* CADET_RESTRICT const pivot, double* CADET_RESTRICT const rhs)
+{
+	const int center = KL + KU;
+
+	// Solve U^T z = b by forward substitution; U has KL + KU superdiagonals
+	for (int j = 0; j < n; ++j)
+	{
+		double const* const cj = data + j * ldm + center;
+		const int lm = std::min(KL + KU, j);
+
+		double temp = rhs[j];
+		for (int d = 1; d <= lm; ++d)
+			temp -= cj[-d] * rhs[j - d];
+		rhs[j] = temp / cj[0];
+	}
+
+	// Solve L^T x = z and apply the row interchanges in reverse order
+	for (int j = n - 2; j >= 0; --j)
+	{
+		double const* const cj = data + j * ldm + center;
+		const int lm = std::min(KL, n - 1 - j);
+
+		double temp = rhs[j];
+		for (int d = 1; d <= lm; ++d)
+			temp -= cj[d] * rhs[j + d];
+		rhs[j] = temp;
+
+		const int jp = static_cast<int>(pivot[j]) - 1;
+		if (jp != j)
+			std::swap(rhs[j], rhs[jp]);
+	}
+}
+
+/**
+ * @brief Selects the small-band factorization specialization matching the given bandwidths
+ * @return @c true if the factorization was successful, @c false if the matrix is singular
+ */
+bool dispatchFactorizeSmall(unsigned int kl, unsigned int ku, int n, int ldm, double* CADET_RESTRICT const data, lapackInt_t* CADET_RESTRICT const pivot)
+{
+	cadet_assert((kl <= smallLuMaxBandwidth) && (ku <= smallLuMaxBandwidth));
+	switch ((kl << 2) | ku)
+	{
+		case (0 << 2) | 0: return bandedLuFactorizeSmall<0, 0>(n, ldm, data, pivot);
+		case (0 << 2) | 1: return bandedLuFactorizeSmall<0, 1>(n, ldm, data, pivot);
+		case (0 << 2) | 2: return bandedLuFactorizeSmall<0, 2>(n, ldm, data, pivot);
+		case (0 << 2) | 3: return bandedLuFactorizeSmall<0, 3>(n, ldm, data, pivot);
+		case (1 << 2) | 0: return bandedLuFactorizeSmall<1, 0>(n, ldm, data, pivot);
+		case (1 << 2) | 1: return bandedLuFactorizeSmall<1, 1>(n, ldm, data, pivot);
+		case (1 << 2) | 2: return bandedLuFactorizeSmall<1, 2>(n, ldm, data, pivot);
+		case (1 << 2) | 3: return bandedLuFactorizeSmall<1, 3>(n, ldm, data, pivot);
+		case (2 << 2) | 0: return bandedLuFactorizeSmall<2, 0>(n, ldm, data, pivot);
+		case (2 << 2) | 1: return bandedLuFactorizeSmall<2, 1>(n, ldm, data, pivot);
+		case (2 << 2) | 2: return bandedLuFactorizeSmall<2, 2>(n, ldm, data, pivot);
+		case (2 << 2) | 3: return bandedLuFactorizeSmall<2, 3>(n, ldm, data, pivot);
+		case (3 << 2) | 0: return bandedLuFactorizeSmall<3, 0>(n, ldm, data, pivot);
+		case (3 << 2) | 1: return bandedLuFactorizeSmall<3, 1>(n, ldm, data, pivot);
+		case (3 << 2) | 2: return bandedLuFactorizeSmall<3, 2>(n, ldm, data, pivot);
+		case (3 << 2) | 3: return bandedLuFactorizeSmall<3, 3>(n, ldm, data, pivot);
+	}
+	return false;
+}
+
+/**
+ * @brief Selects the small-band substitution specialization matching the given bandwidths
+ */
+void dispatchSolveSmall(unsigned int kl, unsigned int ku, int n, int ldm, double const* CADET_RESTRICT const data, lapackInt_t const* CADET_RESTRICT const pivot, double* CADET_RESTRICT const rhs)
+{
+	cadet_assert((kl <= smallLuMaxBandwidth) && (ku <= smallLuMaxBandwidth));
+	switch ((kl << 2) | ku)
+	{
+		case (0 << 2) | 0: return bandedLuSolveSmall<0, 0>(n, ldm, data, pivot, rhs);
+		case (0 << 2) | 1: return bandedLuSolveSmall<0, 1>(n, ldm, data, pivot, rhs);
+		case (0 << 2) | 2: return bandedLuSolveSmall<0, 2>(n, ldm, data, pivot, rhs);
+		case (0 << 2) | 3: return bandedLuSolveSmall<0, 3>(n, ldm, data, pivot, rhs);
+		case (1 << 2) | 0: return bandedLuSolveSmall<1, 0>(n, ldm, data, pivot, rhs);
+		case (1 << 2) | 1: return bandedLuSolveSmall<1, 1>(n, ldm, data, pivot, rhs);
+		case (1 << 2) | 2: return bandedLuSolveSmall<1, 2>(n, ldm, data, pivot, rhs);
+		case (1 << 2) | 3: return bandedLuSolveSmall<1, 3>(n, ldm, data, pivot, rhs);
+		case (2 << 2) | 0: return bandedLuSolveSmall<2, 0>(n, ldm, data, pivot, rhs);
+		case (2 << 2) | 1: return bandedLuSolveSmall<2, 1>(n, ldm, data, pivot, rhs);
+		case (2 << 2) | 2: return bandedLuSolveSmall<2, 2>(n, ldm, data, pivot, rhs);
+		case (2 << 2) | 3: return bandedLuSolveSmall<2, 3>(n, ldm, data, pivot, rhs);
+		case (3 << 2) | 0: return bandedLuSolveSmall<3, 0>(n, ldm, data, pivot, rhs);
+		case (3 << 2) | 1: return bandedLuSolveSmall<3, 1>(n, ldm, data, pivot, rhs);
+		case (3 << 2) | 2: return bandedLuSolveSmall<3, 2>(n, ldm, data, pivot, rhs);
+		case (3 << 2) | 3: return bandedLuSolveSmall<3, 3>(n, ldm, data, pivot, rhs);
+	}
+}
+
 template <class MatrixType>
 void bandMatrixToSparseString(std::ostream& out, const MatrixType& mt)
 {
@@ -94,10 +469,53 @@ void bandMatrixToSparseString(std::ostream& out, const MatrixType& mt)
 
 void BandMatrix::multiplyVector(const double* const x, double alpha, double beta, double* const y) const
 {
-	bandMatrixVectorMultiplication(_rows, _upperBand, _lowerBand, stride(), _data, alpha, beta, x, y);
+	bandMatrixVectorMultiplicationBlocked(_rows, _lowerBand, _upperBand, stride(), _data, alpha, beta, x, y);
 }
 
-void BandMatrix::submatrixMultiplyVector(const double* const x, unsigned int startRow, int startDiag, 
+void BandMatrix::transposedMultiplyVector(const double* const x, double alpha, double beta, double* const y) const
+{
+	const int lowerBand = static_cast<int>(_lowerBand);
+	const int upperBand = static_cast<int>(_upperBand);
+
+	// Element A(r,c) of column c is stored at centered(r, c - r); admissible rows
+	// are r in [c - upperBand, c + lowerBand], clipped to the matrix
+	for (unsigned int c = 0; c < _rows; ++c)
+	{
+		const int lower = std::max(-upperBand, -static_cast<int>(c));
+		const int upper = std::min(lowerBand, static_cast<int>(_rows - c) - 1);
+
+		double temp = 0.0;
+		for (int d = lower; d <= upper; ++d)
+			temp += centered(static_cast<int>(c) + d, -d) * x[static_cast<int>(c) + d];
+
+		y[c] = alpha * temp + beta * y[c];
+	}
+}
+
+void BandMatrix::multiplyVectors(double const* const* x, unsigned int numVectors, double alpha, double beta, double* const* y) const
+{
+	const int lowerBand = static_cast<int>(_lowerBand);
+	const int upperBand = static_cast<int>(_upperBand);
+
+	for (unsigned int r = 0; r < _rows; ++r)
+	{
+		// Clip the band to the matrix at the top left and bottom right corners
+		const int lower = std::max(-lowerBand, -static_cast<int>(r));
+		const int upper = std::min(upperBand, static_cast<int>(_rows - r) - 1);
+
+		// The band row stays in cache while it is applied to all vectors of the panel
+		for (unsigned int v = 0; v < numVectors; ++v)
+		{
+			double temp = 0.0;
+			for (int d = lower; d <= upper; ++d)
+				temp += centered(r, d) * x[v][static_cast<int>(r) + d];
+
+			y[v][r] = alpha * temp + beta * y[v][r];
+		}
+	}
+}
+
+void BandMatrix::submatrixMultiplyVector(const double* const x, unsigned int startRow, int startDiag,
 		unsigned int numRows, unsigned int numCols, double alpha, double beta, double* const y) const
 {
 	cadet_assert(startDiag >= -static_cast<int>(_lowerBand));
@@ -173,10 +591,29 @@ void FactorizableBandMatrix::multiplyVector(const double* const x, double alpha,
 
 bool FactorizableBandMatrix::factorize()
 {
+	return factorize(_rows);
+}
+
+bool FactorizableBandMatrix::factorize(unsigned int rows)
+{
+	cadet_assert(rows <= _rows);
+
+	// For wide bands the native blocked LU threads the trailing-submatrix updates,
+	// whereas the serial LAPACK routine wins for the narrow bands of small matrices.
+	// Both produce the same storage layout and pivot indices, so solve() works either way.
+	if (_lowerBand + _upperBand >= nativeLuMinBandwidth)
+		return bandedLuFactorizeBlocked(rows, _lowerBand, _upperBand, stride(), _data, _pivot);
+
+	// Tiny bands (tri- and pentadiagonal blocks of low WENO orders) use fully
+	// unrolled specializations; the generic LAPACK routine pays per-element
+	// bookkeeping that dwarfs the actual arithmetic at these bandwidths
+	if ((_lowerBand <= smallLuMaxBandwidth) && (_upperBand <= smallLuMaxBandwidth))
+		return dispatchFactorizeSmall(_upperBand, _lowerBand, rows, stride(), _data, _pivot);
+
 	// Since LAPACK uses column-major storage and we use row-major,
 	// we actually have constructed the transposed matrix. Thus,
 	// upper and lower diagonals interchange.
-	lapackInt_t n = _rows;
+	lapackInt_t n = rows;
 	lapackInt_t kl = _upperBand;
 	lapackInt_t ku   = _lowerBand;
 	lapackInt_t ldab = stride();
@@ -191,10 +628,24 @@ bool FactorizableBandMatrix::factorize()
 
 bool FactorizableBandMatrix::solve(double* rhs) const
 {
+	return solve(_rows, rhs);
+}
+
+bool FactorizableBandMatrix::solve(unsigned int rows, double* rhs) const
+{
+	cadet_assert(rows <= _rows);
+
+	// Tiny bands use the fully unrolled specializations matching factorize()
+	if ((_lowerBand <= smallLuMaxBandwidth) && (_upperBand <= smallLuMaxBandwidth))
+	{
+		dispatchSolveSmall(_upperBand, _lowerBand, rows, stride(), _data, _pivot, rhs);
+		return true;
+	}
+
 	// Since LAPACK uses column-major storage and we use row-major,
 	// we actually have constructed the transposed matrix. Thus,
 	// upper and lower diagonals interchange.
-	lapackInt_t n = _rows;
+	lapackInt_t n = rows;
 	lapackInt_t kl = _upperBand;
 	lapackInt_t ku = _lowerBand;
 	lapackInt_t nrhs = 1;
@@ -211,6 +662,138 @@ bool FactorizableBandMatrix::solve(double* rhs) const
 	return flag == 0;
 }
 
+bool FactorizableBandMatrix::factorizeMixedPrecision()
+{
+	_mixedFactorized = false;
+
+	// Copy the matrix including the fill-in area to single precision; the double
+	// precision matrix is left untouched for computing refinement residuals
+	const unsigned int numElems = stride() * _rows;
+	_singleData.resize(numElems);
+	for (unsigned int i = 0; i < numElems; ++i)
+		_singleData[i] = static_cast<float>(_data[i]);
+
+	// Row sum norm of the matrix for the convergence test of iterative refinement
+	_singleAnorm = 0.0;
+	for (unsigned int r = 0; r < _rows; ++r)
+	{
+		double rowSum = 0.0;
+		double const* const row = _data + r * stride() + _upperBand;
+		for (unsigned int i = 0; i < apparentStride(); ++i)
+			rowSum += std::abs(row[i]);
+		_singleAnorm = std::max(_singleAnorm, rowSum);
+	}
+
+	// Since LAPACK uses column-major storage and we use row-major,
+	// we actually have constructed the transposed matrix. Thus,
+	// upper and lower diagonals interchange.
+	lapackInt_t n = _rows;
+	lapackInt_t kl = _upperBand;
+	lapackInt_t ku = _lowerBand;
+	lapackInt_t ldab = stride();
+	lapackInt_t flag = 0;
+
+	LapackFactorSingleBanded(&n, &n, &kl, &ku, _singleData.data(), &ldab, _pivot, &flag);
+
+	// Fall back to double precision if single precision runs into a (numerically) singular matrix
+	if (flag != 0)
+		return factorize();
+
+	_singleWork.resize(_rows);
+	_refineRhs.resize(_rows);
+	_refineRes.resize(_rows);
+	_mixedFactorized = true;
+	return true;
+}
+
+bool FactorizableBandMatrix::solveSinglePrecision(double const* rhs, double* sol)
+{
+	for (unsigned int i = 0; i < _rows; ++i)
+		_singleWork[i] = static_cast<float>(rhs[i]);
+
+	// Since LAPACK uses column-major storage and we use row-major,
+	// we actually have constructed the transposed matrix. Thus,
+	// upper and lower diagonals interchange.
+	lapackInt_t n = _rows;
+	lapackInt_t kl = _upperBand;
+	lapackInt_t ku = _lowerBand;
+	lapackInt_t nrhs = 1;
+	lapackInt_t ldab = stride();
+	lapackInt_t flag = 0;
+
+	// For LAPACK the matrix looks like it's transposed. We, thus,
+	// solve the transposed equation which uses the original matrix.
+	char trans[] = "T";
+
+	LapackSolveSingleBanded(trans, &n, &kl, &ku, &nrhs, _singleData.data(), &ldab, _pivot, _singleWork.data(), &n, &flag);
+
+	if (flag != 0)
+		return false;
+
+	for (unsigned int i = 0; i < _rows; ++i)
+		sol[i] = static_cast<double>(_singleWork[i]);
+
+	return true;
+}
+
+bool FactorizableBandMatrix::solveMixedPrecision(double* rhs)
+{
+	if (!_mixedFactorized)
+		return solve(rhs);
+
+	// Keep the right hand side b for computing residuals
+	std::copy(rhs, rhs + _rows, _refineRhs.begin());
+
+	bool converged = false;
+	if (solveSinglePrecision(_refineRhs.data(), rhs))
+	{
+		double prevNorm = std::numeric_limits<double>::infinity();
+		for (unsigned int iter = 0; iter < maxRefinementIter; ++iter)
+		{
+			// Compute the residual r = b - A x in double precision
+			std::copy(_refineRhs.begin(), _refineRhs.end(), _refineRes.begin());
+			multiplyVector(rhs, -1.0, 1.0, _refineRes.data());
+
+			double normR = 0.0;
+			double normX = 0.0;
+			for (unsigned int i = 0; i < _rows; ++i)
+			{
+				normR = std::max(normR, std::abs(_refineRes[i]));
+				normX = std::max(normX, std::abs(rhs[i]));
+			}
+
+			// Convergence test similar to LAPACK's dsgesv
+			if (normR <= normX * _singleAnorm * std::numeric_limits<double>::epsilon() * std::sqrt(static_cast<double>(_rows)))
+			{
+				converged = true;
+				break;
+			}
+
+			// Give up if the residual stops contracting
+			if (normR >= 0.5 * prevNorm)
+				break;
+			prevNorm = normR;
+
+			// Apply the correction x += A^{-1} r computed in single precision
+			if (!solveSinglePrecision(_refineRes.data(), _refineRes.data()))
+				break;
+			for (unsigned int i = 0; i < _rows; ++i)
+				rhs[i] += _refineRes[i];
+		}
+	}
+
+	if (converged)
+		return true;
+
+	// Refinement failed (e.g., matrix too ill-conditioned for single precision):
+	// restore the right hand side and fall back to a double precision factorization
+	std::copy(_refineRhs.begin(), _refineRhs.end(), rhs);
+	_mixedFactorized = false;
+	if (!factorize())
+		return false;
+	return solve(rhs);
+}
+
 std::ostream& operator<<(std::ostream& out, const BandMatrix& bm)
 {
 	bandMatrixToSparseString(out, bm);
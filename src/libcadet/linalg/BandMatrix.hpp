@@ -21,9 +21,19 @@
 #include "cadet/cadetCompilerInfo.hpp"
 #include "common/CompilerSpecific.hpp"
 #include "LapackInterface.hpp"
+#include "AlignedMemory.hpp"
 
 #include <ostream>
 #include <algorithm>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef CADET_PARALLELIZE
+	#include <tbb/parallel_for.h>
+	#include <tbb/blocked_range.h>
+	#include <tbb/partitioner.h>
+#endif
 
 namespace cadet
 {
@@ -31,6 +41,40 @@ namespace cadet
 namespace linalg
 {
 
+namespace detail
+{
+	//! Alignment of matrix storage in bytes (cache line, also suffices for AVX-512 loads)
+	const std::size_t matrixDataAlignment = ::cadet::cacheLineAlignment;
+
+	using ::cadet::alignedDoubleAlloc;
+	using ::cadet::alignedDoubleFree;
+
+	/**
+	 * @brief Zeros an array such that its pages are distributed over the worker threads
+	 * @details Under the usual first-touch page placement policy of the operating system,
+	 *          a page is placed on the NUMA domain of the thread that writes to it first.
+	 *          Zeroing the array in page sized chunks from the worker threads therefore
+	 *          interleaves the storage over the NUMA domains the threads run on, which
+	 *          balances the memory bandwidth when the array is later streamed by multiple
+	 *          threads. Reduces to a serial fill in non-parallel builds.
+	 * @param [in] data Pointer to the array
+	 * @param [in] n Number of elements
+	 */
+	inline void firstTouchFill(double* data, std::size_t n)
+	{
+#ifdef CADET_PARALLELIZE
+		// One chunk per memory page (4096 bytes); the simple partitioner prevents
+		// chunk merging and thus spreads the pages over the worker threads
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0, n, 4096 / sizeof(double)), [=](const tbb::blocked_range<std::size_t>& r)
+		{
+			std::fill(data + r.begin(), data + r.end(), 0.0);
+		}, tbb::simple_partitioner());
+#else
+		std::fill(data, data + n, 0.0);
+#endif
+	}
+} // namespace detail
+
 /**
  * @brief Iterates over rows of a banded matrix like BandMatrix or FactorizableBandMatrix
  * @tparam MatrixType Type of the matrix class, one of BandMatrix or FactorizableBandMatrix
@@ -560,19 +604,19 @@ public:
 	 * @brief Creates an empty, unitialized band matrix
 	 * @details No memory is allocated for the matrix. Users have to call resize() first.
 	 */
-	BandMatrix() CADET_NOEXCEPT : _data(nullptr), _lowerBand(0), _upperBand(0), _rows(0) { }
+	BandMatrix() CADET_NOEXCEPT : _data(nullptr), _lowerBand(0), _upperBand(0), _rows(0), _capacity(0) { }
 	~BandMatrix() CADET_NOEXCEPT
 	{
-		delete[] _data;
+		detail::alignedDoubleFree(_data);
 	}
 
-	BandMatrix(const BandMatrix& cpy) : _data(new double[cpy.stride() * cpy._rows]),
-		_lowerBand(cpy._lowerBand), _upperBand(cpy._upperBand), _rows(cpy._rows)
+	BandMatrix(const BandMatrix& cpy) : _data(detail::alignedDoubleAlloc(cpy.stride() * cpy._rows)),
+		_lowerBand(cpy._lowerBand), _upperBand(cpy._upperBand), _rows(cpy._rows), _capacity(cpy.stride() * cpy._rows)
 	{
 		copyValues(cpy._data);
 	}
 
-	BandMatrix(BandMatrix&& cpy) CADET_NOEXCEPT : _data(cpy._data), _lowerBand(cpy._lowerBand), _upperBand(cpy._upperBand), _rows(cpy._rows)
+	BandMatrix(BandMatrix&& cpy) CADET_NOEXCEPT : _data(cpy._data), _lowerBand(cpy._lowerBand), _upperBand(cpy._upperBand), _rows(cpy._rows), _capacity(cpy._capacity)
 	{
 		cpy._data = nullptr;
 	}
@@ -585,8 +629,9 @@ public:
 		_upperBand = cpy._upperBand;
 		_rows = cpy._rows;
 
-		delete[] _data;
-		_data = new double[cpy.stride() * cpy._rows];
+		detail::alignedDoubleFree(_data);
+		_data = detail::alignedDoubleAlloc(cpy.stride() * cpy._rows);
+		_capacity = cpy.stride() * cpy._rows;
 
 		copyValues(cpy._data);
 		return *this;
@@ -598,9 +643,10 @@ public:
 		_upperBand = cpy._upperBand;
 		_rows = cpy._rows;
 
-		delete[] _data;
+		detail::alignedDoubleFree(_data);
 		_data = cpy._data;
 		cpy._data = nullptr;
+		_capacity = cpy._capacity;
 
 		return *this;
 	}
@@ -616,29 +662,64 @@ public:
 	 */
 	inline void resize(unsigned int rows, unsigned int lowerBand, unsigned int upperBand)
 	{
-		delete[] _data;
-
 		_rows = rows;
 		_lowerBand = lowerBand;
 		_upperBand = upperBand;
 
 		// Do not forget the main diagonal
-		_data = new double[stride() * _rows];
-		setAll(0.0);
+		if (cadet_unlikely(_capacity >= stride() * _rows))
+		{
+			// Use existing memory
+			setAll(0.0);
+			return;
+		}
+
+		_capacity = stride() * _rows;
+
+		detail::alignedDoubleFree(_data);
+		_data = detail::alignedDoubleAlloc(_capacity);
+		detail::firstTouchFill(_data, _capacity);
+	}
+
+	/**
+	 * @brief Ensures enough capacity for a matrix of the given size without changing the layout
+	 * @details Grows the allocated memory such that subsequent resize() and repartition() calls
+	 *          within the given limits are guaranteed to reuse the existing memory. The logical
+	 *          size and partitioning of the matrix are not changed, but all data is lost if
+	 *          memory has to be allocated. Reserve for the widest required bandwidth up front
+	 *          (e.g., the largest WENO order of all time sections) so that later bandwidth
+	 *          switches never allocate.
+	 *
+	 * @param [in] rows Number of rows
+	 * @param [in] lowerBand Number of lower diagonals (excluding the main diagonal)
+	 * @param [in] upperBand Number of upper diagonals (excluding the main diagonal)
+	 */
+	inline void reserve(unsigned int rows, unsigned int lowerBand, unsigned int upperBand)
+	{
+		const unsigned int cap = rows * (lowerBand + upperBand + 1);
+		if (cadet_likely(cap <= _capacity))
+			return;
+
+		_capacity = cap;
+
+		detail::alignedDoubleFree(_data);
+		_data = detail::alignedDoubleAlloc(_capacity);
+		detail::firstTouchFill(_data, _capacity);
 	}
 
 	/**
 	 * @brief Repartitions the matrix by changing lower and upper bandwidth
-	 * @details The number of nonzero elements per row (i.e., sum of lower and upper bandwidth)
-	 *          must not change. This way, all of the memory is reused.
+	 * @details There has to be enough capacity for the new bandwidths, which is always
+	 *          the case if the sum of lower and upper bandwidth does not exceed the one
+	 *          the matrix was resized to. All of the memory is reused.
 	 *          Note that the data is not reset to @c 0.0 by this operation.
-	 *          
+	 *
 	 * @param [in] lowerBand Number of lower diagonals (excluding the main diagonal)
 	 * @param [in] upperBand Number of upper diagonals (excluding the main diagonal)
 	 */
 	inline void repartition(unsigned int lowerBand, unsigned int upperBand)
 	{
-		cadet_assert(lowerBand + upperBand == _lowerBand + _upperBand);
+		cadet_assert(_capacity >= _rows * (lowerBand + upperBand + 1));
 		_lowerBand = lowerBand;
 		_upperBand = upperBand;
 	}
@@ -734,6 +815,12 @@ public:
 	inline double* data() CADET_NOEXCEPT { return _data; }
 	inline double const* data() const CADET_NOEXCEPT { return _data; }
 
+	/**
+	 * @brief Returns the amount of heap memory held by the matrix in bytes
+	 * @return Memory footprint in bytes
+	 */
+	inline std::size_t memoryFootprint() const CADET_NOEXCEPT { return _capacity * sizeof(double); }
+
 	/**
 	 * @brief Returns the number of elements in a row
 	 * @return Number of elements in a row
@@ -819,8 +906,11 @@ public:
 		unsigned int numRows, unsigned int numCols, double alpha, double beta, double* const y) const;
 
 	/**
-	 * @brief Multiplies the matrix @f$ A @f$ with a given vector @f$ x @f$ and adds it to another vector using LAPACK
+	 * @brief Multiplies the matrix @f$ A @f$ with a given vector @f$ x @f$ and adds it to another vector
 	 * @details Computes @f$ y = \alpha Ax + \beta y@f$, where @f$ A @f$ is this matrix and @f$ x @f$ is given.
+	 *          Uses a cache-blocked kernel that traverses each block of rows diagonal by
+	 *          diagonal, which gives unit stride access to @f$ x @f$ and the accumulator
+	 *          in the innermost loop (i.e., the loop vectorizes).
 	 * @param [in] x Vector this matrix is multiplied with
 	 * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ Ax @f$
 	 * @param [in] beta Factor @f$ \beta @f$ in front of @f$ y @f$
@@ -828,11 +918,49 @@ public:
 	 */
 	void multiplyVector(const double* const x, double alpha, double beta, double* const y) const;
 
+	/**
+	 * @brief Multiplies the transpose of the matrix @f$ A @f$ with a given vector @f$ x @f$
+	 * @details Computes @f$ y = A^T x @f$, where @f$ A @f$ is this matrix and @f$ x @f$ is given.
+	 * @param [in] x Vector the transposed matrix is multiplied with
+	 * @param [out] y Result of the transposed matrix-vector multiplication
+	 */
+	inline void transposedMultiplyVector(const double* const x, double* const y) const
+	{
+		transposedMultiplyVector(x, 1.0, 0.0, y);
+	}
+
+	/**
+	 * @brief Multiplies the transpose of the matrix @f$ A @f$ with a given vector @f$ x @f$ and adds it to another vector
+	 * @details Computes @f$ y = \alpha A^T x + \beta y @f$, where @f$ A @f$ is this matrix and @f$ x @f$ is given.
+	 *          The transpose of a banded matrix is again banded with lower and upper bandwidth
+	 *          exchanged, so the operation runs over the band storage without forming the transpose.
+	 * @param [in] x Vector the transposed matrix is multiplied with
+	 * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ A^T x @f$
+	 * @param [in] beta Factor @f$ \beta @f$ in front of @f$ y @f$
+	 * @param [out] y Result of the transposed matrix-vector multiplication
+	 */
+	void transposedMultiplyVector(const double* const x, double alpha, double beta, double* const y) const;
+
+	/**
+	 * @brief Multiplies the matrix @f$ A @f$ with a panel of vectors @f$ x_i @f$ and adds it to other vectors
+	 * @details Computes @f$ y_i = \alpha A x_i + \beta y_i @f$ for all vectors of the panel.
+	 *          The band storage is swept a single time and each row is applied to all vectors
+	 *          while it is in cache, which is faster than calling multiplyVector() once per
+	 *          vector if the panel is large (e.g., many parameter sensitivities).
+	 * @param [in] x Array of @p numVectors pointers to the vectors this matrix is multiplied with
+	 * @param [in] numVectors Number of vectors in the panel
+	 * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ Ax_i @f$
+	 * @param [in] beta Factor @f$ \beta @f$ in front of @f$ y_i @f$
+	 * @param [out] y Array of @p numVectors pointers to the result vectors
+	 */
+	void multiplyVectors(double const* const* x, unsigned int numVectors, double alpha, double beta, double* const* y) const;
+
 protected:
 	double* _data; //!< Pointer to the array in which the matrix is stored
 	unsigned int _lowerBand; //!< Lower bandwidth excluding main diagonal
 	unsigned int _upperBand; //!< Upper bandwidth excluding main diagonal
 	unsigned int _rows; //!< Number of rows
+	unsigned int _capacity; //!< Size of the allocated array in number of elements
 
 	/**
 	 * @brief Returns the number of true elements in a row (same as stride())
@@ -886,22 +1014,26 @@ public:
 	 * @brief Creates an empty, unitialized band matrix
 	 * @details No memory is allocated for the matrix. Users have to call resize() first.
 	 */
-	FactorizableBandMatrix() CADET_NOEXCEPT : _data(nullptr), _lowerBand(0), _upperBand(0), _rows(0), _capacity(0), _pivot(nullptr) { }
+	FactorizableBandMatrix() CADET_NOEXCEPT : _data(nullptr), _lowerBand(0), _upperBand(0), _rows(0), _capacity(0), _pivot(nullptr), _singleAnorm(0.0), _mixedFactorized(false) { }
 	~FactorizableBandMatrix() CADET_NOEXCEPT
 	{
 		delete[] _pivot;
-		delete[] _data;
+		detail::alignedDoubleFree(_data);
 	}
 
-	FactorizableBandMatrix(const FactorizableBandMatrix& cpy) : _data(new double[cpy.stride() * cpy._rows]),
-		_lowerBand(cpy._lowerBand), _upperBand(cpy._upperBand), _rows(cpy._rows), _capacity(cpy._capacity), _pivot(new lapackInt_t[cpy._rows])
+	FactorizableBandMatrix(const FactorizableBandMatrix& cpy) : _data(detail::alignedDoubleAlloc(cpy.stride() * cpy._rows)),
+		_lowerBand(cpy._lowerBand), _upperBand(cpy._upperBand), _rows(cpy._rows), _capacity(cpy._capacity), _pivot(new lapackInt_t[cpy._rows]),
+		_singleData(cpy._singleData), _singleWork(cpy._singleWork), _refineRhs(cpy._refineRhs), _refineRes(cpy._refineRes),
+		_singleAnorm(cpy._singleAnorm), _mixedFactorized(cpy._mixedFactorized)
 	{
 		copyValues(cpy._data);
 		copyPivot(cpy._pivot);
 	}
 
 	FactorizableBandMatrix(FactorizableBandMatrix&& cpy) CADET_NOEXCEPT : _data(cpy._data), _lowerBand(cpy._lowerBand), _upperBand(cpy._upperBand),
-		_rows(cpy._rows), _capacity(cpy._capacity), _pivot(cpy._pivot)
+		_rows(cpy._rows), _capacity(cpy._capacity), _pivot(cpy._pivot),
+		_singleData(std::move(cpy._singleData)), _singleWork(std::move(cpy._singleWork)), _refineRhs(std::move(cpy._refineRhs)),
+		_refineRes(std::move(cpy._refineRes)), _singleAnorm(cpy._singleAnorm), _mixedFactorized(cpy._mixedFactorized)
 	{
 		cpy._data = nullptr;
 		cpy._pivot = nullptr;
@@ -922,14 +1054,21 @@ public:
 		_rows = cpy._rows;
 		_capacity = cpy._capacity;
 
-		delete[] _data;
-		_data = new double[_capacity];
+		detail::alignedDoubleFree(_data);
+		_data = detail::alignedDoubleAlloc(_capacity);
 		copyValues(cpy._data);
 
 		delete[] _pivot;
 		_pivot = new lapackInt_t[_rows];
 		copyPivot(cpy._pivot);
 
+		_singleData = cpy._singleData;
+		_singleWork = cpy._singleWork;
+		_refineRhs = cpy._refineRhs;
+		_refineRes = cpy._refineRes;
+		_singleAnorm = cpy._singleAnorm;
+		_mixedFactorized = cpy._mixedFactorized;
+
 		return *this;
 	}
 
@@ -940,7 +1079,7 @@ public:
 		_rows = cpy._rows;
 		_capacity = cpy._capacity;
 
-		delete[] _data;
+		detail::alignedDoubleFree(_data);
 		_data = cpy._data;
 		cpy._data = nullptr;
 
@@ -948,6 +1087,13 @@ public:
 		_pivot = cpy._pivot;
 		cpy._pivot = nullptr;
 
+		_singleData = std::move(cpy._singleData);
+		_singleWork = std::move(cpy._singleWork);
+		_refineRhs = std::move(cpy._refineRhs);
+		_refineRes = std::move(cpy._refineRes);
+		_singleAnorm = cpy._singleAnorm;
+		_mixedFactorized = cpy._mixedFactorized;
+
 		return *this;
 	}
 
@@ -987,20 +1133,47 @@ public:
 			_upperBand = upperBand;
 			_capacity = stride() * _rows;
 
-			delete[] _data;
-			_data = new double[_capacity];
-			setAll(0.0);
+			detail::alignedDoubleFree(_data);
+			_data = detail::alignedDoubleAlloc(_capacity);
+			detail::firstTouchFill(_data, _capacity);
 
 			delete[] _pivot;
 			_pivot = new lapackInt_t[_rows];
 		}
 	}
 
+	/**
+	 * @brief Ensures enough capacity for a matrix of the given size without changing the layout
+	 * @details Grows the allocated memory such that subsequent resize() and repartition() calls
+	 *          within the given limits are guaranteed to reuse the existing memory. The logical
+	 *          size and partitioning of the matrix are not changed, but all data is lost if
+	 *          memory has to be allocated. Reserve for the widest required bandwidth up front
+	 *          (e.g., the largest WENO order of all time sections) so that later bandwidth
+	 *          switches never allocate and the factorization kernels operate on the narrower
+	 *          logical band immediately.
+	 *
+	 * @param [in] rows Number of rows
+	 * @param [in] lowerBand Number of lower diagonals (excluding the main diagonal)
+	 * @param [in] upperBand Number of upper diagonals (excluding the main diagonal)
+	 */
+	inline void reserve(unsigned int rows, unsigned int lowerBand, unsigned int upperBand)
+	{
+		const unsigned int cap = rows * stride(lowerBand, upperBand);
+		if (cadet_likely(cap <= _capacity))
+			return;
+
+		_capacity = cap;
+
+		detail::alignedDoubleFree(_data);
+		_data = detail::alignedDoubleAlloc(_capacity);
+		detail::firstTouchFill(_data, _capacity);
+	}
+
 	/**
 	 * @brief Repartitions the matrix by changing lower and upper bandwidth
 	 * @details There has to be enough capacity for the new matrix size. Use resize() if the capacity is too small.
 	 *          Note that the data is not reset to @c 0.0 by this operation.
-	 *          
+	 *
 	 * @param [in] lowerBand Number of lower diagonals (excluding the main diagonal)
 	 * @param [in] upperBand Number of upper diagonals (excluding the main diagonal)
 	 */
@@ -1024,8 +1197,8 @@ public:
 		_upperBand = bdm.upperBandwidth();
 		_capacity = stride() * _rows;
 
-		delete[] _data;
-		_data = new double[_capacity];
+		detail::alignedDoubleFree(_data);
+		_data = detail::alignedDoubleAlloc(_capacity);
 
 		// Copy data over and take into account that the local storage is larger
 		copyOver(bdm);
@@ -1154,6 +1327,19 @@ public:
 	inline lapackInt_t* pivot() CADET_NOEXCEPT { return _pivot; }
 	inline lapackInt_t const* pivot() const CADET_NOEXCEPT { return _pivot; }
 
+	/**
+	 * @brief Returns the amount of heap memory held by the matrix in bytes
+	 * @details Covers the matrix storage, the pivot array, and the workspaces of the
+	 *          mixed precision factorization (if used).
+	 * @return Memory footprint in bytes
+	 */
+	inline std::size_t memoryFootprint() const CADET_NOEXCEPT
+	{
+		return _capacity * sizeof(double) + _rows * sizeof(lapackInt_t)
+			+ (_singleData.capacity() + _singleWork.capacity()) * sizeof(float)
+			+ (_refineRhs.capacity() + _refineRes.capacity()) * sizeof(double);
+	}
+
 	/**
 	 * @brief Returns the total number of elements in a row including additional storage for factorization
 	 * @return Total number of elements in a row
@@ -1213,19 +1399,78 @@ public:
 	void multiplyVector(const double* const x, double alpha, double beta, double* const y) const;
 
 	/**
-	 * @brief Factorizes the BandMatrix using LAPACK (performs LU factorization)
+	 * @brief Factorizes the BandMatrix (performs LU factorization)
+	 * @details Narrow bands are factorized with LAPACK. Wide bands use a native blocked
+	 *          LU whose trailing-submatrix updates are threaded if parallelization is
+	 *          enabled. Tiny bands (lower and upper bandwidth at most 3, e.g., the tri-
+	 *          and pentadiagonal column blocks of low WENO orders) use fully unrolled
+	 *          compile-time specializations. All paths produce an identical
+	 *          factorization layout.
 	 * @return @c true if the factorization was successful, otherwise @c false
 	 */
 	bool factorize();
 
 	/**
-	 * @brief Uses the factorized matrix to solve the equation @f$ Ax = b @f$ with LAPACK
-	 * @details Before the equation can be solved, the matrix has to be factorized first by calling factorize().
+	 * @brief Factorizes the leading principal submatrix (performs LU factorization)
+	 * @details Same as factorize(), but only the leading @p rows rows and columns take part
+	 *          in the factorization. The trailing rows and the corresponding pivot entries
+	 *          are left untouched. Use the matching solve() overload for such a partial
+	 *          factorization. This is useful when trailing unknowns of the block are known
+	 *          to be inactive (e.g., frozen converged particle shells).
+	 * @param [in] rows Number of leading rows to factorize (at most rows())
+	 * @return @c true if the factorization was successful, otherwise @c false
+	 */
+	bool factorize(unsigned int rows);
+
+	/**
+	 * @brief Uses the factorized matrix to solve the equation @f$ Ax = b @f$
+	 * @details Before the equation can be solved, the matrix has to be factorized first by
+	 *          calling factorize(). Tiny bands are solved with fully unrolled compile-time
+	 *          specializations, all other bandwidths with LAPACK.
 	 * @param [in,out] rhs On entry pointer to the right hand side vector @f$ b @f$ of the equation, on exit the solution @f$ x @f$
 	 * @return @c true if the solution process was successful, otherwise @c false
 	 */
 	bool solve(double* rhs) const;
 
+	/**
+	 * @brief Solves the equation @f$ Ax = b @f$ restricted to the leading principal submatrix
+	 * @details The matrix has to be factorized with the factorize() overload using the same
+	 *          number of @p rows first. Only the leading @p rows entries of @p rhs are read
+	 *          and overwritten with the solution; the trailing entries are left untouched.
+	 * @param [in] rows Number of leading rows the matrix was factorized with
+	 * @param [in,out] rhs On entry pointer to the right hand side vector @f$ b @f$ of the equation, on exit the solution @f$ x @f$
+	 * @return @c true if the solution process was successful, otherwise @c false
+	 */
+	bool solve(unsigned int rows, double* rhs) const;
+
+	/**
+	 * @brief Factorizes a single precision copy of the BandMatrix (performs LU factorization)
+	 * @details The matrix itself is left untouched, so that it can be used for computing
+	 *          residuals in the double precision iterative refinement performed by
+	 *          solveMixedPrecision(). The single precision factorization halves the memory
+	 *          traffic and doubles the SIMD width of the factorization, which pays off for
+	 *          well-conditioned (e.g., diagonally dominant) matrices. If the single
+	 *          precision factorization encounters a singular matrix, the method
+	 *          automatically falls back to factorize().
+	 * @return @c true if the factorization was successful, otherwise @c false
+	 */
+	bool factorizeMixedPrecision();
+
+	/**
+	 * @brief Uses the mixed precision factorized matrix to solve the equation @f$ Ax = b @f$
+	 * @details The equation is solved with the single precision factorization computed by
+	 *          factorizeMixedPrecision() and the solution is refined to double precision
+	 *          accuracy by iterative refinement on the unmodified double precision matrix.
+	 *          If the refinement does not converge (e.g., because the matrix is too ill
+	 *          conditioned for single precision), the matrix is refactorized in double
+	 *          precision and the solve is repeated, so the result is always usable.
+	 *          If factorize() was called instead of factorizeMixedPrecision(), the method
+	 *          simply forwards to solve().
+	 * @param [in,out] rhs On entry pointer to the right hand side vector @f$ b @f$ of the equation, on exit the solution @f$ x @f$
+	 * @return @c true if the solution process was successful, otherwise @c false
+	 */
+	bool solveMixedPrecision(double* rhs);
+
 protected:
 	double* _data; //!< Pointer to the array in which the matrix is stored
 	unsigned int _lowerBand; //!< Lower bandwidth excluding main diagonal
@@ -1234,6 +1479,21 @@ protected:
 	unsigned int _capacity; //!< Allocated memory in sizeof(double)
 	lapackInt_t* _pivot; //!< Pointer to an array which is used for pivoting by factorization methods
 
+	std::vector<float> _singleData; //!< Single precision copy of the matrix holding the mixed precision factorization
+	std::vector<float> _singleWork; //!< Single precision workspace for right hand sides of the mixed precision solves
+	std::vector<double> _refineRhs; //!< Copy of the right hand side used for computing residuals in iterative refinement
+	std::vector<double> _refineRes; //!< Residual vector workspace for iterative refinement
+	double _singleAnorm; //!< Row sum norm of the matrix, used in the convergence test of iterative refinement
+	bool _mixedFactorized; //!< Determines whether a valid mixed precision factorization is available
+
+	/**
+	 * @brief Solves the equation @f$ Ax = b @f$ with the single precision factorization
+	 * @param [in] rhs Right hand side vector @f$ b @f$ of the equation
+	 * @param [out] sol Solution @f$ x @f$, may alias @p rhs
+	 * @return @c true if the solution process was successful, otherwise @c false
+	 */
+	bool solveSinglePrecision(double const* rhs, double* sol);
+
 	/**
 	 * @brief Returns the total number of elements in a row including additional storage for factorization
 	 * @param [in] lowerBand Number of lower diagonals (excluding the main diagonal)
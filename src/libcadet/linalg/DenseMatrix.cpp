@@ -12,6 +12,7 @@
 
 #include "linalg/DenseMatrix.hpp"
 #include <cmath>
+#include <utility>
 
 namespace cadet
 {
@@ -149,10 +150,184 @@ void DenseMatrixBase::transposedSubmatrixMultiplyVector(const double* const x, u
 	LapackMultiplyDense(trans, &m, &n, &alpha, data, &lda, const_cast<double*>(x), &inc, &beta, const_cast<double*>(y), &inc);
 }
 
+namespace
+{
+	/**
+	 * @brief Maximum matrix dimension handled by the inline factorization and solution kernels
+	 * @details The matrices of the per-cell systems (e.g., one bound state block of a column cell)
+	 *          are so small that the dispatch overhead of a LAPACK call exceeds the actual compute.
+	 *          Systems up to this dimension are processed by the inline kernels below, bigger
+	 *          systems are handed to LAPACK.
+	 */
+	const int denseSmallMatrixThreshold = 40;
+
+	/**
+	 * @brief Performs an unblocked LU factorization with partial pivoting on a small matrix
+	 * @details The matrix is factorized in LAPACK's transposed view (see class description of
+	 *          DenseMatrixBase), in which column @c j is the contiguous range starting at
+	 *          @c data[j*stride]. The algorithm replicates LAPACK's dgetf2 including the
+	 *          1-based pivot format, so the produced factorization is interchangeable with
+	 *          one computed by LAPACK.
+	 * @param [in,out] data Pointer to matrix data, overwritten with the factorization
+	 * @param [out] pivot Array of (at least) size @p dynDim receiving the pivot indices
+	 * @param [in] stride Distance between two rows of the matrix
+	 * @param [in] dynDim Dimension of the matrix if @p N is @c 0, ignored otherwise
+	 * @tparam N Compile time dimension of the matrix, or @c 0 if the dimension is only known at runtime
+	 * @return @c true if the factorization was successful, otherwise @c false
+	 */
+	template <int N>
+	inline bool denseLuFactorizeSmall(double* const data, lapackInt_t* const pivot, const int stride, const int dynDim)
+	{
+		// A fixed trip count (N > 0) lets the compiler fully unroll and vectorize the loops
+		const int n = (N > 0) ? N : dynDim;
+
+		bool singular = false;
+		for (int j = 0; j < n; ++j)
+		{
+			double* const colJ = data + j * stride;
+
+			// Find pivot element in the contiguous column j
+			int jp = j;
+			double maxVal = std::abs(colJ[j]);
+			for (int i = j + 1; i < n; ++i)
+			{
+				const double curVal = std::abs(colJ[i]);
+				if (curVal > maxVal)
+				{
+					maxVal = curVal;
+					jp = i;
+				}
+			}
+
+			// LAPACK uses 1-based indices
+			pivot[j] = jp + 1;
+
+			if (colJ[jp] != 0.0)
+			{
+				// Swap rows j and jp of the transposed view, which are strided in memory
+				if (jp != j)
+				{
+					for (int k = 0; k < n; ++k)
+						std::swap(data[k * stride + j], data[k * stride + jp]);
+				}
+
+				// Compute multipliers
+				const double invPivot = 1.0 / colJ[j];
+				for (int i = j + 1; i < n; ++i)
+					colJ[i] *= invPivot;
+			}
+			else
+				singular = true;
+
+			// Rank-1 update of the trailing submatrix, one contiguous column at a time
+			for (int k = j + 1; k < n; ++k)
+			{
+				double* const colK = data + k * stride;
+				const double mult = colK[j];
+				for (int i = j + 1; i < n; ++i)
+					colK[i] -= mult * colJ[i];
+			}
+		}
+
+		return !singular;
+	}
+
+	/**
+	 * @brief Solves a small linear system using a factorization computed by denseLuFactorizeSmall()
+	 * @details Solving the original system corresponds to solving the transposed system in
+	 *          LAPACK's view, which consists of a forward substitution with the transposed
+	 *          upper triangular factor, a backward substitution with the transposed unit lower
+	 *          triangular factor, and undoing the row interchanges. Both triangular sweeps
+	 *          run over contiguous rows of the row-major storage.
+	 * @param [in] data Pointer to factorized matrix data
+	 * @param [in] pivot Pivot indices of the factorization
+	 * @param [in] stride Distance between two rows of the matrix
+	 * @param [in] dynDim Dimension of the matrix if @p N is @c 0, ignored otherwise
+	 * @param [in,out] rhs On entry the right hand side, on exit the solution
+	 * @tparam N Compile time dimension of the matrix, or @c 0 if the dimension is only known at runtime
+	 */
+	template <int N>
+	inline void denseLuSolveSmall(double const* const data, lapackInt_t const* const pivot, const int stride, const int dynDim, double* const rhs)
+	{
+		const int n = (N > 0) ? N : dynDim;
+
+		// Forward substitution with the transposed upper triangular factor (non-unit diagonal)
+		for (int i = 0; i < n; ++i)
+		{
+			double const* const row = data + i * stride;
+			double sum = rhs[i];
+			for (int j = 0; j < i; ++j)
+				sum -= row[j] * rhs[j];
+			rhs[i] = sum / row[i];
+		}
+
+		// Backward substitution with the transposed unit lower triangular factor
+		for (int i = n - 1; i >= 0; --i)
+		{
+			double const* const row = data + i * stride;
+			double sum = rhs[i];
+			for (int j = i + 1; j < n; ++j)
+				sum -= row[j] * rhs[j];
+			rhs[i] = sum;
+		}
+
+		// Undo the row interchanges in reverse order
+		for (int j = n - 1; j >= 0; --j)
+		{
+			const int jp = pivot[j] - 1;
+			if (jp != j)
+				std::swap(rhs[j], rhs[jp]);
+		}
+	}
+
+	/**
+	 * @brief Factorizes a small matrix dispatching to a fixed-size kernel for the most common dimensions
+	 */
+	inline bool denseLuFactorize(double* const data, lapackInt_t* const pivot, const int stride, const int n)
+	{
+		switch (n)
+		{
+			case 1: return denseLuFactorizeSmall<1>(data, pivot, stride, n);
+			case 2: return denseLuFactorizeSmall<2>(data, pivot, stride, n);
+			case 3: return denseLuFactorizeSmall<3>(data, pivot, stride, n);
+			case 4: return denseLuFactorizeSmall<4>(data, pivot, stride, n);
+			case 5: return denseLuFactorizeSmall<5>(data, pivot, stride, n);
+			case 6: return denseLuFactorizeSmall<6>(data, pivot, stride, n);
+			case 7: return denseLuFactorizeSmall<7>(data, pivot, stride, n);
+			case 8: return denseLuFactorizeSmall<8>(data, pivot, stride, n);
+		}
+		return denseLuFactorizeSmall<0>(data, pivot, stride, n);
+	}
+
+	/**
+	 * @brief Solves a small system dispatching to a fixed-size kernel for the most common dimensions
+	 */
+	inline void denseLuSolve(double const* const data, lapackInt_t const* const pivot, const int stride, const int n, double* const rhs)
+	{
+		switch (n)
+		{
+			case 1: return denseLuSolveSmall<1>(data, pivot, stride, n, rhs);
+			case 2: return denseLuSolveSmall<2>(data, pivot, stride, n, rhs);
+			case 3: return denseLuSolveSmall<3>(data, pivot, stride, n, rhs);
+			case 4: return denseLuSolveSmall<4>(data, pivot, stride, n, rhs);
+			case 5: return denseLuSolveSmall<5>(data, pivot, stride, n, rhs);
+			case 6: return denseLuSolveSmall<6>(data, pivot, stride, n, rhs);
+			case 7: return denseLuSolveSmall<7>(data, pivot, stride, n, rhs);
+			case 8: return denseLuSolveSmall<8>(data, pivot, stride, n, rhs);
+		}
+		return denseLuSolveSmall<0>(data, pivot, stride, n, rhs);
+	}
+}
+
 bool DenseMatrixBase::factorize()
 {
 	cadet_assert(_rows == _cols);
 
+	// Tiny systems are factorized by the inline kernels since the LAPACK call
+	// dispatch overhead exceeds the actual compute for these dimensions
+	if (static_cast<int>(_rows) <= denseSmallMatrixThreshold)
+		return denseLuFactorize(_data, _pivot, stride(), _rows);
+
 	// Since LAPACK uses column-major storage and we use row-major,
 	// we actually have constructed the transposed matrix. However,
 	// this is irrelevant for factorization.
@@ -171,6 +346,14 @@ bool DenseMatrixBase::solve(double* rhs) const
 {
 	cadet_assert(_rows == _cols);
 
+	// Since the inline kernels replicate LAPACK's factorization exactly, the
+	// solution kernel works no matter which path performed the factorization
+	if (static_cast<int>(_rows) <= denseSmallMatrixThreshold)
+	{
+		denseLuSolve(_data, _pivot, stride(), _rows, rhs);
+		return true;
+	}
+
 	// Since LAPACK uses column-major storage and we use row-major,
 	// we actually have constructed the transposed matrix.
 	lapackInt_t n = _rows;
@@ -349,6 +532,17 @@ std::ostream& operator<<(std::ostream& out, const DenseMatrixBase& bm)
 
 }  // namespace detail
 
+bool batchedFactorizeSolve(DenseMatrixView* const systems, double* const* const rhs, unsigned int numSystems)
+{
+	bool success = true;
+	for (unsigned int i = 0; i < numSystems; ++i)
+	{
+		success = systems[i].factorize() && success;
+		success = systems[i].solve(rhs[i]) && success;
+	}
+	return success;
+}
+
 }  // namespace linalg
 
 }  // namespace cadet
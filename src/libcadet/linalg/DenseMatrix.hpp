@@ -24,6 +24,7 @@
 
 #include <ostream>
 #include <algorithm>
+#include <cstddef>
 
 namespace cadet
 {
@@ -297,6 +298,13 @@ namespace detail
 		inline double* data() CADET_NOEXCEPT { return _data; }
 		inline double const* data() const CADET_NOEXCEPT { return _data; }
 
+		/**
+		 * @brief Provides direct access to the pivot array used by the factorization
+		 * @return Pointer to the first element of the pivot array
+		 */
+		inline lapackInt_t* pivot() CADET_NOEXCEPT { return _pivot; }
+		inline lapackInt_t const* pivot() const CADET_NOEXCEPT { return _pivot; }
+
 		/**
 		 * @brief Returns the number of elements in an array row
 		 * @return Number of elements in a matrix row
@@ -798,6 +806,16 @@ public:
 
 		setAll(0.0);
 	}
+
+	/**
+	 * @brief Returns the amount of heap memory held by the matrix in bytes
+	 * @details Covers the matrix storage and the pivot array.
+	 * @return Memory footprint in bytes
+	 */
+	inline std::size_t memoryFootprint() const CADET_NOEXCEPT
+	{
+		return stride() * _rows * sizeof(double) + std::min(_rows, _cols) * sizeof(lapackInt_t);
+	}
 };
 
 
@@ -896,6 +914,19 @@ public:
 	}
 };
 
+/**
+ * @brief Factorizes and solves a batch of small independent square systems in one call
+ * @details All systems are processed back to back by the inline small-matrix kernels,
+ *          which avoids the per-system LAPACK dispatch overhead that would be incurred
+ *          by solving the tiny per-cell systems one at a time. The matrices are
+ *          overwritten with their LU factorization.
+ * @param [in,out] systems Array of @p numSystems square matrices which are factorized in place
+ * @param [in,out] rhs Array of @p numSystems pointers to the right hand sides, overwritten with the solutions
+ * @param [in] numSystems Number of systems in the batch
+ * @return @c true if all systems were solved successfully, otherwise @c false
+ */
+bool batchedFactorizeSolve(DenseMatrixView* systems, double* const* rhs, unsigned int numSystems);
+
 } // namespace linalg
 
 } // namespace cadet
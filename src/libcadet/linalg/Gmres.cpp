@@ -17,6 +17,8 @@
 #include "SundialsVector.hpp"
 
 #include <type_traits>
+#include <algorithm>
+#include <cmath>
 
 namespace cadet
 {
@@ -32,7 +34,16 @@ int gmresCallback(void* userData, N_Vector v, N_Vector z)
 	return callback(g->userData(), NVEC_DATA(v), NVEC_DATA(z));
 }
 
-Gmres::Gmres() CADET_NOEXCEPT : _mem(nullptr), _ortho(Orthogonalization::ModifiedGramSchmidt), _maxRestarts(0), _matrixSize(0), _matVecMul(nullptr), _userData(nullptr)
+// Wrapper function that calls the user preconditioner with the supplied user data
+int gmresPrecondCallback(void* userData, N_Vector r, N_Vector z, int lr)
+{
+	Gmres* const g = static_cast<Gmres*>(userData);
+	Gmres::PreconditionerSolveFun callback = g->preconditioner();
+	return callback(g->userData(), NVEC_DATA(r), NVEC_DATA(z));
+}
+
+Gmres::Gmres() CADET_NOEXCEPT : _mem(nullptr), _ortho(Orthogonalization::ModifiedGramSchmidt), _maxRestarts(0), _matrixSize(0), _maxKrylov(0), _matVecMul(nullptr),
+	_precSolve(nullptr), _precSide(PreconditionerSide::None), _userData(nullptr), _lastNumIter(0), _totalNumIter(0), _maxRecycle(0), _numRecycled(0), _nextRecycleSlot(0)
 {
 }
 
@@ -49,13 +60,28 @@ void Gmres::initialize(unsigned int matrixSize, unsigned int maxKrylov)
 
 void Gmres::initialize(unsigned int matrixSize, unsigned int maxKrylov, Orthogonalization om, unsigned int maxRestarts)
 {
-	_matrixSize = matrixSize;
 	if (maxKrylov == 0)
-		maxKrylov = _matrixSize;
+		maxKrylov = matrixSize;
 
 	_maxRestarts = maxRestarts;
 	_ortho = om;
 
+	// Reuse the existing workspace if the problem size has not changed; only the
+	// settings are updated then (avoids reallocating maxKrylov state-sized vectors
+	// on every reconfiguration)
+	if (_mem && (matrixSize == _matrixSize) && (maxKrylov == _maxKrylov))
+		return;
+
+	_matrixSize = matrixSize;
+	_maxKrylov = maxKrylov;
+
+	// Release an old workspace of different size
+	if (_mem)
+	{
+		SpgmrFree(_mem);
+		_mem = nullptr;
+	}
+
 	// Create a template vector for the malloc routine of SPGMR
 	N_Vector NV_tmpl = NVec_New(matrixSize);
 	NVec_Const(0.0, NV_tmpl);
@@ -64,10 +90,130 @@ void Gmres::initialize(unsigned int matrixSize, unsigned int maxKrylov, Orthogon
 	_mem = SpgmrMalloc(maxKrylov, NV_tmpl);
 
 	NVec_Destroy(NV_tmpl);
+
+	// Update recycle space storage in case recycleSubspace() was called before initialize()
+	if (_maxRecycle > 0)
+		recycleSubspace(_maxRecycle);
+}
+
+void Gmres::recycleSubspace(unsigned int maxVectors)
+{
+	_maxRecycle = maxVectors;
+	clearRecycleSpace();
+
+	if ((_maxRecycle == 0) || (_matrixSize == 0))
+		return;
+
+	_recycleU.resize(_maxRecycle * _matrixSize);
+	_recycleC.resize(_maxRecycle * _matrixSize);
+	_recycleTmp.resize(_matrixSize);
+	_recycleGuess.resize(_matrixSize);
+}
+
+/**
+ * @brief Projects the initial guess onto the recycle space
+ * @details Computes the initial residual @f$ r_0 = b - A x_0 @f$ and updates the guess
+ *          @f$ x_0 \leftarrow x_0 + \sum_i \left( c_i^T r_0 \right) u_i @f$ with the
+ *          stored directions @f$ u_i @f$ and their orthonormalized images @f$ c_i = A u_i @f$.
+ *          This is the outer (Galerkin) projection of GCRO and removes the recycled
+ *          spectral components from the initial residual before the Krylov iteration starts.
+ * @param [in] rhs Right hand side vector @f$ b @f$
+ * @param [in,out] sol On entry the initial guess, on exit the projected initial guess
+ */
+void Gmres::projectOntoRecycleSpace(double const* rhs, double* sol)
+{
+	// Compute initial residual r_0 = b - A x_0
+	double* const r = _recycleTmp.data();
+	_matVecMul(_userData, sol, r);
+	for (unsigned int i = 0; i < _matrixSize; ++i)
+		r[i] = rhs[i] - r[i];
+
+	for (unsigned int j = 0; j < _numRecycled; ++j)
+	{
+		double const* const u = _recycleU.data() + j * _matrixSize;
+		double const* const c = _recycleC.data() + j * _matrixSize;
+
+		double beta = 0.0;
+		for (unsigned int i = 0; i < _matrixSize; ++i)
+			beta += c[i] * r[i];
+
+		for (unsigned int i = 0; i < _matrixSize; ++i)
+		{
+			sol[i] += beta * u[i];
+			r[i] -= beta * c[i];
+		}
+	}
+}
+
+/**
+ * @brief Adds the correction computed by the last solve to the recycle space
+ * @details The correction @f$ d = x - x_0 @f$ is orthonormalized (with respect to its
+ *          image @f$ A d @f$) against the stored directions and replaces the oldest
+ *          direction if the recycle space is full.
+ * @param [in] guess Projected initial guess @f$ x_0 @f$ the solve was started from
+ * @param [in] sol Solution @f$ x @f$ returned by the solve
+ */
+void Gmres::harvestRecycleDirection(double const* guess, double const* sol)
+{
+	double* const u = _recycleU.data() + _nextRecycleSlot * _matrixSize;
+	double* const c = _recycleC.data() + _nextRecycleSlot * _matrixSize;
+
+	for (unsigned int i = 0; i < _matrixSize; ++i)
+		u[i] = sol[i] - guess[i];
+
+	// Compute the image c = A d of the new direction
+	_matVecMul(_userData, u, c);
+
+	// Orthogonalize the image against the stored directions (modified Gram-Schmidt)
+	for (unsigned int j = 0; j < _numRecycled; ++j)
+	{
+		if (j == _nextRecycleSlot)
+			continue;
+
+		double const* const uOld = _recycleU.data() + j * _matrixSize;
+		double const* const cOld = _recycleC.data() + j * _matrixSize;
+
+		double beta = 0.0;
+		for (unsigned int i = 0; i < _matrixSize; ++i)
+			beta += cOld[i] * c[i];
+
+		for (unsigned int i = 0; i < _matrixSize; ++i)
+		{
+			c[i] -= beta * cOld[i];
+			u[i] -= beta * uOld[i];
+		}
+	}
+
+	double norm = 0.0;
+	for (unsigned int i = 0; i < _matrixSize; ++i)
+		norm += c[i] * c[i];
+	norm = std::sqrt(norm);
+
+	// Discard (numerically) linearly dependent directions
+	if (norm <= 1e-13)
+		return;
+
+	const double invNorm = 1.0 / norm;
+	for (unsigned int i = 0; i < _matrixSize; ++i)
+	{
+		c[i] *= invNorm;
+		u[i] *= invNorm;
+	}
+
+	_numRecycled = std::min(_numRecycled + 1, _maxRecycle);
+	_nextRecycleSlot = (_nextRecycleSlot + 1) % _maxRecycle;
 }
 
 int Gmres::solve(double tolerance, double const* weight, double const* rhs, double* sol)
 {
+	// Remove recycled spectral components from the initial residual
+	if ((_maxRecycle > 0) && (_numRecycled > 0))
+		projectOntoRecycleSpace(rhs, sol);
+
+	// Remember the (projected) initial guess for harvesting a new recycle direction
+	if (_maxRecycle > 0)
+		std::copy(sol, sol + _matrixSize, _recycleGuess.begin());
+
 	// Create init-guess/solution vector by bending pointer
 	N_Vector NV_sol = NVec_NewEmpty(_matrixSize);
 	NVEC_DATA(NV_sol) = sol;
@@ -82,14 +228,22 @@ int Gmres::solve(double tolerance, double const* weight, double const* rhs, doub
 
 //	double tolerance = _cc.sqrt_neq() * IDA_mem->ida_epsNewt * _schurSafety;
 
-	const int gsType = static_cast<typename std::underlying_type<Orthogonalization>::type>(_ortho);
+	// Map the method to the SUNDIALS constants (the enum values do not coincide
+	// with them). Classical Gram-Schmidt in SUNDIALS batches the dot products of
+	// a new Krylov vector against the whole stored basis into one sweep and
+	// re-orthogonalizes when cancellation is detected, so it also implements the
+	// iterated classical variant.
+	const int gsType = (_ortho == Orthogonalization::ModifiedGramSchmidt) ? MODIFIED_GS : CLASSICAL_GS;
 	int nIter = 0;
 	int nPrecondSolve = 0;
 	double resNorm = -1.0;
 
+	const bool usePrec = _precSolve && (_precSide != PreconditionerSide::None);
+	const int precType = usePrec ? ((_precSide == PreconditionerSide::Left) ? PREC_LEFT : PREC_RIGHT) : PREC_NONE;
+
 	const int flag = SpgmrSolve(_mem, this, NV_sol, NV_rhs,
-			PREC_NONE, gsType, tolerance, _maxRestarts, NULL,
-			NV_weight, NV_weight, &gmresCallback, NULL, 
+			precType, gsType, tolerance, _maxRestarts, usePrec ? this : NULL,
+			NV_weight, NV_weight, &gmresCallback, usePrec ? &gmresPrecondCallback : NULL,
 			&resNorm, &nIter, &nPrecondSolve);
 
 	// Free NVector memory space
@@ -97,6 +251,13 @@ int Gmres::solve(double tolerance, double const* weight, double const* rhs, doub
 	NVec_Destroy(NV_weight);
 	NVec_Destroy(NV_sol);
 
+	_lastNumIter = static_cast<unsigned int>(nIter);
+	_totalNumIter += _lastNumIter;
+
+	// Keep the computed correction for subsequent solves with the same matrix
+	if ((_maxRecycle > 0) && ((flag == SPGMR_SUCCESS) || (flag == SPGMR_RES_REDUCED)))
+		harvestRecycleDirection(_recycleGuess.data(), sol);
+
 	return flag;
 }
 
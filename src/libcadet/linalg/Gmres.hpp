@@ -22,6 +22,7 @@
 #include "cadet/Exceptions.hpp"
 
 #include <functional>
+#include <vector>
 
 // Forward declare SUNDIALS types
 typedef struct _SpgmrMemRec SpgmrMemRec;
@@ -34,11 +35,20 @@ namespace linalg
 
 /**
  * @brief Supported orthogonalization methods
+ * @details Classical Gram-Schmidt batches all dot products of a new Krylov vector
+ *          against the stored basis into one sweep over contiguous memory, whereas
+ *          modified Gram-Schmidt interleaves dot products and updates (more stable,
+ *          but strictly serial). The iterated classical variant adds a second
+ *          orthogonalization pass when cancellation is detected, which combines the
+ *          batched sweeps with (nearly) the stability of modified Gram-Schmidt and
+ *          pays off for long restart lengths where orthogonalization cost grows
+ *          quadratically.
  */
 enum class Orthogonalization : unsigned int
 {
 	ClassicalGramSchmidt = 0,
 	ModifiedGramSchmidt = 1, 
+	IteratedClassicalGramSchmidt = 2,
 };
 
 /**
@@ -54,10 +64,22 @@ inline Orthogonalization toOrthogonalization(unsigned int ortho)
 			return Orthogonalization::ClassicalGramSchmidt;
 		case static_cast<typename std::underlying_type<Orthogonalization>::type>(Orthogonalization::ModifiedGramSchmidt):
 			return Orthogonalization::ModifiedGramSchmidt;
+		case static_cast<typename std::underlying_type<Orthogonalization>::type>(Orthogonalization::IteratedClassicalGramSchmidt):
+			return Orthogonalization::IteratedClassicalGramSchmidt;
 	}
 	throw InvalidParameterException("Unknown orthogonalization type");
 }
 
+/**
+ * @brief Side on which a preconditioner is applied
+ */
+enum class PreconditionerSide : unsigned int
+{
+	None = 0,
+	Left = 1,
+	Right = 2,
+};
+
 /**
  * @brief Implements the Generalized Minimal Residual (GMRES) method for solving the linear system @f$ Ax = b @f$
  * @details Wraps the implementation provided by SUNDIALS.
@@ -77,6 +99,17 @@ public:
  	 */
 	typedef std::function<int(void* userData, double const* x, double* z)> MatrixVectorMultFun;
 
+	/**
+ 	 * @brief Prototype of preconditioner solve function provided to GMRES algorithm
+ 	 * @details Solves the preconditioner equation @f$ Pz = r @f$.
+ 	 *
+ 	 * @param [in] userData User data
+ 	 * @param [in] r Right hand side of the preconditioner equation
+ 	 * @param [out] z Solution of the preconditioner equation (memory is provided by the caller)
+ 	 * @return @c 0 if successful, a positive value on recoverable error, and a negative value on critical failure
+ 	 */
+	typedef std::function<int(void* userData, double const* r, double* z)> PreconditionerSolveFun;
+
 	Gmres() CADET_NOEXCEPT;
 	~Gmres() CADET_NOEXCEPT;
 
@@ -90,7 +123,10 @@ public:
 
 	/**
 	 * @brief Initializes the GMRES algorithm
-	 * @details Applies settings and allocates memory.
+	 * @details Applies settings and allocates memory. If the solver is already initialized
+	 *          with the same matrix size and Krylov space dimension (e.g., on reconfiguration
+	 *          or section transitions), the existing workspace is reused and only the
+	 *          settings are updated.
 	 * @param [in] matrixSize Size of the square matrix @f$ A @f$
 	 * @param [in] maxKrylov Maximum number of stored Krylov vectors (between @c 1 and @p matrixSize)
 	 * @param [in] om Orthogonalization method used by GMRES
@@ -156,6 +192,74 @@ public:
 		_userData = ud;
 	}
 
+	/**
+	 * @brief Returns the preconditioner solve function
+	 * @return Preconditioner solve function
+	 */
+	inline PreconditionerSolveFun preconditioner() const CADET_NOEXCEPT { return _precSolve; }
+	/**
+	 * @brief Sets the preconditioner solve function
+	 * @details The preconditioner receives the same user data as the matrix-vector
+	 *          multiplication function. Pass a default constructed function or
+	 *          PreconditionerSide::None to disable preconditioning.
+	 * @param [in] ps Preconditioner solve function
+	 * @param [in] side Side on which the preconditioner is applied
+	 */
+	inline void preconditioner(PreconditionerSolveFun ps, PreconditionerSide side) CADET_NOEXCEPT
+	{
+		_precSolve = ps;
+		_precSide = side;
+	}
+
+	/**
+	 * @brief Returns the side on which the preconditioner is applied
+	 * @return Side on which the preconditioner is applied
+	 */
+	inline PreconditionerSide preconditionerSide() const CADET_NOEXCEPT { return _precSide; }
+
+	/**
+	 * @brief Enables recycling of spectral information between consecutive solves
+	 * @details After each converged solve, the computed correction is added to a recycle
+	 *          space of at most @p maxVectors directions (GCRO style, oldest direction is
+	 *          replaced first). Subsequent solves project their initial guess onto this
+	 *          space before the Krylov iteration starts, which removes the recurring
+	 *          spectral components from the initial residual. The recycle space is only
+	 *          valid as long as the matrix @f$ A @f$ does not change; call
+	 *          clearRecycleSpace() whenever it does.
+	 * @param [in] maxVectors Maximum number of recycled directions (@c 0 disables recycling)
+	 */
+	void recycleSubspace(unsigned int maxVectors);
+
+	/**
+	 * @brief Discards all recycled directions
+	 * @details Has to be called whenever the matrix @f$ A @f$ changes (e.g., on a new
+	 *          Jacobian factorization), since the recycled directions are only valid
+	 *          for the matrix they were computed with.
+	 */
+	inline void clearRecycleSpace() CADET_NOEXCEPT
+	{
+		_numRecycled = 0;
+		_nextRecycleSlot = 0;
+	}
+
+	/**
+	 * @brief Returns the maximum number of recycled directions
+	 * @return Maximum number of recycled directions
+	 */
+	inline unsigned int maxRecycle() const CADET_NOEXCEPT { return _maxRecycle; }
+
+	/**
+	 * @brief Returns the number of iterations spent in the most recent solve() call
+	 * @return Number of GMRES iterations of the last solve() call
+	 */
+	inline unsigned int lastNumIterations() const CADET_NOEXCEPT { return _lastNumIter; }
+
+	/**
+	 * @brief Returns the accumulated number of iterations of all solve() calls
+	 * @return Total number of GMRES iterations since creation of this solver
+	 */
+	inline unsigned int totalNumIterations() const CADET_NOEXCEPT { return _totalNumIter; }
+
 	/**
 	 * @brief Returns the user data passed to the matrix-vector multiplication function
 	 * @return User data
@@ -175,12 +279,29 @@ public:
 	const char* getReturnFlagName(int flag) const CADET_NOEXCEPT;
 
 protected:
+
+	void projectOntoRecycleSpace(double const* rhs, double* sol);
+	void harvestRecycleDirection(double const* guess, double const* sol);
+
 	SpgmrMemRec* _mem; //!< SUNDIALS memory
 	Orthogonalization _ortho; //!< Orthogonalization method
 	unsigned int _maxRestarts; //!< Maximum number of restarts
 	unsigned int _matrixSize; //!< Size of the square matrix
+	unsigned int _maxKrylov; //!< Dimension of the allocated Krylov space
 	MatrixVectorMultFun _matVecMul; //!< Matrix-vector multiplication function required for GMRES algorithm
+	PreconditionerSolveFun _precSolve; //!< Preconditioner solve function (optional)
+	PreconditionerSide _precSide; //!< Side on which the preconditioner is applied
 	void* _userData; //!< User data for matrix-vector multiplication function
+	unsigned int _lastNumIter; //!< Number of iterations of the most recent solve() call
+	unsigned int _totalNumIter; //!< Accumulated number of iterations of all solve() calls
+
+	unsigned int _maxRecycle; //!< Maximum number of recycled directions (0 disables recycling)
+	unsigned int _numRecycled; //!< Current number of recycled directions
+	unsigned int _nextRecycleSlot; //!< Slot the next harvested direction is stored in (cyclic)
+	std::vector<double> _recycleU; //!< Recycled directions @f$ u_i @f$ (column-wise)
+	std::vector<double> _recycleC; //!< Orthonormalized images @f$ c_i = A u_i @f$ (column-wise)
+	std::vector<double> _recycleTmp; //!< Temporary storage for residual and matrix-vector products
+	std::vector<double> _recycleGuess; //!< Copy of the (projected) initial guess for harvesting
 };
 
 } // namespace linalg
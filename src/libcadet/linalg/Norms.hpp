@@ -10,6 +10,15 @@
 //  is available at http://www.gnu.org/licenses/gpl.html
 // =============================================================================
 
+/**
+ * @file
+ * Provides vector norms.
+ * All norms in this file accumulate in a fixed element order that does not depend on the
+ * thread count or build options (the four-lane accumulators always combine in the same
+ * pattern). This invariant makes the results bitwise reproducible across machines and
+ * must be preserved when modifying or adding norms (see CADET_DETERMINISTIC_REDUCTIONS).
+ */
+
 #ifndef LIBCADET_NORMS_HPP_
 #define LIBCADET_NORMS_HPP_
 
@@ -31,10 +40,25 @@ namespace linalg
 	 */
 	inline double l1Norm(double const* const x, unsigned int size)
 	{
-		double res = 0.0;
-		for (unsigned int i = 0; i < size; ++i)
-			res += std::abs(x[i]);
-		return res;
+		// Summing into four independent accumulators breaks the sequential dependency
+		// chain of the reduction, which lets the compiler vectorize the loop. At the
+		// same time this amounts to a one-level pairwise summation which reduces the
+		// accumulated round-off error compared to a single running sum.
+		double acc0 = 0.0;
+		double acc1 = 0.0;
+		double acc2 = 0.0;
+		double acc3 = 0.0;
+		unsigned int i = 0;
+		for (; i + 4 <= size; i += 4)
+		{
+			acc0 += std::abs(x[i]);
+			acc1 += std::abs(x[i + 1]);
+			acc2 += std::abs(x[i + 2]);
+			acc3 += std::abs(x[i + 3]);
+		}
+		for (; i < size; ++i)
+			acc0 += std::abs(x[i]);
+		return (acc0 + acc1) + (acc2 + acc3);
 	}
 
 	/**
@@ -46,10 +70,22 @@ namespace linalg
 	 */
 	inline double l2NormSquared(double const* const x, unsigned int size)
 	{
-		double res = 0.0;
-		for (unsigned int i = 0; i < size; ++i)
-			res += sqr(x[i]);
-		return res;
+		// Four independent accumulators for vectorization and pairwise summation (see l1Norm())
+		double acc0 = 0.0;
+		double acc1 = 0.0;
+		double acc2 = 0.0;
+		double acc3 = 0.0;
+		unsigned int i = 0;
+		for (; i + 4 <= size; i += 4)
+		{
+			acc0 += sqr(x[i]);
+			acc1 += sqr(x[i + 1]);
+			acc2 += sqr(x[i + 2]);
+			acc3 += sqr(x[i + 3]);
+		}
+		for (; i < size; ++i)
+			acc0 += sqr(x[i]);
+		return (acc0 + acc1) + (acc2 + acc3);
 	}
 
 	/**
@@ -95,13 +131,118 @@ namespace linalg
 	 * @return The weighted @f$\ell^2(w)@f$-norm of the vector
 	 */
 	inline double l2normWeighted(double const* const x, double const* const weight, unsigned int size)
+	{
+		// Four independent accumulators for vectorization and pairwise summation (see l1Norm())
+		double acc0 = 0.0;
+		double acc1 = 0.0;
+		double acc2 = 0.0;
+		double acc3 = 0.0;
+		unsigned int i = 0;
+		for (; i + 4 <= size; i += 4)
+		{
+			acc0 += sqr(x[i] / weight[i]);
+			acc1 += sqr(x[i + 1] / weight[i + 1]);
+			acc2 += sqr(x[i + 2] / weight[i + 2]);
+			acc3 += sqr(x[i + 3] / weight[i + 3]);
+		}
+		for (; i < size; ++i)
+			acc0 += sqr(x[i] / weight[i]);
+		return std::sqrt((acc0 + acc1) + (acc2 + acc3));
+	}
+
+	/**
+	 * @brief Computes the weighted root mean square (WRMS) norm of the given vector
+	 * @details The WRMS norm is given by @f$ \lVert v \rVert_{\mathrm{WRMS}} = \sqrt{ \frac{1}{N} \sum_{i=1}^N \left(v_i w_i\right)^2 } @f$,
+	 *          following the multiplicative error weight convention of IDAS. The sum is evaluated
+	 *          with compensated (Kahan) summation in each of the four lanes, so the result does not
+	 *          degrade with the length of the state vector and is reproducible across problem sizes.
+	 * @param [in] x Pointer to vector whose norm is to be evaluated
+	 * @param [in] weight Pointer to weight vector @f$ w @f$
+	 * @param [in] size Number of elements in the vector
+	 * @return The WRMS norm of the vector
+	 */
+	inline double wrmsNorm(double const* const x, double const* const weight, unsigned int size)
+	{
+		double acc0 = 0.0;
+		double acc1 = 0.0;
+		double acc2 = 0.0;
+		double acc3 = 0.0;
+		double com0 = 0.0;
+		double com1 = 0.0;
+		double com2 = 0.0;
+		double com3 = 0.0;
+		unsigned int i = 0;
+		for (; i + 4 <= size; i += 4)
+		{
+			const double t0 = sqr(x[i] * weight[i]) - com0;
+			const double s0 = acc0 + t0;
+			com0 = (s0 - acc0) - t0;
+			acc0 = s0;
+
+			const double t1 = sqr(x[i + 1] * weight[i + 1]) - com1;
+			const double s1 = acc1 + t1;
+			com1 = (s1 - acc1) - t1;
+			acc1 = s1;
+
+			const double t2 = sqr(x[i + 2] * weight[i + 2]) - com2;
+			const double s2 = acc2 + t2;
+			com2 = (s2 - acc2) - t2;
+			acc2 = s2;
+
+			const double t3 = sqr(x[i + 3] * weight[i + 3]) - com3;
+			const double s3 = acc3 + t3;
+			com3 = (s3 - acc3) - t3;
+			acc3 = s3;
+		}
+		for (; i < size; ++i)
+		{
+			const double t0 = sqr(x[i] * weight[i]) - com0;
+			const double s0 = acc0 + t0;
+			com0 = (s0 - acc0) - t0;
+			acc0 = s0;
+		}
+		return std::sqrt(((acc0 + acc1) + (acc2 + acc3)) / static_cast<double>(size));
+	}
+
+	/**
+	 * @brief Computes the weighted (discrete) @f$\ell^\infty@f$-norm of the given vector
+	 * @details The weighted (discrete) @f$\ell^\infty@f$-norm is given by @f$ \lVert v \rVert_{\ell^\infty(w)} = \max \{ \abs{v_i / w_i} : i = 1, \dots, N \} @f$.
+	 * @param [in] x Pointer to vector whose norm is to be evaluated
+	 * @param [in] weight Pointer to weight vector @f$ w @f$
+	 * @param [in] size Number of elements in the vector
+	 * @return The weighted @f$\ell^\infty(w)@f$-norm of the vector
+	 */
+	inline double linfNormWeighted(double const* const x, double const* const weight, unsigned int size)
 	{
 		double res = 0.0;
 		for (unsigned int i = 0; i < size; ++i)
-			res += sqr(x[i] / weight[i]);
-		return std::sqrt(res);
+			res = std::max(std::abs(x[i] / weight[i]), res);
+		return res;
 	}
-	
+
+	/**
+	 * @brief Scales a vector by the reciprocal weights and computes the @f$\ell^\infty@f$-norm of the result
+	 * @details Computes @f$ y_i = v_i / w_i @f$ and returns @f$ \lVert y \rVert_{\ell^\infty} @f$ in a
+	 *          single traversal of the input. This avoids reading the state vector twice when the
+	 *          scaled vector is required right after the error test. In-place operation (@p x equal
+	 *          to @p out) is supported.
+	 * @param [in] x Pointer to vector to be scaled
+	 * @param [in] weight Pointer to weight vector @f$ w @f$
+	 * @param [out] out Pointer to vector receiving the scaled values
+	 * @param [in] size Number of elements in the vector
+	 * @return The weighted @f$\ell^\infty(w)@f$-norm of the vector
+	 */
+	inline double linfNormWeightedScale(double const* const x, double const* const weight, double* const out, unsigned int size)
+	{
+		double res = 0.0;
+		for (unsigned int i = 0; i < size; ++i)
+		{
+			out[i] = x[i] / weight[i];
+			res = std::max(std::abs(out[i]), res);
+		}
+		return res;
+	}
+
 
 	/**
 	 * @brief Computes the (discrete) @f$\ell^1@f$-norm of the difference of the given vectors
@@ -129,10 +270,22 @@ namespace linalg
 	 */
 	inline double l2NormSquaredDiff(double const* const x, double const* const y, unsigned int size)
 	{
-		double res = 0.0;
-		for (unsigned int i = 0; i < size; ++i)
-			res += sqr(x[i] - y[i]);
-		return res;
+		// Four independent accumulators for vectorization and pairwise summation (see l1Norm())
+		double acc0 = 0.0;
+		double acc1 = 0.0;
+		double acc2 = 0.0;
+		double acc3 = 0.0;
+		unsigned int i = 0;
+		for (; i + 4 <= size; i += 4)
+		{
+			acc0 += sqr(x[i] - y[i]);
+			acc1 += sqr(x[i + 1] - y[i + 1]);
+			acc2 += sqr(x[i + 2] - y[i + 2]);
+			acc3 += sqr(x[i + 3] - y[i + 3]);
+		}
+		for (; i < size; ++i)
+			acc0 += sqr(x[i] - y[i]);
+		return (acc0 + acc1) + (acc2 + acc3);
 	}
 
 	/**
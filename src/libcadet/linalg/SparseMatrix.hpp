@@ -20,6 +20,8 @@
 
 #include <vector>
 #include <ostream>
+#include <algorithm>
+#include <cstddef>
 
 #include "cadet/cadetCompilerInfo.hpp"
 #include "common/CompilerSpecific.hpp"
@@ -231,7 +233,7 @@ public:
 	 * @tparam result_t Type of the vector \f$ y \f$
 	 */
 	template <typename arg_t, typename result_t>
-	inline void multiplyVector(arg_t const* const x, result_t* const out) const
+	inline void multiplyVector(arg_t const* CADET_RESTRICT const x, result_t* CADET_RESTRICT const out) const
 	{
 		for (unsigned int i = 0; i < _curIdx; ++i)
 			out[_rows[i]] = _values[i] * x[_cols[i]];
@@ -247,7 +249,7 @@ public:
 	 * @tparam result_t Type of the vector \f$ y \f$
 	 */
 	template <typename arg_t, typename result_t>
-	inline void multiplyVector(arg_t const* const x, double alpha, result_t* const out) const
+	inline void multiplyVector(arg_t const* CADET_RESTRICT const x, double alpha, result_t* CADET_RESTRICT const out) const
 	{
 		for (unsigned int i = 0; i < _curIdx; ++i)
 			out[_rows[i]] = alpha * _values[i] * x[_cols[i]];
@@ -264,7 +266,7 @@ public:
 	 * @tparam result_t Type of the vector \f$ y \f$
 	 */
 	template <typename arg_t, typename result_t>
-	inline void multiplyVector(arg_t const* const x, double alpha, double beta, result_t* const out) const
+	inline void multiplyVector(arg_t const* CADET_RESTRICT const x, double alpha, double beta, result_t* CADET_RESTRICT const out) const
 	{
 		for (unsigned int i = 0; i < _curIdx; ++i)
 			out[_rows[i]] = alpha * _values[i] * x[_cols[i]] + beta * out[_rows[i]];
@@ -281,7 +283,7 @@ public:
 	 * @tparam result_t Type of the vector \f$ y \f$
 	 */
 	template <typename arg_t, typename result_t>
-	inline void multiplyAdd(arg_t const* const x, result_t* const out) const
+	inline void multiplyAdd(arg_t const* CADET_RESTRICT const x, result_t* CADET_RESTRICT const out) const
 	{
 		for (unsigned int i = 0; i < _curIdx; ++i)
 			out[_rows[i]] += _values[i] * x[_cols[i]];
@@ -299,7 +301,7 @@ public:
 	 * @tparam result_t Type of the vector \f$ y \f$
 	 */
 	template <typename arg_t, typename result_t>
-	inline void multiplyAdd(arg_t const* const x, result_t* const out, double alpha) const
+	inline void multiplyAdd(arg_t const* CADET_RESTRICT const x, result_t* CADET_RESTRICT const out, double alpha) const
 	{
 		for (unsigned int i = 0; i < _curIdx; ++i)
 			out[_rows[i]] += alpha * _values[i] * x[_cols[i]];
@@ -316,7 +318,7 @@ public:
 	 * @tparam result_t Type of the vector \f$ y \f$
 	 */
 	template <typename arg_t, typename result_t>
-	inline void multiplySubtract(arg_t const* const x, result_t* const out) const
+	inline void multiplySubtract(arg_t const* CADET_RESTRICT const x, result_t* CADET_RESTRICT const out) const
 	{
 		for (unsigned int i = 0; i < _curIdx; ++i)
 			out[_rows[i]] -= _values[i] * x[_cols[i]];
@@ -334,12 +336,47 @@ public:
 	 * @tparam result_t Type of the vector \f$ y \f$
 	 */
 	template <typename arg_t, typename result_t>
-	inline void multiplySubtract(arg_t const* const x, result_t* const out, double alpha) const
+	inline void multiplySubtract(arg_t const* CADET_RESTRICT const x, result_t* CADET_RESTRICT const out, double alpha) const
 	{
 		for (unsigned int i = 0; i < _curIdx; ++i)
 			out[_rows[i]] -= alpha * _values[i] * x[_cols[i]];
 	}
 
+	/**
+	 * @brief Multiplies the transpose of this sparse matrix with a vector and adds the result to another vector
+	 * @details Computes the matrix vector operation \f$ b + A^T x \f$, where the matrix vector
+	 *          product is added to @p out, which is \f$ b \f$.
+	 *
+	 * @param [in] x Vector to multiply the transposed matrix with
+	 * @param [in,out] out Vector to add the matrix-vector product to
+	 * @tparam arg_t Type of the vector \f$ x \f$
+	 * @tparam result_t Type of the vector \f$ y \f$
+	 */
+	template <typename arg_t, typename result_t>
+	inline void transposedMultiplyAdd(arg_t const* CADET_RESTRICT const x, result_t* CADET_RESTRICT const out) const
+	{
+		for (unsigned int i = 0; i < _curIdx; ++i)
+			out[_cols[i]] += _values[i] * x[_rows[i]];
+	}
+
+	/**
+	 * @brief Multiplies the transpose of this sparse matrix with a vector and adds the scaled result to another vector
+	 * @details Computes the matrix vector operation \f$ b + \alpha A^T x \f$, where the matrix vector
+	 *          product is added to @p out, which is \f$ b \f$.
+	 *
+	 * @param [in] x Vector to multiply the transposed matrix with
+	 * @param [in,out] out Vector to add the matrix-vector product to
+	 * @param [in] alpha Scale factor
+	 * @tparam arg_t Type of the vector \f$ x \f$
+	 * @tparam result_t Type of the vector \f$ y \f$
+	 */
+	template <typename arg_t, typename result_t>
+	inline void transposedMultiplyAdd(arg_t const* CADET_RESTRICT const x, result_t* CADET_RESTRICT const out, double alpha) const
+	{
+		for (unsigned int i = 0; i < _curIdx; ++i)
+			out[_cols[i]] += alpha * _values[i] * x[_rows[i]];
+	}
+
 	/**
 	 * @brief Returns a vector with row indices
 	 * @details Not all elements in the vector are actually set. Only the first numNonZero()
@@ -364,12 +401,31 @@ public:
 	 */
 	inline const std::vector<real_t>& values() const CADET_NOEXCEPT { return _values; }
 
+	/**
+	 * @brief Returns a vector with element values
+	 * @details The values are stored in the order in which the elements were inserted by
+	 *          addElement(). This allows overwriting the values of a fixed sparsity pattern
+	 *          in place by repeating the insertion loop, without calling clear() and
+	 *          rebuilding the structure.
+	 * @return Vector with element values
+	 */
+	inline std::vector<real_t>& values() CADET_NOEXCEPT { return _values; }
+
 	/**
 	 * @brief Returns the number of (structurally) non-zero elements in the matrix
 	 * @return Number of (structurally) non-zero elements in the matrix
 	 */
 	inline unsigned int numNonZero() const CADET_NOEXCEPT { return _curIdx; }
 
+	/**
+	 * @brief Returns the amount of heap memory held by the matrix in bytes
+	 * @return Memory footprint in bytes
+	 */
+	inline std::size_t memoryFootprint() const CADET_NOEXCEPT
+	{
+		return (_rows.capacity() + _cols.capacity()) * sizeof(unsigned int) + _values.capacity() * sizeof(real_t);
+	}
+
 private:
 	std::vector<unsigned int> _rows; //!< List with row indices of elements
 	std::vector<unsigned int> _cols; //!< List with column indices of elements
@@ -381,12 +437,140 @@ typedef SparseMatrix<double> DoubleSparseMatrix;
 
 std::ostream& operator<<(std::ostream& out, const DoubleSparseMatrix& sm);
 
+namespace detail
+{
+	//! Number of elements the CSR kernels prefetch ahead of the current element. The
+	//! gathered @c x entries are the only data dependent accesses of the kernels, so the
+	//! distance only has to cover the latency of one cache miss relative to one
+	//! multiply-add; two cache lines of column indices ahead is enough for that and small
+	//! enough not to thrash L1 on short rows. The column index array is padded by this
+	//! many entries so the kernels can prefetch unconditionally.
+	const unsigned int csrPrefetchDistance = 16;
+} // namespace detail
+
+/**
+ * @brief Represents a sparse matrix in compressed sparse row (CSR) format
+ * @details The matrix is compiled once from a DoubleSparseMatrix by compressFrom() and is
+ *          read-only afterwards. All non-zero values of a row are stored contiguously with
+ *          their column indices in ascending order, which makes multiplyAdd() and its
+ *          variants run with unit stride and lets the compiler vectorize the inner loop.
+ *          This format is meant for matrix-vector products in hot loops (e.g., inside
+ *          every GMRES iteration), whereas the coordinate format of SparseMatrix is meant
+ *          for assembly.
+ */
 class CompressedSparseMatrix
 {
 public:
-	CompressedSparseMatrix() CADET_NOEXCEPT : _values(nullptr) { }
+	/**
+	 * @brief Creates an empty CompressedSparseMatrix
+	 * @details Users have to call compressFrom() prior to multiplying with the matrix.
+	 */
+	CompressedSparseMatrix() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Creates a CompressedSparseMatrix from the given coordinate format matrix
+	 * @param [in] mat Source matrix in coordinate format
+	 */
+	CompressedSparseMatrix(const DoubleSparseMatrix& mat) { compressFrom(mat); }
+
+	~CompressedSparseMatrix() CADET_NOEXCEPT { }
+
+	// Default copy and assignment semantics
+	CompressedSparseMatrix(const CompressedSparseMatrix& cpy) = default;
+	CompressedSparseMatrix(CompressedSparseMatrix&& cpy) CADET_NOEXCEPT = default;
+
+	CompressedSparseMatrix& operator=(const CompressedSparseMatrix& cpy) = default;
+
+#ifdef COMPILER_SUPPORT_NOEXCEPT_DEFAULTED_MOVE
+	CompressedSparseMatrix& operator=(CompressedSparseMatrix&& cpy) CADET_NOEXCEPT = default;
+#else
+	CompressedSparseMatrix& operator=(CompressedSparseMatrix&& cpy) = default;
+#endif
+
+	/**
+	 * @brief Compiles the given coordinate format matrix into this CSR matrix
+	 * @details All previous content is lost. The elements are bucketed by row using a
+	 *          counting sort, which is linear in the number of non-zero elements, and
+	 *          then ordered by column inside each row. Duplicate entries are kept and
+	 *          contribute additively to matrix-vector products, just like they do in
+	 *          the coordinate format.
+	 * @param [in] mat Source matrix in coordinate format
+	 */
+	inline void compressFrom(const DoubleSparseMatrix& mat)
+	{
+		const unsigned int nnz = mat.numNonZero();
+		const std::vector<unsigned int>& srcRows = mat.rows();
+		const std::vector<unsigned int>& srcCols = mat.cols();
+		const std::vector<double>& srcVals = mat.values();
+
+		unsigned int numRows = 0;
+		for (unsigned int i = 0; i < nnz; ++i)
+			numRows = std::max(numRows, srcRows[i] + 1);
+
+		// Count elements per row and convert the counts to row start indices
+		_rowStart.assign(numRows + 1, 0);
+		for (unsigned int i = 0; i < nnz; ++i)
+			++_rowStart[srcRows[i] + 1];
+		for (unsigned int r = 1; r <= numRows; ++r)
+			_rowStart[r] += _rowStart[r - 1];
+
+		// Scatter the elements into their rows, remembering for each slot which
+		// source element it came from so that updateValuesFrom() can refresh the
+		// values of an identical pattern without repeating the compression
+		_values.resize(nnz);
+		_colIdx.resize(nnz);
+		_sourceIdx.resize(nnz);
+		std::vector<unsigned int> pos(_rowStart.begin(), _rowStart.end() - (numRows > 0 ? 1 : 0));
+		for (unsigned int i = 0; i < nnz; ++i)
+		{
+			const unsigned int idx = pos[srcRows[i]]++;
+			_colIdx[idx] = srcCols[i];
+			_values[idx] = srcVals[i];
+			_sourceIdx[idx] = i;
+		}
 
+		// Order the elements of each row by column (rows are short, so insertion sort suffices)
+		for (unsigned int r = 0; r < numRows; ++r)
+		{
+			for (unsigned int i = _rowStart[r] + 1; i < _rowStart[r + 1]; ++i)
+			{
+				const unsigned int col = _colIdx[i];
+				const double val = _values[i];
+				const unsigned int src = _sourceIdx[i];
+				unsigned int j = i;
+				for (; (j > _rowStart[r]) && (_colIdx[j - 1] > col); --j)
+				{
+					_colIdx[j] = _colIdx[j - 1];
+					_values[j] = _values[j - 1];
+					_sourceIdx[j] = _sourceIdx[j - 1];
+				}
+				_colIdx[j] = col;
+				_values[j] = val;
+				_sourceIdx[j] = src;
+			}
+		}
 
+		// Pad the column index array so that the multiplication kernels can prefetch
+		// x[_colIdx[i + csrPrefetchDistance]] without bounds checks; the padding points
+		// at column 0, which is always a valid prefetch target
+		_colIdx.resize(nnz + detail::csrPrefetchDistance, 0);
+	}
+
+	/**
+	 * @brief Copies the element values from a coordinate format matrix with identical pattern
+	 * @details Assumes that @p mat has exactly the same sparsity pattern (same elements
+	 *          inserted in the same order) as the matrix this CSR matrix was compiled from
+	 *          by compressFrom(). Only the values are copied using the stored permutation,
+	 *          which skips the row bucketing and column sorting of a full compression.
+	 * @param [in] mat Source matrix in coordinate format
+	 */
+	inline void updateValuesFrom(const DoubleSparseMatrix& mat)
+	{
+		cadet_assert(mat.numNonZero() == _values.size());
+		const std::vector<double>& srcVals = mat.values();
+		for (std::size_t i = 0; i < _values.size(); ++i)
+			_values[i] = srcVals[_sourceIdx[i]];
+	}
 
 	/**
 	 * @brief Multiplies this sparse matrix with a vector and adds the result to another vector
@@ -396,9 +580,20 @@ public:
 	 * @param [in] x Vector to multiply with
 	 * @param [in,out] out Vector to add the matrix-vector product to
 	 */
-	inline void multiplyAdd(double const* const x, double* const out)
+	inline void multiplyAdd(double const* CADET_RESTRICT const x, double* CADET_RESTRICT const out) const
 	{
-
+		double const* CADET_RESTRICT const vals = _values.data();
+		unsigned int const* CADET_RESTRICT const cols = _colIdx.data();
+		for (unsigned int r = 0; r < rows(); ++r)
+		{
+			double temp = 0.0;
+			for (unsigned int i = _rowStart[r]; i < _rowStart[r + 1]; ++i)
+			{
+				cadet_prefetch_read(x + cols[i + detail::csrPrefetchDistance]);
+				temp += vals[i] * x[cols[i]];
+			}
+			out[r] += temp;
+		}
 	}
 
 	/**
@@ -410,9 +605,20 @@ public:
 	 * @param [in] x Vector to multiply with
 	 * @param [in,out] out Vector to add the matrix-vector product to
 	 */
-	inline void multiplyAdd(double alpha, double const* const x, double* const out)
+	inline void multiplyAdd(double alpha, double const* CADET_RESTRICT const x, double* CADET_RESTRICT const out) const
 	{
-
+		double const* CADET_RESTRICT const vals = _values.data();
+		unsigned int const* CADET_RESTRICT const cols = _colIdx.data();
+		for (unsigned int r = 0; r < rows(); ++r)
+		{
+			double temp = 0.0;
+			for (unsigned int i = _rowStart[r]; i < _rowStart[r + 1]; ++i)
+			{
+				cadet_prefetch_read(x + cols[i + detail::csrPrefetchDistance]);
+				temp += vals[i] * x[cols[i]];
+			}
+			out[r] += alpha * temp;
+		}
 	}
 
 	/**
@@ -423,13 +629,100 @@ public:
 	 * @param [in] x Vector to multiply with
 	 * @param [in,out] out Vector to subtract the matrix-vector product from
 	 */
-	inline void multiplySubtract(double const* const x, double* const out)
+	inline void multiplySubtract(double const* CADET_RESTRICT const x, double* CADET_RESTRICT const out) const
+	{
+		double const* CADET_RESTRICT const vals = _values.data();
+		unsigned int const* CADET_RESTRICT const cols = _colIdx.data();
+		for (unsigned int r = 0; r < rows(); ++r)
+		{
+			double temp = 0.0;
+			for (unsigned int i = _rowStart[r]; i < _rowStart[r + 1]; ++i)
+			{
+				cadet_prefetch_read(x + cols[i + detail::csrPrefetchDistance]);
+				temp += vals[i] * x[cols[i]];
+			}
+			out[r] -= temp;
+		}
+	}
+
+	/**
+	 * @brief Multiplies this sparse matrix with a vector and overwrites another vector with the negated result
+	 * @details Computes the matrix vector operation \f$ -Ax \f$, which overwrites @p out.
+	 *          This is equivalent to resetting @p out to @c 0.0 followed by multiplySubtract(),
+	 *          but fuses both operations into a single traversal of @p out.
+	 *
+	 * @param [in] x Vector to multiply with
+	 * @param [out] out Vector that receives the negated matrix-vector product
+	 */
+	inline void multiplyNegate(double const* CADET_RESTRICT const x, double* CADET_RESTRICT const out) const
 	{
+		double const* CADET_RESTRICT const vals = _values.data();
+		unsigned int const* CADET_RESTRICT const cols = _colIdx.data();
+		for (unsigned int r = 0; r < rows(); ++r)
+		{
+			double temp = 0.0;
+			for (unsigned int i = _rowStart[r]; i < _rowStart[r + 1]; ++i)
+			{
+				cadet_prefetch_read(x + cols[i + detail::csrPrefetchDistance]);
+				temp += vals[i] * x[cols[i]];
+			}
+			out[r] = -temp;
+		}
+	}
 
+	/**
+	 * @brief Returns the number of rows of the matrix
+	 * @details Trailing rows without any non-zero element are not counted.
+	 * @return Number of rows
+	 */
+	inline unsigned int rows() const CADET_NOEXCEPT { return _rowStart.empty() ? 0 : _rowStart.size() - 1; }
+
+	/**
+	 * @brief Returns the number of (structurally) non-zero elements in the matrix
+	 * @return Number of (structurally) non-zero elements in the matrix
+	 */
+	inline unsigned int numNonZero() const CADET_NOEXCEPT { return _values.size(); }
+
+	/**
+	 * @brief Returns a vector with row start indices into the value and column index arrays
+	 * @return Vector with row start indices
+	 */
+	inline const std::vector<unsigned int>& rowStart() const CADET_NOEXCEPT { return _rowStart; }
+
+	/**
+	 * @brief Returns a vector with column indices
+	 * @details The vector holds detail::csrPrefetchDistance additional padding entries
+	 *          beyond the numNonZero() element indices, see compressFrom().
+	 * @return Vector with column indices
+	 */
+	inline const std::vector<unsigned int>& cols() const CADET_NOEXCEPT { return _colIdx; }
+
+	/**
+	 * @brief Returns a vector with element values
+	 * @return Vector with element values
+	 */
+	inline const std::vector<double>& values() const CADET_NOEXCEPT { return _values; }
+
+	/**
+	 * @brief Returns a vector with element values
+	 * @return Vector with element values
+	 */
+	inline std::vector<double>& values() CADET_NOEXCEPT { return _values; }
+
+	/**
+	 * @brief Returns the amount of heap memory held by the matrix in bytes
+	 * @return Memory footprint in bytes
+	 */
+	inline std::size_t memoryFootprint() const CADET_NOEXCEPT
+	{
+		return _values.capacity() * sizeof(double) + (_colIdx.capacity() + _rowStart.capacity() + _sourceIdx.capacity()) * sizeof(unsigned int);
 	}
 
 protected:
-	double* _values;
+	std::vector<double> _values; //!< Values of all elements, rows stored contiguously
+	std::vector<unsigned int> _colIdx; //!< Column indices of all elements
+	std::vector<unsigned int> _rowStart; //!< Index of the first element of each row, last entry is the total number of elements
+	std::vector<unsigned int> _sourceIdx; //!< For each slot, the index of the source element in the coordinate format matrix
 };
 
 } // namespace linalg
@@ -228,6 +228,34 @@ public:
 		unsigned int adEqOffset, unsigned int adOffset, unsigned int diagDir, unsigned int lowerBandwidth, unsigned int upperBandwidth, double* const workingMemory,
 		linalg::detail::DenseMatrixBase& workingMat) const = 0;
 
+	/**
+	 * @brief Checks whether the quasi-stationary bound states possess a closed-form equilibrium
+	 * @details Some isotherms (e.g., linear, multi component Langmuir) can be solved analytically
+	 *          for the bound states given the liquid phase concentrations. In this case, the
+	 *          algebraic bound state equations do not require a nonlinear solver and can be
+	 *          eliminated via quasiStationaryEquilibrium().
+	 * @return @c true if quasiStationaryEquilibrium() is implemented, otherwise @c false
+	 */
+	virtual bool hasQuasiStationaryEquilibrium() const CADET_NOEXCEPT { return false; }
+
+	/**
+	 * @brief Evaluates the closed-form equilibrium of the bound states
+	 * @details Computes the bound state concentrations @f$ q @f$ that solve the algebraic
+	 *          equations @f$ f(c_p, q) = 0 @f$ analytically for the given liquid phase
+	 *          concentrations. Only available if hasQuasiStationaryEquilibrium() returns
+	 *          @c true. The default implementation does nothing.
+	 *
+	 *          This function is called simultaneously from multiple threads.
+	 *
+	 * @param [in] t Current time point
+	 * @param [in] z Axial position in normalized coordinates (column inlet = 0, column outlet = 1)
+	 * @param [in] r Radial position in normalized coordinates (outer shell = 1, inner center = 0)
+	 * @param [in] secIdx Index of the current section
+	 * @param [in] yCp Pointer to first component in bead liquid phase of the current particle shell
+	 * @param [out] q Pointer to first bound state of the first component in the current particle shell
+	 */
+	virtual void quasiStationaryEquilibrium(double t, double z, double r, unsigned int secIdx, double const* yCp, double* q) const { }
+
 	/**
 	 * @brief Evaluates the residual for one particle shell
 	 * @details The binding model is responsible for implementing the complete bound state equations,
@@ -260,6 +288,44 @@ public:
 	virtual int residual(double t, double z, double r, unsigned int secIdx, double timeFactor, double const* y,
 		double const* yDot, double* res) const = 0;
 
+	/**
+	 * @brief Evaluates the residual for several particle shells in one call
+	 * @details Batched variant of residual() that operates on contiguous shell data. The bound
+	 *          states of two consecutive shells are separated by @p shellStride elements in
+	 *          @p y, @p yDot, and @p res. Evaluating all shells of a particle at once reduces
+	 *          the virtual dispatch to one call per particle and allows implementations to
+	 *          expose the whole shell loop to the compiler for vectorization. The default
+	 *          implementation forwards to residual() for each shell.
+	 *
+	 *          This function is called simultaneously from multiple threads.
+	 *
+	 * @param [in] nShells Number of particle shells
+	 * @param [in] t Current time point
+	 * @param [in] z Axial position in normalized coordinates (column inlet = 0, column outlet = 1)
+	 * @param [in] r Array with radial positions of the shells in normalized coordinates (outer shell = 1, inner center = 0)
+	 * @param [in] secIdx Index of the current section
+	 * @param [in] timeFactor Used to compute parameter derivatives with respect to section length,
+	 *             originates from time transformation and is premultiplied to time derivatives
+	 * @param [in] y Pointer to first bound state of the first component in the outermost particle shell
+	 * @param [in] yDot Pointer to first bound state time derivative of the first component in the
+	 *             outermost particle shell or @c nullptr if time derivatives shall be left out
+	 * @param [out] res Pointer to residual equation of first bound state of the first component in the outermost particle shell
+	 * @param [in] shellStride Distance between the data of two consecutive shells in @p y, @p yDot, and @p res
+	 * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+	 */
+	virtual int residualBatch(unsigned int nShells, double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		double const* y, double const* yDot, double* res, unsigned int shellStride) const
+	{
+		for (unsigned int i = 0; i < nShells; ++i)
+		{
+			const int result = residual(t, z, r[i], secIdx, timeFactor, y + i * shellStride,
+				yDot ? yDot + i * shellStride : nullptr, res + i * shellStride);
+			if (result != 0)
+				return result;
+		}
+		return 0;
+	}
+
 	/**
 	 * @brief Evaluates the Jacobian of the bound states for one particle shell analytically
 	 * @details The binding model is responsible for implementing the complete bound state equations,
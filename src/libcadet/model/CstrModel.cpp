@@ -0,0 +1,397 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "model/CstrModel.hpp"
+#include "ParamReaderHelper.hpp"
+#include "cadet/Exceptions.hpp"
+#include "cadet/HashUtil.hpp"
+#include "cadet/SolutionRecorder.hpp"
+
+#include "ConfigurationHelper.hpp"
+#include "ParamIdUtil.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include "LoggingUtils.hpp"
+#include "Logging.hpp"
+
+#include "AdUtils.hpp"
+
+namespace cadet
+{
+
+namespace model
+{
+
+CstrModel::CstrModel(UnitOpIdx unitOpIdx) : _unitOpIdx(unitOpIdx), _nComp(0), _volume(0.0), _flowRate(0.0)
+{
+}
+
+CstrModel::~CstrModel() CADET_NOEXCEPT
+{
+}
+
+unsigned int CstrModel::numDofs() const CADET_NOEXCEPT
+{
+	// Inlet DOFs followed by tank concentrations
+	return 2 * _nComp;
+}
+
+unsigned int CstrModel::numPureDofs() const CADET_NOEXCEPT
+{
+	return _nComp;
+}
+
+bool CstrModel::usesAD() const CADET_NOEXCEPT
+{
+	return false;
+}
+
+uint64_t CstrModel::structureHash(IParameterProvider& paramProvider)
+{
+	// The structure is fully determined by the number of components; the
+	// volume only changes coefficients
+	uint64_t h = 0;
+	hash_combine(h, paramProvider.getInt("NCOMP"));
+	return h;
+}
+
+bool CstrModel::configure(IParameterProvider& paramProvider, IConfigHelper& helper)
+{
+	_nComp = paramProvider.getInt("NCOMP");
+	return reconfigure(paramProvider);
+}
+
+bool CstrModel::reconfigure(IParameterProvider& paramProvider)
+{
+	const double vol = paramProvider.getDouble("VOLUME");
+	if (vol <= 0.0)
+		throw InvalidParameterException("VOLUME has to be positive");
+	_volume.setValue(vol);
+
+	_parameters.clear();
+	_parameters[makeParamId(hashString("VOLUME"), _unitOpIdx, CompIndep, BoundPhaseIndep, ReactionIndep, SectionIndep)] = &_volume;
+	return true;
+}
+
+void CstrModel::setFlowRates(const active& in, const active& out) CADET_NOEXCEPT
+{
+	// The network enforces a closed flow rate balance per unit operation,
+	// hence inflow and outflow coincide
+	_flowRate = in;
+}
+
+std::unordered_map<ParameterId, double> CstrModel::getAllParameterValues() const
+{
+	std::unordered_map<ParameterId, double> data;
+	std::transform(_parameters.begin(), _parameters.end(), std::inserter(data, data.end()),
+	               [](const std::pair<const ParameterId, active*>& p) { return std::make_pair(p.first, static_cast<double>(*p.second)); });
+	return data;
+}
+
+bool CstrModel::hasParameter(const ParameterId& pId) const
+{
+	return _parameters.find(pId) != _parameters.end();
+}
+
+bool CstrModel::setParameter(const ParameterId& pId, int value)
+{
+	return false;
+}
+
+bool CstrModel::setParameter(const ParameterId& pId, double value)
+{
+	if ((pId.unitOperation != _unitOpIdx) && (pId.unitOperation != UnitOpIndep))
+		return false;
+
+	auto paramHandle = _parameters.find(pId);
+	if (paramHandle != _parameters.end())
+	{
+		paramHandle->second->setValue(value);
+		return true;
+	}
+
+	return false;
+}
+
+bool CstrModel::setParameter(const ParameterId& pId, bool value)
+{
+	return false;
+}
+
+void CstrModel::setSensitiveParameterValue(const ParameterId& pId, double value)
+{
+	if ((pId.unitOperation != _unitOpIdx) && (pId.unitOperation != UnitOpIndep))
+		return;
+
+	auto paramHandle = _parameters.find(pId);
+	if ((paramHandle != _parameters.end()) && (_sensParams.find(paramHandle->second) != _sensParams.end()))
+		paramHandle->second->setValue(value);
+}
+
+bool CstrModel::setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue)
+{
+	if ((pId.unitOperation != _unitOpIdx) && (pId.unitOperation != UnitOpIndep))
+		return false;
+
+	auto paramHandle = _parameters.find(pId);
+	if (paramHandle != _parameters.end())
+	{
+		LOG(Debug) << "Found parameter " << pId << " in CSTR: Dir " << adDirection << " is set to " << adValue;
+
+		// Register parameter and set AD seed / direction
+		_sensParams.insert(paramHandle->second);
+		paramHandle->second->setADValue(adDirection, adValue);
+		return true;
+	}
+
+	return false;
+}
+
+void CstrModel::clearSensParams()
+{
+	// Remove AD directions from parameters
+	for (auto sp : _sensParams)
+		sp->setADValue(0.0);
+
+	_sensParams.clear();
+}
+
+void CstrModel::useAnalyticJacobian(const bool analyticJac) { }
+void CstrModel::notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset) { }
+
+void CstrModel::reportSolution(ISolutionRecorder& recorder, double const* const solution) const
+{
+	Exporter expr(_nComp, solution);
+	recorder.beginUnitOperation(_unitOpIdx, *this, expr);
+	recorder.endUnitOperation();
+}
+
+void CstrModel::reportSolutionStructure(ISolutionRecorder& recorder) const
+{
+	Exporter expr(_nComp, nullptr);
+	recorder.unitOperationStructure(_unitOpIdx, *this, expr);
+}
+
+unsigned int CstrModel::requiredADdirs() const CADET_NOEXCEPT
+{
+	return 0;
+}
+
+void CstrModel::prepareADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const { }
+
+void CstrModel::applyInitialCondition(double* const vecStateY, double* const vecStateYdot)
+{
+	std::fill(vecStateY, vecStateY + numDofs(), 0.0);
+	std::fill(vecStateYdot, vecStateYdot + numDofs(), 0.0);
+}
+
+void CstrModel::applyInitialCondition(IParameterProvider& paramProvider, double* const vecStateY, double* const vecStateYdot)
+{
+	applyInitialCondition(vecStateY, vecStateYdot);
+
+	if (paramProvider.exists("INIT_C"))
+	{
+		const std::vector<double> initC = paramProvider.getDoubleArray("INIT_C");
+		if ((initC.size() > 1) && (initC.size() < _nComp))
+			throw InvalidParameterException("INIT_C does not contain enough values for all components");
+
+		if (initC.size() == 1)
+			std::fill(vecStateY + _nComp, vecStateY + 2 * _nComp, initC[0]);
+		else
+			std::copy_n(initC.data(), _nComp, vecStateY + _nComp);
+	}
+}
+
+int CstrModel::residual(double t, unsigned int secIdx, double timeFactor, double const* const y, double const* const yDot, double* const res)
+{
+	return residualImpl<double, double>(t, secIdx, timeFactor, y, yDot, res);
+}
+
+template <typename ResidualType, typename ParamType>
+int CstrModel::residualImpl(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, double const* const y, double const* const yDot, ResidualType* const res)
+{
+	// Inlet DOFs: identity (the network coupling subtracts the mixed feed)
+	for (unsigned int i = 0; i < _nComp; ++i)
+		res[i] = y[i];
+
+	// Tank: dc / dt - (F / V) * (c_in - c) = 0
+	const ParamType flowByVolume = static_cast<ParamType>(_flowRate) / static_cast<ParamType>(_volume);
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		res[_nComp + i] = flowByVolume * (y[_nComp + i] - y[i]);
+		if (yDot)
+			res[_nComp + i] += timeFactor * yDot[_nComp + i];
+	}
+
+	return 0;
+}
+
+int CstrModel::residualWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot,
+	double* const res, active* const adRes, active* const adY, unsigned int adDirOffset)
+{
+	// The Jacobian is diagonal with closed-form entries derived from F and V,
+	// so nothing has to be assembled or factorized
+	return residualImpl<double, double>(static_cast<double>(t), secIdx, static_cast<double>(timeFactor), y, yDot, res);
+}
+
+int CstrModel::residualSensFwdAdOnly(const active& t, unsigned int secIdx, const active& timeFactor,
+	double const* const y, double const* const yDot, active* const adRes)
+{
+	// Evaluate residual with active parameters propagating the AD seeds of V and F
+	return residualImpl<active, active>(t, secIdx, timeFactor, y, yDot, adRes);
+}
+
+int CstrModel::residualSensFwdCombine(const active& timeFactor, const std::vector<const double*>& yS, const std::vector<const double*>& ySdot,
+	const std::vector<double*>& resS, active const* adRes, unsigned int const* dirMap, double* const tmp1, double* const tmp2, double* const tmp3)
+{
+	const double tf = static_cast<double>(timeFactor);
+	const double flowByVolume = static_cast<double>(_flowRate) / static_cast<double>(_volume);
+
+	for (unsigned int param = 0; param < yS.size(); ++param)
+	{
+		double const* const s = yS[param];
+		double const* const sDot = ySdot[param];
+		double* const r = resS[param];
+		const unsigned int dir = dirMap ? dirMap[param] : param;
+
+		// Compute (dF / dy) * s + (dF / dyDot) * sDot + dF / dp
+		for (unsigned int i = 0; i < _nComp; ++i)
+		{
+			r[i] = s[i] + adRes[i].getADValue(dir);
+			r[_nComp + i] = tf * sDot[_nComp + i] + flowByVolume * (s[_nComp + i] - s[i]) + adRes[_nComp + i].getADValue(dir);
+		}
+	}
+	return 0;
+}
+
+int CstrModel::residualSensFwdWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y,
+	double const* const yDot, active* const adRes, active* const adY, unsigned int adDirOffset)
+{
+	// Jacobian is always analytic, only the sensitivity residual has to be evaluated
+	return residualImpl<active, active>(t, secIdx, timeFactor, y, yDot, adRes);
+}
+
+int CstrModel::linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
+	double const* const y, double const* const yDot, double const* const res)
+{
+	// The system (dF / dy + alpha * dF / dyDot) x = b is diagonal except for the
+	// coupling of each tank concentration to its inlet DOF and solves in closed form
+	const double flowByVolume = static_cast<double>(_flowRate) / static_cast<double>(_volume);
+	const double diag = flowByVolume + alpha * timeFactor;
+
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		// Inlet DOF row is the identity
+		// Tank row: -F/V * x_in + (F/V + alpha * timeFactor) * x_tank = b_tank
+		rhs[_nComp + i] = (rhs[_nComp + i] + flowByVolume * rhs[i]) / diag;
+	}
+
+	return 0;
+}
+
+void CstrModel::consistentInitialState(double t, unsigned int secIdx, double timeFactor, double* const vecStateY, active* const adRes, active* const adY, unsigned int adDirOffset, double errorTol)
+{
+	// The tank concentrations are differential states and keep their initial values;
+	// the inlet DOFs are initialized by ModelSystem
+}
+
+void CstrModel::consistentInitialTimeDerivative(double t, unsigned int secIdx, double timeFactor, double const* vecStateY, double* const vecStateYdot)
+{
+	// On entry, vecStateYdot holds the residual evaluated without time derivatives;
+	// solve M * yDot = -res with the diagonal mass matrix M = timeFactor * I on the tank block
+	const double invTf = 1.0 / timeFactor;
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		vecStateYdot[i] = -vecStateYdot[i];
+		vecStateYdot[_nComp + i] = -vecStateYdot[_nComp + i] * invTf;
+	}
+}
+
+void CstrModel::leanConsistentInitialState(double t, unsigned int secIdx, double timeFactor, double* const vecStateY, active* const adRes, active* const adY, unsigned int adDirOffset, double errorTol)
+{
+	// Nothing to do, see consistentInitialState()
+}
+
+void CstrModel::leanConsistentInitialTimeDerivative(double t, double timeFactor, double* const vecStateYdot, double* const res)
+{
+	const double invTf = 1.0 / timeFactor;
+	for (unsigned int i = 0; i < _nComp; ++i)
+		vecStateYdot[_nComp + i] = -res[_nComp + i] * invTf;
+}
+
+void CstrModel::consistentInitialSensitivity(const active& t, unsigned int secIdx, const active& timeFactor, double const* vecStateY, double const* vecStateYdot,
+	std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, active const* const adRes)
+{
+	const double tf = static_cast<double>(timeFactor);
+	const double flowByVolume = static_cast<double>(_flowRate) / static_cast<double>(_volume);
+
+	for (unsigned int param = 0; param < vecSensY.size(); ++param)
+	{
+		double* const sensY = vecSensY[param];
+		double* const sensYdot = vecSensYdot[param];
+
+		// The tank sensitivities are differential states and keep their values, the inlet
+		// DOF sensitivities are initialized by ModelSystem; the time derivatives follow
+		// from the sensitivity residual being zero
+		for (unsigned int i = 0; i < _nComp; ++i)
+			sensYdot[_nComp + i] = -(flowByVolume * (sensY[_nComp + i] - sensY[i]) + adRes[_nComp + i].getADValue(param)) / tf;
+	}
+}
+
+void CstrModel::leanConsistentInitialSensitivity(const active& t, unsigned int secIdx, const active& timeFactor, double const* vecStateY, double const* vecStateYdot,
+	std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, active const* const adRes)
+{
+	consistentInitialSensitivity(t, secIdx, timeFactor, vecStateY, vecStateYdot, vecSensY, vecSensYdot, adRes);
+}
+
+void CstrModel::multiplyWithJacobian(double const* yS, double alpha, double beta, double* ret)
+{
+	const double flowByVolume = static_cast<double>(_flowRate) / static_cast<double>(_volume);
+
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		// Identity matrix of inlet DOFs
+		ret[i] = alpha * yS[i] + beta * ret[i];
+
+		// Tank rows
+		ret[_nComp + i] = alpha * flowByVolume * (yS[_nComp + i] - yS[i]) + beta * ret[_nComp + i];
+	}
+}
+
+void CstrModel::multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret)
+{
+	const double flowByVolume = static_cast<double>(_flowRate) / static_cast<double>(_volume);
+
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		// Inlet DOF columns receive the identity and the coupling to the tank rows
+		ret[i] = alpha * (yS[i] - flowByVolume * yS[_nComp + i]) + beta * ret[i];
+
+		// Tank columns
+		ret[_nComp + i] = alpha * flowByVolume * yS[_nComp + i] + beta * ret[_nComp + i];
+	}
+}
+
+void CstrModel::multiplyWithDerivativeJacobian(double const* sDot, double* ret, double timeFactor)
+{
+	// Inlet DOFs are algebraic
+	std::fill_n(ret, _nComp, 0.0);
+
+	for (unsigned int i = 0; i < _nComp; ++i)
+		ret[_nComp + i] = timeFactor * sDot[_nComp + i];
+}
+
+}  // namespace model
+
+}  // namespace cadet
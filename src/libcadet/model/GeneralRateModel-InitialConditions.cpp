@@ -14,8 +14,10 @@
 #include "linalg/DenseMatrix.hpp"
 #include "linalg/BandMatrix.hpp"
 #include "ParamReaderHelper.hpp"
+#include "MemoryPool.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <functional>
 
 #include "LoggingUtils.hpp"
@@ -26,6 +28,49 @@
 	#include <tbb/tbb.h>
 #endif
 
+namespace
+{
+	// Stack capacity of the per-shell binding workspace; covers the nonlinear solver
+	// workspaces of all shipped binding models up to roughly 16 bound states
+	const unsigned int bindingWorkspaceStackBytes = 2048;
+
+	/**
+	 * @brief Conservatively remaps a piecewise constant function onto a different grid
+	 * @details Both grids are given by ascending cell edge coordinates over the same domain.
+	 *          Every destination cell receives the average of the source function over its
+	 *          extent, so the integral (i.e., the mass) is preserved exactly.
+	 * @param [in] src Source cell values
+	 * @param [in] srcEdges Source cell edges (ascending, @p nSrc + 1 entries)
+	 * @param [in] nSrc Number of source cells
+	 * @param [out] dst Destination cell values
+	 * @param [in] dstEdges Destination cell edges (ascending, @p nDst + 1 entries, same domain as @p srcEdges)
+	 * @param [in] nDst Number of destination cells
+	 */
+	void conservativeRemap(double const* const src, double const* const srcEdges, unsigned int nSrc,
+		double* const dst, double const* const dstEdges, unsigned int nDst)
+	{
+		unsigned int i = 0;
+		for (unsigned int j = 0; j < nDst; ++j)
+		{
+			const double lo = dstEdges[j];
+			const double hi = dstEdges[j + 1];
+
+			// Advance to the first source cell overlapping the destination cell
+			while ((i < nSrc) && (srcEdges[i + 1] <= lo))
+				++i;
+
+			double acc = 0.0;
+			for (unsigned int k = i; (k < nSrc) && (srcEdges[k] < hi); ++k)
+			{
+				const double overlap = std::min(hi, srcEdges[k + 1]) - std::max(lo, srcEdges[k]);
+				if (overlap > 0.0)
+					acc += overlap * src[k];
+			}
+			dst[j] = acc / (hi - lo);
+		}
+	}
+}
+
 namespace cadet
 {
 
@@ -99,6 +144,147 @@ void GeneralRateModel::applyInitialCondition(IParameterProvider& paramProvider,
 	}
 }
 
+/**
+ * @brief Initializes the state vector from a recorded state on a (possibly) different discretization
+ * @details Conservatively remaps bulk, particle mobile phase, and solid phase states of a
+ *          recorded solution (as exposed by reportSolution() / reportSolutionStructure())
+ *          onto the discretization of this model. Cell averages are transferred by exact
+ *          overlap integration, so the interpolation preserves mass and enables
+ *          coarse-to-fine continuation between optimization stages without restarting the
+ *          fine model from scratch.
+ *
+ *          The axial grids are equidistant by construction. The particle shells of this
+ *          model are remapped in the (normalized) volume coordinate using its actual radial
+ *          discretization; the source shells are assumed to be equidistant in radius (see
+ *          setEquidistantRadialDisc()). The flux DOFs and the inlet DOFs are reset to zero;
+ *          a consistent initialization has to be performed afterwards, which recomputes
+ *          them along with the time derivatives.
+ * @param [in] oldState Exporter of the recorded source state
+ * @param [out] vecStateY State vector the remapped state is written to
+ */
+void GeneralRateModel::applyInitialConditionFromState(const ISolutionExporter& oldState, double* const vecStateY)
+{
+	if (oldState.numComponents() != _disc.nComp)
+		throw InvalidParameterException("Source state has a different number of components");
+
+	if (!oldState.hasParticleMobilePhase())
+		throw InvalidParameterException("Source state does not provide particle mobile phase data");
+
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		if (oldState.numBoundStates(comp) != _disc.nBound[comp])
+			throw InvalidParameterException("Source state has a different number of bound states");
+	}
+
+	Indexer idxr(_disc);
+
+	const unsigned int nColSrc = oldState.numAxialCells();
+	const unsigned int nParSrc = oldState.numRadialCells();
+
+	// Axial cell edges (both grids are equidistant)
+	std::vector<double> axEdgesSrc(nColSrc + 1);
+	for (unsigned int i = 0; i <= nColSrc; ++i)
+		axEdgesSrc[i] = static_cast<double>(i) / static_cast<double>(nColSrc);
+
+	std::vector<double> axEdgesDst(_disc.nCol + 1);
+	for (unsigned int i = 0; i <= _disc.nCol; ++i)
+		axEdgesDst[i] = static_cast<double>(i) / static_cast<double>(_disc.nCol);
+
+	// Particle shell edges in the normalized volume coordinate measured from the particle
+	// surface inwards (shell 0 is the outermost shell); conservation in this coordinate is
+	// conservation of mass in the spherical shells
+	std::vector<double> shEdgesSrc(nParSrc + 1);
+	for (unsigned int i = 0; i <= nParSrc; ++i)
+	{
+		const double rOut = 1.0 - static_cast<double>(i) / static_cast<double>(nParSrc);
+		shEdgesSrc[i] = 1.0 - rOut * rOut * rOut;
+	}
+
+	std::vector<double> shEdgesDst(_disc.nPar + 1);
+	{
+		double rOut = 1.0;
+		shEdgesDst[0] = 0.0;
+		for (unsigned int i = 0; i < _disc.nPar; ++i)
+		{
+			const double rIn = rOut - _parDisc->cellSize[i];
+			shEdgesDst[i + 1] = shEdgesDst[i] + (rOut * rOut * rOut - rIn * rIn * rIn);
+			rOut = rIn;
+		}
+		// Guard against round-off in the accumulated volumes
+		shEdgesDst[_disc.nPar] = 1.0;
+	}
+
+	// Inlet DOFs are determined by the network coupling
+	std::fill(vecStateY, vecStateY + idxr.offsetC(), 0.0);
+
+	// Bulk concentrations
+	std::vector<double> srcBuf(std::max(nColSrc, nParSrc));
+	std::vector<double> dstBuf(std::max(_disc.nCol, _disc.nPar));
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		for (unsigned int col = 0; col < nColSrc; ++col)
+			srcBuf[col] = oldState.concentration(comp, col);
+
+		conservativeRemap(srcBuf.data(), axEdgesSrc.data(), nColSrc, dstBuf.data(), axEdgesDst.data(), _disc.nCol);
+
+		for (unsigned int col = 0; col < _disc.nCol; ++col)
+			idxr.c(vecStateY, col, comp) = dstBuf[col];
+	}
+
+	// Particle states: remap axially per source shell first, then remap the shells of
+	// each destination column cell in the volume coordinate
+	std::vector<double> panel(_disc.nCol * nParSrc);
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		// Mobile phase
+		for (unsigned int shell = 0; shell < nParSrc; ++shell)
+		{
+			for (unsigned int col = 0; col < nColSrc; ++col)
+				srcBuf[col] = oldState.mobilePhase(comp, col, shell);
+
+			conservativeRemap(srcBuf.data(), axEdgesSrc.data(), nColSrc, panel.data() + shell * _disc.nCol, axEdgesDst.data(), _disc.nCol);
+		}
+
+		for (unsigned int col = 0; col < _disc.nCol; ++col)
+		{
+			for (unsigned int shell = 0; shell < nParSrc; ++shell)
+				srcBuf[shell] = panel[shell * _disc.nCol + col];
+
+			conservativeRemap(srcBuf.data(), shEdgesSrc.data(), nParSrc, dstBuf.data(), shEdgesDst.data(), _disc.nPar);
+
+			for (unsigned int shell = 0; shell < _disc.nPar; ++shell)
+				idxr.cp(vecStateY, col, shell, comp) = dstBuf[shell];
+		}
+
+		// Solid phase
+		for (unsigned int bnd = 0; bnd < _disc.nBound[comp]; ++bnd)
+		{
+			for (unsigned int shell = 0; shell < nParSrc; ++shell)
+			{
+				for (unsigned int col = 0; col < nColSrc; ++col)
+					srcBuf[col] = oldState.solidPhase(comp, col, shell, bnd);
+
+				conservativeRemap(srcBuf.data(), axEdgesSrc.data(), nColSrc, panel.data() + shell * _disc.nCol, axEdgesDst.data(), _disc.nCol);
+			}
+
+			for (unsigned int col = 0; col < _disc.nCol; ++col)
+			{
+				for (unsigned int shell = 0; shell < nParSrc; ++shell)
+					srcBuf[shell] = panel[shell * _disc.nCol + col];
+
+				conservativeRemap(srcBuf.data(), shEdgesSrc.data(), nParSrc, dstBuf.data(), shEdgesDst.data(), _disc.nPar);
+
+				for (unsigned int shell = 0; shell < _disc.nPar; ++shell)
+					idxr.q(vecStateY, col, shell, bnd, comp) = dstBuf[shell];
+			}
+		}
+	}
+
+	// Flux DOFs are algebraic and recomputed by the consistent initialization
+	double* const jf = idxr.jf(vecStateY);
+	std::fill(jf, jf + _disc.nComp * _disc.nCol, 0.0);
+}
+
 /**
  * @brief Computes consistent initial values (state variables without their time derivatives)
  * @details Given the DAE \f[ F(t, y, \dot{y}) = 0, \f] the initial values \f$ y_0 \f$ and \f$ \dot{y}_0 \f$ have
@@ -167,48 +353,63 @@ void GeneralRateModel::consistentInitialState(double t, unsigned int secIdx, dou
 	// Step 1a: Compute quasi-stationary binding model state
 	if (_binding->hasAlgebraicEquations())
 	{
-		//Problem capturing variables here
+		// The shell solves are all independent, so we run over the flattened (column cell, shell)
+		// index space and let each thread work on whatever shell comes next
 #ifdef CADET_PARALLELIZE
 		BENCH_SCOPE(_timerConsistentInitPar);
-		tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
+		tbb::parallel_for(size_t(0), size_t(_disc.nCol) * size_t(_disc.nPar), [&](size_t cell)
 #else
-		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+		for (unsigned int cell = 0; cell < _disc.nCol * _disc.nPar; ++cell)
 #endif
 		{
-			// Reuse memory of band matrix for dense matrix
-			linalg::DenseMatrixView jacobianMatrix(_jacPdisc[pblk].data(), _jacPdisc[pblk].pivot(), _disc.strideBound, _disc.strideBound);
+			const unsigned int pblk = cell / _disc.nPar;
+			const unsigned int shell = cell % _disc.nPar;
+
+			// Pooled per-thread dense matrix; reusing the memory of _jacPdisc[pblk] would
+			// serialize all shells of a particle block on a single Jacobian matrix
+			linalg::DenseMatrix& jacobianMatrix = _consistentInitJac.local();
+			if (jacobianMatrix.rows() < _disc.strideBound)
+				jacobianMatrix.resize(_disc.strideBound, _disc.strideBound);
 
 			// Midpoint of current column cell (z coordinate) - needed in externally dependent adsorption kinetic
 			const double z = 1.0 / static_cast<double>(_disc.nCol) * (0.5 + pblk);
 
-			// This loop cannot be run in parallel without creating a Jacobian matrix for each one which would increase memory usage
-			for(size_t shell = 0; shell < size_t(_disc.nPar); shell++)
+			const int localOffsetToParticle = idxr.offsetCp(pblk);
+			const int localOffsetInParticle = static_cast<int>(shell) * idxr.strideParShell() + idxr.strideParLiquid();
+
+			// Get pointer to q variables in a shell of particle pblk
+			double* const qShell = vecStateY + localOffsetToParticle + localOffsetInParticle;
+
+			// The binding models extract their dense Jacobian from the band compressed AD
+			// seeding; if the colored seeding is active, they have to fall back to their
+			// analytic Jacobian instead
+			const bool bandSeeding = _parAdColors.empty();
+			active* const localAdRes = (adRes && bandSeeding) ? adRes + localOffsetToParticle : nullptr;
+			active* const localAdY = (adY && bandSeeding) ? adY + localOffsetToParticle : nullptr;
+
+			// The common small binding problems get their workspace from the stack: the
+			// buffer is private to the executing thread and hot in cache, instead of a
+			// cell-strided slice of the heap-backed _tempState. Oversized problems (many
+			// bound states or solver settings that inflate the workspace) fall back to
+			// the pooled path.
+			StackArrayPool<bindingWorkspaceStackBytes> stackPool;
+			double* workingMemory;
+			if (cadet_likely(requiredMem * sizeof(double) <= stackPool.capacityBytes()))
+				workingMemory = stackPool.create<double>(requiredMem);
+			else
 			{
-				const int localOffsetToParticle = idxr.offsetCp(pblk);
-				const int localOffsetInParticle = static_cast<int>(shell) * idxr.strideParShell() + idxr.strideParLiquid();
-
-				// Get pointer to q variables in a shell of particle pblk
-				double* const qShell = vecStateY + localOffsetToParticle + localOffsetInParticle;
-				active* const localAdRes = adRes ? adRes + localOffsetToParticle : nullptr;
-				active* const localAdY = adY ? adY + localOffsetToParticle : nullptr;
-
 				// We are essentially creating a 2d vector of blocks out of a linear strip of memory
-				const unsigned int offset = requiredMem * (_disc.nPar * pblk + shell);
-
-				// Solve algebraic variables
-				_binding->consistentInitialState(t, z, _parCenterRadius[shell], secIdx, qShell, errorTol, localAdRes, localAdY,
-					localOffsetInParticle, adDirOffset, _jacP[0].lowerBandwidth(), _jacP[0].lowerBandwidth(), _jacP[0].upperBandwidth(), _tempState + offset, jacobianMatrix);
+				workingMemory = _tempState + requiredMem * cell;
 			}
+
+			// Solve algebraic variables
+			_binding->consistentInitialState(t, z, _parDisc->centerRadius[shell], secIdx, qShell, errorTol, localAdRes, localAdY,
+				localOffsetInParticle, adDirOffset, _jacP[0].lowerBandwidth(), _jacP[0].lowerBandwidth(), _jacP[0].upperBandwidth(), workingMemory, jacobianMatrix);
 		} CADET_PARFOR_END;
 	}
 
-	// Step 1b: Compute fluxes j_f
-
-	// Reset j_f to 0.0
-	double* const jf = vecStateY + idxr.offsetJf();
-	std::fill(jf, jf + _disc.nComp * _disc.nCol, 0.0);
-
-	solveForFluxes(vecStateY, idxr);
+	// Step 1b: Compute fluxes j_f with zero right hand side
+	solveForFluxesZeroRhs(vecStateY, idxr);
 }
 
 /**
@@ -270,10 +471,17 @@ void GeneralRateModel::consistentInitialTimeDerivative(double t, unsigned int se
 
 	// Step 2a: Assemble, factorize, and solve diagonal blocks of linear system
 
-	// Note that the residual has not been negated, yet. We will do that now.
-	for (unsigned int i = 0; i < numDofs(); ++i)
+	// Note that the residual has not been negated, yet. Instead of a separate sweep over the
+	// full state vector, the negation is fused into the (parallel) block loops below: Each
+	// block negates its own right hand side immediately before solving. Only the inlet DOFs,
+	// which do not belong to any block, are negated here. The flux block is skipped entirely
+	// since it is overwritten in Step 2b anyway.
+	for (unsigned int i = 0; i < _disc.nComp; ++i)
 		vecStateYdot[i] = -vecStateYdot[i];
 
+	// The bulk blocks only depend on the time transformation; reuse a retained factorization if possible
+	const bool reuseBulk = _jacCdiscRetained && (_jacCdiscTimeFactor == timeFactor);
+
 	// Threads that are done with the bulk column blocks can proceed to the particle blocks
 #ifdef CADET_PARALLELIZE
 	BENCH_START(_timerConsistentInitPar);
@@ -282,26 +490,39 @@ void GeneralRateModel::consistentInitialTimeDerivative(double t, unsigned int se
 	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
 #endif
 	{
-		// Assemble
-		linalg::FactorizableBandMatrix& fbm = _jacCdisc[comp];
-		fbm.setAll(0.0);
-		addTimeDerivativeToJacobianColumnBlock(fbm, idxr, 1.0, timeFactor);
+		double* const yDotSlice = vecStateYdot + comp * idxr.strideColComp() + idxr.offsetC();
 
-		// Factorize
-		const bool result = fbm.factorize();
-		if (!result)
+		// Negate the right hand side of this block (fused into the parallel loop)
+		for (int i = 0; i < idxr.strideColComp(); ++i)
+			yDotSlice[i] = -yDotSlice[i];
+
+		linalg::FactorizableBandMatrix& fbm = _jacCdisc[comp];
+		if (!reuseBulk)
 		{
-			LOG(Error) << "Factorize() failed for comp " << comp;
+			// Assemble
+			fbm.setAll(0.0);
+			addTimeDerivativeToJacobianColumnBlock(fbm, idxr, 1.0, timeFactor);
+
+			// Factorize
+			const bool result = fbm.factorize();
+			if (!result)
+			{
+				LOG(Error) << "Factorize() failed for comp " << comp;
+			}
 		}
 
 		// Solve
-		const bool result2 = fbm.solve(vecStateYdot + comp * idxr.strideColComp() + idxr.offsetC());
+		const bool result2 = fbm.solve(yDotSlice);
 		if (!result2)
 		{
 			LOG(Error) << "Solve() failed for comp " << comp;
 		}
 	} CADET_PARFOR_END;
 
+	// Retain the factorized bulk blocks for subsequent initializations with the same time transformation
+	_jacCdiscRetained = true;
+	_jacCdiscTimeFactor = timeFactor;
+
 	// Process the particle blocks
 #ifdef CADET_PARALLELIZE
 	tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
@@ -312,6 +533,12 @@ void GeneralRateModel::consistentInitialTimeDerivative(double t, unsigned int se
 		// Midpoint of current column cell (z coordinate) - needed in externally dependent adsorption kinetic
 		const double z = 1.0 / static_cast<double>(_disc.nCol) * (0.5 + pblk);
 
+		// Negate the right hand side of this block (fused into the parallel loop);
+		// rows of algebraic equations are overwritten below anyway
+		double* const pblkDotSlice = vecStateYdot + idxr.offsetCp(pblk);
+		for (int i = 0; i < idxr.strideParBlock(); ++i)
+			pblkDotSlice[i] = -pblkDotSlice[i];
+
 		// Assemble
 		linalg::FactorizableBandMatrix& fbm = _jacPdisc[pblk];
 		fbm.setAll(0.0);
@@ -352,7 +579,7 @@ void GeneralRateModel::consistentInitialTimeDerivative(double t, unsigned int se
 				std::fill(qShellDot, qShellDot + algLen, 0.0);
 				if (_binding->dependsOnTime())
 				{
-					_binding->timeDerivativeAlgebraicResidual(t, z, _parCenterRadius[j], secIdx, vecStateY + idxr.offsetCp(pblk, j), qShellDot);
+					_binding->timeDerivativeAlgebraicResidual(t, z, _parDisc->centerRadius[j], secIdx, vecStateY + idxr.offsetCp(pblk, j), qShellDot);
 					for (unsigned int algRow = 0; algRow < algLen; ++algRow)
 						qShellDot[algRow] *= -1.0;
 				}
@@ -370,24 +597,29 @@ void GeneralRateModel::consistentInitialTimeDerivative(double t, unsigned int se
 		}
 
 		// Solve
-		const bool result2 = fbm.solve(vecStateYdot + idxr.offsetCp(pblk));
+		const bool result2 = fbm.solve(pblkDotSlice);
 		if (!result2)
 		{
 			LOG(Error) << "Solve() failed for par block " << pblk;
 		}
 	} CADET_PARFOR_END;
 
+	// Retain the factorized particle blocks; the algebraic rows copied from the Jacobian
+	// remain valid as long as neither state nor section change (e.g., for the immediately
+	// following sensitivity initialization)
+	_jacPdiscRetained = true;
+	_jacPdiscTimeFactor = timeFactor;
+
+	// The retained factorization covers the full blocks, so any shell truncation from a
+	// previous linear solve no longer applies
+	std::fill(_parActiveRows.begin(), _parActiveRows.end(), std::numeric_limits<unsigned int>::max());
+
 #ifdef CADET_PARALLELIZE
 	BENCH_STOP(_timerConsistentInitPar);
 #endif
 
-	// Step 2b: Solve for fluxes j_f by backward substitution
-
-	// Reset \dot{j}_f to 0.0
-	double* const jfDot = vecStateYdot + idxr.offsetJf();
-	std::fill(jfDot, jfDot + _disc.nComp * _disc.nCol, 0.0);
-
-	solveForFluxes(vecStateYdot, idxr);
+	// Step 2b: Solve for fluxes \dot{j}_f with zero right hand side by backward substitution
+	solveForFluxesZeroRhs(vecStateYdot, idxr);
 }
 
 
@@ -448,13 +680,8 @@ void GeneralRateModel::leanConsistentInitialState(double t, unsigned int secIdx,
 
 	Indexer idxr(_disc);
 
-	// Step 1: Compute fluxes j_f
-
-	// Reset j_f to 0.0
-	double* const jf = vecStateY + idxr.offsetJf();
-	std::fill(jf, jf + _disc.nComp * _disc.nCol, 0.0);
-
-	solveForFluxes(vecStateY, idxr);
+	// Step 1: Compute fluxes j_f with zero right hand side
+	solveForFluxesZeroRhs(vecStateY, idxr);
 }
 
 /**
@@ -524,16 +751,19 @@ void GeneralRateModel::leanConsistentInitialTimeDerivative(double t, double time
 		//double* const yDotSlice = vecStateYdot + comp * idxr.strideColComp() + idxr.offsetC();
 		double* const resSlice = res + comp * idxr.strideColComp() + idxr.offsetC();
 
-		// Assemble
 		linalg::FactorizableBandMatrix& fbm = _jacCdisc[comp];
-		fbm.setAll(0.0);
-		addTimeDerivativeToJacobianColumnBlock(fbm, idxr, 1.0, timeFactor);
-
-		// Factorize
-		const bool result = fbm.factorize();
-		if (!result)
+		if (!(_jacCdiscRetained && (_jacCdiscTimeFactor == timeFactor)))
 		{
-			LOG(Error) << "Factorize() failed for comp " << comp;
+			// Assemble
+			fbm.setAll(0.0);
+			addTimeDerivativeToJacobianColumnBlock(fbm, idxr, 1.0, timeFactor);
+
+			// Factorize
+			const bool result = fbm.factorize();
+			if (!result)
+			{
+				LOG(Error) << "Factorize() failed for comp " << comp;
+			}
 		}
 
 		// Solve
@@ -550,17 +780,16 @@ void GeneralRateModel::leanConsistentInitialTimeDerivative(double t, double time
 		//	yDotSlice[i] = -resSlice[i];
 	} CADET_PARFOR_END;
 
+	// Retain the factorized bulk blocks for subsequent initializations with the same time transformation
+	_jacCdiscRetained = true;
+	_jacCdiscTimeFactor = timeFactor;
+
 #ifdef CADET_PARALLELIZE
 	BENCH_STOP(_timerConsistentInitPar);
 #endif
 
-	// Step 2b: Solve for fluxes j_f by backward substitution
-
-	// Reset \dot{j}_f to 0.0
-	double* const jfDot = vecStateYdot + idxr.offsetJf();
-	std::fill(jfDot, jfDot + _disc.nComp * _disc.nCol, 0.0);
-
-	solveForFluxes(vecStateYdot, idxr);
+	// Step 2b: Solve for fluxes \dot{j}_f with zero right hand side by backward substitution
+	solveForFluxesZeroRhs(vecStateYdot, idxr);
 }
 
 /**
@@ -652,11 +881,16 @@ void GeneralRateModel::consistentInitialSensitivity(const active& t, unsigned in
 				unsigned int algLen = 0;
 				_binding->getAlgebraicBlock(algStart, algLen);
 
-				// Reuse memory of band matrix for dense matrix
-				linalg::DenseMatrixView jacobianMatrix(_jacPdisc[pblk].data(), _jacPdisc[pblk].pivot(), algLen, algLen);
+				// Reuse memory of band matrix for the dense matrices of all shells; the band
+				// matrix provides enough space since its stride exceeds the algebraic block size
+				std::vector<linalg::DenseMatrixView> jacobianBatch;
+				std::vector<double*> rhsBatch;
+				jacobianBatch.reserve(_disc.nPar);
+				rhsBatch.reserve(_disc.nPar);
 
 				for (unsigned int shell = 0; shell < _disc.nPar; ++shell)
 				{
+					linalg::DenseMatrixView jacobianMatrix(_jacPdisc[pblk].data() + shell * algLen * algLen, _jacPdisc[pblk].pivot() + shell * algLen, algLen, algLen);
 					const unsigned int jacRowOffset = shell * static_cast<unsigned int>(idxr.strideParShell()) + static_cast<unsigned int>(idxr.strideParLiquid());
 					const int localCpOffset = idxr.offsetCp(pblk) + static_cast<int>(shell) * idxr.strideParShell();
 					const int localOffset = localCpOffset + idxr.strideParLiquid();
@@ -692,10 +926,12 @@ void GeneralRateModel::consistentInitialSensitivity(const active& t, unsigned in
 					// Copy main block to dense matrix
 					jacobianMatrix.copySubmatrixFromBanded(_jacP[pblk], jacRowOffset + algStart, 0, algLen, algLen);
 
-					// Solve algebraic variables
-					jacobianMatrix.factorize();
-					jacobianMatrix.solve(qShell + algStart);
+					jacobianBatch.push_back(jacobianMatrix);
+					rhsBatch.push_back(qShell + algStart);
 				}
+
+				// Solve algebraic variables of all shells in one batch
+				linalg::batchedFactorizeSolve(jacobianBatch.data(), rhsBatch.data(), _disc.nPar);
 			} CADET_PARFOR_END;
 		}
 
@@ -704,18 +940,29 @@ void GeneralRateModel::consistentInitialSensitivity(const active& t, unsigned in
 
 		solveForFluxes(sensY, idxr);
 
-		// Step 2: Compute the correct time derivative of the state vector
-
-		// Step 2a: Assemble, factorize, and solve diagonal blocks of linear system
-
-		// Compute right hand side by adding -dF / dy * s = -J * s to -dF / dp which is already stored in sensYdot
+		// Step 2 right hand side: add -dF / dy * s = -J * s to -dF / dp which is already stored in sensYdot
 		multiplyWithJacobian(sensY, -1.0, 1.0, sensYdot);
 
 		// Note that we have correctly negated the right hand side
+	}
+
+	// The dense algebraic solves above reused the memory of _jacPdisc as scratch space,
+	// which destroys any retained factorization
+	if (_binding->hasAlgebraicEquations() && !vecSensY.empty())
+		_jacPdiscRetained = false;
+
+	// Step 2a: Assemble and factorize the diagonal blocks of the linear system. The blocks
+	// are identical for all parameters, so they are factorized only once. If the
+	// factorization of consistentInitialTimeDerivative() is still intact (same time
+	// transformation, unchanged state and Jacobians), it is handed over without a rebuild.
 
-		// Threads that are done with the bulk column blocks can proceed to the particle blocks
 #ifdef CADET_PARALLELIZE
-		BENCH_START(_timerConsistentInitPar);
+	BENCH_START(_timerConsistentInitPar);
+#endif
+
+	if (!(_jacCdiscRetained && (_jacCdiscTimeFactor == static_cast<double>(timeFactor))))
+	{
+#ifdef CADET_PARALLELIZE
 		tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
 #else
 		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
@@ -732,16 +979,14 @@ void GeneralRateModel::consistentInitialSensitivity(const active& t, unsigned in
 			{
 				LOG(Error) << "Factorize() failed for comp " << comp;
 			}
-
-			// Solve
-			const bool result2 = fbm.solve(sensYdot + comp * idxr.strideColComp() + idxr.offsetC());
-			if (!result2)
-			{
-				LOG(Error) << "Solve() failed for comp " << comp;
-			}
 		} CADET_PARFOR_END;
 
-		// Process the particle blocks
+		_jacCdiscRetained = true;
+		_jacCdiscTimeFactor = static_cast<double>(timeFactor);
+	}
+
+	if (!(_jacPdiscRetained && (_jacPdiscTimeFactor == static_cast<double>(timeFactor))))
+	{
 #ifdef CADET_PARALLELIZE
 		tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
 #else
@@ -763,7 +1008,7 @@ void GeneralRateModel::consistentInitialSensitivity(const active& t, unsigned in
 				// Populate matrix with time derivative Jacobian first
 				_binding->jacobianAddDiscretized(static_cast<double>(timeFactor), jac);
 
-				// Overwrite rows corresponding to algebraic equations with the Jacobian and set right hand side to 0
+				// Overwrite rows corresponding to algebraic equations with the Jacobian
 				if (_binding->hasAlgebraicEquations())
 				{
 					// Get start and length of algebraic block
@@ -776,24 +1021,14 @@ void GeneralRateModel::consistentInitialSensitivity(const active& t, unsigned in
 					jacAlg += algStart;
 					linalg::BandMatrix::RowIterator origJacobian = _jacP[pblk].row(j * static_cast<unsigned int>(idxr.strideParShell()) + static_cast<unsigned int>(idxr.strideParLiquid()) + algStart);
 
-					// Pointer to right hand side of algebraic block
-					double* const qShellDot = sensYdot + idxr.offsetCp(pblk) + static_cast<int>(j) * idxr.strideParShell() + idxr.strideParLiquid() + static_cast<int>(algStart);
-
-					// Copy rows and reset right hand side
+					// Copy matrix rows
 					for (unsigned int algRow = 0; algRow < algLen; ++algRow, ++jacAlg, ++origJacobian)
-					{
 						jacAlg.copyRowFrom(origJacobian);
-
-						// Right hand side is -\frac{\partial^2 res(t, y, \dot{y})}{\partial p \partial t}
-						// If the residual is not explicitly depending on time, this expression is 0
-						// @todo This is wrong if external functions are used. Take that into account!
-						qShellDot[algRow] = 0.0;
-					}
 				}
 
 				// Advance pointers over all bound states
 				jac += idxr.strideParBound();
-			}   
+			}
 
 			// Factorize
 			const bool result = fbm.factorize();
@@ -801,73 +1036,74 @@ void GeneralRateModel::consistentInitialSensitivity(const active& t, unsigned in
 			{
 				LOG(Error) << "Factorize() failed for par block " << pblk;
 			}
+		} CADET_PARFOR_END;
 
-			// Solve
-			const bool result2 = fbm.solve(sensYdot + idxr.offsetCp(pblk));
-			if (!result2)
+		_jacPdiscRetained = true;
+		_jacPdiscTimeFactor = static_cast<double>(timeFactor);
+
+		// The fresh factorization covers the full blocks, so any shell truncation from a
+		// previous linear solve no longer applies
+		std::fill(_parActiveRows.begin(), _parActiveRows.end(), std::numeric_limits<unsigned int>::max());
+	}
+
+	// Step 2b: Solve the diagonal blocks and the fluxes with the shared factorization
+	for (unsigned int param = 0; param < vecSensY.size(); ++param)
+	{
+		double* const sensYdot = vecSensYdot[param];
+
+		// Threads that are done with the bulk column blocks can proceed to the particle blocks
+#ifdef CADET_PARALLELIZE
+		tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
+#else
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+#endif
+		{
+			const bool result = _jacCdisc[comp].solve(sensYdot + comp * idxr.strideColComp() + idxr.offsetC());
+			if (!result)
 			{
-				LOG(Error) << "Solve() failed for par block " << pblk;
+				LOG(Error) << "Solve() failed for comp " << comp;
 			}
 		} CADET_PARFOR_END;
 
+		// Process the particle blocks
 #ifdef CADET_PARALLELIZE
-		BENCH_STOP(_timerConsistentInitPar);
+		tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
+#else
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
 #endif
+		{
+			// Right hand side of the algebraic rows is -\frac{\partial^2 res(t, y, \dot{y})}{\partial p \partial t}
+			// If the residual is not explicitly depending on time, this expression is 0
+			// @todo This is wrong if external functions are used. Take that into account!
+			if (_binding->hasAlgebraicEquations())
+			{
+				unsigned int algStart = 0;
+				unsigned int algLen = 0;
+				_binding->getAlgebraicBlock(algStart, algLen);
 
-		// Step 2b: Solve for fluxes j_f by backward substitution
+				for (unsigned int j = 0; j < _disc.nPar; ++j)
+				{
+					double* const qShellDot = sensYdot + idxr.offsetCp(pblk) + static_cast<int>(j) * idxr.strideParShell() + idxr.strideParLiquid() + static_cast<int>(algStart);
+					std::fill(qShellDot, qShellDot + algLen, 0.0);
+				}
+			}
+
+			const bool result = _jacPdisc[pblk].solve(sensYdot + idxr.offsetCp(pblk));
+			if (!result)
+			{
+				LOG(Error) << "Solve() failed for par block " << pblk;
+			}
+		} CADET_PARFOR_END;
+
+		// Solve for fluxes j_f by backward substitution
 		solveForFluxes(sensYdot, idxr);
 	}
+
+#ifdef CADET_PARALLELIZE
+	BENCH_STOP(_timerConsistentInitPar);
+#endif
 }
 
-/**
- * @brief Computes approximately / partially consistent initial values and time derivatives of sensitivity subsystems
- * @details Given the DAE \f[ F(t, y, \dot{y}) = 0, \f] and initial values \f$ y_0 \f$ and \f$ \dot{y}_0 \f$,
- *          the sensitivity system for a parameter @f$ p @f$ reads
- *          \f[ \frac{\partial F}{\partial y}(t, y, \dot{y}) s + \frac{\partial F}{\partial \dot{y}}(t, y, \dot{y}) \dot{s} + \frac{\partial F}{\partial p}(t, y, \dot{y}) = 0. \f]
- *          The initial values of this linear DAE, @f$ s_0 = \frac{\partial y_0}{\partial p} @f$ and @f$ \dot{s}_0 = \frac{\partial \dot{y}_0}{\partial p} @f$
- *          have to be consistent with the sensitivity DAE. This functions updates the initial sensitivity\f$ s_0 \f$ and overwrites the time
- *          derivative \f$ \dot{s}_0 \f$ such that they are consistent.
- *          
- *          The process follows closely the one of leanConsistentInitialConditions() and, in fact, is a linearized version of it.
- *          This is necessary because the initial conditions of the sensitivity system \f$ s_0 \f$ and \f$ \dot{s}_0 \f$ are
- *          related to the initial conditions \f$ y_0 \f$ and \f$ \dot{y}_0 \f$ of the original DAE by differentiating them
- *          with respect to @f$ p @f$: @f$ s_0 = \frac{\partial y_0}{\partial p} @f$ and @f$ \dot{s}_0 = \frac{\partial \dot{y}_0}{\partial p}. @f$
- *          <ol>
- *              <li>Keep state and time derivative vectors as they are (i.e., do not solve algebraic equations).
- *                 Only solve for the fluxes @f$ j_{f,i} @f$ (only linear equations).</li>
- *              <li>Compute the time derivatives of the sensitivity @f$ \dot{s} @f$ such that the differential equations hold.
- *                 However, because of the algebraic equations, we need additional conditions to fully determine
- *                 @f$ \dot{s}@f$. By differentiating the algebraic equations with respect to time, we get the
- *                 missing linear equations (recall that the sensitivity vector @f$ s @f$ is fixed). The resulting
- *                 equations are stated below:
- *                 @f[ \begin{align}
- *                  \left[\begin{array}{c|ccc|c}
- *                     \dot{J}_0  &         &        &           &   \\
- *                     \hline
- *                        J_{f,0} & J_{f,1} & \dots & J_{f,N_z} & I
- *                  \end{array}\right],
- *                 \end{align} @f]
- *                 where @f$ \dot{J}_0 @f$ denotes the bulk block Jacobian with respect to @f$ \dot{y}@f$.
- *                
- *     Let @f$ \mathcal{I}_d @f$ denote the index set of differential equations.
- *     The right hand side of the linear system is given by @f[ -\frac{\partial F}{\partial y}(t, y, \dot{y}) s - \frac{\partial F}{\partial p}(t, y, \dot{y}), @f]
- *     which is 0 for algebraic equations (@f$ -\frac{\partial^2 F}{\partial t \partial p}@f$, to be more precise).
- *     
- *     The linear system is solved by backsubstitution. First, the bulk block is solved.
- *     Then, the equations for the fluxes @f$ j_f @f$ are solved by substituting in the solution of the
- *     bulk block and the unchanged particle block time derivative vectors.</li>
- *          </ol>
- *     This function requires the parameter sensitivities to be computed beforehand and up-to-date Jacobians.
- * @param [in] t Current time point
- * @param [in] secIdx Index of the current section
- * @param [in] timeFactor Used for time transformation (pre factor of time derivatives) and to compute parameter derivatives with respect to section length
- * @param [in] vecStateY State vector with consistent initial values of the original system
- * @param [in] vecStateYdot Time derivative state vector with consistent initial values of the original system
- * @param [in,out] vecSensY Sensitivity subsystem state vectors
- * @param [in,out] vecSensYdot Time derivative state vectors of the sensitivity subsystems to be initialized
- * @param [in] adRes Pointer to global residual vector of AD datatypes with parameter sensitivities
- * @todo Decrease amount of allocated memory by partially using temporary vectors (state and Schur complement)
- */
 void GeneralRateModel::leanConsistentInitialSensitivity(const active& t, unsigned int secIdx, const active& timeFactor, double const* vecStateY, double const* vecStateYdot,
 	std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, active const* const adRes)
 {
@@ -895,17 +1131,23 @@ void GeneralRateModel::leanConsistentInitialSensitivity(const active& t, unsigne
 
 		solveForFluxes(sensY, idxr);
 
-		// Step 2: Compute the correct time derivative of the state vector
-
-		// Step 2a: Assemble, factorize, and solve diagonal blocks of linear system
-
-		// Compute right hand side by adding -dF / dy * s = -J * s to -dF / dp which is already stored in sensYdot
+		// Step 2 right hand side: add -dF / dy * s = -J * s to -dF / dp which is already stored in sensYdot
 		multiplyWithJacobian(sensY, -1.0, 1.0, sensYdot);
 
 		// Note that we have correctly negated the right hand side
+	}
+
+	// Step 2a: Assemble and factorize the bulk blocks of the linear system. The blocks are
+	// identical for all parameters, so they are factorized only once; a retained
+	// factorization (e.g., of leanConsistentInitialTimeDerivative()) is handed over as is.
+
+#ifdef CADET_PARALLELIZE
+	BENCH_START(_timerConsistentInitPar);
+#endif
 
+	if (!(_jacCdiscRetained && (_jacCdiscTimeFactor == static_cast<double>(timeFactor))))
+	{
 #ifdef CADET_PARALLELIZE
-		BENCH_START(_timerConsistentInitPar);
 		tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
 #else
 		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
@@ -922,22 +1164,37 @@ void GeneralRateModel::leanConsistentInitialSensitivity(const active& t, unsigne
 			{
 				LOG(Error) << "Factorize() failed for comp " << comp;
 			}
+		} CADET_PARFOR_END;
+
+		_jacCdiscRetained = true;
+		_jacCdiscTimeFactor = static_cast<double>(timeFactor);
+	}
+
+	// Step 2b: Solve the bulk blocks and the fluxes with the shared factorization
+	for (unsigned int param = 0; param < vecSensY.size(); ++param)
+	{
+		double* const sensYdot = vecSensYdot[param];
 
-			// Solve
-			const bool result2 = fbm.solve(sensYdot + comp * idxr.strideColComp() + idxr.offsetC());
-			if (!result2)
+#ifdef CADET_PARALLELIZE
+		tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
+#else
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+#endif
+		{
+			const bool result = _jacCdisc[comp].solve(sensYdot + comp * idxr.strideColComp() + idxr.offsetC());
+			if (!result)
 			{
 				LOG(Error) << "Solve() failed for comp " << comp;
 			}
 		} CADET_PARFOR_END;
 
-#ifdef CADET_PARALLELIZE
-		BENCH_STOP(_timerConsistentInitPar);
-#endif
-
-		// Step 2b: Solve for fluxes j_f by backward substitution
+		// Solve for fluxes j_f by backward substitution
 		solveForFluxes(sensYdot, idxr);
 	}
+
+#ifdef CADET_PARALLELIZE
+	BENCH_STOP(_timerConsistentInitPar);
+#endif
 }
 
 /**
@@ -950,16 +1207,38 @@ void GeneralRateModel::leanConsistentInitialSensitivity(const active& t, unsigne
  */
 void GeneralRateModel::solveForFluxes(double* const vecState, const Indexer& idxr)
 {
-	// We have j_f - k_f * (c - c_p) == 0 
-	// Thus, jacFC contains -k_f and jacFP +k_f.
-	// We just need to subtract both -k_f * c and k_f * c_p to get j_f == k_f * (c - c_p)
+	// We have j_f - k_f * (c - c_p) == y, so j_f == y + k_f * (c - c_p) with y given
+	// in the flux variables; one fused pass over the flux segment adds the rest
+	subtractFluxRows(vecState, vecState + idxr.offsetJf(), idxr);
+}
 
+/**
+ * @brief Solves the algebraic flux equations for the fluxes @f$ j_f @f$ with zero right hand side
+ * @details Same as solveForFluxes() for the special case @f$ y = 0 @f$, which occurs in every
+ *          consistent initialization variant. The solution @f$ k_f \left( c - c_p \right) @f$
+ *          directly overwrites the flux variables instead of resetting them to @c 0.0 first,
+ *          see subtractFluxRows() for the layout of the fused pass.
+ * @param [in,out] vecState On entry the state vector with arbitrary flux variables @f$ j_f @f$,
+ *                 on exit the solution @f$ j_f. @f$
+ * @param [in] idxr Indexer
+ */
+void GeneralRateModel::solveForFluxesZeroRhs(double* const vecState, const Indexer& idxr)
+{
+	double const* const c = vecState + idxr.offsetC();
+	double const* const cp = vecState + idxr.offsetCp();
 	double* const jf = vecState + idxr.offsetJf();
+	const int strideCp = idxr.strideParBlock();
 
-	// Note that we cannot parallelize this loop since we are updating the fluxes in-place
-	_jacFC.multiplySubtract(vecState + idxr.offsetC(), jf);
-	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
-		_jacFP[pblk].multiplySubtract(vecState + idxr.offsetCp(pblk), jf);
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		const double kf = _curKfFVDense[comp];
+		double const* const cComp = c + comp * idxr.strideColComp();
+		double const* const cpComp = cp + comp;
+		double* const jfComp = jf + comp * idxr.strideColComp();
+
+		for (unsigned int col = 0; col < _disc.nCol; ++col)
+			jfComp[col] = kf * (cComp[col] - cpComp[col * strideCp]);
+	}
 }
 
 }  // namespace model
@@ -16,7 +16,9 @@
 #include "AdUtils.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <limits>
 
 #include "LoggingUtils.hpp"
 #include "Logging.hpp"
@@ -36,6 +38,17 @@ namespace cadet
 namespace model
 {
 
+namespace
+{
+	// Number of adjacent particle blocks solved by one task; the blocks are small,
+	// identical, and contiguous in memory, so batching them amortizes scheduling
+	// overhead (see util::parallelBatchedFor)
+	const std::size_t particleBlockBatchSize = 8;
+}
+
+// Wrapper around schurPreconditionerSolve(), defined in GeneralRateModel.cpp
+int schurComplementPreconditionerGRM(void* userData, double const* r, double* z);
+
 /**
  * @brief Computes the solution of the linear system involving the system Jacobian
  * @details The system \f[ \left( \frac{\partial F}{\partial y} + \alpha \frac{\partial F}{\partial \dot{y}} \right) x = b \f]
@@ -94,6 +107,12 @@ namespace model
  *                 @f[ y_f = b_f - \sum_{i=0}^{N_z} J_{f,i} y_i. @f]
  *              -# Solve the Schur-complement @f$ S x_f = y_f @f$ using an iterative method that only requires
  *                 matrix-vector products. The already inverted diagonal blocks @f$ J_i^{-1} @f$ come in handy here.
+ *                 The GMRES tolerance can optionally track the Newton convergence progress with
+ *                 Eisenstat-Walker forcing terms (see @c SCHUR_FORCING_MAX), so that early Newton
+ *                 iterations use loose, cheap solves.
+ *                 For small discretizations (at most @c DIRECT_SCHUR_THRESHOLD flux DOFs), @f$ S @f$ is instead
+ *                 assembled as a dense matrix and factorized together with the diagonal blocks, so that this
+ *                 step reduces to a direct triangular solve (see assembleAndFactorizeDirectSchur()).
  *              -# Solve the rest of the @f$ U x = y @f$ system by backward substitution. To be more precise, compute
  *                 @f[ x_i = y_i - J_i^{-1} J_{i,f} y_f. @f]
  *
@@ -116,10 +135,68 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 
 	Indexer idxr(_disc);
 
+	// ==== Step 0: Check frozen particle shells for reactivation
+
+	// Truncated particle factorizations assume the inner shells stay converged. The
+	// assumption is verified exactly on every solve: if the residual of a frozen state
+	// exceeds the threshold again, all blocks are refactorized at full dimension and
+	// truncation is suspended for this call (the next factorization may re-freeze
+	// shells from the then-current time derivatives).
+	const unsigned int fullParRows = _disc.nPar * (_disc.nComp + _disc.strideBound);
+	bool allowTruncation = (_parShellTruncThreshold > 0.0) && yDot && weight;
+	bool forceFullRefactorization = false;
+	if ((_parShellTruncThreshold > 0.0) && res && weight)
+	{
+		bool reactivate = false;
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+		{
+			const unsigned int actRows = _parActiveRows[pblk];
+			if (actRows >= fullParRows)
+				continue;
+
+			double const* const localRes = res + idxr.offsetCp(pblk);
+			double const* const localWeight = weight + idxr.offsetCp(pblk);
+			for (unsigned int i = actRows; i < fullParRows; ++i)
+			{
+				if (std::abs(localRes[i]) * localWeight[i] >= _parShellTruncThreshold)
+				{
+					reactivate = true;
+					break;
+				}
+			}
+			if (reactivate)
+				break;
+		}
+
+		if (cadet_unlikely(reactivate))
+		{
+			std::fill(_parActiveRows.begin(), _parActiveRows.end(), std::numeric_limits<unsigned int>::max());
+			allowTruncation = false;
+			forceFullRefactorization = true;
+			_factorizeJacobian = true;
+		}
+	}
+
 	// ==== Step 1: Factorize diagonal Jacobian blocks
 
 	// Factorize partial Jacobians only if required
 
+	// Check whether the current factorization can be reused although a new setup has been
+	// requested: In smooth sections the Jacobian and the BDF coefficient alpha change only
+	// negligibly between consecutive Newton iterations, so the (slightly stale) factorization
+	// still yields fast convergence. The factorization is refreshed once alpha has drifted too
+	// far, the Schur-complement solves have slowed down noticeably (degrading Newton
+	// convergence), or the factorization has reached its maximum age.
+	bool refactorized = false;
+	bool reuseFactorization = false;
+	if (!forceFullRefactorization && _factorizeJacobian && (_factorizationAlphaTol > 0.0) && (_lastFactorizationAlpha > 0.0) && (_factorizationAge < _maxFactorizationAge))
+	{
+		const double alphaDrift = std::abs(alpha - _lastFactorizationAlpha) / _lastFactorizationAlpha;
+		// The GMRES convergence criterion does not apply on the direct Schur-complement path
+		const bool schurConverging = _useDirectSchur || (_gmres.lastNumIterations() <= 2 * _gmresIterRef + 4);
+		reuseFactorization = (alphaDrift <= _factorizationAlphaTol) && schurConverging;
+	}
+
 #ifdef CADET_PARALLELIZE
 	tbb::flow::graph g;
 #endif
@@ -128,56 +205,87 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 	node_t A(g, [&](msg_t)
 	{
 #endif
-		if (_factorizeJacobian)
+		if (_factorizeJacobian && !reuseFactorization)
 		{
+			// The Schur-complement changes with the Jacobian, so previously
+			// recycled Krylov directions are no longer valid
+			if (!_useDirectSchur)
+				_gmres.clearRecycleSpace();
+
 			// Assemble and factorize discretized system Jacobians
-			// Threads that are done with the bulk column blocks can proceed to the particle blocks
+			// All diagonal blocks are independent, so bulk column and particle blocks are
+			// factorized from one work queue. Threads that are done with the few bulk
+			// column blocks immediately proceed to the many particle blocks.
 
 #ifdef CADET_PARALLELIZE
-			tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
+			tbb::parallel_for(size_t(0), size_t(_disc.nComp + _disc.nCol), [&](size_t idx)
 #else
-			for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+			for (unsigned int idx = 0; idx < _disc.nComp + _disc.nCol; ++idx)
 #endif
 			{
-				// Assemble
-				assembleDiscretizedJacobianColumnBlock(comp, alpha, idxr, timeFactor);
-
-				// Factorize
-				const bool result = _jacCdisc[comp].factorize();
-				if (cadet_unlikely(!result))
+				if (cadet_unlikely(idx < _disc.nComp))
 				{
-					LOG(Error) << "Factorize() failed for comp " << comp;
-				}
-			} CADET_PARFOR_END;
-		}
-	CADET_PARNODE_END;
-
+					const unsigned int comp = idx;
 
-	// Process the particle blocks
-#ifdef CADET_PARALLELIZE
-	node_t B(g, [&](msg_t)
-	{
-#endif
-		if (_factorizeJacobian)
-		{
-#ifdef CADET_PARALLELIZE
-			tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
-#else
-			for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
-#endif
-			{
-				// Assemble
-				assembleDiscretizedJacobianParticleBlock(pblk, alpha, idxr, timeFactor);
+					// Assemble
+					assembleDiscretizedJacobianColumnBlock(comp, alpha, idxr, timeFactor);
 
-				// Factorize
-				const bool result = _jacPdisc[pblk].factorize();
-				if (cadet_unlikely(!result))
+					// Factorize
+					const bool result = _mixedPrecisionBulk ? _jacCdisc[comp].factorizeMixedPrecision() : _jacCdisc[comp].factorize();
+					if (cadet_unlikely(!result))
+					{
+						LOG(Error) << "Factorize() failed for comp " << comp;
+					}
+				}
+				else
 				{
+					const unsigned int pblk = idx - _disc.nComp;
+
+					// Assemble
+					assembleDiscretizedJacobianParticleBlock(pblk, alpha, idxr, timeFactor);
+
+					// Freeze converged inner shells by truncating the factorization to the
+					// active leading rows; the mixed precision path always runs at full
+					// dimension since it maintains its own single precision copy
+					unsigned int actRows = std::numeric_limits<unsigned int>::max();
+					if (allowTruncation)
+						actRows = activeParticleRows(pblk, weight, yDot, idxr);
+					_parActiveRows[pblk] = actRows;
+
+					// Factorize
+					bool result;
+					if (cadet_unlikely(actRows < fullParRows))
+						result = _jacPdisc[pblk].factorize(actRows);
+					else
+						result = _mixedPrecisionParticle ? _jacPdisc[pblk].factorizeMixedPrecision() : _jacPdisc[pblk].factorize();
+					if (cadet_unlikely(!result))
 					{
 						LOG(Error) << "Factorize() failed for par block " << pblk;
 					}
 				}
 			} CADET_PARFOR_END;
+
+			_lastFactorizationAlpha = alpha;
+			_factorizationAge = 0;
+			refactorized = true;
+
+			// The blocks now hold the discretized system Jacobians, any retained
+			// time-derivative factorization from consistent initialization is gone
+			_jacCdiscRetained = false;
+			_jacPdiscRetained = false;
+
+			// With fresh diagonal factorizations in place, rebuild the dense
+			// Schur-complement for the direct solver path or refresh the
+			// block-Jacobi preconditioner of the GMRES path
+			if (_useDirectSchur)
+				assembleAndFactorizeDirectSchur();
+			else if (_schurPrecond)
+				assembleSchurPreconditioner();
+		}
+		else if (_factorizeJacobian)
+		{
+			// Serve this setup request with the existing factorization
+			++_factorizationAge;
 		}
 	CADET_PARNODE_END;
 
@@ -210,7 +318,7 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
 #endif
 		{
-			const bool result = _jacCdisc[comp].solve(rhs + comp * idxr.strideColComp() + idxr.offsetC());
+			const bool result = _mixedPrecisionBulk ? _jacCdisc[comp].solveMixedPrecision(rhs + comp * idxr.strideColComp() + idxr.offsetC()) : _jacCdisc[comp].solve(rhs + comp * idxr.strideColComp() + idxr.offsetC());
 			if (cadet_unlikely(!result))
 			{
 				LOG(Error) << "Solve() failed for comp " << comp;
@@ -222,56 +330,118 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 	node_t E(g, [&](msg_t)
 	{
 #endif
-#ifdef CADET_PARALLELIZE
-		tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
-#else
-		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
-#endif
+		util::parallelBatchedFor(0, _disc.nCol, particleBlockBatchSize, [&](std::size_t pblk)
 		{
-			const bool result = _jacPdisc[pblk].solve(rhs + idxr.offsetCp(pblk));
+			const bool result = solveParticleBlock(pblk, rhs + idxr.offsetCp(pblk));
 			if (cadet_unlikely(!result))
 			{
 				LOG(Error) << "Solve() failed for par block " << pblk;
 			}
-		} CADET_PARFOR_END;
+		});
 	CADET_PARNODE_END;
 
 	// Solve last row of L with backwards substitution: y_f = b_f - \sum_{i=0}^{N_z} J_{f,i} y_i
-	// Note that we cannot easily parallelize this loop since the results of the sparse
-	// matrix-vector multiplications are added in-place to rhs. We would need one copy of rhs
-	// for each thread and later fuse them together (reduction statement).
 #ifdef CADET_PARALLELIZE
 	node_t F(g, [&](msg_t) 
 	{
 #endif
-		_jacFC.multiplySubtract(rhs + idxr.offsetC(), rhs + idxr.offsetJf());
-
-		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
-		{
-			_jacFP[pblk].multiplySubtract(rhs + idxr.offsetCp(pblk), rhs + idxr.offsetJf());
-		}
+		subtractFluxRows(rhs, rhs + idxr.offsetJf(), idxr);
 
 		// Now, rhs contains the full intermediate solution y = L^{-1} b
 
-		// Initialize temporary storage by copying over the fluxes
-		// Note that the rest of _tempState is zeroed out in schurComplementMatrixVector()
-		std::copy(rhs + idxr.offsetJf(), rhs + numDofs(), _tempState + idxr.offsetJf());
-
 		// ==== Step 3: Solve Schur-complement to get x_f = S^{-1} y_f
 		// Column and particle parts remain unchanged.
-		// The only thing to be done is the iterative (and approximate)
-		// solution of the Schur complement system:
+		// The only thing to be done is the solution of the Schur complement system:
 		//     S * x_f = y_f
 
 		// Note that rhs is updated in-place with the solution of the Schur-complement
-		// The temporary storage is only needed to hold the right hand side of the Schur-complement
-		const double tolerance = std::sqrt(static_cast<double>(numDofs())) * outerTol * _schurSafety;
+		if (_useDirectSchur)
+		{
+			// Direct path: S has been assembled and factorized together with the
+			// diagonal blocks, so a single triangular solve replaces the GMRES iteration
+			BENCH_START(_timerGmres);
+			const bool result = _schurDirect.solve(rhs + idxr.offsetJf());
+			BENCH_STOP(_timerGmres);
+			if (cadet_unlikely(!result))
+			{
+				LOG(Error) << "Solve() failed for direct Schur-complement";
+			}
+		}
+		else
+		{
+			// Initialize temporary storage by copying over the fluxes
+			// Note that the rest of _tempState is zeroed out in schurComplementMatrixVector()
+			std::copy(rhs + idxr.offsetJf(), rhs + numDofs(), _tempState + idxr.offsetJf());
+
+			// The temporary storage is only needed to hold the right hand side of the Schur-complement
+			double tolerance = std::sqrt(static_cast<double>(numDofs())) * outerTol * _schurSafety;
+
+			// Eisenstat-Walker forcing: early Newton iterations of a step only need the linear
+			// system solved to a fraction of the current nonlinear residual. The forcing term
+			// eta is set from the contraction of the weighted flux residual between consecutive
+			// linear solves of the same step (identified by unchanged t and alpha); the first
+			// solve of a step uses the loosest eta. The fixed tolerance above remains the lower
+			// bound, so the final Newton iterations are solved as accurately as without forcing.
+			if (_schurForcingMax > 0.0)
+			{
+				double resNorm = 0.0;
+				double const* const fluxRhs = rhs + idxr.offsetJf();
+				double const* const fluxWeight = weight + idxr.offsetJf();
+				for (unsigned int i = 0; i < numDofs() - idxr.offsetJf(); ++i)
+					resNorm += sqr(fluxRhs[i] * fluxWeight[i]);
+				resNorm = std::sqrt(resNorm);
+
+				const bool sameStep = (t == _schurLastT) && (alpha == _schurLastAlpha);
+				double eta = _schurForcingMax;
+				if (sameStep && (_schurPrevResNorm > 0.0))
+				{
+					// Choice 2 of Eisenstat and Walker: eta_k = gamma * (|r_k| / |r_{k-1}|)^2
+					// with safeguard against premature tightening after a fast previous eta
+					const double ratio = resNorm / _schurPrevResNorm;
+					eta = 0.9 * ratio * ratio;
+					const double etaSafe = 0.9 * _schurForcing * _schurForcing;
+					if (etaSafe > 0.1)
+						eta = std::max(eta, etaSafe);
+					eta = std::min(eta, _schurForcingMax);
+				}
+				_schurForcing = eta;
+				_schurPrevResNorm = resNorm;
+				_schurLastT = t;
+				_schurLastAlpha = alpha;
+
+				tolerance = std::max(tolerance, eta * resNorm);
+			}
+
+			BENCH_START(_timerGmres);
+			int gmresResult = _gmres.solve(tolerance, weight + idxr.offsetJf(), _tempState + idxr.offsetJf(), rhs + idxr.offsetJf());
+			BENCH_STOP(_timerGmres);
+
+			// If the preconditioned iteration stalls (no convergence within the restart
+			// budget), drop the block-Jacobi preconditioner and repeat the solve with the
+			// exact operator alone; the preconditioner stays disabled until it is refreshed
+			// by the next refactorization
+			if (cadet_unlikely((gmresResult != 0) && _schurPrecondActive))
+			{
+				LOG(Debug) << "Schur-complement GMRES stalled with preconditioner (" << _gmres.getReturnFlagName(gmresResult) << "), falling back to unpreconditioned solve";
+
+				_schurPrecondActive = false;
+				_gmres.preconditioner(nullptr, linalg::PreconditionerSide::None);
+
+				// Restore the initial guess, which is the right hand side y_f itself
+				std::copy(_tempState + idxr.offsetJf(), _tempState + numDofs(), rhs + idxr.offsetJf());
 
-		BENCH_START(_timerGmres);
-		const int gmresResult = _gmres.solve(tolerance, weight + idxr.offsetJf(), _tempState + idxr.offsetJf(), rhs + idxr.offsetJf());
-		BENCH_STOP(_timerGmres);
+				BENCH_START(_timerGmres);
+				gmresResult = _gmres.solve(tolerance, weight + idxr.offsetJf(), _tempState + idxr.offsetJf(), rhs + idxr.offsetJf());
+				BENCH_STOP(_timerGmres);
+			}
+
+			// Remember how fast the Schur-complement solve converges with a fresh
+			// factorization as reference for the reuse policy
+			if (refactorized)
+				_gmresIterRef = _gmres.lastNumIterations();
+		}
 
-			// Remove temporary results that are leftovers from schurComplementMatrixVector()
+		// Remove temporary results that are leftovers from schurComplementMatrixVector()
 		std::fill(_tempState + idxr.offsetC(), _tempState + idxr.offsetJf(), 0.0);
 
 		// At this point, rhs contains the intermediate solution [y_0, ..., y_{N_z}, x_f]
@@ -280,7 +450,7 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 		// The fluxes are already solved and remain unchanged
 
 		// Compute tempState_0 = J_{0,f} * y_f
-		_jacCF.multiplyAdd(rhs + idxr.offsetJf(), _tempState + idxr.offsetC());
+		_jacCFCompressed.multiplyAdd(rhs + idxr.offsetJf(), _tempState + idxr.offsetC());
 	CADET_PARNODE_END;
 
 	// Threads that are done with solving the bulk column blocks can proceed
@@ -299,7 +469,7 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 			double* const rhsCol = rhs + comp * idxr.strideColComp() + idxr.offsetC();
 
 			// Apply J_0^{-1} to tempState_0
-			const bool result = _jacCdisc[comp].solve(localCol);
+			const bool result = _mixedPrecisionBulk ? _jacCdisc[comp].solveMixedPrecision(localCol) : _jacCdisc[comp].solve(localCol);
 			if (cadet_unlikely(!result))
 			{
 				LOG(Error) << "Solve() failed for comp " << comp;
@@ -315,19 +485,15 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 	node_t H(g, [&](msg_t) 
 	{
 #endif
-#ifdef CADET_PARALLELIZE
-		tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
-#else
-		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
-#endif
+		util::parallelBatchedFor(0, _disc.nCol, particleBlockBatchSize, [&](std::size_t pblk)
 		{
 			double* const localPar = _tempState + idxr.offsetCp(pblk);
 			double* const rhsPar = rhs + idxr.offsetCp(pblk);
 
 			// Compute tempState_i = J_{i,f} * y_f
-			_jacPF[pblk].multiplyAdd(rhs + idxr.offsetJf(), localPar);
+			_jacPFCompressed[pblk].multiplyAdd(rhs + idxr.offsetJf(), localPar);
 			// Apply J_i^{-1} to tempState_i
-			const bool result = _jacPdisc[pblk].solve(localPar);
+			const bool result = solveParticleBlock(pblk, localPar);
 			if (cadet_unlikely(!result))
 			{
 				LOG(Error) << "Solve() failed for par block " << pblk;
@@ -336,13 +502,12 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 			// Compute rhs_i = y_i - J_i^{-1} * J_{i,f} * y_f = y_i - tempState_i
 			for (int i = 0; i < idxr.strideParBlock(); ++i)
 				rhsPar[i] -= localPar[i];
-		} CADET_PARFOR_END;
+		});
 	CADET_PARNODE_END;
 
 #ifdef CADET_PARALLELIZE
 	// Create TBB dependency graph
 	make_edge(A, C);
-	make_edge(B, C);
 
 	make_edge(C, D);
 	make_edge(C, E);
@@ -353,7 +518,6 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 
 	// Start the graph running
 	A.try_put(tbb::flow::continue_msg());
-	B.try_put(tbb::flow::continue_msg());
 
 	// Wait for results
 	g.wait_for_all();
@@ -363,6 +527,83 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 	return 0;
 }
 
+/**
+ * @brief Determines the number of active (leading) rows of a particle block
+ * @details Deep particle shells near the center often reach equilibrium early in a time
+ *          section and stop changing. This function scans the shells of particle block
+ *          @p pblk from the center outwards (shells are stored outermost first, so the
+ *          innermost shells occupy the trailing rows) and freezes the maximal run of
+ *          trailing shells whose states have all converged, i.e., whose weighted time
+ *          derivatives @f$ \left| \dot{y}_i \right| w_i @f$ have dropped below
+ *          @c PAR_SHELL_TRUNCATION. A shell is only frozen together with all shells
+ *          inside it, and the outermost shell always stays active since it couples to
+ *          the film flux.
+ *
+ *          Frozen shells are cut off the factorization (see linearSolve()), turning the
+ *          Newton matrix into an approximation whose error is controlled by the
+ *          threshold; the exact residual-based reactivation check in linearSolve()
+ *          restores the full system as soon as a frozen state starts moving again.
+ *
+ * @param [in] pblk Index of the particle block
+ * @param [in] weight Vector with error weights
+ * @param [in] yDot Pointer to global time derivative state vector
+ * @param [in] idxr Indexer
+ * @return Number of active leading rows of the particle block
+ */
+unsigned int GeneralRateModel::activeParticleRows(unsigned int pblk, double const* weight, double const* yDot, const Indexer& idxr) const
+{
+	const unsigned int strideShell = idxr.strideParShell();
+	double const* const localDot = yDot + idxr.offsetCp(pblk);
+	double const* const localWeight = weight + idxr.offsetCp(pblk);
+
+	unsigned int activeShells = _disc.nPar;
+	while (activeShells > 1)
+	{
+		double const* const shellDot = localDot + (activeShells - 1) * strideShell;
+		double const* const shellWeight = localWeight + (activeShells - 1) * strideShell;
+
+		bool converged = true;
+		for (unsigned int i = 0; i < strideShell; ++i)
+		{
+			if (std::abs(shellDot[i]) * shellWeight[i] >= _parShellTruncThreshold)
+			{
+				converged = false;
+				break;
+			}
+		}
+
+		if (!converged)
+			break;
+
+		--activeShells;
+	}
+
+	return activeShells * strideShell;
+}
+
+/**
+ * @brief Applies the inverse of a factorized particle block to @p data in place
+ * @details Dispatches to the full block solve (mixed precision if enabled) or, if the
+ *          factorization was truncated to the active leading rows (see
+ *          activeParticleRows()), to the corresponding leading subsystem solve. The
+ *          Newton update of the frozen trailing shells is zero by construction, so
+ *          their entries of @p data are simply cleared.
+ * @param [in] pblk Index of the particle block
+ * @param [in,out] data On entry the right hand side, on exit the solution
+ * @return @c true if the solve was successful, otherwise @c false
+ */
+bool GeneralRateModel::solveParticleBlock(unsigned int pblk, double* const data) const
+{
+	const unsigned int fullRows = _disc.nPar * (_disc.nComp + _disc.strideBound);
+	const unsigned int actRows = _parActiveRows[pblk];
+	if (cadet_likely(actRows >= fullRows))
+		return _mixedPrecisionParticle ? _jacPdisc[pblk].solveMixedPrecision(data) : _jacPdisc[pblk].solve(data);
+
+	const bool result = _jacPdisc[pblk].solve(actRows, data);
+	std::fill(data + actRows, data + fullRows, 0.0);
+	return result;
+}
+
 /**
  * @brief Performs the matrix-vector product @f$ z = Sx @f$ with the Schur-complement @f$ S @f$ from the Jacobian
  * @details The Schur-complement @f$ S @f$ is given by
@@ -398,7 +639,7 @@ int GeneralRateModel::schurComplementMatrixVector(double const* x, double* z) co
 	// Solve bulk column blocks first
 
 	// Apply J_{0,f}
-	_jacCF.multiplyAdd(x, _tempState + idxr.offsetC());
+	_jacCFCompressed.multiplyAdd(x, _tempState + idxr.offsetC());
 
 #ifdef CADET_PARALLELIZE
 	node_t A(g, [&](msg_t) 
@@ -412,7 +653,7 @@ int GeneralRateModel::schurComplementMatrixVector(double const* x, double* z) co
 #endif
 		{
 			// Apply J_0^{-1} of each component
-			const bool result = _jacCdisc[comp].solve(_tempState + comp * idxr.strideColComp() + idxr.offsetC());
+			const bool result = _mixedPrecisionBulk ? _jacCdisc[comp].solveMixedPrecision(_tempState + comp * idxr.strideColComp() + idxr.offsetC()) : _jacCdisc[comp].solve(_tempState + comp * idxr.strideColComp() + idxr.offsetC());
 			if (cadet_unlikely(!result))
 			{
 				LOG(Error) << "Solve() failed for comp " << comp;
@@ -435,9 +676,9 @@ int GeneralRateModel::schurComplementMatrixVector(double const* x, double* z) co
 			double* const tmp = _tempState + idxr.offsetCp(pblk);
 
 			// Apply J_{i,f}
-			_jacPF[pblk].multiplyAdd(x, tmp);
+			_jacPFCompressed[pblk].multiplyAdd(x, tmp);
 			// Apply J_{i}^{-1}
-			const bool result = _jacPdisc[pblk].solve(tmp);
+			const bool result = solveParticleBlock(pblk, tmp);
 			if (cadet_unlikely(!result))
 			{
 				LOG(Error) << "Solve() failed for par block " << pblk;
@@ -449,14 +690,8 @@ int GeneralRateModel::schurComplementMatrixVector(double const* x, double* z) co
 	node_t C(g, [&](msg_t) 
 	{
 #endif
-		// Apply J_{f,0} and subtract results from z
-		_jacFC.multiplySubtract(_tempState + idxr.offsetC(), z);
-
-		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
-		{
-			// Apply J_{f,i} and subtract results from z
-			_jacFP[pblk].multiplySubtract(_tempState + idxr.offsetCp() + idxr.strideParBlock() * pblk, z);
-		}
+		// Apply J_{f,0} and J_{f,i} and subtract the results from z
+		subtractFluxRows(_tempState, z, idxr);
 	CADET_PARNODE_END;
 
 #ifdef CADET_PARALLELIZE
@@ -474,6 +709,134 @@ int GeneralRateModel::schurComplementMatrixVector(double const* x, double* z) co
 	return 0;
 }
 
+/**
+ * @brief Assembles the Schur-complement @f$ S @f$ as a dense matrix and factorizes it
+ * @details On the direct solver path (at most @c DIRECT_SCHUR_THRESHOLD flux DOFs), the
+ *          Schur-complement is not solved iteratively but factorized once per setup. The
+ *          dense matrix is built column by column by applying schurComplementMatrixVector()
+ *          to unit vectors, which reuses the freshly factorized diagonal blocks and the
+ *          sparse off-diagonal blocks; the block solves inside each product run in parallel.
+ *          The factorization is refreshed exactly when the diagonal blocks are refactorized,
+ *          so it participates in the factorization reuse policy of linearSolve() for free.
+ */
+void GeneralRateModel::assembleAndFactorizeDirectSchur()
+{
+	const unsigned int numFluxDofs = _disc.nCol * _disc.nComp;
+	const Indexer idxr(_disc);
+
+	// The flux part of _tempState is free at this point (it is initialized in
+	// linearSolve() only after the factorization step), so it holds the unit vectors
+	double* const unitVec = _tempState + idxr.offsetJf();
+	std::fill(unitVec, unitVec + numFluxDofs, 0.0);
+
+	for (unsigned int col = 0; col < numFluxDofs; ++col)
+	{
+		unitVec[col] = 1.0;
+		schurComplementMatrixVector(unitVec, _schurColBuffer.data());
+		unitVec[col] = 0.0;
+
+		for (unsigned int row = 0; row < numFluxDofs; ++row)
+			_schurDirect.native(row, col) = _schurColBuffer[row];
+	}
+
+	if (cadet_unlikely(!_schurDirect.factorize()))
+	{
+		LOG(Error) << "Factorize() failed for direct Schur-complement";
+	}
+}
+
+/**
+ * @brief Assembles and factorizes the block-Jacobi preconditioner of the Schur-complement GMRES
+ * @details The particle contribution @f$ J_{f,p} \, J_p^{-1} \, J_{p,f} @f$ couples only the
+ *          flux DOFs of column cell @f$ p @f$: the particle boundary condition reads the fluxes
+ *          of its own cell and the flux equation reads the outer shell of its own particle
+ *          block (see assembleOffdiagJac()). Hence, this contribution is block-diagonal with
+ *          one dense block of size number of components per cell. The blocks, including the
+ *          identity @f$ J_f @f$, are assembled exactly from the freshly factorized particle
+ *          blocks and registered as right preconditioner; only the axial coupling through the
+ *          bulk contribution @f$ J_{f,0} \, J_0^{-1} \, J_{0,f} @f$ is left to the GMRES
+ *          iteration. The assembly costs one particle block solve per cell and component once
+ *          per refactorization, which the factorization reuse policy of linearSolve()
+ *          amortizes over many solves; applying the factorized blocks in an iteration is
+ *          negligible compared to the exact operator application.
+ */
+void GeneralRateModel::assembleSchurPreconditioner()
+{
+	const Indexer idxr(_disc);
+	const unsigned int parRows = _disc.nPar * (_disc.nComp + _disc.strideBound);
+
+	// The flux part of _tempState is free at this point (it is initialized in linearSolve()
+	// only after the factorization step), so it holds the unit vectors; each cell only
+	// toggles its own flux entries, so the vector is shared across the parallel batches
+	double* const fluxUnit = _tempState + idxr.offsetJf();
+	std::fill(fluxUnit, fluxUnit + _disc.nCol * _disc.nComp, 0.0);
+
+	util::parallelBatchedFor(0, _disc.nCol, particleBlockBatchSize, [&](std::size_t pblk)
+	{
+		linalg::DenseMatrix& blk = _schurPrecondBlocks[pblk];
+		double* const tmp = _tempState + idxr.offsetCp(pblk);
+
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+		{
+			const unsigned int eq = pblk * idxr.strideColCell() + comp * idxr.strideColComp();
+			fluxUnit[eq] = 1.0;
+
+			// Apply J_{p,f} and J_p^{-1} to the unit vector of flux DOF (pblk, comp)
+			std::fill(tmp, tmp + parRows, 0.0);
+			_jacPFCompressed[pblk].multiplyAdd(fluxUnit, tmp);
+			const bool result = solveParticleBlock(pblk, tmp);
+			if (cadet_unlikely(!result))
+			{
+				LOG(Error) << "Solve() failed for par block " << pblk;
+			}
+
+			fluxUnit[eq] = 0.0;
+
+			// Apply the flux rows J_{f,p} to the outer shell of the result and add the
+			// identity of J_f (cf. subtractFluxRows())
+			for (unsigned int row = 0; row < _disc.nComp; ++row)
+				blk.native(row, comp) = ((row == comp) ? 1.0 : 0.0) - _curKfFVDense[row] * tmp[row];
+		}
+
+		if (cadet_unlikely(!blk.factorize()))
+		{
+			LOG(Error) << "Factorize() failed for preconditioner block " << pblk;
+		}
+	});
+
+	// (Re)enable the preconditioner with the refreshed blocks
+	_schurPrecondActive = true;
+	_gmres.preconditioner(&schurComplementPreconditionerGRM, linalg::PreconditionerSide::Right);
+}
+
+/**
+ * @brief Applies the inverse of the block-Jacobi preconditioner, @f$ z = M^{-1} r @f$
+ * @details Solves the factorized per-cell blocks assembled in assembleSchurPreconditioner().
+ *          Each block couples the flux DOFs of one column cell, which are strided in the
+ *          component-major flux vector, so the entries are gathered into a contiguous
+ *          buffer, solved in place, and scattered back.
+ * @param [in] r Right hand side of the preconditioner equation
+ * @param [out] z Solution of the preconditioner equation
+ * @return @c 0 if successful, @c 1 on a failed block solve (recoverable)
+ */
+int GeneralRateModel::schurPreconditionerSolve(double const* r, double* z) const
+{
+	int flag = 0;
+	double* const buf = _schurPrecondBuffer.data();
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	{
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+			buf[comp] = r[pblk + comp * _disc.nCol];
+
+		if (cadet_unlikely(!_schurPrecondBlocks[pblk].solve(buf)))
+			flag = 1;
+
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+			z[pblk + comp * _disc.nCol] = buf[comp];
+	}
+	return flag;
+}
+
 /**
  * @brief Assembles the column void Jacobian block @f$ J_0 @f$ of the time-discretized equations
  * @details The system \f[ \left( \frac{\partial F}{\partial y} + \alpha \frac{\partial F}{\partial \dot{y}} \right) x = b \f]
@@ -593,12 +956,7 @@ void GeneralRateModel::addMobilePhaseTimeDerivativeToJacobianParticleBlock(linal
 		// Add derivative with respect to dq / dt to Jacobian
 		for (int i = 0; i < static_cast<int>(_disc.nBound[comp]); ++i)
 		{
-			// Index explanation:
-			//   -comp -> go back to beginning of liquid phase
-			//   + strideParLiquid() skip to solid phase
-			//   + offsetBoundComp() jump to component (skips all bound states of previous components)
-			//   + i go to current bound state
-			jac[idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i] += alpha * invBetaP;
+			jac[idxr.offsetLiquidToBound(comp, i)] += alpha * invBetaP;
 		}
 	}
 }
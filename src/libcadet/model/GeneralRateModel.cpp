@@ -15,6 +15,7 @@
 #include "ParamReaderHelper.hpp"
 #include "cadet/Exceptions.hpp"
 #include "cadet/ExternalFunction.hpp"
+#include "cadet/HashUtil.hpp"
 #include "cadet/SolutionRecorder.hpp"
 #include "ConfigurationHelper.hpp"
 #include "linalg/DenseMatrix.hpp"
@@ -31,11 +32,12 @@
 
 #include <algorithm>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <system_error>
 
 #include "ParallelSupport.hpp"
-#ifdef CADET_PARALLELIZE
-	#include <tbb/tbb.h>
-#endif
 
 namespace cadet
 {
@@ -43,28 +45,66 @@ namespace cadet
 namespace model
 {
 
+namespace
+{
+	// Number of axial cells per block of the tiled bulk residual; a block touches the
+	// state, time derivative, residual, face flux, and WENO buffers of its cells
+	// (roughly 10 doubles per cell with Jacobian), so 512 cells keep the working set
+	// of a block comfortably inside a 256 kB L2 cache
+	const unsigned int bulkCellBlockSize = 512;
+}
+
 int schurComplementMultiplierGRM(void* userData, double const* x, double* z)
 {
 	GeneralRateModel* const grm = static_cast<GeneralRateModel*>(userData);
 	return grm->schurComplementMatrixVector(x, z);
 }
 
+int schurComplementPreconditionerGRM(void* userData, double const* r, double* z)
+{
+	GeneralRateModel* const grm = static_cast<GeneralRateModel*>(userData);
+	return grm->schurPreconditionerSolve(r, z);
+}
+
 
 GeneralRateModel::GeneralRateModel(UnitOpIdx unitOpIdx) : _unitOpIdx(unitOpIdx), _binding(nullptr),
-	_jacC(nullptr), _jacP(nullptr), _jacPF(nullptr), _jacFP(nullptr), _jacCdisc(nullptr), _jacPdisc(nullptr), _jacInlet(),
-	_analyticJac(true), _stencilMemory(sizeof(active) * Weno::maxStencilSize()), _wenoDerivatives(new double[Weno::maxStencilSize()]),
-	_weno(), _jacobianAdDirs(0), _factorizeJacobian(false), _tempState(nullptr)
+	_jacC(nullptr), _jacP(nullptr), _jacPF(nullptr), _jacFP(nullptr), _jacPFCompressed(nullptr), _offdiagJacPatternValid(false), _jacCdisc(nullptr), _jacPdisc(nullptr), _jacInlet(),
+	_curFilmDiffusion(nullptr), _curParDiffusion(nullptr), _curParSurfDiffusion(nullptr), _analyticJac(true), _dirtyDerived(DerivedAll),
+	_stencilMemory(sizeof(active) * Weno::maxStencilSize()), _wenoDerivatives(new double[Weno::maxStencilSize()]),
+	_weno(), _wenoStripVm(nullptr), _wenoStripDvm(nullptr), _wenoStripOrder(nullptr), _bulkFaceFlux(nullptr), _jacobianAdDirs(0), _parAdDirs(0), _factorizeJacobian(false), _jacCdiscRetained(false), _jacCdiscTimeFactor(0.0), _jacPdiscRetained(false), _jacPdiscTimeFactor(0.0),
+	_mixedPrecisionParticle(false), _mixedPrecisionBulk(false), _multirateErrTolFactor(1.0), _factorizationAlphaTol(0.0),
+	_maxFactorizationAge(20), _lastFactorizationAlpha(0.0), _factorizationAge(0), _gmresIterRef(0), _schurForcingMax(0.0), _schurForcing(0.0),
+	_schurPrevResNorm(0.0), _schurLastT(0.0), _schurLastAlpha(0.0), _useDirectSchur(false), _directSchurThreshold(0), _schurPrecond(false), _schurPrecondActive(false), _parShellTruncThreshold(0.0), _tempState(nullptr)
 {
+#ifdef CADET_BENCHMARK_MODE
+	_frontCellFraction = 1.0;
+#endif
+#ifdef CADET_CHECK_ANALYTIC_JACOBIAN
+	_jacCheckInterval = 1;
+	_jacCheckRngState = 0x9E3779B9u + unitOpIdx;
+	_jacCheckSamples = 0;
+	_jacCheckMaxDiffCol = 0.0;
+	_jacCheckMaxDiffPar = 0.0;
+#endif
 }
 
 GeneralRateModel::~GeneralRateModel() CADET_NOEXCEPT
 {
+	// A still pending coloring task works on members that are about to be released
+	if (_parColoringTask.valid())
+		_parColoringTask.wait();
+
 	delete[] _tempState;
 
 	delete[] _wenoDerivatives;
+	delete[] _wenoStripVm;
+	delete[] _wenoStripDvm;
+	delete[] _wenoStripOrder;
+	delete[] _bulkFaceFlux;
 
 	delete[] _jacPF;
 	delete[] _jacFP;
+	delete[] _jacPFCompressed;
 
 	delete[] _jacC;
 	delete[] _jacCdisc;
@@ -109,6 +149,109 @@ bool GeneralRateModel::usesAD() const CADET_NOEXCEPT
 #endif
 }
 
+uint64_t GeneralRateModel::structureHash(IParameterProvider& paramProvider)
+{
+	// Covers all settings that configure() consumes but reconfigure() does not read again,
+	// i.e., everything that determines memory layout and solver configuration. Two models
+	// with the same hash are interchangeable up to a reconfigure() call.
+	uint64_t h = 0;
+	hash_combine(h, paramProvider.getInt("NCOMP"));
+	hash_combine(h, paramProvider.getString("ADSORPTION_MODEL"));
+
+	paramProvider.pushScope("discretization");
+
+	hash_combine(h, paramProvider.getInt("NCOL"));
+	hash_combine(h, paramProvider.getInt("NPAR"));
+
+	const std::vector<int> nBound = paramProvider.getIntArray("NBOUND");
+	for (int nb : nBound)
+		hash_combine(h, nb);
+
+	const std::string parDiscType = paramProvider.getString("PAR_DISC_TYPE");
+	hash_combine(h, parDiscType);
+	if (parDiscType == "USER_DEFINED_PAR")
+	{
+		const std::vector<double> parInterfaces = paramProvider.getDoubleArray("PAR_DISC_VECTOR");
+		for (double v : parInterfaces)
+			hash_combine(h, v);
+	}
+
+	paramProvider.pushScope("weno");
+	hash_combine(h, paramProvider.getInt("WENO_ORDER"));
+	hash_combine(h, paramProvider.getInt("BOUNDARY_MODEL"));
+	hash_combine(h, paramProvider.getDouble("WENO_EPS"));
+	const bool hasWenoSections = paramProvider.exists("WENO_ORDER_SECTIONS");
+	hash_combine(h, hasWenoSections);
+	if (hasWenoSections)
+	{
+		const std::vector<int> wenoOrders = paramProvider.getIntArray("WENO_ORDER_SECTIONS");
+		for (int wo : wenoOrders)
+			hash_combine(h, wo);
+	}
+	paramProvider.popScope();
+
+	const bool hasAnalyticJac = paramProvider.exists("USE_ANALYTIC_JACOBIAN");
+	hash_combine(h, hasAnalyticJac);
+	if (hasAnalyticJac)
+		hash_combine(h, paramProvider.getBool("USE_ANALYTIC_JACOBIAN"));
+
+	hash_combine(h, paramProvider.getInt("MAX_KRYLOV"));
+	hash_combine(h, paramProvider.getInt("GS_TYPE"));
+	hash_combine(h, paramProvider.getInt("MAX_RESTARTS"));
+	hash_combine(h, paramProvider.getDouble("SCHUR_SAFETY"));
+
+	const bool hasRecycle = paramProvider.exists("MAX_RECYCLE");
+	hash_combine(h, hasRecycle);
+	if (hasRecycle)
+		hash_combine(h, paramProvider.getInt("MAX_RECYCLE"));
+
+	const bool hasMixedPrec = paramProvider.exists("MIXED_PRECISION_PARTICLE");
+	hash_combine(h, hasMixedPrec);
+	if (hasMixedPrec)
+		hash_combine(h, paramProvider.getBool("MIXED_PRECISION_PARTICLE"));
+
+	const bool hasMixedPrecBulk = paramProvider.exists("MIXED_PRECISION_BULK");
+	hash_combine(h, hasMixedPrecBulk);
+	if (hasMixedPrecBulk)
+		hash_combine(h, paramProvider.getBool("MIXED_PRECISION_BULK"));
+
+	const bool hasMultirate = paramProvider.exists("MULTIRATE_FACTOR");
+	hash_combine(h, hasMultirate);
+	if (hasMultirate)
+		hash_combine(h, paramProvider.getDouble("MULTIRATE_FACTOR"));
+
+	const bool hasFactReuse = paramProvider.exists("FACTORIZATION_REUSE_TOL");
+	hash_combine(h, hasFactReuse);
+	if (hasFactReuse)
+		hash_combine(h, paramProvider.getDouble("FACTORIZATION_REUSE_TOL"));
+
+	const bool hasFactAge = paramProvider.exists("MAX_FACTORIZATION_AGE");
+	hash_combine(h, hasFactAge);
+	if (hasFactAge)
+		hash_combine(h, paramProvider.getInt("MAX_FACTORIZATION_AGE"));
+
+	const bool hasDirectSchur = paramProvider.exists("DIRECT_SCHUR_THRESHOLD");
+	hash_combine(h, hasDirectSchur);
+	if (hasDirectSchur)
+		hash_combine(h, paramProvider.getInt("DIRECT_SCHUR_THRESHOLD"));
+
+	const bool hasShellTrunc = paramProvider.exists("PAR_SHELL_TRUNCATION");
+	hash_combine(h, hasShellTrunc);
+	if (hasShellTrunc)
+		hash_combine(h, paramProvider.getDouble("PAR_SHELL_TRUNCATION"));
+
+#ifdef CADET_CHECK_ANALYTIC_JACOBIAN
+	const bool hasJacCheck = paramProvider.exists("JAC_CHECK_INTERVAL");
+	hash_combine(h, hasJacCheck);
+	if (hasJacCheck)
+		hash_combine(h, paramProvider.getInt("JAC_CHECK_INTERVAL"));
+#endif
+
+	paramProvider.popScope();
+
+	return h;
+}
+
 bool GeneralRateModel::configure(IParameterProvider& paramProvider, IConfigHelper& helper)
 {
 	// ==== Read discretization
@@ -119,6 +262,11 @@ bool GeneralRateModel::configure(IParameterProvider& paramProvider, IConfigHelpe
 	_disc.nCol = paramProvider.getInt("NCOL");
 	_disc.nPar = paramProvider.getInt("NPAR");
 
+#ifdef CADET_BENCHMARK_MODE
+	// One accumulator for the bulk block plus one per particle block
+	_cellResidualCycles.assign(_disc.nCol + 1, 0);
+#endif
+
 	const std::vector<int> nBound = paramProvider.getIntArray("NBOUND");
 	_disc.nBound = new unsigned int[_disc.nComp];
 	std::copy(nBound.begin(), nBound.end(), _disc.nBound);
@@ -132,34 +280,76 @@ bool GeneralRateModel::configure(IParameterProvider& paramProvider, IConfigHelpe
 	}
 	_disc.strideBound = _disc.boundOffset[_disc.nComp-1] + _disc.nBound[_disc.nComp - 1];
 
-	// Configure particle discretization
-	_parCellSize.resize(_disc.nPar);
-	_parCenterRadius.resize(_disc.nPar);
-	_parOuterSurfAreaPerVolume.resize(_disc.nPar);
-	_parInnerSurfAreaPerVolume.resize(_disc.nPar);
+	// Configure particle discretization; the computed tables are interned such that
+	// identically configured models (e.g., ensemble members) share a single copy
+	ParticleDiscretization parDisc;
+	parDisc.cellSize.resize(_disc.nPar);
+	parDisc.centerRadius.resize(_disc.nPar);
+	parDisc.outerSurfAreaPerVolume.resize(_disc.nPar);
+	parDisc.innerSurfAreaPerVolume.resize(_disc.nPar);
 
 	const std::string parDiscType = paramProvider.getString("PAR_DISC_TYPE");
 	if (parDiscType == "EQUIVOLUME_PAR")
-		setEquivolumeRadialDisc();
+		setEquivolumeRadialDisc(parDisc);
 	else if (parDiscType == "USER_DEFINED_PAR")
 	{
 		const std::vector<double> parInterfaces = paramProvider.getDoubleArray("PAR_DISC_VECTOR");
-		setUserdefinedRadialDisc(parInterfaces);
+		setUserdefinedRadialDisc(parInterfaces, parDisc);
 	}
 	else // Handle parDiscType == "EQUIDISTANT_PAR" and default
-		setEquidistantRadialDisc();
+		setEquidistantRadialDisc(parDisc);
+
+	_parDisc = internParticleDisc(std::move(parDisc));
 
 	// Read WENO settings and apply them
 	paramProvider.pushScope("weno");
 	_weno.order(paramProvider.getInt("WENO_ORDER"));
 	_weno.boundaryTreatment(paramProvider.getInt("BOUNDARY_MODEL"));
 	_wenoEpsilon = paramProvider.getDouble("WENO_EPS");
+
+	// The WENO order can optionally be overridden per time section (e.g., first order
+	// in smooth sections); sections beyond the end of the array use its last entry
+	if (paramProvider.exists("WENO_ORDER_SECTIONS"))
+	{
+		_wenoOrderSections = paramProvider.getIntArray("WENO_ORDER_SECTIONS");
+		for (int wo : _wenoOrderSections)
+		{
+			if ((wo < 1) || (wo > static_cast<int>(Weno::maxOrder())))
+				throw InvalidParameterException("WENO_ORDER_SECTIONS entries have to be between 1 and " + std::to_string(Weno::maxOrder()));
+		}
+	}
+	else
+		_wenoOrderSections.clear();
+
+	// Optionally memoize the smoothness indicators across the residual evaluations of a
+	// time step (see Weno::enableSmoothnessMemo()); changes the weights by at most the
+	// reuse threshold and is therefore opt-in
+	bool wenoMemo = false;
+	double wenoMemoTol = 1e-4;
+	if (paramProvider.exists("WENO_MEMO"))
+		wenoMemo = paramProvider.getBool("WENO_MEMO");
+	if (paramProvider.exists("WENO_MEMO_TOL"))
+		wenoMemoTol = paramProvider.getDouble("WENO_MEMO_TOL");
+
 	paramProvider.popScope();
 
+	// Precompute the per-cell boundary treatment tables of the WENO scheme
+	_weno.init(_disc.nCol);
+
+	if (wenoMemo)
+		_weno.enableSmoothnessMemo(_disc.nComp, _disc.nCol, wenoMemoTol);
+	else
+		_weno.disableSmoothnessMemo();
+
 	// Determine whether analytic Jacobian should be used but don't set it right now.
 	// We need to setup Jacobian matrices first.
 #ifndef CADET_CHECK_ANALYTIC_JACOBIAN
-	const bool analyticJac = paramProvider.getBool("USE_ANALYTIC_JACOBIAN");
+	// All shipped binding models provide analytic Jacobians, so the fused single-pass
+	// residual + Jacobian evaluation is the default; the separate AD sweep remains
+	// available as explicit opt-out (e.g., for validating new binding models)
+	bool analyticJac = true;
+	if (paramProvider.exists("USE_ANALYTIC_JACOBIAN"))
+		analyticJac = paramProvider.getBool("USE_ANALYTIC_JACOBIAN");
 #else
 	const bool analyticJac = false;
 #endif
@@ -169,6 +359,110 @@ bool GeneralRateModel::configure(IParameterProvider& paramProvider, IConfigHelpe
 	_gmres.matrixVectorMultiplier(&schurComplementMultiplierGRM, this);
 	_schurSafety = paramProvider.getDouble("SCHUR_SAFETY");
 
+	// Recycle Krylov information between the Schur-complement solves of a time step
+	if (paramProvider.exists("MAX_RECYCLE"))
+		_gmres.recycleSubspace(paramProvider.getInt("MAX_RECYCLE"));
+
+	// Adapt the Schur-complement tolerance to the Newton convergence progress with
+	// Eisenstat-Walker forcing terms so that the early Newton iterations of a step use
+	// loose, cheap GMRES solves; the fixed SCHUR_SAFETY tolerance remains the lower bound
+	if (paramProvider.exists("SCHUR_FORCING_MAX"))
+		_schurForcingMax = std::min(std::max(paramProvider.getDouble("SCHUR_FORCING_MAX"), 0.0), 0.9);
+	else
+		_schurForcingMax = 0.0;
+
+	// Particle blocks are diagonally dominant in most setups, so they can optionally be
+	// factorized in single precision with double precision iterative refinement
+	if (paramProvider.exists("MIXED_PRECISION_PARTICLE"))
+		_mixedPrecisionParticle = paramProvider.getBool("MIXED_PRECISION_PARTICLE");
+	else
+		_mixedPrecisionParticle = false;
+
+	// The bulk column blocks can be treated the same way for screening runs that
+	// do not need estimation-grade accuracy in the interstitial solves
+	if (paramProvider.exists("MIXED_PRECISION_BULK"))
+		_mixedPrecisionBulk = paramProvider.getBool("MIXED_PRECISION_BULK");
+	else
+		_mixedPrecisionBulk = false;
+
+	// Multirate stepping: relax the error test on the fast particle and flux DOFs so
+	// that the global step size follows the bulk transport time scale, see
+	// applyMultirateErrorTol()
+	if (paramProvider.exists("MULTIRATE_FACTOR"))
+		_multirateErrTolFactor = std::max(1.0, paramProvider.getDouble("MULTIRATE_FACTOR"));
+	else
+		_multirateErrTolFactor = 1.0;
+
+	// Reuse factorized Jacobian blocks across consecutive setup requests in smooth sections
+	// as long as the BDF coefficient alpha has drifted only negligibly and the Schur-complement
+	// solves have not slowed down
+	if (paramProvider.exists("FACTORIZATION_REUSE_TOL"))
+		_factorizationAlphaTol = paramProvider.getDouble("FACTORIZATION_REUSE_TOL");
+	else
+		_factorizationAlphaTol = 0.0;
+
+	if (paramProvider.exists("MAX_FACTORIZATION_AGE"))
+		_maxFactorizationAge = paramProvider.getInt("MAX_FACTORIZATION_AGE");
+	else
+		_maxFactorizationAge = 20;
+
+	// For small discretizations, assembling and factorizing the Schur-complement as a dense
+	// matrix once per setup is cheaper than iterating GMRES in every linear solve; the direct
+	// path is selected automatically below the flux DOF threshold (0 disables it)
+	if (paramProvider.exists("DIRECT_SCHUR_THRESHOLD"))
+		_directSchurThreshold = paramProvider.getInt("DIRECT_SCHUR_THRESHOLD");
+	else
+		_directSchurThreshold = 256;
+
+	const unsigned int numFluxDofs = _disc.nCol * _disc.nComp;
+	_useDirectSchur = (numFluxDofs <= _directSchurThreshold);
+	if (_useDirectSchur)
+	{
+		_schurDirect.resize(numFluxDofs, numFluxDofs);
+		_schurColBuffer.resize(numFluxDofs);
+	}
+
+	// On the GMRES path, a block-Jacobi approximation of the particle contribution to the
+	// Schur-complement can optionally be used as right preconditioner. The blocks are
+	// refreshed together with the diagonal factorizations (see assembleSchurPreconditioner()),
+	// so the preconditioner is registered there once the first factorization is available
+	if (paramProvider.exists("SCHUR_PRECOND"))
+		_schurPrecond = paramProvider.getBool("SCHUR_PRECOND") && !_useDirectSchur;
+	else
+		_schurPrecond = false;
+
+	_schurPrecondActive = false;
+	_gmres.preconditioner(nullptr, linalg::PreconditionerSide::None);
+	if (_schurPrecond)
+	{
+		_schurPrecondBlocks.resize(_disc.nCol);
+		for (linalg::DenseMatrix& blk : _schurPrecondBlocks)
+			blk.resize(_disc.nComp, _disc.nComp);
+		_schurPrecondBuffer.resize(_disc.nComp);
+	}
+	else
+	{
+		_schurPrecondBlocks.clear();
+		_schurPrecondBuffer.clear();
+	}
+
+	// Freeze converged inner particle shells out of the Newton system: shells whose
+	// weighted time derivatives have dropped below the threshold are cut off the
+	// factorization, see activeParticleRows() (0 disables truncation)
+	if (paramProvider.exists("PAR_SHELL_TRUNCATION"))
+		_parShellTruncThreshold = paramProvider.getDouble("PAR_SHELL_TRUNCATION");
+	else
+		_parShellTruncThreshold = 0.0;
+
+#ifdef CADET_CHECK_ANALYTIC_JACOBIAN
+	// Sample the Jacobian verification so that it can stay enabled in long running tests:
+	// on average, one out of JAC_CHECK_INTERVAL Jacobian updates is compared against AD
+	if (paramProvider.exists("JAC_CHECK_INTERVAL"))
+		_jacCheckInterval = paramProvider.getInt("JAC_CHECK_INTERVAL");
+	else
+		_jacCheckInterval = 1;
+#endif
+
 	paramProvider.popScope();
 
 	// ==== Read model parameters
@@ -181,21 +475,30 @@ bool GeneralRateModel::configure(IParameterProvider& paramProvider, IConfigHelpe
 
 	_jacC = new linalg::BandMatrix[_disc.nComp];
 	_jacCdisc = new linalg::FactorizableBandMatrix[_disc.nComp];
+
+	// Freshly allocated matrices do not hold a factorization
+	_jacCdiscRetained = false;
+	_jacPdiscRetained = false;
 	for (unsigned int i = 0; i < _disc.nComp; ++i)
 	{
 		// Note that we have to increase the lower bandwidth by 1 because the WENO stencil is applied to the
 		// right cell face (lower + 1 + upper) and to the left cell face (shift the stencil by -1 because influx of cell i
 		// is outflux of cell i-1)
 		// We also have to make sure that there's at least one sub and super diagonal for the dispersion term
-		const unsigned int lb = std::max(_weno.lowerBandwidth() + 1u, 1u);
-		const unsigned int ub = std::max(_weno.upperBandwidth(), 1u);
+		// Bandwidths are computed for the largest WENO order of all time sections such that
+		// notifyDiscontinuousSectionTransition() can switch to a smaller order by repartitioning
+		const unsigned int maxWenoOrder = maxSectionWenoOrder();
+		const unsigned int lb = std::max(maxWenoOrder, 1u);
+		const unsigned int ub = std::max(maxWenoOrder - 1u, 1u);
 		const unsigned int mb = std::max(lb, ub);
 
-		// Allocate matrices such that bandwidths can be switched (backwards flow support)
+		// Reserve for the widest bandwidth such that flow reversal and WENO order switches
+		// repartition in place without allocating
+		_jacC[i].reserve(_disc.nCol, mb, mb);
 		_jacC[i].resize(_disc.nCol, lb, ub);
 
-		_jacCdisc[i].resize(_disc.nCol, mb, mb);
-		_jacCdisc[i].repartition(lb, ub);
+		_jacCdisc[i].reserve(_disc.nCol, mb, mb);
+		_jacCdisc[i].resize(_disc.nCol, lb, ub);
 	}
 
 	_jacP = new linalg::BandMatrix[_disc.nCol];
@@ -206,6 +509,24 @@ bool GeneralRateModel::configure(IParameterProvider& paramProvider, IConfigHelpe
 		_jacP[i].resize(_disc.nPar * (_disc.nComp + _disc.strideBound), _disc.nComp + _disc.strideBound, _disc.nComp + 2 * _disc.strideBound);
 	}
 
+	// All particle factorizations start out full; blocks are truncated lazily in linearSolve()
+	_parActiveRows.assign(_disc.nCol, std::numeric_limits<unsigned int>::max());
+
+	// Determine how many AD directions the particle blocks really need. The coloring only
+	// depends on the discretization set up above, so it runs on a background thread while
+	// the remaining parameter provider bound configuration (binding model, transport
+	// parameters, possibly further unit operations of the system) continues. All consumers
+	// of the coloring state join the task via syncParticleADcoloring().
+	try
+	{
+		_parColoringTask = std::async(std::launch::async, [this]() { computeParticleADcoloring(); });
+	}
+	catch (const std::system_error&)
+	{
+		// No thread available, compute synchronously
+		computeParticleADcoloring();
+	}
+
 	_jacPF = new linalg::DoubleSparseMatrix[_disc.nCol];
 	_jacFP = new linalg::DoubleSparseMatrix[_disc.nCol];
 	for (unsigned int i = 0; i < _disc.nCol; ++i)
@@ -217,7 +538,21 @@ bool GeneralRateModel::configure(IParameterProvider& paramProvider, IConfigHelpe
 	_jacCF.resize(_disc.nComp * _disc.nCol);
 	_jacFC.resize(_disc.nComp * _disc.nCol);
 
-	_discParFlux.resize(sizeof(active) * _disc.nComp);
+	// CSR versions of the off-diagonal blocks are compiled in assembleOffdiagJac()
+	_jacPFCompressed = new linalg::CompressedSparseMatrix[_disc.nCol];
+	_offdiagJacPatternValid = false;
+
+	_discParFlux.reset(sizeof(active) * _disc.nComp);
+
+	// Workspace of the batched WENO kernel used by the vectorized bulk residual
+	delete[] _wenoStripVm;
+	delete[] _wenoStripDvm;
+	delete[] _wenoStripOrder;
+	delete[] _bulkFaceFlux;
+	_wenoStripVm = new double[_disc.nCol];
+	_wenoStripDvm = new double[_disc.nCol * Weno::maxStencilSize()];
+	_wenoStripOrder = new int[_disc.nCol];
+	_bulkFaceFlux = new double[_disc.nCol + 1];
 
 	// Set whether analytic Jacobian is used
 	useAnalyticJacobian(analyticJac);
@@ -253,6 +588,10 @@ bool GeneralRateModel::configure(IParameterProvider& paramProvider, IConfigHelpe
 
 bool GeneralRateModel::reconfigure(IParameterProvider& paramProvider)
 {
+	// Rewind the scratch arena such that transient buffers of this run reuse
+	// the memory acquired by previous (re)configurations
+	_configScratch.reset();
+
 	// Read geometry parameters
 	_colLength = paramProvider.getDouble("COL_LENGTH");
 	_colPorosity = paramProvider.getDouble("COL_POROSITY");
@@ -326,6 +665,12 @@ bool GeneralRateModel::reconfigure(IParameterProvider& paramProvider)
 		}
 	}
 
+	// Compile the collision-free dispatch table used by the hot parameter setters
+	_paramLookup.rebuild(_parameters);
+
+	// All parameters have been re-read, every derived coefficient group is stale
+	_dirtyDerived = DerivedAll;
+
 	// Reconfigure binding model
 	if (_binding)
 		return _binding->reconfigure(paramProvider, _unitOpIdx);
@@ -357,6 +702,23 @@ bool GeneralRateModel::hasParameter(const ParameterId& pId) const
 	return hasParam;
 }
 
+/**
+ * @brief Marks the derived coefficient groups that depend on the given parameter as stale
+ * @details The groups are recomputed on the next section transition. Parameters that no
+ *          derived coefficient depends on leave the bitmask untouched, which makes updating
+ *          them (e.g., adsorption rates in an estimation inner loop) nearly free.
+ * @param [in] nameHash Hashed name of the updated parameter
+ */
+void GeneralRateModel::invalidateDerived(StringHash nameHash) CADET_NOEXCEPT
+{
+	if ((nameHash == hashString("FILM_DIFFUSION")) || (nameHash == hashString("PAR_DIFFUSION")))
+		_dirtyDerived |= DerivedFluxCoeffs | DerivedParamMirrors;
+	else if (nameHash == hashString("PAR_SURFDIFFUSION"))
+		_dirtyDerived |= DerivedParamMirrors;
+	else if ((nameHash == hashString("COL_POROSITY")) || (nameHash == hashString("PAR_POROSITY")) || (nameHash == hashString("PAR_RADIUS")))
+		_dirtyDerived |= DerivedFluxCoeffs | DerivedParamMirrors;
+}
+
 bool GeneralRateModel::setParameter(const ParameterId& pId, int value)
 {
 	if ((pId.unitOperation != _unitOpIdx) && (pId.unitOperation != UnitOpIndep))
@@ -372,10 +734,11 @@ bool GeneralRateModel::setParameter(const ParameterId& pId, double value)
 	if ((pId.unitOperation != _unitOpIdx) && (pId.unitOperation != UnitOpIndep))
 		return false;
 
-	auto paramHandle = _parameters.find(pId);
-	if (paramHandle != _parameters.end())
+	active* const param = _paramLookup.find(pId);
+	if (param)
 	{
-		paramHandle->second->setValue(value);
+		param->setValue(value);
+		invalidateDerived(pId.name);
 		return true;
 	}
 	else if (_binding)
@@ -400,10 +763,11 @@ void GeneralRateModel::setSensitiveParameterValue(const ParameterId& pId, double
 		return;
 
 	// Check our own parameters
-	auto paramHandle = _parameters.find(pId);
-	if ((paramHandle != _parameters.end()) && contains(_sensParams, paramHandle->second))
+	active* const param = _paramLookup.find(pId);
+	if (param && contains(_sensParams, param))
 	{
-		paramHandle->second->setValue(value);
+		param->setValue(value);
+		invalidateDerived(pId.name);
 		return;
 	}
 
@@ -425,14 +789,14 @@ bool GeneralRateModel::setSensitiveParameter(const ParameterId& pId, unsigned in
 		return false;
 
 	// Check own parameters
-	auto paramHandle = _parameters.find(pId);
-	if (paramHandle != _parameters.end())
+	active* const param = _paramLookup.find(pId);
+	if (param)
 	{
 		LOG(Debug) << "Found parameter " << pId << " in GRM: Dir " << adDirection << " is set to " << adValue;
 
 		// Register parameter and set AD seed / direction
-		_sensParams.insert(paramHandle->second);
-		paramHandle->second->setADValue(adDirection, adValue);
+		_sensParams.insert(param);
+		param->setADValue(adDirection, adValue);
 		return true;
 	}
 
@@ -468,10 +832,11 @@ void GeneralRateModel::useAnalyticJacobian(const bool analyticJac)
 #ifndef CADET_CHECK_ANALYTIC_JACOBIAN
 	_analyticJac = analyticJac;
 	if (!_analyticJac)
-		// We need as many directions as the highest bandwidth of the diagonal blocks:
+		// We need as many directions as the larger of the diagonal block direction counts:
 		// The bandwidth of the column block depends on the size of the WENO stencil, whereas
-		// the bandwidth of the particle blocks are given by the number of components and bound states.
-		_jacobianAdDirs = std::max(_jacC[0].stride(), _jacP[0].stride());
+		// the direction count of the particle blocks is given by the coloring of their
+		// structural pattern (see computeParticleADcoloring()).
+		_jacobianAdDirs = std::max(_jacC[0].stride(), _parAdDirs);
 	else
 		_jacobianAdDirs = 0;
 #else
@@ -483,15 +848,175 @@ void GeneralRateModel::useAnalyticJacobian(const bool analyticJac)
 #endif
 }
 
+std::size_t GeneralRateModel::memoryFootprint() const CADET_NOEXCEPT
+{
+	syncParticleADcoloring();
+
+	std::size_t mem = 0;
+
+	// Interstitial Jacobian blocks (one per component)
+	for (unsigned int i = 0; i < _disc.nComp; ++i)
+		mem += _jacC[i].memoryFootprint() + _jacCdisc[i].memoryFootprint();
+
+	// Particle Jacobian blocks and their couplings to the fluxes (one per column cell)
+	for (unsigned int i = 0; i < _disc.nCol; ++i)
+	{
+		mem += _jacP[i].memoryFootprint() + _jacPdisc[i].memoryFootprint();
+		mem += _jacPF[i].memoryFootprint() + _jacFP[i].memoryFootprint();
+		mem += _jacPFCompressed[i].memoryFootprint();
+	}
+
+	mem += _jacCF.memoryFootprint() + _jacFC.memoryFootprint();
+	mem += _jacCFCompressed.memoryFootprint();
+	mem += _jacInlet.memoryFootprint();
+
+	// Colored AD seeding of the particle blocks
+	mem += _parAdColors.capacity() * sizeof(unsigned int) + _parAdPattern.memoryFootprint();
+
+	// Temporary state vector, sized as in configure()
+	std::size_t tempStateSize = numDofs();
+	if (_binding && _binding->hasAlgebraicEquations())
+		tempStateSize = std::max(tempStateSize, static_cast<std::size_t>(_binding->consistentInitializationWorkspaceSize()) * _disc.nPar * _disc.nCol);
+	mem += tempStateSize * sizeof(double);
+
+	// WENO workspaces
+	mem += (Weno::maxStencilSize() + _disc.nCol * (1 + Weno::maxStencilSize())) * sizeof(double) + _disc.nCol * sizeof(int);
+
+	// Per-thread workspaces, counted once (see IModel::memoryFootprint()): WENO stencil pool,
+	// discretized film diffusion pool, and dense Jacobian for consistent initialization
+	mem += sizeof(active) * (Weno::maxStencilSize() + _disc.nComp);
+	mem += _disc.strideBound * _disc.strideBound * sizeof(double) + _disc.strideBound * sizeof(lapackInt_t);
+
+	// Particle discretization tables; one interned copy serves all identically
+	// configured models, so attribute an equal share to each of them
+	if (_parDisc)
+	{
+		const std::size_t tables = (_parDisc->cellSize.capacity() + _parDisc->centerRadius.capacity()
+			+ _parDisc->outerSurfAreaPerVolume.capacity() + _parDisc->innerSurfAreaPerVolume.capacity()) * sizeof(double);
+		mem += tables / _parDisc.use_count();
+	}
+
+	// Dense Schur-complement of the direct solver path (empty above the threshold)
+	mem += _schurDirect.memoryFootprint() + _schurColBuffer.capacity() * sizeof(double);
+	for (const linalg::DenseMatrix& blk : _schurPrecondBlocks)
+		mem += blk.memoryFootprint();
+	mem += _schurPrecondBuffer.capacity() * sizeof(double);
+	mem += _parActiveRows.capacity() * sizeof(unsigned int);
+
+	// Scratch arena for transient configuration data
+	mem += _configScratch.capacityBytes();
+
+	return mem;
+}
+
+cadet::CostEstimate GeneralRateModel::costEstimate(unsigned int numSensParams) const CADET_NOEXCEPT
+{
+	Indexer idxr(_disc);
+	const std::size_t mem = memoryFootprint();
+
+	// Static order of magnitude model of one integrator step for scheduler driven job
+	// placement. A step is taken as two Newton iterations, each with one residual
+	// evaluation and one banded backsubstitution, plus an amortized share of the
+	// factorization. Sensitivities evaluate the residual once more per parameter with
+	// AD arithmetic, which roughly doubles the cost of each direction.
+	const double sensFactor = 1.0 + 2.0 * static_cast<double>(numSensParams);
+	const double nDofs = static_cast<double>(numDofs());
+
+	// Residual: WENO reconstruction and dispersion in the bulk (about ten flops per
+	// stencil entry), diffusion stencil and isotherm kinetics in the particle shells,
+	// and the film diffusion flux coupling
+	const double bulkCells = static_cast<double>(_disc.nCol) * _disc.nComp;
+	const double wenoStencil = 2.0 * _weno.order() - 1.0;
+	const double residualFlops = bulkCells * (10.0 * wenoStencil + 10.0)
+		+ static_cast<double>(_disc.nCol) * _disc.nPar * (6.0 * _disc.nComp + 20.0 * _disc.strideBound)
+		+ bulkCells * 10.0;
+
+	// Banded linear algebra: backsubstitution is rows times total bandwidth, the
+	// factorization rows times bandwidth squared amortized over the refactorization
+	// age limit. Bulk bandwidths follow from the WENO stencil, particle bandwidths
+	// from the shell stride.
+	const double bwBulk = static_cast<double>(_weno.lowerBandwidth() + 1 + _weno.upperBandwidth());
+	const double bulkRows = static_cast<double>(_disc.nCol);
+	const double parRows = static_cast<double>(idxr.strideParBlock());
+	const double bwPar = static_cast<double>(2 * idxr.strideParShell() + 1);
+	const double solveFlops = 2.0 * (_disc.nComp * bulkRows * bwBulk + _disc.nCol * parRows * bwPar);
+	const double factorFlops = (_disc.nComp * bulkRows * bwBulk * bwBulk + _disc.nCol * parRows * bwPar * bwPar)
+		/ static_cast<double>(std::max(_maxFactorizationAge, 1u));
+
+	// Two Newton iterations per step; the state, derivative, and residual vectors are
+	// streamed once per residual evaluation, the Jacobian storage once per solve
+	CostEstimate ce;
+	ce.flopsPerStep = 2.0 * (residualFlops * sensFactor + solveFlops) + factorFlops;
+	ce.bytesPerStep = 2.0 * 3.0 * sizeof(double) * nDofs * sensFactor + static_cast<double>(mem);
+	ce.memory = mem;
+	return ce;
+}
+
 void GeneralRateModel::notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset)
 {
-	// Setup flux Jacobian blocks at the beginning of the simulation or in case of
-	// section dependent film or particle diffusion coefficients
-	if ((secIdx == 0) || (_filmDiffusion.size() > _disc.nComp) || (_parDiffusion.size() > _disc.nComp))
+	// Setup flux Jacobian blocks at the beginning of the simulation, in case of
+	// section dependent film or particle diffusion coefficients, or when a
+	// parameter they depend on has been updated since the last assembly
+	const bool secDepFluxCoeffs = (_filmDiffusion.size() > _disc.nComp) || (_parDiffusion.size() > _disc.nComp);
+	if (!_offdiagJacPatternValid || secDepFluxCoeffs || (_dirtyDerived & DerivedFluxCoeffs))
 		assembleOffdiagJac(t, secIdx);
 
+	// The Jacobian changes discontinuously here, so the factorization of the previous
+	// section must not be reused
+	_lastFactorizationAlpha = 0.0;
+	_factorizationAge = 0;
+
 	Indexer idxr(_disc);
 
+	// Cache the section constant transport coefficients; the residual functions
+	// use these instead of looking them up on every call
+	_curColDispersion = getSectionDependentScalar(_colDispersion, secIdx);
+	_curFilmDiffusion = getSectionDependentSlice(_filmDiffusion, _disc.nComp, secIdx);
+	_curParDiffusion = getSectionDependentSlice(_parDiffusion, _disc.nComp, secIdx);
+	_curParSurfDiffusion = getSectionDependentSlice(_parSurfDiffusion, idxr.strideParBound(), secIdx);
+
+	// Pack the plain values of the slices into dense double arrays for the double
+	// typed residual functions; this is only required when the slices point to a
+	// different section or a diffusion parameter has been updated via setParameter()
+	const bool secDepMirrors = secDepFluxCoeffs || (_parSurfDiffusion.size() > static_cast<unsigned int>(idxr.strideParBound()));
+	if (_curFilmDiffusionDense.empty() || secDepMirrors || (_dirtyDerived & DerivedParamMirrors))
+	{
+		extractDenseSlice(_curFilmDiffusion, _disc.nComp, _curFilmDiffusionDense);
+		extractDenseSlice(_curParDiffusion, _disc.nComp, _curParDiffusionDense);
+		extractDenseSlice(_curParSurfDiffusion, idxr.strideParBound(), _curParSurfDiffusionDense);
+
+		// Pre-resolve the derived double coefficients so that the double typed residual
+		// functions neither unwrap active parameters nor redo these divisions per call
+		const double radius = static_cast<double>(_parRadius);
+		const double epsP = static_cast<double>(_parPorosity);
+		const double relOuterShellHalfRadius = 0.5 * _parDisc->cellSize[0];
+
+		_curKfFVDense.resize(_disc.nComp);
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+			_curKfFVDense[comp] = 1.0 / (radius * relOuterShellHalfRadius / epsP / _curParDiffusionDense[comp] + 1.0 / _curFilmDiffusionDense[comp]);
+
+		_parOuterApVDense.resize(_disc.nPar);
+		_parInnerApVDense.resize(_disc.nPar);
+		for (unsigned int par = 0; par < _disc.nPar; ++par)
+		{
+			_parOuterApVDense[par] = _parDisc->outerSurfAreaPerVolume[par] / radius;
+			_parInnerApVDense[par] = _parDisc->innerSurfAreaPerVolume[par] / radius;
+		}
+	}
+
+	// All derived coefficient groups are up to date now
+	_dirtyDerived = 0;
+
+	// Apply the WENO order of this section; changing the order alters the bulk Jacobian
+	// bandwidths and, thus, requires the same matrix updates as a flow reversal
+	bool wenoOrderChanged = false;
+	if (!_wenoOrderSections.empty())
+	{
+		const int wenoOrder = _wenoOrderSections[std::min(static_cast<std::size_t>(secIdx), _wenoOrderSections.size() - 1)];
+		wenoOrderChanged = (wenoOrder != _weno.order());
+		_weno.order(wenoOrder);
+	}
+
 	// If we don't have cross section area, velocity is given by parameter
 	if (_crossSection <= 0.0)
 		_curVelocity = getSectionDependentScalar(_velocity, secIdx);
@@ -517,8 +1042,9 @@ void GeneralRateModel::notifyDiscontinuousSectionTransition(double t, unsigned i
 	if (_velocity.empty())
 		prevU = u;
 
-	// Exit if we do not need to setup (secIdx == 0) or change (prevU and u differ in sign) matrices
-	if ((secIdx != 0) && (prevU * u >= 0.0))
+	// Exit if we do not need to setup (secIdx == 0) or change (prevU and u differ in sign,
+	// or the WENO order of this section differs from the previous one) matrices
+	if ((secIdx != 0) && (prevU * u >= 0.0) && !wenoOrderChanged)
 		return;
 
 	// Setup the matrix connecting inlet DOFs to first column cells
@@ -563,6 +1089,9 @@ void GeneralRateModel::notifyDiscontinuousSectionTransition(double t, unsigned i
 		}
 	}
 
+	// Repartitioning changes the bulk block layout, dropping any retained factorization
+	_jacCdiscRetained = false;
+
 	// Update AD seed vectors since Jacobian structure has changed (bulk block bandwidths)
 	prepareBulkADvectors(adRes, adY, adDirOffset);
 }
@@ -591,6 +1120,7 @@ void GeneralRateModel::reportSolutionStructure(ISolutionRecorder& recorder) cons
 unsigned int GeneralRateModel::requiredADdirs() const CADET_NOEXCEPT
 {
 #ifndef CADET_CHECK_ANALYTIC_JACOBIAN
+	syncParticleADcoloring();
 	return _jacobianAdDirs;
 #else
 	// If CADET_CHECK_ANALYTIC_JACOBIAN is active, we always need the AD directions for the Jacobian
@@ -604,22 +1134,62 @@ void GeneralRateModel::prepareADvectors(active* const adRes, active* const adY,
 	if (!adY)
 		return;
 
-	Indexer idxr(_disc);
+	syncParticleADcoloring();
 
-	// Get bandwidths of blocks
-	const unsigned int lowerParBandwidth = _jacP[0].lowerBandwidth();
-	const unsigned int upperParBandwidth = _jacP[0].upperBandwidth();
+	Indexer idxr(_disc);
 
-	// Column block	
+	// Column block
 	prepareBulkADvectors(adRes, adY, adDirOffset);
 
 	// Particle blocks
-	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	if (_parAdColors.empty())
+	{
+		// Get bandwidths of blocks
+		const unsigned int lowerParBandwidth = _jacP[0].lowerBandwidth();
+		const unsigned int upperParBandwidth = _jacP[0].upperBandwidth();
+
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+		{
+			ad::prepareAdVectorSeedsForBandMatrix(adY + idxr.offsetCp(pblk), adDirOffset, idxr.strideParBlock(), lowerParBandwidth, upperParBandwidth, lowerParBandwidth);
+		}
+	}
+	else
 	{
-		ad::prepareAdVectorSeedsForBandMatrix(adY + idxr.offsetCp(pblk), adDirOffset, idxr.strideParBlock(), lowerParBandwidth, upperParBandwidth, lowerParBandwidth);
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+		{
+			ad::prepareAdVectorSeedsForColoredPattern(adY + idxr.offsetCp(pblk), adDirOffset, _parAdColors);
+		}
 	}
 }
 
+uint64_t GeneralRateModel::adSeedStructureHash() const CADET_NOEXCEPT
+{
+	syncParticleADcoloring();
+
+	// The seeding in prepareADvectors() is fully determined by the discretization,
+	// the current bulk block bandwidths (which depend on the flow direction), and
+	// the particle AD coloring (if enabled)
+	uint64_t h = 0;
+	hash_combine(h, std::string("GENERAL_RATE_MODEL"));
+	hash_combine(h, _disc.nComp);
+	hash_combine(h, _disc.nCol);
+	hash_combine(h, _disc.nPar);
+	hash_combine(h, _disc.strideBound);
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+		hash_combine(h, _disc.nBound[comp]);
+
+	hash_combine(h, _jacC[0].lowerBandwidth());
+	hash_combine(h, _jacC[0].upperBandwidth());
+	hash_combine(h, _jacP[0].lowerBandwidth());
+	hash_combine(h, _jacP[0].upperBandwidth());
+
+	hash_combine(h, _parAdColors.size());
+	for (unsigned int color : _parAdColors)
+		hash_combine(h, color);
+
+	return h;
+}
+
 /**
  * @brief Sets the AD seed vectors for the bulk Jacobian block
  * @details This has to be done whenever the Jacobian structure changes.
@@ -650,8 +1220,126 @@ void GeneralRateModel::prepareBulkADvectors(active* const adRes, active* const a
 }
 
 /**
- * @brief Extracts the system Jacobian from band compressed AD seed vectors
- * @param [in] adRes Residual vector of AD datatypes with band compressed seed vectors
+ * @brief Computes an AD direction assignment (coloring) for the particle blocks
+ * @details The band compressed seeding requires as many AD directions as the particle block
+ *          band is wide, although the true coupling inside the band is much sparser: a mobile
+ *          phase equation couples only to its own component (and the bound states thereof)
+ *          in the neighboring shells, whereas the binding equations are local to one shell.
+ *          A graph coloring of this structural pattern assigns each column of a particle
+ *          block an AD direction such that no two columns sharing a structural non-zero row
+ *          use the same direction, which typically requires about half as many directions as
+ *          the band compression. Since the pattern contains the surface diffusion stencil
+ *          unconditionally, it does not depend on any parameter values and stays valid when
+ *          parameters are changed by setParameterValue(). All particle blocks share the same
+ *          structure and, hence, the same coloring.
+ *
+ *          The flux equations need no AD directions at all as their Jacobian blocks are
+ *          assembled analytically in assembleOffdiagJac(). The bulk blocks reuse the lower
+ *          particle directions with their own band compressed seeding, just like before.
+ */
+void GeneralRateModel::computeParticleADcoloring()
+{
+#ifdef CADET_CHECK_ANALYTIC_JACOBIAN
+	// The Jacobian verification helpers assume the band compressed seeding
+	_parAdColors.clear();
+	_parAdDirs = _jacP[0].stride();
+#else
+	const unsigned int sps = _disc.nComp + _disc.strideBound;
+	const unsigned int numCols = _disc.nPar * sps;
+
+	// Assemble the structural pattern of one particle block; binding equations are
+	// conservatively assumed to couple to every entry of their shell (competitive isotherms)
+	linalg::DoubleSparseMatrix pattern;
+	pattern.resize(numCols * (3 + _disc.strideBound));
+	for (unsigned int par = 0; par < _disc.nPar; ++par)
+	{
+		const unsigned int offset = par * sps;
+
+		// Mobile phase: molecular diffusion couples to the own component of the neighboring
+		// shells, surface diffusion to the own bound states of the own and neighboring shells
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+		{
+			const unsigned int row = offset + comp;
+			pattern.addElement(row, row, 1.0);
+			if (par != 0)
+				pattern.addElement(row, row - sps, 1.0);
+			if (par != _disc.nPar - 1)
+				pattern.addElement(row, row + sps, 1.0);
+
+			for (unsigned int bnd = 0; bnd < _disc.nBound[comp]; ++bnd)
+			{
+				const unsigned int col = offset + _disc.nComp + _disc.boundOffset[comp] + bnd;
+				pattern.addElement(row, col, 1.0);
+				if (par != 0)
+					pattern.addElement(row, col - sps, 1.0);
+				if (par != _disc.nPar - 1)
+					pattern.addElement(row, col + sps, 1.0);
+			}
+		}
+
+		// Bound phases: all equations of the shell
+		for (unsigned int bnd = 0; bnd < _disc.strideBound; ++bnd)
+		{
+			const unsigned int row = offset + _disc.nComp + bnd;
+			for (unsigned int col = 0; col < sps; ++col)
+				pattern.addElement(row, offset + col, 1.0);
+		}
+	}
+
+	linalg::CompressedSparseMatrix compiledPattern(pattern);
+	std::vector<unsigned int> colors;
+	const unsigned int numColors = ad::colorJacobianPattern(compiledPattern, numCols, colors);
+
+	// Only switch to the colored seeding if it actually beats the band compression
+	if (numColors < _jacP[0].stride())
+	{
+		_parAdColors = std::move(colors);
+		_parAdPattern = std::move(compiledPattern);
+		_parAdDirs = numColors;
+	}
+	else
+	{
+		_parAdColors.clear();
+		_parAdDirs = _jacP[0].stride();
+	}
+#endif
+}
+
+/**
+ * @brief Joins a pending background computation of the particle AD coloring
+ * @details configure() launches computeParticleADcoloring() asynchronously so that it
+ *          overlaps with the remaining configuration work. Every consumer of the coloring
+ *          state (_parAdColors, _parAdDirs, _parAdPattern, and the derived _jacobianAdDirs)
+ *          has to join the task through this function first. After the first join the
+ *          function is a cheap no-op.
+ */
+void GeneralRateModel::syncParticleADcoloring() const CADET_NOEXCEPT
+{
+	if (!_parColoringTask.valid())
+		return;
+
+	try
+	{
+		_parColoringTask.get();
+	}
+	catch (...)
+	{
+		// Fall back to the band compressed seeding on any failure
+		_parAdColors.clear();
+		_parAdDirs = _jacP[0].stride();
+	}
+
+#ifndef CADET_CHECK_ANALYTIC_JACOBIAN
+	// Refresh the direction count which useAnalyticJacobian() may have derived from a
+	// stale _parAdDirs while the task was still running
+	if (!_analyticJac)
+		_jacobianAdDirs = std::max(_jacC[0].stride(), _parAdDirs);
+#endif
+}
+
+/**
+ * @brief Extracts the system Jacobian from compressed AD seed vectors
+ * @param [in] adRes Residual vector of AD datatypes with compressed seed vectors
  * @param [in] adDirOffset Number of AD directions used for non-Jacobian purposes (e.g., parameter sensitivities)
  */
 void GeneralRateModel::extractJacobianFromAD(active const* const adRes, unsigned int adDirOffset)
@@ -663,8 +1351,16 @@ void GeneralRateModel::extractJacobianFromAD(active const* const adRes, unsigned
 		ad::extractBandedJacobianFromAd(adRes + comp * idxr.strideColComp() + idxr.offsetC(), adDirOffset, _jacC[comp].lowerBandwidth(), _jacC[comp]);
 
 	// Particles
-	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
-		ad::extractBandedJacobianFromAd(adRes + idxr.offsetCp(pblk), adDirOffset, _jacP[pblk].lowerBandwidth(), _jacP[pblk]);
+	if (_parAdColors.empty())
+	{
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+			ad::extractBandedJacobianFromAd(adRes + idxr.offsetCp(pblk), adDirOffset, _jacP[pblk].lowerBandwidth(), _jacP[pblk]);
+	}
+	else
+	{
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+			ad::extractBandedJacobianFromColoredAd(adRes + idxr.offsetCp(pblk), adDirOffset, _parAdColors, _parAdPattern, _jacP[pblk]);
+	}
 }
 
 #ifdef CADET_CHECK_ANALYTIC_JACOBIAN
@@ -672,6 +1368,8 @@ void GeneralRateModel::extractJacobianFromAD(active const* const adRes, unsigned
 /**
  * @brief Compares the analytical Jacobian with a Jacobian derived by AD
  * @details The analytical Jacobian is assumed to be stored in the corresponding band matrices.
+ *          The maximum differences are accumulated over all performed comparisons and reported
+ *          in the benchmark statistics (see benchmarkTimings()).
  * @param [in] adRes Residual vector of AD datatypes with band compressed seed vectors
  * @param [in] adDirOffset Number of AD directions used for non-Jacobian purposes (e.g., parameter sensitivities)
  */
@@ -699,6 +1397,75 @@ void GeneralRateModel::checkAnalyticJacobianAgainstAd(active const* const adRes,
 		LOG(Debug) << "-> Par block diff " << pblk << ": " << localDiff;
 		maxDiffPar = std::max(maxDiffPar, localDiff);
 	}
+
+	// Accumulate statistics over all sampled comparisons
+	++_jacCheckSamples;
+	_jacCheckMaxDiffCol = std::max(_jacCheckMaxDiffCol, maxDiffCol);
+	_jacCheckMaxDiffPar = std::max(_jacCheckMaxDiffPar, maxDiffPar);
+
+	LOG(Debug) << "Jacobian check sample " << _jacCheckSamples << ": col diff " << maxDiffCol << " (max " << _jacCheckMaxDiffCol
+		<< "), par diff " << maxDiffPar << " (max " << _jacCheckMaxDiffPar << ")";
+}
+
+#endif
+
+#ifdef CADET_BENCHMARK_MODE
+
+/**
+ * @brief Records how much of the axial mesh is occupied by steep concentration fronts
+ * @details Computes the absolute cell-to-cell concentration jumps of all bulk components
+ *          and counts the cell faces whose jump exceeds 10% of the largest jump. The
+ *          smallest fraction observed over the run is reported as @c FrontCellFraction
+ *          in the benchmark statistics. A small value indicates that the elution front
+ *          occupies only a small part of the column, that is, an adaptively (or locally)
+ *          refined axial mesh could resolve the same front with far fewer cells than the
+ *          equidistant discretization uses.
+ * @param [in] y State vector
+ */
+void GeneralRateModel::updateFrontIndicator(double const* const y) const
+{
+	if (_disc.nCol < 2)
+		return;
+
+	Indexer idxr(_disc);
+
+	// Find the largest jump and the largest concentration over all components
+	double maxJump = 0.0;
+	double maxConc = 0.0;
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		for (unsigned int col = 1; col < _disc.nCol; ++col)
+		{
+			maxJump = std::max(maxJump, std::abs(idxr.c<double>(y, col, comp) - idxr.c<double>(y, col - 1, comp)));
+			maxConc = std::max(maxConc, std::abs(idxr.c<double>(y, col, comp)));
+		}
+	}
+
+	// Ignore (numerically) flat profiles, for instance, before the injection arrives
+	if (maxJump <= 1e-10 * std::max(maxConc, 1.0))
+		return;
+
+	// Count cell faces that carry a significant part of the front in any component
+	const double threshold = 0.1 * maxJump;
+	unsigned int frontFaces = 0;
+	for (unsigned int col = 1; col < _disc.nCol; ++col)
+	{
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+		{
+			if (std::abs(idxr.c<double>(y, col, comp) - idxr.c<double>(y, col - 1, comp)) > threshold)
+			{
+				++frontFaces;
+				break;
+			}
+		}
+	}
+
+	const double fraction = static_cast<double>(frontFaces) / static_cast<double>(_disc.nCol - 1);
+	if (fraction < _frontCellFraction)
+	{
+		_frontCellFraction = fraction;
+		LOG(Debug) << "Front occupies " << frontFaces << " of " << (_disc.nCol - 1) << " cell faces (fraction " << fraction << ")";
+	}
 }
 
 #endif
@@ -708,6 +1475,10 @@ int GeneralRateModel::residual(double t, unsigned int secIdx, double timeFactor,
 	LOG(Trace) << "======= RESIDUAL ========== t = " << static_cast<double>(t) << " sec = " << secIdx << " dt = " << static_cast<double>(timeFactor);
 	BENCH_SCOPE(_timerResidual);
 
+#ifdef CADET_BENCHMARK_MODE
+	updateFrontIndicator(y);
+#endif
+
 	// Evaluate residual do not compute Jacobian or parameter sensitivities
 	return residualImpl<double, double, double, false>(t, secIdx, timeFactor, y, yDot, res);
 }
@@ -786,8 +1557,9 @@ int GeneralRateModel::residual(const active& t, unsigned int secIdx, const activ
 		else
 			retCode = residualImpl<active, active, double, false>(static_cast<double>(t), secIdx, static_cast<double>(timeFactor), adY, yDot, adRes);
 
-		// Only do comparison if we have a residuals vector (which is not always the case)
-		if (res)
+		// Only do comparison if we have a residuals vector (which is not always the case);
+		// the comparison is sampled so that continuous verification stays cheap
+		if (res && sampleJacobianCheck())
 		{
 			// Evaluate with analytical Jacobian which is stored in the band matrices
 			retCode = residualImpl<double, double, double, true>(static_cast<double>(t), secIdx, static_cast<double>(timeFactor), y, yDot, res);
@@ -795,6 +1567,11 @@ int GeneralRateModel::residual(const active& t, unsigned int secIdx, const activ
 			// Compare AD with anaytic Jacobian
 			checkAnalyticJacobianAgainstAd(adRes, adDirOffset);
 		}
+		else if (res)
+		{
+			// Copy AD residuals to original residuals vector
+			ad::copyFromAd(adRes, res, numDofs());
+		}
 
 		// Extract Jacobian
 		extractJacobianFromAD(adRes, adDirOffset);
@@ -830,17 +1607,26 @@ int GeneralRateModel::residualImpl(const ParamType& t, unsigned int secIdx, cons
 
 	BENCH_START(_timerResidualPar);
 
-#ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), size_t(_disc.nCol + 1), [&](size_t pblk)
-#else
-	for (unsigned int pblk = 0; pblk < _disc.nCol + 1; ++pblk)
-#endif
+	// The persistent partitioner replays the block-to-worker mapping of the previous
+	// evaluation such that each particle block tends to stay on the core (and memory
+	// domain) that processed it before
+	util::parallelBatchedFor(0, _disc.nCol + 1, 1, _particleLoopPartitioner, [&](std::size_t pblk)
 	{
+#ifdef CADET_BENCHMARK_MODE
+		// Each block index is processed by exactly one worker per evaluation, so the
+		// per-block accumulators are updated race-free inside the parallel loop
+		const std::uint64_t cellStart = benchCycleCount();
+#endif
+
 		if (cadet_unlikely(pblk == 0))
 			residualBulk<StateType, ResidualType, ParamType, wantJac>(t, secIdx, timeFactor, y, yDot, res);
 		else
 			residualParticle<StateType, ResidualType, ParamType, wantJac>(t, pblk-1, secIdx, timeFactor, y, yDot, res);
-	} CADET_PARFOR_END;
+
+#ifdef CADET_BENCHMARK_MODE
+		_cellResidualCycles[pblk] += benchCycleCount() - cellStart;
+#endif
+	});
 
 	BENCH_STOP(_timerResidualPar);
 
@@ -868,19 +1654,50 @@ int GeneralRateModel::residualBulk(const ParamType& t, unsigned int secIdx, cons
 		return residualBulkBackwardsFlow<StateType, ResidualType, ParamType, wantJac>(t, secIdx, timeFactor, y, yDot, res);
 }
 
+namespace
+{
+	/**
+	 * @brief Selects the stencil type for the scalar bulk convection loops
+	 * @details AD state data uses the pool backed CachingStencil. Plain @c double state data
+	 *          (e.g., parameter sensitivities and backwards flow) uses the RegisterStencil,
+	 *          which keeps the WENO window in a stack array that the compiler can promote to
+	 *          registers across consecutive cells; shifting the window through the memory pool
+	 *          defeats store-to-load forwarding in these loops.
+	 */
+	template <typename StateType>
+	struct BulkStencilSelector
+	{
+		typedef CachingStencil<StateType, ArrayPool> Type;
+	};
+
+	template <>
+	struct BulkStencilSelector<double>
+	{
+		typedef RegisterStencil<2 * 3 - 1> Type; // Weno::maxStencilSize() many slots
+	};
+}
+
 template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
 int GeneralRateModel::residualBulkForwardsFlow(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res)
 {
 	const ParamType u = static_cast<ParamType>(_curVelocity);
-	const ParamType d_c = static_cast<ParamType>(getSectionDependentScalar(_colDispersion, secIdx));
+	const ParamType d_c = static_cast<ParamType>(_curColDispersion);
 	const ParamType h = static_cast<ParamType>(_colLength) / static_cast<double>(_disc.nCol);
-	const ParamType h2 = h * h;
+
+	// The combined coefficients are constant within the time section; hoisting the
+	// divisions out of the cell loop leaves pure stencil math in the loop body
+	// (the divisions are particularly expensive for AD types)
+	const ParamType dcH2 = d_c / (h * h);
+	const ParamType uH = u / h;
+	const double dcH2Dbl = static_cast<double>(dcH2);
+	const double uHDbl = static_cast<double>(uH);
 
 	Indexer idxr(_disc);
 
-	// The stencil caches parts of the state vector for better spatial coherence
-	typedef CachingStencil<StateType, ArrayPool> StencilType;
-	StencilType stencil(std::max(_weno.stencilSize(), 3u), _stencilMemory, std::max(_weno.order() - 1, 1));
+	// The stencil caches parts of the state vector for better spatial coherence;
+	// plain double states keep the window in registers (see BulkStencilSelector)
+	typedef typename BulkStencilSelector<StateType>::Type StencilType;
+	StencilType stencil(std::max(_weno.stencilSize(), 3u), _stencilMemory.local(), std::max(_weno.order() - 1, 1));
 
 	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
 	{
@@ -928,24 +1745,24 @@ int GeneralRateModel::residualBulkForwardsFlow(const ParamType& t, unsigned int
 			// Right side, leave out if we're in the last cell (boundary condition)
 			if (cadet_likely(col < _disc.nCol - 1))
 			{
-				idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[1] - stencil[0]);
+				idxr.c<ResidualType>(res, col, comp) -= dcH2 * (stencil[1] - stencil[0]);
 				// Jacobian entries
 				if (wantJac)
 				{
-					jac[0] += static_cast<double>(d_c) / static_cast<double>(h2);
-					jac[1] -= static_cast<double>(d_c) / static_cast<double>(h2);
+					jac[0] += dcH2Dbl;
+					jac[1] -= dcH2Dbl;
 				}
 			}
 
 			// Left side, leave out if we're in the first cell (boundary condition)
 			if (cadet_likely(col > 0))
 			{
-				idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[-1] - stencil[0]);
+				idxr.c<ResidualType>(res, col, comp) -= dcH2 * (stencil[-1] - stencil[0]);
 				// Jacobian entries
 				if (wantJac)
 				{
-					jac[0]  += static_cast<double>(d_c) / static_cast<double>(h2);
-					jac[-1] -= static_cast<double>(d_c) / static_cast<double>(h2);
+					jac[0]  += dcH2Dbl;
+					jac[-1] -= dcH2Dbl;
 				}
 			}
 
@@ -956,7 +1773,7 @@ int GeneralRateModel::residualBulkForwardsFlow(const ParamType& t, unsigned int
 			{
 				// Remember that vm still contains the reconstructed value of the previous 
 				// cell's *right* face, which is identical to this cell's *left* face!
-				idxr.c<ResidualType>(res, col, comp) -= u / h * vm;
+				idxr.c<ResidualType>(res, col, comp) -= uH * vm;
 
 				// Jacobian entries
 				if (wantJac)
@@ -964,13 +1781,13 @@ int GeneralRateModel::residualBulkForwardsFlow(const ParamType& t, unsigned int
 					for (int i = 0; i < 2 * wenoOrder - 1; ++i)
 						// Note that we have an offset of -1 here (compared to the right cell face below), since
 						// the reconstructed value depends on the previous stencil (which has now been moved by one cell)
-						jac[i - wenoOrder] -= static_cast<double>(u) / static_cast<double>(h) * _wenoDerivatives[i];
+						jac[i - wenoOrder] -= uHDbl * _wenoDerivatives[i];
 				}
 			}
 			else
 			{
 				// In the first cell we need to apply the boundary condition: inflow concentration
-				idxr.c<ResidualType>(res, col, comp) -= u / h * y[comp];
+				idxr.c<ResidualType>(res, col, comp) -= uH * y[comp];
 			}
 
 			// Reconstruct concentration on this cell's right face
@@ -980,12 +1797,12 @@ int GeneralRateModel::residualBulkForwardsFlow(const ParamType& t, unsigned int
 				wenoOrder = _weno.reconstruct<StateType, StencilType>(_wenoEpsilon, col, _disc.nCol, stencil, vm);
 
 			// Right side
-			idxr.c<ResidualType>(res, col, comp) += u / h * vm;
+			idxr.c<ResidualType>(res, col, comp) += uH * vm;
 			// Jacobian entries
 			if (wantJac)
 			{
 				for (int i = 0; i < 2 * wenoOrder - 1; ++i)
-					jac[i - wenoOrder + 1] += static_cast<double>(u) / static_cast<double>(h) * _wenoDerivatives[i];
+					jac[i - wenoOrder + 1] += uHDbl * _wenoDerivatives[i];
 			}
 
 			// Update stencil
@@ -1003,15 +1820,23 @@ template <typename StateType, typename ResidualType, typename ParamType, bool wa
 int GeneralRateModel::residualBulkBackwardsFlow(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res)
 {
 	const ParamType u = static_cast<ParamType>(_curVelocity);
-	const ParamType d_c = static_cast<ParamType>(getSectionDependentScalar(_colDispersion, secIdx));
+	const ParamType d_c = static_cast<ParamType>(_curColDispersion);
 	const ParamType h = static_cast<ParamType>(_colLength) / static_cast<double>(_disc.nCol);
-	const ParamType h2 = h * h;
+
+	// The combined coefficients are constant within the time section; hoisting the
+	// divisions out of the cell loop leaves pure stencil math in the loop body
+	// (the divisions are particularly expensive for AD types)
+	const ParamType dcH2 = d_c / (h * h);
+	const ParamType uH = u / h;
+	const double dcH2Dbl = static_cast<double>(dcH2);
+	const double uHDbl = static_cast<double>(uH);
 
 	Indexer idxr(_disc);
 
-	// The stencil caches parts of the state vector for better spatial coherence
-	typedef CachingStencil<StateType, ArrayPool> StencilType;
-	StencilType stencil(std::max(_weno.stencilSize(), 3u), _stencilMemory, std::max(_weno.order() - 1, 1));
+	// The stencil caches parts of the state vector for better spatial coherence;
+	// plain double states keep the window in registers (see BulkStencilSelector)
+	typedef typename BulkStencilSelector<StateType>::Type StencilType;
+	StencilType stencil(std::max(_weno.stencilSize(), 3u), _stencilMemory.local(), std::max(_weno.order() - 1, 1));
 
 	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
 	{
@@ -1060,24 +1885,24 @@ int GeneralRateModel::residualBulkBackwardsFlow(const ParamType& t, unsigned int
 			// Right side, leave out if we're in the first cell (boundary condition)
 			if (cadet_likely(col < _disc.nCol - 1))
 			{
-				idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[-1] - stencil[0]);
+				idxr.c<ResidualType>(res, col, comp) -= dcH2 * (stencil[-1] - stencil[0]);
 				// Jacobian entries
 				if (wantJac)
 				{
-					jac[0] += static_cast<double>(d_c) / static_cast<double>(h2);
-					jac[1] -= static_cast<double>(d_c) / static_cast<double>(h2);
+					jac[0] += dcH2Dbl;
+					jac[1] -= dcH2Dbl;
 				}
 			}
 
 			// Left side, leave out if we're in the last cell (boundary condition)
 			if (cadet_likely(col > 0))
 			{
-				idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[1] - stencil[0]);
+				idxr.c<ResidualType>(res, col, comp) -= dcH2 * (stencil[1] - stencil[0]);
 				// Jacobian entries
 				if (wantJac)
 				{
-					jac[0] += static_cast<double>(d_c) / static_cast<double>(h2);
-					jac[-1] -= static_cast<double>(d_c) / static_cast<double>(h2);
+					jac[0] += dcH2Dbl;
+					jac[-1] -= dcH2Dbl;
 				}
 			}
 
@@ -1088,7 +1913,7 @@ int GeneralRateModel::residualBulkBackwardsFlow(const ParamType& t, unsigned int
 			{
 				// Remember that vm still contains the reconstructed value of the previous 
 				// cell's *left* face, which is identical to this cell's *right* face!
-				idxr.c<ResidualType>(res, col, comp) += u / h * vm;
+				idxr.c<ResidualType>(res, col, comp) += uH * vm;
 
 				// Jacobian entries
 				if (wantJac)
@@ -1096,13 +1921,13 @@ int GeneralRateModel::residualBulkBackwardsFlow(const ParamType& t, unsigned int
 					for (int i = 0; i < 2 * wenoOrder - 1; ++i)
 						// Note that we have an offset of +1 here (compared to the left cell face below), since
 						// the reconstructed value depends on the previous stencil (which has now been moved by one cell)
-						jac[wenoOrder - i] += static_cast<double>(u) / static_cast<double>(h) * _wenoDerivatives[i];					
+						jac[wenoOrder - i] += uHDbl * _wenoDerivatives[i];					
 				}
 			}
 			else
 			{
 				// In the last cell (z = L) we need to apply the boundary condition: inflow concentration
-				idxr.c<ResidualType>(res, col, comp) += u / h * y[comp];
+				idxr.c<ResidualType>(res, col, comp) += uH * y[comp];
 			}
 
 			// Reconstruct concentration on this cell's left face
@@ -1112,12 +1937,12 @@ int GeneralRateModel::residualBulkBackwardsFlow(const ParamType& t, unsigned int
 				wenoOrder = _weno.reconstruct<StateType, StencilType>(_wenoEpsilon, col, _disc.nCol, stencil, vm);
 
 			// Left face
-			idxr.c<ResidualType>(res, col, comp) -= u / h * vm;
+			idxr.c<ResidualType>(res, col, comp) -= uH * vm;
 			// Jacobian entries
 			if (wantJac)
 			{
 				for (int i = 0; i < 2 * wenoOrder - 1; ++i)
-					jac[wenoOrder - i - 1] -= static_cast<double>(u) / static_cast<double>(h) * _wenoDerivatives[i];				
+					jac[wenoOrder - i - 1] -= uHDbl * _wenoDerivatives[i];				
 			}
 
 			// Update stencil (be careful because of wrap-around, might cause reading memory very far away [although never used])
@@ -1135,11 +1960,244 @@ int GeneralRateModel::residualBulkBackwardsFlow(const ParamType& t, unsigned int
 	return 0;
 }
 
+/**
+ * @brief Computes the forward flow bulk residual using the batched WENO kernel
+ * @details Specialized path for plain @c double data that is picked by the explicit
+ *          specializations of residualBulkForwardsFlow(). It implements the same
+ *          discretization as the generic kernel but reconstructs all cell face values
+ *          of a component in a single strip sweep (see Weno::reconstructStrip()),
+ *          which avoids the per-cell dispatch and workspace handling of the scalar
+ *          kernel and exposes the WENO multiply-add chains to SIMD vectorization.
+ *          The convection-dispersion term is then evaluated face-centric: a first
+ *          pass assembles the total flux on every cell face and a second pass
+ *          differences the face fluxes into the cell residuals. Each interior face
+ *          is computed exactly once instead of once per adjacent cell, and both
+ *          passes are plain array sweeps without branches.
+ *          For long columns, the passes are tiled into axial cell blocks (see
+ *          bulkCellBlockSize): reconstruction, time derivative, face assembly, and
+ *          flux differencing of a block complete while its cells are still cache
+ *          resident instead of streaming the whole column once per pass.
+ */
+template <bool wantJac>
+int GeneralRateModel::residualBulkForwardsFlowVectorized(double t, unsigned int secIdx, double timeFactor, double const* y, double const* yDot, double* res)
+{
+	const double u = static_cast<double>(_curVelocity);
+	const double d_c = static_cast<double>(_curColDispersion);
+	const double h = static_cast<double>(_colLength) / static_cast<double>(_disc.nCol);
+
+	// Section constant combined coefficients, hoisted out of the cell loop
+	const double dcH2 = d_c / (h * h);
+	const double uH = u / h;
+
+	Indexer idxr(_disc);
+
+	// The integrator evaluates all Newton iterations of a step attempt at the same time
+	// point, so the time stamp marks the step boundary for the smoothness indicator memo
+	_weno.beginTimeStep(t);
+
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		_weno.smoothnessMemoSlot(comp);
+
+		// Reset Jacobian
+		if (wantJac)
+			_jacC[comp].setAll(0.0);
+
+		linalg::BandMatrix::RowIterator jac = _jacC[comp].row(0);
+
+		// Each component occupies a contiguous strip of cells (strideColCell() == 1)
+		double const* const yComp = y + idxr.offsetC() + comp * idxr.strideColComp();
+		double const* const yDotComp = yDot ? yDot + idxr.offsetC() + comp * idxr.strideColComp() : nullptr;
+		double* const resComp = res + idxr.offsetC() + comp * idxr.strideColComp();
+		double* const fFlux = _bulkFaceFlux;
+
+		// Process the column block by block; all passes over a block finish before the
+		// next block is touched, so the cells of a block are read from cache instead of
+		// being streamed from memory once per pass
+		for (unsigned int blockStart = 0; blockStart < _disc.nCol; blockStart += bulkCellBlockSize)
+		{
+			const unsigned int blockEnd = std::min(blockStart + bulkCellBlockSize, _disc.nCol);
+
+			// Reconstruct the right cell face values of this block in one sweep
+			if (wantJac)
+				_weno.reconstructStripRange<true>(_wenoEpsilon, _disc.nCol, blockStart, blockEnd - 1, yComp, _wenoStripVm, _wenoStripDvm, _wenoStripOrder);
+			else
+				_weno.reconstructStripRange<false>(_wenoEpsilon, _disc.nCol, blockStart, blockEnd - 1, yComp, _wenoStripVm, nullptr, _wenoStripOrder);
+
+			// Add time derivative to each cell of the block
+			if (yDotComp)
+			{
+				for (unsigned int col = blockStart; col < blockEnd; ++col)
+					resComp[col] = timeFactor * yDotComp[col];
+			}
+			else
+			{
+				for (unsigned int col = blockStart; col < blockEnd; ++col)
+					resComp[col] = 0.0;
+			}
+
+			// ------------------- Face pass -------------------
+
+			// Assemble the total (convective minus dispersive) flux on every cell face of the
+			// block; each interior face is evaluated once instead of once per adjacent cell.
+			// The boundary faces carry no dispersive flux, the inlet face carries the inflow
+			// concentration. The left face of the first block cell was assembled by the
+			// previous block.
+			if (blockStart == 0)
+				fFlux[0] = uH * y[comp];
+			for (unsigned int f = blockStart + 1; f < blockEnd; ++f)
+				fFlux[f] = uH * _wenoStripVm[f - 1] - dcH2 * (yComp[f] - yComp[f - 1]);
+			if (blockEnd == _disc.nCol)
+				fFlux[_disc.nCol] = uH * _wenoStripVm[_disc.nCol - 1];
+			else
+				fFlux[blockEnd] = uH * _wenoStripVm[blockEnd - 1] - dcH2 * (yComp[blockEnd] - yComp[blockEnd - 1]);
+
+			// ------------------- Cell pass -------------------
+
+			// Difference the face fluxes into the cell residuals
+			for (unsigned int col = blockStart; col < blockEnd; ++col)
+				resComp[col] += fFlux[col + 1] - fFlux[col];
+
+			// The Jacobian entries scatter over the WENO stencil bands and do not fit the two
+			// pass layout, they stay in a separate loop (the row iterator advances across the
+			// block boundaries)
+			if (wantJac)
+			{
+				for (unsigned int col = blockStart; col < blockEnd; ++col)
+				{
+					// ------------------- Dispersion -------------------
+
+					// Right side, leave out if we're in the last cell (boundary condition)
+					if (cadet_likely(col < _disc.nCol - 1))
+					{
+						jac[0] += dcH2;
+						jac[1] -= dcH2;
+					}
+
+					// Left side, leave out if we're in the first cell (boundary condition)
+					if (cadet_likely(col > 0))
+					{
+						jac[0]  += dcH2;
+						jac[-1] -= dcH2;
+					}
+
+					// ------------------- Convection -------------------
+
+					// Convection through this cell's left face, which is the previous
+					// cell's right face and hence already reconstructed
+					if (cadet_likely(col > 0))
+					{
+						const int wenoOrder = _wenoStripOrder[col - 1];
+						double const* const Dvm = _wenoStripDvm + (col - 1) * Weno::maxStencilSize();
+						for (int i = 0; i < 2 * wenoOrder - 1; ++i)
+							// Note that we have an offset of -1 here (compared to the right cell face below), since
+							// the reconstructed value depends on the previous cell's stencil
+							jac[i - wenoOrder] -= uH * Dvm[i];
+					}
+
+					// Right side
+					const int wenoOrder = _wenoStripOrder[col];
+					double const* const Dvm = _wenoStripDvm + col * Weno::maxStencilSize();
+					for (int i = 0; i < 2 * wenoOrder - 1; ++i)
+						jac[i - wenoOrder + 1] += uH * Dvm[i];
+
+					++jac;
+				}
+			}
+		}
+	}
+
+	// Film diffusion with flux into beads is added in residualFlux() function
+
+	return 0;
+}
+
+template <>
+int GeneralRateModel::residualBulkForwardsFlow<double, double, double, true>(const double& t, unsigned int secIdx, const double& timeFactor, double const* y, double const* yDot, double* res)
+{
+	return residualBulkForwardsFlowVectorized<true>(t, secIdx, timeFactor, y, yDot, res);
+}
+
+template <>
+int GeneralRateModel::residualBulkForwardsFlow<double, double, double, false>(const double& t, unsigned int secIdx, const double& timeFactor, double const* y, double const* yDot, double* res)
+{
+	return residualBulkForwardsFlowVectorized<false>(t, secIdx, timeFactor, y, yDot, res);
+}
+
 template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
 int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell, unsigned int secIdx, const ParamType& timeFactor, StateType const* yBase, double const* yDotBase, ResidualType* resBase)
+{
+	return residualParticleImpl<StateType, ResidualType, ParamType, wantJac, 0>(t, colCell, secIdx, timeFactor, yBase, yDotBase, resBase);
+}
+
+namespace
+{
+	/**
+	 * @brief Evaluates the bound phases of all particle shells with one batched binding model call
+	 * @details Only the pure @c double evaluation can use IBindingModel::residualBatch(). The
+	 *          template overload below catches all type combinations involving AD data types and
+	 *          reports that the caller has to evaluate the bound phases shell by shell.
+	 * @return @c true if the bound phases have been evaluated, otherwise @c false
+	 */
+	inline bool bindingResidualBatch(IBindingModel& binding, unsigned int nShells, double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		double const* y, double const* yDot, double* res, unsigned int shellStride)
+	{
+		binding.residualBatch(nShells, t, z, r, secIdx, timeFactor, y, yDot, res, shellStride);
+		return true;
+	}
+
+	template <typename StateType, typename ResidualType, typename ParamType>
+	inline bool bindingResidualBatch(IBindingModel& binding, unsigned int nShells, const ParamType& t, double z, double const* r, unsigned int secIdx, const ParamType& timeFactor,
+		StateType const* y, double const* yDot, ResidualType* res, unsigned int shellStride)
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Returns the surface area per volume of a particle shell divided by the particle radius
+	 * @details The pure @c double overload reads the quotient from the table precomputed at the
+	 *          section transition; the template overload performs the division on the AD type.
+	 */
+	inline double areaPerVolume(double surfAreaPerVolume, const double& radius, double const* precomputed, unsigned int par)
+	{
+		return precomputed[par];
+	}
+
+	template <typename ParamType>
+	inline ParamType areaPerVolume(double surfAreaPerVolume, const ParamType& radius, double const* precomputed, unsigned int par)
+	{
+		return surfAreaPerVolume / radius;
+	}
+
+	/**
+	 * @brief Computes the discretized film diffusion coefficients of the flux equations
+	 * @details The pure @c double overload copies the coefficients precomputed at the section
+	 *          transition; the template overload evaluates the formula on the AD types.
+	 */
+	inline void discretizedFilmDiffusion(double* kf_FV, unsigned int nComp, double const* precomputed, const double& radius, const double& epsP,
+		double relOuterShellHalfRadius, double const* parDiff, double const* filmDiff)
+	{
+		std::copy(precomputed, precomputed + nComp, kf_FV);
+	}
+
+	template <typename ParamType>
+	inline void discretizedFilmDiffusion(ParamType* kf_FV, unsigned int nComp, double const* precomputed, const ParamType& radius, const ParamType& epsP,
+		double relOuterShellHalfRadius, ParamType const* parDiff, ParamType const* filmDiff)
+	{
+		for (unsigned int comp = 0; comp < nComp; ++comp)
+			kf_FV[comp] = 1.0 / (radius * relOuterShellHalfRadius / epsP / parDiff[comp] + 1.0 / filmDiff[comp]);
+	}
+}
+
+template <typename StateType, typename ResidualType, typename ParamType, bool wantJac, unsigned int compileTimeNComp>
+int GeneralRateModel::residualParticleImpl(const ParamType& t, unsigned int colCell, unsigned int secIdx, const ParamType& timeFactor, StateType const* yBase, double const* yDotBase, ResidualType* resBase)
 {
 	Indexer idxr(_disc);
 
+	// A compile time component count allows the compiler to unroll the mobile phase loop;
+	// compileTimeNComp == 0 falls back to the runtime value
+	const unsigned int nComp = (compileTimeNComp > 0) ? compileTimeNComp : _disc.nComp;
+
 	// Go to the particle block of the given column cell
 	StateType const* y = yBase + idxr.offsetCp(colCell);
 	double const* yDot = yDotBase + idxr.offsetCp(colCell);
@@ -1149,11 +2207,11 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 	const ParamType radius = static_cast<ParamType>(_parRadius);
 	const ParamType invBetaP = 1.0 / static_cast<ParamType>(_parPorosity) - 1.0;
 
-	active const* const parDiff = getSectionDependentSlice(_parDiffusion, _disc.nComp, secIdx);
+	ParamType const* const parDiff = selectParamSlice<ParamType>(_curParDiffusion, _curParDiffusionDense.data());
 
 	// Ordering of particle surface diffusion:
 	// bnd0comp0, bnd0comp1, bnd0comp2, bnd1comp0, bnd1comp1, bnd1comp2
-	active const* const parSurfDiff = getSectionDependentSlice(_parSurfDiffusion, idxr.strideParBound(), secIdx);
+	ParamType const* const parSurfDiff = selectParamSlice<ParamType>(_curParSurfDiffusion, _curParSurfDiffusionDense.data());
 
 	// Midpoint of current column cell (z coordinate) - needed in externally dependent adsorption kinetic
 	const double z = 1.0 / static_cast<double>(_disc.nCol) * (0.5 + colCell);
@@ -1169,15 +2227,23 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 	// continuing to the last upper diagonal by using the native() method.
 	linalg::BandMatrix::RowIterator jac = _jacP[colCell].row(0);
 
+	// If no Jacobian is assembled and no AD data types are involved, all bound phases of this
+	// particle are evaluated with a single batched binding model call; the transport terms
+	// below do not write to the bound phase residuals and are still computed shell by shell
+	bool boundPhasesDone = false;
+	if (!wantJac)
+		boundPhasesDone = bindingResidualBatch(*_binding, _disc.nPar, t, z, _parDisc->centerRadius.data(), secIdx, timeFactor,
+			y + idxr.strideParLiquid(), yDotBase ? yDot + idxr.strideParLiquid() : nullptr, res + idxr.strideParLiquid(), idxr.strideParShell());
+
 	// Loop over particle cells
 	for (unsigned int par = 0; par < _disc.nPar; ++par)
 	{
 		// Geometry
-		const ParamType outerAreaPerVolume = _parOuterSurfAreaPerVolume[par] / radius;
-		const ParamType innerAreaPerVolume = _parInnerSurfAreaPerVolume[par] / radius;
+		const ParamType outerAreaPerVolume = areaPerVolume(_parDisc->outerSurfAreaPerVolume[par], radius, _parOuterApVDense.data(), par);
+		const ParamType innerAreaPerVolume = areaPerVolume(_parDisc->innerSurfAreaPerVolume[par], radius, _parInnerApVDense.data(), par);
 
 		// Mobile phase
-		for (unsigned int comp = 0; comp < _disc.nComp; ++comp, ++res, ++y, ++yDot, ++jac)
+		for (unsigned int comp = 0; comp < nComp; ++comp, ++res, ++y, ++yDot, ++jac)
 		{
 			*res = 0.0;
 			const unsigned int nBound = _disc.nBound[comp];
@@ -1190,13 +2256,7 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 
 				// Sum dq_comp^1 / dt + dq_comp^2 / dt + ... + dq_comp^{N_comp} / dt
 				for (unsigned int i = 0; i < nBound; ++i)
-					// Index explanation:
-					//   -comp -> go back to beginning of liquid phase
-					//   + strideParLiquid() skip to solid phase
-					//   + offsetBoundComp() jump to component (skips all bound states of previous components)
-					//   + i go to current bound state
-					// Remember this, you'll see it quite a lot ...
-					*res += yDot[idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i];
+					*res += yDot[idxr.offsetLiquidToBound(comp, i)];
 
 				// Divide by beta_p and add dcp_i / dt
 				*res = timeFactor * (yDot[0] + invBetaP * res[0]);
@@ -1209,7 +2269,7 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 			if (cadet_likely(par != 0))
 			{
 				// Difference between two cell-centers
-				const ParamType dr = (_parCenterRadius[par - 1] - _parCenterRadius[par]) * radius;
+				const ParamType dr = (_parDisc->centerRadius[par - 1] - _parDisc->centerRadius[par]) * radius;
 
 				// Molecular diffusion contribution
 				const ResidualType gradCp = (y[-idxr.strideParShell()] - y[0]) / dr;
@@ -1218,8 +2278,7 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 				// Surface diffusion contribution
 				for (unsigned int i = 0; i < nBound; ++i)
 				{
-					// See above for explanation of curIdx value
-					const int curIdx = idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i;
+					const int curIdx = idxr.offsetLiquidToBound(comp, i);
 					const ResidualType gradQ = (y[-idxr.strideParShell() + curIdx] - y[curIdx]) / dr;
 					*res -= outerAreaPerVolume * static_cast<ParamType>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) * invBetaP * gradQ;
 				}
@@ -1237,8 +2296,7 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 					// Solid phase
 					for (unsigned int i = 0; i < nBound; ++i)
 					{
-						// See above for explanation of curIdx value
-						const int curIdx = idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i;
+						const int curIdx = idxr.offsetLiquidToBound(comp, i);
 						jac[curIdx] += ouApV * localInvBetaP * static_cast<double>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j)
 						jac[-idxr.strideParShell() + curIdx] = -ouApV * localInvBetaP * static_cast<double>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j-1)
 					}
@@ -1250,7 +2308,7 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 			if (cadet_likely(par != _disc.nPar - 1))
 			{
 				// Difference between two cell-centers
-				const ParamType dr = (_parCenterRadius[par] - _parCenterRadius[par + 1]) * radius;
+				const ParamType dr = (_parDisc->centerRadius[par] - _parDisc->centerRadius[par + 1]) * radius;
 
 				// Molecular diffusion contribution
 				const ResidualType gradCp = (y[0] - y[idxr.strideParShell()]) / dr;
@@ -1259,8 +2317,7 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 				// Surface diffusion contribution
 				for (unsigned int i = 0; i < nBound; ++i)
 				{
-					// See above for explanation of curIdx value
-					const unsigned int curIdx = idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i;
+					const int curIdx = idxr.offsetLiquidToBound(comp, i);
 					const ResidualType gradQ = (y[curIdx] - y[idxr.strideParShell() + curIdx]) / dr;
 					*res += innerAreaPerVolume * static_cast<ParamType>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) * invBetaP * gradQ;
 				}
@@ -1278,8 +2335,7 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 					// Solid phase
 					for (unsigned int i = 0; i < nBound; ++i)
 					{
-						// See above for explanation of curIdx value
-						const int curIdx = idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i;
+						const int curIdx = idxr.offsetLiquidToBound(comp, i);
 						jac[curIdx] += inApV * localInvBetaP * static_cast<double>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j)
 						jac[idxr.strideParShell() + curIdx] = -inApV * localInvBetaP * static_cast<double>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j-1)
 					}
@@ -1291,11 +2347,14 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 		if (!yDotBase)
 			yDot = nullptr;
 
-		_binding->residual(t, z, _parCenterRadius[par], secIdx, timeFactor, y, yDot, res);
-		if (wantJac)
+		if (!boundPhasesDone)
 		{
-			// static_cast should be sufficient here, but this statement is also analyzed when wantJac = false
-			_binding->analyticJacobian(static_cast<double>(t), z, _parCenterRadius[par], secIdx, reinterpret_cast<double const*>(y), jac);
+			_binding->residual(t, z, _parDisc->centerRadius[par], secIdx, timeFactor, y, yDot, res);
+			if (wantJac)
+			{
+				// static_cast should be sufficient here, but this statement is also analyzed when wantJac = false
+				_binding->analyticJacobian(static_cast<double>(t), z, _parDisc->centerRadius[par], secIdx, reinterpret_cast<double const*>(y), jac);
+			}
 		}
 
 		// Advance pointers over all bound states
@@ -1307,6 +2366,34 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 	return 0;
 }
 
+template <>
+int GeneralRateModel::residualParticle<double, double, double, true>(const double& t, unsigned int colCell, unsigned int secIdx, const double& timeFactor, double const* y, double const* yDot, double* res)
+{
+	// Dispatch to kernels with the number of components baked in for common small counts
+	switch (_disc.nComp)
+	{
+		case 1: return residualParticleImpl<double, double, double, true, 1>(t, colCell, secIdx, timeFactor, y, yDot, res);
+		case 2: return residualParticleImpl<double, double, double, true, 2>(t, colCell, secIdx, timeFactor, y, yDot, res);
+		case 3: return residualParticleImpl<double, double, double, true, 3>(t, colCell, secIdx, timeFactor, y, yDot, res);
+		case 4: return residualParticleImpl<double, double, double, true, 4>(t, colCell, secIdx, timeFactor, y, yDot, res);
+		default: return residualParticleImpl<double, double, double, true, 0>(t, colCell, secIdx, timeFactor, y, yDot, res);
+	}
+}
+
+template <>
+int GeneralRateModel::residualParticle<double, double, double, false>(const double& t, unsigned int colCell, unsigned int secIdx, const double& timeFactor, double const* y, double const* yDot, double* res)
+{
+	// Dispatch to kernels with the number of components baked in for common small counts
+	switch (_disc.nComp)
+	{
+		case 1: return residualParticleImpl<double, double, double, false, 1>(t, colCell, secIdx, timeFactor, y, yDot, res);
+		case 2: return residualParticleImpl<double, double, double, false, 2>(t, colCell, secIdx, timeFactor, y, yDot, res);
+		case 3: return residualParticleImpl<double, double, double, false, 3>(t, colCell, secIdx, timeFactor, y, yDot, res);
+		case 4: return residualParticleImpl<double, double, double, false, 4>(t, colCell, secIdx, timeFactor, y, yDot, res);
+		default: return residualParticleImpl<double, double, double, false, 0>(t, colCell, secIdx, timeFactor, y, yDot, res);
+	}
+}
+
 template <typename StateType, typename ResidualType, typename ParamType>
 int GeneralRateModel::residualFlux(const ParamType& t, unsigned int secIdx, StateType const* yBase, double const* yDotBase, ResidualType* resBase)
 {
@@ -1316,25 +2403,23 @@ int GeneralRateModel::residualFlux(const ParamType& t, unsigned int secIdx, Stat
 	const ParamType epsP = static_cast<ParamType>(_parPorosity);
 	const ParamType radius = static_cast<ParamType>(_parRadius);
 
-	active const* const filmDiff = getSectionDependentSlice(_filmDiffusion, _disc.nComp, secIdx);
+	ParamType const* const filmDiff = selectParamSlice<ParamType>(_curFilmDiffusion, _curFilmDiffusionDense.data());
 	// Ordering of particle surface diffusion:
 	// bnd0comp0, bnd0comp1, bnd0comp2, bnd1comp0, bnd1comp1, bnd1comp2
-	active const* const parDiff = getSectionDependentSlice(_parDiffusion, _disc.nComp, secIdx);
+	ParamType const* const parDiff = selectParamSlice<ParamType>(_curParDiffusion, _curParDiffusionDense.data());
 
 	const ParamType surfaceToVolumeRatio = 3.0 / radius;
-	const ParamType outerAreaPerVolume = _parOuterSurfAreaPerVolume[0] / radius;
+	const ParamType outerAreaPerVolume = _parDisc->outerSurfAreaPerVolume[0] / radius;
 
 	const ParamType jacCF_val = invBetaC * surfaceToVolumeRatio;
 	const ParamType jacPF_val = -outerAreaPerVolume / epsP;
 
 	// Discretized film diffusion kf for finite volumes
-	ParamType* const kf_FV = _discParFlux.create<ParamType>(_disc.nComp);
+	ArrayPool& discParFlux = _discParFlux.local();
+	ParamType* const kf_FV = discParFlux.create<ParamType>(_disc.nComp);
 
-	const double relOuterShellHalfRadius = 0.5 * _parCellSize[0];
-	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
-	{
-		kf_FV[comp] = 1.0 / (radius * relOuterShellHalfRadius / epsP / static_cast<ParamType>(parDiff[comp]) + 1.0 / static_cast<ParamType>(filmDiff[comp]));
-	}
+	const double relOuterShellHalfRadius = 0.5 * _parDisc->cellSize[0];
+	discretizedFilmDiffusion(kf_FV, _disc.nComp, _curKfFVDense.data(), radius, epsP, relOuterShellHalfRadius, parDiff, filmDiff);
 
 	// Get offsets
 	ResidualType* const resCol = resBase + idxr.offsetC();
@@ -1383,28 +2468,22 @@ int GeneralRateModel::residualFlux(const ParamType& t, unsigned int secIdx, Stat
 		}
 	}
 
-	_discParFlux.destroy<ParamType>();
+	discParFlux.destroy<ParamType>();
 	return 0;
 }
 
 /**
  * @brief Assembles off diagonal Jacobian blocks
  * @details Assembles the fixed blocks @f$ J_{0,f}, \dots, J_{N_p,f} @f$ and @f$ J_{f,0}, \dots, J_{f, N_p}. @f$
- *          The blocks are fixed for each section.
+ *          The blocks are fixed for each section. Their sparsity pattern depends only on the
+ *          discretization, which does not change between sections or reconfigurations, so the
+ *          pattern is built and compiled into CSR format only once. Subsequent calls merely
+ *          overwrite the element values in place.
  * @param [in] t Current time
  * @param [in] secIdx Index of the current section
  */
 void GeneralRateModel::assembleOffdiagJac(double t, unsigned int secIdx)
 {
-	// Clear matrices for new assembly
-	_jacCF.clear();
-	_jacFC.clear();
-	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
-	{
-		_jacPF[pblk].clear();
-		_jacFP[pblk].clear();
-	}
-
 	Indexer idxr(_disc);
 
 	const double invBetaC = 1.0 / static_cast<double>(_colPorosity) - 1.0;
@@ -1417,17 +2496,57 @@ void GeneralRateModel::assembleOffdiagJac(double t, unsigned int secIdx)
 	active const* const parDiff = getSectionDependentSlice(_parDiffusion, _disc.nComp, secIdx);
 
 	const double surfaceToVolumeRatio = 3.0 / radius;
-	const double outerAreaPerVolume   = _parOuterSurfAreaPerVolume[0] / radius;
+	const double outerAreaPerVolume   = _parDisc->outerSurfAreaPerVolume[0] / radius;
 
 	const double jacCF_val = invBetaC * surfaceToVolumeRatio;
 	const double jacPF_val = -outerAreaPerVolume / epsP;
-	const double relOuterShellHalfRadius = 0.5 * _parCellSize[0];
+	const double relOuterShellHalfRadius = 0.5 * _parDisc->cellSize[0];
 
 	// Discretized film diffusion kf for finite volumes
-	double* const kf_FV = _discParFlux.create<double>(_disc.nComp);
+	ArrayPool& discParFlux = _discParFlux.local();
+	double* const kf_FV = discParFlux.create<double>(_disc.nComp);
 	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
 		kf_FV[comp] = 1.0 / (radius * relOuterShellHalfRadius / epsP / static_cast<double>(parDiff[comp]) + 1.0 / static_cast<double>(filmDiff[comp]));
 
+	if (_offdiagJacPatternValid)
+	{
+		// The pattern already exists, only the section dependent values have changed.
+		// Overwrite them in insertion order and refresh the compiled CSR copies.
+		std::fill_n(_jacCF.values().data(), _jacCF.numNonZero(), jacCF_val);
+
+		double* const fcVals = _jacFC.values().data();
+		for (unsigned int bnd = 0; bnd < _disc.nCol; ++bnd)
+		{
+			for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+				fcVals[bnd * _disc.nComp + comp] = -kf_FV[comp];
+		}
+
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+		{
+			std::fill_n(_jacPF[pblk].values().data(), _jacPF[pblk].numNonZero(), jacPF_val);
+
+			double* const fpVals = _jacFP[pblk].values().data();
+			for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+				fpVals[comp] = kf_FV[comp];
+		}
+
+		_jacCFCompressed.updateValuesFrom(_jacCF);
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+			_jacPFCompressed[pblk].updateValuesFrom(_jacPF[pblk]);
+
+		discParFlux.destroy<double>();
+		return;
+	}
+
+	// Clear matrices for new assembly
+	_jacCF.clear();
+	_jacFC.clear();
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	{
+		_jacPF[pblk].clear();
+		_jacFP[pblk].clear();
+	}
+
 	// Note that the J_f block, which is the identity matrix, is treated in the linear solver
 
 	// J_{0,f} block, adds flux to column void / bulk volume equations
@@ -1468,7 +2587,49 @@ void GeneralRateModel::assembleOffdiagJac(double t, unsigned int secIdx)
 		}
 	}
 
-	_discParFlux.destroy<double>();
+	// Compile the assembled blocks into CSR format for the matrix-vector
+	// products performed in every GMRES iteration of the linear solver. The
+	// flux equation rows J_{f,0} and J_{f,p} are not compiled: they only carry
+	// the discretized film diffusion coefficients and are applied as a fused
+	// array operation in subtractFluxRows()
+	_jacCFCompressed.compressFrom(_jacCF);
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+		_jacPFCompressed[pblk].compressFrom(_jacPF[pblk]);
+
+	_offdiagJacPatternValid = true;
+
+	discParFlux.destroy<double>();
+}
+
+/**
+ * @brief Subtracts the off-diagonal flux equation rows applied to a state from a vector
+ * @details Computes @f$ \text{out} = \text{out} - J_{f,0} x_0 - \sum_i J_{f,i} x_i
+ *          = \text{out} + k_f \left( c - c_p \right) @f$ in a single fused pass. The
+ *          off-diagonal flux rows only carry the discretized film diffusion coefficients
+ *          @f$ \pm k_{f,FV} @f$ (see assembleOffdiagJac()), which are taken from the dense
+ *          mirror @c _curKfFVDense. Since the bulk block is component-major, the pass runs
+ *          over contiguous cell ranges with one constant coefficient per component and
+ *          vectorizes; only the outer particle shell concentrations are gathered strided.
+ * @param [in] x Full state vector the flux rows are applied to
+ * @param [out] out Flux-sized vector the result is subtracted from
+ * @param [in] idxr Indexer
+ */
+void GeneralRateModel::subtractFluxRows(double const* const x, double* const out, const Indexer& idxr) const
+{
+	double const* const c = x + idxr.offsetC();
+	double const* const cp = x + idxr.offsetCp();
+	const int strideCp = idxr.strideParBlock();
+
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		const double kf = _curKfFVDense[comp];
+		double const* const cComp = c + comp * idxr.strideColComp();
+		double const* const cpComp = cp + comp;
+		double* const outComp = out + comp * idxr.strideColComp();
+
+		for (unsigned int col = 0; col < _disc.nCol; ++col)
+			outComp[col] += kf * (cComp[col] - cpComp[col * strideCp]);
+	}
 }
 
 int GeneralRateModel::residualSensFwdWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot,
@@ -1503,7 +2664,7 @@ int GeneralRateModel::residualSensFwdAdOnly(const active& t, unsigned int secIdx
 }
 
 int GeneralRateModel::residualSensFwdCombine(const active& timeFactor, const std::vector<const double*>& yS, const std::vector<const double*>& ySdot,
-	const std::vector<double*>& resS, active const* adRes, double* const tmp1, double* const tmp2, double* const tmp3)
+	const std::vector<double*>& resS, active const* adRes, unsigned int const* dirMap, double* const tmp1, double* const tmp2, double* const tmp3)
 {
 /*
 	LOG(Debug) << "s = " << cadet::log::VectorPtr<double>(yS[0], numDofs()) << "\n"
@@ -1512,33 +2673,30 @@ int GeneralRateModel::residualSensFwdCombine(const active& timeFactor, const std
 
 	BENCH_SCOPE(_timerResidualSens);
 
-	// tmp1 stores result of (dF / dy) * s
-	// tmp2 stores result of (dF / dyDot) * sDot
-
-	for (unsigned int param = 0; param < yS.size(); param++)
-	{
-		// Directional derivative (dF / dy) * s
-		multiplyWithJacobian(yS[param], tmp1);
-
-		// Directional derivative (dF / dyDot) * sDot
-		multiplyWithDerivativeJacobian(ySdot[param], tmp2, static_cast<double>(timeFactor));
-
-		double* const ptrResS = resS[param];
+	// Directional derivatives (dF / dy) * s + (dF / dyDot) * sDot of all parameters at
+	// once; each banded Jacobian block is swept a single time over the whole panel of
+	// vectors and the time derivative products are fused into the same traversal
+	multiplyWithCombinedJacobians(yS, ySdot, resS, static_cast<double>(timeFactor));
 
-		BENCH_START(_timerResidualSensPar);
+	BENCH_START(_timerResidualSensPar);
 
-		// Complete sens residual is the sum:
-		// TODO: Chunk TBB loop
+	// Complete sens residual is the sum:
+	// The parameters are mutually independent, so the work is distributed over the
+	// parameters (each thread adds the AD derivatives of one full residual vector)
+	// instead of splitting the vector of a single parameter into tiny chunks.
+	// Each vector is summed by exactly one thread in fixed element order, so the
+	// result is bitwise identical for any thread count
 #ifdef CADET_PARALLELIZE
-		tbb::parallel_for(size_t(0), size_t(numDofs()), [&](size_t i)
+	tbb::parallel_for(size_t(0), yS.size(), [&](size_t param)
 #else
-		for (unsigned int i = 0; i < numDofs(); ++i)
+	for (unsigned int param = 0; param < yS.size(); ++param)
 #endif
-		{
-			ptrResS[i] = tmp1[i] + tmp2[i] + adRes[i].getADValue(param);
-		} CADET_PARFOR_END;
+	{
+		double* const ptrResS = resS[param];
+		const unsigned int dir = dirMap ? dirMap[param] : param;
 
-		BENCH_STOP(_timerResidualSensPar);
+		for (unsigned int i = 0; i < numDofs(); ++i)
+			ptrResS[i] += adRes[i].getADValue(dir);
 
 /*
 		LOG(Debug) << "tmp1 = " << cadet::log::VectorPtr<double>(tmp1, numDofs()) << "\n"
@@ -1546,7 +2704,9 @@ int GeneralRateModel::residualSensFwdCombine(const active& timeFactor, const std
 		           << "adRes = " << cadet::log::VectorPtr<active>(adRes, numDofs()) << "\n"
 		           << "sensRes = " << cadet::log::VectorPtr<double>(ptrResS, numDofs());
 */
-	}
+	} CADET_PARFOR_END;
+
+	BENCH_STOP(_timerResidualSensPar);
 
 	return 0;
 }
@@ -1612,6 +2772,274 @@ void GeneralRateModel::multiplyWithJacobian(double const* yS, double alpha, doub
 	_jacInlet.multiplyAdd(yS, ret + idxr.offsetC(), alpha);
 }
 
+/**
+ * @brief Multiplies the given vector with the transposed system Jacobian (i.e., @f$ \frac{\partial F}{\partial y}^T @f$)
+ * @details Actually, the operation @f$ z = \alpha \frac{\partial F}{\partial y}^T x + \beta z @f$ is performed.
+ *          Transposing exchanges the roles of the off-diagonal blocks: the flux columns of the
+ *          transport equations scatter into the flux DOFs and the transport columns of the flux
+ *          equation scatter into the bulk and particle DOFs.
+ * @param [in] yS Vector @f$ x @f$ that is transformed by the transposed Jacobian @f$ \frac{\partial F}{\partial y}^T @f$
+ * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ \frac{\partial F}{\partial y}^T @f$
+ * @param [in] beta Factor @f$ \beta @f$ in front of @f$ z @f$
+ * @param [in,out] ret Vector @f$ z @f$ which stores the result of the operation
+ */
+void GeneralRateModel::multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret)
+{
+	Indexer idxr(_disc);
+
+	// Handle identity matrix of inlet DOFs; the transposed inlet map adds the
+	// contributions of the first bulk cells afterwards
+	for (unsigned int i = 0; i < _disc.nComp; ++i)
+	{
+		ret[i] = alpha * yS[i] + beta * ret[i];
+	}
+
+	// Map column inlet (first bulk cells) back to inlet DOFs
+	_jacInlet.transposedMultiplyAdd(yS + idxr.offsetC(), ret, alpha);
+
+	// Threads that are done with multiplying with the bulk column blocks can proceed
+	// to the particle blocks
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
+#else
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+#endif
+	{
+		_jacC[comp].transposedMultiplyVector(yS + comp * idxr.strideColComp() + idxr.offsetC(), alpha, beta,
+			ret + comp * idxr.strideColComp() + idxr.offsetC());
+	} CADET_PARFOR_END;
+
+	// Transposed column block of the flux equation scatters into the bulk DOFs
+	_jacFC.transposedMultiplyAdd(yS + idxr.offsetJf(), ret + idxr.offsetC(), alpha);
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
+#else
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+#endif
+	{
+		const int localOffset = idxr.offsetCp(pblk);
+		_jacP[pblk].transposedMultiplyVector(yS + localOffset, alpha, beta, ret + localOffset);
+		_jacFP[pblk].transposedMultiplyAdd(yS + idxr.offsetJf(), ret + localOffset, alpha);
+	} CADET_PARFOR_END;
+
+	// Handle flux equation
+
+	// Set fluxes(ret) = fluxes(yS)
+	// This applies the identity matrix in the bottom right corner of the transposed Jaocbian (flux equation)
+	for (unsigned int i = idxr.offsetJf(); i < numDofs(); ++i)
+		ret[i] = alpha * yS[i] + beta * ret[i];
+
+	double* const retJf = ret + idxr.offsetJf();
+	_jacCF.transposedMultiplyAdd(yS + idxr.offsetC(), retJf, alpha);
+
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+		_jacPF[pblk].transposedMultiplyAdd(yS + idxr.offsetCp(pblk), retJf, alpha);
+}
+
+/**
+ * @brief Multiplies a panel of vectors with the system Jacobian (i.e., @f$ \frac{\partial F}{\partial y} @f$)
+ * @details Computes @f$ z_i = \frac{\partial F}{\partial y} x_i @f$ for all vectors of the panel.
+ *          Each banded Jacobian block is swept a single time over all vectors (see
+ *          linalg::BandMatrix::multiplyVectors()) instead of once per vector, which pays off
+ *          when many parameter sensitivities are propagated simultaneously.
+ * @param [in] yS Vectors @f$ x_i @f$ that are transformed by the Jacobian @f$ \frac{\partial F}{\partial y} @f$
+ * @param [out] ret Vectors @f$ z_i @f$ which store the result of the operation
+ */
+void GeneralRateModel::multiplyWithJacobian(const std::vector<const double*>& yS, const std::vector<double*>& ret)
+{
+	Indexer idxr(_disc);
+	const unsigned int nVec = yS.size();
+
+	// Assemble panels of offset pointers into the vectors, one slice per banded block
+	std::vector<double const*> xPanel(nVec * (_disc.nComp + _disc.nCol));
+	std::vector<double*> yPanel(nVec * (_disc.nComp + _disc.nCol));
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		for (unsigned int v = 0; v < nVec; ++v)
+		{
+			xPanel[comp * nVec + v] = yS[v] + comp * idxr.strideColComp() + idxr.offsetC();
+			yPanel[comp * nVec + v] = ret[v] + comp * idxr.strideColComp() + idxr.offsetC();
+		}
+	}
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	{
+		for (unsigned int v = 0; v < nVec; ++v)
+		{
+			xPanel[(_disc.nComp + pblk) * nVec + v] = yS[v] + idxr.offsetCp(pblk);
+			yPanel[(_disc.nComp + pblk) * nVec + v] = ret[v] + idxr.offsetCp(pblk);
+		}
+	}
+
+	// Handle identity matrix of inlet DOFs
+	for (unsigned int v = 0; v < nVec; ++v)
+	{
+		for (unsigned int i = 0; i < _disc.nComp; ++i)
+			ret[v][i] = yS[v][i];
+	}
+
+	// Threads that are done with multiplying with the bulk column blocks can proceed
+	// to the particle blocks
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nComp + _disc.nCol), [&](size_t idx)
+#else
+	for (unsigned int idx = 0; idx < _disc.nComp + _disc.nCol; ++idx)
+#endif
+	{
+		if (idx < _disc.nComp)
+		{
+			_jacC[idx].multiplyVectors(xPanel.data() + idx * nVec, nVec, 1.0, 0.0, yPanel.data() + idx * nVec);
+		}
+		else
+		{
+			const unsigned int pblk = idx - _disc.nComp;
+			_jacP[pblk].multiplyVectors(xPanel.data() + idx * nVec, nVec, 1.0, 0.0, yPanel.data() + idx * nVec);
+			for (unsigned int v = 0; v < nVec; ++v)
+				_jacPF[pblk].multiplyVector(yS[v] + idxr.offsetJf(), 1.0, 1.0, ret[v] + idxr.offsetCp(pblk));
+		}
+	} CADET_PARFOR_END;
+
+	for (unsigned int v = 0; v < nVec; ++v)
+	{
+		// Multiply with the flux block in the column equation
+		_jacCF.multiplyVector(yS[v] + idxr.offsetJf(), 1.0, 1.0, ret[v] + idxr.offsetC());
+
+		// Handle flux equation: identity matrix in the bottom right corner of the Jacobian
+		for (unsigned int i = idxr.offsetJf(); i < numDofs(); ++i)
+			ret[v][i] = yS[v][i];
+
+		double* const retJf = ret[v] + idxr.offsetJf();
+		_jacFC.multiplyVector(yS[v] + idxr.offsetC(), 1.0, 1.0, retJf);
+
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+			_jacFP[pblk].multiplyVector(yS[v] + idxr.offsetCp(pblk), 1.0, 1.0, retJf);
+
+		// Map inlet DOFs to the column inlet (first bulk cells)
+		_jacInlet.multiplyAdd(yS[v], ret[v] + idxr.offsetC(), 1.0);
+	}
+}
+
+/**
+ * @brief Multiplies given vectors with the Jacobian and the time derivative Jacobian in one pass
+ * @details Computes @f$ z_i = \frac{\partial F}{\partial y} x_i + \frac{\partial F}{\partial \dot{y}} \dot{x}_i @f$
+ *          for all vectors of the panel. The matrix-free time derivative products are written to
+ *          @p ret first and the banded blocks then accumulate their products on top while each
+ *          block's slice of @p ret is still in cache. This way, the Jacobian band storage is
+ *          traversed only once per panel and no temporary vector is needed for combining the
+ *          two products, which saves memory bandwidth in sensitivity runs with many parameters.
+ * @param [in] yS Vectors @f$ x_i @f$ the Jacobian @f$ \frac{\partial F}{\partial y} @f$ is multiplied with
+ * @param [in] ySdot Vectors @f$ \dot{x}_i @f$ the Jacobian @f$ \frac{\partial F}{\partial \dot{y}} @f$ is multiplied with
+ * @param [out] ret Vectors @f$ z_i @f$ which store the result of the operation
+ * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+ */
+void GeneralRateModel::multiplyWithCombinedJacobians(const std::vector<const double*>& yS, const std::vector<const double*>& ySdot, const std::vector<double*>& ret, double timeFactor)
+{
+	Indexer idxr(_disc);
+	const unsigned int nVec = yS.size();
+	const double invBetaP = (1.0 / static_cast<double>(_parPorosity) - 1.0) * timeFactor;
+
+	// Assemble panels of offset pointers into the vectors, one slice per banded block
+	std::vector<double const*> xPanel(nVec * (_disc.nComp + _disc.nCol));
+	std::vector<double*> yPanel(nVec * (_disc.nComp + _disc.nCol));
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		for (unsigned int v = 0; v < nVec; ++v)
+		{
+			xPanel[comp * nVec + v] = yS[v] + comp * idxr.strideColComp() + idxr.offsetC();
+			yPanel[comp * nVec + v] = ret[v] + comp * idxr.strideColComp() + idxr.offsetC();
+		}
+	}
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	{
+		for (unsigned int v = 0; v < nVec; ++v)
+		{
+			xPanel[(_disc.nComp + pblk) * nVec + v] = yS[v] + idxr.offsetCp(pblk);
+			yPanel[(_disc.nComp + pblk) * nVec + v] = ret[v] + idxr.offsetCp(pblk);
+		}
+	}
+
+	// Handle identity matrix of inlet DOFs (time derivative part is algebraic, i.e., zero)
+	for (unsigned int v = 0; v < nVec; ++v)
+	{
+		for (unsigned int i = 0; i < _disc.nComp; ++i)
+			ret[v][i] = yS[v][i];
+	}
+
+	// Threads that are done with multiplying with the bulk column blocks can proceed
+	// to the particle blocks
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nComp + _disc.nCol), [&](size_t idx)
+#else
+	for (unsigned int idx = 0; idx < _disc.nComp + _disc.nCol; ++idx)
+#endif
+	{
+		if (idx < _disc.nComp)
+		{
+			// Time derivative of the bulk equations is the (scaled) identity
+			for (unsigned int v = 0; v < nVec; ++v)
+			{
+				double const* const localSdot = ySdot[v] + idx * idxr.strideColComp() + idxr.offsetC();
+				double* const localRet = yPanel[idx * nVec + v];
+				for (unsigned int i = 0; i < _disc.nCol; ++i)
+					localRet[i] = timeFactor * localSdot[i];
+			}
+
+			_jacC[idx].multiplyVectors(xPanel.data() + idx * nVec, nVec, 1.0, 1.0, yPanel.data() + idx * nVec);
+		}
+		else
+		{
+			const unsigned int pblk = idx - _disc.nComp;
+
+			for (unsigned int v = 0; v < nVec; ++v)
+			{
+				for (unsigned int shell = 0; shell < _disc.nPar; ++shell)
+				{
+					double const* const localSdot = ySdot[v] + idxr.offsetCp(pblk) + shell * idxr.strideParShell();
+					double* const localRet = ret[v] + idxr.offsetCp(pblk) + shell * idxr.strideParShell();
+
+					// Mobile phase
+					for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+					{
+						// Derivative with respect to dc_p / dt
+						localRet[comp] = timeFactor * localSdot[comp];
+
+						// Derivative with respect to dq / dt (normal equations)
+						for (unsigned int i = 0; i < _disc.nBound[comp]; ++i)
+							localRet[comp] += invBetaP * localSdot[_disc.nComp + _disc.boundOffset[comp] + i];
+					}
+
+					// Solid phase
+					_binding->multiplyWithDerivativeJacobian(localSdot + _disc.nComp, localRet + _disc.nComp, timeFactor);
+				}
+			}
+
+			_jacP[pblk].multiplyVectors(xPanel.data() + idx * nVec, nVec, 1.0, 1.0, yPanel.data() + idx * nVec);
+			for (unsigned int v = 0; v < nVec; ++v)
+				_jacPF[pblk].multiplyVector(yS[v] + idxr.offsetJf(), 1.0, 1.0, ret[v] + idxr.offsetCp(pblk));
+		}
+	} CADET_PARFOR_END;
+
+	for (unsigned int v = 0; v < nVec; ++v)
+	{
+		// Multiply with the flux block in the column equation
+		_jacCF.multiplyVector(yS[v] + idxr.offsetJf(), 1.0, 1.0, ret[v] + idxr.offsetC());
+
+		// Handle flux equation: identity matrix in the bottom right corner of the Jacobian
+		// (the fluxes are algebraic, so there is no time derivative contribution)
+		for (unsigned int i = idxr.offsetJf(); i < numDofs(); ++i)
+			ret[v][i] = yS[v][i];
+
+		double* const retJf = ret[v] + idxr.offsetJf();
+		_jacFC.multiplyVector(yS[v] + idxr.offsetC(), 1.0, 1.0, retJf);
+
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+			_jacFP[pblk].multiplyVector(yS[v] + idxr.offsetCp(pblk), 1.0, 1.0, retJf);
+
+		// Map inlet DOFs to the column inlet (first bulk cells)
+		_jacInlet.multiplyAdd(yS[v], ret[v] + idxr.offsetC(), 1.0);
+	}
+}
+
 /**
  * @brief Multiplies the time derivative Jacobian @f$ \frac{\partial F}{\partial \dot{y}} @f$ with a given vector
  * @details The operation @f$ z = \frac{\partial F}{\partial \dot{y}} x @f$ is performed.
@@ -1710,7 +3138,177 @@ unsigned int GeneralRateModel::localInletComponentStride() const CADET_NOEXCEPT
 
 void GeneralRateModel::expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut)
 {
-	// @todo Write this function
+	Indexer idxr(_disc);
+
+	// The specification is interpreted as one tolerance per component (cycled if it is
+	// shorter); bound states inherit the tolerance of their component
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		const double tol = errorSpec[comp % errorSpecSize];
+
+		// Inlet DOFs
+		expandOut[comp] = tol;
+
+		// Bulk and flux DOFs (component-major layout)
+		for (unsigned int col = 0; col < _disc.nCol; ++col)
+		{
+			expandOut[idxr.offsetC() + comp * idxr.strideColComp() + col] = tol;
+			expandOut[idxr.offsetJf() + comp * idxr.strideColComp() + col] = tol;
+		}
+	}
+
+	// Particle DOFs (shell-major layout with mobile phase first, then bound states)
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	{
+		for (unsigned int shell = 0; shell < _disc.nPar; ++shell)
+		{
+			double* const shellTol = expandOut + idxr.offsetCp(pblk, shell);
+			for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+			{
+				const double tol = errorSpec[comp % errorSpecSize];
+				shellTol[comp] = tol;
+				for (unsigned int bnd = 0; bnd < _disc.nBound[comp]; ++bnd)
+					shellTol[idxr.strideParLiquid() + idxr.offsetBoundComp(comp) + bnd] = tol;
+			}
+		}
+	}
+}
+
+void GeneralRateModel::relaxTransitionErrorTol(double const* baseTol, double relaxFactor, double* relaxedTol)
+{
+	Indexer idxr(_disc);
+
+	// Relax all DOFs by default
+	for (unsigned int i = 0; i < numDofs(); ++i)
+		relaxedTol[i] = baseTol[i] * relaxFactor;
+
+	// Keep the base tolerances where the disturbance enters the column: the inlet DOFs
+	// and the cells covered by the WENO stencil at the inlet boundary, including their
+	// particle blocks and film fluxes. For backwards flow the disturbance enters at the
+	// last cell instead.
+	const unsigned int nFrontCells = std::min(static_cast<unsigned int>(std::max(_weno.order(), 2)), _disc.nCol);
+	const bool backwards = static_cast<double>(_curVelocity) < 0.0;
+
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+		relaxedTol[comp] = baseTol[comp];
+
+	for (unsigned int i = 0; i < nFrontCells; ++i)
+	{
+		const unsigned int col = backwards ? (_disc.nCol - 1 - i) : i;
+
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+		{
+			const unsigned int bulkIdx = idxr.offsetC() + comp * idxr.strideColComp() + col;
+			relaxedTol[bulkIdx] = baseTol[bulkIdx];
+
+			const unsigned int fluxIdx = idxr.offsetJf() + comp * idxr.strideColComp() + col;
+			relaxedTol[fluxIdx] = baseTol[fluxIdx];
+		}
+
+		const unsigned int parStart = idxr.offsetCp(col);
+		for (int j = 0; j < idxr.strideParBlock(); ++j)
+			relaxedTol[parStart + j] = baseTol[parStart + j];
+	}
+}
+
+bool GeneralRateModel::hasMultirateErrorTol() const CADET_NOEXCEPT
+{
+	return _multirateErrTolFactor > 1.0;
+}
+
+void GeneralRateModel::applyMultirateErrorTol(double* absTol)
+{
+	if (_multirateErrTolFactor <= 1.0)
+		return;
+
+	Indexer idxr(_disc);
+
+	// Relax the error test on the particle shells and film fluxes so that the step
+	// size controller follows the bulk transport time scale. The particle dynamics
+	// are still solved implicitly within each step (and thus remain stable); only
+	// their weight in the local error test is reduced. The bulk concentrations keep
+	// their full tolerances, so chromatogram accuracy is governed by the bulk error.
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	{
+		double* const parTol = absTol + idxr.offsetCp(pblk);
+		for (int j = 0; j < idxr.strideParBlock(); ++j)
+			parTol[j] *= _multirateErrTolFactor;
+	}
+
+	double* const fluxTol = absTol + idxr.offsetJf();
+	for (unsigned int i = 0; i < _disc.nCol * _disc.nComp; ++i)
+		fluxTol[i] *= _multirateErrTolFactor;
+}
+
+void GeneralRateModel::applyStateClassErrorTol(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor, double* absTol)
+{
+	Indexer idxr(_disc);
+
+	// Inlet DOFs belong to the column liquid class
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+		absTol[comp] *= colLiquidFactor;
+
+	// Bulk and flux DOFs (both component-major with nCol * nComp entries)
+	for (unsigned int i = 0; i < _disc.nCol * _disc.nComp; ++i)
+	{
+		absTol[idxr.offsetC() + i] *= colLiquidFactor;
+		absTol[idxr.offsetJf() + i] *= fluxFactor;
+	}
+
+	// Particle DOFs (shell-major layout with mobile phase first, then bound states)
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	{
+		for (unsigned int shell = 0; shell < _disc.nPar; ++shell)
+		{
+			double* const shellTol = absTol + idxr.offsetCp(pblk, shell);
+			for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+				shellTol[comp] *= parLiquidFactor;
+			for (unsigned int bnd = 0; bnd < _disc.strideBound; ++bnd)
+				shellTol[idxr.strideParLiquid() + bnd] *= boundFactor;
+		}
+	}
+}
+
+/**
+ * @brief Interns a particle discretization in a process-wide cache
+ * @details Looks the computed tables up in a cache of all live discretizations and returns
+ *          the existing refcounted copy if one with identical contents is found; otherwise
+ *          the given tables are moved into the cache. This deduplicates the read-only
+ *          discretization data across identically configured model instances (ensembles):
+ *          each model only holds a shared_ptr and the tables are freed automatically once
+ *          the last model using them is destroyed.
+ * @param [in] parDisc Computed discretization tables (moved from on cache miss)
+ * @return Shared pointer to the interned tables
+ */
+std::shared_ptr<const GeneralRateModel::ParticleDiscretization> GeneralRateModel::internParticleDisc(ParticleDiscretization&& parDisc)
+{
+	// Process-wide cache of all live interned discretizations
+	static std::mutex particleDiscCacheMutex;
+	static std::vector<std::weak_ptr<const ParticleDiscretization>> particleDiscCache;
+
+	std::lock_guard<std::mutex> lock(particleDiscCacheMutex);
+
+	// Drop expired entries and look for a live discretization with identical contents
+	for (unsigned int i = 0; i < particleDiscCache.size();)
+	{
+		std::shared_ptr<const ParticleDiscretization> cand = particleDiscCache[i].lock();
+		if (!cand)
+		{
+			particleDiscCache.erase(particleDiscCache.begin() + i);
+			continue;
+		}
+
+		if ((cand->cellSize == parDisc.cellSize) && (cand->centerRadius == parDisc.centerRadius)
+			&& (cand->outerSurfAreaPerVolume == parDisc.outerSurfAreaPerVolume)
+			&& (cand->innerSurfAreaPerVolume == parDisc.innerSurfAreaPerVolume))
+			return cand;
+
+		++i;
+	}
+
+	std::shared_ptr<const ParticleDiscretization> interned = std::make_shared<const ParticleDiscretization>(std::move(parDisc));
+	particleDiscCache.push_back(interned);
+	return interned;
 }
 
 /**
@@ -1721,20 +3319,20 @@ void GeneralRateModel::expandErrorTol(double const* errorSpec, unsigned int erro
  *          @f$ r_{\text{out}} = \left(1 - \Delta r i \right) @f$ and inner radius
  *          @f$ r_{\text{in}} = \left(1 - \Delta r (i+1) \right). @f$
  */
-void GeneralRateModel::setEquidistantRadialDisc()
+void GeneralRateModel::setEquidistantRadialDisc(ParticleDiscretization& parDisc) const
 {
 	const double dr = 1.0 / static_cast<double>(_disc.nPar);
-	_parCellSize.assign(_disc.nPar, dr);
+	parDisc.cellSize.assign(_disc.nPar, dr);
 
 	for (unsigned int cell = 0; cell < _disc.nPar; cell++)
 	{
-		_parCenterRadius[cell] = 1.0 - (0.5 + static_cast<double>(cell)) * dr;
+		parDisc.centerRadius[cell] = 1.0 - (0.5 + static_cast<double>(cell)) * dr;
 
 		// Compute denominator -> corresponding to cell volume
 		const double vol = std::pow(1.0 - static_cast<double>(cell) * dr, 3.0) - std::pow(1.0 - static_cast<double>(cell + 1) * dr, 3.0);
 
-		_parOuterSurfAreaPerVolume[cell] = 3.0 * sqr(1.0 - static_cast<double>(cell) * dr) / vol;
-		_parInnerSurfAreaPerVolume[cell] = 3.0 * sqr(1.0 - static_cast<double>(cell + 1) * dr) / vol;
+		parDisc.outerSurfAreaPerVolume[cell] = 3.0 * sqr(1.0 - static_cast<double>(cell) * dr) / vol;
+		parDisc.innerSurfAreaPerVolume[cell] = 3.0 * sqr(1.0 - static_cast<double>(cell + 1) * dr) / vol;
 	}
 }
 
@@ -1747,7 +3345,7 @@ void GeneralRateModel::setEquidistantRadialDisc()
  *          Solving for @f$ r_{\text{in}} @f$, we get
  *          @f[ r_{\text{in}} = \left( r_{\text{out}}^3 - \frac{1}{n} \right)^{\frac{1}{3}}. @f]
  */
-void GeneralRateModel::setEquivolumeRadialDisc()
+void GeneralRateModel::setEquivolumeRadialDisc(ParticleDiscretization& parDisc) const
 {
 	double r_out = 1.0;
 	double r_in = 0.0;
@@ -1757,12 +3355,12 @@ void GeneralRateModel::setEquivolumeRadialDisc()
 		if (cell != (_disc.nPar - 1))
 			r_in = std::pow(std::pow(r_out, 3.0) - 1.0 / static_cast<double>(_disc.nPar), (1.0 / 3.0));
 
-		_parCellSize[cell] = r_out - r_in;
-		_parCenterRadius[cell] = r_out - 0.5 * _parCellSize[cell];
+		parDisc.cellSize[cell] = r_out - r_in;
+		parDisc.centerRadius[cell] = r_out - 0.5 * parDisc.cellSize[cell];
 
 		const double invVol = static_cast<double>(_disc.nPar);
-		_parOuterSurfAreaPerVolume[cell] = 3.0 * sqr(r_out) * invVol;
-		_parInnerSurfAreaPerVolume[cell] = 3.0 * sqr(r_in) * invVol;
+		parDisc.outerSurfAreaPerVolume[cell] = 3.0 * sqr(r_out) * invVol;
+		parDisc.innerSurfAreaPerVolume[cell] = 3.0 * sqr(r_in) * invVol;
 
 		// For the next cell: r_out == r_in of the current cell
 		r_out = r_in;
@@ -1774,10 +3372,10 @@ void GeneralRateModel::setEquivolumeRadialDisc()
  * @details Calculates surface areas per volume for every shell and the radial shell centers.
  * @param cellInterfaces Vector with normalized radial cell boundaries (starting with @c 0.0 and ending with @c 1.0)
  */
-void GeneralRateModel::setUserdefinedRadialDisc(const std::vector<double>& cellInterfaces)
+void GeneralRateModel::setUserdefinedRadialDisc(const std::vector<double>& cellInterfaces, ParticleDiscretization& parDisc)
 {
 	// Care for the right ordering and include 0.0 / 1.0 if not already in the vector.
-	std::vector<double> orderedInterfaces = cellInterfaces;
+	ScratchVector<double> orderedInterfaces(cellInterfaces.begin(), cellInterfaces.end(), ScratchAllocator<double>(_configScratch));
 
 	if (std::find(orderedInterfaces.begin(), orderedInterfaces.end(), 0.0) == orderedInterfaces.end())
 		orderedInterfaces.push_back(0.0);
@@ -1789,14 +3387,14 @@ void GeneralRateModel::setUserdefinedRadialDisc(const std::vector<double>& cellI
 
 	for (unsigned int cell = 0; cell < _disc.nPar; ++cell)
 	{
-		_parCellSize[cell] = orderedInterfaces[cell] - orderedInterfaces[cell + 1];
-		_parCenterRadius[cell] = orderedInterfaces[cell] - 0.5 * _parCellSize[cell];
+		parDisc.cellSize[cell] = orderedInterfaces[cell] - orderedInterfaces[cell + 1];
+		parDisc.centerRadius[cell] = orderedInterfaces[cell] - 0.5 * parDisc.cellSize[cell];
 
 		// Compute denominator -> corresponding to cell volume
 		const double vol = std::pow(orderedInterfaces[cell], 3.0) - std::pow(orderedInterfaces[cell + 1], 3.0);
 
-		_parOuterSurfAreaPerVolume[cell] = 3.0 * sqr(orderedInterfaces[cell]) / vol;
-		_parInnerSurfAreaPerVolume[cell] = 3.0 * sqr(orderedInterfaces[cell + 1]) / vol;
+		parDisc.outerSurfAreaPerVolume[cell] = 3.0 * sqr(orderedInterfaces[cell]) / vol;
+		parDisc.innerSurfAreaPerVolume[cell] = 3.0 * sqr(orderedInterfaces[cell + 1]) / vol;
 	}
 }
 
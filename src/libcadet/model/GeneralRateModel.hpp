@@ -23,13 +23,20 @@
 #include "cadet/SolutionExporter.hpp"
 #include "AutoDiff.hpp"
 #include "linalg/SparseMatrix.hpp"
+#include "linalg/DenseMatrix.hpp"
 #include "linalg/Gmres.hpp"
 #include "MemoryPool.hpp"
+#include "ParallelSupport.hpp"
 #include "ParamIdUtil.hpp"
+#include "ParamHashTable.hpp"
 #include "Weno.hpp"
 #include "model/ModelUtils.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <future>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -89,11 +96,14 @@ public:
 	virtual bool canAccumulate() const CADET_NOEXCEPT { return false; }
 
 	static const char* identifier() { return "GENERAL_RATE_MODEL"; }
+	static uint64_t structureHash(IParameterProvider& paramProvider);
 	virtual const char* unitOperationName() const CADET_NOEXCEPT { return "GENERAL_RATE_MODEL"; }
 
 	virtual bool configure(IParameterProvider& paramProvider, IConfigHelper& helper);
 	virtual bool reconfigure(IParameterProvider& paramProvider);
 	virtual void notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset);
+	virtual bool discontinuousOutputTransition(double t, unsigned int secIdx) { return false; }
+	virtual bool exactDiscontinuousOutputTransition(double t, unsigned int secIdx) { return true; }
 
 	virtual std::unordered_map<ParameterId, double> getAllParameterValues() const;
 	virtual bool hasParameter(const ParameterId& pId) const;
@@ -109,6 +119,9 @@ public:
 
 	virtual void useAnalyticJacobian(const bool analyticJac);
 
+	virtual std::size_t memoryFootprint() const CADET_NOEXCEPT;
+	virtual CostEstimate costEstimate(unsigned int numSensParams) const CADET_NOEXCEPT;
+
 	virtual void reportSolution(ISolutionRecorder& recorder, double const* const solution) const;
 	virtual void reportSolutionStructure(ISolutionRecorder& recorder) const;
 
@@ -122,16 +135,21 @@ public:
 	virtual int residualSensFwdWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot, active* const adRes, active* const adY, unsigned int adDirOffset);
 
 	virtual int residualSensFwdCombine(const active& timeFactor, const std::vector<const double*>& yS, const std::vector<const double*>& ySdot,
-		const std::vector<double*>& resS, active const* adRes, double* const tmp1, double* const tmp2, double* const tmp3);
+		const std::vector<double*>& resS, active const* adRes, unsigned int const* dirMap, double* const tmp1, double* const tmp2, double* const tmp3);
 
 	virtual int linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
 		double const* const y, double const* const yDot, double const* const res);
 
+	virtual unsigned int numGmresIterations() const CADET_NOEXCEPT { return _gmres.totalNumIterations(); }
+
 	virtual void prepareADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const;
+	virtual uint64_t adSeedStructureHash() const CADET_NOEXCEPT;
 
 	virtual void applyInitialCondition(double* const vecStateY, double* const vecStateYdot) { }
 	virtual void applyInitialCondition(IParameterProvider& paramProvider, double* const vecStateY, double* const vecStateYdot);
 
+	void applyInitialConditionFromState(const ISolutionExporter& oldState, double* const vecStateY);
+
 	virtual void consistentInitialState(double t, unsigned int secIdx, double timeFactor, double* const vecStateY, active* const adRes, active* const adY, unsigned int adDirOffset, double errorTol);
 	virtual void consistentInitialTimeDerivative(double t, unsigned int secIdx, double timeFactor, double const* vecStateY, double* const vecStateYdot);
 
@@ -146,6 +164,7 @@ public:
 
 	virtual bool hasInlet() const CADET_NOEXCEPT { return true; }
 	virtual bool hasOutlet() const CADET_NOEXCEPT { return true; }
+	virtual bool isPureBoundaryUnit() const CADET_NOEXCEPT { return false; }
 
 	virtual unsigned int localOutletComponentIndex() const CADET_NOEXCEPT;
 	virtual unsigned int localOutletComponentStride() const CADET_NOEXCEPT;
@@ -156,18 +175,29 @@ public:
 	virtual void setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections) { }
 
 	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut);
+	virtual void relaxTransitionErrorTol(double const* baseTol, double relaxFactor, double* relaxedTol);
+	virtual bool hasMultirateErrorTol() const CADET_NOEXCEPT;
+	virtual void applyMultirateErrorTol(double* absTol);
+	virtual void applyStateClassErrorTol(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor, double* absTol);
 
 	virtual void multiplyWithJacobian(double const* yS, double alpha, double beta, double* ret);
+	virtual void multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret);
 	virtual void multiplyWithDerivativeJacobian(double const* sDot, double* ret, double timeFactor);
 	inline void multiplyWithJacobian(double const* yS, double* ret)
 	{
 		multiplyWithJacobian(yS, 1.0, 0.0, ret);
 	}
+	inline void multiplyWithJacobianTranspose(double const* yS, double* ret)
+	{
+		multiplyWithJacobianTranspose(yS, 1.0, 0.0, ret);
+	}
+	void multiplyWithJacobian(const std::vector<const double*>& yS, const std::vector<double*>& ret);
+	void multiplyWithCombinedJacobians(const std::vector<const double*>& yS, const std::vector<const double*>& ySdot, const std::vector<double*>& ret, double timeFactor);
 
 #ifdef CADET_BENCHMARK_MODE
 	virtual std::vector<double> benchmarkTimings() const
 	{
-		return std::vector<double>({
+		std::vector<double> timings({
 			_timerResidual.totalElapsedTime(),
 			_timerResidualPar.totalElapsedTime(),
 			_timerResidualSens.totalElapsedTime(),
@@ -181,6 +211,17 @@ public:
 			_timerMatVec.totalElapsedTime(),
 			_timerGmres.totalElapsedTime()
 		});
+		timings.push_back(_frontCellFraction);
+#ifdef CADET_CHECK_ANALYTIC_JACOBIAN
+		timings.push_back(static_cast<double>(_jacCheckSamples));
+		timings.push_back(_jacCheckMaxDiffCol);
+		timings.push_back(_jacCheckMaxDiffPar);
+#endif
+#ifdef CADET_HARDWARE_COUNTERS
+		_timerResidualParHwc.appendCounts(timings);
+		_timerMatVecHwc.appendCounts(timings);
+#endif
+		return timings;
 	}
 
 	virtual char const* const* benchmarkDescriptions() const
@@ -197,10 +238,26 @@ public:
 			"Factorize",
 			"FactorizePar",
 			"MatVec",
-			"Gmres"
+			"Gmres",
+			"FrontCellFraction"
+#ifdef CADET_CHECK_ANALYTIC_JACOBIAN
+			, "JacCheckSamples",
+			"JacCheckMaxDiffCol",
+			"JacCheckMaxDiffPar"
+#endif
+#ifdef CADET_HARDWARE_COUNTERS
+			, BENCH_HWC_DESC("ResidualPar"),
+			BENCH_HWC_DESC("MatVec")
+#endif
 		};
 		return desc;
 	}
+
+	virtual std::vector<double> benchmarkCellTimings() const
+	{
+		// Entry 0 is the bulk block, entries 1 to nCol are the particle blocks
+		return std::vector<double>(_cellResidualCycles.begin(), _cellResidualCycles.end());
+	}
 #endif
 
 protected:
@@ -221,30 +278,101 @@ protected:
 	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
 	int residualBulkBackwardsFlow(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res);
 
+	template <bool wantJac>
+	int residualBulkForwardsFlowVectorized(double t, unsigned int secIdx, double timeFactor, double const* y, double const* yDot, double* res);
+
 	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
 	int residualParticle(const ParamType& t, unsigned int colCell, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res);
 
+	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac, unsigned int compileTimeNComp>
+	int residualParticleImpl(const ParamType& t, unsigned int colCell, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res);
+
 	template <typename StateType, typename ResidualType, typename ParamType>
 	int residualFlux(const ParamType& t, unsigned int secIdx, StateType const* y, double const* yDot, ResidualType* res);
 
 	void assembleOffdiagJac(double t, unsigned int secIdx);
+	void invalidateDerived(StringHash nameHash) CADET_NOEXCEPT;
 	void extractJacobianFromAD(active const* const adRes, unsigned int adDirOffset);
 	void prepareBulkADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const;
+	void computeParticleADcoloring();
+	void syncParticleADcoloring() const CADET_NOEXCEPT;
 
 	int schurComplementMatrixVector(double const* x, double* z) const;
+	void assembleAndFactorizeDirectSchur();
+	void assembleSchurPreconditioner();
+	int schurPreconditionerSolve(double const* r, double* z) const;
 	void assembleDiscretizedJacobianColumnBlock(unsigned int comp, double alpha, const Indexer& idxr, double timeFactor);
 	void assembleDiscretizedJacobianParticleBlock(unsigned int pblk, double alpha, const Indexer& idxr, double timeFactor);
-	
-	void setEquidistantRadialDisc();
-	void setEquivolumeRadialDisc();
-	void setUserdefinedRadialDisc(const std::vector<double>& cellInterfaces);
+	unsigned int activeParticleRows(unsigned int pblk, double const* weight, double const* yDot, const Indexer& idxr) const;
+	bool solveParticleBlock(unsigned int pblk, double* data) const;
+
+	/**
+	 * @brief Immutable radial particle discretization tables
+	 * @details Fully determined by the particle discretization settings in configure() and
+	 *          read-only afterwards. Instances are interned (see internParticleDisc()), so
+	 *          models configured with identical settings (e.g., the members of an ensemble)
+	 *          share one refcounted copy instead of holding private duplicates.
+	 */
+	struct ParticleDiscretization
+	{
+		std::vector<double> cellSize; //!< Particle cell / shell size
+		std::vector<double> centerRadius; //!< Particle cell-centered position for each particle cell
+		std::vector<double> outerSurfAreaPerVolume; //!< Outer surface area per volume of each shell
+		std::vector<double> innerSurfAreaPerVolume; //!< Inner surface area per volume of each shell
+	};
+
+	void setEquidistantRadialDisc(ParticleDiscretization& parDisc) const;
+	void setEquivolumeRadialDisc(ParticleDiscretization& parDisc) const;
+	void setUserdefinedRadialDisc(const std::vector<double>& cellInterfaces, ParticleDiscretization& parDisc);
+
+	static std::shared_ptr<const ParticleDiscretization> internParticleDisc(ParticleDiscretization&& parDisc);
+
+	/**
+	 * @brief Returns the largest WENO order used in any time section
+	 * @details The bulk Jacobian blocks and the AD seed vectors are allocated for this
+	 *          order such that notifyDiscontinuousSectionTransition() can switch to a
+	 *          smaller order by repartitioning without reallocation.
+	 * @return Largest WENO order of all time sections
+	 */
+	inline unsigned int maxSectionWenoOrder() const CADET_NOEXCEPT
+	{
+		if (_wenoOrderSections.empty())
+			return static_cast<unsigned int>(_weno.order());
+		return static_cast<unsigned int>(std::max(*std::max_element(_wenoOrderSections.begin(), _wenoOrderSections.end()), _weno.order()));
+	}
 
 	void addTimeDerivativeToJacobianColumnBlock(linalg::FactorizableBandMatrix& fbm, const Indexer& idxr, double alpha, double timeFactor);
 	void addMobilePhaseTimeDerivativeToJacobianParticleBlock(linalg::FactorizableBandMatrix::RowIterator& jac, const Indexer& idxr, double alpha, double invBetaP, double timeFactor);
 	void solveForFluxes(double* const vecState, const Indexer& idxr);
+	void solveForFluxesZeroRhs(double* const vecState, const Indexer& idxr);
+	void subtractFluxRows(double const* const x, double* const out, const Indexer& idxr) const;
+
+#ifdef CADET_BENCHMARK_MODE
+	void updateFrontIndicator(double const* const y) const;
+#endif
 
 #ifdef CADET_CHECK_ANALYTIC_JACOBIAN
 	void checkAnalyticJacobianAgainstAd(active const* const adRes, unsigned int adDirOffset) const;
+
+	/**
+	 * @brief Decides whether the current Jacobian update is verified against AD
+	 * @details Draws from a xorshift generator such that on average one out of
+	 *          @c _jacCheckInterval Jacobian updates is selected. Random sampling
+	 *          avoids resonance with periodic patterns of the time integrator
+	 *          (e.g., section transitions always hitting the same phase).
+	 * @return @c true if the current Jacobian update should be compared, otherwise @c false
+	 */
+	inline bool sampleJacobianCheck() const CADET_NOEXCEPT
+	{
+		if (_jacCheckInterval <= 1)
+			return true;
+
+		// Xorshift step (Marsaglia)
+		_jacCheckRngState ^= _jacCheckRngState << 13;
+		_jacCheckRngState ^= _jacCheckRngState >> 17;
+		_jacCheckRngState ^= _jacCheckRngState << 5;
+		return (_jacCheckRngState % _jacCheckInterval) == 0;
+	}
 #endif
 
 	struct Discretization
@@ -270,6 +398,10 @@ protected:
 	linalg::DoubleSparseMatrix* _jacPF; //!< Jacobian blocks connecting particle states and fluxes (particle transport boundary condition)
 	linalg::DoubleSparseMatrix* _jacFP; //!< Jacobian blocks connecting fluxes and particle states (flux equation)
 
+	linalg::CompressedSparseMatrix _jacCFCompressed; //!< Compiled CSR version of @c _jacCF used by the linear solver
+	linalg::CompressedSparseMatrix* _jacPFCompressed; //!< Compiled CSR versions of @c _jacPF used by the linear solver
+	bool _offdiagJacPatternValid; //!< Determines whether the sparsity pattern of the off-diagonal blocks has been built for the current discretization
+
 	linalg::FactorizableBandMatrix* _jacCdisc; //!< Interstitial jacobian diagonal block with time derivatives from BDF method
 	linalg::FactorizableBandMatrix* _jacPdisc; //!< Particle jacobian diagonal blocks (all of them) with time derivatives from BDF method
 
@@ -285,34 +417,114 @@ protected:
 	std::vector<active> _colDispersion; //!< Column dispersion (may be section dependent) \f$ D_{\text{ax}} \f$
 	std::vector<active> _velocity; //!< Interstitial velocity (may be section dependent) \f$ u \f$
 	active _curVelocity; //!< Current interstitial velocity \f$ u \f$ in this time section
+	active _curColDispersion; //!< Current column dispersion \f$ D_{\text{ax}} \f$ in this time section
 
 	// Vectorial parameters
 	std::vector<active> _filmDiffusion; //!< Film diffusion coefficient \f$ k_f \f$
 	std::vector<active> _parDiffusion; //!< Particle diffusion coefficient \f$ D_p \f$
 	std::vector<active> _parSurfDiffusion; //!< Particle surface diffusion coefficient \f$ D_s \f$
 
+	// Slices of the vectorial parameters belonging to the current time section,
+	// cached in notifyDiscontinuousSectionTransition()
+	active const* _curFilmDiffusion; //!< Film diffusion coefficients of the current time section
+	active const* _curParDiffusion; //!< Particle diffusion coefficients of the current time section
+	active const* _curParSurfDiffusion; //!< Particle surface diffusion coefficients of the current time section
+
+	// Packed double mirrors of the current slices read by the double typed residual
+	// functions, which do not need the AD gradient slots of the active storage
+	std::vector<double> _curFilmDiffusionDense; //!< Packed plain values of @c _curFilmDiffusion
+	std::vector<double> _curParDiffusionDense; //!< Packed plain values of @c _curParDiffusion
+	std::vector<double> _curParSurfDiffusionDense; //!< Packed plain values of @c _curParSurfDiffusion
+
+	// Derived double coefficients of the current section, pre-resolved such that the
+	// double typed residual functions run on clean double arithmetic without unwrapping
+	// active parameters or redoing the divisions on every call
+	std::vector<double> _curKfFVDense; //!< Discretized film diffusion coefficients \f$ k_{f,FV} \f$ of the flux equations
+	std::vector<double> _parOuterApVDense; //!< Outer shell surface area per volume divided by particle radius, one entry per shell
+	std::vector<double> _parInnerApVDense; //!< Inner shell surface area per volume divided by particle radius, one entry per shell
+
 	std::unordered_map<ParameterId, active*> _parameters; //!< Provides access to all parameters
+	ParameterHashTable<active*> _paramLookup; //!< Collision-free dispatch table over _parameters used by the hot parameter setters
 	bool _analyticJac; //!< Determines whether AD or analytic Jacobians are used
 
-	ArrayPool _stencilMemory; //!< Provides memory for the stencil
+	/**
+	 * @brief Groups of derived coefficients that are recomputed only when a parameter they depend on has changed
+	 */
+	enum DerivedGroup : unsigned int
+	{
+		DerivedFluxCoeffs = 1u, //!< Off-diagonal Jacobian values (depend on porosities, particle radius, film and particle diffusion)
+		DerivedParamMirrors = 2u, //!< Packed double mirrors of the diffusion parameter tables and derived coefficients (depend also on porosities and particle radius)
+		DerivedAll = 3u //!< All derived coefficient groups
+	};
+
+	unsigned int _dirtyDerived; //!< Bitmask of derived coefficient groups that have to be recomputed on the next section transition
+
+	util::ThreadLocalStorage<ArrayPool> _stencilMemory; //!< Provides each thread with memory for the stencil
+	util::AffinityPartitioner _particleLoopPartitioner; //!< Replays the block-to-worker mapping of the residual particle loop between evaluations
 	double* _wenoDerivatives; //!< Holds derivatives of the WENO scheme
 	Weno _weno; //!< The WENO scheme implementation
+	std::vector<int> _wenoOrderSections; //!< WENO order for each time section (empty if the order is not section dependent)
 	double _wenoEpsilon; //!< The @f$ \varepsilon @f$ of the WENO scheme (prevents division by zero)
+	double* _wenoStripVm; //!< Face values of a full component strip from the batched WENO kernel
+	double* _wenoStripDvm; //!< Face value gradients of a full component strip from the batched WENO kernel
+	int* _wenoStripOrder; //!< WENO orders used in each cell of a component strip
+	double* _bulkFaceFlux; //!< Total flux on each cell face of a component strip assembled by the vectorized bulk residual
 
 	std::unordered_set<active*> _sensParams; //!< Holds all parameters with activated AD directions
-	unsigned int _jacobianAdDirs; //!< Number of AD seed vectors required for Jacobian computation
+	// The coloring state is computed on a background thread during configure() and joined
+	// lazily by syncParticleADcoloring(), hence the mutable qualifiers
+	mutable unsigned int _jacobianAdDirs; //!< Number of AD seed vectors required for Jacobian computation
+	mutable std::vector<unsigned int> _parAdColors; //!< AD direction (color) of each particle block column if the colored seeding is used (empty for band compressed seeding)
+	mutable unsigned int _parAdDirs; //!< Number of AD directions required for one particle block
+	linalg::CompressedSparseMatrix _parAdPattern; //!< Structural non-zero pattern of one particle block the coloring was computed for
+	mutable std::future<void> _parColoringTask; //!< Pending background computation of the particle AD coloring (joined by syncParticleADcoloring())
+
+	std::shared_ptr<const ParticleDiscretization> _parDisc; //!< Radial particle discretization tables, shared between identically configured models
 
-	std::vector<double> _parCellSize; //!< Particle cell / shell size
-	std::vector<double> _parCenterRadius; //!< Particle cell-centered position for each particle cell
-	std::vector<double> _parOuterSurfAreaPerVolume;
-	std::vector<double> _parInnerSurfAreaPerVolume;
+	util::ThreadLocalStorage<ArrayPool> _discParFlux; //!< Per-thread storage for discretized @f$ k_f @f$ value
 
-	ArrayPool _discParFlux; //!< Storage for discretized @f$ k_f @f$ value
+	ScratchArena _configScratch; //!< Arena for transient data built during (re)configuration, rewound on every reconfigure()
+	util::ThreadLocalStorage<linalg::DenseMatrix> _consistentInitJac; //!< Per-thread dense Jacobian workspace for consistent initialization
 
 	bool _factorizeJacobian; //!< Determines whether the Jacobian needs to be factorized
+	bool _jacCdiscRetained; //!< Determines whether @c _jacCdisc holds a retained factorization of the pure time-derivative bulk blocks
+	double _jacCdiscTimeFactor; //!< Time factor the retained bulk block factorization was assembled with
+	bool _jacPdiscRetained; //!< Determines whether @c _jacPdisc holds a retained factorization of the pure time-derivative particle blocks
+	double _jacPdiscTimeFactor; //!< Time factor the retained particle block factorization was assembled with
 	double* _tempState; //!< Temporary storage with the size of the state vector or nCol * nPar * _binding->consistentInitializationWorkspaceSize() whichever is larger
 	linalg::Gmres _gmres; //!< GMRES algorithm for the Schur-complement in linearSolve()
 	double _schurSafety; //!< Safety factor for Schur-complement solution
+	bool _mixedPrecisionParticle; //!< Determines whether particle blocks are factorized in mixed precision
+	bool _mixedPrecisionBulk; //!< Determines whether bulk column blocks are factorized in mixed precision
+	double _multirateErrTolFactor; //!< Factor the error tolerances of particle and flux DOFs are relaxed by (@c 1.0 disables multirate stepping)
+	double _factorizationAlphaTol; //!< Maximum relative drift of @f$ \alpha @f$ before a refactorization is forced (@c 0.0 disables reuse)
+	unsigned int _maxFactorizationAge; //!< Maximum number of setup requests a factorization may be reused for
+	double _lastFactorizationAlpha; //!< Value of @f$ \alpha @f$ baked into the current factorization
+	unsigned int _factorizationAge; //!< Number of setup requests the current factorization has already served
+	unsigned int _gmresIterRef; //!< GMRES iterations of the first Schur-complement solve with the current factorization
+	double _schurForcingMax; //!< Maximum Eisenstat-Walker forcing term for the Schur-complement solve (@c 0.0 disables adaptive inner tolerances)
+	double _schurForcing; //!< Current Eisenstat-Walker forcing term
+	double _schurPrevResNorm; //!< Weighted flux residual norm of the previous linear solve of the current Newton iteration sequence
+	double _schurLastT; //!< Time point of the previous linear solve (identifies the Newton iteration sequence)
+	double _schurLastAlpha; //!< BDF coefficient @f$ \alpha @f$ of the previous linear solve
+	bool _useDirectSchur; //!< Determines whether the Schur-complement is solved directly via a dense factorization instead of GMRES
+	unsigned int _directSchurThreshold; //!< Maximum number of flux DOFs for which the direct Schur-complement solver is selected
+	linalg::DenseMatrix _schurDirect; //!< Dense (factorized) Schur-complement for the direct solver path
+	std::vector<double> _schurColBuffer; //!< Column workspace for assembling the dense Schur-complement
+	bool _schurPrecond; //!< Determines whether the block-Jacobi particle preconditioner is used for the Schur-complement GMRES
+	bool _schurPrecondActive; //!< Determines whether the preconditioner is currently applied (reset after a stalled solve until the next refresh)
+	std::vector<linalg::DenseMatrix> _schurPrecondBlocks; //!< Factorized per-cell particle contribution blocks of the Schur-complement (see assembleSchurPreconditioner())
+	mutable std::vector<double> _schurPrecondBuffer; //!< Gather workspace of schurPreconditionerSolve(), which is invoked serially from the const matrix-vector context of GMRES
+	double _parShellTruncThreshold; //!< Weighted @f$ \dot{y} @f$ magnitude below which converged inner particle shells are frozen out of the Newton system (@c 0.0 disables truncation)
+	std::vector<unsigned int> _parActiveRows; //!< Number of active (leading) rows in each factorized particle block; the sentinel @c uint max denotes a full factorization
+
+#ifdef CADET_CHECK_ANALYTIC_JACOBIAN
+	unsigned int _jacCheckInterval; //!< Average number of Jacobian updates between two sampled comparisons
+	mutable unsigned int _jacCheckRngState; //!< State of the xorshift generator drawing the sampled updates
+	mutable unsigned int _jacCheckSamples; //!< Number of Jacobian comparisons performed so far
+	mutable double _jacCheckMaxDiffCol; //!< Maximum difference between analytic and AD column blocks over all samples
+	mutable double _jacCheckMaxDiffPar; //!< Maximum difference between analytic and AD particle blocks over all samples
+#endif
 
 	BENCH_TIMER(_timerResidual)
 	BENCH_TIMER(_timerResidualPar)
@@ -327,9 +539,30 @@ protected:
 	BENCH_TIMER(_timerMatVec)
 	BENCH_TIMER(_timerGmres)
 
+#ifdef CADET_BENCHMARK_MODE
+	mutable double _frontCellFraction; //!< Smallest observed fraction of axial cell faces occupied by a concentration front
+	mutable std::vector<std::uint64_t> _cellResidualCycles; //!< Accumulated residual evaluation cycles per block (bulk block followed by one entry per particle block)
+#endif
+
 	// Wrapper for calling the corresponding function in GeneralRateModel class
 	friend int schurComplementMultiplierGRM(void* userData, double const* x, double* z);
-
+	friend int schurComplementPreconditionerGRM(void* userData, double const* r, double* z);
+
+	/**
+	 * @brief Provides access to the state vector layout of the GRM
+	 * @details All address arithmetic of the GRM state vector is centralized here. A particle
+	 *          block interleaves liquid and solid phase per shell (a shell holds the nComp
+	 *          mobile phase entries followed by all bound states grouped by component). This
+	 *          interleaving determines the bandwidths of the per-particle Jacobian blocks:
+	 *          coupling between neighboring shells stays within strideParShell() diagonals,
+	 *          which keeps the blocks narrow-banded and factorizable by dgbtrf. A
+	 *          component-major (structure-of-arrays) ordering of a particle block would
+	 *          stream better in the diffusion kernels but spreads the shell coupling over
+	 *          nPar-sized strides, destroying the banded structure the linear solver relies
+	 *          on. Hence, only the interleaved layout is offered; kernels must use the named
+	 *          helpers below instead of hand-rolled offsets so the layout remains confined
+	 *          to this class.
+	 */
 	class Indexer
 	{
 	public:
@@ -356,6 +589,18 @@ protected:
 		inline const int offsetJf() const CADET_NOEXCEPT { return (_disc.nComp + strideParBlock()) * _disc.nCol + offsetC(); }
 		inline const int offsetBoundComp(unsigned int comp) const CADET_NOEXCEPT { return _disc.boundOffset[comp]; }
 
+		/**
+		 * @brief Returns the offset from the liquid phase entry of a component to one of its bound states in the same shell
+		 * @details Index explanation:
+		 *            @c -comp  go back to the beginning of the liquid phase,
+		 *            <tt>+ strideParLiquid()</tt>  skip to the solid phase,
+		 *            <tt>+ offsetBoundComp()</tt>  jump to the component (skips all bound states of previous components),
+		 *            <tt>+ bnd</tt>  go to the requested bound state.
+		 * @param [in] comp Component index the offset is relative to
+		 * @param [in] bnd Bound state index of the component
+		 */
+		inline const int offsetLiquidToBound(unsigned int comp, unsigned int bnd) const CADET_NOEXCEPT { return strideParLiquid() - static_cast<int>(comp) + offsetBoundComp(comp) + static_cast<int>(bnd); }
+
 		// Return pointer to first element of state variable in state vector
 		template <typename real_t> inline real_t* c(real_t* const data) const { return data + offsetC(); }
 		template <typename real_t> inline real_t const* c(real_t const* const data) const { return data + offsetC(); }
@@ -476,6 +721,12 @@ protected:
 			return &_idx.c(_data, _disc.nCol - 1, 0);
 		}
 
+		virtual SolutionSpan concentrationSpan() const { return SolutionSpan{ _idx.c(_data), _disc.nComp * _disc.nCol, 1u }; }
+		virtual SolutionSpan fluxSpan() const { return SolutionSpan{ _idx.jf(_data), _disc.nComp * _disc.nCol, 1u }; }
+		virtual SolutionSpan mobilePhaseSpan() const { return SolutionSpan{ _idx.cp(_data), (_disc.nComp + _disc.strideBound) * _disc.nPar * _disc.nCol, 1u }; }
+		virtual SolutionSpan inletSpan() const { return SolutionSpan{ &_idx.c(_data, 0, 0), _disc.nComp, static_cast<unsigned int>(_idx.strideColComp()) }; }
+		virtual SolutionSpan outletSpan() const { return SolutionSpan{ &_idx.c(_data, _disc.nCol - 1, 0), _disc.nComp, static_cast<unsigned int>(_idx.strideColComp()) }; }
+
 		virtual StateOrdering const* concentrationOrdering(unsigned int& len) const
 		{
 			len = _concentrationOrdering.size();
@@ -512,6 +763,23 @@ protected:
 	};
 };
 
+// The pure double instantiations of the forward flow bulk residual are specialized
+// to use the batched WENO strip kernel (see residualBulkForwardsFlowVectorized())
+template <>
+int GeneralRateModel::residualBulkForwardsFlow<double, double, double, true>(const double& t, unsigned int secIdx, const double& timeFactor, double const* y, double const* yDot, double* res);
+
+template <>
+int GeneralRateModel::residualBulkForwardsFlow<double, double, double, false>(const double& t, unsigned int secIdx, const double& timeFactor, double const* y, double const* yDot, double* res);
+
+// The pure double instantiations of the particle residual dispatch to kernels with
+// compile time component count for common small numbers of components (see
+// residualParticleImpl())
+template <>
+int GeneralRateModel::residualParticle<double, double, double, true>(const double& t, unsigned int colCell, unsigned int secIdx, const double& timeFactor, double const* y, double const* yDot, double* res);
+
+template <>
+int GeneralRateModel::residualParticle<double, double, double, false>(const double& t, unsigned int colCell, unsigned int secIdx, const double& timeFactor, double const* y, double const* yDot, double* res);
+
 } // namespace model
 } // namespace cadet
 
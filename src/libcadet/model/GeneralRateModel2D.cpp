@@ -0,0 +1,1100 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "model/GeneralRateModel2D.hpp"
+#include "cadet/Exceptions.hpp"
+#include "cadet/HashUtil.hpp"
+#include "cadet/SolutionRecorder.hpp"
+
+#include "LoggingUtils.hpp"
+#include "Logging.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ParallelSupport.hpp"
+
+namespace
+{
+	/**
+	 * @brief Fuses the error codes of the radial zones into one indicator
+	 * @details Negative (non-recoverable) codes dominate positive (recoverable) ones.
+	 */
+	inline int foldZoneErrors(const std::vector<int>& errors)
+	{
+		int ret = 0;
+		for (int e : errors)
+		{
+			if ((ret < 0) || (e < 0))
+				ret = std::min(ret, e);
+			else
+				ret = std::max(ret, e);
+		}
+		return ret;
+	}
+}
+
+namespace cadet
+{
+
+namespace model
+{
+
+GeneralRateModel2D::GeneralRateModel2D(UnitOpIdx unitOpIdx) : _unitOpIdx(unitOpIdx), _nComp(0), _nCol(0), _nRad(0),
+	_zoneDofs(0), _radDispersion(0.0), _colRadius(0.0)
+{
+}
+
+GeneralRateModel2D::~GeneralRateModel2D() CADET_NOEXCEPT
+{
+	for (GeneralRateModel* zone : _zones)
+		delete zone;
+}
+
+unsigned int GeneralRateModel2D::numDofs() const CADET_NOEXCEPT
+{
+	// Shared inlet DOFs, all zone blocks, and the mixing cup outlet DOFs
+	return 2 * _nComp + _nRad * _zoneDofs;
+}
+
+unsigned int GeneralRateModel2D::numPureDofs() const CADET_NOEXCEPT
+{
+	return numDofs() - _nComp;
+}
+
+bool GeneralRateModel2D::usesAD() const CADET_NOEXCEPT
+{
+	return !_zones.empty() && _zones[0]->usesAD();
+}
+
+unsigned int GeneralRateModel2D::requiredADdirs() const CADET_NOEXCEPT
+{
+	// The zone blocks are mutually independent in the Jacobian (the radial coupling is
+	// added analytically), hence all zones can share the same AD directions
+	unsigned int dirs = 0;
+	for (GeneralRateModel const* zone : _zones)
+		dirs = std::max(dirs, zone->requiredADdirs());
+	return dirs;
+}
+
+unsigned int GeneralRateModel2D::numGmresIterations() const CADET_NOEXCEPT
+{
+	unsigned int iter = 0;
+	for (GeneralRateModel const* zone : _zones)
+		iter += zone->numGmresIterations();
+	return iter;
+}
+
+uint64_t GeneralRateModel2D::structureHash(IParameterProvider& paramProvider)
+{
+	// All zones share the column configuration, so the zone structure hash covers them all
+	uint64_t h = GeneralRateModel::structureHash(paramProvider);
+
+	paramProvider.pushScope("discretization");
+	hash_combine(h, paramProvider.getInt("NRAD"));
+	paramProvider.popScope();
+
+	return h;
+}
+
+bool GeneralRateModel2D::configure(IParameterProvider& paramProvider, IConfigHelper& helper)
+{
+	_nComp = paramProvider.getInt("NCOMP");
+
+	paramProvider.pushScope("discretization");
+	_nCol = paramProvider.getInt("NCOL");
+	const int nRad = paramProvider.getInt("NRAD");
+	paramProvider.popScope();
+
+	if (nRad < 1)
+		throw InvalidParameterException("NRAD has to be at least 1");
+	_nRad = nRad;
+
+	// Each radial zone is a full general rate model configured from the same group
+	for (GeneralRateModel* zone : _zones)
+		delete zone;
+	_zones.assign(_nRad, nullptr);
+
+	bool success = true;
+	for (unsigned int z = 0; z < _nRad; ++z)
+	{
+		_zones[z] = new GeneralRateModel(_unitOpIdx);
+		success = _zones[z]->configure(paramProvider, helper) && success;
+	}
+	if (!success)
+		return false;
+
+	_zoneDofs = _zones[0]->numDofs();
+	_zoneErrors.resize(_nRad);
+	_linRhs.resize(numDofs());
+	_linPrev.resize(numDofs());
+	_reportBuffer.resize(_nComp * _nCol);
+
+	return readOwnParameters(paramProvider);
+}
+
+bool GeneralRateModel2D::reconfigure(IParameterProvider& paramProvider)
+{
+	bool success = true;
+	for (GeneralRateModel* zone : _zones)
+		success = zone->reconfigure(paramProvider) && success;
+
+	return readOwnParameters(paramProvider) && success;
+}
+
+/**
+ * @brief Reads the parameters owned by the 2D wrapper itself
+ * @details Covers the radial dispersion coefficient and the annular zone geometry.
+ *          Called from both configure() and reconfigure().
+ */
+bool GeneralRateModel2D::readOwnParameters(IParameterProvider& paramProvider)
+{
+	_colRadius = paramProvider.getDouble("COL_RADIUS");
+	if (_colRadius <= 0.0)
+		throw InvalidParameterException("COL_RADIUS has to be positive");
+
+	_radDispersion.setValue(paramProvider.getDouble("COL_DISPERSION_RADIAL"));
+
+	updateRadialGeometry();
+
+	_parameters.clear();
+	_parameters[makeParamId(hashString("COL_DISPERSION_RADIAL"), _unitOpIdx, CompIndep, BoundPhaseIndep, ReactionIndep, SectionIndep)] = &_radDispersion;
+
+	return true;
+}
+
+/**
+ * @brief Recomputes the geometric factors of the zone interfaces
+ * @details The column cross section is divided into @c _nRad annuli of equal area, so the
+ *          interface radii are @f$ r_j = R \sqrt{j / n} @f$ and the area centroids of the
+ *          zones are @f$ \rho_z = R \sqrt{(z + 1/2) / n} @f$. The finite volume coupling
+ *          coefficient of interface @f$ j @f$ is @f$ D_{\text{rad}} @f$ times the stored
+ *          factor @f$ 2 r_j / (A \, (\rho_j - \rho_{j-1})) @f$ with the zone area
+ *          @f$ A = R^2 / n @f$ (the common factor @f$ \pi @f$ cancels).
+ */
+void GeneralRateModel2D::updateRadialGeometry()
+{
+	_radGeomFactor.clear();
+	if (_nRad < 2)
+		return;
+
+	_radGeomFactor.resize(_nRad - 1);
+	const double n = static_cast<double>(_nRad);
+	const double areaPerLength = _colRadius * _colRadius / n;
+	for (unsigned int j = 1; j < _nRad; ++j)
+	{
+		const double r = _colRadius * std::sqrt(j / n);
+		const double dCentroid = _colRadius * (std::sqrt((j + 0.5) / n) - std::sqrt((j - 0.5) / n));
+		_radGeomFactor[j - 1] = 2.0 * r / (areaPerLength * dCentroid);
+	}
+}
+
+void GeneralRateModel2D::setFlowRates(const active& in, const active& out) CADET_NOEXCEPT
+{
+	// Every zone receives the full network flow rate on purpose: with CROSS_SECTION_AREA
+	// set to the full column cross section, the interstitial velocity in each equal-area
+	// zone then evaluates to the correct uniform value F / (A * porosity)
+	for (GeneralRateModel* zone : _zones)
+		zone->setFlowRates(in, out);
+}
+
+std::unordered_map<ParameterId, double> GeneralRateModel2D::getAllParameterValues() const
+{
+	// The zones share their parameter values (they are radially uniform), so the
+	// first zone is representative
+	std::unordered_map<ParameterId, double> data;
+	if (!_zones.empty())
+		data = _zones[0]->getAllParameterValues();
+
+	for (const std::pair<const ParameterId, active*>& p : _parameters)
+		data[p.first] = static_cast<double>(*p.second);
+
+	return data;
+}
+
+bool GeneralRateModel2D::hasParameter(const ParameterId& pId) const
+{
+	if (_parameters.find(pId) != _parameters.end())
+		return true;
+	return !_zones.empty() && _zones[0]->hasParameter(pId);
+}
+
+bool GeneralRateModel2D::setParameter(const ParameterId& pId, int value)
+{
+	bool found = false;
+	for (GeneralRateModel* zone : _zones)
+		found = zone->setParameter(pId, value) || found;
+	return found;
+}
+
+bool GeneralRateModel2D::setParameter(const ParameterId& pId, double value)
+{
+	if ((pId.unitOperation == _unitOpIdx) || (pId.unitOperation == UnitOpIndep))
+	{
+		auto paramHandle = _parameters.find(pId);
+		if (paramHandle != _parameters.end())
+		{
+			paramHandle->second->setValue(value);
+			return true;
+		}
+	}
+
+	// A zone parameter is kept radially uniform by setting it in every zone
+	bool found = false;
+	for (GeneralRateModel* zone : _zones)
+		found = zone->setParameter(pId, value) || found;
+	return found;
+}
+
+bool GeneralRateModel2D::setParameter(const ParameterId& pId, bool value)
+{
+	bool found = false;
+	for (GeneralRateModel* zone : _zones)
+		found = zone->setParameter(pId, value) || found;
+	return found;
+}
+
+bool GeneralRateModel2D::setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue)
+{
+	bool found = false;
+	if ((pId.unitOperation == _unitOpIdx) || (pId.unitOperation == UnitOpIndep))
+	{
+		auto paramHandle = _parameters.find(pId);
+		if (paramHandle != _parameters.end())
+		{
+			LOG(Debug) << "Found parameter " << pId << " in GRM2D: Dir " << adDirection << " is set to " << adValue;
+
+			_sensParams.insert(paramHandle->second);
+			paramHandle->second->setADValue(adDirection, adValue);
+			found = true;
+		}
+	}
+
+	// All zones see the same AD direction; their derivative contributions end up in
+	// disjoint rows of the sensitivity residual
+	for (GeneralRateModel* zone : _zones)
+		found = zone->setSensitiveParameter(pId, adDirection, adValue) || found;
+	return found;
+}
+
+void GeneralRateModel2D::setSensitiveParameterValue(const ParameterId& pId, double value)
+{
+	if ((pId.unitOperation == _unitOpIdx) || (pId.unitOperation == UnitOpIndep))
+	{
+		auto paramHandle = _parameters.find(pId);
+		if ((paramHandle != _parameters.end()) && (_sensParams.find(paramHandle->second) != _sensParams.end()))
+			paramHandle->second->setValue(value);
+	}
+
+	for (GeneralRateModel* zone : _zones)
+		zone->setSensitiveParameterValue(pId, value);
+}
+
+void GeneralRateModel2D::clearSensParams()
+{
+	for (active* sp : _sensParams)
+		sp->setADValue(0.0);
+	_sensParams.clear();
+
+	for (GeneralRateModel* zone : _zones)
+		zone->clearSensParams();
+}
+
+void GeneralRateModel2D::useAnalyticJacobian(const bool analyticJac)
+{
+	for (GeneralRateModel* zone : _zones)
+		zone->useAnalyticJacobian(analyticJac);
+}
+
+void GeneralRateModel2D::setExternalFunctions(IExternalFunction** extFuns, unsigned int size)
+{
+	for (GeneralRateModel* zone : _zones)
+		zone->setExternalFunctions(extFuns, size);
+}
+
+void GeneralRateModel2D::notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset)
+{
+	for (unsigned int z = 0; z < _nRad; ++z)
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zones[z]->notifyDiscontinuousSectionTransition(t, secIdx, adRes ? adRes + offZ : nullptr, adY ? adY + offZ : nullptr, adDirOffset);
+	}
+}
+
+void GeneralRateModel2D::prepareADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const
+{
+	for (unsigned int z = 0; z < _nRad; ++z)
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zones[z]->prepareADvectors(adRes ? adRes + offZ : nullptr, adY ? adY + offZ : nullptr, adDirOffset);
+	}
+}
+
+uint64_t GeneralRateModel2D::adSeedStructureHash() const CADET_NOEXCEPT
+{
+	// The seeding is the concatenation of the zones' seedings at the zone offsets
+	uint64_t h = 0;
+	hash_combine(h, std::string("GENERAL_RATE_MODEL_2D"));
+	hash_combine(h, _nRad);
+	for (GeneralRateModel const* zone : _zones)
+		hash_combine(h, zone->adSeedStructureHash());
+
+	return h;
+}
+
+std::size_t GeneralRateModel2D::memoryFootprint() const CADET_NOEXCEPT
+{
+	std::size_t mem = sizeof(double) * (_linRhs.capacity() + _linPrev.capacity() + _reportBuffer.capacity() + _radGeomFactor.capacity());
+	for (GeneralRateModel const* zone : _zones)
+		mem += zone->memoryFootprint();
+	return mem;
+}
+
+cadet::CostEstimate GeneralRateModel2D::costEstimate(unsigned int numSensParams) const CADET_NOEXCEPT
+{
+	// Sum the per-zone estimates; the own memory footprint already includes the zones
+	CostEstimate ce = { 0.0, 0.0, memoryFootprint() };
+	for (GeneralRateModel const* zone : _zones)
+	{
+		const CostEstimate zc = zone->costEstimate(numSensParams);
+		ce.flopsPerStep += zc.flopsPerStep;
+		ce.bytesPerStep += zc.bytesPerStep;
+	}
+
+	// Radial coupling term and the block tridiagonal outer solve over the zone bulks
+	const double couplingDofs = static_cast<double>(_nRad) * _nComp * _nCol;
+	ce.flopsPerStep += 10.0 * couplingDofs * (1.0 + numSensParams);
+	ce.bytesPerStep += 2.0 * sizeof(double) * couplingDofs * (1.0 + numSensParams);
+	return ce;
+}
+
+void GeneralRateModel2D::reportSolution(ISolutionRecorder& recorder, double const* const solution) const
+{
+	// Record the area averaged bulk concentration; the zone average and the mixing cup
+	// outlet are the quantities a detector sees
+	std::fill(_reportBuffer.begin(), _reportBuffer.end(), 0.0);
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int z = 0; z < _nRad; ++z)
+	{
+		double const* const bulk = solution + offsetZoneBulk(z);
+		for (unsigned int i = 0; i < _nComp * _nCol; ++i)
+			_reportBuffer[i] += w * bulk[i];
+	}
+
+	Exporter expr(_nComp, _nCol, _reportBuffer.data(), solution, solution + offsetMixer());
+	recorder.beginUnitOperation(_unitOpIdx, *this, expr);
+	recorder.endUnitOperation();
+}
+
+void GeneralRateModel2D::reportSolutionStructure(ISolutionRecorder& recorder) const
+{
+	Exporter expr(_nComp, _nCol, nullptr, nullptr, nullptr);
+	recorder.unitOperationStructure(_unitOpIdx, *this, expr);
+}
+
+void GeneralRateModel2D::applyInitialCondition(IParameterProvider& paramProvider, double* const vecStateY, double* const vecStateYdot)
+{
+	std::fill(vecStateY, vecStateY + _nComp, 0.0);
+	std::fill(vecStateYdot, vecStateYdot + _nComp, 0.0);
+
+	for (unsigned int z = 0; z < _nRad; ++z)
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zones[z]->applyInitialCondition(paramProvider, vecStateY + offZ, vecStateYdot + offZ);
+	}
+
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		vecStateY[mix + i] = 0.0;
+		vecStateYdot[mix + i] = 0.0;
+		for (unsigned int z = 0; z < _nRad; ++z)
+		{
+			vecStateY[mix + i] += w * vecStateY[offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+			vecStateYdot[mix + i] += w * vecStateYdot[offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+		}
+	}
+}
+
+/**
+ * @brief Adds the radial dispersion coupling between neighboring zones to the residual
+ * @details The coupling acts on corresponding bulk cells of adjacent zones only; particle
+ *          and flux states are untouched, which keeps the zone Jacobian blocks mutually
+ *          independent. With an active coefficient type the AD derivative with respect to
+ *          the radial dispersion coefficient is propagated as well.
+ */
+template <typename ResidualType, typename ParamType>
+void GeneralRateModel2D::addRadialCoupling(double const* const y, ResidualType* const res) const
+{
+	const unsigned int nBulk = _nComp * _nCol;
+	for (unsigned int iface = 0; iface + 1 < _nRad; ++iface)
+	{
+		const ParamType k = static_cast<ParamType>(_radDispersion) * _radGeomFactor[iface];
+		double const* const cLo = y + offsetZoneBulk(iface);
+		double const* const cHi = y + offsetZoneBulk(iface + 1);
+		ResidualType* const rLo = res + offsetZoneBulk(iface);
+		ResidualType* const rHi = res + offsetZoneBulk(iface + 1);
+
+		for (unsigned int i = 0; i < nBulk; ++i)
+		{
+			const ResidualType d = k * (cHi[i] - cLo[i]);
+			rLo[i] -= d;
+			rHi[i] += d;
+		}
+	}
+}
+
+/**
+ * @brief Adds @f$ \alpha @f$ times the radial coupling Jacobian applied to a vector
+ * @details The radial coupling block is symmetric, so the same operation serves the
+ *          transposed multiplication.
+ */
+void GeneralRateModel2D::addRadialCouplingJacobian(double const* const yS, double alpha, double* const ret) const
+{
+	const unsigned int nBulk = _nComp * _nCol;
+	const double dRad = static_cast<double>(_radDispersion);
+	for (unsigned int iface = 0; iface + 1 < _nRad; ++iface)
+	{
+		const double k = alpha * dRad * _radGeomFactor[iface];
+		double const* const sLo = yS + offsetZoneBulk(iface);
+		double const* const sHi = yS + offsetZoneBulk(iface + 1);
+		double* const rLo = ret + offsetZoneBulk(iface);
+		double* const rHi = ret + offsetZoneBulk(iface + 1);
+
+		for (unsigned int i = 0; i < nBulk; ++i)
+		{
+			const double d = k * (sHi[i] - sLo[i]);
+			rLo[i] -= d;
+			rHi[i] += d;
+		}
+	}
+}
+
+/**
+ * @brief Assembles the algebraic mixing cup rows of the residual
+ * @details The outlet DOFs carry the area weighted average of the zone outlet cells.
+ */
+template <typename ResidualType>
+void GeneralRateModel2D::assembleMixerRows(double const* const y, ResidualType* const res) const
+{
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		double avg = 0.0;
+		for (unsigned int z = 0; z < _nRad; ++z)
+			avg += w * y[offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+		res[mix + i] = y[mix + i] - avg;
+	}
+}
+
+int GeneralRateModel2D::residual(double t, unsigned int secIdx, double timeFactor, double const* const y, double const* const yDot, double* const res)
+{
+	// Shared inlet DOFs: identity (the network coupling subtracts the mixed feed)
+	for (unsigned int i = 0; i < _nComp; ++i)
+		res[i] = y[i];
+
+	// The zone blocks only couple through the bulk cells, evaluate them in parallel
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+	for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zoneErrors[z] = _zones[z]->residual(t, secIdx, timeFactor, y + offZ, yDot ? yDot + offZ : nullptr, res + offZ);
+
+		// All zones are fed by the shared inlet DOFs
+		for (unsigned int i = 0; i < _nComp; ++i)
+			res[offZ + i] -= y[i];
+	} CADET_PARFOR_END;
+
+	addRadialCoupling<double, double>(y, res);
+	assembleMixerRows(y, res);
+
+	return foldZoneErrors(_zoneErrors);
+}
+
+int GeneralRateModel2D::residualWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot,
+	double* const res, active* const adRes, active* const adY, unsigned int adDirOffset)
+{
+	// The zone blocks assemble and factorize their Jacobians; the radial coupling and the
+	// mixing cup rows are applied analytically in multiplyWithJacobian() and linearSolve()
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+	for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zoneErrors[z] = _zones[z]->residualWithJacobian(t, secIdx, timeFactor, y + offZ, yDot ? yDot + offZ : nullptr, res + offZ,
+			adRes ? adRes + offZ : nullptr, adY ? adY + offZ : nullptr, adDirOffset);
+
+		for (unsigned int i = 0; i < _nComp; ++i)
+			res[offZ + i] -= y[i];
+	} CADET_PARFOR_END;
+
+	for (unsigned int i = 0; i < _nComp; ++i)
+		res[i] = y[i];
+
+	addRadialCoupling<double, double>(y, res);
+	assembleMixerRows(y, res);
+
+	return foldZoneErrors(_zoneErrors);
+}
+
+int GeneralRateModel2D::residualSensFwdAdOnly(const active& t, unsigned int secIdx, const active& timeFactor,
+	double const* const y, double const* const yDot, active* const adRes)
+{
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+	for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zoneErrors[z] = _zones[z]->residualSensFwdAdOnly(t, secIdx, timeFactor, y + offZ, yDot ? yDot + offZ : nullptr, adRes + offZ);
+
+		for (unsigned int i = 0; i < _nComp; ++i)
+			adRes[offZ + i] -= y[i];
+	} CADET_PARFOR_END;
+
+	for (unsigned int i = 0; i < _nComp; ++i)
+		adRes[i] = y[i];
+
+	// Propagates the AD seed of the radial dispersion coefficient
+	addRadialCoupling<active, active>(y, adRes);
+	assembleMixerRows(y, adRes);
+
+	return foldZoneErrors(_zoneErrors);
+}
+
+int GeneralRateModel2D::residualSensFwdWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y,
+	double const* const yDot, active* const adRes, active* const adY, unsigned int adDirOffset)
+{
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+	for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zoneErrors[z] = _zones[z]->residualSensFwdWithJacobian(t, secIdx, timeFactor, y + offZ, yDot ? yDot + offZ : nullptr,
+			adRes + offZ, adY ? adY + offZ : nullptr, adDirOffset);
+
+		for (unsigned int i = 0; i < _nComp; ++i)
+			adRes[offZ + i] -= y[i];
+	} CADET_PARFOR_END;
+
+	for (unsigned int i = 0; i < _nComp; ++i)
+		adRes[i] = y[i];
+
+	addRadialCoupling<active, active>(y, adRes);
+	assembleMixerRows(y, adRes);
+
+	return foldZoneErrors(_zoneErrors);
+}
+
+int GeneralRateModel2D::residualSensFwdCombine(const active& timeFactor, const std::vector<const double*>& yS, const std::vector<const double*>& ySdot,
+	const std::vector<double*>& resS, active const* adRes, unsigned int const* dirMap, double* const tmp1, double* const tmp2, double* const tmp3)
+{
+	const unsigned int nSens = yS.size();
+	std::vector<const double*> ySl(nSens);
+	std::vector<const double*> ySdotl(nSens);
+	std::vector<double*> resSl(nSens);
+
+	for (unsigned int z = 0; z < _nRad; ++z)
+	{
+		const unsigned int offZ = offsetZone(z);
+		for (unsigned int p = 0; p < nSens; ++p)
+		{
+			ySl[p] = yS[p] + offZ;
+			ySdotl[p] = ySdot[p] + offZ;
+			resSl[p] = resS[p] + offZ;
+		}
+		_zones[z]->residualSensFwdCombine(timeFactor, ySl, ySdotl, resSl, adRes + offZ, dirMap, tmp1 + offZ, tmp2 + offZ, tmp3 + offZ);
+	}
+
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int p = 0; p < nSens; ++p)
+	{
+		double const* const s = yS[p];
+		double* const r = resS[p];
+		const unsigned int dir = dirMap ? dirMap[p] : p;
+
+		// Shared inlet rows and the coupling of the zone inlets to them
+		for (unsigned int i = 0; i < _nComp; ++i)
+			r[i] = s[i] + adRes[i].getADValue(dir);
+
+		for (unsigned int z = 0; z < _nRad; ++z)
+		{
+			const unsigned int offZ = offsetZone(z);
+			for (unsigned int i = 0; i < _nComp; ++i)
+				r[offZ + i] -= s[i];
+		}
+
+		// (dF / dy) * s of the radial coupling (the dF / dp part is already in adRes)
+		addRadialCouplingJacobian(s, 1.0, r);
+
+		// Mixing cup rows
+		for (unsigned int i = 0; i < _nComp; ++i)
+		{
+			double avg = 0.0;
+			for (unsigned int z = 0; z < _nRad; ++z)
+				avg += w * s[offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+			r[mix + i] = s[mix + i] - avg + adRes[mix + i].getADValue(dir);
+		}
+	}
+
+	return 0;
+}
+
+int GeneralRateModel2D::linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
+	double const* const y, double const* const yDot, double const* const res)
+{
+	// The system matrix is block-tridiagonal in the radial index with the banded zone
+	// blocks on the diagonal and the (weak) radial dispersion coupling off the diagonal.
+	// The zone factorizations are kept intact and the coupling is moved to the right
+	// hand side, lagged by one iterate (block-Jacobi over the zones). The first sweep
+	// equals the uncoupled solve, so a single radial zone needs exactly one sweep.
+	const unsigned int maxIter = 50;
+	const unsigned int nBulk = _nComp * _nCol;
+	const double dRad = static_cast<double>(_radDispersion);
+
+	// The shared inlet rows are the identity; rhs already holds their solution
+	std::copy(rhs, rhs + numDofs(), _linRhs.begin());
+	std::fill(_linPrev.begin(), _linPrev.end(), 0.0);
+
+	int retCode = 0;
+	for (unsigned int iter = 0; iter < maxIter; ++iter)
+	{
+#ifdef CADET_PARALLELIZE
+		tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+		for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+		{
+			const unsigned int offZ = offsetZone(z);
+			double* const rz = rhs + offZ;
+
+			// Restore the original right hand side of the zone and resolve the exactly
+			// known coupling of the zone inlet rows to the shared inlet DOFs
+			std::copy(_linRhs.begin() + offZ, _linRhs.begin() + offZ + _zoneDofs, rz);
+			for (unsigned int i = 0; i < _nComp; ++i)
+				rz[i] += _linRhs[i];
+
+			// Move the radial coupling to the right hand side, lagged by one iterate
+			if (_nRad > 1)
+			{
+				double* const rb = rz + _nComp;
+				double const* const xz = _linPrev.data() + offsetZoneBulk(z);
+				if (z > 0)
+				{
+					const double k = dRad * _radGeomFactor[z - 1];
+					double const* const xLo = _linPrev.data() + offsetZoneBulk(z - 1);
+					for (unsigned int i = 0; i < nBulk; ++i)
+						rb[i] -= k * (xz[i] - xLo[i]);
+				}
+				if (z + 1 < _nRad)
+				{
+					const double k = dRad * _radGeomFactor[z];
+					double const* const xHi = _linPrev.data() + offsetZoneBulk(z + 1);
+					for (unsigned int i = 0; i < nBulk; ++i)
+						rb[i] -= k * (xz[i] - xHi[i]);
+				}
+			}
+
+			_zoneErrors[z] = _zones[z]->linearSolve(t, timeFactor, alpha, tol, rz, weight + offZ, y + offZ, yDot + offZ, res + offZ);
+		} CADET_PARFOR_END;
+
+		retCode = foldZoneErrors(_zoneErrors);
+		if ((retCode < 0) || (_nRad == 1))
+			break;
+
+		// Weighted max norm of the change over all zone blocks
+		double maxDiff = 0.0;
+		for (unsigned int i = _nComp; i < offsetMixer(); ++i)
+			maxDiff = std::max(maxDiff, weight[i] * std::abs(rhs[i] - _linPrev[i]));
+
+		std::copy(rhs + _nComp, rhs + offsetMixer(), _linPrev.begin() + _nComp);
+
+		if (maxDiff <= tol)
+			break;
+
+		if (iter == maxIter - 1)
+		{
+			LOG(Warning) << "Block-Jacobi iteration over radial zones did not converge (residual " << maxDiff << ", tolerance " << tol << ")";
+		}
+	}
+
+	// Mixing cup rows by backward substitution
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		for (unsigned int z = 0; z < _nRad; ++z)
+			rhs[mix + i] += w * rhs[offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+	}
+
+	return retCode;
+}
+
+void GeneralRateModel2D::consistentInitialState(double t, unsigned int secIdx, double timeFactor, double* const vecStateY, active* const adRes, active* const adY, unsigned int adDirOffset, double errorTol)
+{
+	// All zones are fed by the shared inlet DOFs, which ModelSystem has already set
+	for (unsigned int z = 0; z < _nRad; ++z)
+	{
+		const unsigned int offZ = offsetZone(z);
+		for (unsigned int i = 0; i < _nComp; ++i)
+			vecStateY[offZ + i] = vecStateY[i];
+	}
+
+	// The radial coupling only enters the differential bulk equations, so the algebraic
+	// states of the zones can be initialized independently and in parallel
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+	for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zones[z]->consistentInitialState(t, secIdx, timeFactor, vecStateY + offZ, adRes ? adRes + offZ : nullptr, adY ? adY + offZ : nullptr, adDirOffset, errorTol);
+	} CADET_PARFOR_END;
+
+	// Mixing cup rows are algebraic
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		vecStateY[mix + i] = 0.0;
+		for (unsigned int z = 0; z < _nRad; ++z)
+			vecStateY[mix + i] += w * vecStateY[offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+	}
+}
+
+void GeneralRateModel2D::consistentInitialTimeDerivative(double t, unsigned int secIdx, double timeFactor, double const* vecStateY, double* const vecStateYdot)
+{
+	// On entry, vecStateYdot holds the residual evaluated without time derivatives,
+	// including the radial coupling terms; the mass matrix is block diagonal over the
+	// zones, so the zones can solve for their time derivatives independently
+	for (unsigned int i = 0; i < _nComp; ++i)
+		vecStateYdot[i] = -vecStateYdot[i];
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+	for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zones[z]->consistentInitialTimeDerivative(t, secIdx, timeFactor, vecStateY + offZ, vecStateYdot + offZ);
+	} CADET_PARFOR_END;
+
+	// Time derivative of the mixing cup constraint
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		vecStateYdot[mix + i] = 0.0;
+		for (unsigned int z = 0; z < _nRad; ++z)
+			vecStateYdot[mix + i] += w * vecStateYdot[offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+	}
+}
+
+void GeneralRateModel2D::leanConsistentInitialState(double t, unsigned int secIdx, double timeFactor, double* const vecStateY, active* const adRes, active* const adY, unsigned int adDirOffset, double errorTol)
+{
+	for (unsigned int z = 0; z < _nRad; ++z)
+	{
+		const unsigned int offZ = offsetZone(z);
+		for (unsigned int i = 0; i < _nComp; ++i)
+			vecStateY[offZ + i] = vecStateY[i];
+	}
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+	for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zones[z]->leanConsistentInitialState(t, secIdx, timeFactor, vecStateY + offZ, adRes ? adRes + offZ : nullptr, adY ? adY + offZ : nullptr, adDirOffset, errorTol);
+	} CADET_PARFOR_END;
+
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		vecStateY[mix + i] = 0.0;
+		for (unsigned int z = 0; z < _nRad; ++z)
+			vecStateY[mix + i] += w * vecStateY[offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+	}
+}
+
+void GeneralRateModel2D::leanConsistentInitialTimeDerivative(double t, double timeFactor, double* const vecStateYdot, double* const res)
+{
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+	for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zones[z]->leanConsistentInitialTimeDerivative(t, timeFactor, vecStateYdot + offZ, res + offZ);
+	} CADET_PARFOR_END;
+
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		vecStateYdot[mix + i] = 0.0;
+		for (unsigned int z = 0; z < _nRad; ++z)
+			vecStateYdot[mix + i] += w * vecStateYdot[offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+	}
+}
+
+void GeneralRateModel2D::consistentInitialSensitivity(const active& t, unsigned int secIdx, const active& timeFactor, double const* vecStateY, double const* vecStateYdot,
+	std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, active const* const adRes)
+{
+	const unsigned int nSens = vecSensY.size();
+	std::vector<double*> sensYl(nSens);
+	std::vector<double*> sensYdotl(nSens);
+
+	for (unsigned int z = 0; z < _nRad; ++z)
+	{
+		const unsigned int offZ = offsetZone(z);
+		for (unsigned int p = 0; p < nSens; ++p)
+		{
+			// The zone inlet sensitivities track the shared inlet DOFs
+			for (unsigned int i = 0; i < _nComp; ++i)
+			{
+				vecSensY[p][offZ + i] = vecSensY[p][i];
+				vecSensYdot[p][offZ + i] = vecSensYdot[p][i];
+			}
+			sensYl[p] = vecSensY[p] + offZ;
+			sensYdotl[p] = vecSensYdot[p] + offZ;
+		}
+		_zones[z]->consistentInitialSensitivity(t, secIdx, timeFactor, vecStateY + offZ, vecStateYdot + offZ, sensYl, sensYdotl, adRes + offZ);
+	}
+
+	// The zones are unaware of the radial coupling; correct the bulk time derivatives by
+	// its (dF / dy) * s contribution (the mass matrix on the bulk block is timeFactor * I)
+	const double tf = static_cast<double>(timeFactor);
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int p = 0; p < nSens; ++p)
+	{
+		addRadialCouplingJacobian(vecSensY[p], -1.0 / tf, vecSensYdot[p]);
+
+		// Mixing cup rows are algebraic
+		for (unsigned int i = 0; i < _nComp; ++i)
+		{
+			vecSensY[p][mix + i] = 0.0;
+			vecSensYdot[p][mix + i] = 0.0;
+			for (unsigned int z = 0; z < _nRad; ++z)
+			{
+				vecSensY[p][mix + i] += w * vecSensY[p][offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+				vecSensYdot[p][mix + i] += w * vecSensYdot[p][offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+			}
+		}
+	}
+}
+
+void GeneralRateModel2D::leanConsistentInitialSensitivity(const active& t, unsigned int secIdx, const active& timeFactor, double const* vecStateY, double const* vecStateYdot,
+	std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, active const* const adRes)
+{
+	const unsigned int nSens = vecSensY.size();
+	std::vector<double*> sensYl(nSens);
+	std::vector<double*> sensYdotl(nSens);
+
+	for (unsigned int z = 0; z < _nRad; ++z)
+	{
+		const unsigned int offZ = offsetZone(z);
+		for (unsigned int p = 0; p < nSens; ++p)
+		{
+			for (unsigned int i = 0; i < _nComp; ++i)
+			{
+				vecSensY[p][offZ + i] = vecSensY[p][i];
+				vecSensYdot[p][offZ + i] = vecSensYdot[p][i];
+			}
+			sensYl[p] = vecSensY[p] + offZ;
+			sensYdotl[p] = vecSensYdot[p] + offZ;
+		}
+		_zones[z]->leanConsistentInitialSensitivity(t, secIdx, timeFactor, vecStateY + offZ, vecStateYdot + offZ, sensYl, sensYdotl, adRes + offZ);
+	}
+
+	const double tf = static_cast<double>(timeFactor);
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int p = 0; p < nSens; ++p)
+	{
+		addRadialCouplingJacobian(vecSensY[p], -1.0 / tf, vecSensYdot[p]);
+
+		for (unsigned int i = 0; i < _nComp; ++i)
+		{
+			vecSensY[p][mix + i] = 0.0;
+			vecSensYdot[p][mix + i] = 0.0;
+			for (unsigned int z = 0; z < _nRad; ++z)
+			{
+				vecSensY[p][mix + i] += w * vecSensY[p][offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+				vecSensYdot[p][mix + i] += w * vecSensYdot[p][offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+			}
+		}
+	}
+}
+
+void GeneralRateModel2D::multiplyWithJacobian(double const* yS, double alpha, double beta, double* ret)
+{
+	// Handle identity matrix of the shared inlet DOFs
+	for (unsigned int i = 0; i < _nComp; ++i)
+		ret[i] = alpha * yS[i] + beta * ret[i];
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+	for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zones[z]->multiplyWithJacobian(yS + offZ, alpha, beta, ret + offZ);
+
+		// Coupling of the zone inlet rows to the shared inlet DOFs
+		for (unsigned int i = 0; i < _nComp; ++i)
+			ret[offZ + i] -= alpha * yS[i];
+	} CADET_PARFOR_END;
+
+	addRadialCouplingJacobian(yS, alpha, ret);
+
+	// Mixing cup rows
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		double avg = 0.0;
+		for (unsigned int z = 0; z < _nRad; ++z)
+			avg += w * yS[offsetZoneOutlet(z) + i * strideZoneOutlet(z)];
+		ret[mix + i] = alpha * (yS[mix + i] - avg) + beta * ret[mix + i];
+	}
+}
+
+void GeneralRateModel2D::multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret)
+{
+	// Shared inlet columns: identity plus the coupling from all zone inlet rows
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		double coupling = 0.0;
+		for (unsigned int z = 0; z < _nRad; ++z)
+			coupling += yS[offsetZone(z) + i];
+		ret[i] = alpha * (yS[i] - coupling) + beta * ret[i];
+	}
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+	for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zones[z]->multiplyWithJacobianTranspose(yS + offZ, alpha, beta, ret + offZ);
+	} CADET_PARFOR_END;
+
+	// The radial coupling block is symmetric
+	addRadialCouplingJacobian(yS, alpha, ret);
+
+	// Mixing cup: identity on its own columns, coupling into the zone outlet columns
+	const unsigned int mix = offsetMixer();
+	const double w = 1.0 / static_cast<double>(_nRad);
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		ret[mix + i] = alpha * yS[mix + i] + beta * ret[mix + i];
+		for (unsigned int z = 0; z < _nRad; ++z)
+			ret[offsetZoneOutlet(z) + i * strideZoneOutlet(z)] -= alpha * w * yS[mix + i];
+	}
+}
+
+void GeneralRateModel2D::multiplyWithDerivativeJacobian(double const* sDot, double* ret, double timeFactor)
+{
+	// Shared inlet DOFs and mixing cup rows are algebraic
+	std::fill_n(ret, _nComp, 0.0);
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_nRad), [&](size_t z)
+#else
+	for (unsigned int z = 0; z < _nRad; ++z)
+#endif
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zones[z]->multiplyWithDerivativeJacobian(sDot + offZ, ret + offZ, timeFactor);
+	} CADET_PARFOR_END;
+
+	std::fill_n(ret + offsetMixer(), _nComp, 0.0);
+}
+
+void GeneralRateModel2D::expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut)
+{
+	for (unsigned int i = 0; i < _nComp; ++i)
+		expandOut[i] = errorSpec[i % errorSpecSize];
+
+	for (unsigned int z = 0; z < _nRad; ++z)
+		_zones[z]->expandErrorTol(errorSpec, errorSpecSize, expandOut + offsetZone(z));
+
+	const unsigned int mix = offsetMixer();
+	for (unsigned int i = 0; i < _nComp; ++i)
+		expandOut[mix + i] = errorSpec[i % errorSpecSize];
+}
+
+void GeneralRateModel2D::relaxTransitionErrorTol(double const* baseTol, double relaxFactor, double* relaxedTol)
+{
+	for (unsigned int i = 0; i < _nComp; ++i)
+		relaxedTol[i] = baseTol[i] * relaxFactor;
+
+	for (unsigned int z = 0; z < _nRad; ++z)
+	{
+		const unsigned int offZ = offsetZone(z);
+		_zones[z]->relaxTransitionErrorTol(baseTol + offZ, relaxFactor, relaxedTol + offZ);
+	}
+
+	const unsigned int mix = offsetMixer();
+	for (unsigned int i = 0; i < _nComp; ++i)
+		relaxedTol[mix + i] = baseTol[mix + i] * relaxFactor;
+}
+
+bool GeneralRateModel2D::hasMultirateErrorTol() const CADET_NOEXCEPT
+{
+	return !_zones.empty() && _zones[0]->hasMultirateErrorTol();
+}
+
+void GeneralRateModel2D::applyMultirateErrorTol(double* absTol)
+{
+	for (unsigned int z = 0; z < _nRad; ++z)
+		_zones[z]->applyMultirateErrorTol(absTol + offsetZone(z));
+}
+
+void GeneralRateModel2D::applyStateClassErrorTol(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor, double* absTol)
+{
+	// Shared inlet DOFs belong to the column liquid class
+	for (unsigned int i = 0; i < _nComp; ++i)
+		absTol[i] *= colLiquidFactor;
+
+	for (unsigned int z = 0; z < _nRad; ++z)
+		_zones[z]->applyStateClassErrorTol(colLiquidFactor, parLiquidFactor, boundFactor, fluxFactor, absTol + offsetZone(z));
+
+	// The mixer DOFs blend the zone outlets and follow the column liquid class
+	const unsigned int mix = offsetMixer();
+	for (unsigned int i = 0; i < _nComp; ++i)
+		absTol[mix + i] *= colLiquidFactor;
+}
+
+}  // namespace model
+
+}  // namespace cadet
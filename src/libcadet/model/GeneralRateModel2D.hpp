@@ -0,0 +1,281 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Defines the axial-radial (2D) general rate model.
+ */
+
+#ifndef LIBCADET_GENERALRATEMODEL2D_HPP_
+#define LIBCADET_GENERALRATEMODEL2D_HPP_
+
+#include "model/GeneralRateModel.hpp"
+
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cadet
+{
+
+namespace model
+{
+
+/**
+ * @brief Axial-radial (2D) general rate model
+ * @details Resolves radial inhomogeneity of a column (wall effects, flow maldistribution)
+ *          by a finite volume discretization of the radial coordinate into @c NRAD
+ *          equal-area annular zones. Each zone is a full GeneralRateModel sharing the
+ *          column configuration; the zones are coupled by radial dispersion between
+ *          corresponding bulk cells,
+ *          @f[ \frac{\partial c}{\partial t} = \dots + D_{\text{rad}} \frac{1}{\rho}
+ *              \frac{\partial}{\partial \rho} \left( \rho \frac{\partial c}{\partial \rho} \right), @f]
+ *          which yields a block-tridiagonal coupling structure in the radial index.
+ *
+ *          All zone blocks are evaluated and factorized in parallel. The linear solver
+ *          exploits the block-tridiagonal structure by keeping the banded per-zone
+ *          factorizations intact and iterating with the (weak) radial coupling moved to
+ *          the right hand side, i.e., a block-Jacobi iteration over the radial zones.
+ *          All zones share one inlet (perfect radial mixing at the column entrance) and
+ *          the outlet DOFs hold the mixing cup concentration, the area weighted average
+ *          of the zone outlets.
+ */
+class GeneralRateModel2D : public IUnitOperation
+{
+public:
+
+	GeneralRateModel2D(UnitOpIdx unitOpIdx);
+	virtual ~GeneralRateModel2D() CADET_NOEXCEPT;
+
+	virtual unsigned int numDofs() const CADET_NOEXCEPT;
+	virtual unsigned int numPureDofs() const CADET_NOEXCEPT;
+	virtual bool usesAD() const CADET_NOEXCEPT;
+	virtual unsigned int requiredADdirs() const CADET_NOEXCEPT;
+
+	virtual UnitOpIdx unitOperationId() const CADET_NOEXCEPT { return _unitOpIdx; }
+	virtual unsigned int numComponents() const CADET_NOEXCEPT { return _nComp; }
+	virtual void setFlowRates(const active& in, const active& out) CADET_NOEXCEPT;
+	virtual bool canAccumulate() const CADET_NOEXCEPT { return false; }
+
+	static const char* identifier() { return "GENERAL_RATE_MODEL_2D"; }
+	static uint64_t structureHash(IParameterProvider& paramProvider);
+	virtual const char* unitOperationName() const CADET_NOEXCEPT { return "GENERAL_RATE_MODEL_2D"; }
+
+	virtual bool configure(IParameterProvider& paramProvider, IConfigHelper& helper);
+	virtual bool reconfigure(IParameterProvider& paramProvider);
+	virtual void notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset);
+	virtual bool discontinuousOutputTransition(double t, unsigned int secIdx) { return false; }
+	virtual bool exactDiscontinuousOutputTransition(double t, unsigned int secIdx) { return true; }
+
+	virtual std::unordered_map<ParameterId, double> getAllParameterValues() const;
+	virtual bool hasParameter(const ParameterId& pId) const;
+
+	virtual bool setParameter(const ParameterId& pId, int value);
+	virtual bool setParameter(const ParameterId& pId, double value);
+	virtual bool setParameter(const ParameterId& pId, bool value);
+
+	virtual bool setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue);
+	virtual void setSensitiveParameterValue(const ParameterId& id, double value);
+
+	virtual void clearSensParams();
+
+	virtual void useAnalyticJacobian(const bool analyticJac);
+
+	virtual std::size_t memoryFootprint() const CADET_NOEXCEPT;
+	virtual CostEstimate costEstimate(unsigned int numSensParams) const CADET_NOEXCEPT;
+
+	virtual void reportSolution(ISolutionRecorder& recorder, double const* const solution) const;
+	virtual void reportSolutionStructure(ISolutionRecorder& recorder) const;
+
+	virtual int residual(double t, unsigned int secIdx, double timeFactor, double const* const y, double const* const yDot, double* const res);
+	virtual int residualWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot, double* const res, active* const adRes, active* const adY, unsigned int adDirOffset);
+
+	virtual int residualSensFwdAdOnly(const active& t, unsigned int secIdx, const active& timeFactor,
+		double const* const y, double const* const yDot, active* const adRes);
+
+	virtual int residualSensFwdCombine(const active& timeFactor, const std::vector<const double*>& yS, const std::vector<const double*>& ySdot,
+		const std::vector<double*>& resS, active const* adRes, unsigned int const* dirMap, double* const tmp1, double* const tmp2, double* const tmp3);
+
+	virtual int residualSensFwdWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot, active* const adRes, active* const adY, unsigned int adDirOffset);
+
+	virtual int linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
+		double const* const y, double const* const yDot, double const* const res);
+
+	virtual unsigned int numGmresIterations() const CADET_NOEXCEPT;
+
+	virtual void prepareADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const;
+	virtual uint64_t adSeedStructureHash() const CADET_NOEXCEPT;
+
+	virtual void applyInitialCondition(double* const vecStateY, double* const vecStateYdot) { }
+	virtual void applyInitialCondition(IParameterProvider& paramProvider, double* const vecStateY, double* const vecStateYdot);
+
+	virtual void consistentInitialState(double t, unsigned int secIdx, double timeFactor, double* const vecStateY, active* const adRes, active* const adY, unsigned int adDirOffset, double errorTol);
+	virtual void consistentInitialTimeDerivative(double t, unsigned int secIdx, double timeFactor, double const* vecStateY, double* const vecStateYdot);
+
+	virtual void consistentInitialSensitivity(const active& t, unsigned int secIdx, const active& timeFactor, double const* vecStateY, double const* vecStateYdot,
+		std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, active const* const adRes);
+
+	virtual void leanConsistentInitialState(double t, unsigned int secIdx, double timeFactor, double* const vecStateY, active* const adRes, active* const adY, unsigned int adDirOffset, double errorTol);
+	virtual void leanConsistentInitialTimeDerivative(double t, double timeFactor, double* const vecStateYdot, double* const res);
+
+	virtual void leanConsistentInitialSensitivity(const active& t, unsigned int secIdx, const active& timeFactor, double const* vecStateY, double const* vecStateYdot,
+		std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, active const* const adRes);
+
+	virtual bool hasInlet() const CADET_NOEXCEPT { return true; }
+	virtual bool hasOutlet() const CADET_NOEXCEPT { return true; }
+	virtual bool isPureBoundaryUnit() const CADET_NOEXCEPT { return false; }
+
+	virtual unsigned int localOutletComponentIndex() const CADET_NOEXCEPT { return offsetMixer(); }
+	virtual unsigned int localOutletComponentStride() const CADET_NOEXCEPT { return 1; }
+	virtual unsigned int localInletComponentIndex() const CADET_NOEXCEPT { return 0; }
+	virtual unsigned int localInletComponentStride() const CADET_NOEXCEPT { return 1; }
+
+	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size);
+	virtual void setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections) { }
+
+	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut);
+	virtual void relaxTransitionErrorTol(double const* baseTol, double relaxFactor, double* relaxedTol);
+	virtual bool hasMultirateErrorTol() const CADET_NOEXCEPT;
+	virtual void applyMultirateErrorTol(double* absTol);
+	virtual void applyStateClassErrorTol(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor, double* absTol);
+
+	virtual void multiplyWithJacobian(double const* yS, double alpha, double beta, double* ret);
+	virtual void multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret);
+	virtual void multiplyWithDerivativeJacobian(double const* sDot, double* ret, double timeFactor);
+
+#ifdef CADET_BENCHMARK_MODE
+	virtual std::vector<double> benchmarkTimings() const { return std::vector<double>(0); }
+	virtual char const* const* benchmarkDescriptions() const { return nullptr; }
+#endif
+
+protected:
+
+	// Offsets into the state vector: [inlet DOFs | zone 0 | ... | zone NRAD-1 | mixing cup outlet]
+	inline unsigned int offsetZone(unsigned int zone) const CADET_NOEXCEPT { return _nComp + zone * _zoneDofs; }
+	inline unsigned int offsetZoneBulk(unsigned int zone) const CADET_NOEXCEPT { return offsetZone(zone) + _nComp; }
+	inline unsigned int offsetMixer() const CADET_NOEXCEPT { return _nComp + _nRad * _zoneDofs; }
+	inline unsigned int offsetZoneOutlet(unsigned int zone) const CADET_NOEXCEPT { return offsetZone(zone) + _zones[zone]->localOutletComponentIndex(); }
+	inline unsigned int strideZoneOutlet(unsigned int zone) const CADET_NOEXCEPT { return _zones[zone]->localOutletComponentStride(); }
+
+	template <typename ResidualType, typename ParamType>
+	void addRadialCoupling(double const* const y, ResidualType* const res) const;
+
+	void addRadialCouplingJacobian(double const* const yS, double alpha, double* const ret) const;
+
+	template <typename ResidualType>
+	void assembleMixerRows(double const* const y, ResidualType* const res) const;
+
+	bool readOwnParameters(IParameterProvider& paramProvider);
+	void updateRadialGeometry();
+
+	UnitOpIdx _unitOpIdx; //!< Unit operation index
+	unsigned int _nComp; //!< Number of components
+	unsigned int _nCol; //!< Number of axial column cells (same in every zone)
+	unsigned int _nRad; //!< Number of radial zones
+	unsigned int _zoneDofs; //!< Number of DOFs of a single zone block
+
+	std::vector<GeneralRateModel*> _zones; //!< One full GRM per radial zone
+
+	active _radDispersion; //!< Radial dispersion coefficient @f$ D_{\text{rad}} @f$
+	double _colRadius; //!< Column radius, determines the annular zone geometry
+	std::vector<double> _radGeomFactor; //!< Geometric factor of each zone interface (coupling coefficient is @f$ D_{\text{rad}} @f$ times this factor)
+
+	std::unordered_map<ParameterId, active*> _parameters; //!< Map used to translate ParameterIds to actual variables
+	std::unordered_set<active*> _sensParams; //!< Holds parameters that are sensitive
+
+	std::vector<int> _zoneErrors; //!< Per-zone error indicators of the parallel residual loops
+	std::vector<double> _linRhs; //!< Copy of the original right hand side during the block-Jacobi iteration
+	std::vector<double> _linPrev; //!< Previous iterate of the block-Jacobi iteration
+	mutable std::vector<double> _reportBuffer; //!< Area averaged bulk concentrations assembled for the solution recorder
+
+	class Exporter : public ISolutionExporter
+	{
+	public:
+
+		Exporter(unsigned int nComp, unsigned int nCol, double const* avgBulk, double const* inletDofs, double const* mixerDofs)
+			: _nComp(nComp), _nCol(nCol), _avgBulk(avgBulk), _inletDofs(inletDofs), _mixerDofs(mixerDofs) { }
+
+		virtual bool hasMultipleBoundStates() const CADET_NOEXCEPT { return false; }
+		virtual bool hasNonBindingComponents() const CADET_NOEXCEPT { return true; }
+		virtual bool hasParticleFlux() const CADET_NOEXCEPT { return false; }
+		virtual bool hasParticleMobilePhase() const CADET_NOEXCEPT { return false; }
+
+		virtual unsigned int numComponents() const CADET_NOEXCEPT { return _nComp; }
+		virtual unsigned int numAxialCells() const CADET_NOEXCEPT { return _nCol; }
+		virtual unsigned int numRadialCells() const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numBoundStates() const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int const* numBoundStatesPerComponent() const CADET_NOEXCEPT { return nullptr; }
+		virtual unsigned int numBoundStates(unsigned int comp) const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numColumnDofs() const CADET_NOEXCEPT { return _nComp * _nCol; }
+		virtual unsigned int numParticleDofs() const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numFluxDofs() const CADET_NOEXCEPT { return 0; }
+
+		virtual double concentration(unsigned int component, unsigned int axialCell) const { return _avgBulk[component * _nCol + axialCell]; }
+		virtual double flux(unsigned int component, unsigned int axialCell) const { return 0.0; }
+		virtual double mobilePhase(unsigned int component, unsigned int axialCell, unsigned int radialCell) const { return 0.0; }
+		virtual double solidPhase(unsigned int component, unsigned int axialCell, unsigned int radialCell, unsigned int boundState) const { return 0.0; }
+
+		virtual double const* concentration() const { return _avgBulk; }
+		virtual double const* flux() const { return nullptr; }
+		virtual double const* mobilePhase() const { return nullptr; }
+		virtual double const* solidPhase() const { return nullptr; }
+		virtual double const* inlet(unsigned int& stride) const
+		{
+			stride = 1;
+			return _inletDofs;
+		}
+		virtual double const* outlet(unsigned int& stride) const
+		{
+			stride = 1;
+			return _mixerDofs;
+		}
+
+		virtual StateOrdering const* concentrationOrdering(unsigned int& len) const
+		{
+			len = _concentrationOrdering.size();
+			return _concentrationOrdering.data();
+		}
+
+		virtual StateOrdering const* fluxOrdering(unsigned int& len) const
+		{
+			len = 0;
+			return nullptr;
+		}
+
+		virtual StateOrdering const* mobilePhaseOrdering(unsigned int& len) const
+		{
+			len = 0;
+			return nullptr;
+		}
+
+		virtual StateOrdering const* solidPhaseOrdering(unsigned int& len) const
+		{
+			len = 0;
+			return nullptr;
+		}
+
+	protected:
+		unsigned int _nComp;
+		unsigned int _nCol;
+		double const* const _avgBulk;
+		double const* const _inletDofs;
+		double const* const _mixerDofs;
+
+		const std::array<StateOrdering, 2> _concentrationOrdering = { { StateOrdering::Component, StateOrdering::AxialCell } };
+	};
+};
+
+} // namespace model
+} // namespace cadet
+
+#endif  // LIBCADET_GENERALRATEMODEL2D_HPP_
@@ -13,6 +13,7 @@
 #include "model/InletModel.hpp"
 #include "ParamReaderHelper.hpp"
 #include "cadet/Exceptions.hpp"
+#include "cadet/HashUtil.hpp"
 #include "cadet/InletProfile.hpp"
 #include "cadet/SolutionRecorder.hpp"
 
@@ -20,7 +21,9 @@
 #include "ParamIdUtil.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <type_traits>
 
 #include "LoggingUtils.hpp"
 #include "Logging.hpp"
@@ -61,6 +64,16 @@ bool InletModel::usesAD() const CADET_NOEXCEPT
 	return false;
 }
 
+uint64_t InletModel::structureHash(IParameterProvider& paramProvider)
+{
+	// Number of components and profile type determine the allocated structure,
+	// all profile parameters are read again by reconfigure()
+	uint64_t h = 0;
+	hash_combine(h, paramProvider.getInt("NCOMP"));
+	hash_combine(h, paramProvider.getString("INLET_TYPE"));
+	return h;
+}
+
 bool InletModel::configure(IParameterProvider& paramProvider, IConfigHelper& helper)
 {
 	_nComp = paramProvider.getInt("NCOMP");
@@ -205,9 +218,8 @@ template<> active const* InletModel::moveInletValues(double const* const rawValu
 	for (unsigned int i = 0; i < _nComp; ++i)
 		_inletConcentrations[i] = rawValues[i];
 
-	// Get time derivative
-	_inlet->timeDerivative(static_cast<double>(t), secIdx, _inletDerivatives + _nComp);
-	LOG(Debug) << "dInlet / dt = " << cadet::log::VectorPtr<double>(_inletDerivatives + _nComp, _nComp); 
+	// Time derivative has already been computed alongside the concentrations in residualImpl()
+	LOG(Debug) << "dInlet / dt = " << cadet::log::VectorPtr<double>(_inletDerivatives + _nComp, _nComp);
 
 	// Retrieve parameter derivatives
 	for (auto sp : _sensParamsInlet)
@@ -242,6 +254,54 @@ template<> active const* const InletModel::getData() const
 void InletModel::useAnalyticJacobian(const bool analyticJac) { }
 void InletModel::notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset) { }
 
+bool InletModel::discontinuousOutputTransition(double t, unsigned int secIdx)
+{
+	if ((secIdx == 0) || !_inlet)
+		return true;
+
+	// Prefer exact discontinuity metadata if the profile provides it; a zero jump in all
+	// components is an exactly continuous transition, no tolerance required
+	double* const jump = _inletDerivatives;
+	if (_inlet->sectionTransitionJump(secIdx, jump))
+	{
+		for (unsigned int comp = 0; comp < _nComp; ++comp)
+		{
+			if (jump[comp] != 0.0)
+				return true;
+		}
+		return false;
+	}
+
+	// Evaluate the profile on both sides of the boundary; the left limit is obtained by
+	// evaluating the previous section at the boundary time. The derivative scratch space
+	// provides room for two evaluations and is unused between residual calls.
+	double* const left = _inletDerivatives;
+	double* const right = _inletDerivatives + _nComp;
+	_inlet->inletConcentration(t, secIdx - 1, left);
+	_inlet->inletConcentration(t, secIdx, right);
+
+	for (unsigned int comp = 0; comp < _nComp; ++comp)
+	{
+		// Tolerate rounding differences from evaluating the polynomial pieces at their
+		// respective ends of the section
+		const double scale = std::max(1.0, std::max(std::abs(left[comp]), std::abs(right[comp])));
+		if (std::abs(left[comp] - right[comp]) > 1e-10 * scale)
+			return true;
+	}
+
+	return false;
+}
+
+bool InletModel::exactDiscontinuousOutputTransition(double t, unsigned int secIdx)
+{
+	if ((secIdx == 0) || !_inlet)
+		return false;
+
+	// The transition is exact if the profile knows its jump in closed form; the jump itself
+	// is applied during consistent initialization, which evaluates the entered section exactly
+	return _inlet->sectionTransitionJump(secIdx, _inletDerivatives);
+}
+
 void InletModel::reportSolution(ISolutionRecorder& recorder, double const* const solution) const
 {
 	Exporter expr(_nComp, solution);
@@ -274,8 +334,8 @@ void InletModel::consistentInitialState(double t, unsigned int secIdx, double ti
 
 void InletModel::leanConsistentInitialState(double t, unsigned int secIdx, double timeFactor, double* const vecStateY, active* const adRes, active* const adY, unsigned int adDirOffset, double errorTol)
 {
-	consistentInitialState(t, secIdx, timeFactor, vecStateY, adRes, adY, adDirOffset, errorTol);
-	_inlet->timeDerivative(static_cast<double>(t), secIdx, _inletDerivatives);
+	_inlet->inletConcentrationAndDerivative(static_cast<double>(t), secIdx, _inletConcentrationsRaw, _inletDerivatives);
+	std::copy_n(_inletConcentrationsRaw, _nComp, vecStateY);
 }
 
 void InletModel::consistentInitialTimeDerivative(double t, unsigned int secIdx, double timeFactor, double const* vecStateY, double* const vecStateYdot)
@@ -297,8 +357,13 @@ int InletModel::residual(double t, unsigned int secIdx, double timeFactor, doubl
 template <typename ResidualType, typename ParamType>
 int InletModel::residualImpl(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, double const* const y, double const* const yDot, ResidualType* const res)
 {
-	// Evaluate the user-specified function for the inlet concentration
-	_inlet->inletConcentration(static_cast<double>(t), secIdx, _inletConcentrationsRaw);
+	// Evaluate the user-specified function for the inlet concentration; parameter sensitivities
+	// (ResidualType = active) additionally require the time derivative, which is obtained in the
+	// same pass over the profile
+	if (std::is_same<ResidualType, active>::value)
+		_inlet->inletConcentrationAndDerivative(static_cast<double>(t), secIdx, _inletConcentrationsRaw, _inletDerivatives + _nComp);
+	else
+		_inlet->inletConcentration(static_cast<double>(t), secIdx, _inletConcentrationsRaw);
 
 	// Copy inlet concentrations over to active types if necessary
 	moveInletValues<ResidualType>(_inletConcentrationsRaw, t, secIdx);
@@ -325,16 +390,17 @@ int InletModel::residualSensFwdAdOnly(const active& t, unsigned int secIdx, cons
 }
 
 int InletModel::residualSensFwdCombine(const active& timeFactor, const std::vector<const double*>& yS, const std::vector<const double*>& ySdot,
-	const std::vector<double*>& resS, active const* adRes, double* const tmp1, double* const tmp2, double* const tmp3)
+	const std::vector<double*>& resS, active const* adRes, unsigned int const* dirMap, double* const tmp1, double* const tmp2, double* const tmp3)
 {
 	for (unsigned int param = 0; param < yS.size(); param++)
 	{
 		double* const ptrResS = resS[param];
 		double const* const ptrYs = yS[param];
+		const unsigned int dir = dirMap ? dirMap[param] : param;
 
 		// Compute (dF / dy) * s + dF / dp = s + dF / dp
 		for (unsigned int i = 0; i < numDofs(); ++i)
-			ptrResS[i] = ptrYs[i] + adRes[i].getADValue(param);
+			ptrResS[i] = ptrYs[i] + adRes[i].getADValue(dir);
 	}
 	return 0;
 }
@@ -387,6 +453,15 @@ void InletModel::multiplyWithJacobian(double const* yS, double alpha, double bet
 	}
 }
 
+void InletModel::multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret)
+{
+	// The Jacobian is the identity matrix, which is its own transpose
+	for (unsigned int i = 0; i < numDofs(); ++i)
+	{
+		ret[i] = alpha * yS[i] + beta * ret[i];
+	}
+}
+
 void InletModel::multiplyWithDerivativeJacobian(double const* sDot, double* ret, double timeFactor)
 {
 	std::fill_n(ret, numDofs(), 0.0);
@@ -62,12 +62,15 @@ public:
 	virtual bool canAccumulate() const CADET_NOEXCEPT { return true; }
 
 	static const char* identifier() { return "INLET"; }
+	static uint64_t structureHash(IParameterProvider& paramProvider);
 	virtual const char* unitOperationName() const CADET_NOEXCEPT { return "INLET"; }
 
 	virtual bool configure(IParameterProvider& paramProvider, IConfigHelper& helper);
 	virtual bool reconfigure(IParameterProvider& paramProvider);
 	virtual void notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset);
-	
+	virtual bool discontinuousOutputTransition(double t, unsigned int secIdx);
+	virtual bool exactDiscontinuousOutputTransition(double t, unsigned int secIdx);
+
 	virtual std::unordered_map<ParameterId, double> getAllParameterValues() const;
 	virtual bool hasParameter(const ParameterId& pId) const;
 
@@ -82,6 +85,19 @@ public:
 
 	virtual void useAnalyticJacobian(const bool analyticJac);
 
+	virtual std::size_t memoryFootprint() const CADET_NOEXCEPT
+	{
+		// Temporary state, raw inlet concentrations (and derivatives), and AD concentrations
+		return _tempState.capacity() * sizeof(double) + 3 * _nComp * sizeof(double) + _nComp * sizeof(active);
+	}
+
+	virtual CostEstimate costEstimate(unsigned int numSensParams) const CADET_NOEXCEPT
+	{
+		// Piecewise polynomial evaluation per component, negligible against any column model
+		const CostEstimate ce = { 10.0 * _nComp * (1.0 + numSensParams), 2.0 * sizeof(double) * _nComp * (1.0 + numSensParams), memoryFootprint() };
+		return ce;
+	}
+
 	virtual void reportSolution(ISolutionRecorder& recorder, double const* const solution) const;
 	virtual void reportSolutionStructure(ISolutionRecorder& recorder) const;
 
@@ -92,7 +108,7 @@ public:
 		double const* const y, double const* const yDot, active* const adRes);
 
 	virtual int residualSensFwdCombine(const active& timeFactor, const std::vector<const double*>& yS, const std::vector<const double*>& ySdot,
-		const std::vector<double*>& resS, active const* adRes, double* const tmp1, double* const tmp2, double* const tmp3);
+		const std::vector<double*>& resS, active const* adRes, unsigned int const* dirMap, double* const tmp1, double* const tmp2, double* const tmp3);
 
 	virtual int residualSensFwdWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot, active* const adRes, active* const adY, unsigned int adDirOffset);
 
@@ -100,7 +116,10 @@ public:
 	virtual int linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
 		double const* const y, double const* const yDot, double const* const res) { return 0; }
 
+	virtual unsigned int numGmresIterations() const CADET_NOEXCEPT { return 0; }
+
 	virtual void prepareADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const;
+	virtual uint64_t adSeedStructureHash() const CADET_NOEXCEPT { return 0; }
 
 	virtual void applyInitialCondition(double* const vecStateY, double* const vecStateYdot);
 	virtual void applyInitialCondition(IParameterProvider& paramProvider, double* const vecStateY, double* const vecStateYdot);
@@ -120,6 +139,7 @@ public:
 	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { }
 
 	virtual void multiplyWithJacobian(double const* yS, double alpha, double beta, double* ret);
+	virtual void multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret);
 	virtual void multiplyWithDerivativeJacobian(double const* sDot, double* ret, double timeFactor);
 	virtual inline void multiplyWithJacobian(double const* yS, double* ret)
 	{
@@ -128,6 +148,7 @@ public:
 
 	virtual bool hasInlet() const CADET_NOEXCEPT { return false; }
 	virtual bool hasOutlet() const CADET_NOEXCEPT { return true; }
+	virtual bool isPureBoundaryUnit() const CADET_NOEXCEPT { return true; }
 
 	virtual unsigned int localOutletComponentIndex() const CADET_NOEXCEPT { return 0; }
 	virtual unsigned int localOutletComponentStride() const CADET_NOEXCEPT { return 1; }
@@ -136,7 +157,28 @@ public:
 
 	virtual void setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections);
 
-	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut) { }
+	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut)
+	{
+		for (unsigned int i = 0; i < _nComp; ++i)
+			expandOut[i] = errorSpec[i % errorSpecSize];
+	}
+
+	virtual void relaxTransitionErrorTol(double const* baseTol, double relaxFactor, double* relaxedTol)
+	{
+		// Inlet DOFs carry the disturbance itself and keep their base tolerance
+		for (unsigned int i = 0; i < _nComp; ++i)
+			relaxedTol[i] = baseTol[i];
+	}
+
+	virtual bool hasMultirateErrorTol() const CADET_NOEXCEPT { return false; }
+	virtual void applyMultirateErrorTol(double* absTol) { }
+
+	virtual void applyStateClassErrorTol(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor, double* absTol)
+	{
+		// Inlet DOFs belong to the column liquid class
+		for (unsigned int i = 0; i < _nComp; ++i)
+			absTol[i] *= colLiquidFactor;
+	}
 
 #ifdef CADET_BENCHMARK_MODE
 	virtual std::vector<double> benchmarkTimings() const { return std::vector<double>(0); }
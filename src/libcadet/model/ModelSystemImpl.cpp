@@ -14,6 +14,7 @@
 #include "cadet/ParameterProvider.hpp"
 #include "cadet/Exceptions.hpp"
 #include "cadet/ExternalFunction.hpp"
+#include "model/extfun/CachedExternalFunction.hpp"
 
 #include "ConfigurationHelper.hpp"
 #include "linalg/SparseMatrix.hpp"
@@ -31,6 +32,10 @@
 #include "LoggingUtils.hpp"
 #include "Logging.hpp"
 
+#ifdef CADET_SELF_PROFILER
+	#include "SelfProfiler.hpp"
+#endif
+
 #include "ParallelSupport.hpp"
 #ifdef CADET_PARALLELIZE
 	#include <tbb/tbb.h>
@@ -98,6 +103,32 @@ namespace
 		return b;
 	}
 
+	/**
+	 * @brief Selects either double or active factor vector based on template argument
+	 * @details Helper function that returns either @p a or @p b depending on the template argument.
+	 * @param [in] a Vector of double factors
+	 * @param [in] b Vector of active factors
+	 * @tparam selector_t One of @c double or @c active
+	 * @return Either @p a or @p b depending on the template argument
+	 */
+	template <class selector_t>
+	const std::vector<selector_t>& selectFactors(const std::vector<double>& a, const std::vector<cadet::active>& b)
+	{
+		cadet_assert(false);
+	}
+
+	template <>
+	const std::vector<double>& selectFactors<double>(const std::vector<double>& a, const std::vector<cadet::active>& b)
+	{
+		return a;
+	}
+
+	template <>
+	const std::vector<cadet::active>& selectFactors<cadet::active>(const std::vector<double>& a, const std::vector<cadet::active>& b)
+	{
+		return b;
+	}
+
 	/**
 	 * @brief Computes a total return code from a list of separate return codes
 	 * @details A negative return code indicates a non-recoverable error. Positive
@@ -137,6 +168,46 @@ namespace
 		return std::max(curCode, nextCode);
 	}
 
+	/**
+	 * @brief Accumulates the total inflow and outflow rate of a unit in a connection list
+	 * @details Only the first row of each (source, destination) pair carries the flow rate;
+	 *          further rows of the same pair only route additional components.
+	 * @param [in] conn Connection list (rows of 4 entries)
+	 * @param [in] nRows Number of rows in the connection list
+	 * @param [in] rates Flow rate of each connection row
+	 * @param [in] unit Index of the unit operation
+	 * @param [out] totalIn Total flow rate into the unit
+	 * @param [out] totalOut Total flow rate out of the unit
+	 */
+	inline void totalUnitFlows(int const* conn, unsigned int nRows, cadet::active const* rates, int unit, double& totalIn, double& totalOut)
+	{
+		totalIn = 0.0;
+		totalOut = 0.0;
+		for (unsigned int j = 0; j < nRows; ++j)
+		{
+			const int uoSource = conn[4 * j];
+			const int uoDest = conn[4 * j + 1];
+
+			// Make sure this is the first connection (there may be several with different components)
+			bool skip = false;
+			for (unsigned int k = 0; k < j; ++k)
+			{
+				if ((conn[4 * k] == uoSource) && (conn[4 * k + 1] == uoDest))
+				{
+					skip = true;
+					break;
+				}
+			}
+			if (skip)
+				continue;
+
+			if (uoSource == unit)
+				totalOut += static_cast<double>(rates[j]);
+			if (uoDest == unit)
+				totalIn += static_cast<double>(rates[j]);
+		}
+	}
+
 	struct FullTag {};
 	struct LeanTag {};
 
@@ -226,7 +297,8 @@ namespace cadet
 namespace model
 {
 
-ModelSystem::ModelSystem() : _jacNF(nullptr), _jacFN(nullptr), _jacActiveFN(nullptr), _curSwitchIndex(0), _tempState(nullptr)
+ModelSystem::ModelSystem() : _jacNF(nullptr), _jacFN(nullptr), _jacActiveFN(nullptr), _numComputeUnits(0), _curSwitchIndex(0), _prevSwitchIndex(0), _lastSwitchSec(0), _tempState(nullptr),
+	_directSchurSolver(false), _schurAssemblyDirty(true), _schurAssembledAlpha(0.0)
 {
 }
 
@@ -235,6 +307,9 @@ ModelSystem::~ModelSystem() CADET_NOEXCEPT
 	for (IUnitOperation* model : _models)
 		delete model;
 
+	for (CachedExternalFunction* extFun : _extFunCache)
+		delete extFun;
+
 	for (IExternalFunction* extFun : _extFunctions)
 		delete extFun;
 
@@ -257,7 +332,7 @@ void ModelSystem::addModel(IModel* unitOp)
 		_inOutModels.push_back(_models.size() - 1);
 
 	// Propagate external functions to submodel
-	uo->setExternalFunctions(_extFunctions.data(), _extFunctions.size());
+	uo->setExternalFunctions(_extFunView.data(), _extFunView.size());
 }
 
 IModel* ModelSystem::getModel(unsigned int index)
@@ -338,12 +413,43 @@ unsigned int ModelSystem::addExternalFunction(IExternalFunction& extFun)
 	_extFunctions.push_back(&extFun);
 
 	// Propagate external functions to submodels
+	updateExternalFunctionViews();
 	for (IUnitOperation* m : _models)
-		m->setExternalFunctions(_extFunctions.data(), _extFunctions.size());
+		m->setExternalFunctions(_extFunView.data(), _extFunView.size());
 
 	return _extFunctions.size() - 1;
 }
 
+/**
+ * @brief Rebuilds the memoizing wrappers that are handed to the unit operation models
+ * @details The unit operation models do not receive the external functions directly but
+ *          through CachedExternalFunction wrappers, so a profile that is shared by
+ *          several consumers is evaluated once per time point and spatial position.
+ *          The wrapper array mirrors _extFunctions index by index (with @c nullptr
+ *          entries preserved) and has to be rebuilt before every broadcast via
+ *          setExternalFunctions().
+ */
+void ModelSystem::updateExternalFunctionViews()
+{
+	for (CachedExternalFunction* extFun : _extFunCache)
+		delete extFun;
+
+	_extFunCache.clear();
+	_extFunView.clear();
+	_extFunView.reserve(_extFunctions.size());
+
+	for (IExternalFunction* extFun : _extFunctions)
+	{
+		if (extFun)
+		{
+			_extFunCache.push_back(new CachedExternalFunction(*extFun));
+			_extFunView.push_back(_extFunCache.back());
+		}
+		else
+			_extFunView.push_back(nullptr);
+	}
+}
+
 IExternalFunction* ModelSystem::getExternalFunction(unsigned int index)
 {
 	if (index < _extFunctions.size())
@@ -365,6 +471,49 @@ unsigned int ModelSystem::numExternalFunctions() const CADET_NOEXCEPT
 	return _extFunctions.size();
 }
 
+std::size_t ModelSystem::memoryFootprint() const CADET_NOEXCEPT
+{
+	std::size_t mem = 0;
+	for (IUnitOperation const* m : _models)
+		mem += m->memoryFootprint();
+
+	// Coupling Jacobian blocks of the superstructure
+	if (_jacNF && _jacFN && _jacActiveFN)
+	{
+		for (unsigned int i = 0; i < numModels(); ++i)
+			mem += _jacNF[i].memoryFootprint() + _jacFN[i].memoryFootprint() + _jacActiveFN[i].memoryFootprint();
+	}
+
+	// Temporary state vector
+	if (_tempState)
+		mem += numDofs() * sizeof(double);
+
+	// Memoized external function evaluations
+	for (CachedExternalFunction const* extFun : _extFunCache)
+		mem += sizeof(CachedExternalFunction) + extFun->memoryFootprint();
+
+	return mem;
+}
+
+cadet::CostEstimate ModelSystem::costEstimate(unsigned int numSensParams) const CADET_NOEXCEPT
+{
+	CostEstimate ce = { 0.0, 0.0, memoryFootprint() };
+	for (IUnitOperation const* m : _models)
+	{
+		const CostEstimate mc = m->costEstimate(numSensParams);
+		ce.flopsPerStep += mc.flopsPerStep;
+		ce.bytesPerStep += mc.bytesPerStep;
+	}
+
+	// Coupling flux solve of the superstructure: sparse products with the connection
+	// blocks and the triangular solve over the coupling DOFs per residual evaluation
+	const double coupling = static_cast<double>(numCouplingDOF());
+	ce.flopsPerStep += 20.0 * coupling * (1.0 + numSensParams);
+	ce.bytesPerStep += 4.0 * sizeof(double) * coupling * (1.0 + numSensParams);
+
+	return ce;
+}
+
 void ModelSystem::removeExternalFunction(IExternalFunction const* extFun)
 {
 	for (std::vector<IExternalFunction*>::iterator it = _extFunctions.begin(); it != _extFunctions.end(); ++it)
@@ -377,8 +526,9 @@ void ModelSystem::removeExternalFunction(IExternalFunction const* extFun)
 	}
 
 	// Update external functions in submodels
+	updateExternalFunctionViews();
 	for (IUnitOperation* m : _models)
-		m->setExternalFunctions(_extFunctions.data(), _extFunctions.size());
+		m->setExternalFunctions(_extFunView.data(), _extFunView.size());
 }
 
 unsigned int ModelSystem::numDofs() const CADET_NOEXCEPT
@@ -412,6 +562,18 @@ bool ModelSystem::usesAD() const CADET_NOEXCEPT
 */
 void ModelSystem::rebuildInternalDataStructures()
 {
+#ifdef CADET_SELF_PROFILER
+	// Stable per unit operation labels for the phase stack of the self-profiler
+	_profilerLabels.clear();
+	_profilerLabels.reserve(_models.size());
+	for (IUnitOperation const* m : _models)
+	{
+		std::ostringstream oss;
+		oss << m->unitOperationName() << "#" << static_cast<int>(m->unitOperationId());
+		_profilerLabels.push_back(oss.str());
+	}
+#endif
+
 	// Calculate array with DOF offsets
 	_dofOffset.clear();
 	_dofs.clear();
@@ -432,6 +594,30 @@ void ModelSystem::rebuildInternalDataStructures()
 	// Process DOF from superstructure
 	_dofOffset.push_back(totalDof);
 
+	// Dispatch order for the per-unit parallel loops: heaviest units (by DOF count) first.
+	// The units only couple through their low-dimensional inlet / outlet states, which are
+	// handled separately after the loops, so any order is valid. Scheduling the few heavy
+	// column models before the trivial inlets and outlets minimizes the makespan (longest
+	// processing time first). Pure boundary units (inlets, outlets) are moved behind all
+	// compute units so that the residual can fold them into the calling thread instead of
+	// paying a parallel task for a copy or a polynomial evaluation.
+	_modelExecOrder.resize(_models.size());
+	for (unsigned int i = 0; i < _models.size(); ++i)
+		_modelExecOrder[i] = i;
+	std::stable_sort(_modelExecOrder.begin(), _modelExecOrder.end(),
+		[this](unsigned int a, unsigned int b)
+		{
+			const bool boundaryA = _models[a]->isPureBoundaryUnit();
+			const bool boundaryB = _models[b]->isPureBoundaryUnit();
+			if (boundaryA != boundaryB)
+				return boundaryB;
+			return _models[a]->numDofs() > _models[b]->numDofs();
+		});
+
+	_numComputeUnits = 0;
+	while ((_numComputeUnits < _models.size()) && !_models[_modelExecOrder[_numComputeUnits]]->isPureBoundaryUnit())
+		++_numComputeUnits;
+
 	/*
 		A mapping is needing to turn a local model and component number into the location of the inlet DOF in
 		the global state vector. Some unit operations do not have inlet DOFs (e.g., inlet unit operation). Hence,
@@ -596,8 +782,9 @@ bool ModelSystem::configure(IParameterProvider& paramProvider, IConfigHelper& he
 	}
 
 	// Propagate external functions to submodels
+	updateExternalFunctionViews();
 	for (IUnitOperation* m : _models)
-		m->setExternalFunctions(_extFunctions.data(), _extFunctions.size());
+		m->setExternalFunctions(_extFunView.data(), _extFunView.size());
 
 	// Read solver settings
 	paramProvider.pushScope("solver");
@@ -605,8 +792,17 @@ bool ModelSystem::configure(IParameterProvider& paramProvider, IConfigHelper& he
 	const int gsType = paramProvider.getInt("GS_TYPE");
 	const int maxRestarts = paramProvider.getInt("MAX_RESTARTS");
 	_schurSafety = paramProvider.getDouble("SCHUR_SAFETY");
+
+	// The inter-unit coupling system can optionally be assembled explicitly and solved
+	// directly instead of iterating with GMRES
+	if (paramProvider.exists("DIRECT_SCHUR"))
+		_directSchurSolver = paramProvider.getBool("DIRECT_SCHUR");
+
 	paramProvider.popScope();
 
+	if (_directSchurSolver)
+		_schurMatrix.resize(numCouplingDOF(), numCouplingDOF());
+
 	// Initialize and configure GMRES for solving the Schur-complement
     _gmres.initialize(numCouplingDOF(), maxKrylov, linalg::toOrthogonalization(gsType), maxRestarts);
 
@@ -657,6 +853,10 @@ bool ModelSystem::reconfigure(IParameterProvider& paramProvider)
 		}
 
 		paramProvider.popScope();
+
+		// The reconfigured functions may return different values for already queried points
+		for (CachedExternalFunction* extFun : _extFunCache)
+			extFun->invalidate();
 	}
 
 	// Reconfigure solver settings
@@ -664,8 +864,16 @@ bool ModelSystem::reconfigure(IParameterProvider& paramProvider)
 	const int gsType = paramProvider.getInt("GS_TYPE");
 	const int maxRestarts = paramProvider.getInt("MAX_RESTARTS");
 	_schurSafety = paramProvider.getDouble("SCHUR_SAFETY");
+
+	if (paramProvider.exists("DIRECT_SCHUR"))
+		_directSchurSolver = paramProvider.getBool("DIRECT_SCHUR");
+
 	paramProvider.popScope();
 
+	if (_directSchurSolver)
+		_schurMatrix.resize(numCouplingDOF(), numCouplingDOF());
+	_schurAssemblyDirty = true;
+
 	_gmres.orthoMethod(linalg::toOrthogonalization(gsType));
 	_gmres.maxRestarts(maxRestarts);
 
@@ -697,6 +905,10 @@ void ModelSystem::configureSwitches(IParameterProvider& paramProvider)
 	const StringHash flowHash = hashString("CONNECTION");
 #endif
 
+	// Scratch buffers reused across switches to avoid reallocating per iteration
+	std::vector<int> conn;
+	std::vector<double> fr;
+
 	std::ostringstream oss;
 	for (unsigned int i = 0; i < numSwitches; ++i)
 	{
@@ -710,12 +922,12 @@ void ModelSystem::configureSwitches(IParameterProvider& paramProvider)
 		if ((i > 0) && (_switchSectionIndex.back() <= _switchSectionIndex[_switchSectionIndex.size() - 2]))
 			throw InvalidParameterException("SECTION index has to be monotonically increasing (switch " + std::to_string(i) + ")");
 
-		std::vector<double> connFlow = paramProvider.getDoubleArray("CONNECTIONS");
+		const std::vector<double> connFlow = paramProvider.getDoubleArray("CONNECTIONS");
 		if ((connFlow.size() % 5) != 0)
 			throw InvalidParameterException("CONNECTIONS matrix has to have 5 columns");
 
-		std::vector<int> conn(connFlow.size() / 5 * 4, 0);
-		std::vector<double> fr(connFlow.size() / 5, 0.0);
+		conn.assign(connFlow.size() / 5 * 4, 0);
+		fr.assign(connFlow.size() / 5, 0.0);
 		
 		checkConnectionList(connFlow, conn, fr, i);
 
@@ -1036,6 +1248,13 @@ void ModelSystem::notifyDiscontinuousSectionTransition(double t, unsigned int se
 			_curSwitchIndex = 0;
 	}
 
+	// Record valve configuration changes for the consistent initialization skip list
+	if (_curSwitchIndex != prevSwitch)
+	{
+		_prevSwitchIndex = prevSwitch;
+		_lastSwitchSec = secIdx;
+	}
+
 	// Notify models that a discontinuous section transition has happened
 	int const* ptrConn = _connections[_curSwitchIndex];
 	active const* const conRates = _flowRates[_curSwitchIndex];
@@ -1102,10 +1321,81 @@ void ModelSystem::notifyDiscontinuousSectionTransition(double t, unsigned int se
 
 /**
 * @brief Rebuild the outer network connection matrices in the super structure
-* @details Rebuild NF and FN matrices. This should only be called if the connections have changed. 
+* @details Rebuild NF and FN matrices. This should only be called if the connections have changed.
+*          Compiled configurations are cached per valve switch: at the beginning of a run all
+*          configurations are assembled ahead of integration (the flow rates are parameters and
+*          may have changed between runs, so earlier caches are discarded), and later transitions
+*          only swap the precompiled state in instead of re-deriving it while integration stalls.
 * @param [in] secIdx Section index
 */
 void ModelSystem::assembleSuperStructMatrices(unsigned int secIdx)
+{
+	if (_switchCache.size() != _switchSectionIndex.size())
+		_switchCache.resize(_switchSectionIndex.size());
+
+	if (secIdx == 0)
+	{
+		// Precompute all valve configurations so that transitions during the run
+		// reduce to applying the cached state; assemble the active one last so
+		// that the live structures end up in the correct configuration
+		for (unsigned int i = 0; i < _switchSectionIndex.size(); ++i)
+		{
+			if (i == _curSwitchIndex)
+				continue;
+
+			assembleValveSwitch(i);
+			cacheValveSwitch(_switchCache[i]);
+		}
+
+		assembleValveSwitch(_curSwitchIndex);
+		cacheValveSwitch(_switchCache[_curSwitchIndex]);
+	}
+	else
+	{
+		CompiledValveConfig& cfg = _switchCache[_curSwitchIndex];
+		if (cfg.valid)
+			applyValveSwitch(cfg);
+		else
+		{
+			assembleValveSwitch(_curSwitchIndex);
+			cacheValveSwitch(cfg);
+		}
+	}
+
+	// The connectivity has changed, so the assembled Schur complement has to be updated
+	_schurAssemblyDirty = true;
+}
+
+bool ModelSystem::exactSectionTransition(double t, unsigned int secIdx)
+{
+	// The consistency of the very first initialization cannot be established by a state jump
+	if (secIdx == 0)
+		return false;
+
+	// A valve configuration change alters flow rates and connectivity, which changes the
+	// algebraic coupling equations beyond a pure state jump
+	if ((_lastSwitchSec == secIdx) && (_prevSwitchIndex != _curSwitchIndex))
+		return false;
+
+	// Every unit has to certify that its outlet jump at this boundary is exactly known;
+	// in this case the differential states are continuous across the boundary and a lean
+	// initialization restores the consistency of the algebraic variables
+	for (IUnitOperation* m : _models)
+	{
+		if (!m->exactDiscontinuousOutputTransition(t, secIdx))
+			return false;
+	}
+
+	return true;
+}
+
+/**
+* @brief Assembles the coupling structures of the given valve configuration into the live members
+* @details Rebuilds the NF and FN matrices, the total inlet flow rates, the compiled routing plan,
+*          and the conflict-free coupling groups from the connection list of the given valve switch.
+* @param [in] switchIdx Index of the valve switch
+*/
+void ModelSystem::assembleValveSwitch(unsigned int switchIdx)
 {
 	// Clear the matrices before we set new entries
 	for (unsigned int i = 0; i < numModels(); ++i)
@@ -1138,14 +1428,14 @@ void ModelSystem::assembleSuperStructMatrices(unsigned int secIdx)
 	}
 
 	// Calculate total flow rate for each inlet
-	int const* const ptrConn = _connections[_curSwitchIndex];
-	active const* const ptrRate = _flowRates[_curSwitchIndex];
+	int const* const ptrConn = _connections[switchIdx];
+	active const* const ptrRate = _flowRates[switchIdx];
 
 	// Reset _totalInletFlow back to zero
 	std::fill(_totalInletFlow.begin(), _totalInletFlow.end(), 0.0);
 
 	// Compute total volumetric inflow for each unit operation
-	for (unsigned int i = 0; i < _connections.sliceSize(_curSwitchIndex) / 4; ++i)
+	for (unsigned int i = 0; i < _connections.sliceSize(switchIdx) / 4; ++i)
 	{
 		// Extract current connection
 		const int uoSource = ptrConn[4*i];
@@ -1172,7 +1462,7 @@ void ModelSystem::assembleSuperStructMatrices(unsigned int secIdx)
 
 	// Bottom macro-row
 	// FN
-	for (unsigned int i = 0; i < _connections.sliceSize(_curSwitchIndex) / 4; ++i)
+	for (unsigned int i = 0; i < _connections.sliceSize(switchIdx) / 4; ++i)
 	{
 		// Extract current connection
 		const int uoSource = ptrConn[4*i];
@@ -1221,6 +1511,154 @@ void ModelSystem::assembleSuperStructMatrices(unsigned int secIdx)
 	// Copy active sparse matrices to their double pendants
 	for (unsigned int i = 0; i < numModels(); ++i)
 		_jacFN[i].copyFrom(_jacActiveFN[i]);
+
+	// The connectivity has changed, so the compiled routing plan and the
+	// conflict-free grouping have to be updated
+	compileRoutingPlan();
+	computeCouplingGroups();
+}
+
+/**
+* @brief Stores the assembled coupling structures of the live members in the given cache entry
+* @param [out] cfg Cache entry receiving the compiled valve configuration
+*/
+void ModelSystem::cacheValveSwitch(CompiledValveConfig& cfg)
+{
+	cfg.jacNF.resize(numModels());
+	cfg.jacFN.resize(numModels());
+	cfg.jacActiveFN.resize(numModels());
+	for (unsigned int i = 0; i < numModels(); ++i)
+	{
+		cfg.jacNF[i].copyFrom(_jacNF[i]);
+		cfg.jacFN[i].copyFrom(_jacFN[i]);
+		cfg.jacActiveFN[i].copyFrom(_jacActiveFN[i]);
+	}
+
+	cfg.totalInletFlow = _totalInletFlow;
+	cfg.couplingGroups = _couplingGroups;
+	cfg.routeInletDof = _routeInletDof;
+	cfg.routeInletCoupling = _routeInletCoupling;
+	cfg.routeOutletDof = _routeOutletDof;
+	cfg.routeOutletCoupling = _routeOutletCoupling;
+	cfg.routeOutletFactor = _routeOutletFactor;
+	cfg.routeOutletFactorActive = _routeOutletFactorActive;
+	cfg.valid = true;
+}
+
+/**
+* @brief Applies a previously compiled valve configuration to the live members
+* @param [in] cfg Cached valve configuration
+*/
+void ModelSystem::applyValveSwitch(const CompiledValveConfig& cfg)
+{
+	for (unsigned int i = 0; i < numModels(); ++i)
+	{
+		_jacNF[i].copyFrom(cfg.jacNF[i]);
+		_jacFN[i].copyFrom(cfg.jacFN[i]);
+		_jacActiveFN[i].copyFrom(cfg.jacActiveFN[i]);
+	}
+
+	_totalInletFlow = cfg.totalInletFlow;
+	_couplingGroups = cfg.couplingGroups;
+	_routeInletDof = cfg.routeInletDof;
+	_routeInletCoupling = cfg.routeInletCoupling;
+	_routeOutletDof = cfg.routeOutletDof;
+	_routeOutletCoupling = cfg.routeOutletCoupling;
+	_routeOutletFactor = cfg.routeOutletFactor;
+	_routeOutletFactorActive = cfg.routeOutletFactorActive;
+}
+
+/**
+ * @brief Compiles the connection matrices of the current valve configuration into a flat routing plan
+ * @details The residual applies the NF and FN blocks on every evaluation. Instead of traversing
+ *          one sparse matrix per unit operation there, the nonzero entries are flattened once per
+ *          valve switch into parallel arrays of (global DOF index, coupling DOF index, flow factor)
+ *          that the residual walks with a single gather and a single scatter loop. All NF entries
+ *          are @f$ -1 @f$ by construction, so only the FN factors are stored.
+ */
+void ModelSystem::compileRoutingPlan()
+{
+	_routeInletDof.clear();
+	_routeInletCoupling.clear();
+	_routeOutletDof.clear();
+	_routeOutletCoupling.clear();
+	_routeOutletFactor.clear();
+	_routeOutletFactorActive.clear();
+
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		const unsigned int offset = _dofOffset[i];
+
+		// NF block: coupling DOFs feed the local inlet entries
+		const linalg::SparseMatrix<double>& nf = _jacNF[i];
+		for (unsigned int j = 0; j < nf.numNonZero(); ++j)
+		{
+			_routeInletDof.push_back(offset + nf.rows()[j]);
+			_routeInletCoupling.push_back(nf.cols()[j]);
+		}
+
+		// FN block: flow-weighted local outlet entries feed the coupling DOFs
+		const linalg::SparseMatrix<active>& fn = _jacActiveFN[i];
+		for (unsigned int j = 0; j < fn.numNonZero(); ++j)
+		{
+			_routeOutletDof.push_back(offset + fn.cols()[j]);
+			_routeOutletCoupling.push_back(fn.rows()[j]);
+			_routeOutletFactorActive.push_back(fn.values()[j]);
+			_routeOutletFactor.push_back(static_cast<double>(fn.values()[j]));
+		}
+	}
+}
+
+/**
+ * @brief Partitions the unit operations into groups that write disjoint coupling DOFs
+ * @details The products @f$ J_{f,i} \, y_i @f$ are accumulated in-place into the coupling DOFs,
+ *          which prevents naive parallelization over units. However, two unit operations conflict
+ *          only if their outlets feed the same inlet (i.e., their @f$ J_{f,i} @f$ blocks share
+ *          nonzero rows), which happens on mixing nodes only. Units are greedily assigned to the
+ *          first group without a row conflict, which yields a single fully parallel group for
+ *          permutation-like networks (e.g., SMB loops).
+ */
+void ModelSystem::computeCouplingGroups()
+{
+	_couplingGroups.clear();
+	std::vector<std::vector<bool>> groupRows;
+
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		const std::vector<unsigned int>& rows = _jacFN[i].rows();
+		const unsigned int nnz = _jacFN[i].numNonZero();
+
+		// Find the first group whose units do not touch any of our coupling DOFs
+		unsigned int target = _couplingGroups.size();
+		for (unsigned int g = 0; g < _couplingGroups.size(); ++g)
+		{
+			bool conflict = false;
+			for (unsigned int j = 0; j < nnz; ++j)
+			{
+				if (groupRows[g][rows[j]])
+				{
+					conflict = true;
+					break;
+				}
+			}
+
+			if (!conflict)
+			{
+				target = g;
+				break;
+			}
+		}
+
+		if (target == _couplingGroups.size())
+		{
+			_couplingGroups.emplace_back();
+			groupRows.emplace_back(numCouplingDOF(), false);
+		}
+
+		_couplingGroups[target].push_back(i);
+		for (unsigned int j = 0; j < nnz; ++j)
+			groupRows[target][rows[j]] = true;
+	}
 }
 
 void ModelSystem::reportSolution(ISolutionRecorder& recorder, double const* const solution) const
@@ -1253,13 +1691,39 @@ void ModelSystem::prepareADvectors(active* const adRes, active* const adY, unsig
 	if (!adY)
 		return;
 
+	// Units with the same non-zero AD seed structure hash set up identical seed vectors,
+	// so the seeds of the first unit of each group are prepared once and copied to the
+	// remaining members instead of repeating the seed bookkeeping per unit
+	std::vector<std::pair<uint64_t, unsigned int>> preparedSeeds;
+	preparedSeeds.reserve(_models.size());
+
 	for (unsigned int i = 0; i < _models.size(); ++i)
 	{
-		if (_models[i]->usesAD())
+		if (!_models[i]->usesAD())
+			continue;
+
+		const unsigned int offset = _dofOffset[i];
+		const uint64_t seedHash = _models[i]->adSeedStructureHash();
+		if (seedHash != 0)
 		{
-			const unsigned int offset = _dofOffset[i];
-			_models[i]->prepareADvectors(adRes + offset, adY + offset, adDirOffset);
+			bool copied = false;
+			for (const std::pair<uint64_t, unsigned int>& ps : preparedSeeds)
+			{
+				if ((ps.first == seedHash) && (_models[ps.second]->numDofs() == _models[i]->numDofs()))
+				{
+					// Only adY carries seeds; adRes is written by the residual evaluation
+					ad::copyAdSeeds(adY + _dofOffset[ps.second], adY + offset, _models[i]->numDofs());
+					copied = true;
+					break;
+				}
+			}
+			if (copied)
+				continue;
+
+			preparedSeeds.push_back(std::make_pair(seedHash, i));
 		}
+
+		_models[i]->prepareADvectors(adRes + offset, adY + offset, adDirOffset);
 	}
 }
 
@@ -1274,16 +1738,39 @@ int ModelSystem::residual(double t, unsigned int secIdx, double timeFactor, doub
 	BENCH_START(_timerResidual);
 
 #ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), _models.size(), [&](size_t i)
+	tbb::parallel_for(size_t(0), size_t(_numComputeUnits), [&](size_t item)
 #else
-	for (unsigned int i = 0; i < _models.size(); ++i)
+	for (unsigned int item = 0; item < _numComputeUnits; ++item)
 #endif
 	{
+		const unsigned int i = _modelExecOrder[item];
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
+#ifdef CADET_SELF_PROFILER
+		const profiler::ScopedPhase profPhase(_profilerLabels[i].c_str());
+#endif
 		_errorIndicator[i] = m->residual(t, secIdx, timeFactor, y + offset, yDot + offset, res + offset);
 	} CADET_PARFOR_END;
 
+	// Fold pure boundary units into the calling thread: an outlet residual is a plain
+	// copy with identity Jacobian and an inlet residual a profile evaluation, which is
+	// not worth dispatching a parallel task per residual call
+	for (unsigned int item = _numComputeUnits; item < _models.size(); ++item)
+	{
+		const unsigned int i = _modelExecOrder[item];
+		IUnitOperation* const m = _models[i];
+		const unsigned int offset = _dofOffset[i];
+
+		if (!m->hasOutlet())
+		{
+			// Outlet unit: res = y
+			std::copy(y + offset, y + offset + m->numDofs(), res + offset);
+			_errorIndicator[i] = 0;
+		}
+		else
+			_errorIndicator[i] = m->residual(t, secIdx, timeFactor, y + offset, yDot + offset, res + offset);
+	}
+
 	// Handle connections
 	residualConnectUnitOps<double, double, double>(secIdx, y, yDot, res);
 
@@ -1296,12 +1783,16 @@ int ModelSystem::residualWithJacobian(const active& t, unsigned int secIdx, cons
 {
 	BENCH_START(_timerResidual);
 
+	// The unit operation Jacobians change, which invalidates the assembled Schur complement
+	_schurAssemblyDirty = true;
+
 #ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), _models.size(), [&](size_t i)
+	tbb::parallel_for(size_t(0), size_t(_numComputeUnits), [&](size_t item)
 #else
-	for (unsigned int i = 0; i < _models.size(); ++i)
+	for (unsigned int item = 0; item < _numComputeUnits; ++item)
 #endif
 	{
+		const unsigned int i = _modelExecOrder[item];
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
 
@@ -1309,11 +1800,37 @@ int ModelSystem::residualWithJacobian(const active& t, unsigned int secIdx, cons
 		active* const localAdY = (adY) ? (adY + offset) : nullptr;
 		double const* const localYdot = (yDot) ? (yDot + offset) : nullptr;
 
+#ifdef CADET_SELF_PROFILER
+		const profiler::ScopedPhase profPhase(_profilerLabels[i].c_str());
+#endif
 		_errorIndicator[i] = m->residualWithJacobian(t, secIdx, timeFactor, y + offset,
 			localYdot, res + offset, localAdRes, localAdY, adDirOffset);
 
 	} CADET_PARFOR_END;
 
+	// Fold pure boundary units into the calling thread (see residual())
+	for (unsigned int item = _numComputeUnits; item < _models.size(); ++item)
+	{
+		const unsigned int i = _modelExecOrder[item];
+		IUnitOperation* const m = _models[i];
+		const unsigned int offset = _dofOffset[i];
+
+		if (!m->hasOutlet())
+		{
+			// Outlet unit: res = y, Jacobian is identity
+			std::copy(y + offset, y + offset + m->numDofs(), res + offset);
+			_errorIndicator[i] = 0;
+		}
+		else
+		{
+			active* const localAdRes = (adRes) ? (adRes + offset) : nullptr;
+			active* const localAdY = (adY) ? (adY + offset) : nullptr;
+			double const* const localYdot = (yDot) ? (yDot + offset) : nullptr;
+			_errorIndicator[i] = m->residualWithJacobian(t, secIdx, timeFactor, y + offset,
+				localYdot, res + offset, localAdRes, localAdY, adDirOffset);
+		}
+	}
+
 	// Handle connections
 	residualConnectUnitOps<double, double, double>(secIdx, y, yDot, res);
 
@@ -1342,32 +1859,30 @@ void ModelSystem::residualConnectUnitOps(unsigned int secIdx, StateType const* c
 	for (unsigned int i = finalOffset; i < numDofs(); ++i)
 		res[i] = y[i];
 
-	// These could technically be done in parallel but from profiling no time is spent here 
+	// These could technically be done in parallel but from profiling no time is spent here
 	// and the parallelization has more overhead than can be gained.
 
-	// N_{x,f} Inlets (Right) matrices; Right macro-column
-	unsigned int offset;
-	for (unsigned int i = 0; i < _models.size(); ++i)
-	{
-		offset = _dofOffset[i];
-		_jacNF[i].multiplyAdd(y + finalOffset, res + offset);
-	}
+	// Apply the compiled routing plan of the current valve configuration instead of
+	// traversing the per unit NF and FN matrices
 
-	// N_{f,x} Outlet (Lower) matrices; Bottom macro-row
-	for (unsigned int i = 0; i < _models.size(); ++i)
-	{
-		offset = _dofOffset[i];
-		select<ParamType>(_jacFN[i], _jacActiveFN[i]).multiplyAdd(y + offset, res + finalOffset);
-	}
+	// N_{x,f} Inlets (Right) macro-column: gather coupling DOFs into the inlet entries
+	// (all NF entries are -1 by construction)
+	for (std::size_t k = 0; k < _routeInletDof.size(); ++k)
+		res[_routeInletDof[k]] -= y[finalOffset + _routeInletCoupling[k]];
+
+	// N_{f,x} Outlet (Lower) macro-row: scatter flow-weighted outlet entries into the coupling DOFs
+	const auto& factors = selectFactors<ParamType>(_routeOutletFactor, _routeOutletFactorActive);
+	for (std::size_t k = 0; k < _routeOutletDof.size(); ++k)
+		res[finalOffset + _routeOutletCoupling[k]] += factors[k] * y[_routeOutletDof[k]];
 }
 
 int ModelSystem::residualSensFwd(unsigned int nSens, const active& t, unsigned int secIdx,
 	const active& timeFactor, double const* const y, double const* const yDot, double const* const res,
 	const std::vector<const double*>& yS, const std::vector<const double*>& ySdot, const std::vector<double*>& resS,
-	active* const adRes, double* const tmp1, double* const tmp2, double* const tmp3)
+	active* const adRes, unsigned char const* sensMask, double* const tmp1, double* const tmp2, double* const tmp3)
 {
 	BENCH_SCOPE(_timerResidualSens);
-	return residualSensFwdWithJacobianAlgorithm<false>(nSens, t, secIdx, timeFactor, y, yDot, res, yS, ySdot, resS, adRes, nullptr, 0, tmp1, tmp2, tmp3);
+	return residualSensFwdWithJacobianAlgorithm<false>(nSens, t, secIdx, timeFactor, y, yDot, res, yS, ySdot, resS, adRes, nullptr, 0, sensMask, tmp1, tmp2, tmp3);
 }
 
 void ModelSystem::multiplyWithJacobian(double const* yS, double alpha, double beta, double* ret)
@@ -1397,6 +1912,33 @@ void ModelSystem::multiplyWithJacobian(double const* yS, double alpha, double be
 	}
 }
 
+void ModelSystem::multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret)
+{
+	const unsigned int finalOffset = _dofOffset.back();
+
+	// Set ret_con = yS_con
+	// This applies the identity matrix in the bottom right corner of the transposed Jacobian
+	// (network coupling equation)
+	for (unsigned int i = finalOffset; i < numDofs(); ++i)
+	{
+		ret[i] = alpha * yS[i] + beta * ret[i];
+	}
+
+	// Transposed N_{x,f} Inlets (Right) matrices scatter into the coupling DOFs
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		const unsigned int offset = _dofOffset[i];
+		_jacNF[i].transposedMultiplyAdd(yS + offset, ret + finalOffset, alpha);
+	}
+
+	// Transposed N_{f,x} Outlet (Lower) matrices scatter into the unit operation DOFs
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		const unsigned int offset = _dofOffset[i];
+		_jacFN[i].transposedMultiplyAdd(yS + finalOffset, ret + offset, alpha);
+	}
+}
+
 void ModelSystem::residualSensFwdNorm(unsigned int nSens, const active& t, unsigned int secIdx,
 		const active& timeFactor, double const* const y, double const* const yDot,
 		const std::vector<const double*>& yS, const std::vector<const double*>& ySdot, double* const norms,
@@ -1419,11 +1961,17 @@ void ModelSystem::residualSensFwdNorm(unsigned int nSens, const active& t, unsig
 	std::vector<double> tempMem(nDOFs * 2, 0.0);
 
 	// Evaluate all the sensitivity system residuals at once
-	residualSensFwd(nSens, t, secIdx, timeFactor, y, yDot, nullptr, yS, ySdot, resPtr, adRes, tmp, tempMem.data(), tempMem.data() + nDOFs);
+	residualSensFwd(nSens, t, secIdx, timeFactor, y, yDot, nullptr, yS, ySdot, resPtr, adRes, nullptr, tmp, tempMem.data(), tempMem.data() + nDOFs);
 
-	// Calculate norms
+	// Calculate norms; the parameters are independent, so they are processed in parallel
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(nSens), [&](size_t i)
+#else
 	for (unsigned int i = 0; i < nSens; ++i)
+#endif
+	{
 		norms[i] = linalg::linfNorm(tempRes[i], nDOFs);
+	} CADET_PARFOR_END;
 }
 
 int ModelSystem::residualSensFwdWithJacobian(unsigned int nSens, const active& t, unsigned int secIdx, const active& timeFactor,
@@ -1431,15 +1979,46 @@ int ModelSystem::residualSensFwdWithJacobian(unsigned int nSens, const active& t
 		const std::vector<const double*>& yS, const std::vector<const double*>& ySdot, const std::vector<double*>& resS,
 		active* const adRes, active* const adY, unsigned int adDirOffset, double* const tmp1, double* const tmp2, double* const tmp3)
 {
-	return residualSensFwdWithJacobianAlgorithm<true>(nSens, t, secIdx, timeFactor, y, yDot, res, yS, ySdot, resS, adRes, adY, adDirOffset, tmp1, tmp2, tmp3);
+	return residualSensFwdWithJacobianAlgorithm<true>(nSens, t, secIdx, timeFactor, y, yDot, res, yS, ySdot, resS, adRes, adY, adDirOffset, nullptr, tmp1, tmp2, tmp3);
 }
 
 template <bool evalJacobian>
 int ModelSystem::residualSensFwdWithJacobianAlgorithm(unsigned int nSens, const active& t, unsigned int secIdx, const active& timeFactor,
 	double const* const y, double const* const yDot, double const* const res,
-	const std::vector<const double*>& yS, const std::vector<const double*>& ySdot, const std::vector<double*>& resS,
-	active* const adRes, active* const adY, unsigned int adDirOffset, double* const tmp1, double* const tmp2, double* const tmp3)
-{
+	const std::vector<const double*>& ySFull, const std::vector<const double*>& ySdotFull, const std::vector<double*>& resSFull,
+	active* const adRes, active* const adY, unsigned int adDirOffset, unsigned char const* const sensMask, double* const tmp1, double* const tmp2, double* const tmp3)
+{
+	// If some sensitivity directions are inactive in the current section, pack the
+	// active directions into contiguous vectors. The units then run their per-direction
+	// work only on the active subset; _sensDirMap preserves the link between a packed
+	// index and its AD direction in adRes. Inactive directions are frozen below by
+	// assigning them the residual sdot = 0.
+	bool anyMasked = false;
+	if (sensMask)
+	{
+		_ySPacked.clear();
+		_ySdotPacked.clear();
+		_resSPacked.clear();
+		_sensDirMap.clear();
+		for (unsigned int i = 0; i < ySFull.size(); ++i)
+		{
+			if (!sensMask[i])
+			{
+				anyMasked = true;
+				continue;
+			}
+
+			_ySPacked.push_back(ySFull[i]);
+			_ySdotPacked.push_back(ySdotFull[i]);
+			_resSPacked.push_back(resSFull[i]);
+			_sensDirMap.push_back(i);
+		}
+	}
+
+	const std::vector<const double*>& yS = anyMasked ? _ySPacked : ySFull;
+	const std::vector<const double*>& ySdot = anyMasked ? _ySdotPacked : ySdotFull;
+	const std::vector<double*>& resS = anyMasked ? _resSPacked : resSFull;
+	unsigned int const* const dirMap = anyMasked ? _sensDirMap.data() : nullptr;
 	BENCH_START(_timerResidualSens);
 
 	const unsigned int nModels = _models.size();
@@ -1459,11 +2038,12 @@ int ModelSystem::residualSensFwdWithJacobianAlgorithm(unsigned int nSens, const
 	// Step 1: Calculate sensitivities using AD in vector mode
 
 #ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), size_t(nModels), [&](size_t i)
+	tbb::parallel_for(size_t(0), size_t(nModels), [&](size_t item)
 #else
-	for (unsigned int i = 0; i < nModels; ++i)
+	for (unsigned int item = 0; item < nModels; ++item)
 #endif
 	{
+		const unsigned int i = _modelExecOrder[item];
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
 
@@ -1478,11 +2058,12 @@ int ModelSystem::residualSensFwdWithJacobianAlgorithm(unsigned int nSens, const
 	residualConnectUnitOps<double, active, active>(secIdx, y, yDot, adRes);
 
 #ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), size_t(nModels), [&](size_t i)
+	tbb::parallel_for(size_t(0), size_t(nModels), [&](size_t item)
 #else
-	for (unsigned int i = 0; i < nModels; ++i)
+	for (unsigned int item = 0; item < nModels; ++item)
 #endif
 	{
+		const unsigned int i = _modelExecOrder[item];
 		// Step 2: Compute forward sensitivity residuals by multiplying with system Jacobians
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
@@ -1496,7 +2077,7 @@ int ModelSystem::residualSensFwdWithJacobianAlgorithm(unsigned int nSens, const
 			_resSTemp[i][j] = resS[j] + offset;
 		}
 
-		const int intermediateRes = m->residualSensFwdCombine(timeFactor, _yStemp[i], _yStempDot[i], _resSTemp[i], adRes + offset, tmp1 + offset, tmp2 + offset, tmp3 + offset);
+		const int intermediateRes = m->residualSensFwdCombine(timeFactor, _yStemp[i], _yStempDot[i], _resSTemp[i], adRes + offset, dirMap, tmp1 + offset, tmp2 + offset, tmp3 + offset);
 		_errorIndicator[i] = updateErrorIndicator(_errorIndicator[i], intermediateRes);
 	} CADET_PARFOR_END;
 
@@ -1522,12 +2103,28 @@ int ModelSystem::residualSensFwdWithJacobianAlgorithm(unsigned int nSens, const
 		// Directional derivative (dF / dyDot) * sDot  (always zero so ignore it)
 
 		//The other adRes values have already been taken care of in the unit operations
+		const unsigned int dir = dirMap ? dirMap[param] : static_cast<unsigned int>(param);
 		for (unsigned int i = finalOffset; i < numDofs(); i++)
 		{
-			ptrResS[i] = tmp1[i] + adRes[i].getADValue(param);
+			ptrResS[i] = tmp1[i] + adRes[i].getADValue(dir);
 		}
 	} CADET_PARFOR_END;
 
+	// Freeze inactive directions by prescribing the residual sdot = 0, which keeps
+	// the corresponding sensitivity vectors constant during time integration
+	if (anyMasked)
+	{
+		for (unsigned int j = 0; j < ySFull.size(); ++j)
+		{
+			if (sensMask[j])
+				continue;
+
+			double* const ptrResS = resSFull[j];
+			double const* const ptrYSdot = ySdotFull[j];
+			std::copy(ptrYSdot, ptrYSdot + numDofs(), ptrResS);
+		}
+	}
+
 	BENCH_STOP(_timerResidualSens);
 	return totalErrorIndicatorFromLocal(_errorIndicator);
 }
@@ -1540,11 +2137,12 @@ int ModelSystem::dResDpFwdWithJacobian(const active& t, unsigned int secIdx, con
 	// Evaluate residual for all parameters using AD in vector mode and at the same time update the 
 	// Jacobian (in one AD run, if analytic Jacobians are disabled)
 #ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), _models.size(), [&](size_t i)
+	tbb::parallel_for(size_t(0), _models.size(), [&](size_t item)
 #else
-	for (unsigned int i = 0; i < _models.size(); ++i)
+	for (unsigned int item = 0; item < _models.size(); ++item)
 #endif
 	{
+		const unsigned int i = _modelExecOrder[item];
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
 
@@ -1623,10 +2221,19 @@ void ModelSystem::solveCouplingDOF(double* const vec)
 	// N_{f,x} Outlet (lower) matrices; Bottom macro-row
 	// N_{f,x,1} * y_1 + ... + N_{f,x,nModels} * y_{nModels} + y_{coupling} = f
 	// y_{coupling} = f - N_{f,x,1} * y_1 - ... - N_{f,x,nModels} * y_{nModels}
-	for (unsigned int i = 0; i < _models.size(); ++i)
+	// Process the conflict-free groups from computeCouplingGroups() in parallel
+	for (const std::vector<unsigned int>& group : _couplingGroups)
 	{
-		const unsigned int offset = _dofOffset[i];
-		_jacFN[i].multiplySubtract(vec + offset, vec + finalOffset);
+#ifdef CADET_PARALLELIZE
+		tbb::parallel_for(size_t(0), group.size(), [=, &group](size_t idx)
+#else
+		for (unsigned int idx = 0; idx < group.size(); ++idx)
+#endif
+		{
+			const unsigned int i = group[idx];
+			const unsigned int offset = _dofOffset[i];
+			_jacFN[i].multiplySubtract(vec + offset, vec + finalOffset);
+		} CADET_PARFOR_END;
 	}
 
 	// Calculate inlet DOF for unit operations based on the coupling conditions. Depends on coupling conditions.
@@ -1650,12 +2257,139 @@ void ModelSystem::solveCouplingDOF(double* const vec)
 	}
 }
 
+/**
+ * @brief Checks whether the inlet configuration of a unit differs between two valve configurations
+ * @details Compares the incoming connections (sources and component routing) in table order and
+ *          the total inflow and outflow rates of the unit (they determine the interstitial
+ *          velocities). A reordering of otherwise identical rows is conservatively reported
+ *          as a change.
+ * @param [in] unit Index of the unit operation
+ * @param [in] switchA Index of the first valve configuration
+ * @param [in] switchB Index of the second valve configuration
+ * @return @c true if incoming connections or flow rates differ, otherwise @c false
+ */
+bool ModelSystem::inletConfigurationChanged(unsigned int unit, unsigned int switchA, unsigned int switchB) const
+{
+	int const* const connA = _connections[switchA];
+	int const* const connB = _connections[switchB];
+	const unsigned int nA = _connections.sliceSize(switchA) / 4;
+	const unsigned int nB = _connections.sliceSize(switchB) / 4;
+
+	unsigned int ia = 0;
+	unsigned int ib = 0;
+	while (true)
+	{
+		while ((ia < nA) && (connA[4 * ia + 1] != static_cast<int>(unit)))
+			++ia;
+		while ((ib < nB) && (connB[4 * ib + 1] != static_cast<int>(unit)))
+			++ib;
+
+		// One list has more incoming connections than the other
+		if ((ia == nA) != (ib == nB))
+			return true;
+		if (ia == nA)
+			break;
+
+		if ((connA[4 * ia] != connB[4 * ib]) || (connA[4 * ia + 2] != connB[4 * ib + 2]) || (connA[4 * ia + 3] != connB[4 * ib + 3]))
+			return true;
+
+		++ia;
+		++ib;
+	}
+
+	// Compare total flow rates; a missing flow rate specification is treated conservatively
+	const unsigned int nRatesA = _flowRates.sliceSize(switchA);
+	const unsigned int nRatesB = _flowRates.sliceSize(switchB);
+	if ((nRatesA == 0) || (nRatesB == 0))
+		return (nRatesA != nRatesB);
+
+	double totalInA, totalOutA, totalInB, totalOutB;
+	totalUnitFlows(connA, nA, _flowRates[switchA], unit, totalInA, totalOutA);
+	totalUnitFlows(connB, nB, _flowRates[switchB], unit, totalInB, totalOutB);
+	return (totalInA != totalInB) || (totalOutA != totalOutB);
+}
+
+/**
+ * @brief Determines which units require consistent initialization at a section transition
+ * @details A discontinuous section transition only perturbs the units whose inlet actually
+ *          changes: system sources whose profile jumps at the boundary, units whose incoming
+ *          connections or flow rates change with a valve switch, and all units downstream of
+ *          those in the connection graph. The states of all other units remain consistent and
+ *          their nonlinear algebraic equation solve is skipped. If the discontinuity cannot be
+ *          attributed to inlets or valve switching (e.g., it stems from section dependent
+ *          parameters or external functions), all units are conservatively initialized.
+ * @param [in] t Time point of the section transition
+ * @param [in] secIdx Index of the new section that is about to be integrated
+ */
+void ModelSystem::updateConsistentInitAffectedUnits(double t, unsigned int secIdx)
+{
+	_initAffected.assign(_models.size(), 1);
+
+	// At the very beginning or without connectivity and continuity information everything is initialized
+	if ((secIdx == 0) || _switchSectionIndex.empty() || _secContinuity.empty())
+		return;
+
+	std::fill(_initAffected.begin(), _initAffected.end(), 0);
+
+	// System sources whose outlet jumps at the boundary; a set continuity flag guarantees
+	// that all inlet profiles are smooth across this transition
+	const bool smoothEntry = (secIdx - 1 < _secContinuity.size()) && _secContinuity[secIdx - 1];
+	if (!smoothEntry)
+	{
+		for (unsigned int i = 0; i < _models.size(); ++i)
+		{
+			if (!_models[i]->hasInlet() && _models[i]->discontinuousOutputTransition(t, secIdx))
+				_initAffected[i] = 1;
+		}
+	}
+
+	// Units whose incoming connections or flow rates changed with a valve switch in this section
+	if ((_lastSwitchSec == secIdx) && (_prevSwitchIndex != _curSwitchIndex))
+	{
+		for (unsigned int i = 0; i < _models.size(); ++i)
+		{
+			if (!_initAffected[i] && inletConfigurationChanged(i, _prevSwitchIndex, _curSwitchIndex))
+				_initAffected[i] = 1;
+		}
+	}
+
+	// Propagate downstream over the current connection graph: a perturbed outlet perturbs
+	// the inlet of every connected unit
+	int const* const conn = _connections[_curSwitchIndex];
+	const unsigned int nRows = _connections.sliceSize(_curSwitchIndex) / 4;
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (unsigned int j = 0; j < nRows; ++j)
+		{
+			if (_initAffected[conn[4 * j]] && !_initAffected[conn[4 * j + 1]])
+			{
+				_initAffected[conn[4 * j + 1]] = 1;
+				changed = true;
+			}
+		}
+	}
+
+	// No perturbed unit found although the transition is discontinuous: the cause is not
+	// visible in inlets or connections, fall back to initializing everything
+	if (std::none_of(_initAffected.begin(), _initAffected.end(), [](char c) { return c != 0; }))
+		std::fill(_initAffected.begin(), _initAffected.end(), 1);
+
+	LOG(Debug) << "Consistent init of " << std::count(_initAffected.begin(), _initAffected.end(), 1)
+		<< " of " << _models.size() << " units at transition into section " << secIdx;
+}
+
 template <typename tag_t>
 void ModelSystem::consistentInitialConditionAlgorithm(double t, unsigned int secIdx, double timeFactor, double* const vecStateY, double* const vecStateYdot,
 	active* const adRes, active* const adY, unsigned int adDirOffset, double errorTol)
 {
 	BENCH_SCOPE(_timerConsistentInit);
 
+	// Determine which units are actually perturbed by this transition; only those need
+	// their algebraic state variables recomputed
+	updateConsistentInitAffectedUnits(t, secIdx);
+
 	// Phase 1: Compute algebraic state variables
 
 	// Consistent initial state for unit operations that only have outlets (system input, Inlet unit operation)
@@ -1684,11 +2418,12 @@ void ModelSystem::consistentInitialConditionAlgorithm(double t, unsigned int sec
 	solveCouplingDOF(vecStateY);
 
 	// Consistent initial state for all other unit operations (unit operations that have inlets)
+	// Units that are not perturbed by this transition are still consistent and skipped
 	for (unsigned int i = 0; i < _models.size(); ++i)
 	{
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
-		if (m->hasInlet())
+		if (m->hasInlet() && _initAffected[i])
 		{
 			active* const localAdRes = (adRes) ? (adRes + offset) : nullptr;
 			active* const localAdY = (adY) ? (adY + offset) : nullptr;
@@ -2097,10 +2832,10 @@ void ModelSystem::genJacobian(unsigned int nSens, const active& t, unsigned int
 		// clear jacobian
 
 		// -h/2
-		residualSensFwd(nSens, t, secIdx, timeFactor, y, yDot, res, CySmh, CySdotmh, resSmh, &adResmh[0], &tmp1mh[0], &tmp2mh[0], &tmp3mh[0]);
+		residualSensFwd(nSens, t, secIdx, timeFactor, y, yDot, res, CySmh, CySdotmh, resSmh, &adResmh[0], nullptr, &tmp1mh[0], &tmp2mh[0], &tmp3mh[0]);
 
 		// +h/2
-		residualSensFwd(nSens, t, secIdx, timeFactor, y, yDot, res, CySph, CySdotph, resSph, &adResph[0], &tmp1ph[0], &tmp2ph[0], &tmp3ph[0]);
+		residualSensFwd(nSens, t, secIdx, timeFactor, y, yDot, res, CySph, CySdotph, resSph, &adResph[0], nullptr, &tmp1ph[0], &tmp2ph[0], &tmp3ph[0]);
 
 		for (unsigned int sens = 0; sens < nSens; ++sens)
 		{
@@ -2156,10 +2891,10 @@ void ModelSystem::genJacobian(unsigned int nSens, const active& t, unsigned int
 		// clear jacobian
 
 		// -h/2
-		residualSensFwd(nSens, t, secIdx, timeFactor, y, yDot, res, CySmh, CySdotmh, resSmh, &adResmh[0], &tmp1mh[0], &tmp2mh[0], &tmp3mh[0]);
+		residualSensFwd(nSens, t, secIdx, timeFactor, y, yDot, res, CySmh, CySdotmh, resSmh, &adResmh[0], nullptr, &tmp1mh[0], &tmp2mh[0], &tmp3mh[0]);
 
 		// +h/2
-		residualSensFwd(nSens, t, secIdx, timeFactor, y, yDot, res, CySph, CySdotph, resSph, &adResph[0], &tmp1ph[0], &tmp2ph[0], &tmp3ph[0]);
+		residualSensFwd(nSens, t, secIdx, timeFactor, y, yDot, res, CySph, CySdotph, resSph, &adResph[0], nullptr, &tmp1ph[0], &tmp2ph[0], &tmp3ph[0]);
 
 		for (unsigned int sens = 0; sens < nSens; ++sens)
 		{
@@ -2202,17 +2937,29 @@ int ModelSystem::linearSolve(double t, double timeFactor, double alpha, double o
 	{
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
+#ifdef CADET_SELF_PROFILER
+		const profiler::ScopedPhase profPhase(_profilerLabels[i].c_str());
+#endif
 		_errorIndicator[i] = m->linearSolve(t, timeFactor, alpha, outerTol, rhs + offset, weight + offset, y + offset, yDot + offset, res + offset);
 	} CADET_PARFOR_END;
 
 	// Solve last row of L with backwards substitution: y_f = b_f - \sum_{i=0}^{N_z} J_{f,i} y_i
-	// Note that we cannot easily parallelize this loop since the results of the sparse
-	// matrix-vector multiplications are added in-place to rhs. We would need one copy of rhs
-	// for each thread and later fuse them together (reduction statement).
-	for (unsigned int i = 0; i < _models.size(); ++i)
+	// The sparse matrix-vector multiplications are added in-place to rhs, so units can only
+	// run concurrently if their J_{f,i} blocks write disjoint coupling DOFs. The conflict-free
+	// groups are derived from the connection matrix in computeCouplingGroups(); units feeding
+	// the same inlet (mixing) end up in different groups and are serialized between groups.
+	for (const std::vector<unsigned int>& group : _couplingGroups)
 	{
-		const unsigned int offset = _dofOffset[i];
-		_jacFN[i].multiplySubtract(rhs + offset, rhs + finalOffset);
+#ifdef CADET_PARALLELIZE
+		tbb::parallel_for(size_t(0), group.size(), [=, &group](size_t idx)
+#else
+		for (unsigned int idx = 0; idx < group.size(); ++idx)
+#endif
+		{
+			const unsigned int i = group[idx];
+			const unsigned int offset = _dofOffset[i];
+			_jacFN[i].multiplySubtract(rhs + offset, rhs + finalOffset);
+		} CADET_PARFOR_END;
 	}
 
 
@@ -2246,10 +2993,23 @@ int ModelSystem::linearSolve(double t, double timeFactor, double alpha, double o
 	const int curError = totalErrorIndicatorFromLocal(_errorIndicator);
 	std::fill(_errorIndicator.begin(), _errorIndicator.end(), 0);
 
-	const int gmresResult = _gmres.solve(tolerance, weight + finalOffset, _tempState + finalOffset, rhs + finalOffset);
+	int schurResult = 0;
+	if (_directSchurSolver)
+	{
+		// The explicitly assembled Schur complement is reused until the unit operation
+		// Jacobians, the time discretization factor alpha, or the connectivity change
+		if (_schurAssemblyDirty || (alpha != _schurAssembledAlpha))
+			schurResult = assembleSchurComplement(t, timeFactor, alpha, outerTol, weight, y, yDot, res);
+
+		// A single direct triangular solve replaces the GMRES sweeps
+		if (!_schurMatrix.solve(rhs + finalOffset))
+			schurResult = updateErrorIndicator(schurResult, -1);
+	}
+	else
+		schurResult = _gmres.solve(tolerance, weight + finalOffset, _tempState + finalOffset, rhs + finalOffset);
 
 	// Set last cumulative error to all elements to restore state (in the end only total error matters)
-	std::fill(_errorIndicator.begin(), _errorIndicator.end(), updateErrorIndicator(curError, gmresResult));
+	std::fill(_errorIndicator.begin(), _errorIndicator.end(), updateErrorIndicator(curError, schurResult));
 
 	// Reset temporary memory
 	std::fill_n(_tempState, finalOffset, 0.0);
@@ -2285,6 +3045,44 @@ int ModelSystem::linearSolve(double t, double timeFactor, double alpha, double o
 	return totalErrorIndicatorFromLocal(_errorIndicator);
 }
 
+/**
+ * @brief Assembles the Schur complement @f$ S @f$ explicitly and factorizes it
+ * @details Builds @f$ S = I - \sum_{p=0}^{N_z}{J_{f,p} \, J_p^{-1} \, J_{p,f}} @f$ column by column
+ *          by applying schurComplementMatrixVector() to unit vectors. Each column costs one linear
+ *          solve on the unit operations fed by the corresponding coupling DOF; the cost is amortized
+ *          since the factorized @f$ S @f$ is reused by linearSolve() until the unit operation
+ *          Jacobians, the time discretization factor @f$ \alpha @f$, or the connectivity change.
+ *          Afterwards, each outer solve applies every unit operation solver exactly once instead of
+ *          once per GMRES sweep.
+ * @return @c 0 if successful, any other value in case of failure
+ */
+int ModelSystem::assembleSchurComplement(double t, double timeFactor, double alpha, double outerTol, double const* const weight,
+	double const* const y, double const* const yDot, double const* const res)
+{
+	const unsigned int nCoupling = numCouplingDOF();
+	std::vector<double> unitVec(nCoupling, 0.0);
+	std::vector<double> col(nCoupling, 0.0);
+
+	int result = 0;
+	for (unsigned int k = 0; k < nCoupling; ++k)
+	{
+		unitVec[k] = 1.0;
+		const int matVec = schurComplementMatrixVector(unitVec.data(), col.data(), t, timeFactor, alpha, outerTol, weight, y, yDot, res);
+		result = updateErrorIndicator(result, matVec);
+		unitVec[k] = 0.0;
+
+		for (unsigned int r = 0; r < nCoupling; ++r)
+			_schurMatrix.native(r, k) = col[r];
+	}
+
+	if (!_schurMatrix.factorize())
+		result = updateErrorIndicator(result, -1);
+
+	_schurAssemblyDirty = false;
+	_schurAssembledAlpha = alpha;
+	return result;
+}
+
 /**
 * @brief Performs the matrix-vector product @f$ z = Sx @f$ with the Schur-complement @f$ S @f$ from the Jacobian
 * @details The Schur-complement @f$ S @f$ is given by
@@ -2343,10 +3141,19 @@ int ModelSystem::schurComplementMatrixVector(double const* x, double* z, double
 
 void ModelSystem::setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections)
 {
+	// Keep the continuity flags for the discontinuity propagation analysis of
+	// consistent initialization
+	if (nSections > 0)
+		_secContinuity.assign(secContinuity, secContinuity + nSections - 1);
+	else
+		_secContinuity.clear();
+
 	for (IUnitOperation* m : _models)
 		m->setSectionTimes(secTimes, secContinuity, nSections);	
 
-	for (IExternalFunction* extFun : _extFunctions)
+	// The wrappers drop their memoized values and forward the notification to the
+	// underlying external functions
+	for (CachedExternalFunction* extFun : _extFunCache)
 		extFun->setSectionTimes(secTimes, secContinuity, nSections);
 }
 
@@ -2363,18 +3170,57 @@ void ModelSystem::setSectionTimes(double const* secTimes, bool const* secContinu
  */
 std::vector<double> ModelSystem::calculateErrorTolsForAdditionalDofs(double const* errorTol, unsigned int errorTolLength)
 {
-	// Return empty vector since we don't have coupling DOFs, yet
-	return std::vector<double>(0, 0.0);
+	// Coupling DOFs are concentrations exchanged between unit operations; assign them
+	// the most stringent tolerance of the user specification
+	const double minTol = *std::min_element(errorTol, errorTol + errorTolLength);
+	return std::vector<double>(numCouplingDOF(), minTol);
 }
 
 void ModelSystem::expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut)
 {
-	// TODO: Adjust indexing / offset of vectors
-	// TODO: Handle connection of unit operations
-	for (IUnitOperation* m : _models)
+	for (unsigned int i = 0; i < _models.size(); ++i)
+		_models[i]->expandErrorTol(errorSpec, errorSpecSize, expandOut + _dofOffset[i]);
+
+	// Use the most stringent tolerance of the specification for the coupling DOFs
+	const double minTol = *std::min_element(errorSpec, errorSpec + errorSpecSize);
+	std::fill(expandOut + _dofOffset.back(), expandOut + numDofs(), minTol);
+}
+
+void ModelSystem::relaxTransitionErrorTol(double const* baseTol, double relaxFactor, double* relaxedTol)
+{
+	for (unsigned int i = 0; i < _models.size(); ++i)
+		_models[i]->relaxTransitionErrorTol(baseTol + _dofOffset[i], relaxFactor, relaxedTol + _dofOffset[i]);
+
+	// Coupling DOFs propagate the disturbance between the units and keep their base tolerance
+	std::copy(baseTol + _dofOffset.back(), baseTol + numDofs(), relaxedTol + _dofOffset.back());
+}
+
+bool ModelSystem::hasMultirateErrorTol() const CADET_NOEXCEPT
+{
+	for (unsigned int i = 0; i < _models.size(); ++i)
 	{
-		m->expandErrorTol(errorSpec, errorSpecSize, expandOut);
+		if (_models[i]->hasMultirateErrorTol())
+			return true;
 	}
+	return false;
+}
+
+void ModelSystem::applyMultirateErrorTol(double* absTol)
+{
+	for (unsigned int i = 0; i < _models.size(); ++i)
+		_models[i]->applyMultirateErrorTol(absTol + _dofOffset[i]);
+
+	// Coupling DOFs connect the bulk phases of the units and keep their tolerances
+}
+
+void ModelSystem::applyStateClassErrorTol(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor, double* absTol)
+{
+	for (unsigned int i = 0; i < _models.size(); ++i)
+		_models[i]->applyStateClassErrorTol(colLiquidFactor, parLiquidFactor, boundFactor, fluxFactor, absTol + _dofOffset[i]);
+
+	// Coupling DOFs carry bulk concentrations between the units, so they follow the column liquid class
+	for (unsigned int i = _dofOffset.back(); i < numDofs(); ++i)
+		absTol[i] *= colLiquidFactor;
 }
 
 }  // namespace model
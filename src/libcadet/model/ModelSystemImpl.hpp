@@ -26,6 +26,7 @@
 
 #include <vector>
 #include <map>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -34,6 +35,7 @@
 #endif
 
 #include "linalg/SparseMatrix.hpp"
+#include "linalg/DenseMatrix.hpp"
 #include "linalg/Gmres.hpp"
 
 #include "Benchmark.hpp"
@@ -44,6 +46,8 @@ namespace cadet
 namespace model
 {
 
+class CachedExternalFunction;
+
 /**
  * @brief Defines a system of unit operations models
  * @details
@@ -80,6 +84,7 @@ public:
 	virtual bool configure(IParameterProvider& paramProvider, IConfigHelper& helper);
 	virtual bool reconfigure(IParameterProvider& paramProvider);
 	virtual void notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset);
+	virtual bool exactSectionTransition(double t, unsigned int secIdx);
 	virtual bool reconfigureModel(IParameterProvider& paramProvider, unsigned int unitOpIdx);
 
 	virtual bool hasParameter(const ParameterId& pId) const;
@@ -105,7 +110,7 @@ public:
 	virtual int residualSensFwd(unsigned int nSens, const active& t, unsigned int secIdx, const active& timeFactor,
 		double const* const y, double const* const yDot, double const* const res,
 		const std::vector<const double*>& yS, const std::vector<const double*>& ySdot, const std::vector<double*>& resS,
-		active* const adRes, double* const tmp1, double* const tmp2, double* const tmp3);
+		active* const adRes, unsigned char const* sensMask, double* const tmp1, double* const tmp2, double* const tmp3);
 
 	virtual int residualSensFwdWithJacobian(unsigned int nSens, const active& t, unsigned int secIdx, const active& timeFactor,
 		double const* const y, double const* const yDot, double const* const res,
@@ -120,6 +125,14 @@ public:
 	virtual int linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
 		double const* const y, double const* const yDot, double const* const res);
 
+	virtual unsigned int numGmresIterations() const CADET_NOEXCEPT
+	{
+		unsigned int iters = _gmres.totalNumIterations();
+		for (IUnitOperation* m : _models)
+			iters += m->numGmresIterations();
+		return iters;
+	}
+
 	virtual void prepareADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const;
 
 	virtual void applyInitialCondition(double* const vecStateY, double* const vecStateYdot);
@@ -148,8 +161,15 @@ public:
 		double const* const y, double const* const yDot, double const* const res) const;
 
 	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut);
+	virtual void relaxTransitionErrorTol(double const* baseTol, double relaxFactor, double* relaxedTol);
+	virtual bool hasMultirateErrorTol() const CADET_NOEXCEPT;
+	virtual void applyMultirateErrorTol(double* absTol);
+	virtual void applyStateClassErrorTol(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor, double* absTol);
 	virtual std::vector<double> calculateErrorTolsForAdditionalDofs(double const* errorTol, unsigned int errorTolLength);
 
+	virtual std::size_t memoryFootprint() const CADET_NOEXCEPT;
+	virtual CostEstimate costEstimate(unsigned int numSensParams) const CADET_NOEXCEPT;
+
 #ifdef CADET_BENCHMARK_MODE
 	virtual std::vector<double> benchmarkTimings() const
 	{
@@ -191,17 +211,58 @@ protected:
 		multiplyWithJacobian(yS, 1.0, 0.0, ret);
 	}
 
+	void multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret);
+	inline void multiplyWithJacobianTranspose(double const* yS, double* ret)
+	{
+		multiplyWithJacobianTranspose(yS, 1.0, 0.0, ret);
+	}
+
 	int dResDpFwdWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot, active* const adRes, active* const adY, unsigned int adDirOffset);
 
+	/**
+	 * @brief Compiled coupling structures of one valve configuration
+	 * @details Holds everything assembleValveSwitch() derives from the connection list of a
+	 *          valve switch so that a later transition to the same configuration only has to
+	 *          copy the precompiled state instead of re-deriving it.
+	 */
+	struct CompiledValveConfig
+	{
+		bool valid; //!< Determines whether this entry holds a compiled configuration
+		std::vector<linalg::SparseMatrix<double>> jacNF; //!< Compiled NF blocks per unit operation
+		std::vector<linalg::SparseMatrix<double>> jacFN; //!< Compiled FN blocks per unit operation
+		std::vector<linalg::SparseMatrix<active>> jacActiveFN; //!< Compiled FN blocks with parameter sensitivities
+		std::vector<active> totalInletFlow; //!< Total flow rate into each inlet
+		std::vector<std::vector<unsigned int>> couplingGroups; //!< Conflict-free unit operation groups
+		std::vector<unsigned int> routeInletDof; //!< Compiled routing plan (see ModelSystem members)
+		std::vector<unsigned int> routeInletCoupling;
+		std::vector<unsigned int> routeOutletDof;
+		std::vector<unsigned int> routeOutletCoupling;
+		std::vector<double> routeOutletFactor;
+		std::vector<active> routeOutletFactorActive;
+
+		CompiledValveConfig() : valid(false) { }
+	};
+
 	void rebuildInternalDataStructures();
+	void updateExternalFunctionViews();
 	void allocateSuperStructMatrices();
 	void assembleSuperStructMatrices(unsigned int secIdx);
+	void assembleValveSwitch(unsigned int switchIdx);
+	void cacheValveSwitch(CompiledValveConfig& cfg);
+	void applyValveSwitch(const CompiledValveConfig& cfg);
+	void computeCouplingGroups();
+	void compileRoutingPlan();
+	int assembleSchurComplement(double t, double timeFactor, double alpha, double outerTol, double const* const weight,
+		double const* const y, double const* const yDot, double const* const res);
 
 	template <typename ParamType>
 	bool setParameterImpl(const ParameterId& pId, const ParamType value);
 
 	void checkConnectionList(const std::vector<double>& conn, std::vector<int>& connOnly, std::vector<double>& totalOutflow, unsigned int idxSwitch) const;
 
+	void updateConsistentInitAffectedUnits(double t, unsigned int secIdx);
+	bool inletConfigurationChanged(unsigned int unit, unsigned int switchA, unsigned int switchB) const;
+
 	template <typename tag_t>
 	void consistentInitialConditionAlgorithm(double t, unsigned int secIdx, double timeFactor, double* const vecStateY, double* const vecStateYdot, active* const adRes, active* const adY, unsigned int adDirOffset, double errorTol);
 
@@ -213,7 +274,7 @@ protected:
 	int residualSensFwdWithJacobianAlgorithm(unsigned int nSens, const active& t, unsigned int secIdx, const active& timeFactor,
 		double const* const y, double const* const yDot, double const* const res,
 		const std::vector<const double*>& yS, const std::vector<const double*>& ySdot, const std::vector<double*>& resS,
-		active* const adRes, active* const adY, unsigned int adDirOffset, double* const tmp1, double* const tmp2, double* const tmp3);
+		active* const adRes, active* const adY, unsigned int adDirOffset, unsigned char const* sensMask, double* const tmp1, double* const tmp2, double* const tmp3);
 
 	/**
 	 * @brief Returns the number of coupling DOFs
@@ -224,18 +285,43 @@ protected:
 
 	std::vector<IUnitOperation*> _models; //!< Unit operation models
 	std::vector<IExternalFunction*> _extFunctions; //!< External functions
+	std::vector<CachedExternalFunction*> _extFunCache; //!< Memoizing wrappers around the external functions (one per non-null entry)
+	std::vector<IExternalFunction*> _extFunView; //!< Wrapped external function pointers handed to the unit operation models
 	linalg::SparseMatrix<double>* _jacNF; //!< Jacobian block connecting coupling DOF to inlets
 	linalg::SparseMatrix<double>* _jacFN; //!< Jacobian block connecting outlets to coupling DOF
 	linalg::SparseMatrix<active>* _jacActiveFN; //!< Jacobian block connecting outlets to coupling DOF
 	std::vector<unsigned int> _dofOffset; //!< Vector with DOF offsets for each unit operation
 	std::vector<unsigned int> _dofs; //!< Vector with DOF for each unit
+	std::vector<unsigned int> _modelExecOrder; //!< Unit operation indices ordered by descending DOF count for parallel dispatch, pure boundary units last
+	unsigned int _numComputeUnits; //!< Number of leading entries in @c _modelExecOrder that are not pure boundary units
+	std::vector<std::vector<unsigned int>> _couplingGroups; //!< Groups of unit operations whose @f$ J_{f,i} @f$ blocks write disjoint coupling DOFs
+
+	// Compiled routing plan of the current valve configuration: flat gather / scatter
+	// arrays over global DOF indices that replace the per unit sparse matrix traversal
+	// in the residual (the matrices are kept for the Jacobian application)
+	std::vector<unsigned int> _routeInletDof; //!< Global DOF indices of inlet entries fed by coupling DOFs (factor is always @f$ -1 @f$)
+	std::vector<unsigned int> _routeInletCoupling; //!< Coupling DOF index feeding each inlet entry
+	std::vector<unsigned int> _routeOutletDof; //!< Global DOF indices of outlet entries feeding coupling DOFs
+	std::vector<unsigned int> _routeOutletCoupling; //!< Coupling DOF index fed by each outlet entry
+	std::vector<double> _routeOutletFactor; //!< Flow rate factor of each outlet entry
+	std::vector<active> _routeOutletFactorActive; //!< Flow rate factor of each outlet entry with parameter sensitivities
 	util::SlicedVector<int> _connections; //!< Vector of connection lists for each section
 	util::SlicedVector<active> _flowRates; //!< Vector of connection flow rates for each section
 	std::vector<unsigned int> _switchSectionIndex; //!< Holds indices of sections where valves are switched
-	unsigned int _curSwitchIndex; //!< Current index in _switchSectionIndex list 
+	unsigned int _curSwitchIndex; //!< Current index in _switchSectionIndex list
+	std::vector<CompiledValveConfig> _switchCache; //!< Precompiled coupling structures per valve switch
+
+	unsigned int _prevSwitchIndex; //!< Valve configuration that was active before the last switch
+	unsigned int _lastSwitchSec; //!< Section index at which the last valve configuration change happened
+	std::vector<bool> _secContinuity; //!< Continuity flags of the section transitions (from setSectionTimes())
+	std::vector<char> _initAffected; //!< Units requiring consistent initialization at the current section transition
 
 	mutable std::vector<int> _errorIndicator; //!< Storage for return value of unit operation function calls
 
+#ifdef CADET_SELF_PROFILER
+	std::vector<std::string> _profilerLabels; //!< Stable per unit operation labels (e.g., "GENERAL_RATE_MODEL#0") for the phase stack of the self-profiler
+#endif
+
 	double* _tempState; //!< Temporary storage for the state vector
 	std::vector<active> _totalInletFlow; //!< Total flow rate into each inlet at the current section
 
@@ -243,6 +329,11 @@ protected:
 	std::vector<std::vector<const double*>> _yStempDot;  //!< Needed to store offsets for unit operations
 	std::vector<std::vector<double*>> _resSTemp;  //!< Needed to store offsets for unit operations
 
+	std::vector<const double*> _ySPacked; //!< Sensitivity state vectors of the active directions when some directions are masked out
+	std::vector<const double*> _ySdotPacked; //!< Sensitivity time derivative vectors of the active directions when some directions are masked out
+	std::vector<double*> _resSPacked; //!< Sensitivity residual vectors of the active directions when some directions are masked out
+	std::vector<unsigned int> _sensDirMap; //!< Maps a packed sensitivity index to its AD direction
+
 	std::map<std::pair<unsigned int, unsigned int>, unsigned int> _couplingIdxMap; //!< Maps (UnitOpIdx, CompIdx) to local coupling DOF index
 
 	std::unordered_map<ParameterId, active*> _parameters; //!< Provides access to all parameters
@@ -251,6 +342,11 @@ protected:
 	linalg::Gmres _gmres; //!< GMRES algorithm for the Schur-complement in linearSolve()
 	double _schurSafety; //!< Safety factor for Schur-complement solution
 
+	linalg::DenseMatrix _schurMatrix; //!< Explicitly assembled Schur complement for the direct coupling solver
+	bool _directSchurSolver; //!< Determines whether the Schur complement is solved directly instead of iteratively by GMRES
+	bool _schurAssemblyDirty; //!< Determines whether the assembled Schur complement factorization is out of date
+	double _schurAssembledAlpha; //!< Time discretization factor @f$ \alpha @f$ the Schur complement was assembled with
+
 	std::vector<unsigned int> _inOutModels; //!< Indices of unit operation models in _models that have inlet and outlet
 
 #ifdef CADET_PARALLELIZE
@@ -13,6 +13,7 @@
 #include "model/OutletModel.hpp"
 #include "ParamReaderHelper.hpp"
 #include "cadet/Exceptions.hpp"
+#include "cadet/HashUtil.hpp"
 #include "cadet/SolutionRecorder.hpp"
 
 #include "ConfigurationHelper.hpp"
@@ -62,6 +63,14 @@ bool OutletModel::usesAD() const CADET_NOEXCEPT
 	return false;
 }
 
+uint64_t OutletModel::structureHash(IParameterProvider& paramProvider)
+{
+	// The outlet has no parameters, its structure is fully determined by the number of components
+	uint64_t h = 0;
+	hash_combine(h, paramProvider.getInt("NCOMP"));
+	return h;
+}
+
 bool OutletModel::configure(IParameterProvider& paramProvider, IConfigHelper& helper)
 {
 	_nComp = paramProvider.getInt("NCOMP");
@@ -172,7 +181,7 @@ int OutletModel::residualSensFwdAdOnly(const active& t, unsigned int secIdx, con
 }
 
 int OutletModel::residualSensFwdCombine(const active& timeFactor, const std::vector<const double*>& yS, const std::vector<const double*>& ySdot,
-	const std::vector<double*>& resS, active const* adRes, double* const tmp1, double* const tmp2, double* const tmp3)
+	const std::vector<double*>& resS, active const* adRes, unsigned int const* dirMap, double* const tmp1, double* const tmp2, double* const tmp3)
 {
 	// Directional derivative (dF / dy) * s does nothing since dF / dy = I (identity)
 	for (unsigned int param = 0; param < resS.size(); ++param)
@@ -214,6 +223,15 @@ void OutletModel::multiplyWithJacobian(double const* yS, double alpha, double be
 	}
 }
 
+void OutletModel::multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret)
+{
+	// dF / dy = I (identity matrix), which is its own transpose
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		ret[i] = alpha * yS[i] + beta * ret[i];
+	}
+}
+
 void OutletModel::multiplyWithDerivativeJacobian(double const* sDot, double* ret, double timeFactor)
 {
 	std::fill_n(ret, numDofs(), 0.0);
@@ -60,11 +60,14 @@ public:
 	virtual bool canAccumulate() const CADET_NOEXCEPT { return true; }
 
 	static const char* identifier() { return "OUTLET"; }
+	static uint64_t structureHash(IParameterProvider& paramProvider);
 	virtual const char* unitOperationName() const CADET_NOEXCEPT { return "OUTLET"; }
 
 	virtual bool configure(IParameterProvider& paramProvider, IConfigHelper& helper);
 	virtual bool reconfigure(IParameterProvider& paramProvider);
 	virtual void notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset);
+	virtual bool discontinuousOutputTransition(double t, unsigned int secIdx) { return false; }
+	virtual bool exactDiscontinuousOutputTransition(double t, unsigned int secIdx) { return true; }
 	
 	virtual std::unordered_map<ParameterId, double> getAllParameterValues() const;
 	virtual bool hasParameter(const ParameterId& pId) const;
@@ -80,6 +83,15 @@ public:
 
 	virtual void useAnalyticJacobian(const bool analyticJac);
 
+	virtual std::size_t memoryFootprint() const CADET_NOEXCEPT { return 0; }
+
+	virtual CostEstimate costEstimate(unsigned int numSensParams) const CADET_NOEXCEPT
+	{
+		// Identity equations, a copy per component
+		const CostEstimate ce = { 2.0 * _nComp * (1.0 + numSensParams), 2.0 * sizeof(double) * _nComp * (1.0 + numSensParams), memoryFootprint() };
+		return ce;
+	}
+
 	virtual void reportSolution(ISolutionRecorder& recorder, double const* const solution) const;
 	virtual void reportSolutionStructure(ISolutionRecorder& recorder) const;
 
@@ -90,7 +102,7 @@ public:
 		double const* const y, double const* const yDot, active* const adRes);
 
 	virtual int residualSensFwdCombine(const active& timeFactor, const std::vector<const double*>& yS, const std::vector<const double*>& ySdot,
-		const std::vector<double*>& resS, active const* adRes, double* const tmp1, double* const tmp2, double* const tmp3);
+		const std::vector<double*>& resS, active const* adRes, unsigned int const* dirMap, double* const tmp1, double* const tmp2, double* const tmp3);
 
 	virtual int residualSensFwdWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot, active* const adRes, active* const adY, unsigned int adDirOffset);
 
@@ -98,7 +110,10 @@ public:
 	virtual int linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
 		double const* const y, double const* const yDot, double const* const res) {	return 0; }
 
+	virtual unsigned int numGmresIterations() const CADET_NOEXCEPT { return 0; }
+
 	virtual void prepareADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const;
+	virtual uint64_t adSeedStructureHash() const CADET_NOEXCEPT { return 0; }
 
 	virtual void applyInitialCondition(double* const vecStateY, double* const vecStateYdot);
 	virtual void applyInitialCondition(IParameterProvider& paramProvider, double* const vecStateY, double* const vecStateYdot);
@@ -118,10 +133,12 @@ public:
 	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { }
 
 	virtual void multiplyWithJacobian(double const* yS, double alpha, double beta, double* ret);
+	virtual void multiplyWithJacobianTranspose(double const* yS, double alpha, double beta, double* ret);
 	virtual void multiplyWithDerivativeJacobian(double const* sDot, double* ret, double timeFactor);
 
 	virtual bool hasInlet() const CADET_NOEXCEPT { return true; }
 	virtual bool hasOutlet() const CADET_NOEXCEPT { return false; }
+	virtual bool isPureBoundaryUnit() const CADET_NOEXCEPT { return true; }
 
 	virtual unsigned int localOutletComponentIndex() const CADET_NOEXCEPT { return 0; }
 	virtual unsigned int localOutletComponentStride() const CADET_NOEXCEPT { return 0; }
@@ -130,7 +147,28 @@ public:
 
 	virtual void setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections);
 
-	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut) { }
+	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut)
+	{
+		for (unsigned int i = 0; i < _nComp; ++i)
+			expandOut[i] = errorSpec[i % errorSpecSize];
+	}
+
+	virtual void relaxTransitionErrorTol(double const* baseTol, double relaxFactor, double* relaxedTol)
+	{
+		// The disturbance arrives at the outlet only after passing through the upstream units
+		for (unsigned int i = 0; i < _nComp; ++i)
+			relaxedTol[i] = baseTol[i] * relaxFactor;
+	}
+
+	virtual bool hasMultirateErrorTol() const CADET_NOEXCEPT { return false; }
+	virtual void applyMultirateErrorTol(double* absTol) { }
+
+	virtual void applyStateClassErrorTol(double colLiquidFactor, double parLiquidFactor, double boundFactor, double fluxFactor, double* absTol)
+	{
+		// Outlet DOFs are the observable concentrations and belong to the column liquid class
+		for (unsigned int i = 0; i < _nComp; ++i)
+			absTol[i] *= colLiquidFactor;
+	}
 
 #ifdef CADET_BENCHMARK_MODE
 	virtual std::vector<double> benchmarkTimings() const { return std::vector<double>(0); }
@@ -0,0 +1,151 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "model/PodBasis.hpp"
+#include "LapackInterface.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cadet
+{
+
+namespace model
+{
+
+bool PodBasis::build(double const* snapshots, unsigned int nDofs, unsigned int nSnapshots, double energy, unsigned int maxModes)
+{
+	_modes.clear();
+	_singularValues.clear();
+	_nDofs = 0;
+	_numModes = 0;
+	_capturedEnergy = 0.0;
+
+	if (!snapshots || (nDofs == 0) || (nSnapshots == 0))
+		return false;
+
+	lapackInt_t n = static_cast<lapackInt_t>(nDofs);
+	lapackInt_t m = static_cast<lapackInt_t>(nSnapshots);
+
+	// Method of snapshots: the Gram matrix G = S^T S is only nSnapshots x nSnapshots,
+	// and the dominant left singular vectors of S are recovered from its eigenpairs
+	// as v_i = S u_i / sqrt(lambda_i)
+	std::vector<double> gram(nSnapshots * static_cast<std::size_t>(nSnapshots), 0.0);
+
+	char trans = 'T';
+	double one = 1.0;
+	double zero = 0.0;
+	lapackInt_t inc = 1;
+	double* const snap = const_cast<double*>(snapshots);
+	for (unsigned int j = 0; j < nSnapshots; ++j)
+		LapackMultiplyDense(&trans, &n, &m, &one, snap, &n, snap + j * static_cast<std::size_t>(nDofs), &inc, &zero, gram.data() + j * static_cast<std::size_t>(nSnapshots), &inc);
+
+	// Symmetric eigendecomposition with workspace query; eigenvalues are returned in
+	// ascending order and the eigenvectors overwrite the Gram matrix
+	char jobz = 'V';
+	char uplo = 'L';
+	std::vector<double> eigVals(nSnapshots, 0.0);
+	lapackInt_t info = 0;
+	lapackInt_t lwork = -1;
+	double workSize = 0.0;
+
+	LapackEigSymmetric(&jobz, &uplo, &m, gram.data(), &m, eigVals.data(), &workSize, &lwork, &info);
+	if (info != 0)
+		return false;
+
+	lwork = static_cast<lapackInt_t>(workSize);
+	std::vector<double> work(static_cast<std::size_t>(lwork), 0.0);
+	LapackEigSymmetric(&jobz, &uplo, &m, gram.data(), &m, eigVals.data(), work.data(), &lwork, &info);
+	if (info != 0)
+		return false;
+
+	// Total snapshot energy; tiny negative eigenvalues from roundoff are clamped
+	double totalEnergy = 0.0;
+	for (unsigned int i = 0; i < nSnapshots; ++i)
+		totalEnergy += std::max(eigVals[i], 0.0);
+
+	if (totalEnergy <= 0.0)
+		return false;
+
+	// Retain the smallest number of dominant modes reaching the energy target
+	const unsigned int modeBound = (maxModes > 0) ? std::min(maxModes, nSnapshots) : nSnapshots;
+	double captured = 0.0;
+	unsigned int numModes = 0;
+	for (unsigned int i = 0; i < modeBound; ++i)
+	{
+		const double ev = eigVals[nSnapshots - 1 - i];
+		if (ev <= 0.0)
+			break;
+
+		captured += ev;
+		++numModes;
+
+		if (captured >= energy * totalEnergy)
+			break;
+	}
+
+	if (numModes == 0)
+		return false;
+
+	// Lift the eigenvectors of the Gram matrix to state space modes
+	_modes.resize(numModes * static_cast<std::size_t>(nDofs), 0.0);
+	_singularValues.resize(numModes, 0.0);
+
+	char noTrans = 'N';
+	for (unsigned int i = 0; i < numModes; ++i)
+	{
+		const unsigned int eigIdx = nSnapshots - 1 - i;
+		double* const modeOut = _modes.data() + i * static_cast<std::size_t>(nDofs);
+
+		LapackMultiplyDense(&noTrans, &n, &m, &one, snap, &n, gram.data() + eigIdx * static_cast<std::size_t>(nSnapshots), &inc, &zero, modeOut, &inc);
+
+		const double sv = std::sqrt(eigVals[eigIdx]);
+		const double invSv = 1.0 / sv;
+		for (unsigned int k = 0; k < nDofs; ++k)
+			modeOut[k] *= invSv;
+
+		_singularValues[i] = sv;
+	}
+
+	_nDofs = nDofs;
+	_numModes = numModes;
+	_capturedEnergy = captured / totalEnergy;
+	return true;
+}
+
+void PodBasis::project(double const* fullState, double* reduced) const
+{
+	lapackInt_t n = static_cast<lapackInt_t>(_nDofs);
+	lapackInt_t k = static_cast<lapackInt_t>(_numModes);
+
+	char trans = 'T';
+	double one = 1.0;
+	double zero = 0.0;
+	lapackInt_t inc = 1;
+	LapackMultiplyDense(&trans, &n, &k, &one, const_cast<double*>(_modes.data()), &n, const_cast<double*>(fullState), &inc, &zero, reduced, &inc);
+}
+
+void PodBasis::lift(double const* reduced, double* fullState) const
+{
+	lapackInt_t n = static_cast<lapackInt_t>(_nDofs);
+	lapackInt_t k = static_cast<lapackInt_t>(_numModes);
+
+	char noTrans = 'N';
+	double one = 1.0;
+	double zero = 0.0;
+	lapackInt_t inc = 1;
+	LapackMultiplyDense(&noTrans, &n, &k, &one, const_cast<double*>(_modes.data()), &n, const_cast<double*>(reduced), &inc, &zero, fullState, &inc);
+}
+
+} // namespace model
+
+} // namespace cadet
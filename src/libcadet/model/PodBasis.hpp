@@ -0,0 +1,125 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a proper orthogonal decomposition (POD) basis built from solution snapshots.
+ */
+
+#ifndef LIBCADET_PODBASIS_HPP_
+#define LIBCADET_PODBASIS_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "cadet/cadetCompilerInfo.hpp"
+
+namespace cadet
+{
+
+namespace model
+{
+
+/**
+ * @brief Orthonormal basis of a low-dimensional solution subspace computed by POD
+ * @details Offline stage of snapshot-based model order reduction: build() takes solution
+ *          snapshots of a full-order run (e.g., the interior column buffer recorded by
+ *          InternalStorageUnitOpRecorder, which stores one state per time step
+ *          contiguously) and computes the dominant left singular vectors by the method
+ *          of snapshots. Since typically far fewer snapshots than DOFs are recorded,
+ *          the eigenvalue problem is posed on the small snapshot Gram matrix instead
+ *          of the full state space.
+ *
+ *          The basis is truncated by the classic energy criterion: the smallest number
+ *          of modes whose cumulative squared singular values reach the requested
+ *          fraction of the total snapshot energy is retained. project() and lift() map
+ *          between full and reduced space for the online stage.
+ */
+class PodBasis
+{
+public:
+
+	PodBasis() CADET_NOEXCEPT : _nDofs(0), _numModes(0), _capturedEnergy(0.0) { }
+
+	/**
+	 * @brief Builds the basis from the given snapshot matrix
+	 * @details The snapshots are expected contiguously one after another (column-major
+	 *          @p nDofs x @p nSnapshots matrix), which is the layout of the interior
+	 *          solution buffers of the recorder. A previously built basis is replaced.
+	 * @param [in] snapshots Pointer to the first element of the snapshot matrix
+	 * @param [in] nDofs Number of DOFs per snapshot
+	 * @param [in] nSnapshots Number of snapshots
+	 * @param [in] energy Fraction of the total snapshot energy the basis has to capture (e.g., @c 0.9999)
+	 * @param [in] maxModes Upper bound on the number of retained modes (@c 0 disables the bound)
+	 * @return @c true if the basis was built, @c false on invalid input or failed eigendecomposition
+	 */
+	bool build(double const* snapshots, unsigned int nDofs, unsigned int nSnapshots, double energy, unsigned int maxModes);
+
+	/**
+	 * @brief Projects a full-order state onto the reduced space
+	 * @param [in] fullState Array with one value per DOF
+	 * @param [out] reduced Array receiving numModes() reduced coordinates
+	 */
+	void project(double const* fullState, double* reduced) const;
+
+	/**
+	 * @brief Lifts reduced coordinates back to the full-order space
+	 * @param [in] reduced Array with numModes() reduced coordinates
+	 * @param [out] fullState Array receiving one value per DOF
+	 */
+	void lift(double const* reduced, double* fullState) const;
+
+	/**
+	 * @brief Returns the number of retained modes
+	 * @return Number of modes, @c 0 if no basis has been built
+	 */
+	inline unsigned int numModes() const CADET_NOEXCEPT { return _numModes; }
+
+	/**
+	 * @brief Returns the number of DOFs per mode
+	 * @return Number of DOFs
+	 */
+	inline unsigned int numDofs() const CADET_NOEXCEPT { return _nDofs; }
+
+	/**
+	 * @brief Returns a basis vector
+	 * @param [in] idx Index of the mode, ordered by descending singular value
+	 * @return Pointer to the first element of the mode
+	 */
+	inline double const* mode(unsigned int idx) const CADET_NOEXCEPT { return _modes.data() + idx * _nDofs; }
+
+	/**
+	 * @brief Returns the singular values of the retained modes in descending order
+	 * @return Vector with numModes() singular values
+	 */
+	inline const std::vector<double>& singularValues() const CADET_NOEXCEPT { return _singularValues; }
+
+	/**
+	 * @brief Returns the fraction of the total snapshot energy captured by the basis
+	 * @return Captured energy fraction in [0, 1]
+	 */
+	inline double capturedEnergy() const CADET_NOEXCEPT { return _capturedEnergy; }
+
+protected:
+
+	std::vector<double> _modes; //!< Basis vectors stored contiguously (column-major nDofs x numModes matrix)
+	std::vector<double> _singularValues; //!< Singular values of the retained modes in descending order
+	unsigned int _nDofs; //!< Number of DOFs per mode
+	unsigned int _numModes; //!< Number of retained modes
+	double _capturedEnergy; //!< Fraction of the total snapshot energy captured by the basis
+};
+
+} // namespace model
+
+} // namespace cadet
+
+#endif  // LIBCADET_PODBASIS_HPP_
@@ -318,10 +318,10 @@ typedef AntiLangmuirBindingBase<ExtAntiLangmuirParamHandler> ExternalAntiLangmui
 
 namespace binding
 {
-	void registerAntiLangmuirModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerAntiLangmuirModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[AntiLangmuirBinding::identifier()] = []() { return new AntiLangmuirBinding(); };
-		bindings[ExternalAntiLangmuirBinding::identifier()] = []() { return new ExternalAntiLangmuirBinding(); };
+		bindings[hashStringRuntime(AntiLangmuirBinding::identifier())] = []() { return new AntiLangmuirBinding(); };
+		bindings[hashStringRuntime(ExternalAntiLangmuirBinding::identifier())] = []() { return new ExternalAntiLangmuirBinding(); };
 	}
 }  // namespace binding
 
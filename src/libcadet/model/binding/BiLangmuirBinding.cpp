@@ -527,10 +527,10 @@ typedef BiLangmuirBindingBase<ExtBiLangmuirParamHandler> ExternalBiLangmuirBindi
 
 namespace binding
 {
-	void registerBiLangmuirModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerBiLangmuirModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[BiLangmuirBinding::identifier()] = []() { return new BiLangmuirBinding(); };
-		bindings[ExternalBiLangmuirBinding::identifier()] = []() { return new ExternalBiLangmuirBinding(); };
+		bindings[hashStringRuntime(BiLangmuirBinding::identifier())] = []() { return new BiLangmuirBinding(); };
+		bindings[hashStringRuntime(ExternalBiLangmuirBinding::identifier())] = []() { return new ExternalBiLangmuirBinding(); };
 	}
 }  // namespace binding
 
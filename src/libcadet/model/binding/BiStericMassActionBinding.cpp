@@ -18,6 +18,7 @@
 #include "cadet/Exceptions.hpp"
 #include "nonlin/Solver.hpp"
 #include "ParamReaderHelper.hpp"
+#include "MathUtil.hpp"
 #include "SlicedVector.hpp"
 
 #include "AdUtils.hpp"
@@ -508,6 +509,14 @@ protected:
 			const ResidualType q0_bar_divRef = q0_bar / refQ;
 			const ResidualType yCp0_divRef = yCp[0] / refC0;
 
+			// All components of this binding site type share the two bases of the powers below,
+			// so their logarithms are hoisted out of the loop and each power reduces to one
+			// exponential (see powFromLog()). Non-positive bases keep the plain pow() path.
+			using std::log;
+			const bool posBases = (yCp0_divRef > 0.0) && (q0_bar_divRef > 0.0);
+			const ResidualType logYCp0_divRef = posBases ? log(yCp0_divRef) : ResidualType(0.0);
+			const ResidualType logQ0_bar_divRef = posBases ? log(q0_bar_divRef) : ResidualType(0.0);
+
 			// Protein equations: dq_i / dt - ( k_{a,i} * c_{p,i} * \bar{q}_0^{nu_i} - k_{d,i} * q_i * c_{p,0}^{nu_i} ) == 0
 			//               <=>  dq_i / dt == k_{a,i} * c_{p,i} * \bar{q}_0^{nu_i} - k_{d,i} * q_i * c_{p,0}^{nu_i}
 			bndIdx = 1;
@@ -517,8 +526,8 @@ protected:
 				if (_nBoundStates[i] == 0)
 					continue;
 
-				const ResidualType c0_pow_nu_divRef = pow(yCp0_divRef, static_cast<ParamType>(curNu[i]));
-				const ResidualType q0_bar_pow_nu_divRef = pow(q0_bar_divRef, static_cast<ParamType>(curNu[i]));
+				const ResidualType c0_pow_nu_divRef = posBases ? powFromLog(logYCp0_divRef, static_cast<ParamType>(curNu[i])) : pow(yCp0_divRef, static_cast<ParamType>(curNu[i]));
+				const ResidualType q0_bar_pow_nu_divRef = posBases ? powFromLog(logQ0_bar_divRef, static_cast<ParamType>(curNu[i])) : pow(q0_bar_divRef, static_cast<ParamType>(curNu[i]));
 
 				// Residual
 				res[bndIdx * numStates] = static_cast<ParamType>(curKd[i]) * y[bndIdx * numStates] * c0_pow_nu_divRef - static_cast<ParamType>(curKa[i]) * yCp[i] * q0_bar_pow_nu_divRef;
@@ -587,6 +596,12 @@ protected:
 			const double q0_bar_divRef = q0_bar / refQ;
 			const double yCp0_divRef = yCp[0] / refC0;
 
+			// Shared base logarithms hoisted out of the loop, see residualImpl()
+			using std::log;
+			const bool posBases = (yCp0_divRef > 0.0) && (q0_bar_divRef > 0.0);
+			const double logYCp0_divRef = posBases ? log(yCp0_divRef) : 0.0;
+			const double logQ0_bar_divRef = posBases ? log(q0_bar_divRef) : 0.0;
+
 			// Protein equations: dq_i / dt - ( k_{a,i} * c_{p,i} * \bar{q}_0^{nu_i} - k_{d,i} * q_i * c_{p,0}^{nu_i} ) == 0
 			// We have already computed \bar{q}_0 in the loop above
 			bndIdx = 1;
@@ -606,10 +621,10 @@ protected:
 				const double kd = static_cast<double>(curKd[i]);
 				const double nu = static_cast<double>(curNu[i]);
 
-				const double c0_pow_nu     = pow(yCp0_divRef, nu);
-				const double q0_bar_pow_nu = pow(q0_bar_divRef, nu);
-				const double c0_pow_nu_m1_divRef     = pow(yCp0_divRef, nu - 1.0);
-				const double q0_bar_pow_nu_m1_divRef = pow(q0_bar_divRef, nu - 1.0) / refQ;
+				const double c0_pow_nu     = posBases ? powFromLog(logYCp0_divRef, nu) : pow(yCp0_divRef, nu);
+				const double q0_bar_pow_nu = posBases ? powFromLog(logQ0_bar_divRef, nu) : pow(q0_bar_divRef, nu);
+				const double c0_pow_nu_m1_divRef     = posBases ? powFromLog(logYCp0_divRef, nu - 1.0) : pow(yCp0_divRef, nu - 1.0);
+				const double q0_bar_pow_nu_m1_divRef = (posBases ? powFromLog(logQ0_bar_divRef, nu - 1.0) : pow(q0_bar_divRef, nu - 1.0)) / refQ;
 
 				// dres_i / dc_{p,0}
 				curJac[-bndSite - _nComp - numStates * bndIdx] = kd * y[bndIdx * numStates] * nu * c0_pow_nu_m1_divRef / refC0;
@@ -654,10 +669,10 @@ typedef BiStericMassActionBindingBase<ExtBiSMAParamHandler> ExternalBiStericMass
 
 namespace binding
 {
-	void registerBiStericMassActionModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerBiStericMassActionModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[BiStericMassActionBinding::identifier()] = []() { return new BiStericMassActionBinding(); };
-		bindings[ExternalBiStericMassActionBinding::identifier()] = []() { return new ExternalBiStericMassActionBinding(); };
+		bindings[hashStringRuntime(BiStericMassActionBinding::identifier())] = []() { return new BiStericMassActionBinding(); };
+		bindings[hashStringRuntime(ExternalBiStericMassActionBinding::identifier())] = []() { return new ExternalBiStericMassActionBinding(); };
 	}
 }  // namespace binding
 
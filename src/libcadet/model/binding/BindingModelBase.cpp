@@ -53,7 +53,16 @@ bool BindingModelBase::configure(IParameterProvider& paramProvider, unsigned int
 	if (!configureNonlinearSolver(paramProvider))
 		return false;
 
-	return configureImpl(false, paramProvider, unitOpIdx);
+	// Binding models register a handful of parameters per bound state (rates, capacities,
+	// modifiers), so reserving up front avoids the incremental rehashing of the map while
+	// the parameters are inserted one by one
+	_parameters.reserve(8 * numBoundStates(_nBoundStates, _nComp) + 8);
+
+	const bool success = configureImpl(false, paramProvider, unitOpIdx);
+
+	// Compile the collision-free dispatch table used by the hot parameter lookups
+	_paramLookup.rebuild(_parameters);
+	return success;
 }
 
 bool BindingModelBase::reconfigure(IParameterProvider& paramProvider, unsigned int unitOpIdx)
@@ -61,9 +70,24 @@ bool BindingModelBase::reconfigure(IParameterProvider& paramProvider, unsigned i
 	// Read binding dynamics (quasi-stationary, kinetic)
 	_kineticBinding = paramProvider.getInt("IS_KINETIC");
 
-	// Clear all parameters and reconfigure
-	_parameters.clear();
-	return configureImpl(true, paramProvider, unitOpIdx);
+	// Update in place: the parameter values are re-read into the same vectors, so the
+	// registered pointers remain valid and re-registering only overwrites the existing
+	// map entries without erasing or rehashing any keys
+	const std::size_t oldSize = _parameters.size();
+	bool success = configureImpl(true, paramProvider, unitOpIdx);
+
+	// The dispatch table remains valid as long as the same parameters still live at the
+	// same addresses; otherwise the parameter layout has changed (e.g., an array parameter
+	// was given with a different size) and everything is rebuilt from scratch
+	if ((_parameters.size() != oldSize) || !_paramLookup.matches(_parameters))
+	{
+		const std::size_t newSize = _parameters.size();
+		_parameters.clear();
+		_parameters.reserve(std::max(oldSize, newSize));
+		success = configureImpl(true, paramProvider, unitOpIdx);
+		_paramLookup.rebuild(_parameters);
+	}
+	return success;
 }
 
 bool BindingModelBase::configureNonlinearSolver(IParameterProvider& paramProvider)
@@ -107,10 +131,10 @@ bool BindingModelBase::setParameter(const ParameterId& pId, int value)
 
 bool BindingModelBase::setParameter(const ParameterId& pId, double value)
 {
-	auto paramHandle = _parameters.find(pId);
-	if (paramHandle != _parameters.end())
+	active* const param = _paramLookup.find(pId);
+	if (param)
 	{
-		paramHandle->second->setValue(value);
+		param->setValue(value);
 		return true;
 	}
 
@@ -124,13 +148,7 @@ bool BindingModelBase::setParameter(const ParameterId& pId, bool value)
 
 active* BindingModelBase::getParameter(const ParameterId& pId)
 {
-	auto paramHandle = _parameters.find(pId);
-	if (paramHandle != _parameters.end())
-	{
-		return paramHandle->second;
-	}
-
-	return nullptr;
+	return _paramLookup.find(pId);
 }
 
 unsigned int BindingModelBase::consistentInitializationWorkspaceSize() const
@@ -205,6 +223,13 @@ void PureBindingModelBase::consistentInitialState(double t, double z, double r,
 	if (_kineticBinding)
 		return;
 
+	// Isotherms with a closed-form equilibrium do not require a nonlinear solver
+	if (hasQuasiStationaryEquilibrium())
+	{
+		quasiStationaryEquilibrium(t, z, r, secIdx, vecStateY - _nComp, vecStateY);
+		return;
+	}
+
 	// All equations are algebraic and (except for salt equation) nonlinear
 	// Compute the q_i from their corresponding c_{p,i}
 
@@ -21,6 +21,7 @@
 #include "model/BindingModel.hpp"
 #include "model/binding/BindingModelMacros.hpp"
 #include "ParamIdUtil.hpp"
+#include "ParamHashTable.hpp"
 
 #include <vector>
 #include <unordered_map>
@@ -83,6 +84,7 @@ protected:
 	bool _kineticBinding; //!< Determines whether binding is kinetic (@c true) or quasi-stationary (@c false)
 
 	std::unordered_map<ParameterId, active*> _parameters; //!< Map used to translate ParameterIds to actual variables
+	ParameterHashTable<active*> _paramLookup; //!< Collision-free dispatch table over _parameters used by the hot parameter lookups
 	nonlin::Solver* _nonlinearSolver; //!< Nonlinear equation solver for consistent initialization
 
 	/**
@@ -144,8 +144,8 @@
 namespace cadet
 {
 
-template <typename ValType>
-inline void readScalarParameterOrArray(std::vector<ValType>& dest, IParameterProvider& paramProvider, const std::string& dataSet, unsigned int nExpand);
+template <typename ValType, typename Alloc_t>
+inline void readScalarParameterOrArray(std::vector<ValType, Alloc_t>& dest, IParameterProvider& paramProvider, const std::string& dataSet, unsigned int nExpand);
 
 namespace model
 {
@@ -202,6 +202,11 @@ namespace model
 		std::vector<IExternalFunction*> _extFun; //!< Pointer to the external function
 		std::vector<int> _extFunIndex; //!< Index to the external function
 		mutable std::vector<double> _extFunBuffer; //!< Buffer for caching the evaluation of external functions
+		std::vector<bool> _extFunRadialDep; //!< Determines whether the external function depends on the radial particle coordinate
+		mutable double _cacheT; //!< Time point the external function buffer has been evaluated at
+		mutable double _cacheZ; //!< Axial position the external function buffer has been evaluated at
+		mutable unsigned int _cacheSec; //!< Section index the external function buffer has been evaluated at
+		mutable bool _cacheValid; //!< Determines whether the external function buffer holds values for the cached evaluation point
 
 		/**
 		 * @brief Sets external functions for this binding model
@@ -212,10 +217,15 @@ namespace model
 		{
 			_extFun.clear();
 			_extFun.resize(_extFunIndex.size(), nullptr);
+			_extFunRadialDep.assign(_extFunIndex.size(), false);
+			_cacheValid = false;
 			for (unsigned int i = 0; i < _extFunIndex.size(); ++i)
 			{
 				if ((_extFunIndex[i] >= 0) && (_extFunIndex[i] < size))
+				{
 					_extFun[i] = extFuns[_extFunIndex[i]];
+					_extFunRadialDep[i] = _extFun[i]->dependsOnRadialPosition();
+				}
 				else
 				{
 					_extFun[i] = nullptr;
@@ -233,7 +243,7 @@ namespace model
 
 	protected:
 
-		ExternalBindingParamHandlerBase() : _extFun(), _extFunIndex(), _extFunBuffer() { }
+		ExternalBindingParamHandlerBase() : _extFun(), _extFunIndex(), _extFunBuffer(), _extFunRadialDep(), _cacheT(0.0), _cacheZ(0.0), _cacheSec(0), _cacheValid(false) { }
 		
 		/**
 		 * @brief Configures the external data source of this externally dependent binding parameter set
@@ -273,6 +283,10 @@ namespace model
 		 * @brief Evaluates the external functions for the different parameters
 		 * @details This function is declared const since the actual parameters are left unchanged by the method.
 		 *          The cache is marked as mutable in order to make it writable.
+		 *
+		 *          Profiles that do not depend on the radial particle coordinate are evaluated
+		 *          once per column cell and time point only; subsequent calls for the other
+		 *          particle shells of the same cell are served from the buffer.
 		 * @param [in] t Current time
 		 * @param [in] z Axial coordinate in the column
 		 * @param [in] r Radial coordinate in the bead
@@ -280,14 +294,26 @@ namespace model
 		 */
 		inline void evaluateExternalFunctions(double t, double z, double r, unsigned int secIdx) const
 		{
+			const bool cacheHit = _cacheValid && (t == _cacheT) && (z == _cacheZ) && (secIdx == _cacheSec);
 			for (unsigned int i = 0; i < _extFunBuffer.size(); ++i)
 			{
 				IExternalFunction* const fun = _extFun[i];
-				if (fun)
-					_extFunBuffer[i] = fun->externalProfile(t, z, r, secIdx);
-				else
+				if (!fun)
+				{
 					_extFunBuffer[i] = 0.0;
+					continue;
+				}
+
+				// Radially constant profiles keep their buffered value from the previous shell
+				if (cacheHit && !_extFunRadialDep[i])
+					continue;
+
+				_extFunBuffer[i] = fun->externalProfile(t, z, r, secIdx);
 			}
+			_cacheT = t;
+			_cacheZ = z;
+			_cacheSec = secIdx;
+			_cacheValid = true;
 		}
 
 		/**
@@ -357,10 +357,10 @@ typedef KumarLangmuirBindingBase<ExtKumarLangmuirParamHandler> ExternalKumarLang
 
 namespace binding
 {
-	void registerKumarLangmuirModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerKumarLangmuirModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[KumarLangmuirBinding::identifier()] = []() { return new KumarLangmuirBinding(); };
-		bindings[ExternalKumarLangmuirBinding::identifier()] = []() { return new ExternalKumarLangmuirBinding(); };
+		bindings[hashStringRuntime(KumarLangmuirBinding::identifier())] = []() { return new KumarLangmuirBinding(); };
+		bindings[hashStringRuntime(ExternalKumarLangmuirBinding::identifier())] = []() { return new ExternalKumarLangmuirBinding(); };
 	}
 }  // namespace binding
 
@@ -196,9 +196,57 @@ public:
 	virtual int residual(double t, double z, double r, unsigned int secIdx, double timeFactor,
 		double const* y, double const* yDot, double* res) const;
 
+	virtual int residualBatch(unsigned int nShells, double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		double const* y, double const* yDot, double* res, unsigned int shellStride) const
+	{
+		// Inlining residualImpl() here exposes the whole shell loop to the compiler, which
+		// removes the per-shell virtual dispatch of the default implementation and lets the
+		// flux expressions vectorize across shells (parameters are constant over the shells
+		// unless they depend on an external function)
+		for (unsigned int shell = 0; shell < nShells; ++shell)
+		{
+			double const* const yShell = y + shell * shellStride;
+			residualImpl<double, double, double, double>(t, z, r[shell], secIdx, timeFactor, yShell, yShell - _nComp,
+				yDot ? yDot + shell * shellStride : nullptr, res + shell * shellStride);
+		}
+		return 0;
+	}
+
 	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { _p.setExternalFunctions(extFuns, size); }
 	virtual bool dependsOnTime() const CADET_NOEXCEPT { return ParamHandler_t::dependsOnTime(); }
 
+	virtual bool hasQuasiStationaryEquilibrium() const CADET_NOEXCEPT { return true; }
+
+	virtual void quasiStationaryEquilibrium(double t, double z, double r, unsigned int secIdx, double const* yCp, double* q) const
+	{
+		_p.update(t, z, r, secIdx, _nComp, _nBoundStates);
+
+		// Inserting  q_i = k_{a,i} / k_{d,i} * c_{p,i} * q_{max,i} * (1 - \sum_j q_j / q_{max,j})  into the
+		// sum on the right hand side yields the closed-form solution
+		//     q_i = q_{max,i} * a_i * c_{p,i} / (1 + \sum_j a_j * c_{p,j})  with  a_i = k_{a,i} / k_{d,i}
+		double denom = 1.0;
+		for (int i = 0; i < _nComp; ++i)
+		{
+			if (_nBoundStates[i] == 0)
+				continue;
+
+			denom += static_cast<double>(_p.kA[i]) / static_cast<double>(_p.kD[i]) * yCp[i];
+		}
+
+		unsigned int bndIdx = 0;
+		for (int i = 0; i < _nComp; ++i)
+		{
+			// Skip components without bound states (bound state index bndIdx is not advanced)
+			if (_nBoundStates[i] == 0)
+				continue;
+
+			q[bndIdx] = static_cast<double>(_p.qMax[i]) * static_cast<double>(_p.kA[i]) / static_cast<double>(_p.kD[i]) * yCp[i] / denom;
+
+			// Next bound component
+			++bndIdx;
+		}
+	}
+
 	virtual void timeDerivativeAlgebraicResidual(double t, double z, double r, unsigned int secIdx, double const* y, double* dResDt) const
 	{
 		if (!hasAlgebraicEquations())
@@ -388,10 +436,10 @@ typedef LangmuirBindingBase<ExtLangmuirParamHandler> ExternalLangmuirBinding;
 
 namespace binding
 {
-	void registerLangmuirModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerLangmuirModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[LangmuirBinding::identifier()] = []() { return new LangmuirBinding(); };
-		bindings[ExternalLangmuirBinding::identifier()] = []() { return new ExternalLangmuirBinding(); };
+		bindings[hashStringRuntime(LangmuirBinding::identifier())] = []() { return new LangmuirBinding(); };
+		bindings[hashStringRuntime(ExternalLangmuirBinding::identifier())] = []() { return new ExternalLangmuirBinding(); };
 	}
 }  // namespace binding
 
@@ -239,9 +239,17 @@ public:
 
 	virtual bool reconfigure(IParameterProvider& paramProvider, unsigned int unitOpIdx)
 	{
-		// Configure again
-		_parameters.clear();
-		return configure(paramProvider, unitOpIdx);
+		// Update in place: the values are re-read into the same vectors, so re-registering
+		// only overwrites the existing map entries without rehashing any keys; a changed
+		// map size means the parameter layout changed and forces a clean rebuild
+		const std::size_t oldSize = _parameters.size();
+		bool success = configure(paramProvider, unitOpIdx);
+		if (_parameters.size() != oldSize)
+		{
+			_parameters.clear();
+			success = configure(paramProvider, unitOpIdx);
+		}
+		return success;
 	}
 
 	virtual std::unordered_map<ParameterId, double> getAllParameterValues() const
@@ -313,12 +321,15 @@ public:
 		if (_kineticBinding)
 			return;
 
-		_p.update(t, z, r, secIdx, _nComp, _nBoundStates);
-
 		// Compute the q_i from their corresponding c_{p,i}
+		quasiStationaryEquilibrium(t, z, r, secIdx, vecStateY - _nComp, vecStateY);
+	}
 
-		// Pointer to first component in liquid phase
-		double const* yCp = vecStateY - _nComp;
+	virtual bool hasQuasiStationaryEquilibrium() const CADET_NOEXCEPT { return true; }
+
+	virtual void quasiStationaryEquilibrium(double t, double z, double r, unsigned int secIdx, double const* yCp, double* q) const
+	{
+		_p.update(t, z, r, secIdx, _nComp, _nBoundStates);
 
 		unsigned int bndIdx = 0;
 		for (int i = 0; i < _nComp; ++i)
@@ -328,7 +339,7 @@ public:
 				continue;
 
 			// Solve  k_a * c_p - k_d * q == 0  for q to obtain  q = k_a / k_d * c_p
-			vecStateY[bndIdx] = static_cast<double>(_p.kA[i]) / static_cast<double>(_p.kD[i]) * yCp[i];
+			q[bndIdx] = static_cast<double>(_p.kA[i]) / static_cast<double>(_p.kD[i]) * yCp[i];
 
 			// Next bound component
 			++bndIdx;
@@ -363,6 +374,22 @@ public:
 		return residualImpl<double, double, double>(t, z, r, secIdx, timeFactor, y, yDot, res);
 	}
 
+	virtual int residualBatch(unsigned int nShells, double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		double const* y, double const* yDot, double* res, unsigned int shellStride) const
+	{
+		// Inlining residualImpl() here exposes the whole shell loop to the compiler: the
+		// per-shell virtual dispatch of the default implementation disappears and, since
+		// update() is a no-op unless the parameters depend on an external function, the
+		// rate constants are hoisted out of the loop and the linear fluxes vectorize
+		for (unsigned int shell = 0; shell < nShells; ++shell)
+		{
+			double const* const yShell = y + shell * shellStride;
+			residualImpl<double, double, double>(t, z, r[shell], secIdx, timeFactor, yShell,
+				yDot ? yDot + shell * shellStride : nullptr, res + shell * shellStride);
+		}
+		return 0;
+	}
+
 	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { _p.setExternalFunctions(extFuns, size); }
 
 	virtual void analyticJacobian(double t, double z, double r, unsigned int secIdx, double const* y, linalg::BandMatrix::RowIterator jac) const
@@ -505,10 +532,10 @@ typedef LinearBindingBase<ExtLinearParamHandler> ExternalLinearBinding;
 
 namespace binding
 {
-	void registerLinearModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerLinearModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[LinearBinding::identifier()] = []() { return new LinearBinding(); };
-		bindings[ExternalLinearBinding::identifier()] = []() { return new ExternalLinearBinding(); };
+		bindings[hashStringRuntime(LinearBinding::identifier())] = []() { return new LinearBinding(); };
+		bindings[hashStringRuntime(ExternalLinearBinding::identifier())] = []() { return new ExternalLinearBinding(); };
 	}
 }  // namespace binding
 
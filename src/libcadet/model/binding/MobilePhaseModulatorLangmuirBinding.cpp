@@ -15,6 +15,7 @@
 #include "model/ModelUtils.hpp"
 #include "cadet/Exceptions.hpp"
 #include "ParamReaderHelper.hpp"
+#include "MathUtil.hpp"
 
 #include <functional>
 #include <unordered_map>
@@ -265,6 +266,13 @@ protected:
 			bndIdx = 1;
 		}
 
+		// All powers of the modulator concentration share their base, so its logarithm is
+		// hoisted out of the loop and each power reduces to one exponential (see powFromLog()).
+		// A non-positive modulator concentration (transient Newton iterates) keeps pow().
+		using std::log;
+		const bool posBase = (yCp[0] > 0.0);
+		const ResidualType logYCp0 = posBase ? ResidualType(log(yCp[0])) : ResidualType(0.0);
+
 		// Handle protein equations
 		for (int i = 1; i < _nComp; ++i)
 		{
@@ -272,8 +280,14 @@ protected:
 			if (_nBoundStates[i] == 0)
 				continue;
 
+			ResidualType modPowBeta;
+			if (cadet_likely(posBase))
+				modPowBeta = powFromLog(logYCp0, static_cast<ParamType>(_p.beta[i]));
+			else
+				modPowBeta = pow(yCp[0], static_cast<ParamType>(_p.beta[i]));
+
 			// Residual
-			res[bndIdx] = static_cast<ParamType>(_p.kD[i]) * pow(yCp[0], static_cast<ParamType>(_p.beta[i])) * y[bndIdx] - static_cast<ParamType>(_p.kA[i]) * exp(yCp[0] * static_cast<ParamType>(_p.gamma[i])) * yCp[i] * static_cast<ParamType>(_p.qMax[i]) * qSum;
+			res[bndIdx] = static_cast<ParamType>(_p.kD[i]) * modPowBeta * y[bndIdx] - static_cast<ParamType>(_p.kA[i]) * exp(yCp[0] * static_cast<ParamType>(_p.gamma[i])) * yCp[i] * static_cast<ParamType>(_p.qMax[i]) * qSum;
 
 			// Add time derivative if necessary
 			if (_kineticBinding && yDot)
@@ -316,6 +330,11 @@ protected:
 			++bndIdx;
 		}
 
+		// Shared base logarithm of the modulator powers hoisted out of the loop, see residualImpl()
+		using std::log;
+		const bool posBase = (yCp[0] > 0.0);
+		const double logYCp0 = posBase ? log(yCp[0]) : 0.0;
+
 		// Protein equations: dq_i / dt - ( k_{a,i} * exp(\gamma_i * c_{p,0}) * c_{p,i} * q_{max,i} * (1 - \sum q_i / q_{max,i}) - k_{d,i} * c_{p,0}^\beta_i * q_i) == 0
 		bndIdx = 0;
 		if (_nBoundStates[0] == 1)
@@ -334,7 +353,7 @@ protected:
 			const double kdRaw = static_cast<double>(_p.kD[i]);
 
 			// dres_i / dc_{p,0}
-			jac[-bndIdx - _nComp] = -ka * yCp[i] * qMax * qSum * gamma + kdRaw * beta * y[bndIdx] * pow(yCp[0], beta - 1.0);
+			jac[-bndIdx - _nComp] = -ka * yCp[i] * qMax * qSum * gamma + kdRaw * beta * y[bndIdx] * (posBase ? powFromLog(logYCp0, beta - 1.0) : pow(yCp[0], beta - 1.0));
 			// Getting to c_{p,0}: -bndIdx takes us to q_0, another -nComp to c_{p,0}.
 			//                     This means jac[bndIdx - nComp] corresponds to c_{p,0}.
 
@@ -362,7 +381,7 @@ protected:
 			}
 
 			// Add to dres_i / dq_i
-			jac[0] += kdRaw * pow(yCp[0], beta);
+			jac[0] += kdRaw * (posBase ? powFromLog(logYCp0, beta) : pow(yCp[0], beta));
 
 			// Advance to next equation and Jacobian row
 			++bndIdx;
@@ -378,10 +397,10 @@ typedef MobilePhaseModulatorLangmuirBindingBase<ExtMPMLangmuirParamHandler> Exte
 
 namespace binding
 {
-	void registerMobilePhaseModulatorLangmuirModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerMobilePhaseModulatorLangmuirModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[MobilePhaseModulatorLangmuirBinding::identifier()] = []() { return new MobilePhaseModulatorLangmuirBinding(); };
-		bindings[ExternalMobilePhaseModulatorLangmuirBinding::identifier()] = []() { return new ExternalMobilePhaseModulatorLangmuirBinding(); };
+		bindings[hashStringRuntime(MobilePhaseModulatorLangmuirBinding::identifier())] = []() { return new MobilePhaseModulatorLangmuirBinding(); };
+		bindings[hashStringRuntime(ExternalMobilePhaseModulatorLangmuirBinding::identifier())] = []() { return new ExternalMobilePhaseModulatorLangmuirBinding(); };
 	}
 }  // namespace binding
 
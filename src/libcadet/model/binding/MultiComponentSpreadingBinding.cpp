@@ -512,10 +512,10 @@ typedef MultiComponentSpreadingBindingBase<ExtSpreadingParamHandler> ExternalMul
 
 namespace binding
 {
-	void registerMultiComponentSpreadingModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerMultiComponentSpreadingModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[MultiComponentSpreadingBinding::identifier()] = []() { return new MultiComponentSpreadingBinding(); };
-		bindings[ExternalMultiComponentSpreadingBinding::identifier()] = []() { return new ExternalMultiComponentSpreadingBinding(); };
+		bindings[hashStringRuntime(MultiComponentSpreadingBinding::identifier())] = []() { return new MultiComponentSpreadingBinding(); };
+		bindings[hashStringRuntime(ExternalMultiComponentSpreadingBinding::identifier())] = []() { return new ExternalMultiComponentSpreadingBinding(); };
 	}
 }  // namespace binding
 
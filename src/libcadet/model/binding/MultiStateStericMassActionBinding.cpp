@@ -24,10 +24,14 @@
 
 #include "LoggingUtils.hpp"
 #include "Logging.hpp"
+#include "common/CompilerSpecific.hpp"
 
 #include <vector>
 #include <unordered_map>
 #include <functional>
+#include <type_traits>
+#include <atomic>
+#include <mutex>
 
 namespace cadet
 {
@@ -221,6 +225,22 @@ struct ExtMSSMAParamHandler : public ExternalBindingParamHandlerBase
 	active refQ; //! Solid phase reference concentration
 };
 
+namespace
+{
+	/**
+	 * @brief Determines whether the parameter tables of a handler stay fixed during time integration
+	 * @details Handlers without external dependence only change their tables through (re-)configuration
+	 *          and the parameter setters, which allows caching the plain values in a packed arena.
+	 *          Externally dependent handlers rewrite their tables on every update() call and cannot
+	 *          use such a cache.
+	 */
+	template <class ParamHandler_t>
+	struct ConstantParamTables { static const bool value = false; };
+
+	template <>
+	struct ConstantParamTables<MSSMAParamHandler> { static const bool value = true; };
+}
+
 /**
  * @brief Defines the Multi-State-SMA binding model
  * @details Implements the Multi-State-SMA adsorption model, which introduces @f$ M_i - 1 @f$ additional bound states @f$ q_i^{(j)} @f$ 
@@ -250,7 +270,7 @@ class MultiStateStericMassActionBindingBase : public BindingModelBase
 {
 public:
 
-	MultiStateStericMassActionBindingBase() { }
+	MultiStateStericMassActionBindingBase() : _uniformBoundStates(0), _packedStale(true) { }
 	virtual ~MultiStateStericMassActionBindingBase() CADET_NOEXCEPT { }
 
 	static const char* identifier() { return ParamHandler_t::identifier(); }
@@ -267,6 +287,28 @@ public:
 
 		// Allocate space for parameters
 		_p.reserve(nComp, nBound, totalBoundStates);
+
+		// Lay out the packed parameter arena: for each component the slices of all bound
+		// state dependent tables followed by the state transition rate matrix
+		_packedOffset.resize(nComp + 1);
+		_packedOffset[0] = 0;
+		for (unsigned int i = 0; i < nComp; ++i)
+			_packedOffset[i + 1] = _packedOffset[i] + 4 * nBound[i] + nBound[i] * nBound[i];
+		_packedParams.assign(_packedOffset[nComp], 0.0);
+		_packedStale.store(true, std::memory_order_release);
+
+		// Detect a uniform bound state multiplicity of all protein components. For the
+		// common multiplicities, the residual dispatches to a kernel with compile-time
+		// state count that the compiler can unroll (see residualProteinFixed()).
+		_uniformBoundStates = (nComp > 1) ? nBound[1] : 0;
+		for (unsigned int i = 2; i < nComp; ++i)
+		{
+			if (nBound[i] != _uniformBoundStates)
+			{
+				_uniformBoundStates = 0;
+				break;
+			}
+		}
 	}
 
 	virtual void getAlgebraicBlock(unsigned int& idxStart, unsigned int& len) const
@@ -391,6 +433,28 @@ public:
 	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { _p.setExternalFunctions(extFuns, size); }
 	virtual bool dependsOnTime() const CADET_NOEXCEPT { return ParamHandler_t::dependsOnTime(); }
 
+	virtual bool setParameter(const ParameterId& pId, double value)
+	{
+		if (!BindingModelBase::setParameter(pId, value))
+			return false;
+
+		// The packed parameter arena has to be rebuilt before the next kernel call
+		_packedStale.store(true, std::memory_order_release);
+		return true;
+	}
+
+	virtual active* getParameter(const ParameterId& pId)
+	{
+		active* const param = BindingModelBase::getParameter(pId);
+
+		// The pointer is handed out for writing (e.g., setting sensitive parameter values),
+		// so conservatively assume the packed parameter arena goes stale
+		if (param)
+			_packedStale.store(true, std::memory_order_release);
+
+		return param;
+	}
+
 	virtual void analyticJacobian(double t, double z, double r, unsigned int secIdx, double const* y, linalg::BandMatrix::RowIterator jac) const
 	{
 		jacobianImpl(t, z, r, secIdx, y, y - _nComp, jac);
@@ -430,6 +494,127 @@ public:
 
 protected:
 	ParamHandler_t _p; //!< Handles parameters and their dependence on external functions
+	unsigned int _uniformBoundStates; //!< Common bound state count of all protein components, @c 0 if the multiplicities differ
+
+	std::vector<unsigned int> _packedOffset; //!< Offset of each component's parameter group in the packed arena
+	mutable std::vector<double> _packedParams; //!< Single allocation arena with the plain values of all parameter tables
+	mutable std::atomic<bool> _packedStale; //!< Signals that the packed arena has to be refreshed from the tables
+	mutable std::mutex _packedLock; //!< Guards the packed arena refresh against concurrent kernel calls
+
+	/**
+	 * @brief Makes sure the packed parameter arena holds the current plain parameter values
+	 * @details The arena keeps the values of all parameter tables in one contiguous allocation
+	 *          so that the whole isotherm parameter set stays cache resident during the particle
+	 *          sweep instead of being scattered over several SlicedVector buffers of actives.
+	 *          Parameter values can change through several code paths (configure(), the
+	 *          setParameter() family, and pointers handed out by getParameter()), hence the
+	 *          arena is rebuilt lazily on the first kernel call after a mutation. Kernels of
+	 *          different particle shells run concurrently on the same binding model instance,
+	 *          so the check uses an atomic flag with a double checked lock. Externally dependent
+	 *          parameter handlers rewrite their tables on every update() call and bypass the
+	 *          arena entirely.
+	 */
+	inline void ensurePackedTables() const
+	{
+		if (!ConstantParamTables<ParamHandler_t>::value)
+			return;
+
+		if (cadet_likely(!_packedStale.load(std::memory_order_acquire)))
+			return;
+
+		std::lock_guard<std::mutex> lock(_packedLock);
+		if (!_packedStale.load(std::memory_order_relaxed))
+			return;
+
+		for (int i = 0; i < _nComp; ++i)
+		{
+			const unsigned int nb = _nBoundStates[i];
+			double* const dst = _packedParams.data() + _packedOffset[i];
+			active const* const srcKa = _p.kA[i];
+			active const* const srcKd = _p.kD[i];
+			active const* const srcNu = _p.nu[i];
+			active const* const srcSigma = _p.sigma[i];
+			for (unsigned int j = 0; j < nb; ++j)
+			{
+				dst[j] = static_cast<double>(srcKa[j]);
+				dst[nb + j] = static_cast<double>(srcKd[j]);
+				dst[2 * nb + j] = static_cast<double>(srcNu[j]);
+				dst[3 * nb + j] = static_cast<double>(srcSigma[j]);
+			}
+
+			active const* const srcRates = _p.kRate[i];
+			for (unsigned int j = 0; j < nb * nb; ++j)
+				dst[4 * nb + j] = static_cast<double>(srcRates[j]);
+		}
+
+		_packedStale.store(false, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Fetches the characteristic charge and steric factor slices of a component
+	 * @details The overload with @c double pointers reads from the packed parameter arena, the
+	 *          one with @c active pointers from the original tables. The kernels select between
+	 *          them via their table element type (see residualImpl()).
+	 * @param [in] comp Component index
+	 * @param [out] nu Characteristic charge slice
+	 * @param [out] sigma Steric factor slice
+	 */
+	inline void nuSigmaSlices(unsigned int comp, double const*& nu, double const*& sigma) const
+	{
+		double const* const base = _packedParams.data() + _packedOffset[comp];
+		const unsigned int nb = _nBoundStates[comp];
+		nu = base + 2 * nb;
+		sigma = base + 3 * nb;
+	}
+
+	inline void nuSigmaSlices(unsigned int comp, active const*& nu, active const*& sigma) const
+	{
+		nu = _p.nu[comp];
+		sigma = _p.sigma[comp];
+	}
+
+	/**
+	 * @brief Fetches the parameter slices of the protein equations of a component
+	 * @details See nuSigmaSlices() for the overload selection.
+	 * @param [in] comp Component index
+	 * @param [out] ka Adsorption rate slice
+	 * @param [out] kd Desorption rate slice
+	 * @param [out] nu Characteristic charge slice
+	 * @param [out] rates State transition rate matrix of the component
+	 */
+	inline void kineticsSlices(unsigned int comp, double const*& ka, double const*& kd, double const*& nu, double const*& rates) const
+	{
+		double const* const base = _packedParams.data() + _packedOffset[comp];
+		const unsigned int nb = _nBoundStates[comp];
+		ka = base;
+		kd = base + nb;
+		nu = base + 2 * nb;
+		rates = base + 4 * nb;
+	}
+
+	inline void kineticsSlices(unsigned int comp, active const*& ka, active const*& kd, active const*& nu, active const*& rates) const
+	{
+		ka = _p.kA[comp];
+		kd = _p.kD[comp];
+		nu = _p.nu[comp];
+		rates = _p.kRate[comp];
+	}
+
+	/**
+	 * @brief Fetches the steric factor slice of a component
+	 * @details See nuSigmaSlices() for the overload selection.
+	 * @param [in] comp Component index
+	 * @param [out] sigma Steric factor slice
+	 */
+	inline void sigmaSlice(unsigned int comp, double const*& sigma) const
+	{
+		sigma = _packedParams.data() + _packedOffset[comp] + 3 * _nBoundStates[comp];
+	}
+
+	inline void sigmaSlice(unsigned int comp, active const*& sigma) const
+	{
+		sigma = _p.sigma[comp];
+	}
 
 	virtual bool configureImpl(bool reconfigure, IParameterProvider& paramProvider, unsigned int unitOpIdx)
 	{
@@ -439,6 +624,9 @@ protected:
 		// Register parameters
 		_p.registerParameters(_parameters, unitOpIdx, _nComp, _nBoundStates);
 
+		// Parameter values have been (re-)read, repack the plain value arena on next use
+		_packedStale.store(true, std::memory_order_release);
+
 		return true;
 	}
 
@@ -447,8 +635,13 @@ protected:
 		StateType const* y, CpStateType const* yCp, double const* yDot, ResidualType* res) const
 	{
 		_p.update(static_cast<double>(t), z, r, secIdx, _nComp, _nBoundStates);
+		ensurePackedTables();
 
-		// Salt equation: q_0 - Lambda + Sum[Sum[nu_i^j * q_i^j, j], i] == 0 
+		// Kernels working on plain double parameters read the packed arena (constant tables
+		// only), AD typed kernels and externally dependent models read the active tables
+		typedef typename std::conditional<std::is_same<ParamType, double>::value && ConstantParamTables<ParamHandler_t>::value, double, active>::type TableT;
+
+		// Salt equation: q_0 - Lambda + Sum[Sum[nu_i^j * q_i^j, j], i] == 0
 		//           <=>  q_0 == Lambda - Sum[Sum[nu_i^j * q_i^j, j], i] 
 		// Also compute \bar{q}_0 = q_0 - Sum[Sum[sigma_i^j * q_i^j, j], i]
 		res[0] = y[0] - static_cast<ParamType>(_p.lambda);
@@ -459,8 +652,9 @@ protected:
 		// Loop over all components i
 		for (int i = 1; i < _nComp; ++i)
 		{
-			active const* const curNu = _p.nu[i];
-			active const* const curSigma = _p.sigma[i];
+			TableT const* curNu;
+			TableT const* curSigma;
+			nuSigmaSlices(i, curNu, curSigma);
 
 			// Loop over bound states j of component i
 			for (unsigned int j = 0; j < _nBoundStates[i]; ++j)
@@ -480,14 +674,26 @@ protected:
 
 		// Protein equations
 
+		// Dispatch to a fixed multiplicity kernel for the common bound state counts
+		switch (_uniformBoundStates)
+		{
+			case 2:
+				residualProteinFixed<2>(timeFactor, y, yCp, yDot, res, yCp0_divRef, q0_bar_divRef);
+				return 0;
+			case 3:
+				residualProteinFixed<3>(timeFactor, y, yCp, yDot, res, yCp0_divRef, q0_bar_divRef);
+				return 0;
+		}
+
 		// Loop over all components i
 		bndIdx = 1;
 		for (int i = 1; i < _nComp; ++i)
 		{
-			active const* const curKa = _p.kA[i];
-			active const* const curKd = _p.kD[i];
-			active const* const curNu = _p.nu[i];
-			active const* const curRates = _p.kRate[i];
+			TableT const* curKa;
+			TableT const* curKd;
+			TableT const* curNu;
+			TableT const* curRates;
+			kineticsSlices(i, curKa, curKd, curNu, curRates);
 			const unsigned int nBoundStatesI = _nBoundStates[i];
 
 			// Loop over bound states j of component i
@@ -536,10 +742,90 @@ protected:
 		return 0;
 	}
 
+	/**
+	 * @brief Evaluates the protein equations for a uniform compile-time bound state count
+	 * @details Same computation as the protein loop in residualImpl() but with the bound
+	 *          state multiplicity fixed at compile time. All inner loops have constant trip
+	 *          counts and the state transition rate table is accessed with fixed strides,
+	 *          which lets the compiler fully unroll the per-component flux expressions.
+	 * @param [in] timeFactor Used for time transformation (pre factor of time derivatives)
+	 * @param [in] y Pointer to first bound state of the first component in the current particle shell
+	 * @param [in] yCp Pointer to first liquid phase concentration in the current particle shell
+	 * @param [in] yDot Pointer to first bound state time derivative or @c nullptr
+	 * @param [out] res Pointer to result of the protein equations
+	 * @param [in] yCp0_divRef Salt liquid phase concentration divided by the reference concentration
+	 * @param [in] q0_bar_divRef Free salt counterion concentration divided by the reference concentration
+	 * @tparam NStates Number of bound states of each protein component
+	 */
+	template <unsigned int NStates, typename StateType, typename CpStateType, typename ResidualType, typename ParamType>
+	void residualProteinFixed(const ParamType& timeFactor, StateType const* y, CpStateType const* yCp, double const* yDot,
+		ResidualType* res, const ResidualType& yCp0_divRef, const ResidualType& q0_bar_divRef) const
+	{
+		// Same table element type selection as in residualImpl(), which has already
+		// refreshed the packed arena before dispatching here
+		typedef typename std::conditional<std::is_same<ParamType, double>::value && ConstantParamTables<ParamHandler_t>::value, double, active>::type TableT;
+
+		// Loop over all components i
+		unsigned int bndIdx = 1;
+		for (int i = 1; i < _nComp; ++i)
+		{
+			TableT const* curKa;
+			TableT const* curKd;
+			TableT const* curNu;
+			TableT const* curRates;
+			kineticsSlices(i, curKa, curKd, curNu, curRates);
+
+			// Loop over bound states j of component i
+			for (unsigned int j = 0; j < NStates; ++j)
+			{
+				const ResidualType c0_pow_nu = pow(yCp0_divRef, static_cast<ParamType>(curNu[j]));
+				const ResidualType q0_bar_pow_nu = pow(q0_bar_divRef, static_cast<ParamType>(curNu[j]));
+
+				// Calculate residual
+				// Adsorption and desorption
+				res[bndIdx] = static_cast<ParamType>(curKd[j]) * y[bndIdx] * c0_pow_nu - static_cast<ParamType>(curKa[j]) * yCp[i] * q0_bar_pow_nu;
+
+				// Conversion to and from weaker states
+				for (unsigned int l = 0; l < j; ++l)
+				{
+					const ParamType nuDiff = static_cast<ParamType>(curNu[j]) - static_cast<ParamType>(curNu[l]);
+					// Conversion to weaker state
+					res[bndIdx] += static_cast<ParamType>(curRates[NStates * j + l]) * y[bndIdx] * pow(yCp0_divRef, nuDiff);
+					// Conversion from weaker state (see residualImpl() for the indexing)
+					res[bndIdx] -= static_cast<ParamType>(curRates[NStates * l + j]) * y[bndIdx - j + l] * pow(q0_bar_divRef, nuDiff);
+				}
+
+				// Conversion to and from stronger states
+				for (unsigned int l = j+1; l < NStates; ++l)
+				{
+					const ParamType nuDiff = static_cast<ParamType>(curNu[l]) - static_cast<ParamType>(curNu[j]);
+					// Conversion to stronger state
+					res[bndIdx] += static_cast<ParamType>(curRates[NStates * j + l]) * y[bndIdx] * pow(q0_bar_divRef, nuDiff);
+					// Conversion from stronger state
+					res[bndIdx] -= static_cast<ParamType>(curRates[NStates * l + j]) * y[bndIdx - j + l] * pow(yCp0_divRef, nuDiff);
+				}
+
+				// Add time derivative if necessary
+				if (_kineticBinding && yDot)
+				{
+					res[bndIdx] += timeFactor * yDot[bndIdx];
+				}
+
+				// Next bound component
+				++bndIdx;
+			}
+		}
+	}
+
 	template <typename RowIterator>
 	void jacobianImpl(double t, double z, double r, unsigned int secIdx, double const* y, double const* yCp, RowIterator jac) const
 	{
 		_p.update(t, z, r, secIdx, _nComp, _nBoundStates);
+		ensurePackedTables();
+
+		// The Jacobian works on plain double parameters, so constant tables come from the
+		// packed arena (see residualImpl())
+		typedef typename std::conditional<ConstantParamTables<ParamHandler_t>::value, double, active>::type TableT;
 
 		double q0_bar = y[0];
 
@@ -548,8 +834,9 @@ protected:
 		int bndIdx = 1;
 		for (int i = 1; i < _nComp; ++i)
 		{
-			active const* const curNu = _p.nu[i];
-			active const* const curSigma = _p.sigma[i];
+			TableT const* curNu;
+			TableT const* curSigma;
+			nuSigmaSlices(i, curNu, curSigma);
 
 			for (unsigned int j = 0; j < _nBoundStates[i]; ++j)
 			{
@@ -576,10 +863,11 @@ protected:
 		bndIdx = 1;
 		for (int i = 1; i < _nComp; ++i)
 		{
-			active const* const curKa = _p.kA[i];
-			active const* const curKd = _p.kD[i];
-			active const* const curNu = _p.nu[i];
-			active const* const curRates = _p.kRate[i];
+			TableT const* curKa;
+			TableT const* curKd;
+			TableT const* curNu;
+			TableT const* curRates;
+			kineticsSlices(i, curKa, curKd, curNu, curRates);
 			const double refC0 = static_cast<double>(_p.refC0);
 			const double refQ = static_cast<double>(_p.refQ);
 			const unsigned int nBoundStatesI = _nBoundStates[i];
@@ -610,7 +898,8 @@ protected:
 				int bndIdx2 = 1;
 				for (int i2 = 1; i2 < _nComp; ++i2)
 				{
-					active const* const curSigma = _p.sigma[i2];
+					TableT const* curSigma;
+					sigmaSlice(i2, curSigma);
 					for (unsigned int j2 = 0; j2 < _nBoundStates[i2]; ++j2)
 					{
 						// dres_i / dq_{i2}^{j2}
@@ -645,7 +934,8 @@ protected:
 					bndIdx2 = 1;
 					for (int i2 = 1; i2 < _nComp; ++i2)
 					{
-						active const* const curSigma = _p.sigma[i2];
+						TableT const* curSigma;
+						sigmaSlice(i2, curSigma);
 						for (int j2 = 0; j2 < static_cast<int>(_nBoundStates[i2]); ++j2, ++bndIdx2)
 							jac[bndIdx2 - bndIdx] += q0_bar_pow_nudiff_deriv * static_cast<double>(curSigma[j2]);
 					}
@@ -669,7 +959,8 @@ protected:
 					bndIdx2 = 1;
 					for (int i2 = 1; i2 < _nComp; ++i2)
 					{
-						active const* const curSigma = _p.sigma[i2];
+						TableT const* curSigma;
+						sigmaSlice(i2, curSigma);
 						for (int j2 = 0; j2 < static_cast<int>(_nBoundStates[i2]); ++j2, ++bndIdx2)
 							jac[bndIdx2 - bndIdx] -= q0_bar_pow_nudiff_deriv * static_cast<double>(curSigma[j2]);
 					}
@@ -691,10 +982,10 @@ typedef MultiStateStericMassActionBindingBase<ExtMSSMAParamHandler> ExternalMult
 
 namespace binding
 {
-	void registerMultiStateStericMassActionModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerMultiStateStericMassActionModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[MultiStateStericMassActionBinding::identifier()] = []() { return new MultiStateStericMassActionBinding(); };
-		bindings[ExternalMultiStateStericMassActionBinding::identifier()] = []() { return new ExternalMultiStateStericMassActionBinding(); };
+		bindings[hashStringRuntime(MultiStateStericMassActionBinding::identifier())] = []() { return new MultiStateStericMassActionBinding(); };
+		bindings[hashStringRuntime(ExternalMultiStateStericMassActionBinding::identifier())] = []() { return new ExternalMultiStateStericMassActionBinding(); };
 	}
 }  // namespace binding
 
@@ -27,8 +27,8 @@
 namespace cadet
 {
 
-template <typename ValType>
-inline void readScalarParameterOrArray(std::vector<ValType>& dest, IParameterProvider& paramProvider, const std::string& dataSet, unsigned int nExpand);
+template <typename ValType, typename Alloc_t>
+inline void readScalarParameterOrArray(std::vector<ValType, Alloc_t>& dest, IParameterProvider& paramProvider, const std::string& dataSet, unsigned int nExpand);
 
 /**
  * @brief Reads multiple reference concentrations from the given parameter provider
@@ -345,10 +345,10 @@ typedef SaskaBindingBase<ExtSaskaParamHandler> ExternalSaskaBinding;
 
 namespace binding
 {
-	void registerSaskaModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerSaskaModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[SaskaBinding::identifier()] = []() { return new SaskaBinding(); };
-		bindings[ExternalSaskaBinding::identifier()] = []() { return new ExternalSaskaBinding(); };
+		bindings[hashStringRuntime(SaskaBinding::identifier())] = []() { return new SaskaBinding(); };
+		bindings[hashStringRuntime(ExternalSaskaBinding::identifier())] = []() { return new ExternalSaskaBinding(); };
 	}
 }  // namespace binding
 
@@ -551,10 +551,10 @@ typedef SelfAssociationBindingBase<ExtSelfAssociationParamHandler> ExternalSelfA
 
 namespace binding
 {
-	void registerSelfAssociationModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerSelfAssociationModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[SelfAssociationBinding::identifier()] = []() { return new SelfAssociationBinding(); };
-		bindings[ExternalSelfAssociationBinding::identifier()] = []() { return new ExternalSelfAssociationBinding(); };
+		bindings[hashStringRuntime(SelfAssociationBinding::identifier())] = []() { return new SelfAssociationBinding(); };
+		bindings[hashStringRuntime(ExternalSelfAssociationBinding::identifier())] = []() { return new ExternalSelfAssociationBinding(); };
 	}
 }  // namespace binding
 
@@ -307,13 +307,13 @@ CADET_BINDINGMODEL_RESIDUAL_BOILERPLATE_IMPL(SimplifiedMultiStateStericMassActio
 template <typename ParamType>
 inline ParamType SimplifiedMultiStateStericMassActionBinding::sigma(int comp, double state) const
 {
-	return static_cast<ParamType>(_sigmaMin[comp]) + state * (static_cast<ParamType>(_sigmaMax[comp]) - static_cast<ParamType>(_sigmaMin[comp])) / (_nBoundStates[comp] - 1) - static_cast<ParamType>(_sigmaQuad[comp]) * state * (1 - _nBoundStates[comp] + state);
+	return static_cast<ParamType>(_sigmaMin[comp]) + state * (static_cast<ParamType>(_sigmaMax[comp]) - static_cast<ParamType>(_sigmaMin[comp])) / static_cast<double>(_nBoundStates[comp] - 1) - static_cast<ParamType>(_sigmaQuad[comp]) * state * (1 - _nBoundStates[comp] + state);
 }
 
 template <typename ParamType>
 inline ParamType SimplifiedMultiStateStericMassActionBinding::nu(int comp, double state) const
 {
-	return static_cast<ParamType>(_nuMin[comp]) + state * (static_cast<ParamType>(_nuMax[comp]) - static_cast<ParamType>(_nuMin[comp])) / (_nBoundStates[comp] - 1) - static_cast<ParamType>(_nuQuad[comp]) * state * (1 - _nBoundStates[comp] + state);
+	return static_cast<ParamType>(_nuMin[comp]) + state * (static_cast<ParamType>(_nuMax[comp]) - static_cast<ParamType>(_nuMin[comp])) / static_cast<double>(_nBoundStates[comp] - 1) - static_cast<ParamType>(_nuQuad[comp]) * state * (1 - _nBoundStates[comp] + state);
 }
 
 template <typename ParamType>
@@ -18,6 +18,7 @@
 #include "cadet/Exceptions.hpp"
 #include "nonlin/Solver.hpp"
 #include "ParamReaderHelper.hpp"
+#include "MathUtil.hpp"
 
 #include <functional>
 #include <unordered_map>
@@ -318,9 +319,24 @@ public:
 	virtual int residual(const active& t, double z, double r, unsigned int secIdx, const active& timeFactor, 
 		double const* y, double const* yDot, active* res) const;
 
-	virtual int residual(double t, double z, double r, unsigned int secIdx, double timeFactor, 
+	virtual int residual(double t, double z, double r, unsigned int secIdx, double timeFactor,
 		double const* y, double const* yDot, double* res) const;
 
+	virtual int residualBatch(unsigned int nShells, double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		double const* y, double const* yDot, double* res, unsigned int shellStride) const
+	{
+		// Inlining residualImpl() here exposes the whole shell loop to the compiler, which
+		// removes the per-shell virtual dispatch of the default implementation and lets the
+		// power functions of the protein fluxes vectorize across shells
+		for (unsigned int shell = 0; shell < nShells; ++shell)
+		{
+			double const* const yShell = y + shell * shellStride;
+			residualImpl<double, double, double, double>(t, z, r[shell], secIdx, timeFactor, yShell, yShell - _nComp,
+				yDot ? yDot + shell * shellStride : nullptr, res + shell * shellStride);
+		}
+		return 0;
+	}
+
 	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { _p.setExternalFunctions(extFuns, size); }
 
 	virtual void analyticJacobian(double t, double z, double r, unsigned int secIdx, double const* y, linalg::BandMatrix::RowIterator jac) const
@@ -408,6 +424,14 @@ protected:
 		const ResidualType yCp0_divRef = yCp[0] / refC0;
 		const ResidualType q0_bar_divRef = q0_bar / refQ;
 
+		// All components share the two bases of the powers below, so their logarithms are
+		// hoisted out of the loop and each power reduces to one exponential (see powFromLog()).
+		// Non-positive bases (transient Newton iterates) keep the plain pow() path.
+		using std::log;
+		const bool posBases = (yCp0_divRef > 0.0) && (q0_bar_divRef > 0.0);
+		const ResidualType logYCp0_divRef = posBases ? log(yCp0_divRef) : ResidualType(0.0);
+		const ResidualType logQ0_bar_divRef = posBases ? log(q0_bar_divRef) : ResidualType(0.0);
+
 		// Protein equations: dq_i / dt - ( k_{a,i} * c_{p,i} * \bar{q}_0^{nu_i} - k_{d,i} * q_i * c_{p,0}^{nu_i} ) == 0
 		//               <=>  dq_i / dt == k_{a,i} * c_{p,i} * \bar{q}_0^{nu_i} - k_{d,i} * q_i * c_{p,0}^{nu_i}
 		bndIdx = 1;
@@ -417,8 +441,8 @@ protected:
 			if (_nBoundStates[i] == 0)
 				continue;
 
-			const ResidualType c0_pow_nu = pow(yCp0_divRef, static_cast<ParamType>(_p.nu[i]));
-			const ResidualType q0_bar_pow_nu = pow(q0_bar_divRef, static_cast<ParamType>(_p.nu[i]));
+			const ResidualType c0_pow_nu = posBases ? powFromLog(logYCp0_divRef, static_cast<ParamType>(_p.nu[i])) : pow(yCp0_divRef, static_cast<ParamType>(_p.nu[i]));
+			const ResidualType q0_bar_pow_nu = posBases ? powFromLog(logQ0_bar_divRef, static_cast<ParamType>(_p.nu[i])) : pow(q0_bar_divRef, static_cast<ParamType>(_p.nu[i]));
 
 			// Residual
 			res[bndIdx] = static_cast<ParamType>(_p.kD[i]) * y[bndIdx] * c0_pow_nu - static_cast<ParamType>(_p.kA[i]) * yCp[i] * q0_bar_pow_nu;
@@ -469,6 +493,12 @@ protected:
 		const double yCp0_divRef = yCp[0] / refC0;
 		const double q0_bar_divRef = q0_bar / refQ;
 
+		// Shared base logarithms hoisted out of the loop, see residualImpl()
+		using std::log;
+		const bool posBases = (yCp0_divRef > 0.0) && (q0_bar_divRef > 0.0);
+		const double logYCp0_divRef = posBases ? log(yCp0_divRef) : 0.0;
+		const double logQ0_bar_divRef = posBases ? log(q0_bar_divRef) : 0.0;
+
 		// Protein equations: dq_i / dt - ( k_{a,i} * c_{p,i} * \bar{q}_0^{nu_i} - k_{d,i} * q_i * c_{p,0}^{nu_i} ) == 0
 		// We have already computed \bar{q}_0 in the loop above
 		bndIdx = 1;
@@ -486,10 +516,10 @@ protected:
 			const double kd = static_cast<double>(_p.kD[i]);
 			const double nu = static_cast<double>(_p.nu[i]);
 
-			const double c0_pow_nu     = pow(yCp0_divRef, nu);
-			const double q0_bar_pow_nu = pow(q0_bar_divRef, nu);
-			const double c0_pow_nu_m1_divRef     = pow(yCp0_divRef, nu - 1.0) / refC0;
-			const double q0_bar_pow_nu_m1_divRef = nu * pow(q0_bar_divRef, nu - 1.0) / refQ;
+			const double c0_pow_nu     = posBases ? powFromLog(logYCp0_divRef, nu) : pow(yCp0_divRef, nu);
+			const double q0_bar_pow_nu = posBases ? powFromLog(logQ0_bar_divRef, nu) : pow(q0_bar_divRef, nu);
+			const double c0_pow_nu_m1_divRef     = (posBases ? powFromLog(logYCp0_divRef, nu - 1.0) : pow(yCp0_divRef, nu - 1.0)) / refC0;
+			const double q0_bar_pow_nu_m1_divRef = nu * (posBases ? powFromLog(logQ0_bar_divRef, nu - 1.0) : pow(q0_bar_divRef, nu - 1.0)) / refQ;
 
 			// dres_i / dc_{p,0}
 			jac[-bndIdx - _nComp] = kd * y[bndIdx] * nu * c0_pow_nu_m1_divRef;
@@ -531,10 +561,10 @@ typedef StericMassActionBindingBase<ExtSMAParamHandler> ExternalStericMassAction
 
 namespace binding
 {
-	void registerStericMassActionModel(std::unordered_map<std::string, std::function<model::IBindingModel*()>>& bindings)
+	void registerStericMassActionModel(std::unordered_map<StringHash, std::function<model::IBindingModel*()>>& bindings)
 	{
-		bindings[StericMassActionBinding::identifier()] = []() { return new StericMassActionBinding(); };
-		bindings[ExternalStericMassActionBinding::identifier()] = []() { return new ExternalStericMassActionBinding(); };
+		bindings[hashStringRuntime(StericMassActionBinding::identifier())] = []() { return new StericMassActionBinding(); };
+		bindings[hashStringRuntime(ExternalStericMassActionBinding::identifier())] = []() { return new ExternalStericMassActionBinding(); };
 	}
 }  // namespace binding
 
@@ -0,0 +1,195 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a memoizing wrapper around an external function shared by several consumers.
+ */
+
+#ifndef LIBCADET_CACHEDEXTERNALFUNCTION_HPP_
+#define LIBCADET_CACHEDEXTERNALFUNCTION_HPP_
+
+#include "cadet/ExternalFunction.hpp"
+#include "common/CompilerSpecific.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+#ifdef CADET_PARALLELIZE
+	#include <tbb/spin_mutex.h>
+#endif
+
+namespace cadet
+{
+
+namespace model
+{
+
+/**
+ * @brief Memoizes the profile values of an external function
+ * @details A single external function (e.g., a temperature profile) is often shared by
+ *          several dependent parameters and by the binding models of several unit
+ *          operations, each of which evaluates the profile independently for every
+ *          column cell. This wrapper is put between the ModelSystem and its consumers
+ *          and caches the profile values of one time point: as long as the queries stay
+ *          at the same time and section, each spatial position is evaluated once and
+ *          all further queries (other dependent parameters, Newton iterations, other
+ *          unit operations sharing the profile) are served from the cache. A query at
+ *          a different time or section drops the cached values and starts over, so no
+ *          explicit per-step reset is required.
+ *
+ *          For profiles that do not depend on the radial particle coordinate, the
+ *          radial position is ignored in the cache key such that all particle shells
+ *          of a cell share one entry.
+ *
+ *          The cache is invalidated explicitly when the underlying function is
+ *          reconfigured or receives new section times. Time derivative queries are
+ *          forwarded without caching since they only occur during consistent
+ *          initialization.
+ */
+class CachedExternalFunction : public IExternalFunction
+{
+public:
+
+	/**
+	 * @brief Creates a caching wrapper around the given external function
+	 * @param [in] base Wrapped external function (ownership remains with the caller)
+	 */
+	explicit CachedExternalFunction(IExternalFunction& base) : _base(base), _radialDep(base.dependsOnRadialPosition()),
+		_cacheTime(0.0), _cacheSec(0), _cacheValid(false) { }
+
+	virtual ~CachedExternalFunction() CADET_NOEXCEPT { }
+
+	virtual const char* name() const CADET_NOEXCEPT { return _base.name(); }
+
+	virtual bool configure(IParameterProvider* paramProvider)
+	{
+		invalidate();
+		return _base.configure(paramProvider);
+	}
+
+	virtual double externalProfile(double t, double z, double r, unsigned int sec)
+	{
+		// Radially constant profiles share one cache entry among all particle shells
+		const PositionKey key{z, _radialDep ? r : 0.0};
+
+#ifdef CADET_PARALLELIZE
+		// Unit operations are evaluated in parallel and may share this wrapper; the
+		// lock also covers the evaluation of the wrapped function, which is therefore
+		// not required to be thread safe
+		tbb::spin_mutex::scoped_lock lock(_mutex);
+#endif
+
+		// The cache only holds the values of a single time point
+		if (!_cacheValid || (t != _cacheTime) || (sec != _cacheSec))
+		{
+			_cache.clear();
+			_cacheTime = t;
+			_cacheSec = sec;
+			_cacheValid = true;
+		}
+
+		const std::unordered_map<PositionKey, double, PositionKeyHash>::const_iterator it = _cache.find(key);
+		if (it != _cache.end())
+			return it->second;
+
+		const double val = _base.externalProfile(t, z, r, sec);
+		_cache[key] = val;
+		return val;
+	}
+
+	virtual double timeDerivative(double t, double z, double r, unsigned int sec)
+	{
+		return _base.timeDerivative(t, z, r, sec);
+	}
+
+	virtual bool dependsOnRadialPosition() const CADET_NOEXCEPT { return _radialDep; }
+
+	virtual void setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections)
+	{
+		invalidate();
+		_base.setSectionTimes(secTimes, secContinuity, nSections);
+	}
+
+	/**
+	 * @brief Drops all memoized profile values
+	 * @details Has to be called whenever the wrapped function may return different
+	 *          values for previously queried points (e.g., after reconfiguration).
+	 */
+	inline void invalidate() CADET_NOEXCEPT
+	{
+		_cache.clear();
+		_cacheValid = false;
+	}
+
+	/**
+	 * @brief Returns the amount of memory occupied by the cache in bytes
+	 * @return Size of the cache in bytes
+	 */
+	inline std::size_t memoryFootprint() const CADET_NOEXCEPT
+	{
+		return _cache.size() * (sizeof(PositionKey) + sizeof(double) + 2 * sizeof(void*));
+	}
+
+protected:
+
+	/**
+	 * @brief Spatial position a profile value was evaluated at
+	 * @details The positions originate from a fixed spatial grid, so the exact bit
+	 *          patterns of the coordinates recur and can be compared directly.
+	 */
+	struct PositionKey
+	{
+		double z; //!< Normalized axial position in the column
+		double r; //!< Normalized radial position in the bead (@c 0.0 if the profile does not depend on it)
+
+		inline bool operator==(const PositionKey& other) const CADET_NOEXCEPT { return (z == other.z) && (r == other.r); }
+	};
+
+	/**
+	 * @brief Hashes a PositionKey by mixing the bit patterns of its coordinates
+	 */
+	struct PositionKeyHash
+	{
+		inline std::size_t operator()(const PositionKey& key) const CADET_NOEXCEPT
+		{
+			std::uint64_t zBits = 0;
+			std::uint64_t rBits = 0;
+			std::memcpy(&zBits, &key.z, sizeof(double));
+			std::memcpy(&rBits, &key.r, sizeof(double));
+
+			// Multiplicative mixing (splitmix64 finalization step)
+			std::uint64_t h = zBits + UINT64_C(0x9E3779B97F4A7C15) * rBits;
+			h = (h ^ (h >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+			h = (h ^ (h >> 27)) * UINT64_C(0x94D049BB133111EB);
+			return static_cast<std::size_t>(h ^ (h >> 31));
+		}
+	};
+
+	IExternalFunction& _base; //!< Wrapped external function (owned by the ModelSystem or the library user)
+	const bool _radialDep; //!< Determines whether the wrapped profile depends on the radial position
+
+	double _cacheTime; //!< Time point the cached values belong to
+	unsigned int _cacheSec; //!< Section index the cached values belong to
+	bool _cacheValid; //!< Determines whether the cached values are usable
+	std::unordered_map<PositionKey, double, PositionKeyHash> _cache; //!< Memoized profile values of the current time point
+
+#ifdef CADET_PARALLELIZE
+	tbb::spin_mutex _mutex; //!< Synchronizes cache access of concurrently evaluated unit operations
+#endif
+};
+
+} // namespace model
+} // namespace cadet
+
+#endif  // LIBCADET_CACHEDEXTERNALFUNCTION_HPP_
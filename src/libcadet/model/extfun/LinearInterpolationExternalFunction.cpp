@@ -140,6 +140,9 @@ public:
 		return (_dataY[idx + 1] - _dataY[idx]) / (_time[idx + 1] - _time[idx]);
 	}
 
+	// The profile only depends on the transformed time (1 - z) / velocity + t
+	virtual bool dependsOnRadialPosition() const CADET_NOEXCEPT { return false; }
+
 private:
 	double _velocity; //!< Velocity of the movement of the external profile in [1/s] (normalized by column length)
 	std::vector<double> _dataY; //!< External profile data points (function values)
@@ -132,6 +132,9 @@ public:
 		return _lin[idx] + tShift * (2.0 * _quad[idx] + tShift * 3.0 * _cub[idx]);
 	}
 
+	// The profile only depends on the transformed time (1 - z) / velocity + t
+	virtual bool dependsOnRadialPosition() const CADET_NOEXCEPT { return false; }
+
 	virtual void setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections) CADET_NOEXCEPT { }
 
 private:
@@ -23,6 +23,7 @@
 #include <unordered_map>
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <limits>
 #include <string>
 #include <sstream>
@@ -34,6 +35,30 @@ namespace cadet
 namespace model
 {
 
+namespace
+{
+	/**
+	 * @brief Coefficient arrays of a single polynomial section
+	 */
+	struct SectionCoefficients
+	{
+		std::vector<double> cons;
+		std::vector<double> lin;
+		std::vector<double> quad;
+		std::vector<double> cub;
+	};
+
+	/**
+	 * @brief Returns the name of the parameter scope of the given section (e.g., @c sec_003)
+	 */
+	inline std::string sectionScopeName(unsigned int sec)
+	{
+		std::ostringstream oss;
+		oss << "sec_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << sec;
+		return oss.str();
+	}
+}
+
 /**
  * @brief A piecewise cubic polynomial inlet profile
  * @details On each section, a cubic polynomial is given as profile of each component.
@@ -47,10 +72,11 @@ class PiecewiseCubicPolyInlet : public cadet::IInletProfile
 {
 public:
 #if CADET_COMPILETIME_HASH
-	PiecewiseCubicPolyInlet() { }
+	PiecewiseCubicPolyInlet() : _cachedSec(_invalidSection) { }
 #else
 	PiecewiseCubicPolyInlet() : _hashCons(hashString("CONST_COEFF")), _hashLin(hashString("LIN_COEFF")),
-		_hashQuad(hashString("QUAD_COEFF")), _hashCub(hashString("CUBE_COEFF")), _hashSectionTimes(hashString("SECTION_TIMES"))
+		_hashQuad(hashString("QUAD_COEFF")), _hashCub(hashString("CUBE_COEFF")), _hashSectionTimes(hashString("SECTION_TIMES")),
+		_cachedSec(_invalidSection)
 	{
 	}
 #endif
@@ -90,17 +116,57 @@ public:
 
 		cadet_assert(sec < _sectionTimes.size());
 
-		const double tShift = t - _sectionTimes[sec];
-		const unsigned int wrapSec = sec % (_const.size()/_nComp);
-
-		double const* const con = _const.data() + wrapSec * _nComp;
-		double const* const lin = _lin.data() + wrapSec * _nComp;
-		double const* const quad = _quad.data() + wrapSec * _nComp;
-		double const* const cub = _cub.data() + wrapSec * _nComp;
+		const double tShift = updateCachedSection(t, sec);
 
 		// Evaluate polynomial using Horner's scheme
 		for (unsigned int comp = 0; comp < _nComp; ++comp)
-			inletConc[comp] = con[comp] + tShift * (lin[comp] + tShift * (quad[comp] + tShift * cub[comp]));
+			inletConc[comp] = _cachedCon[comp] + tShift * (_cachedLin[comp] + tShift * (_cachedQuad[comp] + tShift * _cachedCub[comp]));
+	}
+
+	virtual void inletConcentrationAndDerivative(double t, unsigned int sec, double* inletConc, double* inletDeriv)
+	{
+		cadet_assert(sec < _sectionTimes.size());
+
+		const double tShift = updateCachedSection(t, sec);
+
+		// Evaluate polynomial and its time derivative in one Horner pass sharing the coefficient loads
+		for (unsigned int comp = 0; comp < _nComp; ++comp)
+		{
+			const double lin = _cachedLin[comp];
+			const double quad = _cachedQuad[comp];
+			const double cub = _cachedCub[comp];
+			inletConc[comp] = _cachedCon[comp] + tShift * (lin + tShift * (quad + tShift * cub));
+			inletDeriv[comp] = lin + tShift * (2.0 * quad + tShift * 3.0 * cub);
+		}
+	}
+
+	virtual bool sectionTransitionJump(unsigned int sec, double* jump)
+	{
+		// The polynomial pieces are known in closed form, so the one-sided limits at the
+		// boundary and, hence, the jump are exact: the left limit is the previous piece
+		// evaluated at the full section width, the right limit is the constant coefficient
+		// of the entered piece
+		if ((sec == 0) || (_sectionTimes.size() < 2) || (sec >= _sectionTimes.size() - 1) || _const.empty() || (_nComp == 0))
+			return false;
+
+		const unsigned int numCoeffSec = _const.size() / _nComp;
+		const unsigned int wrapPrev = (sec - 1) % numCoeffSec;
+		const unsigned int wrapCur = sec % numCoeffSec;
+		const double dt = _sectionTimes[sec] - _sectionTimes[sec - 1];
+
+		double const* const prevCon = _const.data() + wrapPrev * _nComp;
+		double const* const prevLin = _lin.data() + wrapPrev * _nComp;
+		double const* const prevQuad = _quad.data() + wrapPrev * _nComp;
+		double const* const prevCub = _cub.data() + wrapPrev * _nComp;
+		double const* const curCon = _const.data() + wrapCur * _nComp;
+
+		for (unsigned int comp = 0; comp < _nComp; ++comp)
+		{
+			const double leftLimit = prevCon[comp] + dt * (prevLin[comp] + dt * (prevQuad[comp] + dt * prevCub[comp]));
+			jump[comp] = curCon[comp] - leftLimit;
+		}
+
+		return true;
 	}
 
 	virtual void parameterDerivative(double t, unsigned int sec, const cadet::ParameterId& pId, double* paramDeriv)
@@ -168,16 +234,11 @@ public:
 	{
 		cadet_assert(sec < _sectionTimes.size());
 
-		const double tShift = t - _sectionTimes[sec];
-		const unsigned int wrapSec = sec % (_const.size()/_nComp);
-
-		double const* const lin = _lin.data() + wrapSec * _nComp;
-		double const* const quad = _quad.data() + wrapSec * _nComp;
-		double const* const cub = _cub.data() + wrapSec * _nComp;
+		const double tShift = updateCachedSection(t, sec);
 
 		// Evaluate polynomial using Horner's scheme
 		for (unsigned int comp = 0; comp < _nComp; ++comp)
-			timeDerivative[comp] = lin[comp] + tShift * (2.0 * quad[comp] + tShift * 3.0 * cub[comp]);
+			timeDerivative[comp] = _cachedLin[comp] + tShift * (2.0 * _cachedQuad[comp] + tShift * 3.0 * _cachedCub[comp]);
 	}
 
 	virtual void timeParameterDerivative(double t, unsigned int sec, const ParameterId& pId, double* deriv)
@@ -337,27 +398,50 @@ public:
 		_const.clear();
 		_lin.clear();
 		_quad.clear();
-		_cub.clear();		
+		_cub.clear();
+
+		// The cached coefficient pointers are invalidated by reallocation of the coefficient vectors
+		_cachedSec = _invalidSection;
 
 		if (!paramProvider)
 			return false;
 
+		// Reads all coefficient arrays of one section scope
+		auto readSection = [paramProvider](const std::string& scope) -> SectionCoefficients
+		{
+			SectionCoefficients sc;
+			paramProvider->pushScope(scope);
+			sc.cons = paramProvider->getDoubleArray("CONST_COEFF");
+			sc.lin = paramProvider->getDoubleArray("LIN_COEFF");
+			sc.quad = paramProvider->getDoubleArray("QUAD_COEFF");
+			sc.cub = paramProvider->getDoubleArray("CUBE_COEFF");
+			paramProvider->popScope();
+			return sc;
+		};
+
+		if (!paramProvider->exists(sectionScopeName(0)))
+			return true;
+
+		// Prefetch pipeline: While the coefficients of the current section are appended to the
+		// coefficient vectors, a worker thread already reads the arrays of the next section.
+		// The parameter provider is only touched by one thread at a time: The main thread
+		// probes for the next section scope after the pending read has finished and before
+		// the next one is launched.
 		unsigned int i = 0;
-		std::ostringstream oss;
-		oss << "sec_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
-		while (paramProvider->exists(oss.str()))
+		std::future<SectionCoefficients> pending = std::async(std::launch::async, readSection, sectionScopeName(0));
+		while (true)
 		{
-			paramProvider->pushScope(oss.str());
+			SectionCoefficients sc = pending.get();
 
-			const std::vector<double> cons = paramProvider->getDoubleArray("CONST_COEFF");
-			const std::vector<double> lin = paramProvider->getDoubleArray("LIN_COEFF");
-			const std::vector<double> quad = paramProvider->getDoubleArray("QUAD_COEFF");
-			const std::vector<double> cub = paramProvider->getDoubleArray("CUBE_COEFF");
+			const std::string nextScope = sectionScopeName(i + 1);
+			const bool hasNext = paramProvider->exists(nextScope);
+			if (hasNext)
+				pending = std::async(std::launch::async, readSection, nextScope);
 
 			// Preallocate memory if possible
 			if ((i == 0) && (_sectionTimes.size() > 0))
 			{
-				const unsigned int nComp = cons.size();
+				const unsigned int nComp = sc.cons.size();
 
 				_const.reserve(nComp * _sectionTimes.size());
 				_lin.reserve(nComp * _sectionTimes.size());
@@ -365,22 +449,47 @@ public:
 				_cub.reserve(nComp * _sectionTimes.size());
 			}
 
-			_const.insert(_const.end(), cons.begin(), cons.end());
-			_lin.insert(_lin.end(), lin.begin(), lin.end());
-			_quad.insert(_quad.end(), quad.begin(), quad.end());
-			_cub.insert(_cub.end(), cub.begin(), cub.end());
+			_const.insert(_const.end(), sc.cons.begin(), sc.cons.end());
+			_lin.insert(_lin.end(), sc.lin.begin(), sc.lin.end());
+			_quad.insert(_quad.end(), sc.quad.begin(), sc.quad.end());
+			_cub.insert(_cub.end(), sc.cub.begin(), sc.cub.end());
 
-			paramProvider->popScope();
+			if (!hasNext)
+				break;
 
 			++i;
-			oss.str("");
-			oss << "sec_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
 		}
 		return true;
 	}
 
 private:
 
+	/**
+	 * @brief Updates the cached coefficient base pointers if the section has changed
+	 * @details Since consecutive evaluations usually happen in the same time section, the
+	 *          section wrapping and pointer arithmetic is only performed on section changes.
+	 *
+	 * @param [in] t Absolute simulation time
+	 * @param [in] sec Index of the current time section
+	 * @return Time shift @f$ t - t_{\text{sec}} @f$ into the current section
+	 */
+	inline double updateCachedSection(double t, unsigned int sec)
+	{
+		if (sec != _cachedSec)
+		{
+			const unsigned int wrapSec = sec % (_const.size() / _nComp);
+
+			_cachedCon = _const.data() + wrapSec * _nComp;
+			_cachedLin = _lin.data() + wrapSec * _nComp;
+			_cachedQuad = _quad.data() + wrapSec * _nComp;
+			_cachedCub = _cub.data() + wrapSec * _nComp;
+			_cachedSec = sec;
+		}
+		return t - _sectionTimes[sec];
+	}
+
+	static const unsigned int _invalidSection = static_cast<unsigned int>(-1);
+
 #if CADET_COMPILETIME_HASH
 	static const cadet::StringHash _hashCons = "CONST_COEFF"_hash;
 	static const cadet::StringHash _hashLin = "LIN_COEFF"_hash;
@@ -402,6 +511,12 @@ private:
 	std::vector<double> _lin;
 	std::vector<double> _quad;
 	std::vector<double> _cub;
+
+	unsigned int _cachedSec; //!< Section index of the cached coefficient pointers
+	double const* _cachedCon; //!< Constant coefficients of the cached section
+	double const* _cachedLin; //!< Linear coefficients of the cached section
+	double const* _cachedQuad; //!< Quadratic coefficients of the cached section
+	double const* _cachedCub; //!< Cubic coefficients of the cached section
 };
 
 namespace inlet
@@ -20,7 +20,7 @@ namespace cadet
 namespace nonlin
 {
 
-AdaptiveTrustRegionNewtonSolver::AdaptiveTrustRegionNewtonSolver() : _initDamping(1e-2), _minDamping(1e-4), _maxIter(50) { }
+AdaptiveTrustRegionNewtonSolver::AdaptiveTrustRegionNewtonSolver() : _initDamping(1e-2), _minDamping(1e-4), _maxIter(50), _maxSecantIter(8) { }
 AdaptiveTrustRegionNewtonSolver::~AdaptiveTrustRegionNewtonSolver() { }
 
 bool AdaptiveTrustRegionNewtonSolver::configure(IParameterProvider& paramProvider)
@@ -31,6 +31,8 @@ bool AdaptiveTrustRegionNewtonSolver::configure(IParameterProvider& paramProvide
 		_minDamping = paramProvider.getDouble("MIN_DAMPING");
 	if (paramProvider.exists("MAX_ITERATIONS"))
 		_maxIter = paramProvider.getInt("MAX_ITERATIONS");
+	if (paramProvider.exists("MAX_SECANT_ITERATIONS"))
+		_maxSecantIter = paramProvider.getInt("MAX_SECANT_ITERATIONS");
 	return true;
 }
 
@@ -40,7 +42,10 @@ bool AdaptiveTrustRegionNewtonSolver::solve(std::function<bool(double const* con
 	return adaptiveTrustRegionNewtonMethod(residual, [&](double const* const x, double* const y) -> bool {
 			return jacobian(x, jacMatrix) && jacMatrix.factorize() && jacMatrix.solve(y);
 		},
-		_maxIter, tol, _initDamping, _minDamping, point, workingMemory, size);
+		[&](double* const y) -> bool {
+			return jacMatrix.solve(y);
+		},
+		_maxSecantIter, _maxIter, tol, _initDamping, _minDamping, point, workingMemory, size);
 }
 
 
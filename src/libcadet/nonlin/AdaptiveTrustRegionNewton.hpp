@@ -93,12 +93,24 @@ namespace nonlin
 	 *             On exit, the solution of the linear system is returned in-place in @f$ r @f$ which on entry
 	 *             contains the right hand side vector of the linear system.
 	 *             If an error is indicated by returning @c false, the algorithm aborts with failure.
+	 * @param [in] jacobianResolver Function calculating the solution of the linear system @f$ J_f(x) \Delta x = r@f$
+	 *             with the Jacobian matrix of the last @p jacobianSolver call for a given right hand side @f$ r @f$.
+	 *             The signature of the function is
+	 *             `bool jacobianResolver(double* const r)`
+	 *             where the return value communicates whether the system has been solved correctly.
+	 *             On exit, the solution of the linear system is returned in-place in @f$ r @f$.
+	 *             Only required if @p maxSecantIter is positive; may be empty otherwise.
+	 * @param [in] maxSecantIter Maximum number of consecutive quasi-Newton (Broyden rank-one update) iterations
+	 *             performed on one Jacobian factorization before the true Jacobian is evaluated and factorized
+	 *             again; @c 0 disables quasi-Newton iterations
 	 * @param [in] maxIter Maximum number of iterations
 	 * @param [in] resTol Termination criterion on the residual @f$\ell^2@f$-norm
 	 * @param [in] damping Initial damping factor (see details for advice)
 	 * @param [in] minDamping Minimal damping factor (see details for advice)
 	 * @param [in,out] point On entry initial guess, on exit solution or last iterate
-	 * @param [in] workingMemory Additional memory of size @f$ 4n @f$ required for performing the iterations, where @f$ n @f$ is the problem @p size
+	 * @param [in] workingMemory Additional memory of size @f$ (5 + \text{maxSecantIter}) n + \text{maxSecantIter} + 1 @f$
+	 *             required for performing the iterations, where @f$ n @f$ is the problem @p size; if @p maxSecantIter
+	 *             is @c 0, a size of @f$ 4n @f$ suffices
 	 * @param [in] size Size of the problem (i.e., number of equations, length of residual, columns of Jacobian etc.)
 	 * @tparam IterateOutputPolicy Policy that handles output of intermediate values (useful for debugging), see VoidNewtonIterateOutputPolicy
 	 * @return @c true if a solution meeting the residual tolerance was found, @c false otherwise
@@ -107,9 +119,10 @@ namespace nonlin
 	 */
 	template <typename IterateOutputPolicy = VoidNewtonIterateOutputPolicy>
 	bool adaptiveTrustRegionNewtonMethod(std::function<bool(double const* const, double* const)> residual, std::function<bool(double const* const, double* const)> jacobianSolver,
+		std::function<bool(double* const)> jacobianResolver, unsigned int maxSecantIter,
 		unsigned int maxIter, double resTol, double damping, double minDamping, double* const point, double* const workingMemory, unsigned int size)
 	{
-		const double thetaMax = 0.25; // Determines whether switch to quasi-newton updates is performed (not implemented)
+		const double thetaMax = 0.25; // Determines whether switch to quasi-Newton updates is performed
 		const bool restricted = false; // Determines if restricted monotonicity test is used
 		double mu = 0.0;
 		double lastResidualNorm = 0.0;
@@ -207,10 +220,114 @@ namespace nonlin
 			std::copy(trialPoint, trialPoint + size, point);
 			std::copy(residualMem, residualMem + size, lastResidual);
 			std::copy(residualMem, residualMem + size, dx);
+
+			// Quasi-Newton phase (QNRES, see Deuflhard p. 134): If the full Newton step was
+			// accepted and achieved strong contraction, continue with rank-one Broyden updates
+			// of the current Jacobian factorization instead of refactorizing in each iteration.
+			// Since a full step satisfies J_k s_k = -F_k, Broyden's update reduces to
+			//     J_{k+1} = J_k + F_{k+1} s_k^T / ||s_k||^2
+			// and by the Sherman-Morrison formula
+			//     J_{k+1}^{-1} y = (I + s_{k+1} s_k^T / ||s_k||^2) J_k^{-1} y,
+			// so only the steps s_j and their squared norms have to be stored.
+			if ((maxSecantIter > 0) && (damping == 1.0) && (residualNorm <= thetaMax * lastResidualNorm))
+			{
+				double* const secant = workingMemory + 4 * size; //!< Quasi-Newton steps s_j
+				double* const secantNorms = secant + (maxSecantIter + 1) * size; //!< Squared norms ||s_j||^2
+
+				// The first secant step is the accepted full Newton step
+				secantNorms[0] = 0.0;
+				for (unsigned int i = 0; i < size; ++i)
+				{
+					secant[i] = -dx[i];
+					secantNorms[0] += sqr(secant[i]);
+				}
+
+				unsigned int numSec = 0;
+				while ((numSec < maxSecantIter) && (residualNorm > resTol) && (kIter + 1 < maxIter) && (secantNorms[numSec] > 0.0))
+				{
+					// Compute v = J_k^{-1} F_{k+1} from the base factorization and all previous updates
+					std::copy(lastResidual, lastResidual + size, dx);
+					if (!jacobianResolver(dx))
+						break;
+
+					for (unsigned int j = 0; j < numSec; ++j)
+					{
+						double const* const sJ = secant + j * size;
+						double const* const sJ1 = secant + (j + 1) * size;
+						double coeff = 0.0;
+						for (unsigned int i = 0; i < size; ++i)
+							coeff += sJ[i] * dx[i];
+						coeff /= secantNorms[j];
+						for (unsigned int i = 0; i < size; ++i)
+							dx[i] += coeff * sJ1[i];
+					}
+
+					// Next step s_{k+1} = -(||s_k||^2 / gamma) * v with gamma = ||s_k||^2 + s_k^T v
+					double const* const sK = secant + numSec * size;
+					double* const sK1 = secant + (numSec + 1) * size;
+					double gamma = secantNorms[numSec];
+					for (unsigned int i = 0; i < size; ++i)
+						gamma += sK[i] * dx[i];
+
+					// Guard against a (nearly) singular update
+					if (std::abs(gamma) <= 1e-14 * secantNorms[numSec])
+						break;
+
+					const double stepFactor = -secantNorms[numSec] / gamma;
+					secantNorms[numSec + 1] = 0.0;
+					for (unsigned int i = 0; i < size; ++i)
+					{
+						sK1[i] = stepFactor * dx[i];
+						secantNorms[numSec + 1] += sqr(sK1[i]);
+						trialPoint[i] = point[i] + sK1[i];
+					}
+
+					// Evaluate residual at the quasi-Newton iterate
+					if (!residual(trialPoint, residualMem))
+						return false;
+
+					const double newResidualNorm = linalg::l2Norm(residualMem, size);
+					++kIter;
+					IterateOutputPolicy::outerIteration(kIter + 1, newResidualNorm, residualMem, trialPoint, sK1, size);
+
+					// Leave the quasi-Newton phase and refactorize if residual monotonicity is violated
+					if (newResidualNorm >= residualNorm)
+						break;
+
+					// Accept the quasi-Newton step
+					std::copy(trialPoint, trialPoint + size, point);
+					std::copy(residualMem, residualMem + size, lastResidual);
+					lastResidualNorm = residualNorm;
+					residualNorm = newResidualNorm;
+					++numSec;
+
+					// Continue with full steps only while the contraction stays strong
+					if (residualNorm > thetaMax * lastResidualNorm)
+						break;
+				}
+
+				// Restore the invariant that dx holds the current residual for the next
+				// Jacobian evaluation and start the next outer iteration with a full step
+				std::copy(lastResidual, lastResidual + size, dx);
+				mu = 1.0;
+			}
 		}
 		return false;
 	}
 
+	/**
+	 * @brief Solves nonlinear equations using a residual oriented descent based global adaptive trust-region Newton method
+	 * @details Variant of adaptiveTrustRegionNewtonMethod() without quasi-Newton iterations, which evaluates
+	 *          and factorizes the Jacobian in every iteration. See the full overload for details.
+	 */
+	template <typename IterateOutputPolicy = VoidNewtonIterateOutputPolicy>
+	bool adaptiveTrustRegionNewtonMethod(std::function<bool(double const* const, double* const)> residual, std::function<bool(double const* const, double* const)> jacobianSolver,
+		unsigned int maxIter, double resTol, double damping, double minDamping, double* const point, double* const workingMemory, unsigned int size)
+	{
+		return adaptiveTrustRegionNewtonMethod<IterateOutputPolicy>(residual, jacobianSolver, std::function<bool(double* const)>(), 0,
+			maxIter, resTol, damping, minDamping, point, workingMemory, size);
+	}
+
 	/**
 	 * @brief Uses an adaptive trust-region Newton method for solving nonlinear equations
 	 * @details Wraps adaptiveTrustRegionNewtonMethod() function.
@@ -225,17 +342,18 @@ namespace nonlin
 		virtual const char* name() const { return AdaptiveTrustRegionNewtonSolver::identifier(); }
 		virtual bool configure(IParameterProvider& paramProvider);
 
-		virtual unsigned int workspaceSize(unsigned int problemSize) const { return 4 * problemSize; }
-		
-		virtual unsigned int numTuningParameters() const { return 3; }
+		virtual unsigned int workspaceSize(unsigned int problemSize) const { return (5 + _maxSecantIter) * problemSize + _maxSecantIter + 1; }
+
+		virtual unsigned int numTuningParameters() const { return 4; }
 
 		virtual bool solve(std::function<bool(double const* const, double* const)> residual, std::function<bool(double const* const, linalg::detail::DenseMatrixBase& jac)> jacobian,
 			double tol, double* const point, double* const workingMemory, linalg::detail::DenseMatrixBase& jacMatrix, unsigned int size) const;
-	
+
 	protected:
 		double _initDamping; //!< Initial damping factor
 		double _minDamping; //!< Minimal damping factor
 		unsigned int _maxIter; //!< Maximum number of iterations
+		unsigned int _maxSecantIter; //!< Maximum number of consecutive quasi-Newton iterations on one Jacobian factorization
 	};
 
 	/**
@@ -22,7 +22,7 @@ namespace cadet
 namespace nonlin
 {
 
-CompositeSolver::CompositeSolver() { }
+CompositeSolver::CompositeSolver() : _preferredSolver(0) { }
 CompositeSolver::~CompositeSolver()
 {
 	for (std::vector<Solver*>::iterator it = _solvers.begin(); it != _solvers.end(); ++it)
@@ -50,17 +50,37 @@ bool CompositeSolver::configure(IParameterProvider& paramProvider)
 		success = (*it)->configure(paramProvider) && success;
 	}
 
+	resizeStatistics();
 	return success;
 }
 
 bool CompositeSolver::solve(std::function<bool(double const* const, double* const)> residual, std::function<bool(double const* const, linalg::detail::DenseMatrixBase& jac)> jacobian,
 		double tol, double* const point, double* const workingMemory, linalg::detail::DenseMatrixBase& jacMatrix, unsigned int size) const
 {
-	bool success = true;
-	for (std::vector<Solver*>::const_iterator it = _solvers.begin(); it != _solvers.end(); ++it)
-		success = (*it)->solve(residual, jacobian, tol, point, workingMemory, jacMatrix, size) && success;
+	if (_solvers.empty())
+		return false;
 
-	return success;
+	// Start with the subsolver that succeeded last; this avoids wasting full failed solve
+	// attempts of subsolvers that systematically fail for the problems at hand. A failed
+	// attempt still leaves its last iterate in point, which serves as improved initial
+	// guess for the next subsolver in line.
+	const unsigned int numSolvers = _solvers.size();
+	const unsigned int preferred = std::min(_preferredSolver.load(), numSolvers - 1);
+
+	for (unsigned int i = 0; i < numSolvers; ++i)
+	{
+		const unsigned int idx = (i == 0) ? preferred : ((i <= preferred) ? i - 1 : i);
+
+		++_numAttempts[idx];
+		if (_solvers[idx]->solve(residual, jacobian, tol, point, workingMemory, jacMatrix, size))
+		{
+			++_numSuccess[idx];
+			_preferredSolver.store(idx);
+			return true;
+		}
+	}
+
+	return false;
 }
 
 unsigned int CompositeSolver::workspaceSize(unsigned int problemSize) const
@@ -84,6 +104,43 @@ void CompositeSolver::addSubsolver(Solver* const solver)
 	if (solver)
 	{
 		_solvers.push_back(solver);
+		resizeStatistics();
+	}
+}
+
+unsigned int CompositeSolver::numSolveAttempts(unsigned int idx) const
+{
+	return _numAttempts[idx].load();
+}
+
+unsigned int CompositeSolver::numSolveSuccesses(unsigned int idx) const
+{
+	return _numSuccess[idx].load();
+}
+
+void CompositeSolver::resetStatistics()
+{
+	_preferredSolver.store(0);
+	for (unsigned int i = 0; i < _solvers.size(); ++i)
+	{
+		_numAttempts[i].store(0);
+		_numSuccess[i].store(0);
+	}
+}
+
+/**
+ * @brief Reallocates the statistics counters to match the number of subsolvers
+ * @details All counters are reset to @c 0. Only called while subsolvers are added,
+ *          that is, before any concurrent solve() invocations.
+ */
+void CompositeSolver::resizeStatistics()
+{
+	_numAttempts.reset(new std::atomic<unsigned int>[_solvers.size()]);
+	_numSuccess.reset(new std::atomic<unsigned int>[_solvers.size()]);
+	for (unsigned int i = 0; i < _solvers.size(); ++i)
+	{
+		_numAttempts[i].store(0);
+		_numSuccess[i].store(0);
 	}
 }
 
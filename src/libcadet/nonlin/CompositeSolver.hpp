@@ -20,6 +20,8 @@
 
 #include "nonlin/Solver.hpp"
 #include <vector>
+#include <memory>
+#include <atomic>
 
 namespace cadet
 {
@@ -30,6 +32,14 @@ namespace nonlin
 	/**
 	 * @brief Applies multiple solvers subsequently
 	 * @details The CompositeSolver owns all its subsolvers and destroys them when it is destroyed.
+	 *
+	 *          The subsolver that solved the last problem is remembered and tried first on the
+	 *          next invocation. If it fails, the remaining subsolvers are applied in configured
+	 *          order until one of them succeeds. Since the same solver object is used for all
+	 *          cells of a unit operation (possibly concurrently), the memory is shared by all
+	 *          cells: once a subsolver has won, the systematically failing ones are skipped for
+	 *          the whole batch of solves. Attempt and success counts of each subsolver are
+	 *          recorded for tuning the subsolver order and settings.
 	 */
 	class CompositeSolver : public Solver
 	{
@@ -51,8 +61,44 @@ namespace nonlin
 
 		virtual void addSubsolver(Solver* const solver);
 
+		/**
+		 * @brief Returns the number of subsolvers
+		 * @return Number of subsolvers
+		 */
+		inline unsigned int numSubsolvers() const { return _solvers.size(); }
+
+		/**
+		 * @brief Returns the index of the subsolver that succeeded last and is tried first
+		 * @return Index of the preferred subsolver
+		 */
+		inline unsigned int preferredSubsolver() const { return _preferredSolver.load(); }
+
+		/**
+		 * @brief Returns the number of solve attempts of the given subsolver
+		 * @param [in] idx Index of the subsolver
+		 * @return Number of times the subsolver was invoked
+		 */
+		unsigned int numSolveAttempts(unsigned int idx) const;
+
+		/**
+		 * @brief Returns the number of successful solves of the given subsolver
+		 * @param [in] idx Index of the subsolver
+		 * @return Number of times the subsolver converged
+		 */
+		unsigned int numSolveSuccesses(unsigned int idx) const;
+
+		/**
+		 * @brief Resets all attempt and success counters and the preferred subsolver
+		 */
+		void resetStatistics();
+
 	protected:
 		std::vector<Solver*> _solvers;
+		mutable std::atomic<unsigned int> _preferredSolver; //!< Index of the subsolver that succeeded last, tried first in solve()
+		mutable std::unique_ptr<std::atomic<unsigned int>[]> _numAttempts; //!< Number of solve attempts per subsolver
+		mutable std::unique_ptr<std::atomic<unsigned int>[]> _numSuccess; //!< Number of successful solves per subsolver
+
+		void resizeStatistics();
 	};
 
 } // namespace nonlin
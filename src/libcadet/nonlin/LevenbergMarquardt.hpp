@@ -108,7 +108,8 @@ namespace nonlin
 	 * @param [in] resTol Termination criterion on the residual @f$\ell^2@f$-norm
 	 * @param [in] damping Initial damping factor (see details for advice)
 	 * @param [in,out] point On entry initial guess, on exit solution or last iterate
-	 * @param [in] workingMemory Additional memory of size @f$ 7n @f$ required for performing the iterations, where @f$ n @f$ is the problem @p size
+	 * @param [in] workingMemory Additional memory of size @f$ 7n + 2n^2 @f$ required for performing the iterations, where @f$ n @f$ is the problem @p size.
+	 *             The @f$ 2n^2 @f$ tail holds the augmented least squares system, which avoids heap allocations when the memory is taken from a preallocated pool
 	 * @param [in,out] jacMatrix Dense matrix used for storing and solving the linear systems (e.g., the Jacobian)
 	 * @param [in] size Size of the problem (i.e., number of equations, length of residual, columns of Jacobian etc.)
 	 * @tparam IterateOutputPolicy Policy that handles output of intermediate values (useful for debugging), see VoidLMIterateOutputPolicy
@@ -128,14 +129,15 @@ namespace nonlin
 		double* const dx = workingMemory + 3 * size;
 		double* const trialPoint = workingMemory + 4 * size;
 		double* const workspace = workingMemory + 5 * size; // 2 * size
+		double* const factoredJacMem = workingMemory + 7 * size; // 2 * size * size
 
 		unsigned int nTrials = 0;
 		const double tolOpt = resTol * 1e-4;
 
-		// Allocate matrix for linear least squares problems
+		// Matrix for linear least squares problems, stored in the working memory
 		// Upper part of matrix is the system Jacobian, lower part is identity matrix for damping
-		linalg::DenseMatrix factoredJac;
-		factoredJac.resize(2 * size, size);
+		// The QR solve in leastSquaresSolve() does not pivot, hence no pivot array is required
+		linalg::DenseMatrixView factoredJac(factoredJacMem, nullptr, 2 * size, size);
 
 		// Get residual and Jacobian
 		if (!residual(point, residualMem))
@@ -254,7 +256,7 @@ namespace nonlin
 		virtual const char* name() const { return LevenbergMarquardtSolver::identifier(); }
 		virtual bool configure(IParameterProvider& paramProvider);
 
-		virtual unsigned int workspaceSize(unsigned int problemSize) const { return 7 * problemSize; }
+		virtual unsigned int workspaceSize(unsigned int problemSize) const { return 7 * problemSize + 2 * problemSize * problemSize; }
 		
 		virtual unsigned int numTuningParameters() const { return 2; }
 
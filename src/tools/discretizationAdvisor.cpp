@@ -0,0 +1,409 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Profile-guided discretization advisor: runs an existing model file over a ladder of
+ * coarser spatial discretizations and reports the cheapest one whose outlet chromatogram
+ * stays within a user given accuracy bound of the model's own (reference) discretization.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <tclap/CmdLine.h>
+#include "common/TclapUtils.hpp"
+
+#include "cadet/cadet.hpp"
+#include "io/hdf5/HDF5Reader.hpp"
+#include "common/ParameterProviderImpl.hpp"
+#include "common/OverlayParameterProvider.hpp"
+#include "common/Driver.hpp"
+#include "common/Timer.hpp"
+
+namespace
+{
+
+/**
+ * @brief Spatial discretization settings of one unit operation as found in the model file
+ */
+struct UnitDisc
+{
+	unsigned int unit; //!< Unit operation index
+	int nCol; //!< Number of axial cells
+	int nPar; //!< Number of particle shells (-1 if the unit has no particle discretization)
+	int wenoOrder; //!< Configured WENO order (-1 if the unit has no weno group)
+};
+
+/**
+ * @brief One candidate discretization of the sweep
+ */
+struct Candidate
+{
+	double colFactor; //!< Fraction of the reference NCOL
+	double parFactor; //!< Fraction of the reference NPAR
+	int wenoOrder; //!< WENO order (-1 keeps the configured order)
+	double error; //!< Maximum relative L2 outlet error against the reference run
+	double simTime; //!< Wall clock time of the time integration in seconds
+	bool ok; //!< Whether the run completed
+};
+
+/**
+ * @brief Outlet chromatograms of one run
+ */
+struct OutletData
+{
+	std::vector<unsigned int> units; //!< Unit operation index of each recorded outlet
+	std::vector<unsigned int> nComp; //!< Number of recorded components of each outlet
+	std::vector<std::vector<double>> data; //!< Time major outlet data of each recorded unit
+};
+
+/**
+ * @brief Reads the discretization groups of all unit operations from the model file
+ */
+std::vector<UnitDisc> scanUnits(cadet::IParameterProvider& pp)
+{
+	std::vector<UnitDisc> units;
+
+	pp.pushScope("input");
+	pp.pushScope("model");
+	const int nUnits = pp.getInt("NUNITS");
+	for (int i = 0; i < nUnits; ++i)
+	{
+		std::ostringstream oss;
+		oss << "unit_" << std::setfill('0') << std::setw(3) << i;
+		if (!pp.exists(oss.str()))
+			continue;
+
+		pp.pushScope(oss.str());
+		if (pp.exists("discretization"))
+		{
+			pp.pushScope("discretization");
+
+			UnitDisc ud{static_cast<unsigned int>(i), -1, -1, -1};
+			if (pp.exists("NCOL"))
+				ud.nCol = pp.getInt("NCOL");
+			if (pp.exists("NPAR"))
+				ud.nPar = pp.getInt("NPAR");
+			if (pp.exists("weno"))
+			{
+				pp.pushScope("weno");
+				ud.wenoOrder = pp.getInt("WENO_ORDER");
+				pp.popScope();
+			}
+			if (ud.nCol > 0)
+				units.push_back(ud);
+
+			pp.popScope(); // discretization
+		}
+		pp.popScope(); // unit
+	}
+	pp.popScope(); // model
+	pp.popScope(); // input
+
+	return units;
+}
+
+/**
+ * @brief Scales an NCOL / NPAR value by a factor with a lower bound
+ */
+inline int scaleCells(int base, double factor, int minCells)
+{
+	return std::max(minCells, static_cast<int>(base * factor + 0.5));
+}
+
+/**
+ * @brief Runs the model with the given discretization overrides and collects outlet data
+ * @details Opens the file fresh for every run so that the overlay and the scope state of
+ *          the base provider start out clean.
+ * @return @c true if the run completed, @c false otherwise
+ */
+bool runModel(const std::string& fileName, const std::vector<UnitDisc>& units, double colFactor, double parFactor,
+	int wenoOrder, int minCol, int minPar, OutletData& out, double& simTime)
+{
+	cadet::Driver drv;
+
+	try
+	{
+		cadet::io::HDF5Reader rd;
+		rd.openFile(fileName, "r");
+
+		{
+			cadet::ParameterProviderImpl<cadet::io::HDF5Reader> pp(rd);
+			cadet::OverlayParameterProvider overlay(pp);
+
+			for (const UnitDisc& ud : units)
+			{
+				std::ostringstream oss;
+				oss << "input/model/unit_" << std::setfill('0') << std::setw(3) << ud.unit << "/discretization";
+				const std::string base = oss.str();
+
+				overlay.setInt(base + "/NCOL", scaleCells(ud.nCol, colFactor, minCol));
+				if (ud.nPar > 0)
+					overlay.setInt(base + "/NPAR", scaleCells(ud.nPar, parFactor, minPar));
+				if ((ud.wenoOrder > 0) && (wenoOrder > 0))
+					overlay.setInt(base + "/weno/WENO_ORDER", wenoOrder);
+			}
+
+			drv.configure(overlay);
+		}
+
+		rd.closeFile();
+
+		cadet::Timer timer;
+		timer.start();
+		drv.run();
+		simTime = timer.stop();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Run failed: " << e.what() << std::endl;
+		return false;
+	}
+
+	// Collect the outlet chromatograms of all units that record them
+	cadet::InternalStorageSystemRecorder const* const sysRec = drv.solution();
+	if (!sysRec)
+		return false;
+
+	out.units.clear();
+	out.nComp.clear();
+	out.data.clear();
+	for (unsigned int r = 0; r < sysRec->numRecorders(); ++r)
+	{
+		cadet::InternalStorageUnitOpRecorder const* const rec = sysRec->recorder(r);
+		if (!rec->solutionConfig().storeOutlet || (rec->numDataPoints() == 0) || (rec->numRecordedComponents() == 0))
+			continue;
+
+		const unsigned int n = rec->numDataPoints() * rec->numRecordedComponents();
+		out.units.push_back(rec->unitOperation());
+		out.nComp.push_back(rec->numRecordedComponents());
+		out.data.push_back(std::vector<double>(rec->outlet(), rec->outlet() + n));
+	}
+
+	return !out.data.empty();
+}
+
+/**
+ * @brief Computes the maximum relative L2 difference of the outlet chromatograms of two runs
+ * @details The error is evaluated per recorded unit and component and the maximum is
+ *          returned. The relative error of a component is the L2 norm of the difference
+ *          divided by the L2 norm of the reference curve; components whose reference curve
+ *          is identically zero are skipped.
+ */
+double outletError(const OutletData& ref, const OutletData& cand)
+{
+	double maxErr = 0.0;
+	for (std::size_t u = 0; u < ref.data.size(); ++u)
+	{
+		// Locate the same unit in the candidate run
+		std::size_t v = 0;
+		for (; v < cand.data.size(); ++v)
+		{
+			if ((cand.units[v] == ref.units[u]) && (cand.nComp[v] == ref.nComp[u]) && (cand.data[v].size() == ref.data[u].size()))
+				break;
+		}
+		if (v == cand.data.size())
+			return std::numeric_limits<double>::infinity();
+
+		const unsigned int nComp = ref.nComp[u];
+		const std::vector<double>& a = ref.data[u];
+		const std::vector<double>& b = cand.data[v];
+		for (unsigned int comp = 0; comp < nComp; ++comp)
+		{
+			double diff = 0.0;
+			double norm = 0.0;
+			for (std::size_t i = comp; i < a.size(); i += nComp)
+			{
+				const double d = a[i] - b[i];
+				diff += d * d;
+				norm += a[i] * a[i];
+			}
+			if (norm > 0.0)
+				maxErr = std::max(maxErr, std::sqrt(diff / norm));
+		}
+	}
+	return maxErr;
+}
+
+} // namespace
+
+struct ProgramOptions
+{
+	std::string fileName;
+	double targetError;
+	int minCol;
+	int minPar;
+	bool sweepWeno;
+};
+
+int main(int argc, char** argv)
+{
+	ProgramOptions opts;
+
+	try
+	{
+		TCLAP::CustomOutputWithoutVersion customOut("discretizationAdvisor");
+		TCLAP::CmdLine cmd("Runs a model file over a ladder of coarser spatial discretizations and reports the cheapest one meeting a target outlet accuracy", ' ', "1.0");
+		cmd.setOutput(&customOut);
+
+		cmd >> (new TCLAP::ValueArg<double>("e", "error", "Target relative L2 outlet error against the file's own discretization (default: 1e-3)", false, 1e-3, "Float"))->storeIn(&opts.targetError);
+		cmd >> (new TCLAP::ValueArg<int>("c", "mincol", "Minimum number of axial cells (default: 8)", false, 8, "Int"))->storeIn(&opts.minCol);
+		cmd >> (new TCLAP::ValueArg<int>("p", "minpar", "Minimum number of particle shells (default: 2)", false, 2, "Int"))->storeIn(&opts.minPar);
+		cmd >> (new TCLAP::SwitchArg("w", "weno", "Also sweep the WENO order (default: keep configured order)"))->storeIn(&opts.sweepWeno);
+		cmd >> (new TCLAP::UnlabeledValueArg<std::string>("input", "Model file (HDF5)", true, "", "File"))->storeIn(&opts.fileName);
+
+		cmd.parse(argc, argv);
+	}
+	catch (const TCLAP::ArgException& e)
+	{
+		std::cerr << "ERROR: " << e.error() << " for argument " << e.argId() << std::endl;
+		return 1;
+	}
+
+	// Read the discretization of the model file; it serves as the accuracy reference
+	std::vector<UnitDisc> units;
+	try
+	{
+		cadet::io::HDF5Reader rd;
+		rd.openFile(opts.fileName, "r");
+		cadet::ParameterProviderImpl<cadet::io::HDF5Reader> pp(rd);
+		units = scanUnits(pp);
+		rd.closeFile();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Failed to read " << opts.fileName << ": " << e.what() << std::endl;
+		return 1;
+	}
+
+	if (units.empty())
+	{
+		std::cerr << "No unit operation with a spatial discretization found in " << opts.fileName << std::endl;
+		return 1;
+	}
+
+	std::cout << "Reference discretization:" << std::endl;
+	for (const UnitDisc& ud : units)
+	{
+		std::cout << "  unit " << ud.unit << ": NCOL = " << ud.nCol;
+		if (ud.nPar > 0)
+			std::cout << ", NPAR = " << ud.nPar;
+		if (ud.wenoOrder > 0)
+			std::cout << ", WENO order " << ud.wenoOrder;
+		std::cout << std::endl;
+	}
+
+	// Reference run with the file's own discretization
+	OutletData refData;
+	double refTime = 0.0;
+	if (!runModel(opts.fileName, units, 1.0, 1.0, -1, opts.minCol, opts.minPar, refData, refTime))
+	{
+		std::cerr << "Reference run failed or the model does not record any outlet "
+			"(enable WRITE_SOLUTION_OUTLET for at least one unit)" << std::endl;
+		return 1;
+	}
+	std::cout << "Reference run: " << refTime << " s" << std::endl << std::endl;
+
+	// Ladder of coarsening factors; duplicates after rounding are run only once
+	const double colFactors[] = {0.25, 0.375, 0.5, 0.75, 1.0};
+	const double parFactors[] = {0.5, 0.75, 1.0};
+	std::vector<int> wenoOrders(1, -1);
+	if (opts.sweepWeno)
+	{
+		// WENO orders 1 to 3 as implemented by the library
+		wenoOrders.clear();
+		for (int o = 1; o <= 3; ++o)
+			wenoOrders.push_back(o);
+	}
+
+	std::vector<Candidate> results;
+	std::set<std::string> seen;
+	for (const double cf : colFactors)
+	{
+		for (const double pf : parFactors)
+		{
+			for (const int wo : wenoOrders)
+			{
+				// Skip candidates that round to an already tested cell layout
+				std::ostringstream key;
+				for (const UnitDisc& ud : units)
+				{
+					key << scaleCells(ud.nCol, cf, opts.minCol) << '/';
+					if (ud.nPar > 0)
+						key << scaleCells(ud.nPar, pf, opts.minPar) << '/';
+				}
+				key << wo;
+				if (!seen.insert(key.str()).second)
+					continue;
+
+				// The reference itself is not a candidate
+				if ((cf == 1.0) && (pf == 1.0) && (wo < 0))
+					continue;
+
+				Candidate cand{cf, pf, wo, 0.0, 0.0, false};
+				OutletData candData;
+				cand.ok = runModel(opts.fileName, units, cf, pf, wo, opts.minCol, opts.minPar, candData, cand.simTime);
+				if (cand.ok)
+					cand.error = outletError(refData, candData);
+				results.push_back(cand);
+
+				std::cout << std::setw(8) << (cand.ok ? cand.error : std::numeric_limits<double>::quiet_NaN())
+					<< "  " << std::setw(7) << cand.simTime << " s  NCOL x " << cf << ", NPAR x " << pf;
+				if (wo > 0)
+					std::cout << ", WENO order " << wo;
+				if (!cand.ok)
+					std::cout << "  [failed]";
+				std::cout << std::endl;
+			}
+		}
+	}
+
+	// Recommend the cheapest run (by measured wall time) that meets the accuracy bound
+	const Candidate* best = nullptr;
+	for (const Candidate& cand : results)
+	{
+		if (!cand.ok || (cand.error > opts.targetError))
+			continue;
+		if (!best || (cand.simTime < best->simTime))
+			best = &cand;
+	}
+
+	std::cout << std::endl;
+	if (!best || (best->simTime >= refTime))
+	{
+		std::cout << "No cheaper discretization meets the target error of " << opts.targetError
+			<< "; keep the file's own discretization" << std::endl;
+		return 0;
+	}
+
+	std::cout << "Recommended discretization (error " << best->error << ", " << best->simTime
+		<< " s instead of " << refTime << " s):" << std::endl;
+	for (const UnitDisc& ud : units)
+	{
+		std::cout << "  unit " << ud.unit << ": NCOL = " << scaleCells(ud.nCol, best->colFactor, opts.minCol);
+		if (ud.nPar > 0)
+			std::cout << ", NPAR = " << scaleCells(ud.nPar, best->parFactor, opts.minPar);
+		if (best->wenoOrder > 0)
+			std::cout << ", WENO order " << best->wenoOrder;
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
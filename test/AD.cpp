@@ -16,12 +16,18 @@
 #include <limits>
 #include <random>
 #include <chrono>
+#include <cstdint>
 
 #include "linalg/DenseMatrix.hpp"
 #include "linalg/BandMatrix.hpp"
+#include "linalg/SparseMatrix.hpp"
 #include "AdUtils.hpp"
+#include "MathUtil.hpp"
 #include "AutoDiff.hpp"
 
+#include "sfad.hpp"
+#include "setfad.hpp"
+
 ACTIVE_INIT;
 
 void checkMatrixAgainstLinearArray(double const* mat, const std::vector<double>& matRef);
@@ -169,3 +175,240 @@ TEST_CASE("Extract dense submatrix from banded Jacobian via AD", "[AD],[DenseMat
 	delete[] x;
 	delete[] res;
 }
+
+TEST_CASE("Extract sparse Jacobian via colored AD seeding", "[AD],[SparseMatrix]")
+{
+	// Each row r couples only to columns r and r + offDiag; the enclosing band has
+	// bandwidth offDiag + 1 whereas the coloring only needs two AD directions
+	const unsigned int matSize = 12;
+	const unsigned int offDiag = 5;
+
+	// Build the sparsity pattern with the Jacobian entries as values for reference
+	cadet::linalg::DoubleSparseMatrix coo;
+	coo.resize(2 * matSize);
+	double counter = 1.0;
+	for (unsigned int r = 0; r < matSize; ++r)
+	{
+		coo.addElement(r, r, counter);
+		counter += 1.0;
+		if (r + offDiag < matSize)
+		{
+			coo.addElement(r, r + offDiag, counter);
+			counter += 1.0;
+		}
+	}
+	cadet::linalg::CompressedSparseMatrix pattern(coo);
+
+	// Compute the coloring and check that it beats band compression
+	std::vector<unsigned int> colors;
+	const unsigned int numColors = cadet::ad::colorJacobianPattern(pattern, matSize, colors);
+	REQUIRE(numColors == 2);
+	REQUIRE(numColors < offDiag + 1);
+
+	// No two columns sharing a row may have the same color
+	const std::vector<unsigned int>& rowStart = pattern.rowStart();
+	const std::vector<unsigned int>& colIdx = pattern.cols();
+	for (unsigned int r = 0; r < pattern.rows(); ++r)
+	{
+		for (unsigned int i = rowStart[r]; i < rowStart[r + 1]; ++i)
+		{
+			for (unsigned int j = i + 1; j < rowStart[r + 1]; ++j)
+				CHECK(colors[colIdx[i]] != colors[colIdx[j]]);
+		}
+	}
+
+	// Initialize AD and allocate AD vectors
+	cadet::ad::setDirections(numColors);
+
+	cadet::active* res = new cadet::active[matSize];
+	cadet::active* x = new cadet::active[matSize];
+
+	// Set seed vectors and compute the residual matching the pattern
+	cadet::ad::prepareAdVectorSeedsForColoredPattern(x, 0, colors);
+	counter = 1.0;
+	for (unsigned int r = 0; r < matSize; ++r)
+	{
+		res[r] += counter * x[r];
+		counter += 1.0;
+		if (r + offDiag < matSize)
+		{
+			res[r] += counter * x[r + offDiag];
+			counter += 1.0;
+		}
+	}
+
+	// Extract the sparse Jacobian from AD and compare against the reference values
+	cadet::linalg::CompressedSparseMatrix jac(coo);
+	std::fill(jac.values().begin(), jac.values().end(), 0.0);
+	cadet::ad::extractSparseJacobianFromAd(res, 0, colors, jac);
+
+	for (unsigned int i = 0; i < jac.numNonZero(); ++i)
+		CHECK(jac.values()[i] == pattern.values()[i]);
+
+	delete[] x;
+	delete[] res;
+}
+
+TEST_CASE("Expression template AD type matches eager AD type", "[AD]")
+{
+	typedef sfad::Fwd<double, sfad::StackStorage> eager_t;
+	typedef sfad::FwdET<double, sfad::StackStorage> et_t;
+
+	const unsigned int numDirs = 3;
+	cadet::ad::setDirections(numDirs);
+
+	// Same values and seed directions for both AD types
+	const double vals[3] = {1.3, 0.8, 2.1};
+	eager_t ea[3];
+	et_t et[3];
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		ea[i] = vals[i];
+		ea[i].setADValue(i, 1.0);
+		et[i] = vals[i];
+		et[i].setADValue(i, 1.0);
+	}
+
+	// SMA-like flux expression with chained arithmetics and math functions
+	const eager_t resEager = 3.5 * ea[0] * pow(ea[1], 2.5) / (1.0 + ea[2]) - exp(-ea[0] * ea[1]) + sqr(ea[1] - ea[2]) + fmax(ea[0], ea[1] * ea[2]);
+	const et_t resEt = 3.5 * et[0] * pow(et[1], 2.5) / (1.0 + et[2]) - exp(-et[0] * et[1]) + sqr(et[1] - et[2]) + fmax(et[0], et[1] * et[2]);
+
+	CHECK(resEt.getValue() == Approx(resEager.getValue()));
+	for (unsigned int i = 0; i < numDirs; ++i)
+		CHECK(resEt.getADValue(i) == Approx(resEager.getADValue(i)));
+
+	// Gradient storage is padded and aligned for vectorized direction loops
+	CHECK(reinterpret_cast<std::uintptr_t>(&et[0][0]) % SFAD_ALIGNMENT == 0);
+	CHECK(SFAD_PADDED_DIR % SFAD_SIMD_WIDTH == 0);
+}
+
+TEST_CASE("Branchless AD selection matches branchy min and max", "[AD]")
+{
+	typedef sfad::Fwd<double, sfad::StackStorage> eager_t;
+	typedef sfad::FwdET<double, sfad::StackStorage> et_t;
+
+	const unsigned int numDirs = 3;
+	cadet::ad::setDirections(numDirs);
+
+	eager_t ea[2];
+	et_t et[2];
+	const double vals[2] = {1.25, -0.5};
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		ea[i] = vals[i];
+		ea[i].setADValue(i, 2.0 + i);
+		et[i] = vals[i];
+		et[i].setADValue(i, 2.0 + i);
+	}
+
+	SECTION("Away from ties smax and smin agree with fmax and fmin")
+	{
+		const eager_t branchyMax = fmax(ea[0], ea[1]);
+		const eager_t branchlessMax = smax(ea[0], ea[1]);
+		const eager_t branchyMin = fmin(ea[0], ea[1]);
+		const eager_t branchlessMin = smin(ea[0], ea[1]);
+
+		CHECK(branchlessMax.getValue() == branchyMax.getValue());
+		CHECK(branchlessMin.getValue() == branchyMin.getValue());
+		for (unsigned int dir = 0; dir < numDirs; ++dir)
+		{
+			CHECK(branchlessMax.getADValue(dir) == branchyMax.getADValue(dir));
+			CHECK(branchlessMin.getADValue(dir) == branchyMin.getADValue(dir));
+		}
+
+		// Expression template type produces the same results
+		const et_t etMax = smax(et[0], et[1]);
+		const et_t etMin = smin(et[0], et[1]);
+		CHECK(etMax.getValue() == branchlessMax.getValue());
+		CHECK(etMin.getValue() == branchlessMin.getValue());
+		for (unsigned int dir = 0; dir < numDirs; ++dir)
+		{
+			CHECK(etMax.getADValue(dir) == branchlessMax.getADValue(dir));
+			CHECK(etMin.getADValue(dir) == branchlessMin.getADValue(dir));
+		}
+	}
+
+	SECTION("Scalar operands zero the gradient of the losing side")
+	{
+		const eager_t upper = smin(ea[0], 1.0);
+		CHECK(upper.getValue() == 1.0);
+		for (unsigned int dir = 0; dir < numDirs; ++dir)
+			CHECK(upper.getADValue(dir) == 0.0);
+
+		const eager_t lower = smax(0.0, ea[1]);
+		CHECK(lower.getValue() == 0.0);
+		for (unsigned int dir = 0; dir < numDirs; ++dir)
+			CHECK(lower.getADValue(dir) == 0.0);
+	}
+
+	SECTION("Ties keep the gradient of the first AD argument")
+	{
+		eager_t twin;
+		twin = ea[0].getValue();
+		twin.setADValue(1, 7.0);
+
+		const eager_t tieMax = smax(ea[0], twin);
+		CHECK(tieMax.getValue() == ea[0].getValue());
+		for (unsigned int dir = 0; dir < numDirs; ++dir)
+			CHECK(tieMax.getADValue(dir) == ea[0].getADValue(dir));
+	}
+
+	SECTION("sel applies the predicate uniformly to value and gradient")
+	{
+		const eager_t taken = sel(true, ea[0], ea[1]);
+		const eager_t notTaken = sel(false, ea[0], ea[1]);
+		CHECK(taken.getValue() == ea[0].getValue());
+		CHECK(notTaken.getValue() == ea[1].getValue());
+		for (unsigned int dir = 0; dir < numDirs; ++dir)
+		{
+			CHECK(taken.getADValue(dir) == ea[0].getADValue(dir));
+			CHECK(notTaken.getADValue(dir) == ea[1].getADValue(dir));
+		}
+
+		// The double counterpart allows the same code in templated kernels
+		CHECK(cadet::sel(true, 1.0, 2.0) == 1.0);
+		CHECK(cadet::sel(false, 1.0, 2.0) == 2.0);
+	}
+}
+
+TEST_CASE("Arena storage AD type matches stack storage type", "[AD]")
+{
+	typedef sfad::Fwd<double, sfad::StackStorage> stack_t;
+	typedef sfad::Fwd<double, sfad::ArenaStorage> arena_t;
+
+	// Switch the runtime direction count between a small Jacobian run and a large
+	// sensitivity run; the arena resizes its chunks accordingly
+	const unsigned int dirCounts[] = {3, 50};
+	for (unsigned int run = 0; run < 2; ++run)
+	{
+		const unsigned int numDirs = dirCounts[run];
+		cadet::ad::setDirections(numDirs);
+
+		stack_t sx[2];
+		arena_t ax[2];
+		for (unsigned int i = 0; i < 2; ++i)
+		{
+			sx[i] = 1.0 + 0.25 * i;
+			ax[i] = 1.0 + 0.25 * i;
+			for (unsigned int dir = 0; dir < numDirs; ++dir)
+			{
+				const double seed = std::sin(1.0 + i + dir);
+				sx[i].setADValue(dir, seed);
+				ax[i].setADValue(dir, seed);
+			}
+		}
+
+		const stack_t sRes = sx[0] * exp(-sx[1]) + sqrt(sx[0] / sx[1]);
+		const arena_t aRes = ax[0] * exp(-ax[1]) + sqrt(ax[0] / ax[1]);
+
+		CHECK(aRes.getValue() == Approx(sRes.getValue()));
+		for (unsigned int dir = 0; dir < numDirs; ++dir)
+			CHECK(aRes.getADValue(dir) == Approx(sRes.getADValue(dir)));
+
+		// Arena chunks keep the gradient arrays aligned
+		CHECK(reinterpret_cast<std::uintptr_t>(&ax[0][0]) % SFAD_ALIGNMENT == 0);
+		CHECK(reinterpret_cast<std::uintptr_t>(&ax[1][0]) % SFAD_ALIGNMENT == 0);
+	}
+
+	cadet::ad::setDirections(cadet::ad::getMaxDirections());
+}
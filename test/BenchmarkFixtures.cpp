@@ -0,0 +1,50 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <json.hpp>
+
+#define CADETTEST_JSONPARAMETERPROVIDER_NOFORWARD
+#include "BenchmarkModels.hpp"
+
+using json = nlohmann::json;
+
+namespace
+{
+	/**
+	 * @brief Returns the requested discretization field of the column unit operation
+	 */
+	inline int discretizationField(const cadet::JsonParameterProvider& jpp, const char* field)
+	{
+		return (*jpp.data())["model"]["unit_000"]["discretization"][field].get<int>();
+	}
+}
+
+TEST_CASE("Embedded LWE fixture matches the JSON builder", "[Fixture],[IO]")
+{
+	const cadet::JsonParameterProvider ref = createLWE();
+	const cadet::JsonParameterProvider emb = createEmbeddedLWE(discretizationField(ref, "NCOL"), discretizationField(ref, "NPAR"));
+	CHECK(*ref.data() == *emb.data());
+}
+
+TEST_CASE("Embedded linear benchmark fixture matches the JSON builder", "[Fixture],[IO]")
+{
+	for (int i = 0; i < 2; ++i)
+	{
+		const bool dynamicBinding = (i == 0);
+		const cadet::JsonParameterProvider ref = createLinearBenchmark(dynamicBinding);
+		const cadet::JsonParameterProvider emb = createEmbeddedLinearBenchmark(discretizationField(ref, "NCOL"), discretizationField(ref, "NPAR"), dynamicBinding);
+		CAPTURE(dynamicBinding);
+		CHECK(*ref.data() == *emb.data());
+	}
+}
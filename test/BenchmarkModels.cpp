@@ -0,0 +1,67 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <json.hpp>
+
+#define CADETTEST_JSONPARAMETERPROVIDER_NOFORWARD
+#include "BenchmarkModels.hpp"
+
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace
+{
+	#include "BenchmarkModelData.inc"
+
+	/**
+	 * @brief Decodes an embedded CBOR blob into a JSON document
+	 * @param [in] data Pointer to the blob
+	 * @param [in] size Size of the blob in bytes
+	 * @return Decoded JSON document
+	 */
+	inline json decodeBlob(const unsigned char* data, std::size_t size)
+	{
+		return json::from_cbor(std::vector<uint8_t>(data, data + size));
+	}
+
+	/**
+	 * @brief Sets the spatial discretization of the column unit operation of a system document
+	 * @param [in,out] config System document to change the discretization in
+	 * @param [in] nCol Number of axial cells
+	 * @param [in] nPar Number of particle shell cells
+	 */
+	inline void setDiscretization(json& config, int nCol, int nPar)
+	{
+		json& disc = config["model"]["unit_000"]["discretization"];
+		disc["NCOL"] = nCol;
+		disc["NPAR"] = nPar;
+	}
+}
+
+cadet::JsonParameterProvider createEmbeddedLWE(int nCol, int nPar)
+{
+	// Decode the blob only once and patch a copy of the cached document
+	static const json fixture = decodeBlob(lweCbor, sizeof(lweCbor));
+	json config = fixture;
+	setDiscretization(config, nCol, nPar);
+	return cadet::JsonParameterProvider(config);
+}
+
+cadet::JsonParameterProvider createEmbeddedLinearBenchmark(int nCol, int nPar, bool dynamicBinding)
+{
+	static const json fixture = decodeBlob(linearCbor, sizeof(linearCbor));
+	json config = fixture;
+	setDiscretization(config, nCol, nPar);
+	config["model"]["unit_000"]["adsorption"]["IS_KINETIC"] = (dynamicBinding ? 1 : 0);
+	return cadet::JsonParameterProvider(config);
+}
@@ -0,0 +1,45 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides canonical benchmark models as embedded binary fixtures.
+ *
+ * The model documents are shipped as CBOR blobs compiled into the binary (see
+ * BenchmarkModelData.inc) and decoded once on first use. Constructing a
+ * parameter provider from them takes microseconds and requires neither the
+ * filesystem nor HDF5, in contrast to the generator tools in src/tools.
+ */
+
+#ifndef CADETTEST_BENCHMARKMODELS_HPP_
+#define CADETTEST_BENCHMARKMODELS_HPP_
+
+#include "JsonParameterProvider.hpp"
+
+/**
+ * @brief Creates the canonical 4 component load-wash-elution GRM benchmark with SMA binding
+ * @param [in] nCol Number of axial cells
+ * @param [in] nPar Number of particle shell cells
+ * @return ParameterProvider with the benchmark model
+ */
+cadet::JsonParameterProvider createEmbeddedLWE(int nCol, int nPar);
+
+/**
+ * @brief Creates the canonical 1 component pulse injection GRM benchmark with linear binding
+ * @param [in] nCol Number of axial cells
+ * @param [in] nPar Number of particle shell cells
+ * @param [in] dynamicBinding Determines whether dynamic binding is used
+ * @return ParameterProvider with the benchmark model
+ */
+cadet::JsonParameterProvider createEmbeddedLinearBenchmark(int nCol, int nPar, bool dynamicBinding);
+
+#endif  // CADETTEST_BENCHMARKMODELS_HPP_
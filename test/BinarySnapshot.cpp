@@ -0,0 +1,123 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include "io/bin/BinaryWriter.hpp"
+#include "io/bin/BinaryReader.hpp"
+#include "io/IOException.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief Deletes the snapshot file when the test leaves scope
+	 */
+	class ScopedSnapshotFile
+	{
+	public:
+		ScopedSnapshotFile(const std::string& fileName) : _fileName(fileName) { }
+		~ScopedSnapshotFile() { std::remove(_fileName.c_str()); }
+		inline const std::string& name() const { return _fileName; }
+	private:
+		const std::string _fileName;
+	};
+}
+
+TEST_CASE("Binary snapshot roundtrip of scalars and vectors", "[BinarySnapshot],[IO]")
+{
+	const ScopedSnapshotFile file("testBinarySnapshotRoundtrip.bin");
+
+	{
+		cadet::io::BinaryWriter bw;
+		bw.openFile(file.name());
+
+		bw.setGroup("input/model");
+		bw.scalar<int>("NCOMP", 4);
+		bw.scalar<double>("COL_LENGTH", 0.017);
+		bw.scalar<std::string>("UNIT_TYPE", "GENERAL_RATE_MODEL");
+		bw.scalar<bool>("USE_ANALYTIC_JACOBIAN", true);
+		bw.vector<double>("INIT_C", std::vector<double>({ 1.0, 2.5, -3.0, 0.0 }));
+		bw.vector<int>("NBOUND", std::vector<int>({ 1, 0, 2, 1 }));
+		bw.vector<std::string>("NAMES", std::vector<std::string>({ "first", "", "a longer entry than the others" }));
+
+		bw.pushGroup("adsorption");
+		bw.vector<uint64_t>("SOME_IDS", std::vector<uint64_t>({ 0, 18446744073709551615ull, 42 }));
+		bw.popGroup();
+
+		bw.setGroup("input/solver");
+		bw.scalar<int>("NTHREADS", 1);
+
+		bw.closeFile();
+	}
+
+	cadet::io::BinaryReader br;
+	br.openFile(file.name());
+
+	br.setGroup("input");
+	CHECK(br.exists("model"));
+	CHECK(br.exists("solver"));
+	CHECK(!br.exists("return"));
+
+	br.pushGroup("model");
+	CHECK(br.scalar<int>("NCOMP") == 4);
+	CHECK(br.scalar<double>("COL_LENGTH") == 0.017);
+	CHECK(br.scalar<std::string>("UNIT_TYPE") == "GENERAL_RATE_MODEL");
+	CHECK(br.scalar<int>("USE_ANALYTIC_JACOBIAN") == 1);
+
+	CHECK(!br.isVector("NCOMP"));
+	CHECK(br.isVector("INIT_C"));
+
+	CHECK(br.vector<double>("INIT_C") == std::vector<double>({ 1.0, 2.5, -3.0, 0.0 }));
+	CHECK(br.vector<int>("NBOUND") == std::vector<int>({ 1, 0, 2, 1 }));
+	CHECK(br.vector<std::string>("NAMES") == std::vector<std::string>({ "first", "", "a longer entry than the others" }));
+	CHECK(br.scalar<double>("INIT_C", 2) == -3.0);
+
+	br.pushGroup("adsorption");
+	CHECK(br.vector<uint64_t>("SOME_IDS") == std::vector<uint64_t>({ 0, 18446744073709551615ull, 42 }));
+	br.popGroup();
+
+	br.setGroup("/input/solver");
+	CHECK(br.scalar<int>("NTHREADS") == 1);
+
+	br.closeFile();
+}
+
+TEST_CASE("Binary snapshot error handling", "[BinarySnapshot],[IO]")
+{
+	const ScopedSnapshotFile file("testBinarySnapshotErrors.bin");
+
+	{
+		cadet::io::BinaryWriter bw;
+		bw.openFile(file.name());
+		bw.setGroup("input");
+		bw.scalar<double>("VALUE", 1.0);
+		bw.closeFile();
+	}
+
+	cadet::io::BinaryReader br;
+	br.openFile(file.name());
+
+	br.setGroup("input");
+	CHECK_THROWS_AS(br.scalar<int>("VALUE"), cadet::io::IOException);
+	CHECK_THROWS_AS(br.vector<double>("MISSING"), cadet::io::IOException);
+	CHECK_THROWS_AS(br.pushGroup("VALUE"), cadet::io::IOException);
+	CHECK_THROWS_AS(br.setGroup("doesNotExist"), cadet::io::IOException);
+
+	br.closeFile();
+
+	// Opening a file that is not a snapshot has to fail
+	CHECK_THROWS_AS(br.openFile("testBinarySnapshotErrors.bin.doesNotExist"), cadet::io::IOException);
+}
@@ -0,0 +1,89 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <cstring>
+
+#include "CpuDispatch.hpp"
+
+namespace
+{
+	typedef int (*kernel_t)();
+
+	int scalarKernel() { return 0; }
+	int sse2Kernel() { return 1; }
+	int avx2Kernel() { return 2; }
+	int avx512Kernel() { return 3; }
+}
+
+TEST_CASE("Variant resolution picks the highest variant the level allows", "[CpuDispatch]")
+{
+	using cadet::dispatch::CpuLevel;
+
+	const cadet::dispatch::VariantTable<kernel_t> full = {&scalarKernel, &sse2Kernel, &avx2Kernel, &avx512Kernel};
+
+	CpuLevel chosen;
+	CHECK(cadet::dispatch::resolveVariant(full, CpuLevel::Scalar, chosen) == &scalarKernel);
+	CHECK(chosen == CpuLevel::Scalar);
+	CHECK(cadet::dispatch::resolveVariant(full, CpuLevel::Sse2, chosen) == &sse2Kernel);
+	CHECK(chosen == CpuLevel::Sse2);
+	CHECK(cadet::dispatch::resolveVariant(full, CpuLevel::Avx2, chosen) == &avx2Kernel);
+	CHECK(chosen == CpuLevel::Avx2);
+	CHECK(cadet::dispatch::resolveVariant(full, CpuLevel::Avx512, chosen) == &avx512Kernel);
+	CHECK(chosen == CpuLevel::Avx512);
+}
+
+TEST_CASE("Variant resolution falls through missing variants", "[CpuDispatch]")
+{
+	using cadet::dispatch::CpuLevel;
+
+	// Family that only ships scalar and AVX2 variants
+	const cadet::dispatch::VariantTable<kernel_t> sparse = {&scalarKernel, nullptr, &avx2Kernel, nullptr};
+
+	CpuLevel chosen;
+	CHECK(cadet::dispatch::resolveVariant(sparse, CpuLevel::Sse2, chosen) == &scalarKernel);
+	CHECK(chosen == CpuLevel::Scalar);
+	CHECK(cadet::dispatch::resolveVariant(sparse, CpuLevel::Avx2, chosen) == &avx2Kernel);
+	CHECK(chosen == CpuLevel::Avx2);
+
+	// An AVX-512 CPU uses the AVX2 variant if no AVX-512 variant exists
+	CHECK(cadet::dispatch::resolveVariant(sparse, CpuLevel::Avx512, chosen) == &avx2Kernel);
+	CHECK(chosen == CpuLevel::Avx2);
+}
+
+TEST_CASE("Dispatched kernels resolve against the active level and register themselves", "[CpuDispatch]")
+{
+	using cadet::dispatch::CpuLevel;
+
+	// The environment cap can only lower the detected level
+	CHECK(cadet::dispatch::activeCpuLevel() <= cadet::dispatch::detectedCpuLevel());
+
+	const cadet::dispatch::VariantTable<kernel_t> full = {&scalarKernel, &sse2Kernel, &avx2Kernel, &avx512Kernel};
+	const cadet::dispatch::DispatchedKernel<kernel_t> kernel("test-kernel", full);
+
+	// With all variants present the resolved level is exactly the active level
+	CHECK(kernel.level() == cadet::dispatch::activeCpuLevel());
+	CHECK(kernel.get()() == static_cast<int>(kernel.level()));
+
+	// The family shows up in the central registry with its resolved level
+	bool found = false;
+	for (const cadet::dispatch::KernelFamilyInfo& info : cadet::dispatch::registeredKernelFamilies())
+	{
+		if (std::strcmp(info.name, "test-kernel") == 0)
+		{
+			found = true;
+			CHECK(info.level == kernel.level());
+		}
+	}
+	CHECK(found);
+}
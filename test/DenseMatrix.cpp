@@ -167,6 +167,44 @@ TEST_CASE("DenseMatrix LU solves", "[DenseMatrix],[LinAlg]")
 	REQUIRE(cadet::linalg::linfNorm(y.data(), y.size()) <= 1e-13);
 }
 
+TEST_CASE("DenseMatrix batched factorization and solution", "[DenseMatrix],[LinAlg]")
+{
+	using cadet::linalg::DenseMatrix;
+	using cadet::linalg::DenseMatrixView;
+
+	const unsigned int numSystems = 5;
+	const unsigned int dim = 12;
+
+	// Assemble a batch of independent systems with known right hand sides
+	std::vector<DenseMatrix> mats;
+	std::vector<DenseMatrix> factMats;
+	std::vector<std::vector<double>> rhs;
+	for (unsigned int i = 0; i < numSystems; ++i)
+	{
+		mats.push_back(randomMatrix(dim, dim));
+		factMats.push_back(mats.back());
+		rhs.push_back(randomVector(dim));
+	}
+
+	std::vector<DenseMatrixView> views;
+	std::vector<double*> rhsPtr;
+	std::vector<std::vector<double>> sol = rhs;
+	for (unsigned int i = 0; i < numSystems; ++i)
+	{
+		views.push_back(DenseMatrixView(factMats[i].data(), factMats[i].pivot(), dim, dim));
+		rhsPtr.push_back(sol[i].data());
+	}
+
+	REQUIRE(cadet::linalg::batchedFactorizeSolve(views.data(), rhsPtr.data(), numSystems));
+
+	// Check the residuals of all systems
+	for (unsigned int i = 0; i < numSystems; ++i)
+	{
+		mats[i].multiplyVector(sol[i].data(), 1.0, -1.0, rhs[i].data());
+		CHECK(cadet::linalg::linfNorm(rhs[i].data(), rhs[i].size()) <= 1e-12);
+	}
+}
+
 TEST_CASE("DenseMatrix QR solves", "[DenseMatrix],[LinAlg]")
 {
 	using cadet::linalg::DenseMatrix;
@@ -360,6 +360,50 @@ void testJacobianWenoForwardBackward(int wenoOrder)
 	destroyModelBuilder(mb);
 }
 
+void testAnalyticJacobianAgainstAD(cadet::JsonParameterProvider& jpp)
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::model::GeneralRateModel* const grmAna = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder() - 1);
+	cadet::model::GeneralRateModel* const grmAD = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder() - 1);
+
+	// Enable AD
+	cadet::ad::setDirections(cadet::ad::getMaxDirections());
+	grmAD->useAnalyticJacobian(false);
+
+	cadet::active* adRes = new cadet::active[grmAD->numDofs()];
+	cadet::active* adY = new cadet::active[grmAD->numDofs()];
+
+	grmAD->prepareADvectors(adRes, adY, 0);
+
+	// Setup matrices
+	grmAna->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+	grmAD->notifyDiscontinuousSectionTransition(0.0, 0u, adRes, adY, 0u);
+
+	// Obtain memory for state, Jacobian multiply direction, Jacobian column
+	std::vector<double> y(grmAD->numDofs(), 0.0);
+	std::vector<double> jacDir(grmAD->numDofs(), 0.0);
+	std::vector<double> jacCol1(grmAD->numDofs(), 0.0);
+	std::vector<double> jacCol2(grmAD->numDofs(), 0.0);
+
+	// Fill state vector with some values
+	fillState(y.data(), [](unsigned int idx) { return std::abs(std::sin(idx * 0.13)) + 1e-4; }, grmAna->numDofs());
+
+	// Compute state Jacobian
+	grmAna->residualWithJacobian(0.0, 0u, 1.0, y.data(), nullptr, jacDir.data(), nullptr, nullptr, 0u);
+	grmAD->residualWithJacobian(0.0, 0u, 1.0, y.data(), nullptr, jacDir.data(), adRes, adY, 0u);
+	std::fill(jacDir.begin(), jacDir.end(), 0.0);
+
+	// Compare Jacobians
+	checkJacobianPatternFD(grmAna, grmAD, y.data(), jacDir.data(), jacCol1.data(), jacCol2.data());
+	compareJacobian(grmAna, grmAD, jacDir.data(), jacCol1.data(), jacCol2.data());
+
+	mb->destroyUnitOperation(grmAna);
+	mb->destroyUnitOperation(grmAD);
+	destroyModelBuilder(mb);
+}
+
 void testResidualBulkWenoForwardBackward(int wenoOrder)
 {
 	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
@@ -485,3 +529,61 @@ TEST_CASE("GeneralRateModel Jacobian forward vs backward flow", "[GRM],[UnitOp],
 	for (unsigned int i = 1; i < cadet::Weno::maxOrder(); ++i)
 		testJacobianWenoForwardBackward(i);
 }
+
+TEST_CASE("GeneralRateModel analytic Jacobian vs AD for multi-state SMA binding", "[GRM],[UnitOp],[Residual],[Jacobian]")
+{
+	cadet::JsonParameterProvider jpp = createGRMwithMSSMA();
+	testAnalyticJacobianAgainstAD(jpp);
+}
+
+TEST_CASE("GeneralRateModel analytic Jacobian vs AD for self association binding", "[GRM],[UnitOp],[Residual],[Jacobian]")
+{
+	cadet::JsonParameterProvider jpp = createGRMwithSelfAssociation();
+	testAnalyticJacobianAgainstAD(jpp);
+}
+
+TEST_CASE("GeneralRateModel transposed Jacobian satisfies adjoint identity", "[GRM],[UnitOp],[Jacobian]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createGRMwithLinear();
+	cadet::model::GeneralRateModel* const grm = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder() - 1);
+
+	// Setup matrices
+	grm->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+	const unsigned int n = grm->numDofs();
+	std::vector<double> y(n, 0.0);
+	std::vector<double> res(n, 0.0);
+
+	// Fill state vector with some values and assemble the state Jacobian
+	fillState(y.data(), [](unsigned int idx) { return std::abs(std::sin(idx * 0.13)) + 1e-4; }, n);
+	grm->residualWithJacobian(0.0, 0u, 1.0, y.data(), nullptr, res.data(), nullptr, nullptr, 0u);
+
+	// Prepare vectors for checking the adjoint identity (Jx, w) == (x, J^T w)
+	std::vector<double> x(n, 0.0);
+	std::vector<double> w(n, 0.0);
+	std::vector<double> jacX(n, 0.0);
+	std::vector<double> jacTW(n, 0.0);
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		x[i] = std::sin(0.23 * i + 0.4);
+		w[i] = std::cos(0.17 * i);
+	}
+
+	grm->multiplyWithJacobian(x.data(), jacX.data());
+	grm->multiplyWithJacobianTranspose(w.data(), jacTW.data());
+
+	double left = 0.0;
+	double right = 0.0;
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		left += jacX[i] * w[i];
+		right += x[i] * jacTW[i];
+	}
+	CHECK(left == Approx(right));
+
+	mb->destroyUnitOperation(grm);
+	destroyModelBuilder(mb);
+}
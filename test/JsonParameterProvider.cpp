@@ -321,7 +321,10 @@ json createGRMwithSMAJson()
 
 cadet::JsonParameterProvider createGRMwithSMA()
 {
-	return cadet::JsonParameterProvider(createGRMwithSMAJson());
+	// Assemble the document only once and hand out an independent copy on every
+	// call since the tests modify their provider in place
+	static const json fixture = createGRMwithSMAJson();
+	return cadet::JsonParameterProvider(fixture);
 }
 
 json createGRMwithLinearJson()
@@ -388,7 +391,152 @@ json createGRMwithLinearJson()
 
 cadet::JsonParameterProvider createGRMwithLinear()
 {
-	return cadet::JsonParameterProvider(createGRMwithLinearJson());
+	static const json fixture = createGRMwithLinearJson();
+	return cadet::JsonParameterProvider(fixture);
+}
+
+json createGRMwithMSSMAJson()
+{
+	json config;
+	config["UNIT_TYPE"] = std::string("GENERAL_RATE_MODEL");
+	config["NCOMP"] = 3;
+	config["VELOCITY"] = 5.75e-4;
+	config["COL_DISPERSION"] = 5.75e-8;
+	config["FILM_DIFFUSION"] = {6.9e-6, 6.9e-6, 6.9e-6};
+	config["PAR_DIFFUSION"] = {7e-10, 6.07e-11, 6.07e-11};
+	config["PAR_SURFDIFFUSION"] = {0.0, 0.0, 0.0, 0.0, 0.0};
+
+	// Geometry
+	config["COL_LENGTH"] = 0.014;
+	config["PAR_RADIUS"] = 4.5e-5;
+	config["COL_POROSITY"] = 0.37;
+	config["PAR_POROSITY"] = 0.75;
+
+	// Initial conditions
+	config["INIT_C"] = {50.0, 0.0, 0.0};
+	config["INIT_Q"] = {1.2e3, 0.0, 0.0, 0.0, 0.0};
+
+	// Adsorption
+	config["ADSORPTION_MODEL"] = std::string("MULTISTATE_STERIC_MASS_ACTION");
+	{
+		json ads;
+		ads["IS_KINETIC"] = 1;
+		ads["MSSMA_LAMBDA"] = 1.2e3;
+		ads["MSSMA_KA"] = {0.0, 35.5, 3.55, 1.59, 0.159};
+		ads["MSSMA_KD"] = {0.0, 1000.0, 100.0, 1000.0, 100.0};
+		ads["MSSMA_NU"] = {0.0, 4.7, 9.4, 5.29, 10.58};
+		ads["MSSMA_SIGMA"] = {0.0, 11.83, 23.66, 10.6, 21.2};
+		ads["MSSMA_RATES"] = {0.0, 0.0, 0.9, 0.8, 0.0, 0.0, 0.7, 0.6, 0.0};
+		config["adsorption"] = ads;
+	}
+
+	// Discretization
+	{
+		json disc;
+
+		disc["NCOL"] = 16;
+		disc["NPAR"] = 4;
+		disc["NBOUND"] = {1, 2, 2};
+
+		disc["PAR_DISC_TYPE"] = std::string("EQUIDISTANT_PAR");
+
+		disc["USE_ANALYTIC_JACOBIAN"] = true;
+		disc["MAX_KRYLOV"] = 0;
+		disc["GS_TYPE"] = 1;
+		disc["MAX_RESTARTS"] = 10;
+		disc["SCHUR_SAFETY"] = 1e-8;
+
+		// WENO
+		{
+			json weno;
+
+			weno["WENO_ORDER"] = 3;
+			weno["BOUNDARY_MODEL"] = 0;
+			weno["WENO_EPS"] = 1e-10;
+			disc["weno"] = weno;
+		}
+		config["discretization"] = disc;
+	}
+
+	return config;
+}
+
+cadet::JsonParameterProvider createGRMwithMSSMA()
+{
+	static const json fixture = createGRMwithMSSMAJson();
+	return cadet::JsonParameterProvider(fixture);
+}
+
+json createGRMwithSelfAssociationJson()
+{
+	json config;
+	config["UNIT_TYPE"] = std::string("GENERAL_RATE_MODEL");
+	config["NCOMP"] = 4;
+	config["VELOCITY"] = 5.75e-4;
+	config["COL_DISPERSION"] = 5.75e-8;
+	config["FILM_DIFFUSION"] = {6.9e-6, 6.9e-6, 6.9e-6, 6.9e-6};
+	config["PAR_DIFFUSION"] = {7e-10, 6.07e-11, 6.07e-11, 6.07e-11};
+	config["PAR_SURFDIFFUSION"] = {0.0, 0.0, 0.0, 0.0};
+
+	// Geometry
+	config["COL_LENGTH"] = 0.014;
+	config["PAR_RADIUS"] = 4.5e-5;
+	config["COL_POROSITY"] = 0.37;
+	config["PAR_POROSITY"] = 0.75;
+
+	// Initial conditions
+	config["INIT_C"] = {50.0, 0.0, 0.0, 0.0};
+	config["INIT_Q"] = {1.2e3, 0.0, 0.0, 0.0};
+
+	// Adsorption
+	config["ADSORPTION_MODEL"] = std::string("SELF_ASSOCIATION");
+	{
+		json ads;
+		ads["IS_KINETIC"] = 1;
+		ads["SAI_LAMBDA"] = 1.2e3;
+		ads["SAI_KA1"] = {0.0, 35.5, 1.59, 7.7};
+		ads["SAI_KA2"] = {0.0, 1.5, 2.0, 1.2};
+		ads["SAI_KD"] = {0.0, 1000.0, 1000.0, 1000.0};
+		ads["SAI_NU"] = {0.0, 4.7, 5.29, 3.7};
+		ads["SAI_SIGMA"] = {0.0, 11.83, 10.6, 10.0};
+		config["adsorption"] = ads;
+	}
+
+	// Discretization
+	{
+		json disc;
+
+		disc["NCOL"] = 16;
+		disc["NPAR"] = 4;
+		disc["NBOUND"] = {1, 1, 1, 1};
+
+		disc["PAR_DISC_TYPE"] = std::string("EQUIDISTANT_PAR");
+
+		disc["USE_ANALYTIC_JACOBIAN"] = true;
+		disc["MAX_KRYLOV"] = 0;
+		disc["GS_TYPE"] = 1;
+		disc["MAX_RESTARTS"] = 10;
+		disc["SCHUR_SAFETY"] = 1e-8;
+
+		// WENO
+		{
+			json weno;
+
+			weno["WENO_ORDER"] = 3;
+			weno["BOUNDARY_MODEL"] = 0;
+			weno["WENO_EPS"] = 1e-10;
+			disc["weno"] = weno;
+		}
+		config["discretization"] = disc;
+	}
+
+	return config;
+}
+
+cadet::JsonParameterProvider createGRMwithSelfAssociation()
+{
+	static const json fixture = createGRMwithSelfAssociationJson();
+	return cadet::JsonParameterProvider(fixture);
 }
 
 json createLWEJson()
@@ -544,12 +692,13 @@ json createLWEJson()
 
 cadet::JsonParameterProvider createLWE()
 {
-	return cadet::JsonParameterProvider(createLWEJson());
+	static const json fixture = createLWEJson();
+	return cadet::JsonParameterProvider(fixture);
 }
 
-cadet::JsonParameterProvider createLinearBenchmark(bool dynamicBinding)
+json createLinearBenchmarkJson()
 {
-	json config;	
+	json config;
 	// Model
 	{
 		json model;
@@ -580,7 +729,7 @@ cadet::JsonParameterProvider createLinearBenchmark(bool dynamicBinding)
 			grm["ADSORPTION_MODEL"] = std::string("LINEAR");
 			{
 				json ads;
-				ads["IS_KINETIC"] = (dynamicBinding ? 1 : 0);
+				ads["IS_KINETIC"] = 1;
 				ads["LIN_KA"] = {2.5};
 				ads["LIN_KD"] = {1.0};
 				grm["adsorption"] = ads;
@@ -745,5 +894,13 @@ cadet::JsonParameterProvider createLinearBenchmark(bool dynamicBinding)
 
 		config["solver"] = solver;
 	}
+	return config;
+}
+
+cadet::JsonParameterProvider createLinearBenchmark(bool dynamicBinding)
+{
+	static const json fixture = createLinearBenchmarkJson();
+	json config = fixture;
+	config["model"]["unit_000"]["adsorption"]["IS_KINETIC"] = (dynamicBinding ? 1 : 0);
 	return cadet::JsonParameterProvider(config);
 }
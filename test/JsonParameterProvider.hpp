@@ -91,6 +91,8 @@ std::ostream& operator<<(std::ostream& out, const JsonParameterProvider& jpp);
 
 cadet::JsonParameterProvider createGRMwithSMA();
 cadet::JsonParameterProvider createGRMwithLinear();
+cadet::JsonParameterProvider createGRMwithMSSMA();
+cadet::JsonParameterProvider createGRMwithSelfAssociation();
 cadet::JsonParameterProvider createLWE();
 cadet::JsonParameterProvider createLinearBenchmark(bool dynamicBinding);
 
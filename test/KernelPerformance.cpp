@@ -0,0 +1,243 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Performance assertions for the WENO reconstruction and stencil kernels.
+ * Absolute cells-per-second floors would depend on the machine running the
+ * test suite, so the tests calibrate against a streaming pass over the same
+ * data measured in the same process and assert that the kernels stay within
+ * a generous slowdown factor of it. The factors are chosen such that normal
+ * compiler and machine variation passes easily while order-of-magnitude
+ * regressions (e.g., an accidental allocation or copy per cell) fail.
+ */
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include "Weno.hpp"
+#include "Stencil.hpp"
+#include "MemoryPool.hpp"
+#include "common/Timer.hpp"
+
+namespace
+{
+	/**
+	 * @brief Fills an array with a smooth profile disturbed by a jump
+	 * @param [out] w Array to be filled
+	 * @param [in] nCells Number of cells
+	 */
+	void createTestProfile(double* w, unsigned int nCells)
+	{
+		for (unsigned int i = 0; i < nCells; ++i)
+			w[i] = std::sin(0.3 * i) + ((i > nCells / 2) ? 3.0 : 0.0);
+	}
+
+	/**
+	 * @brief Times a kernel and returns the best wall clock time of several runs
+	 * @details Taking the minimum over repetitions filters out scheduling noise.
+	 * @param [in] reps Number of timed repetitions
+	 * @param [in] kernel Functor to be timed
+	 * @return Shortest observed run time in seconds
+	 */
+	template <typename kernel_t>
+	double bestOf(unsigned int reps, kernel_t kernel)
+	{
+		double best = -1.0;
+		for (unsigned int r = 0; r < reps; ++r)
+		{
+			cadet::Timer timer;
+			timer.start();
+			kernel();
+			const double elapsed = timer.stop();
+			if ((best < 0.0) || (elapsed < best))
+				best = elapsed;
+		}
+		return best;
+	}
+
+	// Sink for kernel results that prevents the optimizer from removing the timed loops
+	volatile double g_sink = 0.0;
+
+	/**
+	 * @brief Measures the throughput of a plain streaming pass over the profile
+	 * @details Serves as machine speed calibration for the relative floors below.
+	 * @param [in] w Cell averages
+	 * @param [in] nCells Number of cells
+	 * @param [in] sweeps Number of passes over the data per timed run
+	 * @return Calibration throughput in cells per second
+	 */
+	double calibrationThroughput(double const* w, unsigned int nCells, unsigned int sweeps)
+	{
+		const double time = bestOf(5, [=]()
+			{
+				double acc = 0.0;
+				for (unsigned int s = 0; s < sweeps; ++s)
+				{
+					for (unsigned int i = 0; i < nCells; ++i)
+						acc += 0.25 * w[i] + acc * 1e-12;
+				}
+				g_sink = acc;
+			});
+		return static_cast<double>(nCells) * static_cast<double>(sweeps) / time;
+	}
+}
+
+TEST_CASE("WENO reconstruction throughput stays within calibrated floor", "[Weno],[Performance]")
+{
+	const unsigned int nCells = 1024;
+	const unsigned int sweeps = 200;
+	const double epsilon = 1e-10;
+
+	std::vector<double> w(nCells);
+	createTestProfile(w.data(), nCells);
+
+	const double calib = calibrationThroughput(w.data(), nCells, sweeps);
+	CAPTURE(calib);
+
+	// Admissible slowdown versus the streaming pass; higher orders evaluate
+	// more substencils and smoothness indicators per cell
+	const double slowdownFactor[3] = {32.0, 256.0, 1024.0};
+
+	std::vector<double> vm(nCells);
+	std::vector<double> Dvm(nCells * cadet::Weno::maxStencilSize());
+	std::vector<int> usedOrder(nCells);
+
+	for (int order = 1; order <= static_cast<int>(cadet::Weno::maxOrder()); ++order)
+	{
+		SECTION("Order " + std::to_string(order))
+		{
+			cadet::Weno weno;
+			weno.order(order);
+			weno.boundaryTreatment(cadet::Weno::BoundaryTreatment::ReduceOrder);
+
+			const double time = bestOf(5, [&]()
+				{
+					for (unsigned int s = 0; s < sweeps; ++s)
+					{
+						weno.reconstructStrip<false>(epsilon, nCells, w.data(), vm.data(), Dvm.data(), usedOrder.data());
+						g_sink = vm[nCells / 2];
+					}
+				});
+			const double cellsPerSec = static_cast<double>(nCells) * static_cast<double>(sweeps) / time;
+
+			CAPTURE(cellsPerSec);
+			CHECK(cellsPerSec >= calib / slowdownFactor[order - 1]);
+		}
+	}
+}
+
+TEST_CASE("Caching stencil advance throughput stays within calibrated floor", "[Weno],[Performance]")
+{
+	const unsigned int nCells = 1024;
+	const unsigned int sweeps = 200;
+	const unsigned int stencilSize = cadet::Weno::maxStencilSize();
+
+	std::vector<double> w(nCells);
+	createTestProfile(w.data(), nCells);
+
+	const double calib = calibrationThroughput(w.data(), nCells, sweeps);
+	CAPTURE(calib);
+
+	cadet::ArrayPool stencilMemory(sizeof(double) * stencilSize);
+
+	// Rotating the cache and summing the stencil touches every element per
+	// cell, hence the admissible slowdown scales with the stencil size
+	const double slowdownFactor = 8.0 * stencilSize;
+
+	const double time = bestOf(5, [&]()
+		{
+			for (unsigned int s = 0; s < sweeps; ++s)
+			{
+				cadet::CachingStencil<double, cadet::ArrayPool> stencil(stencilSize, stencilMemory, stencilSize / 2);
+
+				double acc = 0.0;
+				for (unsigned int i = 0; i < nCells; ++i)
+				{
+					stencil.advance(w[i]);
+					for (int j = -static_cast<int>(stencilSize / 2); j <= static_cast<int>(stencilSize / 2); ++j)
+						acc += stencil[j];
+				}
+				g_sink = acc;
+			}
+		});
+	const double cellsPerSec = static_cast<double>(nCells) * static_cast<double>(sweeps) / time;
+
+	CAPTURE(cellsPerSec);
+	CHECK(cellsPerSec >= calib / slowdownFactor);
+}
+
+TEST_CASE("Register stencil matches caching stencil and stays within calibrated floor", "[Weno],[Performance]")
+{
+	const unsigned int nCells = 1024;
+	const unsigned int sweeps = 200;
+	const unsigned int stencilSize = cadet::Weno::maxStencilSize();
+
+	std::vector<double> w(nCells);
+	createTestProfile(w.data(), nCells);
+
+	SECTION("Window agrees with CachingStencil after every advance")
+	{
+		cadet::ArrayPool stencilMemory(sizeof(double) * stencilSize);
+		cadet::CachingStencil<double, cadet::ArrayPool> reference(stencilSize, stencilMemory, stencilSize / 2);
+		cadet::RegisterStencil<2 * 3 - 1> stencil(stencilSize, stencilSize / 2);
+
+		for (unsigned int i = 0; i < 4 * stencilSize; ++i)
+		{
+			reference.advance(w[i]);
+			stencil.advance(w[i]);
+
+			// The window only holds defined values once it has been filled completely
+			if (i + 1 < stencilSize)
+				continue;
+
+			for (int j = -static_cast<int>(stencilSize / 2); j <= static_cast<int>(stencilSize / 2); ++j)
+				CHECK(stencil[j] == reference[j]);
+			for (unsigned int j = 0; j < stencilSize; ++j)
+				CHECK(stencil.native(j) == reference.native(j));
+		}
+	}
+
+	SECTION("Advance throughput")
+	{
+		const double calib = calibrationThroughput(w.data(), nCells, sweeps);
+		CAPTURE(calib);
+
+		// The register stencil avoids the memory pool indirection of the caching
+		// stencil, so a tighter slowdown factor is admissible
+		const double slowdownFactor = 4.0 * stencilSize;
+
+		const double time = bestOf(5, [&]()
+			{
+				for (unsigned int s = 0; s < sweeps; ++s)
+				{
+					cadet::RegisterStencil<2 * 3 - 1> stencil(stencilSize, stencilSize / 2);
+
+					double acc = 0.0;
+					for (unsigned int i = 0; i < nCells; ++i)
+					{
+						stencil.advance(w[i]);
+						for (int j = -static_cast<int>(stencilSize / 2); j <= static_cast<int>(stencilSize / 2); ++j)
+							acc += stencil[j];
+					}
+					g_sink = acc;
+				}
+			});
+		const double cellsPerSec = static_cast<double>(nCells) * static_cast<double>(sweeps) / time;
+
+		CAPTURE(cellsPerSec);
+		CHECK(cellsPerSec >= calib / slowdownFactor);
+	}
+}
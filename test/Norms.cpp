@@ -0,0 +1,95 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <vector>
+#include <cmath>
+
+#include "linalg/Norms.hpp"
+
+TEST_CASE("Norms match naive reference implementations", "[Norms],[LinAlg]")
+{
+	const unsigned int size = 259;
+
+	// Use an odd size so the remainder loops of the blocked kernels are exercised
+	std::vector<double> x(size, 0.0);
+	std::vector<double> y(size, 0.0);
+	std::vector<double> w(size, 0.0);
+	double refL1 = 0.0;
+	double refL2 = 0.0;
+	double refL2Diff = 0.0;
+	double refL2W = 0.0;
+	double refLinfW = 0.0;
+	for (unsigned int i = 0; i < size; ++i)
+	{
+		x[i] = std::sin(0.37 * i) * std::pow(-1.0, i);
+		y[i] = std::cos(0.23 * i);
+		w[i] = 1.5 + std::sin(0.11 * i);
+
+		refL1 += std::abs(x[i]);
+		refL2 += x[i] * x[i];
+		refL2Diff += (x[i] - y[i]) * (x[i] - y[i]);
+		refL2W += (x[i] / w[i]) * (x[i] / w[i]);
+		refLinfW = std::max(std::abs(x[i] / w[i]), refLinfW);
+	}
+
+	CHECK(cadet::linalg::l1Norm(x.data(), size) == Approx(refL1));
+	CHECK(cadet::linalg::l2NormSquared(x.data(), size) == Approx(refL2));
+	CHECK(cadet::linalg::l2NormSquaredDiff(x.data(), y.data(), size) == Approx(refL2Diff));
+	CHECK(cadet::linalg::l2normWeighted(x.data(), w.data(), size) == Approx(std::sqrt(refL2W)));
+	CHECK(cadet::linalg::linfNormWeighted(x.data(), w.data(), size) == Approx(refLinfW));
+}
+
+TEST_CASE("Compensated WRMS norm is accurate for ill-scaled sums", "[Norms],[LinAlg]")
+{
+	const unsigned int size = 4001;
+
+	// One big entry followed by many small ones loses accuracy in a naive running sum
+	std::vector<double> x(size, 1e-8);
+	std::vector<double> w(size, 1.0);
+	x[0] = 1e8;
+
+	// Reference sum in extended precision
+	long double refSum = 0.0;
+	for (unsigned int i = 0; i < size; ++i)
+		refSum += static_cast<long double>(x[i]) * static_cast<long double>(x[i]);
+	const double ref = static_cast<double>(std::sqrt(refSum / static_cast<long double>(size)));
+
+	CHECK(cadet::linalg::wrmsNorm(x.data(), w.data(), size) == Approx(ref).epsilon(1e-15));
+}
+
+TEST_CASE("Fused weighted linf norm and scaling matches separate operations", "[Norms],[LinAlg]")
+{
+	const unsigned int size = 77;
+
+	std::vector<double> x(size, 0.0);
+	std::vector<double> w(size, 0.0);
+	for (unsigned int i = 0; i < size; ++i)
+	{
+		x[i] = std::sin(1.7 * i);
+		w[i] = 2.0 + std::cos(0.41 * i);
+	}
+
+	std::vector<double> scaled(size, 0.0);
+	const double norm = cadet::linalg::linfNormWeightedScale(x.data(), w.data(), scaled.data(), size);
+
+	CHECK(norm == Approx(cadet::linalg::linfNormWeighted(x.data(), w.data(), size)));
+	for (unsigned int i = 0; i < size; ++i)
+		CHECK(scaled[i] == Approx(x[i] / w[i]));
+
+	// In-place operation overwrites the input with the scaled vector
+	const double normInPlace = cadet::linalg::linfNormWeightedScale(x.data(), w.data(), x.data(), size);
+	CHECK(normInPlace == Approx(norm));
+	for (unsigned int i = 0; i < size; ++i)
+		CHECK(x[i] == Approx(scaled[i]));
+}
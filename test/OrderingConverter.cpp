@@ -0,0 +1,71 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <vector>
+
+#include "common/OrderingConverter.hpp"
+
+/**
+ * @brief Converts a tensor in both directions and checks the result element by element
+ * @param [in] dims Dimensions of the tensor
+ */
+void testConversionRoundTrip(const std::vector<unsigned int>& dims)
+{
+	const cadet::OrderingConverter conv(dims);
+	const std::size_t n = conv.numElements();
+
+	// Fill source with its linear row-major index
+	std::vector<double> src(n, 0.0);
+	for (std::size_t i = 0; i < n; ++i)
+		src[i] = static_cast<double>(i);
+
+	// Blocked conversion has to agree with the element-wise index mapping
+	std::vector<double> colMajor(n, -1.0);
+	conv.convertRowToCol(src.data(), colMajor.data());
+	for (std::size_t i = 0; i < n; ++i)
+		CHECK(colMajor[conv.rowToCol(i)] == src[i]);
+
+	// Converting back recovers the original array
+	std::vector<double> roundTrip(n, -1.0);
+	conv.convertColToRow(colMajor.data(), roundTrip.data());
+	for (std::size_t i = 0; i < n; ++i)
+		CHECK(roundTrip[i] == src[i]);
+}
+
+TEST_CASE("Blocked ordering conversion matches element-wise mapping", "[OrderingConverter]")
+{
+	// Sizes above and below the tile size, even and odd
+	testConversionRoundTrip({70, 37});
+	testConversionRoundTrip({9, 5, 41});
+	testConversionRoundTrip({4, 3, 2, 33});
+}
+
+TEST_CASE("Trivial orderings are detected and copied straight through", "[OrderingConverter]")
+{
+	// At most one non-trivial dimension means both layouts coincide
+	const cadet::OrderingConverter conv(std::vector<unsigned int>{1, 23, 1});
+	REQUIRE(conv.trivialOrdering());
+
+	std::vector<double> src(conv.numElements(), 0.0);
+	for (std::size_t i = 0; i < src.size(); ++i)
+		src[i] = static_cast<double>(2 * i + 1);
+
+	std::vector<double> dest(src.size(), -1.0);
+	conv.convertRowToCol(src.data(), dest.data());
+	for (std::size_t i = 0; i < src.size(); ++i)
+		CHECK(dest[i] == src[i]);
+
+	const cadet::OrderingConverter conv2(std::vector<unsigned int>{2, 23});
+	REQUIRE(!conv2.trivialOrdering());
+}
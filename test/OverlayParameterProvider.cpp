@@ -0,0 +1,136 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include "common/OverlayParameterProvider.hpp"
+#include "JsonParameterProvider.hpp"
+
+namespace
+{
+	const char jsonBase[] = R"json({
+		"model": {
+			"NUNITS": 1,
+			"unit_000": {
+				"UNIT_TYPE": "GENERAL_RATE_MODEL",
+				"COL_DISPERSION": 5.75e-8,
+				"VELOCITY": 5.75e-4,
+				"INIT_C": [0.0, 0.0],
+				"discretization": {
+					"NCOL": 16
+				}
+			}
+		}
+	})json";
+}
+
+TEST_CASE("Overlay falls through to the base provider for untouched leaves", "[ParameterProvider]")
+{
+	cadet::JsonParameterProvider base(jsonBase);
+	cadet::OverlayParameterProvider ovl(base);
+
+	REQUIRE(ovl.numOverrides() == 0);
+
+	ovl.pushScope("model");
+	CHECK(ovl.getInt("NUNITS") == 1);
+
+	ovl.pushScope("unit_000");
+	CHECK(ovl.getString("UNIT_TYPE") == "GENERAL_RATE_MODEL");
+	CHECK(ovl.getDouble("COL_DISPERSION") == 5.75e-8);
+	CHECK(ovl.exists("VELOCITY"));
+	CHECK(!ovl.exists("PAR_RADIUS"));
+	CHECK(ovl.isArray("INIT_C"));
+	CHECK(!ovl.isArray("COL_DISPERSION"));
+
+	ovl.pushScope("discretization");
+	CHECK(ovl.getInt("NCOL") == 16);
+	ovl.popScope();
+
+	ovl.popScope();
+	ovl.popScope();
+}
+
+TEST_CASE("Overlay overrides shadow the base provider in the right scope", "[ParameterProvider]")
+{
+	cadet::JsonParameterProvider base(jsonBase);
+	cadet::OverlayParameterProvider ovl(base);
+
+	ovl.setDouble("model/unit_000/COL_DISPERSION", 1.25e-7);
+	ovl.setInt("model/unit_000/discretization/NCOL", 64);
+	ovl.setDoubleArray("model/unit_000/INIT_C", {1.0, 2.0});
+	REQUIRE(ovl.numOverrides() == 3);
+
+	ovl.pushScope("model");
+	ovl.pushScope("unit_000");
+
+	// Overridden leaves read the delta, untouched leaves still read the base
+	CHECK(ovl.getDouble("COL_DISPERSION") == 1.25e-7);
+	CHECK(ovl.getDouble("VELOCITY") == 5.75e-4);
+
+	const std::vector<double> initC = ovl.getDoubleArray("INIT_C");
+	REQUIRE(initC.size() == 2);
+	CHECK(initC[0] == 1.0);
+	CHECK(initC[1] == 2.0);
+
+	// A leaf name overridden in a nested scope is only shadowed there
+	ovl.pushScope("discretization");
+	CHECK(ovl.getInt("NCOL") == 64);
+	ovl.popScope();
+
+	ovl.popScope();
+	ovl.popScope();
+
+	// Clearing the overrides restores pure fall-through behavior
+	ovl.clearOverrides();
+	REQUIRE(ovl.numOverrides() == 0);
+	ovl.pushScope("model");
+	ovl.pushScope("unit_000");
+	CHECK(ovl.getDouble("COL_DISPERSION") == 5.75e-8);
+	ovl.popScope();
+	ovl.popScope();
+}
+
+TEST_CASE("Overlay adds new leaves and reports their type", "[ParameterProvider]")
+{
+	cadet::JsonParameterProvider base(jsonBase);
+	cadet::OverlayParameterProvider ovl(base);
+
+	// PAR_RADIUS does not exist in the base but is introduced by the overlay
+	ovl.setDouble("model/unit_000/PAR_RADIUS", 4.5e-5);
+	ovl.setString("model/unit_000/ADSORPTION_MODEL", "LINEAR");
+	ovl.setIntArray("model/unit_000/NBOUND", {1, 1});
+
+	ovl.pushScope("model");
+	ovl.pushScope("unit_000");
+
+	CHECK(ovl.exists("PAR_RADIUS"));
+	CHECK(ovl.getDouble("PAR_RADIUS") == 4.5e-5);
+	CHECK(!ovl.isArray("PAR_RADIUS"));
+
+	CHECK(ovl.getString("ADSORPTION_MODEL") == "LINEAR");
+
+	CHECK(ovl.isArray("NBOUND"));
+	const std::vector<int> nBound = ovl.getIntArray("NBOUND");
+	REQUIRE(nBound.size() == 2);
+	CHECK(nBound[0] == 1);
+
+	// Scalar overrides also read as one-element arrays and vice versa
+	const std::vector<double> parRadius = ovl.getDoubleArray("PAR_RADIUS");
+	REQUIRE(parRadius.size() == 1);
+	CHECK(parRadius[0] == 4.5e-5);
+
+	// Reading an override as an incompatible type is an error
+	CHECK_THROWS_AS(ovl.getInt("ADSORPTION_MODEL"), cadet::InvalidParameterException);
+
+	ovl.popScope();
+	ovl.popScope();
+}
@@ -0,0 +1,442 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <vector>
+#include <unordered_map>
+
+#include "cadet/Model.hpp"
+#include "cadet/SolutionExporter.hpp"
+#include "common/SolutionRecorderImpl.hpp"
+#include "ParamIdUtil.hpp"
+
+namespace
+{
+	/**
+	 * @brief Minimal IModel implementation for driving recorders in tests
+	 */
+	class DummyModel : public cadet::IModel
+	{
+	public:
+		virtual cadet::UnitOpIdx unitOperationId() const CADET_NOEXCEPT { return 0; }
+		virtual const char* unitOperationName() const CADET_NOEXCEPT { return "DUMMY"; }
+
+		virtual bool setParameter(const cadet::ParameterId& pId, int value) { return false; }
+		virtual bool setParameter(const cadet::ParameterId& pId, double value) { return false; }
+		virtual bool setParameter(const cadet::ParameterId& pId, bool value) { return false; }
+		virtual bool hasParameter(const cadet::ParameterId& pId) const { return false; }
+		virtual std::unordered_map<cadet::ParameterId, double> getAllParameterValues() const { return std::unordered_map<cadet::ParameterId, double>(); }
+		virtual void useAnalyticJacobian(const bool analyticJac) { }
+		virtual std::size_t memoryFootprint() const CADET_NOEXCEPT { return 0; }
+		virtual cadet::CostEstimate costEstimate(unsigned int numSensParams) const CADET_NOEXCEPT { return cadet::CostEstimate{0.0, 0.0, 0}; }
+
+#ifdef CADET_BENCHMARK_MODE
+		virtual std::vector<double> benchmarkTimings() const { return std::vector<double>(0); }
+		virtual char const* const* benchmarkDescriptions() const { return nullptr; }
+#endif
+	};
+
+	/**
+	 * @brief Exposes plain arrays with the layout of the general rate model through ISolutionExporter
+	 * @details Uses @c nComp = 2 components, @c nCol = 3 axial cells, @c nPar = 2 radial cells,
+	 *          and one bound state for the first component.
+	 */
+	class MockExporter : public cadet::ISolutionExporter
+	{
+	public:
+		static const unsigned int nComp = 2;
+		static const unsigned int nCol = 3;
+		static const unsigned int nPar = 2;
+		static const unsigned int nBoundTotal = 1;
+
+		MockExporter(double const* column, double const* particle, double const* flux) : _column(column), _particle(particle), _flux(flux) { }
+
+		virtual bool hasMultipleBoundStates() const CADET_NOEXCEPT { return false; }
+		virtual bool hasNonBindingComponents() const CADET_NOEXCEPT { return true; }
+		virtual bool hasParticleFlux() const CADET_NOEXCEPT { return true; }
+		virtual bool hasParticleMobilePhase() const CADET_NOEXCEPT { return true; }
+
+		virtual unsigned int numComponents() const CADET_NOEXCEPT { return nComp; }
+		virtual unsigned int numAxialCells() const CADET_NOEXCEPT { return nCol; }
+		virtual unsigned int numRadialCells() const CADET_NOEXCEPT { return nPar; }
+		virtual unsigned int numBoundStates() const CADET_NOEXCEPT { return nBoundTotal; }
+		virtual unsigned int const* numBoundStatesPerComponent() const CADET_NOEXCEPT { return _nBound; }
+		virtual unsigned int numBoundStates(unsigned int comp) const CADET_NOEXCEPT { return _nBound[comp]; }
+		virtual unsigned int numColumnDofs() const CADET_NOEXCEPT { return nComp * nCol; }
+		virtual unsigned int numParticleDofs() const CADET_NOEXCEPT { return (nComp + nBoundTotal) * nPar * nCol; }
+		virtual unsigned int numFluxDofs() const CADET_NOEXCEPT { return nComp * nCol; }
+
+		virtual double concentration(unsigned int component, unsigned int axialCell) const { return _column[component * nCol + axialCell]; }
+		virtual double flux(unsigned int component, unsigned int axialCell) const { return _flux[component * nCol + axialCell]; }
+		virtual double mobilePhase(unsigned int component, unsigned int axialCell, unsigned int radialCell) const
+		{
+			return _particle[(axialCell * nPar + radialCell) * (nComp + nBoundTotal) + component];
+		}
+		virtual double solidPhase(unsigned int component, unsigned int axialCell, unsigned int radialCell, unsigned int boundState) const
+		{
+			return _particle[(axialCell * nPar + radialCell) * (nComp + nBoundTotal) + nComp + boundState];
+		}
+
+		virtual double const* concentration() const { return _column; }
+		virtual double const* flux() const { return _flux; }
+		virtual double const* mobilePhase() const { return _particle; }
+		virtual double const* solidPhase() const { return _particle + nComp; }
+		virtual double const* inlet(unsigned int& stride) const
+		{
+			stride = nCol;
+			return _column;
+		}
+		virtual double const* outlet(unsigned int& stride) const
+		{
+			stride = nCol;
+			return _column + nCol - 1;
+		}
+
+		virtual cadet::StateOrdering const* concentrationOrdering(unsigned int& len) const
+		{
+			len = 2;
+			return _planarOrdering;
+		}
+		virtual cadet::StateOrdering const* fluxOrdering(unsigned int& len) const
+		{
+			len = 2;
+			return _planarOrdering;
+		}
+		virtual cadet::StateOrdering const* mobilePhaseOrdering(unsigned int& len) const
+		{
+			len = 4;
+			return _particleOrdering;
+		}
+		virtual cadet::StateOrdering const* solidPhaseOrdering(unsigned int& len) const
+		{
+			len = 2;
+			return _solidOrdering;
+		}
+
+	protected:
+		double const* _column;
+		double const* _particle;
+		double const* _flux;
+
+		const unsigned int _nBound[nComp] = {1, 0};
+		const cadet::StateOrdering _planarOrdering[2] = {cadet::StateOrdering::Component, cadet::StateOrdering::AxialCell};
+		const cadet::StateOrdering _particleOrdering[4] = {cadet::StateOrdering::AxialCell, cadet::StateOrdering::RadialCell, cadet::StateOrdering::Phase, cadet::StateOrdering::Component};
+		const cadet::StateOrdering _solidOrdering[2] = {cadet::StateOrdering::Component, cadet::StateOrdering::Phase};
+	};
+
+	/**
+	 * @brief Enables all storage options of a recorder
+	 */
+	void storeEverything(cadet::InternalStorageUnitOpRecorder& rec)
+	{
+		const cadet::InternalStorageUnitOpRecorder::StorageConfig cfg = {true, true, true, true, true};
+		rec.solutionConfig(cfg);
+		rec.solutionDotConfig(cfg);
+		rec.storeTime(true);
+	}
+
+	/**
+	 * @brief Replays a fixed sequence of time steps into a recorder
+	 * @details Mimics the callback sequence issued by the simulator (without sensitivities).
+	 */
+	void driveRecorder(cadet::ISolutionRecorder& rec, unsigned int nSteps)
+	{
+		DummyModel model;
+
+		std::vector<double> column(MockExporter::nComp * MockExporter::nCol, 0.0);
+		std::vector<double> particle((MockExporter::nComp + MockExporter::nBoundTotal) * MockExporter::nPar * MockExporter::nCol, 0.0);
+		std::vector<double> flux(MockExporter::nComp * MockExporter::nCol, 0.0);
+		std::vector<double> columnDot(column.size(), 0.0);
+		std::vector<double> particleDot(particle.size(), 0.0);
+		std::vector<double> fluxDot(flux.size(), 0.0);
+
+		const MockExporter exporter(column.data(), particle.data(), flux.data());
+		const MockExporter exporterDot(columnDot.data(), particleDot.data(), fluxDot.data());
+
+		rec.notifyIntegrationStart(column.size() + particle.size() + flux.size(), 0, nSteps);
+		rec.unitOperationStructure(0, model, exporter);
+
+		for (unsigned int step = 0; step < nSteps; ++step)
+		{
+			// Deterministic data that differs between time steps and arrays
+			for (unsigned int i = 0; i < column.size(); ++i)
+			{
+				column[i] = step + 0.01 * i;
+				columnDot[i] = -column[i];
+			}
+			for (unsigned int i = 0; i < particle.size(); ++i)
+			{
+				particle[i] = 100.0 + step + 0.01 * i;
+				particleDot[i] = -particle[i];
+			}
+			for (unsigned int i = 0; i < flux.size(); ++i)
+			{
+				flux[i] = 200.0 + step + 0.01 * i;
+				fluxDot[i] = -flux[i];
+			}
+
+			rec.beginTimestep(0.5 * step);
+
+			rec.beginSolution();
+			rec.beginUnitOperation(0, model, exporter);
+			rec.endUnitOperation();
+			rec.endSolution();
+
+			rec.beginSolutionDerivative();
+			rec.beginUnitOperation(0, model, exporterDot);
+			rec.endUnitOperation();
+			rec.endSolutionDerivative();
+
+			rec.endTimestep();
+		}
+	}
+}
+
+TEST_CASE("Reduced output records only the selected components at inlet and outlet", "[SolutionRecorder]")
+{
+	const unsigned int nSteps = 17;
+	const unsigned int nComp = MockExporter::nComp;
+
+	// Full reference
+	cadet::InternalStorageUnitOpRecorder recFull(0);
+	storeEverything(recFull);
+	driveRecorder(recFull, nSteps);
+
+	// Record only the last component
+	cadet::InternalStorageUnitOpRecorder recRed(0);
+	storeEverything(recRed);
+	recRed.recordedComponents({nComp - 1});
+	driveRecorder(recRed, nSteps);
+
+	REQUIRE(recRed.numDataPoints() == nSteps);
+	REQUIRE(recRed.numRecordedComponents() == 1);
+
+	for (unsigned int i = 0; i < nSteps; ++i)
+	{
+		CHECK(recRed.inlet()[i] == recFull.inlet()[i * nComp + nComp - 1]);
+		CHECK(recRed.outlet()[i] == recFull.outlet()[i * nComp + nComp - 1]);
+		CHECK(recRed.outletDot()[i] == recFull.outletDot()[i * nComp + nComp - 1]);
+	}
+}
+
+TEST_CASE("Memory footprint covers the recorded buffers", "[SolutionRecorder]")
+{
+	const unsigned int nSteps = 11;
+
+	cadet::InternalStorageUnitOpRecorder rec(0);
+	storeEverything(rec);
+
+	// Nothing has been allocated yet
+	REQUIRE(rec.memoryFootprint() == 0);
+
+	driveRecorder(rec, nSteps);
+
+	// At least time, inlet, and outlet (solution and time derivative) have to fit
+	const std::size_t minBytes = nSteps * (1 + 4 * MockExporter::nComp) * sizeof(double);
+	CHECK(rec.memoryFootprint() >= minBytes);
+}
+
+TEST_CASE("Async recorder produces the same data as synchronous recording", "[SolutionRecorder]")
+{
+	const unsigned int nSteps = 23;
+
+	// Synchronous reference
+	cadet::InternalStorageUnitOpRecorder recSync(0);
+	storeEverything(recSync);
+	driveRecorder(recSync, nSteps);
+
+	// Asynchronously fed recorder with a small ring to exercise producer blocking
+	cadet::InternalStorageUnitOpRecorder recInner(0);
+	storeEverything(recInner);
+	{
+		cadet::AsyncSystemRecorder async(recInner, 4);
+		driveRecorder(async, nSteps);
+		async.wait();
+	}
+
+	REQUIRE(recSync.numDataPoints() == nSteps);
+	REQUIRE(recInner.numDataPoints() == nSteps);
+
+	const unsigned int nComp = MockExporter::nComp;
+	const unsigned int nColDofs = MockExporter::nComp * MockExporter::nCol;
+	const unsigned int nParDofs = (MockExporter::nComp + MockExporter::nBoundTotal) * MockExporter::nPar * MockExporter::nCol;
+	const unsigned int nFluxDofs = MockExporter::nComp * MockExporter::nCol;
+
+	for (unsigned int i = 0; i < nSteps; ++i)
+	{
+		CHECK(recInner.time()[i] == recSync.time()[i]);
+
+		for (unsigned int j = 0; j < nComp; ++j)
+		{
+			CHECK(recInner.inlet()[i * nComp + j] == recSync.inlet()[i * nComp + j]);
+			CHECK(recInner.outlet()[i * nComp + j] == recSync.outlet()[i * nComp + j]);
+		}
+		for (unsigned int j = 0; j < nColDofs; ++j)
+		{
+			CHECK(recInner.column()[i * nColDofs + j] == recSync.column()[i * nColDofs + j]);
+			CHECK(recInner.columnDot()[i * nColDofs + j] == recSync.columnDot()[i * nColDofs + j]);
+		}
+		for (unsigned int j = 0; j < nParDofs; ++j)
+		{
+			CHECK(recInner.particle()[i * nParDofs + j] == recSync.particle()[i * nParDofs + j]);
+			CHECK(recInner.particleDot()[i * nParDofs + j] == recSync.particleDot()[i * nParDofs + j]);
+		}
+		for (unsigned int j = 0; j < nFluxDofs; ++j)
+		{
+			CHECK(recInner.flux()[i * nFluxDofs + j] == recSync.flux()[i * nFluxDofs + j]);
+			CHECK(recInner.fluxDot()[i * nFluxDofs + j] == recSync.fluxDot()[i * nFluxDofs + j]);
+		}
+	}
+}
+
+TEST_CASE("Solution views and buffer extraction access storage without copying", "[SolutionRecorder]")
+{
+	const unsigned int nSteps = 11;
+
+	cadet::InternalStorageUnitOpRecorder rec(0);
+	storeEverything(rec);
+	driveRecorder(rec, nSteps);
+
+	// Views carry the correct sizes and point directly into the internal storage
+	const cadet::ConstSolutionView outlet = rec.outletView();
+	REQUIRE(outlet.size == nSteps * MockExporter::nComp);
+	CHECK(outlet.data == rec.outlet());
+	CHECK(rec.timeView().size == nSteps);
+	CHECK(rec.timeView().data == rec.time());
+	CHECK(rec.columnView().size == nSteps * MockExporter::nComp * MockExporter::nCol);
+	CHECK(rec.columnDotView().data == rec.columnDot());
+
+	for (unsigned int i = 0; i < outlet.size; ++i)
+		CHECK(outlet[i] == rec.outlet()[i]);
+
+	// Extraction transfers ownership of the storage and survives clear()
+	const std::vector<double> ref(outlet.begin(), outlet.end());
+	std::vector<double> taken = rec.extractOutlet();
+	CHECK(taken.data() == outlet.data);
+
+	rec.clear();
+
+	REQUIRE(taken.size() == ref.size());
+	for (unsigned int i = 0; i < taken.size(); ++i)
+		CHECK(taken[i] == ref[i]);
+
+	// The recorder continues with an empty buffer
+	CHECK(rec.outletView().size == 0);
+}
+
+TEST_CASE("Recorded interior buffers are raw copies described by the negotiated layout", "[SolutionRecorder]")
+{
+	const unsigned int nSteps = 5;
+	const unsigned int nComp = MockExporter::nComp;
+	const unsigned int nCol = MockExporter::nCol;
+	const unsigned int nPar = MockExporter::nPar;
+	const unsigned int parShell = nComp + MockExporter::nBoundTotal;
+
+	cadet::InternalStorageUnitOpRecorder rec(0);
+	storeEverything(rec);
+	driveRecorder(rec, nSteps);
+
+	// The layout metadata reflects what the mock exporter advertises; phases are
+	// folded into the component dimension of the particle layout
+	const cadet::RecordedDataLayout& colLayout = rec.columnDataLayout();
+	REQUIRE(colLayout.ordering.size() == 2);
+	CHECK(colLayout.ordering[0] == cadet::StateOrdering::Component);
+	CHECK(colLayout.ordering[1] == cadet::StateOrdering::AxialCell);
+	REQUIRE(colLayout.dims.size() == 2);
+	CHECK(colLayout.dims[0] == nComp);
+	CHECK(colLayout.dims[1] == nCol);
+	CHECK(colLayout.elementsPerTimestep() == nComp * nCol);
+
+	const cadet::RecordedDataLayout& parLayout = rec.particleDataLayout();
+	REQUIRE(parLayout.ordering.size() == 3);
+	CHECK(parLayout.ordering[0] == cadet::StateOrdering::AxialCell);
+	CHECK(parLayout.ordering[1] == cadet::StateOrdering::RadialCell);
+	CHECK(parLayout.ordering[2] == cadet::StateOrdering::Component);
+	REQUIRE(parLayout.dims.size() == 3);
+	CHECK(parLayout.dims[0] == nCol);
+	CHECK(parLayout.dims[1] == nPar);
+	CHECK(parLayout.dims[2] == parShell);
+
+	// Reading through the stored layout recovers the element-wise view of the exporter:
+	// the buffers hold untouched blocks in the native ordering, one time step after the
+	// other (data replayed by driveRecorder(): column[i] = step + 0.01 * i etc.)
+	const cadet::ConstSolutionView column = rec.columnView();
+	REQUIRE(column.size == nSteps * colLayout.elementsPerTimestep());
+	for (unsigned int step = 0; step < nSteps; ++step)
+	{
+		for (unsigned int comp = 0; comp < nComp; ++comp)
+		{
+			for (unsigned int cell = 0; cell < nCol; ++cell)
+				CHECK(column[(step * nComp + comp) * nCol + cell] == step + 0.01 * (comp * nCol + cell));
+		}
+	}
+
+	const cadet::ConstSolutionView particle = rec.particleView();
+	REQUIRE(particle.size == nSteps * parLayout.elementsPerTimestep());
+	for (unsigned int step = 0; step < nSteps; ++step)
+	{
+		for (unsigned int i = 0; i < parLayout.elementsPerTimestep(); ++i)
+			CHECK(particle[step * parLayout.elementsPerTimestep() + i] == 100.0 + step + 0.01 * i);
+	}
+}
+
+TEST_CASE("Default span views match the classic exporter accessors", "[SolutionRecorder]")
+{
+	std::vector<double> column(MockExporter::nComp * MockExporter::nCol, 0.0);
+	std::vector<double> particle((MockExporter::nComp + MockExporter::nBoundTotal) * MockExporter::nPar * MockExporter::nCol, 0.0);
+	std::vector<double> flux(MockExporter::nComp * MockExporter::nCol, 0.0);
+
+	for (unsigned int i = 0; i < column.size(); ++i)
+		column[i] = 1.0 + 0.25 * i;
+	for (unsigned int i = 0; i < particle.size(); ++i)
+		particle[i] = 100.0 + 0.25 * i;
+	for (unsigned int i = 0; i < flux.size(); ++i)
+		flux[i] = 200.0 + 0.25 * i;
+
+	const MockExporter expr(column.data(), particle.data(), flux.data());
+
+	// The mock does not override the span accessors, so the default implementations
+	// assemble the views from the classic pointer and stride queries
+	const cadet::SolutionSpan conc = expr.concentrationSpan();
+	CHECK(conc.data == expr.concentration());
+	CHECK(conc.numElements == expr.numColumnDofs());
+	CHECK(conc.contiguous());
+
+	const cadet::SolutionSpan parts = expr.mobilePhaseSpan();
+	CHECK(parts.data == expr.mobilePhase());
+	CHECK(parts.numElements == expr.numParticleDofs());
+	CHECK(parts.contiguous());
+
+	const cadet::SolutionSpan fluxSpan = expr.fluxSpan();
+	CHECK(fluxSpan.data == expr.flux());
+	CHECK(fluxSpan.numElements == expr.numFluxDofs());
+	CHECK(fluxSpan.contiguous());
+
+	// Inlet and outlet of the mock are strided slices of the column block
+	unsigned int stride = 0;
+	double const* const outletPtr = expr.outlet(stride);
+	const cadet::SolutionSpan outlet = expr.outletSpan();
+	const unsigned int nComp = MockExporter::nComp;
+	CHECK(outlet.data == outletPtr);
+	CHECK(outlet.numElements == nComp);
+	CHECK(outlet.stride == stride);
+	CHECK(!outlet.contiguous());
+
+	for (unsigned int comp = 0; comp < nComp; ++comp)
+		CHECK(outlet.data[comp * outlet.stride] == outletPtr[comp * stride]);
+
+	double const* const inletPtr = expr.inlet(stride);
+	const cadet::SolutionSpan inlet = expr.inletSpan();
+	CHECK(inlet.data == inletPtr);
+	CHECK(inlet.stride == stride);
+}
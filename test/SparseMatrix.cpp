@@ -0,0 +1,99 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <vector>
+#include <cmath>
+
+#include "linalg/SparseMatrix.hpp"
+
+/**
+ * @brief Creates a coordinate format matrix with a fixed pseudo-random pattern
+ * @param [in] rows Number of rows and columns
+ * @param [in] elemsPerRow Number of elements added to each row
+ * @return Populated matrix in coordinate format
+ */
+cadet::linalg::DoubleSparseMatrix createSparseMatrix(unsigned int rows, unsigned int elemsPerRow)
+{
+	cadet::linalg::DoubleSparseMatrix sm(rows * elemsPerRow);
+	for (unsigned int r = 0; r < rows; ++r)
+	{
+		for (unsigned int i = 0; i < elemsPerRow; ++i)
+		{
+			// Spread the elements over the columns in a non-monotonic order
+			const unsigned int col = (r + 7 * i + (i % 2) * (rows / 2)) % rows;
+			sm.addElement(r, col, std::sin(1.3 * r + 0.7 * col) + 2.0);
+		}
+	}
+	return sm;
+}
+
+TEST_CASE("Compressing DoubleSparseMatrix to CompressedSparseMatrix", "[SparseMatrix],[LinAlg]")
+{
+	using cadet::linalg::CompressedSparseMatrix;
+	using cadet::linalg::DoubleSparseMatrix;
+
+	const DoubleSparseMatrix sm = createSparseMatrix(32, 3);
+	const CompressedSparseMatrix csm(sm);
+
+	REQUIRE(csm.numNonZero() == sm.numNonZero());
+	REQUIRE(csm.rows() == 32);
+
+	// Each row has to hold its elements with ascending column indices
+	for (unsigned int r = 0; r < csm.rows(); ++r)
+	{
+		CHECK(csm.rowStart()[r + 1] - csm.rowStart()[r] == 3);
+		for (unsigned int i = csm.rowStart()[r] + 1; i < csm.rowStart()[r + 1]; ++i)
+			CHECK(csm.cols()[i - 1] < csm.cols()[i]);
+	}
+
+	// All elements have to be found with their original values
+	for (unsigned int r = 0; r < csm.rows(); ++r)
+	{
+		for (unsigned int i = csm.rowStart()[r]; i < csm.rowStart()[r + 1]; ++i)
+			CHECK(csm.values()[i] == sm(r, csm.cols()[i]));
+	}
+}
+
+TEST_CASE("CompressedSparseMatrix multiplication matches coordinate format", "[SparseMatrix],[LinAlg]")
+{
+	using cadet::linalg::CompressedSparseMatrix;
+	using cadet::linalg::DoubleSparseMatrix;
+
+	const DoubleSparseMatrix sm = createSparseMatrix(48, 4);
+	const CompressedSparseMatrix csm(sm);
+
+	std::vector<double> x(48, 0.0);
+	std::vector<double> ref(48, 0.0);
+	for (unsigned int i = 0; i < x.size(); ++i)
+	{
+		x[i] = std::cos(0.3 * i);
+		ref[i] = std::sin(0.2 * i);
+	}
+
+	std::vector<double> y = ref;
+	sm.multiplyAdd(x.data(), ref.data());
+	csm.multiplyAdd(x.data(), y.data());
+	for (unsigned int i = 0; i < y.size(); ++i)
+		CHECK(y[i] == Approx(ref[i]));
+
+	sm.multiplyAdd(x.data(), ref.data(), 2.5);
+	csm.multiplyAdd(2.5, x.data(), y.data());
+	for (unsigned int i = 0; i < y.size(); ++i)
+		CHECK(y[i] == Approx(ref[i]));
+
+	sm.multiplySubtract(x.data(), ref.data());
+	csm.multiplySubtract(x.data(), y.data());
+	for (unsigned int i = 0; i < y.size(); ++i)
+		CHECK(y[i] == Approx(ref[i]));
+}
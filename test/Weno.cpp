@@ -0,0 +1,189 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+#include "Weno.hpp"
+
+namespace
+{
+	/**
+	 * @brief Fills an array with a smooth profile disturbed by a jump
+	 * @param [out] w Array to be filled
+	 * @param [in] nCells Number of cells
+	 */
+	void createTestProfile(double* w, unsigned int nCells)
+	{
+		for (unsigned int i = 0; i < nCells; ++i)
+			w[i] = std::sin(0.3 * i) + ((i > nCells / 2) ? 3.0 : 0.0);
+	}
+}
+
+TEST_CASE("WENO strip kernel matches scalar reconstruction", "[Weno],[Simulation]")
+{
+	const unsigned int nCells = 37;
+	const double epsilon = 1e-10;
+
+	double w[nCells];
+	createTestProfile(w, nCells);
+
+	// Ghost-zero padded copy for the scalar reference kernel
+	double padded[nCells + 2 * cadet::Weno::maxOrder()] = {0.0};
+	std::copy(w, w + nCells, padded + cadet::Weno::maxOrder());
+
+	for (int bndTreatment = 0; bndTreatment <= 2; ++bndTreatment)
+	{
+		for (int order = 1; order <= static_cast<int>(cadet::Weno::maxOrder()); ++order)
+		{
+			SECTION("Boundary treatment " + std::to_string(bndTreatment) + " order " + std::to_string(order))
+			{
+				cadet::Weno weno;
+				weno.order(order);
+				weno.boundaryTreatment(bndTreatment);
+
+				double vm[nCells];
+				double Dvm[nCells * cadet::Weno::maxStencilSize()];
+				int usedOrder[nCells];
+				weno.reconstructStrip<true>(epsilon, nCells, w, vm, Dvm, usedOrder);
+
+				for (unsigned int cell = 0; cell < nCells; ++cell)
+				{
+					double refVm = 0.0;
+					double refDvm[cadet::Weno::maxStencilSize()] = {0.0};
+					double const* stencil = padded + cadet::Weno::maxOrder() + cell;
+					const int refOrder = weno.reconstruct<double, double const*>(epsilon, cell, nCells, stencil, refVm, refDvm);
+
+					CHECK(usedOrder[cell] == refOrder);
+					CHECK(vm[cell] == refVm);
+					for (int i = 0; i < 2 * refOrder - 1; ++i)
+						CHECK(Dvm[cell * cadet::Weno::maxStencilSize() + i] == refDvm[i]);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("WENO smoothness indicator memo reuses and refreshes correctly", "[Weno],[Simulation]")
+{
+	const unsigned int nCells = 37;
+	const double epsilon = 1e-10;
+
+	double w[nCells];
+	createTestProfile(w, nCells);
+
+	for (int order = 2; order <= static_cast<int>(cadet::Weno::maxOrder()); ++order)
+	{
+		SECTION("Order " + std::to_string(order))
+		{
+			cadet::Weno wenoRef;
+			wenoRef.order(order);
+
+			cadet::Weno weno;
+			weno.order(order);
+			weno.enableSmoothnessMemo(1, nCells, 1e-4);
+
+			double refVm[nCells];
+			double vm[nCells];
+			int refOrder[nCells];
+			int usedOrder[nCells];
+
+			// First evaluation of a step stores the indicators and matches the unmemoized kernel
+			weno.beginTimeStep(1.0);
+			wenoRef.reconstructStrip<false>(epsilon, nCells, w, refVm, nullptr, refOrder);
+			weno.reconstructStrip<false>(epsilon, nCells, w, vm, nullptr, usedOrder);
+			for (unsigned int cell = 0; cell < nCells; ++cell)
+				CHECK(vm[cell] == refVm[cell]);
+
+			// Re-evaluation at the same time point and state reuses the stored indicators
+			weno.beginTimeStep(1.0);
+			weno.reconstructStrip<false>(epsilon, nCells, w, vm, nullptr, usedOrder);
+			for (unsigned int cell = 0; cell < nCells; ++cell)
+				CHECK(vm[cell] == refVm[cell]);
+
+			// A cell that moved beyond the reuse threshold is recomputed and refreshed;
+			// its unperturbed neighbors deliberately keep their stored indicators, so only
+			// cells whose stencil does not touch the perturbation are compared
+			const unsigned int pert = nCells / 4;
+			double wPert[nCells];
+			std::copy(w, w + nCells, wPert);
+			wPert[pert] += 1.0;
+			wenoRef.reconstructStrip<false>(epsilon, nCells, wPert, refVm, nullptr, refOrder);
+			weno.reconstructStrip<false>(epsilon, nCells, wPert, vm, nullptr, usedOrder);
+			CHECK(vm[pert] == refVm[pert]);
+			for (unsigned int cell = 0; cell < nCells; ++cell)
+			{
+				if (std::abs(static_cast<int>(cell) - static_cast<int>(pert)) >= order)
+					CHECK(vm[cell] == refVm[cell]);
+			}
+
+			// A new time point invalidates the memo, so the evaluation matches a fresh compute
+			weno.beginTimeStep(2.0);
+			weno.reconstructStrip<false>(epsilon, nCells, wPert, vm, nullptr, usedOrder);
+			for (unsigned int cell = 0; cell < nCells; ++cell)
+				CHECK(vm[cell] == refVm[cell]);
+		}
+	}
+}
+
+TEST_CASE("WENO precomputed boundary tables match on-the-fly treatment", "[Weno],[Simulation]")
+{
+	const unsigned int nCells = 37;
+	const double epsilon = 1e-10;
+
+	double w[nCells];
+	createTestProfile(w, nCells);
+
+	// Ghost-zero padded copy for the scalar kernels
+	double padded[nCells + 2 * cadet::Weno::maxOrder()] = {0.0};
+	std::copy(w, w + nCells, padded + cadet::Weno::maxOrder());
+
+	for (int bndTreatment = 0; bndTreatment <= 2; ++bndTreatment)
+	{
+		for (int order = 1; order <= static_cast<int>(cadet::Weno::maxOrder()); ++order)
+		{
+			SECTION("Boundary treatment " + std::to_string(bndTreatment) + " order " + std::to_string(order))
+			{
+				// Reference without tables evaluates the boundary treatment on every call
+				cadet::Weno wenoRef;
+				wenoRef.order(order);
+				wenoRef.boundaryTreatment(bndTreatment);
+
+				// Tables are built before the settings change and have to be rebuilt by the setters
+				cadet::Weno weno;
+				weno.init(nCells);
+				weno.order(order);
+				weno.boundaryTreatment(bndTreatment);
+
+				for (unsigned int cell = 0; cell < nCells; ++cell)
+				{
+					double const* stencil = padded + cadet::Weno::maxOrder() + cell;
+
+					double refVm = 0.0;
+					double refDvm[cadet::Weno::maxStencilSize()] = {0.0};
+					const int refOrder = wenoRef.reconstruct<double, double const*>(epsilon, cell, nCells, stencil, refVm, refDvm);
+
+					double vm = 0.0;
+					double Dvm[cadet::Weno::maxStencilSize()] = {0.0};
+					const int tabOrder = weno.reconstruct<double, double const*>(epsilon, cell, nCells, stencil, vm, Dvm);
+
+					CHECK(tabOrder == refOrder);
+					CHECK(vm == refVm);
+					for (int i = 0; i < 2 * refOrder - 1; ++i)
+						CHECK(Dvm[i] == refDvm[i]);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,415 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Microbenchmarks for the linear algebra kernels (banded and sparse matrix-vector
+ * products, banded factorization and solution, GMRES) on matrix shapes produced by
+ * real GRM discretizations.
+ *
+ * For each kernel a FLOP and bytes-moved estimate is derived from the matrix shape,
+ * which yields the achieved GFLOP/s, GB/s, and the arithmetic intensity (FLOP per
+ * byte). Comparing those numbers to the peak compute and memory bandwidth of the
+ * deployment hardware shows how far each kernel sits from the roofline and whether
+ * it is memory or compute bound. The estimates assume perfect caching of the
+ * vectors and exactly one transfer of the matrix data per operation, so they are
+ * lower bounds on the actual traffic.
+ */
+
+#include <tclap/CmdLine.h>
+#include "common/TclapUtils.hpp"
+
+#include "linalg/BandMatrix.hpp"
+#include "linalg/SparseMatrix.hpp"
+#include "linalg/Gmres.hpp"
+
+#include "common/Timer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief Deterministic pseudo random sequence for filling matrices and vectors
+	 * @details A simple LCG is sufficient here and keeps runs reproducible across platforms.
+	 */
+	class RandomSequence
+	{
+	public:
+		RandomSequence() : _state(8192506006733221571ull) { }
+
+		inline double next()
+		{
+			_state = 6364136223846793005ull * _state + 1442695040888963407ull;
+			return static_cast<double>(_state >> 11) / static_cast<double>(1ull << 53) - 0.5;
+		}
+
+	private:
+		unsigned long long _state;
+	};
+
+	/**
+	 * @brief Fills a banded matrix with pseudo random values and makes it diagonally dominant
+	 * @details Diagonal dominance guarantees that the factorization succeeds without pivoting
+	 *          growth distorting the timings.
+	 */
+	template <typename Matrix_t>
+	void fillBandMatrix(Matrix_t& bm, RandomSequence& rng)
+	{
+		for (unsigned int row = 0; row < bm.rows(); ++row)
+		{
+			const int lower = std::max(-static_cast<int>(bm.lowerBandwidth()), -static_cast<int>(row));
+			const int upper = std::min(static_cast<int>(bm.upperBandwidth()), static_cast<int>(bm.rows() - row) - 1);
+			for (int col = lower; col <= upper; ++col)
+				bm.centered(row, col) = rng.next();
+
+			bm.centered(row, 0) += static_cast<double>(bm.lowerBandwidth() + bm.upperBandwidth() + 1);
+		}
+	}
+
+	/**
+	 * @brief Returns the number of structurally non-zero elements of a banded matrix
+	 */
+	inline double bandNumNonZero(unsigned int rows, unsigned int lb, unsigned int ub)
+	{
+		double nnz = 0.0;
+		for (unsigned int row = 0; row < rows; ++row)
+		{
+			const unsigned int lower = std::min(lb, row);
+			const unsigned int upper = std::min(ub, rows - row - 1);
+			nnz += lower + upper + 1;
+		}
+		return nnz;
+	}
+
+	/**
+	 * @brief Result of one kernel benchmark
+	 */
+	struct KernelResult
+	{
+		std::string kernel; //!< Name of the benchmarked kernel
+		std::string shape; //!< Human readable matrix shape
+		unsigned int reps; //!< Number of executed repetitions
+		double seconds; //!< Total wall clock time of all repetitions
+		double flopsPerOp; //!< Estimated floating point operations per kernel execution
+		double bytesPerOp; //!< Estimated bytes moved per kernel execution
+	};
+
+	/**
+	 * @brief Prints one result line of the report table
+	 */
+	void printResult(const KernelResult& r)
+	{
+		const double timePerOp = r.seconds / static_cast<double>(r.reps);
+		const double gflops = (timePerOp > 0.0) ? r.flopsPerOp / timePerOp * 1e-9 : 0.0;
+		const double gbytes = (timePerOp > 0.0) ? r.bytesPerOp / timePerOp * 1e-9 : 0.0;
+		const double intensity = (r.bytesPerOp > 0.0) ? r.flopsPerOp / r.bytesPerOp : 0.0;
+
+		std::printf("%-22s %-26s %10.3f %10.3f %10.3f %10.3f\n", r.kernel.c_str(), r.shape.c_str(),
+			timePerOp * 1e6, gflops, gbytes, intensity);
+	}
+
+	/**
+	 * @brief Formats the shape of a banded matrix as string
+	 */
+	std::string bandShape(unsigned int rows, unsigned int lb, unsigned int ub)
+	{
+		return std::to_string(rows) + " rows, bands " + std::to_string(lb) + "+1+" + std::to_string(ub);
+	}
+
+	/**
+	 * @brief Chooses the number of repetitions such that a case runs long enough to be timed reliably
+	 */
+	inline unsigned int chooseReps(double flopsPerOp, unsigned int repFactor)
+	{
+		const unsigned int base = static_cast<unsigned int>(std::max(1.0, 2e7 / std::max(flopsPerOp, 1.0)));
+		return base * repFactor;
+	}
+
+	/**
+	 * @brief Benchmarks BandMatrix::multiplyVector()
+	 * @details FLOPs: @f$ 2 \, \text{nnz} @f$; bytes: matrix data plus read of @f$ x @f$ and write of @f$ y @f$.
+	 */
+	KernelResult benchBandMatVec(unsigned int rows, unsigned int lb, unsigned int ub, unsigned int repFactor, RandomSequence& rng)
+	{
+		cadet::linalg::BandMatrix bm;
+		bm.resize(rows, lb, ub);
+		fillBandMatrix(bm, rng);
+
+		std::vector<double> x(rows, 0.0);
+		std::vector<double> y(rows, 0.0);
+		for (unsigned int i = 0; i < rows; ++i)
+			x[i] = rng.next();
+
+		const double nnz = bandNumNonZero(rows, lb, ub);
+		const unsigned int reps = chooseReps(2.0 * nnz, repFactor);
+
+		cadet::Timer timer;
+		timer.start();
+		for (unsigned int i = 0; i < reps; ++i)
+			bm.multiplyVector(x.data(), y.data());
+		const double elapsed = timer.stop();
+
+		return KernelResult{"BandMatrix::matVec", bandShape(rows, lb, ub), reps, elapsed, 2.0 * nnz, 8.0 * (nnz + 2.0 * rows)};
+	}
+
+	/**
+	 * @brief Benchmarks FactorizableBandMatrix::factorize()
+	 * @details The matrix content is restored before every repetition since the factorization
+	 *          overwrites it; only the factorize() call itself is timed. FLOPs follow the
+	 *          LU operation count @f$ 2 n \, l_b u_b @f$; bytes cover the banded storage
+	 *          including the fill-in rows.
+	 */
+	KernelResult benchBandFactorize(unsigned int rows, unsigned int lb, unsigned int ub, unsigned int repFactor, RandomSequence& rng)
+	{
+		cadet::linalg::BandMatrix bm;
+		bm.resize(rows, lb, ub);
+		fillBandMatrix(bm, rng);
+
+		cadet::linalg::FactorizableBandMatrix fbm;
+		fbm.resize(rows, lb, ub);
+
+		const double flops = 2.0 * rows * lb * ub;
+		const unsigned int reps = chooseReps(flops, repFactor);
+
+		cadet::Timer timer;
+		bool success = true;
+		for (unsigned int i = 0; i < reps; ++i)
+		{
+			fbm.copyOver(bm);
+			timer.start();
+			success = fbm.factorize() && success;
+			timer.stop();
+		}
+		if (!success)
+			std::cerr << "WARNING: Factorization failed for " << bandShape(rows, lb, ub) << std::endl;
+
+		return KernelResult{"FactBandMatrix::factorize", bandShape(rows, lb, ub), reps, timer.totalElapsedTime(), flops,
+			8.0 * rows * (2.0 * lb + ub + 1.0)};
+	}
+
+	/**
+	 * @brief Benchmarks FactorizableBandMatrix::solve()
+	 * @details FLOPs follow the banded triangular solve count @f$ 2 n (2 l_b + u_b) @f$;
+	 *          bytes cover the factorized banded storage and the right hand side vector.
+	 */
+	KernelResult benchBandSolve(unsigned int rows, unsigned int lb, unsigned int ub, unsigned int repFactor, RandomSequence& rng)
+	{
+		cadet::linalg::BandMatrix bm;
+		bm.resize(rows, lb, ub);
+		fillBandMatrix(bm, rng);
+
+		cadet::linalg::FactorizableBandMatrix fbm;
+		fbm.resize(rows, lb, ub);
+		fbm.copyOver(bm);
+		if (!fbm.factorize())
+			std::cerr << "WARNING: Factorization failed for " << bandShape(rows, lb, ub) << std::endl;
+
+		std::vector<double> rhs(rows, 0.0);
+		for (unsigned int i = 0; i < rows; ++i)
+			rhs[i] = rng.next();
+
+		const double flops = 2.0 * rows * (2.0 * lb + ub);
+		const unsigned int reps = chooseReps(flops, repFactor);
+
+		cadet::Timer timer;
+		timer.start();
+		for (unsigned int i = 0; i < reps; ++i)
+			fbm.solve(rhs.data());
+		const double elapsed = timer.stop();
+
+		return KernelResult{"FactBandMatrix::solve", bandShape(rows, lb, ub), reps, elapsed, flops,
+			8.0 * rows * (2.0 * lb + ub + 2.0)};
+	}
+
+	/**
+	 * @brief Creates a coordinate format sparse matrix with the given number of elements per row
+	 * @details Mirrors the flux coupling matrices of the GRM, which hold a handful of entries
+	 *          per row scattered over the column index range.
+	 */
+	cadet::linalg::DoubleSparseMatrix createSparseMatrix(unsigned int rows, unsigned int elemsPerRow, RandomSequence& rng)
+	{
+		cadet::linalg::DoubleSparseMatrix sm(rows * elemsPerRow);
+		for (unsigned int r = 0; r < rows; ++r)
+		{
+			for (unsigned int e = 0; e < elemsPerRow; ++e)
+			{
+				const unsigned int col = (r + e * (rows / elemsPerRow + 1)) % rows;
+				sm.addElement(r, col, rng.next());
+			}
+		}
+		return sm;
+	}
+
+	/**
+	 * @brief Benchmarks DoubleSparseMatrix::multiplyVector()
+	 * @details FLOPs: @f$ 2 \, \text{nnz} @f$; bytes: one value and two 32 bit indices per
+	 *          element plus read of @f$ x @f$ and write of @f$ y @f$.
+	 */
+	KernelResult benchSparseMatVec(unsigned int rows, unsigned int elemsPerRow, unsigned int repFactor, RandomSequence& rng)
+	{
+		const cadet::linalg::DoubleSparseMatrix sm = createSparseMatrix(rows, elemsPerRow, rng);
+
+		std::vector<double> x(rows, 0.0);
+		std::vector<double> y(rows, 0.0);
+		for (unsigned int i = 0; i < rows; ++i)
+			x[i] = rng.next();
+
+		const double nnz = sm.numNonZero();
+		const unsigned int reps = chooseReps(2.0 * nnz, repFactor);
+
+		cadet::Timer timer;
+		timer.start();
+		for (unsigned int i = 0; i < reps; ++i)
+			sm.multiplyVector(x.data(), y.data());
+		const double elapsed = timer.stop();
+
+		const std::string shape = std::to_string(rows) + " rows, " + std::to_string(static_cast<unsigned int>(nnz)) + " nnz";
+		return KernelResult{"SparseMatrix::matVec", shape, reps, elapsed, 2.0 * nnz, 16.0 * nnz + 16.0 * rows};
+	}
+
+	/**
+	 * @brief Benchmarks CompressedSparseMatrix::multiplyAdd() on the same matrix content
+	 */
+	KernelResult benchCompressedSparseMatVec(unsigned int rows, unsigned int elemsPerRow, unsigned int repFactor, RandomSequence& rng)
+	{
+		const cadet::linalg::CompressedSparseMatrix csm(createSparseMatrix(rows, elemsPerRow, rng));
+
+		std::vector<double> x(rows, 0.0);
+		std::vector<double> y(rows, 0.0);
+		for (unsigned int i = 0; i < rows; ++i)
+			x[i] = rng.next();
+
+		const double nnz = csm.numNonZero();
+		const unsigned int reps = chooseReps(2.0 * nnz, repFactor);
+
+		cadet::Timer timer;
+		timer.start();
+		for (unsigned int i = 0; i < reps; ++i)
+			csm.multiplyAdd(x.data(), y.data());
+		const double elapsed = timer.stop();
+
+		const std::string shape = std::to_string(rows) + " rows, " + std::to_string(static_cast<unsigned int>(nnz)) + " nnz";
+		return KernelResult{"CompressedSparse::matVec", shape, reps, elapsed, 2.0 * nnz, 12.0 * nnz + 4.0 * rows + 16.0 * rows};
+	}
+
+	/**
+	 * @brief Benchmarks Gmres::solve() with a banded operator
+	 * @details Uses a diagonally dominant banded matrix as operator, which converges in a few
+	 *          iterations just like the Schur-complement systems of the GRM. FLOPs account for
+	 *          the matrix-vector product of each iteration plus the modified Gram-Schmidt
+	 *          orthogonalization (@f$ 4 n @f$ per stored Krylov vector); bytes for the matrix
+	 *          and the touched Krylov vectors. Both are rough estimates.
+	 */
+	KernelResult benchGmres(unsigned int rows, unsigned int lb, unsigned int ub, unsigned int maxKrylov, unsigned int repFactor, RandomSequence& rng)
+	{
+		cadet::linalg::BandMatrix bm;
+		bm.resize(rows, lb, ub);
+		fillBandMatrix(bm, rng);
+
+		cadet::linalg::Gmres gmres;
+		gmres.initialize(rows, maxKrylov);
+		gmres.matrixVectorMultiplier([&](void* userData, double const* x, double* z) -> int
+			{
+				bm.multiplyVector(x, z);
+				return 0;
+			});
+
+		std::vector<double> weight(rows, 1.0);
+		std::vector<double> rhs(rows, 0.0);
+		std::vector<double> sol(rows, 0.0);
+		for (unsigned int i = 0; i < rows; ++i)
+			rhs[i] = rng.next();
+
+		const double nnz = bandNumNonZero(rows, lb, ub);
+		const unsigned int reps = std::max(16u, chooseReps(2.0 * nnz * maxKrylov, repFactor));
+
+		cadet::Timer timer;
+		const unsigned int itersBefore = gmres.totalNumIterations();
+		timer.start();
+		for (unsigned int i = 0; i < reps; ++i)
+		{
+			std::fill(sol.begin(), sol.end(), 0.0);
+			gmres.solve(1e-8, weight.data(), rhs.data(), sol.data());
+		}
+		const double elapsed = timer.stop();
+		const double iters = static_cast<double>(gmres.totalNumIterations() - itersBefore) / static_cast<double>(reps);
+
+		const double flopsPerIter = 2.0 * nnz + 4.0 * rows * (iters + 1.0) / 2.0;
+		const std::string shape = bandShape(rows, lb, ub) + ", " + std::to_string(static_cast<unsigned int>(iters + 0.5)) + " it";
+		return KernelResult{"Gmres::solve", shape, reps, elapsed, iters * flopsPerIter,
+			iters * 8.0 * (nnz + rows * (iters + 3.0))};
+	}
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int repFactor = 1;
+	unsigned int nComp = 4;
+	unsigned int nBound = 4;
+
+	try
+	{
+		TCLAP::CustomOutputWithoutVersion customOut("benchmarkLinalg");
+		TCLAP::CmdLine cmd("Runs microbenchmarks of the linear algebra kernels on GRM-like matrix shapes", ' ', "1.0");
+		cmd.setOutput(&customOut);
+
+		cmd >> (new TCLAP::ValueArg<unsigned int>("r", "reps", "Repetition multiplier (default: 1)", false, 1, "Value"))->storeIn(&repFactor);
+		cmd >> (new TCLAP::ValueArg<unsigned int>("c", "ncomp", "Number of components (default: 4)", false, 4, "Value"))->storeIn(&nComp);
+		cmd >> (new TCLAP::ValueArg<unsigned int>("b", "nbound", "Number of bound states (default: 4)", false, 4, "Value"))->storeIn(&nBound);
+
+		cmd.parse(argc, argv);
+	}
+	catch (const TCLAP::ArgException& e)
+	{
+		std::cerr << "ERROR: " << e.error() << " for argument " << e.argId() << std::endl;
+		return 1;
+	}
+
+	RandomSequence rng;
+
+	std::printf("%-22s %-26s %10s %10s %10s %10s\n", "Kernel", "Shape", "us/op", "GFLOP/s", "GB/s", "FLOP/B");
+
+	// Column blocks: one band matrix per component with the WENO stencil bandwidth
+	// (lower = order, upper = order - 1 for the maximum order 3)
+	for (unsigned int nCol : {16u, 64u, 256u, 1024u})
+		printResult(benchBandMatVec(nCol, 3, 2, repFactor, rng));
+
+	// Particle blocks: nPar shells with nComp liquid and nBound bound states per shell
+	const unsigned int parStride = nComp + nBound;
+	for (unsigned int nPar : {4u, 16u, 64u})
+	{
+		const unsigned int rows = nPar * parStride;
+		printResult(benchBandMatVec(rows, parStride, parStride + nBound, repFactor, rng));
+		printResult(benchBandFactorize(rows, parStride, parStride + nBound, repFactor, rng));
+		printResult(benchBandSolve(rows, parStride, parStride + nBound, repFactor, rng));
+	}
+
+	// Flux coupling matrices: a handful of entries per row like the particle-flux couplings
+	for (unsigned int nCol : {64u, 256u, 1024u})
+	{
+		printResult(benchSparseMatVec(nCol * nComp, 3, repFactor, rng));
+		printResult(benchCompressedSparseMatVec(nCol * nComp, 3, repFactor, rng));
+	}
+
+	// Schur-complement solves: operator size equals the number of flux DOFs
+	for (unsigned int nCol : {64u, 256u})
+		printResult(benchGmres(nCol * nComp, 3, 2, 30, repFactor, rng));
+
+	return 0;
+}
@@ -0,0 +1,197 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Benchmark harness that runs parameterized GRM load-wash-elution problems across
+ * problem-size sweeps and reports per-phase timings in machine-readable JSON.
+ *
+ * The per-phase timings (residual bulk / particle, factorization, GMRES, consistent
+ * initialization, etc.) are taken from the benchmark timers of the unit operation
+ * models and the model system. They are only collected if libcadet was built with
+ * BENCHMARK_MODE enabled; without it, only wall clock durations are reported.
+ */
+
+#include <json.hpp>
+
+#include <tclap/CmdLine.h>
+#include "common/TclapUtils.hpp"
+
+#include "cadet/cadet.hpp"
+
+#define CADET_LOGGING_DISABLE
+#include "Logging.hpp"
+
+#define CADETTEST_JSONPARAMETERPROVIDER_NOFORWARD
+#include "BenchmarkModels.hpp"
+#include "common/Driver.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace
+{
+	/**
+	 * @brief Sets the number of threads used by the time integrator
+	 */
+	inline void setNumThreads(cadet::JsonParameterProvider& jpp, int nThreads)
+	{
+		jpp.pushScope("solver");
+		jpp.set("NTHREADS", nThreads);
+		jpp.popScope();
+	}
+
+	/**
+	 * @brief Converts the benchmark timers of a model or model system to a JSON object
+	 * @details Returns an empty object if no timings are available (e.g., libcadet was
+	 *          built without BENCHMARK_MODE).
+	 */
+	template <typename Model_t>
+	inline json timingsToJson(const Model_t& model)
+	{
+		json out = json::object();
+
+#ifdef CADET_BENCHMARK_MODE
+		const std::vector<double> timings = model.benchmarkTimings();
+		char const* const* const desc = model.benchmarkDescriptions();
+		if (!desc)
+			return out;
+
+		for (unsigned int i = 0; i < timings.size(); ++i)
+			out[desc[i]] = timings[i];
+#endif
+
+		return out;
+	}
+
+	/**
+	 * @brief Runs one benchmark case and returns its results as JSON object
+	 */
+	inline json runCase(int nCol, int nPar, int nThreads)
+	{
+		cadet::JsonParameterProvider jpp = createEmbeddedLWE(nCol, nPar);
+		setNumThreads(jpp, nThreads);
+
+		cadet::Driver drv;
+		drv.configure(jpp);
+		drv.run();
+
+		json res;
+		res["NCOL"] = nCol;
+		res["NPAR"] = nPar;
+		res["NTHREADS"] = nThreads;
+		res["TOTAL_TIME_SEC"] = drv.simulator()->lastSimulationDuration();
+
+		cadet::IModelSystem const* const sys = drv.simulator()->model();
+		res["SYSTEM"] = timingsToJson(*sys);
+
+		json units = json::object();
+		for (unsigned int i = 0; i < sys->numModels(); ++i)
+		{
+			cadet::IModel const* const unit = sys->getModel(i);
+
+			char unitName[16];
+			std::snprintf(unitName, sizeof(unitName), "unit_%03d", static_cast<int>(unit->unitOperationId()));
+
+			json unitRes = timingsToJson(*unit);
+			unitRes["TYPE"] = unit->unitOperationName();
+			units[unitName] = unitRes;
+		}
+		res["UNITS"] = units;
+
+		return res;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string outFileName;
+	std::vector<int> nCols;
+	std::vector<int> nPars;
+	int nReps = 1;
+	int nThreads = 1;
+
+	try
+	{
+		TCLAP::CustomOutputWithoutVersion customOut("benchmarkRunner");
+		TCLAP::CmdLine cmd("Runs GRM load-wash-elution benchmarks across problem-size sweeps", ' ', "1.0");
+		cmd.setOutput(&customOut);
+
+		cmd >> (new TCLAP::ValueArg<std::string>("o", "out", "Write JSON results to file (default: standard output)", false, "", "File"))->storeIn(&outFileName);
+		cmd >> (new TCLAP::MultiArg<int>("c", "ncol", "Number of axial cells (default: 64; can be given multiple times for a sweep)", false, "Value"))->storeIn(&nCols);
+		cmd >> (new TCLAP::MultiArg<int>("p", "npar", "Number of particle cells (default: 4; can be given multiple times for a sweep)", false, "Value"))->storeIn(&nPars);
+		cmd >> (new TCLAP::ValueArg<int>("r", "reps", "Number of repetitions per case (default: 1)", false, 1, "Value"))->storeIn(&nReps);
+		cmd >> (new TCLAP::ValueArg<int>("n", "threads", "Number of threads (default: 1)", false, 1, "Value"))->storeIn(&nThreads);
+
+		cmd.parse(argc, argv);
+	}
+	catch (const TCLAP::ArgException& e)
+	{
+		std::cerr << "ERROR: " << e.error() << " for argument " << e.argId() << std::endl;
+		return 1;
+	}
+
+	if (nCols.empty())
+		nCols.push_back(64);
+	if (nPars.empty())
+		nPars.push_back(4);
+
+	json out;
+	out["VERSION"] = cadet::getLibraryVersion();
+	out["COMMIT"] = cadet::getLibraryCommitHash();
+#ifdef CADET_BENCHMARK_MODE
+	out["BENCHMARK_MODE"] = true;
+#else
+	out["BENCHMARK_MODE"] = false;
+#endif
+
+	json cases = json::array();
+	try
+	{
+		for (int nCol : nCols)
+		{
+			for (int nPar : nPars)
+			{
+				for (int rep = 0; rep < nReps; ++rep)
+				{
+					json res = runCase(nCol, nPar, nThreads);
+					res["REP"] = rep;
+					cases.push_back(res);
+
+					std::cerr << "NCOL = " << nCol << " NPAR = " << nPar << " rep " << (rep + 1) << " / " << nReps
+						<< ": " << res["TOTAL_TIME_SEC"].get<double>() << " sec" << std::endl;
+				}
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		return 2;
+	}
+	out["CASES"] = cases;
+
+	if (outFileName.empty())
+		std::cout << out.dump(4) << std::endl;
+	else
+	{
+		std::ofstream file(outFileName, std::ios::trunc);
+		file << out.dump(4) << std::endl;
+	}
+
+	return 0;
+}
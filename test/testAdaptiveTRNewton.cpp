@@ -170,16 +170,18 @@ void run()
 	const double initDamping = 0.01;
 	const double minDamping = 1e-4;
 
+	const unsigned int maxSecantIter = 8;
+
 	std::vector<double> sol(p.initPoint, p.initPoint + p.size());
-	std::vector<double> tempMem(4 * p.size(), 0.0);
+	std::vector<double> tempMem((5 + maxSecantIter) * p.size() + maxSecantIter + 1, 0.0);
 
 /*
-	const bool success = cadet::nonlin::adaptiveTrustRegionNewtonMethod<StdOutIterateOutputPolicy>([&](double const* const x, double* const res) { return p.residual(x, res); }, 
+	const bool success = cadet::nonlin::adaptiveTrustRegionNewtonMethod<StdOutIterateOutputPolicy>([&](double const* const x, double* const res) { return p.residual(x, res); },
 		[&](double const* const x, double* const res) { return p.jacobianSolve(x, res); }, maxIter, resTol,
 		initDamping, minDamping, sol.data(), tempMem.data(), p.size());
 */
 
-	const bool success = cadet::nonlin::robustAdaptiveTrustRegionNewtonMethod<StdOutIterateOutputPolicy>([&](double const* const x, double* const res) { return p.residual(x, res); }, 
+	const bool success = cadet::nonlin::robustAdaptiveTrustRegionNewtonMethod<StdOutIterateOutputPolicy>([&](double const* const x, double* const res) { return p.residual(x, res); },
 		[&](double const* const x, double* const res) { return p.jacobianSolve(x, res); },
 		[&](double* const res) { return p.jacobianResolve(res); }, maxIter, resTol,
 		initDamping, minDamping, sol.data(), tempMem.data(), p.size());
@@ -195,6 +197,26 @@ void run()
 		errorLinf = std::max(std::abs(sol[i] - p.solution[i]), errorLinf);
 	}
 	std::cout << "Linf-Error: " << errorLinf << std::endl;
+
+	// Repeat with quasi-Newton (Broyden) iterations enabled
+	sol.assign(p.initPoint, p.initPoint + p.size());
+	std::fill(tempMem.begin(), tempMem.end(), 0.0);
+
+	const bool successQN = cadet::nonlin::adaptiveTrustRegionNewtonMethod<StdOutIterateOutputPolicy>([&](double const* const x, double* const res) { return p.residual(x, res); },
+		[&](double const* const x, double* const res) { return p.jacobianSolve(x, res); },
+		[&](double* const res) { return p.jacobianResolve(res); }, maxSecantIter, maxIter, resTol,
+		initDamping, minDamping, sol.data(), tempMem.data(), p.size());
+
+	std::cout << "Method with quasi-Newton " << (successQN ? "SUCCESS" : "FAIL") << std::endl;
+	printVector("Solution", sol.data(), p.size());
+	printVector("Referenc", p.solution, p.size());
+
+	errorLinf = 0.0;
+	for (unsigned int i = 0; i < p.size(); ++i)
+	{
+		errorLinf = std::max(std::abs(sol[i] - p.solution[i]), errorLinf);
+	}
+	std::cout << "Linf-Error: " << errorLinf << std::endl;
 }
 
 
@@ -21,7 +21,7 @@ typedef cadet::log::Logger<GlobalLogger, cadet::LogLevel::Warning> FilterLogger;
 typedef cadet::log::Logger<cadet::log::RuntimeFilteringLogger<GlobalLogger>, cadet::LogLevel::Normal> RtFilterLogger;
 
 template <>
-cadet::LogLevel cadet::log::RuntimeFilteringLogger<GlobalLogger>::_minLvl = cadet::LogLevel::Trace;
+std::atomic<cadet::LogLevel> cadet::log::RuntimeFilteringLogger<GlobalLogger>::_minLvl(cadet::LogLevel::Trace);
 
 #define LOG_GLOBAL(lvl) LOG_BASE(NonFilteringLogger, lvl)
 #define LOG_FILTER(lvl) LOG_BASE(FilterLogger, lvl)